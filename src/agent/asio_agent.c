@@ -75,15 +75,28 @@ void init_asio_agent(asio_agent_t* io)
 {
   assert(io != NULL);
 
-  io->efd = init_epoll();
-  set_fd_non_blocking(io->efd);
+  io->ring = create_asio_uring();
+  if(io->ring != NULL){
+    io->efd = -1;
+  } else {
+    io->efd = init_epoll();
+    set_fd_non_blocking(io->efd);
+  }
 
   io->pipe = create_pipe_asio_agent(io);
+
+  io->clk = NULL;
 }
 
 void add_fd_asio_agent(asio_agent_t* io, int fd)
 {
   assert(io != NULL);
+
+  if(io->ring != NULL){
+    add_fd_asio_uring(io->ring, fd, true);
+    return;
+  }
+
   const int op = EPOLL_CTL_ADD;
   const epoll_data_t e_data = {.fd = fd};
   const int e_events = EPOLLIN | EPOLLET; // open for reading and edge triggered instead of level triggered
@@ -92,9 +105,39 @@ void add_fd_asio_agent(asio_agent_t* io, int fd)
   assert(rc != -1);
 }
 
+void add_sock_fd_asio_agent(asio_agent_t* io, int fd)
+{
+  assert(io != NULL);
+
+  if(io->ring != NULL){
+    add_fd_asio_uring(io->ring, fd, false);
+    return;
+  }
+
+  const int op = EPOLL_CTL_ADD;
+  const epoll_data_t e_data = {.fd = fd};
+  const int e_events = EPOLLIN; // level triggered
+  struct epoll_event event = {.events = e_events, .data = e_data};
+  int rc = epoll_ctl(io->efd, op, fd, &event);
+  assert(rc != -1);
+}
+
 void rm_fd_asio_agent(asio_agent_t* io, int fd)
 {
   assert(io != NULL);
+  if(io->clk != NULL)
+    rm_timer_sim_clock(io->clk, fd);
+
+  if(io->ring != NULL && is_timer_asio_uring(fd) == true){
+    rm_timer_asio_uring(io->ring, fd);
+    return;
+  } else if(io->ring != NULL){
+    rm_fd_asio_uring(io->ring, fd);
+    int const rc = close(fd);
+    assert(rc == 0);
+    return;
+  }
+
   const int op = EPOLL_CTL_DEL;
   const epoll_data_t e_data = {.fd = fd};
   const int e_events = EPOLLIN; // open for reading
@@ -111,6 +154,9 @@ int create_timer_ms_asio_agent(asio_agent_t* io, long initial_ms, long interval_
   assert(initial_ms > -1);
   assert(interval_ms > -1);
 
+  if(io->ring != NULL)
+    return create_timer_ms_asio_uring(io->ring, initial_ms, interval_ms);
+
   // Create the timer
   const int clockid = CLOCK_MONOTONIC;
   const int flags = TFD_NONBLOCK | TFD_CLOEXEC;
@@ -137,10 +183,43 @@ int create_timer_ms_asio_agent(asio_agent_t* io, long initial_ms, long interval_
   return tfd;
 }
 
+int create_ran_timer_ms_asio_agent(asio_agent_t* io, long initial_ms, long interval_ms)
+{
+  assert(io != NULL);
+
+  if(io->clk == NULL)
+    return create_timer_ms_asio_agent(io, initial_ms, interval_ms);
+
+  const int fd = add_timer_sim_clock(io->clk, initial_ms, interval_ms);
+  add_fd_asio_agent(io, fd);
+  return fd;
+}
+
+void consume_timer_asio_agent(asio_agent_t const* io, int fd)
+{
+  assert(io != NULL);
+  assert(fd > 0);
+
+  // Nothing to read from io_uring timeouts. The ones of the simulation 
+  // clock are eventfds
+  if(io->ring != NULL && is_timer_asio_uring(fd) == true)
+    return;
+
+  uint64_t read_buf = 0;
+  ssize_t const bytes = read(fd, &read_buf, sizeof(read_buf));
+  assert(bytes <= (ssize_t)sizeof(read_buf));
+}
+
 int event_asio_agent(asio_agent_t const* io)
 {
   assert(io != NULL);
 
+  if(io->ring != NULL){
+    int fd = -1;
+    size_t const len = event_asio_uring(io->ring, 1000, 1, &fd);
+    return len == 0 ? -1 : fd;
+  }
+
   const int maxevents = 1;
   struct epoll_event events[maxevents];
   const int timeout_ms = 1000;
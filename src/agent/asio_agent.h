@@ -23,6 +23,9 @@
 #ifndef ASYNC_INPUT_OUTPUT_AGENT_H
 #define ASYNC_INPUT_OUTPUT_AGENT_H
 
+#include "../lib/asio_uring.h"
+#include "sim_clock_agent.h"
+
 typedef struct{
   int r;
   int w;
@@ -31,19 +34,34 @@ typedef struct{
 typedef struct{
   // epoll based fd
   int efd; 
+  // io_uring backend. NULL if epoll 
+  asio_uring_t* ring;
   // Aperiodic events
   // pipe fd, for communication with epoll
   fd_pair_t pipe; 
+  // Simulation clock of the RAN. NULL follows CLOCK_MONOTONIC
+  sim_clock_t* clk;
 } asio_agent_t;
 
 void init_asio_agent(asio_agent_t* io);
 
 void add_fd_asio_agent(asio_agent_t* io, int fd);
 
+// Level triggered, as one message is read per event, e.g., the answers to
+// two E2 SETUP-REQUESTs may arrive back to back
+void add_sock_fd_asio_agent(asio_agent_t* io, int fd);
+
 void rm_fd_asio_agent(asio_agent_t* io, int fd);
 
+// Acknowledges the expiration of a timer
+void consume_timer_asio_agent(asio_agent_t const* io, int fd);
+
 int create_timer_ms_asio_agent(asio_agent_t* io, long initial_ms, long interval_ms);
 
+// Timers that follow the time of the RAN, i.e., the subscription periods.
+// They follow the simulation clock if set
+int create_ran_timer_ms_asio_agent(asio_agent_t* io, long initial_ms, long interval_ms);
+
 int event_asio_agent(asio_agent_t const* io);
 
 #endif
@@ -111,27 +111,12 @@ void free_pending_ev(void* key, void* value)
 }
 
 static inline
-void free_pending_agent(e2_agent_t* ag)
+void init_pending_events(ric_ag_t* ric)
 {
-  assert(ag != NULL);
-  bi_map_free(&ag->pending);
-}
-
-static inline
-void free_indication_event(e2_agent_t* ag)
-{
-  assert(ag != NULL);
-  bi_map_free(&ag->ind_event);
-  pthread_mutex_destroy(&ag->mtx_ind_event);
-}
-
-static inline
-void init_pending_events(e2_agent_t* ag)
-{
-  assert(ag != NULL);
+  assert(ric != NULL);
   size_t fd_sz = sizeof(int);
   size_t event_sz = sizeof( pending_event_t );
-  bi_map_init(&ag->pending, fd_sz, event_sz, cmp_fd, cmp_pending_event, free_fd, free_pending_ev );
+  bi_map_init(&ric->pending, fd_sz, event_sz, cmp_fd, cmp_pending_event, free_fd, free_pending_ev );
 }
 
 static inline
@@ -146,6 +131,7 @@ void free_ind_event_map(void* key, void* value)
   if(ev->sm->free_act_def != NULL)
     ev->sm->free_act_def(ev->sm, ev->act_def); 
 
+  free_byte_array(ev->subs);
   free(ev);
 }
 
@@ -161,56 +147,91 @@ void free_key(void* key, void* value)
   free(fd);
 }
 
-
 static inline
-void init_indication_event(e2_agent_t* ag)
+void init_indication_event(ric_ag_t* ric)
 {
-  assert(ag != NULL);
+  assert(ric != NULL);
   size_t key_sz_fd = sizeof(int);
   size_t key_sz_ind = sizeof(ind_event_t);
 
-  bi_map_init(&ag->ind_event, key_sz_fd, key_sz_ind, cmp_fd, cmp_ind_event, free_ind_event_map, free_key);
+  bi_map_init(&ric->ind_event, key_sz_fd, key_sz_ind, cmp_fd, cmp_ind_event, free_ind_event_map, free_key);
+}
 
-  pthread_mutexattr_t attr = {0};
-#ifdef DEBUG
-  pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_ERRORCHECK); 
+static
+void init_ric_ag(ric_ag_t* ric, uint16_t idx, ric_addr_ag_t const* addr)
+{
+  assert(ric != NULL);
+  assert(addr != NULL);
+
+  ric->idx = idx;
+  e2ap_init_ep_agent(&ric->ep, addr->addr, addr->port);
+
+  init_pending_events(ric);
+
+  init_indication_event(ric);
+
+  init_backoff(&ric->backoff, BASE_MS_BACKOFF, MAX_MS_BACKOFF);
+
+#if defined(E2AP_V2) || defined (E2AP_V3)
+  ric->trans_id_setup_req = 0;
 #endif
-  int rc = pthread_mutex_init(&ag->mtx_ind_event, &attr);
-  assert(rc == 0);
+}
+
+static
+void free_ric_ag(ric_ag_t* ric)
+{
+  assert(ric != NULL);
 
+  bi_map_free(&ric->pending);
+
+  bi_map_free(&ric->ind_event);
+
+  e2ap_free_ep_agent(&ric->ep);
 }
 
 static inline
-void* ind_fd(e2_agent_t* ag, int fd)
+void* ind_fd(ric_ag_t* ric, int fd)
 {
-  assert(ag != NULL);
+  assert(ric != NULL);
   assert(fd > 0);
 
-  void* start_it = assoc_front(&ag->ind_event.left);
-  void* end_it = assoc_end(&ag->ind_event.left);
+  void* start_it = assoc_front(&ric->ind_event.left);
+  void* end_it = assoc_end(&ric->ind_event.left);
 
-  void* it = find_if(&ag->ind_event.left, start_it, end_it, &fd, eq_fd );
+  void* it = find_if(&ric->ind_event.left, start_it, end_it, &fd, eq_fd );
   return it;
 }
 
 static inline
-bool net_pkt(const e2_agent_t* ag, int fd)
+bool net_pkt(e2_agent_t* ag, int fd, ric_ag_t** ric)
 {
   assert(ag != NULL);
   assert(fd > 0);
-  return fd == ag->ep.base.fd;
+
+  for(size_t i = 0; i < ag->len_ric; ++i){
+    if(fd == ag->ric[i].ep.base.fd){
+      *ric = &ag->ric[i];
+      return true;
+    }
+  }
+  return false;
 }
 
+// The first nearRT-RIC subscribed. The rest may share the fd 
 static inline
-bool ind_event(e2_agent_t* ag, int fd, ind_event_t** i_ev)
+bool ind_event(e2_agent_t* ag, int fd, ind_event_t** i_ev, ric_ag_t** ric)
 {
   assert(*i_ev == NULL);
-  void* it = ind_fd(ag, fd);   
-  void* end_it = assoc_end(&ag->ind_event.left); // bi_map_end_left(&ag->ind_event);
-  if(it != end_it){
-    *i_ev = assoc_value(&ag->ind_event.left, it);
-    return true;
-  } 
+
+  for(size_t i = 0; i < ag->len_ric; ++i){
+    void* it = ind_fd(&ag->ric[i], fd);   
+    void* end_it = assoc_end(&ag->ric[i].ind_event.left);
+    if(it != end_it){
+      *i_ev = assoc_value(&ag->ric[i].ind_event.left, it);
+      *ric = &ag->ric[i];
+      return true;
+    } 
+  }
   return false;
 }
 
@@ -220,9 +241,14 @@ bool aind_event(e2_agent_t* ag, int fd, arr_aind_event_t* dst)
   if(fd != ag->io.pipe.r)
     return false;
 
+  // Already drained by a previous wake-up. io_uring reports every write
   const size_t sz = size_tsq(&ag->aind);
-  assert(sz > 0 && "Aperiodic Event detected but the queue is empty!");
   dst->len = sz;
+  if(sz == 0){
+    dst->arr = NULL;
+    return true;
+  }
+
   dst->arr = calloc(sz, sizeof(aind_event_t));
   assert(dst->arr != NULL && "Memory exhausted");
 
@@ -233,32 +259,27 @@ bool aind_event(e2_agent_t* ag, int fd, arr_aind_event_t* dst)
 }
 
 static inline
-bool pend_event(e2_agent_t* ag, int fd, pending_event_t** p_ev)
+bool pend_event(e2_agent_t* ag, int fd, pending_event_t** p_ev, ric_ag_t** ric)
 {
   assert(ag != NULL);
   assert(fd > 0);
   assert(*p_ev == NULL);
   
-  assert(bi_map_size(&ag->pending) == 1 );
-
-  void* start_it = assoc_front(&ag->pending.left);
-  void* end_it = assoc_end(&ag->pending.left);
-
-  void* it = find_if(&ag->pending.left,start_it, end_it, &fd, eq_fd);
-
-  assert(it != end_it);
-  *p_ev = assoc_value(&ag->pending.left ,it);
-  return *p_ev != NULL;
-}
-
-static
-void consume_fd_sync(int fd)
-{
-  assert(fd > 0);
-  uint64_t read_buf = 0;
-  ssize_t const bytes = read(fd,&read_buf, sizeof(read_buf));
-  //assert(bytes == -1);
-  assert(bytes <= (ssize_t)sizeof(read_buf));
+  for(size_t i = 0; i < ag->len_ric; ++i){
+    bi_map_t* pending = &ag->ric[i].pending;
+    assert(bi_map_size(pending) < 2);
+
+    void* start_it = assoc_front(&pending->left);
+    void* end_it = assoc_end(&pending->left);
+
+    void* it = find_if(&pending->left,start_it, end_it, &fd, eq_fd);
+    if(it != end_it){
+      *p_ev = assoc_value(&pending->left ,it);
+      *ric = &ag->ric[i];
+      return true;
+    }
+  }
+  return false;
 }
 
 static
@@ -273,7 +294,7 @@ int consume_fd_async(int fd)
 }
 
 static
-async_event_t next_async_event_agent(e2_agent_t* ag)
+async_event_t next_async_event_agent(e2_agent_t* ag, ric_ag_t** ric)
 {
   assert(ag != NULL);
 
@@ -285,8 +306,8 @@ async_event_t next_async_event_agent(e2_agent_t* ag)
   if(fd == -1){ // no event happened. Just for checking the stop_token condition
     e.type = CHECK_STOP_TOKEN_EVENT;
 
-  } else if (net_pkt(ag, fd) == true){
-    e.msg = e2ap_recv_msg_agent(&ag->ep);
+  } else if (net_pkt(ag, fd, ric) == true){
+    e.msg = e2ap_recv_msg_agent(&(*ric)->ep);
     if(e.msg.type == SCTP_MSG_NOTIFICATION){
       e.type = SCTP_CONNECTION_SHUTDOWN_EVENT;
 
@@ -300,10 +321,10 @@ async_event_t next_async_event_agent(e2_agent_t* ag)
   } else if(aind_event(ag, fd, &e.ai_ev) == true) {
     e.type = APERIODIC_INDICATION_EVENT;
 
-  } else if (ind_event(ag, fd, &e.i_ev) == true) {
+  } else if (ind_event(ag, fd, &e.i_ev, ric) == true) {
     e.type = INDICATION_EVENT;
 
-  } else if (pend_event(ag, fd, &e.p_ev) == true){
+  } else if (pend_event(ag, fd, &e.p_ev, ric) == true){
     e.type = PENDING_EVENT;
 
   } else {
@@ -312,13 +333,63 @@ async_event_t next_async_event_agent(e2_agent_t* ag)
   return e;
 }
 
+// The SM reads the RAN and encodes once. Every nearRT-RIC that shares the
+// timer receives it with its own RIC Request ID 
+static
+void send_indication_event(e2_agent_t* ag, ric_ag_t* first, ind_event_t const* i_ev, int fd)
+{
+  assert(ag != NULL);
+  assert(first != NULL);
+  assert(i_ev != NULL);
+
+  sm_agent_t const* sm = i_ev->sm;
+  exp_ind_data_t exp = sm->proc.on_indication(sm, i_ev->act_def);
+  // Condition not matched e.g., No UE matches condition 
+  if(exp.has_value == false)
+    return;
+
+  ric_indication_t ind = generate_indication(ag, &exp.data, (ind_event_t*)i_ev);
+  defer({ e2ap_free_indication(&ind); } );
+
+  for(size_t i = first->idx; i < ag->len_ric; ++i){
+    ric_ag_t* ric = &ag->ric[i];
+    void* it = ind_fd(ric, fd);
+    if(it == assoc_end(&ric->ind_event.left))
+      continue;
+
+    ind_event_t const* ev = assoc_value(&ric->ind_event.left, it);
+    ind.ric_id = ev->ric_id;
+    ind.action_id = ev->action_id;
+
+    byte_array_t ba = e2ap_enc_indication_ag(&ag->ap, &ind); 
+    e2ap_send_bytes_agent(&ric->ep, ba);
+    free_byte_array(ba);
+  }
+}
+
+static
+void send_setup_request(e2_agent_t* ag, ric_ag_t* ric)
+{
+  assert(ag != NULL);
+  assert(ric != NULL);
+
+  e2_setup_request_t sr = gen_setup_request(&ag->ap.version.type, ag, ric); 
+  defer({ e2ap_free_setup_request(&sr); } );
+
+  byte_array_t ba = e2ap_enc_setup_request_ag(&ag->ap, &sr); 
+  defer({ free_byte_array(ba); } ); 
+
+  e2ap_send_bytes_agent(&ric->ep, ba);
+}
+
 static
 void e2_event_loop_agent(e2_agent_t* ag)
 {
   assert(ag != NULL);
   while(ag->stop_token == false){
 
-    async_event_t e = next_async_event_agent(ag); 
+    ric_ag_t* ric = NULL;
+    async_event_t e = next_async_event_agent(ag, &ric); 
     assert(e.type != UNKNOWN_EVENT && "Unknown event triggered ");
 
     switch(e.type){
@@ -329,14 +400,20 @@ void e2_event_loop_agent(e2_agent_t* ag)
           e2ap_msg_t msg = e2ap_msg_dec_ag(&ag->ap, e.msg.ba);
           defer( { e2ap_msg_free_ag(&ag->ap, &msg);} );
 
-          e2ap_msg_t ans = e2ap_msg_handle_agent(ag, &msg);
+          // Undecodable or of an unsupported procedure, e.g., of another E2AP version
+          if(msg.type == NONE_E2_MSG_TYPE){
+            printf("[E2-AGENT]: Undecodable or unsupported E2AP PDU from the nearRT-RIC discarded\n");
+            break;
+          }
+
+          e2ap_msg_t ans = e2ap_msg_handle_agent(ag, ric, &msg);
           defer( { e2ap_msg_free_ag(&ag->ap, &ans);} );
 
           if(ans.type != NONE_E2_MSG_TYPE){
             byte_array_t ba_ans = e2ap_msg_enc_ag(&ag->ap, &ans); 
             defer ({free_byte_array(ba_ans); } );
 
-            e2ap_send_bytes_agent(&ag->ep, ba_ans);
+            e2ap_send_bytes_agent(&ric->ep, ba_ans);
           }
 
           break;
@@ -344,7 +421,9 @@ void e2_event_loop_agent(e2_agent_t* ag)
       case APERIODIC_INDICATION_EVENT:
         {
           arr_aind_event_t* aind = &e.ai_ev;  
-          assert(aind->len > 0 && aind->arr != NULL);
+          if(aind->len == 0)
+            break;
+          assert(aind->arr != NULL);
           defer({ free(aind->arr); });
           for(size_t i = 0; i < aind->len; ++i){
 
@@ -364,7 +443,8 @@ void e2_event_loop_agent(e2_agent_t* ag)
             byte_array_t ba = e2ap_enc_indication_ag(&ag->ap, &ind); 
             defer({ free_byte_array(ba); } );
 
-            e2ap_send_bytes_agent(&ag->ep, ba);
+            assert(aind->arr[i].ric_idx < ag->len_ric);
+            e2ap_send_bytes_agent(&ag->ric[aind->arr[i].ric_idx].ep, ba);
 
             int rc = consume_fd_async(ag->io.pipe.r); 
             assert(rc != 1 && "No bytes in the pipe but message in the queue! ");
@@ -373,47 +453,29 @@ void e2_event_loop_agent(e2_agent_t* ag)
         }
       case INDICATION_EVENT:
         {
-          sm_agent_t const* sm = e.i_ev->sm;
-          void* act_def = e.i_ev->act_def; 
-          exp_ind_data_t exp = sm->proc.on_indication(sm, act_def); // , &e.i_ev->ric_id);
-          // Condition not matched e.g., No UE matches condition 
-          if(exp.has_value == false){
-            consume_fd_sync(e.fd);
-            break;  
-          }
-          ric_indication_t ind = generate_indication(ag, &exp.data, e.i_ev);
-          defer({ e2ap_free_indication(&ind); } );
-
-          byte_array_t ba = e2ap_enc_indication_ag(&ag->ap, &ind); 
-          defer({ free_byte_array(ba); } );
-
-          e2ap_send_bytes_agent(&ag->ep, ba);
-
-          consume_fd_sync(e.fd);
-
+          // Before sending, as an expiration while sending would be lost
+          consume_timer_asio_agent(&ag->io, e.fd);
+          send_indication_event(ag, ric, e.i_ev, e.fd);
           break;
         }
       case PENDING_EVENT:
         {
           assert(*e.p_ev == SETUP_REQUEST_PENDING_EVENT && "Unforeseen pending event happened!" );
 
-          // Resend the setup request message
-          e2_setup_request_t sr = gen_setup_request(&ag->ap.version.type, ag); 
-          defer({ e2ap_free_setup_request(&sr); } );
-
+          // Resend the setup request message. The one-shot timer is replaced
+          // by one with the next delay of the backoff 
           printf("[E2 AGENT]: E2 SETUP REQUEST timeout. Resending again (tx) \n");
-          byte_array_t ba = e2ap_enc_setup_request_ag(&ag->ap, &sr); 
-          defer({ free_byte_array(ba); } ); 
+          consume_timer_asio_agent(&ag->io, e.fd);
+          arm_setup_timer_agent(ag, ric);
 
-          e2ap_send_bytes_agent(&ag->ep, ba);
-
-          consume_fd_sync(e.fd);
+          send_setup_request(ag, ric);
+          notify_conn_state_agent(ag, ric, RETRY_CONN_STATE);
 
           break;
         }
       case SCTP_CONNECTION_SHUTDOWN_EVENT: 
         {
-          notification_handle_ag(ag, &e.msg);
+          notification_handle_ag(ag, ric, &e.msg);
           free_sctp_msg(&e.msg);
           break;
         }
@@ -436,19 +498,32 @@ void e2_event_loop_agent(e2_agent_t* ag)
 
 e2_agent_t* e2_init_agent(const char* addr, int port, global_e2_node_id_t ge2nid, sm_io_ag_ran_t io, char const* libs_dir)
 {
-  assert(addr != NULL);
-  assert(port > 0 && port < 65535);
+  ric_addr_ag_t const ric = {.addr = addr, .port = port};
+  return e2_init_multi_ric_agent(1, &ric, ge2nid, io, libs_dir);
+}
+
+e2_agent_t* e2_init_multi_ric_agent(size_t len, ric_addr_ag_t const addr[len], global_e2_node_id_t ge2nid, sm_io_ag_ran_t io, char const* libs_dir)
+{
+  assert(len > 0 && len < 1 << 16);
+  for(size_t i = 0; i < len; ++i){
+    assert(addr[i].addr != NULL);
+    assert(addr[i].port > 0 && addr[i].port < 65535);
+  }
 
   printf("[E2 AGENT]: Initializing ... \n");
 
   e2_agent_t* ag = calloc(1, sizeof(*ag));
   assert(ag != NULL && "Memory exhausted");
 
-  e2ap_init_ep_agent(&ag->ep, addr, port);
-
   init_asio_agent(&ag->io); 
 
-  add_fd_asio_agent(&ag->io, ag->ep.base.fd);
+  ag->len_ric = len;
+  ag->ric = calloc(len, sizeof(ric_ag_t));
+  assert(ag->ric != NULL && "Memory exhausted");
+  for(size_t i = 0; i < len; ++i){
+    init_ric_ag(&ag->ric[i], i, &addr[i]);
+    add_sock_fd_asio_agent(&ag->io, ag->ric[i].ep.base.fd);
+  }
 
   init_ap(&ag->ap.base.type);
 
@@ -457,9 +532,12 @@ e2_agent_t* e2_init_agent(const char* addr, int port, global_e2_node_id_t ge2nid
 
   init_plugin_ag(&ag->plugin, libs_dir, io);
 
-  init_pending_events(ag);
-
-  init_indication_event(ag);
+  pthread_mutexattr_t attr = {0};
+#ifdef DEBUG
+  pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_ERRORCHECK); 
+#endif
+  int rc = pthread_mutex_init(&ag->mtx_ind_event, &attr);
+  assert(rc == 0);
 
   init_tsq(&ag->aind, sizeof(aind_event_t));
 
@@ -467,8 +545,6 @@ e2_agent_t* e2_init_agent(const char* addr, int port, global_e2_node_id_t ge2nid
   // Read RAN 
   assert(io.read_setup_ran != NULL);
   ag->read_setup_ran = io.read_setup_ran;
-
-  ag->trans_id_setup_req = 0;
 #endif
 
   ag->global_e2_node_id = ge2nid;
@@ -478,29 +554,37 @@ e2_agent_t* e2_init_agent(const char* addr, int port, global_e2_node_id_t ge2nid
   return ag;
 }
 
-void e2_start_agent(e2_agent_t* ag)
+void backoff_e2_agent(e2_agent_t* ag, int64_t base_ms, int64_t max_ms)
 {
   assert(ag != NULL);
 
-  // Resend the subscription request message
-  e2_setup_request_t sr = gen_setup_request(&ag->ap.version.type, ag); 
-  defer({ e2ap_free_setup_request(&sr);  } );
+  // One seed per nearRT-RIC
+  for(size_t i = 0; i < ag->len_ric; ++i)
+    init_backoff(&ag->ric[i].backoff, base_ms, max_ms);
+}
 
-  printf("[E2-AGENT]: E2 SETUP-REQUEST tx \n");
-  byte_array_t ba = e2ap_enc_setup_request_ag(&ag->ap, &sr); 
-  defer({free_byte_array(ba); } ); 
+void conn_state_cb_e2_agent(e2_agent_t* ag, conn_state_cb cb, void* data)
+{
+  assert(ag != NULL);
 
-  // A pending event is created along with a timer of 3000 ms,
-  // after which an event will be generated
-  pending_event_t ev = SETUP_REQUEST_PENDING_EVENT;
-  long const wait_ms = 3000;
-  int fd_timer = create_timer_ms_asio_agent(&ag->io, wait_ms, wait_ms); 
-  //printf("fd_timer with value created == %d\n", fd_timer);
+  ag->conn_cb = cb;
+  ag->conn_data = data;
+}
 
-  bi_map_insert(&ag->pending, &fd_timer, sizeof(fd_timer), &ev, sizeof(ev)); 
+void e2_start_agent(e2_agent_t* ag)
+{
+  assert(ag != NULL);
+
+  for(size_t i = 0; i < ag->len_ric; ++i){
+    ric_ag_t* ric = &ag->ric[i];
 
-  // Send the message
-  e2ap_send_bytes_agent(&ag->ep, ba);
+    // A pending event is created along with a timer, after which the 
+    // E2 SETUP-REQUEST is sent again
+    arm_setup_timer_agent(ag, ric);
+
+    printf("[E2-AGENT]: E2 SETUP-REQUEST tx \n");
+    send_setup_request(ag, ric);
+  }
 
   e2_event_loop_agent(ag);
 }
@@ -514,32 +598,83 @@ void e2_free_agent(e2_agent_t* ag)
 
   free_plugin_ag(&ag->plugin);
 
-  free_pending_agent(ag);
+  for(size_t i = 0; i < ag->len_ric; ++i)
+    free_ric_ag(&ag->ric[i]);
+  free(ag->ric);
 
-  free_indication_event(ag);
+  pthread_mutex_destroy(&ag->mtx_ind_event);
 
   free_tsq(&ag->aind, NULL);
 
   free_global_e2_node_id(&ag->global_e2_node_id);
 
-  e2ap_free_ep_agent(&ag->ep);
-
   free(ag);
 }
 
+uint32_t ric_req_id_agent(ric_ag_t const* ric, uint32_t ric_req_id)
+{
+  assert(ric != NULL);
+  assert(ric_req_id < 1 << 16);
+
+  return ((uint32_t)ric->idx << 16) | ric_req_id;
+}
+
+void arm_setup_timer_agent(e2_agent_t* ag, ric_ag_t* ric)
+{
+  assert(ag != NULL);
+  assert(ric != NULL);
+
+  stop_setup_timer_agent(ag, ric);
+
+  // One-shot, as every retry waits longer
+  pending_event_t ev = SETUP_REQUEST_PENDING_EVENT;
+  long const wait_ms = next_backoff(&ric->backoff);
+  int fd_timer = create_timer_ms_asio_agent(&ag->io, wait_ms, 0); 
+
+  bi_map_insert(&ric->pending, &fd_timer, sizeof(fd_timer), &ev, sizeof(ev)); 
+}
+
+bool stop_setup_timer_agent(e2_agent_t* ag, ric_ag_t* ric)
+{
+  assert(ag != NULL);
+  assert(ric != NULL);
+
+  // The E2 SETUP-REQUEST is the only pending event of the agent
+  if(bi_map_size(&ric->pending) == 0)
+    return false;
+
+  pending_event_t ev = SETUP_REQUEST_PENDING_EVENT;
+  void (*free_pending_event)(void*) = NULL;
+  int* fd = bi_map_extract_right(&ric->pending, &ev, sizeof(ev), free_pending_event);
+  assert(*fd > 0);
+  rm_fd_asio_agent(&ag->io, *fd);
+  free(fd);
+  return true;
+}
+
+void notify_conn_state_agent(e2_agent_t const* ag, ric_ag_t const* ric, conn_state_e state)
+{
+  assert(ag != NULL);
+  assert(ric != NULL);
+  assert(state < END_CONN_STATE);
+
+  if(ag->conn_cb != NULL)
+    ag->conn_cb(ric->ep.base.addr, state, ag->conn_data);
+}
+
 void e2_async_event_agent(e2_agent_t* ag, uint32_t ric_req_id, void* ind_data)
 {
   assert(ag != NULL);
 
+  size_t const idx = ric_req_id >> 16; 
+  assert(idx < ag->len_ric && "Not a RIC Request ID of the agent");
+  uint32_t const id = ric_req_id & 0xFFFF;
+
   void* f = NULL; 
   void* l = NULL;
   void* it = NULL;
 
-  ind_event_t tmp = {.ric_id.ric_req_id = ric_req_id, 
-    .sm = NULL, 
-    .action_id = 0 };
-
-  assoc_rb_tree_t* tree = &ag->ind_event.right;
+  assoc_rb_tree_t* tree = &ag->ric[idx].ind_event.right;
  
   for(size_t i =0; i < 10; ++i){
     int rc = pthread_mutex_lock(&ag->mtx_ind_event);  
@@ -547,7 +682,7 @@ void e2_async_event_agent(e2_agent_t* ag, uint32_t ric_req_id, void* ind_data)
 
     f = assoc_rb_tree_front(tree);
     l = assoc_rb_tree_end(tree);
-    it = find_if_rb_tree(tree, f, l, &tmp, eq_ind_event_ric_req_id); 
+    it = find_if_rb_tree(tree, f, l, (void*)&id, eq_ind_event_ric_req_id); 
     if(it != l) break; 
 
     rc = pthread_mutex_unlock(&ag->mtx_ind_event);
@@ -565,7 +700,8 @@ void e2_async_event_agent(e2_agent_t* ag, uint32_t ric_req_id, void* ind_data)
   aind_event_t aind = {.ric_id = ind_ev->ric_id,
     .sm = ind_ev->sm,
     .action_id = ind_ev->action_id,
-    .ind_data = ind_data};
+    .ind_data = ind_data,
+    .ric_idx = idx};
 
   int rc = pthread_mutex_unlock(&ag->mtx_ind_event);
   assert(rc == 0);
@@ -587,63 +723,64 @@ void e2_async_event_agent(e2_agent_t* ag, uint32_t ric_req_id, void* ind_data)
 //////////////////////////////////
 /////////////////////////////////
 
-void e2_send_subscription_response(e2_agent_t* ag, const ric_subscription_response_t* sr)
+void e2_send_subscription_response(e2_agent_t* ag, ric_ag_t* ric, const ric_subscription_response_t* sr)
 {
   assert(ag != NULL);
+  assert(ric != NULL);
   assert(sr != NULL);
 
   byte_array_t ba = e2ap_enc_subscription_response_ag(&ag->ap, sr);
-  e2ap_send_bytes_agent(&ag->ep, ba);
+  e2ap_send_bytes_agent(&ric->ep, ba);
   free_byte_array(ba);
 }
 
-void e2_send_subscription_failure(e2_agent_t* ag, const ric_subscription_failure_t* sf)
+void e2_send_subscription_failure(e2_agent_t* ag, ric_ag_t* ric, const ric_subscription_failure_t* sf)
 {
   assert(ag != NULL);
   assert(sf != NULL);
 
   byte_array_t ba = e2ap_enc_subscription_failure_ag(&ag->ap, sf);
-  e2ap_send_bytes_agent(&ag->ep, ba);
+  e2ap_send_bytes_agent(&ric->ep, ba);
   free_byte_array(ba);
 }
 
-void e2_send_indication_agent(e2_agent_t* ag, const ric_indication_t* indication)
+void e2_send_indication_agent(e2_agent_t* ag, ric_ag_t* ric, const ric_indication_t* indication)
 {
   assert(ag != NULL);
   assert(indication != NULL);
 
   byte_array_t ba = e2ap_enc_indication_ag(&ag->ap, indication);
-  e2ap_send_bytes_agent(&ag->ep, ba);
+  e2ap_send_bytes_agent(&ric->ep, ba);
   free_byte_array(ba);
 }
 
-void e2_send_subscription_delete_response(e2_agent_t* ag, const ric_subscription_delete_response_t* sdr)
+void e2_send_subscription_delete_response(e2_agent_t* ag, ric_ag_t* ric, const ric_subscription_delete_response_t* sdr)
 {
   assert(ag != NULL);
   assert(sdr != NULL);
   byte_array_t ba = e2ap_enc_subscription_delete_response_ag(&ag->ap, sdr);
-  e2ap_send_bytes_agent(&ag->ep, ba);
+  e2ap_send_bytes_agent(&ric->ep, ba);
   free_byte_array(ba);
 }
 
-void e2_send_subscription_delete_failure(e2_agent_t* ag, const ric_subscription_delete_failure_t* sdf)
+void e2_send_subscription_delete_failure(e2_agent_t* ag, ric_ag_t* ric, const ric_subscription_delete_failure_t* sdf)
 {
   byte_array_t ba = e2ap_enc_subscription_delete_failure_ag(&ag->ap, sdf );
-  e2ap_send_bytes_agent(&ag->ep, ba);
+  e2ap_send_bytes_agent(&ric->ep, ba);
   free_byte_array(ba);
 }
 
-void e2_send_control_acknowledge(e2_agent_t* ag, const ric_control_acknowledge_t* ca)
+void e2_send_control_acknowledge(e2_agent_t* ag, ric_ag_t* ric, const ric_control_acknowledge_t* ca)
 {
   byte_array_t ba = e2ap_enc_control_acknowledge_ag(&ag->ap, ca);
-  e2ap_send_bytes_agent(&ag->ep, ba);
+  e2ap_send_bytes_agent(&ric->ep, ba);
   free_byte_array(ba);
 }
 
-void e2_send_control_failure(e2_agent_t* ag, const ric_control_failure_t* cf)
+void e2_send_control_failure(e2_agent_t* ag, ric_ag_t* ric, const ric_control_failure_t* cf)
 {
   byte_array_t ba = e2ap_enc_control_failure_ag(&ag->ap, cf);
-  e2ap_send_bytes_agent(&ag->ep, ba);
+  e2ap_send_bytes_agent(&ric->ep, ba);
   free_byte_array(ba);
 }
 
@@ -26,12 +26,14 @@
 #include "util/alg_ds/ds/assoc_container/bimap.h"
 #include "util/alg_ds/ds/tsq/tsq.h"
 
+#include "util/backoff.h"
 #include "util/conf_file.h"
 #include "util/ngran_types.h"
 
 #include "asio_agent.h"
 #include "e2ap_agent.h"
 #include "endpoint_agent.h"
+#include "lib/conn_state.h"
 #include "plugin_agent.h"
 #include "sm/sm_io.h"
 
@@ -51,11 +53,43 @@ static_assert(0!=0, "Unknown E2AP version");
 
 typedef struct e2_agent_s e2_agent_t;
 
-typedef e2ap_msg_t (*handle_msg_fp_agent)(struct e2_agent_s*, const e2ap_msg_t* msg) ;
+// Association with one nearRT-RIC. Each one runs its own E2 Setup and owns
+// its subscriptions, as the RIC Request IDs of different nearRT-RICs collide 
+typedef struct ric_ag_s
+{
+  e2ap_ep_ag_t ep; 
+
+  // Position in e2_agent_t::ric
+  uint16_t idx;
+
+  // Registered Indication events. Identical periodic subscriptions of
+  // different nearRT-RICs share the fd of the timer
+  bi_map_t ind_event; // key1:int fd, key2:ind_event_t 
+
+  // Pending events
+  bi_map_t pending;  // left: fd, right: pending_event_t 
+
+  // Delay of the E2 Setup Request retries 
+  backoff_t backoff;
+
+#if defined(E2AP_V2) || defined (E2AP_V3)
+  _Atomic uint32_t trans_id_setup_req;
+#endif
+} ric_ag_t;
+
+typedef struct{
+  char const* addr;
+  int port;
+} ric_addr_ag_t;
+
+typedef e2ap_msg_t (*handle_msg_fp_agent)(struct e2_agent_s*, ric_ag_t* ric, const e2ap_msg_t* msg) ;
 
 typedef struct e2_agent_s 
 {
-  e2ap_ep_ag_t ep; 
+  // nearRT-RICs
+  size_t len_ric;
+  ric_ag_t* ric;
+
   e2ap_agent_t ap;
   asio_agent_t io;
 
@@ -65,22 +99,21 @@ typedef struct e2_agent_s
   // Registered SMs
   plugin_ag_t plugin;
 
-  // Registered Periodic Indication events
+  // Protects the ind_event of every nearRT-RIC
   pthread_mutex_t mtx_ind_event;
-  bi_map_t ind_event; // key1:int fd, key2:ind_event_t 
-
-  // Pending events
-  bi_map_t pending;  // left: fd, right: pending_event_t 
 
   global_e2_node_id_t global_e2_node_id;
 
+  // Connection state changes of the nearRT-RICs. NULL for none
+  conn_state_cb conn_cb;
+  void* conn_data;
+
   // Aperiodic Indication events
   tsq_t aind; // aind_event_t Events that occurred 
 
 #if defined(E2AP_V2) || defined (E2AP_V3)
   // Read RAN 
   void (*read_setup_ran)(void* data, const ngran_node_t node_type);
-  _Atomic uint32_t trans_id_setup_req;
 #endif
 
   atomic_bool stop_token;
@@ -89,30 +122,55 @@ typedef struct e2_agent_s
 
 e2_agent_t* e2_init_agent(const char* addr, int port, global_e2_node_id_t ge2nid, sm_io_ag_ran_t io, char const*  libs_dir);
 
+// One association per nearRT-RIC
+e2_agent_t* e2_init_multi_ric_agent(size_t len, ric_addr_ag_t const addr[len], global_e2_node_id_t ge2nid, sm_io_ag_ran_t io, char const*  libs_dir);
+
+// E2 Setup retries of every nearRT-RIC, see util/backoff.h. 
+// Call it before e2_start_agent()
+void backoff_e2_agent(e2_agent_t* ag, int64_t base_ms, int64_t max_ms);
+
+// Call it before e2_start_agent()
+void conn_state_cb_e2_agent(e2_agent_t* ag, conn_state_cb cb, void* data);
+
 // Blocking call
 void e2_start_agent(e2_agent_t* ag);
 
 void e2_free_agent(e2_agent_t* ag);
      
+// The RIC Request ID that the SM received at subscription, see 
+// ric_req_id_agent()
 void e2_async_event_agent(e2_agent_t* ag, uint32_t ric_req_id, void* ind_data);
 
+// The SMs and the RAN see the RIC Request IDs of the nearRT-RIC at idx 0
+// unchanged, and the ones of the others with the idx in the upper 16 bits 
+uint32_t ric_req_id_agent(ric_ag_t const* ric, uint32_t ric_req_id);
+
+// One-shot timer of the E2 Setup Request, armed with the next delay of the
+// backoff. It replaces the armed one, if any
+void arm_setup_timer_agent(e2_agent_t* ag, ric_ag_t* ric);
+
+// false if not armed, e.g., a duplicated E2 Setup Response
+bool stop_setup_timer_agent(e2_agent_t* ag, ric_ag_t* ric);
+
+void notify_conn_state_agent(e2_agent_t const* ag, ric_ag_t const* ric, conn_state_e state);
+
 ///////////////////////////////////////////////
 // E2AP AGENT FUNCTIONAL PROCEDURES MESSAGES //
 ///////////////////////////////////////////////
 
-void e2_send_subscription_response(e2_agent_t* ag, const ric_subscription_response_t* sr);
+void e2_send_subscription_response(e2_agent_t* ag, ric_ag_t* ric, const ric_subscription_response_t* sr);
 
-void e2_send_subscription_failure(e2_agent_t* ag, const ric_subscription_failure_t* sf);
+void e2_send_subscription_failure(e2_agent_t* ag, ric_ag_t* ric, const ric_subscription_failure_t* sf);
 
-void e2_send_subscription_delete_response(e2_agent_t* ag, const ric_subscription_delete_response_t* sdr);
+void e2_send_subscription_delete_response(e2_agent_t* ag, ric_ag_t* ric, const ric_subscription_delete_response_t* sdr);
 
-void e2_send_subscription_delete_failure(e2_agent_t* ag, const ric_subscription_delete_failure_t* sdf);
+void e2_send_subscription_delete_failure(e2_agent_t* ag, ric_ag_t* ric, const ric_subscription_delete_failure_t* sdf);
 
-void e2_send_indication_agent(e2_agent_t* ag, const ric_indication_t* indication);
+void e2_send_indication_agent(e2_agent_t* ag, ric_ag_t* ric, const ric_indication_t* indication);
 
-void e2_send_control_acknowledge(e2_agent_t* ag, const ric_control_acknowledge_t* ca);
+void e2_send_control_acknowledge(e2_agent_t* ag, ric_ag_t* ric, const ric_control_acknowledge_t* ca);
 
-void e2_send_control_failure(e2_agent_t* ag, const ric_control_failure_t* cf);
+void e2_send_control_failure(e2_agent_t* ag, ric_ag_t* ric, const ric_control_failure_t* cf);
 
 ////////////////////////////////////////////////
 
@@ -25,12 +25,18 @@
 #include <pthread.h>                                       // for pthread_cr...
 #include <stdlib.h>
 #include <stdio.h>                                         // for NULL
+#include <string.h>
 #include "e2_agent.h"                                      // for e2_free_agent
 #include "lib/e2ap/e2ap_global_node_id_wrapper.h"  // for global_e2_...
 #include "lib/e2ap/e2ap_plmn_wrapper.h"            // for plmn_t
 #include "util/ngran_types.h"                              // for ngran_gNB
 #include "util/conf_file.h"
+#include "lib/ep/e2ap_capture.h"
+#include "lib/asio_uring.h"
+#include "util/mem_acct.h"
 
+// Entries of the NEAR_RIC_IP_LIST key
+#define MAX_NEAR_RIC_AGENT 8
 
 static
 e2_agent_t* agent = NULL;
@@ -38,6 +44,15 @@ e2_agent_t* agent = NULL;
 static
 pthread_t thrd_agent;
 
+static
+sim_clock_t* sim_clk = NULL;
+
+static
+conn_state_cb conn_cb = NULL;
+
+static
+void* conn_data = NULL;
+
 static inline
 void* static_start_agent(void* a)
 {
@@ -70,6 +85,59 @@ global_e2_node_id_t init_ge2ni(ngran_node_t ran_type, e2ap_plmn_t plmn, int nb_i
 
 
 
+static
+void init_io_backend(fr_args_t const* args)
+{
+  char* name = get_conf_io_backend(args);
+  if(name != NULL && set_backend_str_asio(name) == false)
+    printf("[E2 AGENT]: Unknown IO_BACKEND %s. Using %s\n", name, backend_asio_str(backend_asio()));
+  free(name);
+}
+
+static
+void init_backoff_agent(fr_args_t const* args)
+{
+  char* conf = get_conf_reconnect_backoff(args);
+  backoff_t b = {0};
+  init_conf_backoff(&b, conf);
+  free(conf);
+
+  backoff_e2_agent(agent, b.base_ms, b.max_ms);
+}
+
+// The addresses of the NEAR_RIC_IP_LIST key or, if absent, the one of the 
+// NEAR_RIC_IP key or the command line 
+static
+size_t init_near_ric_ips(fr_args_t const* args, size_t len, char* ips[len])
+{
+  char* list = args->ip == NULL ? get_conf_near_ric_ip_list(args) : NULL;
+  if(list == NULL){
+    ips[0] = get_near_ric_ip(args);
+    return 1;
+  }
+
+  size_t n = 0;
+  char* save = NULL;
+  for(char* tok = strtok_r(list, ",", &save); tok != NULL; tok = strtok_r(NULL, ",", &save)){
+    while(*tok == ' ' || *tok == '\t')
+      ++tok;
+    size_t sz = strlen(tok);
+    while(sz > 0 && (tok[sz-1] == ' ' || tok[sz-1] == '\t'))
+      tok[--sz] = '\0';
+    if(sz == 0)
+      continue;
+
+    assert(n < len && "Too many nearRT-RICs in NEAR_RIC_IP_LIST");
+    ips[n] = strdup(tok);
+    assert(ips[n] != NULL && "Memory exhausted");
+    ++n;
+  }
+  free(list);
+
+  assert(n > 0 && "Empty NEAR_RIC_IP_LIST");
+  return n;
+}
+
 void init_agent_api(int mcc, 
                     int mnc, 
                     int mnc_digit_len,
@@ -86,7 +154,8 @@ void init_agent_api(int mcc,
   assert(nb_id > 0);
   assert(ran_type >= 0);
 
-  char* server_ip_str = get_near_ric_ip(args);
+  char* server_ip_str[MAX_NEAR_RIC_AGENT] = {0};
+  size_t const len_ric = init_near_ric_ips(args, MAX_NEAR_RIC_AGENT, server_ip_str);
 
   const e2ap_plmn_t plmn = {.mcc = mcc, .mnc = mnc, .mnc_digit_len = mnc_digit_len};
   global_e2_node_id_t ge2ni = init_ge2ni(ran_type, plmn, nb_id, cu_du_id ); 
@@ -95,24 +164,50 @@ void init_agent_api(int mcc,
 
   char* ran_type_str = get_ngran_name(ran_type);
   char str[128] = {0};
-  int it = sprintf(str, "[E2 AGENT]: nearRT-RIC IP Address = %s, PORT = %d, RAN type = %s, nb_id = %d", server_ip_str, e2ap_server_port, ran_type_str, nb_id);
-  assert(it > 0);
-  if(ge2ni.cu_du_id != NULL){
-    it = sprintf(str+it, ", cu_du_id = %ld\n", *ge2ni.cu_du_id);
-    assert(it > 0);
-  } else {
-    it = sprintf(str+it, "\n" );
+  int it = 0;
+  for(size_t i = 0; i < len_ric; ++i){
+    it = sprintf(str, "[E2 AGENT]: nearRT-RIC IP Address = %s, PORT = %d, RAN type = %s, nb_id = %d", server_ip_str[i], e2ap_server_port, ran_type_str, nb_id);
     assert(it > 0);
+    if(ge2ni.cu_du_id != NULL){
+      it = sprintf(str+it, ", cu_du_id = %ld\n", *ge2ni.cu_du_id);
+      assert(it > 0);
+    } else {
+      it = sprintf(str+it, "\n" );
+      assert(it > 0);
+    }
+    assert(it < 128);
+    printf("%s" ,str);
+  }
+
+  init_conf_e2ap_capture(args);
+  init_io_backend(args);
+
+  ric_addr_ag_t addr[MAX_NEAR_RIC_AGENT] = {0};
+  for(size_t i = 0; i < len_ric; ++i)
+    addr[i] = (ric_addr_ag_t){.addr = server_ip_str[i], .port = e2ap_server_port};
+
+  agent = e2_init_multi_ric_agent(len_ric, addr, ge2ni, io, args->libs_dir);
+  if(enabled_e2ap_capture() == true){
+    // The peer is always the nearRT-RIC, tag the local E2 node instead
+    for(size_t i = 0; i < len_ric; ++i){
+      char tag[160] = {0};
+      it = snprintf(tag, sizeof(tag), "nearRT-RIC %s from %s mcc %d mnc %d nb_id %d", server_ip_str[i], ran_type_str, mcc, mnc, nb_id);
+      if(ge2ni.cu_du_id != NULL && it > 0 && it < (int)sizeof(tag))
+        snprintf(tag + it, sizeof(tag) - it, " cu_du_id %d", cu_du_id);
+      tag_e2ap_capture(&agent->ric[i].ep.to, tag);
+    }
   }
-  assert(it < 128);
-  printf("%s" ,str);
 
-  agent = e2_init_agent(server_ip_str, e2ap_server_port, ge2ni, io, args->libs_dir);
+  // Before the agent thread arms any timer
+  agent->io.clk = sim_clk;
+  init_backoff_agent(args);
+  conn_state_cb_e2_agent(agent, conn_cb, conn_data);
 
   // Spawn a new thread for the agent
   const int rc = pthread_create(&thrd_agent, NULL, static_start_agent, NULL);
   assert(rc == 0);
-  free(server_ip_str);
+  for(size_t i = 0; i < len_ric; ++i)
+    free(server_ip_str[i]);
 }
 
 void stop_agent_api(void)
@@ -121,6 +216,16 @@ void stop_agent_api(void)
   e2_free_agent(agent);
   int const rc = pthread_join(thrd_agent,NULL);
   assert(rc == 0);
+
+  free_e2ap_capture();
+
+  if(sim_clk != NULL){
+    free_sim_clock(sim_clk);
+    free(sim_clk);
+    sim_clk = NULL;
+  }
+
+  report_leaks_mem_acct("E2 AGENT", stdout);
 }
 
 void async_event_agent_api(uint32_t ric_req_id, void* ind_data)
@@ -129,3 +234,33 @@ void async_event_agent_api(uint32_t ric_req_id, void* ind_data)
   e2_async_event_agent(agent, ric_req_id, ind_data);
 }
 
+void conn_state_cb_agent_api(conn_state_cb cb, void* data)
+{
+  assert(agent == NULL && "Call it before init_agent_api()");
+
+  conn_cb = cb;
+  conn_data = data;
+}
+
+void init_sim_clock_agent_api(int64_t now_ms)
+{
+  assert(agent == NULL && "Call it before init_agent_api()");
+  assert(sim_clk == NULL);
+
+  sim_clk = calloc(1, sizeof(sim_clock_t));
+  assert(sim_clk != NULL && "Memory exhausted");
+  init_sim_clock(sim_clk, now_ms);
+}
+
+int64_t now_sim_clock_agent_api(void)
+{
+  assert(sim_clk != NULL && "Simulation clock not initialized");
+  return now_sim_clock(sim_clk);
+}
+
+uint64_t advance_sim_clock_agent_api(int64_t delta_ms)
+{
+  assert(sim_clk != NULL && "Simulation clock not initialized");
+  return advance_sim_clock(sim_clk, delta_ms);
+}
+
@@ -22,10 +22,13 @@
 #ifndef E2_AGENT_API_MOSAIC_H
 #define E2_AGENT_API_MOSAIC_H
 
+#include "../lib/conn_state.h"
 #include "../sm/sm_io.h"
 #include "../util/conf_file.h"
 #include "../util/ngran_types.h"
 
+#include <stdint.h>
+
 void init_agent_api(int mcc, 
                     int mnc, 
                     int mnc_digit_len,
@@ -39,5 +42,21 @@ void stop_agent_api(void);
 
 void async_event_agent_api(uint32_t ric_req_id, void* ind_data);
 
+// Connection state changes of the nearRT-RICs, e.g., the E2 Node lost one.
+// The E2 Setup retries follow the RECONNECT_BACKOFF key of the conf file.
+// Call it before init_agent_api()
+void conn_state_cb_agent_api(conn_state_cb cb, void* data);
+
+// Simulation time, e.g., ns-3. The subscription periods expire when the
+// simulator advances the clock, and not with the wall clock. 
+// Call it before init_agent_api()
+void init_sim_clock_agent_api(int64_t now_ms);
+
+int64_t now_sim_clock_agent_api(void);
+
+// Fires the subscriptions due in (now, now + delta_ms]. Returns the
+// number of expirations
+uint64_t advance_sim_clock_agent_api(int64_t delta_ms);
+
 #endif
 
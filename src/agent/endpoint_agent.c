@@ -64,13 +64,33 @@ void init_sctp_conn_client(e2ap_ep_ag_t* ep, const char* addr, int port)
   ((char*)(&ep->base.addr))[15] = '\0';
 }
 
+static
+void init_mem_conn_client(e2ap_ep_ag_t* ep, const char* addr, int port)
+{
+  struct sockaddr_in servaddr = { .sin_family = AF_INET,
+                                  .sin_port = htons(port)}; 
+
+  int rc = inet_pton(AF_INET, addr, &servaddr.sin_addr);
+  assert(rc == 1);
+
+  ep->to = servaddr;
+  *(int*)(&ep->base.port) = port; 
+  *(int*)(&ep->base.fd) = e2ap_ep_connect_mem(&ep->base, addr, port);
+  strncpy((char*)(&ep->base.addr), addr, 15);
+  ((char*)(&ep->base.addr))[15] = '\0';
+}
+
 void e2ap_init_ep_agent(e2ap_ep_ag_t* ep, const char* addr, int port)
 {
   assert(ep != NULL);
   assert(addr != NULL);
   assert(strlen(addr) < 16);
   assert(port > 0 && port < 65535);
-  init_sctp_conn_client(ep, addr, port);
+
+  if(enabled_mem_ep() == true)
+    init_mem_conn_client(ep, addr, port);
+  else
+    init_sctp_conn_client(ep, addr, port);
 }
 
 /*
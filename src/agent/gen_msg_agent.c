@@ -25,9 +25,10 @@
 #include <stdlib.h>
 
 #ifdef E2AP_V1
-e2_setup_request_t gen_setup_request_v1(e2_agent_t* ag)
+e2_setup_request_t gen_setup_request_v1(e2_agent_t* ag, ric_ag_t* ric)
 {
   assert(ag != NULL);
+  assert(ric != NULL);
 
   const size_t len_rf = assoc_size(&ag->plugin.sm_ds);
   assert(len_rf > 0 && "No RAN function/service model registered. Check if the Service Models are located at shared library paths, default location is /usr/local/lib/flexric/ ");
@@ -66,9 +67,10 @@ e2_setup_request_t gen_setup_request_v1(e2_agent_t* ag)
   return sr;
 }
 #elif defined(E2AP_V2) || defined (E2AP_V3)
-e2_setup_request_t gen_setup_request_v2(e2_agent_t* ag)
+e2_setup_request_t gen_setup_request_v2(e2_agent_t* ag, ric_ag_t* ric)
 {
   assert(ag != NULL);
+  assert(ric != NULL);
 
   const size_t len_rf = assoc_size(&ag->plugin.sm_ds);
   assert(len_rf > 0 && "No RAN function/service model registered. Check if the Service Models are located at shared library paths, default location is /usr/local/lib/flexric/ ");
@@ -78,7 +80,7 @@ e2_setup_request_t gen_setup_request_v2(e2_agent_t* ag)
 
   // ToDO: Transaction ID needs to be considered within the pending messages
   e2_setup_request_t sr = {
-    .trans_id = ag->trans_id_setup_req++,
+    .trans_id = ric->trans_id_setup_req++,
     .id = cp_global_e2_node_id(&ag->global_e2_node_id),
     .ran_func_item = ran_func,
     .len_rf = len_rf,
@@ -111,17 +113,17 @@ e2_setup_request_t gen_setup_request_v2(e2_agent_t* ag)
   return sr;
 }
 
-e2_setup_request_t gen_setup_request_v3(e2_agent_t* ag)
+e2_setup_request_t gen_setup_request_v3(e2_agent_t* ag, ric_ag_t* ric)
 {
-  return gen_setup_request_v2(ag);
+  return gen_setup_request_v2(ag, ric);
 }
 
 
 /*
 #elif defined(E2AP_V3
-e2_setup_request_t gen_setup_request_v3(e2_agent_t* ag)
+e2_setup_request_t gen_setup_request_v3(e2_agent_t* ag, ric_ag_t* ric)
 {
-  return gen_setup_request_v2(ag);
+  return gen_setup_request_v2(ag, ric);
 }
 */
 
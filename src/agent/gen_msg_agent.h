@@ -25,16 +25,16 @@
 #include "e2_agent.h"
 #include "lib/e2ap/e2_setup_request_wrapper.h"
 
-e2_setup_request_t gen_setup_request_v1(e2_agent_t* ag);
+e2_setup_request_t gen_setup_request_v1(e2_agent_t* ag, ric_ag_t* ric);
 
-e2_setup_request_t gen_setup_request_v2(e2_agent_t* ag);
+e2_setup_request_t gen_setup_request_v2(e2_agent_t* ag, ric_ag_t* ric);
 
-e2_setup_request_t gen_setup_request_v3(e2_agent_t* ag);
+e2_setup_request_t gen_setup_request_v3(e2_agent_t* ag, ric_ag_t* ric);
 
 
-#define gen_setup_request(T,U) _Generic ((T), e2ap_v1_t*: gen_setup_request_v1, \
+#define gen_setup_request(T,U,V) _Generic ((T), e2ap_v1_t*: gen_setup_request_v1, \
                                               e2ap_v2_t*: gen_setup_request_v2, \
                                              e2ap_v3_t*: gen_setup_request_v3, \
-                                             default: gen_setup_request_v1) (U)
+                                             default: gen_setup_request_v1) (U,V)
 
 #endif
@@ -30,6 +30,8 @@
 
 #include <assert.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 static
 bool check_valid_msg_type(e2_msg_type_t msg_type )
@@ -60,37 +62,106 @@ bool not_aperiodic_ind_event(int fd)
 }
 
 static
-bool stop_ind_event(e2_agent_t* ag, ric_gen_id_t id)
+bool used_fd_ind_event_ric(ric_ag_t const* ric, int fd)
+{
+  assert(ric != NULL);
+
+  assoc_rb_tree_t* left = (assoc_rb_tree_t*)&ric->ind_event.left;
+  void* it = find_if(left, assoc_front(left), assoc_end(left), &fd, eq_fd);
+  return it != assoc_end(left);
+}
+
+// Timer of a periodic subscription of any nearRT-RIC
+static
+bool used_fd_ind_event(e2_agent_t* ag, int fd)
+{
+  assert(ag != NULL);
+  assert(fd > 0);
+
+  for(size_t i = 0; i < ag->len_ric; ++i){
+    if(used_fd_ind_event_ric(&ag->ric[i], fd))
+      return true;
+  }
+  return false;
+}
+
+typedef struct{
+  ric_ag_t const* ric;
+  uint16_t ran_func_id;
+  byte_array_t subs;
+} same_subs_t;
+
+static
+bool eq_subs(void const* value, void const* key)
+{
+  same_subs_t const* s = (same_subs_t const*)value; 
+  ind_event_t const* ev = (ind_event_t const*)key;
+
+  return ev->type == PERIODIC_SUBSCRIPTION_FLRC
+      && ev->ric_id.ran_func_id == s->ran_func_id
+      && eq_byte_array(&ev->subs, &s->subs);
+}
+
+// An equal periodic subscription of another nearRT-RIC. Its timer is shared 
+// as the SM would read and encode the same indication twice otherwise 
+static
+int shared_fd_ind_event(e2_agent_t* ag, same_subs_t const* s)
 {
   assert(ag != NULL);
+  assert(s != NULL);
+
+  for(size_t i = 0; i < ag->len_ric; ++i){
+    if(i == s->ric->idx)
+      continue;
+
+    assoc_rb_tree_t* right = &ag->ric[i].ind_event.right;
+    void* it = find_if_rb_tree(right, assoc_rb_tree_front(right), assoc_rb_tree_end(right), (void*)s, eq_subs); 
+    if(it == assoc_rb_tree_end(right))
+      continue;
+
+    int const fd = *(int*)assoc_rb_tree_value(right, it);
+    // A nearRT-RIC subscribes once per timer, as the fd is its key 
+    if(used_fd_ind_event_ric(s->ric, fd) == false)
+      return fd;
+  }
+  return -1;
+}
+
+static
+bool stop_ind_event(e2_agent_t* ag, ric_ag_t* ric, ric_gen_id_t id)
+{
+  assert(ag != NULL);
+  assert(ric != NULL);
   ind_event_t tmp = {.ric_id = id, .sm = NULL, .action_id =0 };
 
   // Fix this! bi_map should liberate the memory itself 
-  void* start_r = assoc_rb_tree_front(&ag->ind_event.right);
-  void* end_r = assoc_rb_tree_end(&ag->ind_event.right);
-  void* it_r = find_if_rb_tree(&ag->ind_event.right, start_r, end_r, &tmp, eq_ind_event); 
+  void* start_r = assoc_rb_tree_front(&ric->ind_event.right);
+  void* end_r = assoc_rb_tree_end(&ric->ind_event.right);
+  void* it_r = find_if_rb_tree(&ric->ind_event.right, start_r, end_r, &tmp, eq_ind_event); 
   if(it_r == end_r){
     printf("[E2 AGENT]: RAN_FUNC_ID %d RIC_REQ_ID %d not found. Spuriously occurs when abruptly closing the xApp\n", id.ran_func_id, id.ric_req_id);
     return false;;
   }
 
   assert(it_r != end_r);
-  ind_event_t* ind_ev = assoc_rb_tree_key(&ag->ind_event.right, it_r);
+  ind_event_t* ind_ev = assoc_rb_tree_key(&ric->ind_event.right, it_r);
 
   // These 4 lines need refactoring
   if(ind_ev->sm->free_act_def != NULL)
     ind_ev->sm->free_act_def(ind_ev->sm, ind_ev->act_def);
   //
   if(ind_ev->type == APERIODIC_SUBSCRIPTION_FLRC)
-    ind_ev->free_subs_aperiodic(id.ric_req_id);
+    ind_ev->free_subs_aperiodic(ric_req_id_agent(ric, id.ric_req_id));
 
+  free_byte_array(ind_ev->subs);
 
   void (*free_ind_event)(void*) = NULL;
-  int* fd = bi_map_extract_right(&ag->ind_event, &tmp, sizeof(tmp), free_ind_event);
+  int* fd = bi_map_extract_right(&ric->ind_event, &tmp, sizeof(tmp), free_ind_event);
   assert(*fd > -1);
   //printf("fd value in stopping pending event = %d \n", *fd);
  
-  if(not_aperiodic_ind_event(*fd))
+  // Other nearRT-RICs may still use the timer
+  if(not_aperiodic_ind_event(*fd) && used_fd_ind_event(ag, *fd) == false)
     rm_fd_asio_agent(&ag->io, *fd);
   free(fd);
 
@@ -119,13 +190,14 @@ void init_handle_msg_agent(size_t len, handle_msg_fp_agent (*handle_msg)[len])
   (*handle_msg)[E2_CONNECTION_UPDATE] =  e2ap_handle_connection_update_agent;
 }
 
-e2ap_msg_t e2ap_msg_handle_agent(e2_agent_t* ag, const e2ap_msg_t* msg)
+e2ap_msg_t e2ap_msg_handle_agent(e2_agent_t* ag, ric_ag_t* ric, const e2ap_msg_t* msg)
 {
+  assert(ric != NULL);
   assert(msg != NULL);
   const e2_msg_type_t msg_type = msg->type;
   assert(check_valid_msg_type(msg_type) == true);
   assert(ag->handle_msg[ msg_type ] != NULL);
-  return ag->handle_msg[msg_type](ag, msg); 
+  return ag->handle_msg[msg_type](ag, ric, msg); 
 }
 
 static inline
@@ -138,12 +210,13 @@ bool supported_ric_subscription_request(ric_subscription_request_t const* sr)
 }
 
 static
-sm_subs_data_t generate_sm_subs_data(ric_subscription_request_t const* sr)
+sm_subs_data_t generate_sm_subs_data(ric_ag_t const* ric, ric_subscription_request_t const* sr)
 {
+  assert(ric != NULL);
   assert(sr != NULL);
   sm_subs_data_t data =  { .event_trigger = sr->event_trigger.buf,
                            .len_et = sr->event_trigger.len,
-                           .ric_req_id = sr->ric_id.ric_req_id };
+                           .ric_req_id = ric_req_id_agent(ric, sr->ric_id.ric_req_id) };
 
   if(sr->action->definition != NULL){
     data.action_def = sr->action->definition->buf;
@@ -153,6 +226,29 @@ sm_subs_data_t generate_sm_subs_data(ric_subscription_request_t const* sr)
   return data;
 }
 
+// Event trigger and action definition as received. The length of the event 
+// trigger prefixes it, so that different splits never compare equal 
+static
+byte_array_t subs_bytes(ric_subscription_request_t const* sr)
+{
+  assert(sr != NULL);
+
+  size_t const len_et = sr->event_trigger.len;
+  size_t const len_ad = sr->action->definition != NULL ? sr->action->definition->len : 0;
+
+  byte_array_t ba = {.len = sizeof(len_et) + len_et + len_ad};
+  ba.buf = malloc(ba.len);
+  assert(ba.buf != NULL && "Memory exhausted");
+
+  memcpy(ba.buf, &len_et, sizeof(len_et));
+  if(len_et > 0)
+    memcpy(ba.buf + sizeof(len_et), sr->event_trigger.buf, len_et);
+  if(len_ad > 0)
+    memcpy(ba.buf + sizeof(len_et) + len_et, sr->action->definition->buf, len_ad);
+
+  return ba;
+}
+
 static
 ric_subscription_response_t generate_subscription_response(ric_gen_id_t const* ric_id, uint8_t ric_act_id)
 {
@@ -169,9 +265,10 @@ ric_subscription_response_t generate_subscription_response(ric_gen_id_t const* r
   return sr; 
 }
 
-e2ap_msg_t e2ap_handle_subscription_request_agent(e2_agent_t* ag, const e2ap_msg_t* msg)
+e2ap_msg_t e2ap_handle_subscription_request_agent(e2_agent_t* ag, ric_ag_t* ric, const e2ap_msg_t* msg)
 {
   assert(ag != NULL);
+  assert(ric != NULL);
   assert(msg != NULL);
   assert(msg->type == RIC_SUBSCRIPTION_REQUEST);
 
@@ -180,8 +277,17 @@ e2ap_msg_t e2ap_handle_subscription_request_agent(e2_agent_t* ag, const e2ap_msg
 
   printf("[E2 AGENT]: RIC_SUBSCRIPTION_REQUEST rx RAN_FUNC_ID %d RIC_REQ_ID %d\n", sr->ric_id.ran_func_id, sr->ric_id.ric_req_id);
 
-  sm_subs_data_t data = generate_sm_subs_data(sr);
   uint16_t const ran_func_id = sr->ric_id.ran_func_id; 
+
+  if(has_sm_plugin_ag(&ag->plugin, ran_func_id) == false){
+    printf("[E2-AGENT]: SUBSCRIPTION FAILURE tx for unknown RAN_FUNC_ID %d\n", ran_func_id);
+    cause_t const cause = {.present = CAUSE_RICREQUEST, .ricRequest = CAUSE_RIC_RAN_FUNCTION_ID_INVALID};
+    e2ap_msg_t ans = {.type = RIC_SUBSCRIPTION_FAILURE, 
+                      .u_msgs.ric_sub_fail = init_ric_subscription_failure(sr->ric_id, cause)};
+    return ans;
+  }
+
+  sm_subs_data_t data = generate_sm_subs_data(ric, sr);
   sm_agent_t* sm = sm_plugin_ag(&ag->plugin, ran_func_id);
   
   //subscribe_timer_t t = sm->proc.on_subscription(sm, &data);
@@ -201,16 +307,20 @@ e2ap_msg_t e2ap_handle_subscription_request_agent(e2_agent_t* ag, const e2ap_msg
     ev.act_def = t.act_def;
     // Periodic indication message generated i.e., every 5 ms
     assert(t.ms < 10001 && "Subscription for granularity larger than 10 seconds requested? ");
-    int fd_timer = create_timer_ms_asio_agent(&ag->io, t.ms, t.ms); 
+    ev.subs = subs_bytes(sr);
     lock_guard(&ag->mtx_ind_event);
-    bi_map_insert(&ag->ind_event, &fd_timer, sizeof(fd_timer), &ev, sizeof(ev));
+    same_subs_t const s = {.ric = ric, .ran_func_id = ran_func_id, .subs = ev.subs};
+    int fd_timer = shared_fd_ind_event(ag, &s);
+    if(fd_timer == -1)
+      fd_timer = create_ran_timer_ms_asio_agent(&ag->io, t.ms, t.ms); 
+    bi_map_insert(&ric->ind_event, &fd_timer, sizeof(fd_timer), &ev, sizeof(ev));
   } else if(ev.type == APERIODIC_SUBSCRIPTION_FLRC){
     ev.free_subs_aperiodic = subs.aper.free_aper_subs;
     // Aperiodic indication generated i.e., the RAN will generate it via 
     // void async_event_agent_api(uint32_t ric_req_id, void* ind_data);
     int fd = 0;
     lock_guard(&ag->mtx_ind_event);
-    bi_map_insert(&ag->ind_event, &fd, sizeof(int), &ev, sizeof(ev));
+    bi_map_insert(&ric->ind_event, &fd, sizeof(int), &ev, sizeof(ev));
   } else {
     assert(0!=0 && "Unknown subscritpion timer value");
   }
@@ -223,9 +333,10 @@ e2ap_msg_t e2ap_handle_subscription_request_agent(e2_agent_t* ag, const e2ap_msg
   return ans;
 }
 
-e2ap_msg_t e2ap_handle_subscription_delete_request_agent(e2_agent_t* ag, const e2ap_msg_t* msg)
+e2ap_msg_t e2ap_handle_subscription_delete_request_agent(e2_agent_t* ag, ric_ag_t* ric, const e2ap_msg_t* msg)
 {
   assert(ag != NULL);
+  assert(ric != NULL);
   assert(msg != NULL);
   assert(msg->type == RIC_SUBSCRIPTION_DELETE_REQUEST);
 
@@ -233,7 +344,7 @@ e2ap_msg_t e2ap_handle_subscription_delete_request_agent(e2_agent_t* ag, const e
 
   printf("[E2-AGENT]: RIC_SUBSCRIPTION_DELETE_REQUEST rx RAN_FUNC_ID %d  RIC_REQ_ID %d  \n", sdr->ric_id.ran_func_id, sdr->ric_id.ric_req_id);
 
-  stop_ind_event(ag, sdr->ric_id);
+  stop_ind_event(ag, ric, sdr->ric_id);
   //bool const found_ind_event = stop_ind_event(ag, sdr->ric_id);
   //if(found_ind_event == false){
   //  return ( e2ap_msg_t ){.type = NONE_E2_MSG_TYPE };
@@ -269,27 +380,52 @@ byte_array_t* ba_from_ctrl_out(sm_ctrl_out_data_t const* data)
 }
 
 // The purpose of the RIC Control procedure is to initiate or resume a specific functionality in the E2 Node.
-e2ap_msg_t e2ap_handle_control_request_agent(e2_agent_t* ag, const e2ap_msg_t* msg)
+e2ap_msg_t e2ap_handle_control_request_agent(e2_agent_t* ag, ric_ag_t* ric, const e2ap_msg_t* msg)
 {
   assert(ag != NULL);
+  assert(ric != NULL);
   assert(msg != NULL);
   assert(msg->type == RIC_CONTROL_REQUEST);
  
   ric_control_request_t const* ctrl_req = &msg->u_msgs.ric_ctrl_req;
-  assert(ctrl_req->ack_req != NULL && *ctrl_req->ack_req == RIC_CONTROL_REQUEST_ACK );
+
+  // An absent RIC Control Ack Request IE is treated as Ack
+  ric_control_ack_req_t const ack = ctrl_req->ack_req == NULL ? RIC_CONTROL_REQUEST_ACK : *ctrl_req->ack_req;
+  assert(ack == RIC_CONTROL_REQUEST_NO_ACK || ack == RIC_CONTROL_REQUEST_ACK || ack == RIC_CONTROL_REQUEST_NACK);
+
+  uint16_t const ran_func_id = ctrl_req->ric_id.ran_func_id; 
+
+  if(has_sm_plugin_ag(&ag->plugin, ran_func_id) == false){
+    printf("[E2-AGENT]: CONTROL REQUEST for unknown RAN_FUNC_ID %d\n", ran_func_id);
+    if(ack == RIC_CONTROL_REQUEST_NO_ACK){
+      e2ap_msg_t ans = {.type = NONE_E2_MSG_TYPE};
+      return ans;
+    }
+
+    printf("[E2-AGENT]: CONTROL FAILURE tx\n");
+    e2ap_msg_t ans = {.type = RIC_CONTROL_FAILURE};
+    ans.u_msgs.ric_ctrl_fail.ric_id = ctrl_req->ric_id;
+    ans.u_msgs.ric_ctrl_fail.cause.present = CAUSE_RICREQUEST;
+    ans.u_msgs.ric_ctrl_fail.cause.ricRequest = CAUSE_RIC_RAN_FUNCTION_ID_INVALID;
+    return ans;
+  }
 
   sm_ctrl_req_data_t data = {.ctrl_hdr = ctrl_req->hdr.buf,
                           .len_hdr = ctrl_req->hdr.len,
                           .ctrl_msg = ctrl_req->msg.buf,
                           .len_msg = ctrl_req->msg.len}; 
 
-
-  uint16_t const ran_func_id = ctrl_req->ric_id.ran_func_id; 
   sm_agent_t* sm = sm_plugin_ag(&ag->plugin, ran_func_id);
 
   sm_ctrl_out_data_t ctrl_ans = sm->proc.on_control(sm, &data);
   defer({ free_sm_ctrl_out_data(&ctrl_ans); } );
 
+  // NoAck and NAck: nothing is answered on success 
+  if(ack != RIC_CONTROL_REQUEST_ACK){
+    e2ap_msg_t ans = {.type = NONE_E2_MSG_TYPE};
+    return ans;
+  }
+
 
   byte_array_t* ba_ctrl_ans = ba_from_ctrl_out(&ctrl_ans);
 
@@ -307,9 +443,10 @@ e2ap_msg_t e2ap_handle_control_request_agent(e2_agent_t* ag, const e2ap_msg_t* m
   return ans; 
 }
 
-e2ap_msg_t e2ap_handle_error_indication_agent(e2_agent_t* ag, const e2ap_msg_t* msg)
+e2ap_msg_t e2ap_handle_error_indication_agent(e2_agent_t* ag, ric_ag_t* ric, const e2ap_msg_t* msg)
 {
   assert(ag != NULL);
+  assert(ric != NULL);
   assert(msg != NULL);
   assert(0!=0 && "Not implemented");
 
@@ -317,44 +454,37 @@ e2ap_msg_t e2ap_handle_error_indication_agent(e2_agent_t* ag, const e2ap_msg_t*
   return ans; 
 }
 
-static
-void stop_pending_event(e2_agent_t* ag, pending_event_t event)
-{
-  assert(ag != NULL);
-
-  void (*free_pending_event)(void*)=NULL;
-  int* fd = bi_map_extract_right(&ag->pending, &event, sizeof(event), free_pending_event);
-  assert(*fd > 0);
-  //printf("[E2-AGENT]: stopping pending\n");
-  //event = %d \n", *fd);
-  rm_fd_asio_agent(&ag->io, *fd);
-  free(fd);
-}
-
-
-e2ap_msg_t e2ap_handle_setup_response_agent(e2_agent_t* ag, const e2ap_msg_t* msg)
+e2ap_msg_t e2ap_handle_setup_response_agent(e2_agent_t* ag, ric_ag_t* ric, const e2ap_msg_t* msg)
 {
   assert(ag != NULL);
+  assert(ric != NULL);
   assert(msg != NULL);
   assert(msg->type == E2_SETUP_RESPONSE);
   printf("[E2-AGENT]: E2 SETUP RESPONSE rx\n");
 
-  // Stop the timer
-  pending_event_t ev = SETUP_REQUEST_PENDING_EVENT;
-  stop_pending_event(ag,ev);
+  // Stop the timer. A retry may have crossed the answer of the first request
+  if(stop_setup_timer_agent(ag, ric) == false){
+    printf("[E2-AGENT]: Duplicated E2 SETUP RESPONSE. Ignoring it\n");
+    e2ap_msg_t ans = {.type = NONE_E2_MSG_TYPE};
+    return ans; 
+  }
+  reset_backoff(&ric->backoff);
 
 #if defined(E2AP_V2) || defined(E2AP_V3)
-  assert(ag->trans_id_setup_req > 0 && "Receiving an E2 SETUP-RESPONSE, eventhough not E2 SETUP-REQUEST not sent from this E2 Node" );
-  printf("[E2-AGENT]: Transaction ID E2 SETUP-REQUEST %u E2 SETUP-RESPONSE %u \n", --ag->trans_id_setup_req, msg->u_msgs.e2_stp_resp.trans_id);
-  ag->trans_id_setup_req = 0;
+  assert(ric->trans_id_setup_req > 0 && "Receiving an E2 SETUP-RESPONSE, eventhough not E2 SETUP-REQUEST not sent from this E2 Node" );
+  printf("[E2-AGENT]: Transaction ID E2 SETUP-REQUEST %u E2 SETUP-RESPONSE %u \n", --ric->trans_id_setup_req, msg->u_msgs.e2_stp_resp.trans_id);
+  ric->trans_id_setup_req = 0;
 #endif
+  notify_conn_state_agent(ag, ric, CONNECTED_CONN_STATE);
+
   e2ap_msg_t ans = {.type = NONE_E2_MSG_TYPE};
   return ans; 
 }
 
-e2ap_msg_t e2ap_handle_setup_failure_agent(e2_agent_t* ag, const e2ap_msg_t* msg)
+e2ap_msg_t e2ap_handle_setup_failure_agent(e2_agent_t* ag, ric_ag_t* ric, const e2ap_msg_t* msg)
 {
   assert(ag != NULL);
+  assert(ric != NULL);
   assert(msg != NULL);
   assert(msg->type == E2_SETUP_FAILURE);
 
@@ -421,9 +551,10 @@ e2ap_msg_t e2ap_handle_setup_failure_agent(e2_agent_t* ag, const e2ap_msg_t* msg
   return ans; 
 }
 
-e2ap_msg_t e2ap_handle_reset_request_agent(e2_agent_t* ag, const e2ap_msg_t* msg)
+e2ap_msg_t e2ap_handle_reset_request_agent(e2_agent_t* ag, ric_ag_t* ric, const e2ap_msg_t* msg)
 {
   assert(ag != NULL);
+  assert(ric != NULL);
   assert(msg != NULL);
   assert(0!=0 && "Not implemented");
 
@@ -431,9 +562,10 @@ e2ap_msg_t e2ap_handle_reset_request_agent(e2_agent_t* ag, const e2ap_msg_t* msg
   return ans; 
 }
 
-e2ap_msg_t e2ap_handle_reset_response_agent(e2_agent_t* ag, const e2ap_msg_t* msg)
+e2ap_msg_t e2ap_handle_reset_response_agent(e2_agent_t* ag, ric_ag_t* ric, const e2ap_msg_t* msg)
 {
   assert(ag != NULL);
+  assert(ric != NULL);
   assert(msg != NULL);
   assert(0!=0 && "Not implemented");
 
@@ -441,9 +573,10 @@ e2ap_msg_t e2ap_handle_reset_response_agent(e2_agent_t* ag, const e2ap_msg_t* ms
   return ans; 
 }
   
-e2ap_msg_t e2ap_handle_service_update_ack_agent(e2_agent_t* ag, const e2ap_msg_t* msg)
+e2ap_msg_t e2ap_handle_service_update_ack_agent(e2_agent_t* ag, ric_ag_t* ric, const e2ap_msg_t* msg)
 {
   assert(ag != NULL);
+  assert(ric != NULL);
   assert(msg != NULL);
   assert(0!=0 && "Not implemented");
 
@@ -451,9 +584,10 @@ e2ap_msg_t e2ap_handle_service_update_ack_agent(e2_agent_t* ag, const e2ap_msg_t
   return ans; 
 }
 
-e2ap_msg_t e2ap_handle_service_update_failure_agent(e2_agent_t* ag, const e2ap_msg_t* msg)
+e2ap_msg_t e2ap_handle_service_update_failure_agent(e2_agent_t* ag, ric_ag_t* ric, const e2ap_msg_t* msg)
 {
   assert(ag != NULL);
+  assert(ric != NULL);
   assert(msg != NULL);
   assert(0!=0 && "Not implemented");
 
@@ -461,9 +595,10 @@ e2ap_msg_t e2ap_handle_service_update_failure_agent(e2_agent_t* ag, const e2ap_m
   return ans; 
 }
 
-e2ap_msg_t e2ap_handle_service_query_agent(e2_agent_t* ag, const e2ap_msg_t* msg)
+e2ap_msg_t e2ap_handle_service_query_agent(e2_agent_t* ag, ric_ag_t* ric, const e2ap_msg_t* msg)
 {
   assert(ag != NULL);
+  assert(ric != NULL);
   assert(msg != NULL);
   assert(0!=0 && "Not implemented");
 
@@ -471,9 +606,10 @@ e2ap_msg_t e2ap_handle_service_query_agent(e2_agent_t* ag, const e2ap_msg_t* msg
   return ans; 
 }
 
-e2ap_msg_t e2ap_handle_node_configuration_update_ack_agent(e2_agent_t* ag, const e2ap_msg_t* msg)
+e2ap_msg_t e2ap_handle_node_configuration_update_ack_agent(e2_agent_t* ag, ric_ag_t* ric, const e2ap_msg_t* msg)
 {
   assert(ag != NULL);
+  assert(ric != NULL);
   assert(msg != NULL);
   assert(0!=0 && "Not implemented");
 
@@ -481,9 +617,10 @@ e2ap_msg_t e2ap_handle_node_configuration_update_ack_agent(e2_agent_t* ag, const
   return ans; 
 }
 
-e2ap_msg_t e2ap_handle_node_configuration_update_failure_agent(e2_agent_t* ag, const e2ap_msg_t* msg)
+e2ap_msg_t e2ap_handle_node_configuration_update_failure_agent(e2_agent_t* ag, ric_ag_t* ric, const e2ap_msg_t* msg)
 {
   assert(ag != NULL);
+  assert(ric != NULL);
   assert(msg != NULL);
   assert(0!=0 && "Not implemented");
 
@@ -491,9 +628,10 @@ e2ap_msg_t e2ap_handle_node_configuration_update_failure_agent(e2_agent_t* ag, c
   return ans; 
 }
 
-e2ap_msg_t e2ap_handle_connection_update_agent(e2_agent_t* ag, const e2ap_msg_t* msg)
+e2ap_msg_t e2ap_handle_connection_update_agent(e2_agent_t* ag, ric_ag_t* ric, const e2ap_msg_t* msg)
 {
   assert(ag != NULL);
+  assert(ric != NULL);
   assert(msg != NULL);
   assert(0!=0 && "Not implemented");
 
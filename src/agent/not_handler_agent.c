@@ -4,22 +4,19 @@
 #include <stdbool.h>
 #include <stdio.h>
 
-#include "../lib/pending_events.h"
-
-void notification_handle_ag(e2_agent_t* ag, sctp_msg_t const* msg)
+void notification_handle_ag(e2_agent_t* ag, ric_ag_t* ric, sctp_msg_t const* msg)
 {
   assert(ag != NULL);
+  assert(ric != NULL);
   assert(msg != NULL && msg->type == SCTP_MSG_NOTIFICATION);
 
-  // A pending event is created along with a timer of 3000 ms,
-  // after which an event will be generated
-  pending_event_t ev = SETUP_REQUEST_PENDING_EVENT;
-  long const wait_ms = 3000;
-  int fd_timer = create_timer_ms_asio_agent(&ag->io, wait_ms, wait_ms); 
-
-  bi_map_insert(&ag->pending, &fd_timer, sizeof(fd_timer), &ev, sizeof(ev)); 
-
-  printf("[E2 AGENT]: Communication with the nearRT-RIC lost\n" );
+  // A pending event is created along with a timer, after which the E2 
+  // SETUP-REQUEST is sent. The backoff starts again, as the E2 Nodes that 
+  // lost the nearRT-RIC at the same instant must not set up in lockstep
+  reset_backoff(&ric->backoff);
+  arm_setup_timer_agent(ag, ric);
 
+  printf("[E2 AGENT]: Communication with the nearRT-RIC %s lost\n", ric->ep.base.addr);
+  notify_conn_state_agent(ag, ric, DISCONNECTED_CONN_STATE);
 }
 
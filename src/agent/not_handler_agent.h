@@ -3,7 +3,7 @@
 
 #include "e2_agent.h"
 
-void notification_handle_ag(e2_agent_t* ag, sctp_msg_t const* msg);
+void notification_handle_ag(e2_agent_t* ag, ric_ag_t* ric, sctp_msg_t const* msg);
 
 #endif
 
@@ -350,6 +350,19 @@ sm_agent_t* sm_plugin_ag(plugin_ag_t* p, uint16_t key)
   return sm;
 }
 
+bool has_sm_plugin_ag(plugin_ag_t* p, uint16_t key)
+{
+  assert(p != NULL);
+
+  lock_guard(&p->sm_ds_mtx);
+
+  void* start_it = assoc_front(&p->sm_ds);
+  void* end_it = assoc_end(&p->sm_ds);
+  void* it = find_if(&p->sm_ds, start_it, end_it, &key, eq_ran_func_id); 
+
+  return it != end_it;
+}
+
 size_t size_plugin_ag(plugin_ag_t* p)
 {
   assert(p != NULL);
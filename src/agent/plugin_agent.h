@@ -61,6 +61,8 @@ void unload_plugin_ag(plugin_ag_t* p, uint16_t key);
 
 sm_agent_t* sm_plugin_ag(plugin_ag_t* p, uint16_t key);
 
+bool has_sm_plugin_ag(plugin_ag_t* p, uint16_t key);
+
 size_t size_plugin_ag(plugin_ag_t* p);
 
 
@@ -0,0 +1,148 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+
+#include "sim_clock_agent.h"
+#include "../util/alg_ds/ds/lock_guard/lock_guard.h"
+
+#include <assert.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+void init_sim_clock(sim_clock_t* clk, int64_t now_ms)
+{
+  assert(clk != NULL);
+  assert(now_ms > -1);
+
+  pthread_mutexattr_t attr = {0};
+#ifdef DEBUG
+  pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_ERRORCHECK); 
+#endif
+  int rc = pthread_mutex_init(&clk->mtx, &attr);
+  assert(rc == 0);
+
+  clk->now_ms = now_ms;
+  seq_arr_init(&clk->timers, sizeof(sim_timer_t));
+}
+
+void free_sim_clock(sim_clock_t* clk)
+{
+  assert(clk != NULL);
+
+  // The fds belong to the event loop that created them
+  void (*free_timer)(void*) = NULL;
+  seq_arr_free(&clk->timers, free_timer);
+
+  int const rc = pthread_mutex_destroy(&clk->mtx);
+  assert(rc == 0);
+}
+
+int64_t now_sim_clock(sim_clock_t* clk)
+{
+  assert(clk != NULL);
+
+  lock_guard(&clk->mtx);
+  return clk->now_ms;
+}
+
+int add_timer_sim_clock(sim_clock_t* clk, long initial_ms, long interval_ms)
+{
+  assert(clk != NULL);
+  assert(initial_ms > -1);
+  assert(interval_ms > -1);
+
+  int const fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  assert(fd != -1);
+
+  // A disarmed timer is a fd that never becomes readable
+  if(initial_ms == 0)
+    return fd;
+
+  lock_guard(&clk->mtx);
+  sim_timer_t t = {.fd = fd, .next_ms = clk->now_ms + initial_ms, .interval_ms = interval_ms};
+  seq_arr_push_back(&clk->timers, &t, sizeof(t));
+
+  return fd;
+}
+
+// Erasing may shrink the array, so the timers are accessed by index
+static
+void erase_timer(sim_clock_t* clk, size_t idx)
+{
+  void* it = seq_arr_at(&clk->timers, idx);
+  seq_arr_erase(&clk->timers, it, seq_arr_next(&clk->timers, it));
+}
+
+bool rm_timer_sim_clock(sim_clock_t* clk, int fd)
+{
+  assert(clk != NULL);
+
+  lock_guard(&clk->mtx);
+
+  size_t const sz = seq_arr_size(&clk->timers);
+  for(size_t i = 0; i < sz; ++i){
+    sim_timer_t const* t = seq_arr_at(&clk->timers, i);
+    if(t->fd == fd){
+      erase_timer(clk, i);
+      return true;
+    }
+  }
+  return false;
+}
+
+uint64_t advance_sim_clock(sim_clock_t* clk, int64_t delta_ms)
+{
+  assert(clk != NULL);
+  assert(delta_ms > -1);
+
+  lock_guard(&clk->mtx);
+  clk->now_ms += delta_ms;
+
+  uint64_t total = 0;
+  size_t i = 0;
+  while(i < seq_arr_size(&clk->timers)){
+    sim_timer_t* t = seq_arr_at(&clk->timers, i);
+    if(t->next_ms > clk->now_ms){
+      ++i;
+      continue;
+    }
+
+    uint64_t exp = 1;
+    if(t->interval_ms > 0)
+      exp += (clk->now_ms - t->next_ms) / t->interval_ms;
+
+    // The counter of an eventfd adds up the writes, as the expirations of a timerfd
+    ssize_t const rc = write(t->fd, &exp, sizeof(exp));
+    assert(rc == sizeof(exp));
+    (void)rc;
+    total += exp;
+
+    if(t->interval_ms > 0){
+      t->next_ms += exp * t->interval_ms;
+      ++i;
+    } else {
+      // One-shot timers stay readable until the fd is removed
+      erase_timer(clk, i);
+    }
+  }
+
+  return total;
+}
@@ -0,0 +1,68 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+
+#ifndef SIMULATION_CLOCK_AGENT_H
+#define SIMULATION_CLOCK_AGENT_H
+
+// Clock driven by an embedding simulator, e.g., ns-3. The timers expire
+// when the simulator advances the clock, and not with the wall clock. 
+// Every timer is an eventfd, that the event loop polls and reads as a
+// timerfd, i.e., a read returns the expirations since the last read
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "../util/alg_ds/ds/seq_container/seq_arr.h"
+
+typedef struct{
+  int fd;
+  int64_t next_ms;
+  int64_t interval_ms; // 0 for one-shot timers
+} sim_timer_t;
+
+typedef struct{
+  pthread_mutex_t mtx;
+  int64_t now_ms;
+  seq_arr_t timers; // sim_timer_t
+} sim_clock_t;
+
+void init_sim_clock(sim_clock_t* clk, int64_t now_ms);
+
+void free_sim_clock(sim_clock_t* clk);
+
+int64_t now_sim_clock(sim_clock_t* clk);
+
+// Same semantics as timerfd_settime(), i.e., initial_ms == 0 disarms it
+int add_timer_sim_clock(sim_clock_t* clk, long initial_ms, long interval_ms);
+
+// The fd is not closed. False if the fd is not a timer of the clock
+bool rm_timer_sim_clock(sim_clock_t* clk, int fd);
+
+// Advances the clock and signals the timers due in (now, now + delta_ms].
+// Returns the number of expirations. A timer that expires more than once
+// within the step is signalled once with all the expirations, as a
+// timerfd when the reader is late, so a simulator wanting one indication
+// per period advances the clock by at most the shortest period
+uint64_t advance_sim_clock(sim_clock_t* clk, int64_t delta_ms);
+
+#endif
@@ -0,0 +1,89 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+
+#include "../asio_agent.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+static
+void free_io(asio_agent_t* io)
+{
+  close(io->pipe.r);
+  close(io->pipe.w);
+  if(io->ring != NULL){
+    free_asio_uring(io->ring);
+    free(io->ring);
+  } else {
+    close(io->efd);
+  }
+}
+
+// The agent reads one message per event of the RIC socket. Two messages
+// that arrive back to back, e.g., the answers to two E2 SETUP-REQUESTs,
+// are both seen, i.e., the socket is level triggered
+static
+void test_sock_level(asio_backend_e b)
+{
+  set_backend_asio(b);
+
+  asio_agent_t io = {0};
+  init_asio_agent(&io);
+
+  int sv[2] = {0};
+  int rc = socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK, 0, sv);
+  assert(rc == 0);
+  add_sock_fd_asio_agent(&io, sv[0]);
+
+  char const msg[2][4] = {"ans", "ANS"};
+  for(size_t i = 0; i < 2; ++i){
+    ssize_t const n = send(sv[1], msg[i], sizeof(msg[i]), 0);
+    assert(n == sizeof(msg[i]));
+  }
+
+  for(size_t i = 0; i < 2; ++i){
+    assert(event_asio_agent(&io) == sv[0]);
+    char buf[4] = {0};
+    ssize_t const n = recv(sv[0], buf, sizeof(buf), 0);
+    assert(n == sizeof(buf) && buf[0] == msg[i][0]);
+  }
+
+  // Drained. event_asio_agent() times out
+  assert(event_asio_agent(&io) == -1);
+
+  rm_fd_asio_agent(&io, sv[0]);
+  close(sv[1]);
+  free_io(&io);
+}
+
+int main()
+{
+  test_sock_level(EPOLL_ASIO_BACKEND);
+  // Falls back to epoll if not supported
+  test_sock_level(IO_URING_ASIO_BACKEND);
+
+  printf("Success\n");
+  return EXIT_SUCCESS;
+}
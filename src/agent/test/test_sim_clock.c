@@ -0,0 +1,172 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+
+#include "../sim_clock_agent.h"
+#include "../asio_agent.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+// Expirations since the last read, as the agent consumes a timerfd
+static
+uint64_t expirations(int fd)
+{
+  uint64_t exp = 0;
+  ssize_t const rc = read(fd, &exp, sizeof(exp));
+  if(rc == -1){
+    assert(errno == EAGAIN);
+    return 0;
+  }
+  assert(rc == sizeof(exp));
+  return exp;
+}
+
+static
+void test_periodic(void)
+{
+  sim_clock_t clk = {0};
+  init_sim_clock(&clk, 1000);
+
+  int const fd_10 = add_timer_sim_clock(&clk, 10, 10);
+  int const fd_25 = add_timer_sim_clock(&clk, 25, 25);
+
+  assert(advance_sim_clock(&clk, 5) == 0);
+  assert(expirations(fd_10) == 0);
+
+  // 1010
+  assert(advance_sim_clock(&clk, 5) == 1);
+  assert(expirations(fd_10) == 1);
+  assert(expirations(fd_25) == 0);
+
+  // 1025: 10 ms timer at 1020, 25 ms timer at 1025
+  assert(advance_sim_clock(&clk, 15) == 2);
+  assert(expirations(fd_10) == 1);
+  assert(expirations(fd_25) == 1);
+
+  // 1030, not read. 1040, read both
+  assert(advance_sim_clock(&clk, 5) == 1);
+  assert(advance_sim_clock(&clk, 10) == 1);
+  assert(expirations(fd_10) == 2);
+
+  assert(now_sim_clock(&clk) == 1040);
+
+  close(fd_10);
+  close(fd_25);
+  free_sim_clock(&clk);
+}
+
+static
+void test_large_step(void)
+{
+  sim_clock_t clk = {0};
+  init_sim_clock(&clk, 0);
+
+  int const fd = add_timer_sim_clock(&clk, 10, 10);
+
+  // 10, 20, ..., 100 coalesced, and the period stays aligned
+  assert(advance_sim_clock(&clk, 105) == 10);
+  assert(expirations(fd) == 10);
+  assert(advance_sim_clock(&clk, 4) == 0);
+  assert(advance_sim_clock(&clk, 1) == 1);
+  assert(expirations(fd) == 1);
+
+  close(fd);
+  free_sim_clock(&clk);
+}
+
+static
+void test_one_shot_disarmed_rm(void)
+{
+  sim_clock_t clk = {0};
+  init_sim_clock(&clk, 0);
+
+  int const fd_once = add_timer_sim_clock(&clk, 5, 0);
+  int const fd_off = add_timer_sim_clock(&clk, 0, 0);
+  int const fd_rm = add_timer_sim_clock(&clk, 5, 5);
+
+  assert(rm_timer_sim_clock(&clk, fd_rm) == true);
+  assert(rm_timer_sim_clock(&clk, fd_rm) == false);
+  assert(rm_timer_sim_clock(&clk, fd_off) == false);
+
+  assert(advance_sim_clock(&clk, 100) == 1);
+  assert(expirations(fd_once) == 1);
+  assert(expirations(fd_off) == 0);
+  assert(expirations(fd_rm) == 0);
+
+  assert(advance_sim_clock(&clk, 100) == 0);
+  assert(expirations(fd_once) == 0);
+
+  close(fd_once);
+  close(fd_off);
+  close(fd_rm);
+  free_sim_clock(&clk);
+}
+
+// The event loop of the agent sees the simulation timers as any other fd
+static
+void test_asio_agent(asio_backend_e b)
+{
+  set_backend_asio(b);
+
+  sim_clock_t clk = {0};
+  init_sim_clock(&clk, 0);
+
+  asio_agent_t io = {0};
+  init_asio_agent(&io);
+  io.clk = &clk;
+
+  int const fd = create_ran_timer_ms_asio_agent(&io, 20, 20);
+
+  assert(advance_sim_clock(&clk, 19) == 0);
+  assert(advance_sim_clock(&clk, 1) == 1);
+  assert(event_asio_agent(&io) == fd);
+  assert(expirations(fd) == 1);
+
+  rm_fd_asio_agent(&io, fd);
+  assert(advance_sim_clock(&clk, 20) == 0);
+
+  close(io.pipe.r);
+  close(io.pipe.w);
+  if(io.ring != NULL){
+    free_asio_uring(io.ring);
+    free(io.ring);
+  } else {
+    close(io.efd);
+  }
+  free_sim_clock(&clk);
+}
+
+int main()
+{
+  test_periodic();
+  test_large_step();
+  test_one_shot_disarmed_rm();
+  test_asio_agent(EPOLL_ASIO_BACKEND);
+  // Falls back to epoll if not supported
+  test_asio_agent(IO_URING_ASIO_BACKEND);
+
+  printf("Success\n");
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,72 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+
+
+
+#ifndef FUZZ_HARNESS_MIR_H
+#define FUZZ_HARNESS_MIR_H
+
+// Every harness implements the libFuzzer entry point and writes its own seed
+// corpus. The first byte of the input selects the decoder of the SMs, i.e., 
+// fuzz_sel_e, while the E2AP harness decodes the whole PDU
+
+#include "../util/byte_array.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef enum{
+  EVENT_TRIGGER_FUZZ_SEL,
+  ACTION_DEF_FUZZ_SEL,
+  IND_HDR_FUZZ_SEL,
+  IND_MSG_FUZZ_SEL,
+  CALL_PROC_ID_FUZZ_SEL,
+  CTRL_HDR_FUZZ_SEL,
+  CTRL_MSG_FUZZ_SEL,
+  CTRL_OUT_FUZZ_SEL,
+  FUNC_DEF_FUZZ_SEL,
+
+  END_FUZZ_SEL
+} fuzz_sel_e;
+
+// Decoders that the SM does not implement are skipped, as they only assert
+#define FUZZ_DEC_PLAIN(SM, IE, LEN, BUF) do{ \
+  SM##_##IE##_t v = SM##_dec_##IE##_plain(LEN, BUF); \
+  free_##SM##_##IE(&v); \
+} while(0)
+
+// Some IEs do not own memory and their free function is not implemented 
+#define FUZZ_DEC_PLAIN_POD(SM, IE, LEN, BUF) do{ \
+  SM##_##IE##_t v = SM##_dec_##IE##_plain(LEN, BUF); \
+  (void)v; \
+} while(0)
+
+int LLVMFuzzerTestOneInput(uint8_t const* data, size_t size);
+
+// Writes the seed corpus of the harness into dir
+void fuzz_seeds(char const* dir);
+
+// Writes dir/name with the selector byte, if sel < END_FUZZ_SEL, followed by ba. 
+// Takes the ownership of ba
+void write_seed(char const* dir, char const* name, fuzz_sel_e sel, byte_array_t ba);
+
+#endif
@@ -0,0 +1,124 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+
+
+
+// main() for the harnesses when libFuzzer is not available, e.g., gcc or AFL++.
+// Runs every file, or the files of every directory, passed as argument. 
+// Without arguments, it runs stdin, as AFL expects
+//  ./fuzz_mac corpus/mac crash-1234
+//  afl-fuzz -i corpus/mac -o out -- ./fuzz_mac
+
+#include "fuzz.h"
+
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+static
+byte_array_t read_all(FILE* fp)
+{
+  byte_array_t ba = {0};
+  size_t cap = 0;
+  for(;;){
+    if(ba.len == cap){
+      cap = cap == 0 ? 4096 : 2*cap;
+      ba.buf = realloc(ba.buf, cap);
+      if(ba.buf == NULL){
+        printf("Memory exhausted\n");
+        exit(EXIT_FAILURE);
+      }
+    }
+    size_t const n = fread(ba.buf + ba.len, 1, cap - ba.len, fp);
+    if(n == 0)
+      break;
+    ba.len += n;
+  }
+  return ba;
+}
+
+static
+void run_file(char const* path)
+{
+  FILE* fp = fopen(path, "rb");
+  if(fp == NULL){
+    printf("Could not open %s\n", path);
+    return;
+  }
+  byte_array_t ba = read_all(fp);
+  fclose(fp);
+
+  LLVMFuzzerTestOneInput(ba.buf, ba.len);
+  free_byte_array(ba);
+}
+
+static
+size_t run_path(char const* path)
+{
+  struct stat st = {0};
+  if(stat(path, &st) != 0){
+    printf("Could not stat %s\n", path);
+    return 0;
+  }
+
+  if(S_ISDIR(st.st_mode) == false){
+    run_file(path);
+    return 1;
+  }
+
+  DIR* dir = opendir(path);
+  if(dir == NULL){
+    printf("Could not open %s\n", path);
+    return 0;
+  }
+
+  size_t num = 0;
+  struct dirent* e = NULL;
+  while((e = readdir(dir)) != NULL){
+    if(strcmp(e->d_name, ".") == 0 || strcmp(e->d_name, "..") == 0)
+      continue;
+    char file[1024] = {0};
+    snprintf(file, sizeof(file), "%s/%s", path, e->d_name);
+    num += run_path(file);
+  }
+  closedir(dir);
+  return num;
+}
+
+int main(int argc, char* argv[])
+{
+  if(argc == 1){
+    byte_array_t ba = read_all(stdin);
+    LLVMFuzzerTestOneInput(ba.buf, ba.len);
+    free_byte_array(ba);
+    return EXIT_SUCCESS;
+  }
+
+  size_t num = 0;
+  for(int i = 1; i < argc; ++i)
+    num += run_path(argv[i]);
+
+  printf("Executed %lu inputs\n", num);
+  return EXIT_SUCCESS;
+}
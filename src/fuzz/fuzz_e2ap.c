@@ -0,0 +1,88 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+
+
+
+// E2AP PDU decoder of the version selected with E2AP_VERSION, i.e., the bytes
+// that the RIC, the agent and the xApps read from the socket
+
+#include "fuzz.h"
+#include "../lib/e2ap/e2ap_ap_wrapper.h"
+#include "../lib/e2ap/e2ap_msg_dec_generic_wrapper.h"
+#include "../lib/e2ap/e2ap_msg_enc_generic_wrapper.h"
+
+#include <stdbool.h>
+
+static
+e2ap_asn_t ap; 
+
+static
+bool ap_init = false;
+
+int LLVMFuzzerTestOneInput(uint8_t const* data, size_t size)
+{
+  if(size == 0)
+    return 0;
+
+  if(ap_init == false){
+    init_ap_asn(&ap);
+    ap_init = true;
+  }
+
+  // The decoder does not modify the buffer
+  byte_array_t ba = {.len = size, .buf = (uint8_t*)data};
+  e2ap_msg_t msg = e2ap_msg_dec_asn(&ap, ba);
+  if(msg.type != NONE_E2_MSG_TYPE)
+    ap.free_msg[msg.type](&msg);
+
+  return 0;
+}
+
+void fuzz_seeds(char const* dir)
+{
+  uint8_t hdr[] = {0x01, 0x02, 0x03, 0x04};
+  uint8_t payload[] = {0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C};
+  byte_array_t ba_hdr = {.len = sizeof(hdr), .buf = hdr};
+  byte_array_t ba_msg = {.len = sizeof(payload), .buf = payload};
+  ric_gen_id_t const ric_id = {.ric_req_id = 1021, .ric_inst_id = 0, .ran_func_id = 2};
+
+  ric_action_t act = {.id = 0, .type = RIC_ACT_REPORT, .definition = &ba_msg};
+  ric_subscription_request_t sr = {.ric_id = ric_id, .event_trigger = ba_hdr, .action = &act, .len_action = 1};
+  write_seed(dir, "subscription_request", END_FUZZ_SEL, e2ap_enc_subscription_request_asn(&sr));
+
+  ric_action_admitted_t adm = {.ric_act_id = 0};
+  ric_subscription_response_t sresp = {.ric_id = ric_id, .admitted = &adm, .len_admitted = 1};
+  write_seed(dir, "subscription_response", END_FUZZ_SEL, e2ap_enc_subscription_response_asn(&sresp));
+
+  ric_subscription_delete_request_t dr = {.ric_id = ric_id};
+  write_seed(dir, "subscription_delete_request", END_FUZZ_SEL, e2ap_enc_subscription_delete_request_asn(&dr));
+
+  ric_indication_t ind = {.ric_id = ric_id, .action_id = 0, .hdr = ba_hdr, .msg = ba_msg};
+  write_seed(dir, "indication", END_FUZZ_SEL, e2ap_enc_indication_asn(&ind));
+
+  ric_control_request_t cr = {.ric_id = ric_id, .hdr = ba_hdr, .msg = ba_msg};
+  write_seed(dir, "control_request", END_FUZZ_SEL, e2ap_enc_control_request_asn(&cr));
+
+  ric_control_acknowledge_t ca = {.ric_id = ric_id};
+  write_seed(dir, "control_ack", END_FUZZ_SEL, e2ap_enc_control_ack_asn(&ca));
+}
+
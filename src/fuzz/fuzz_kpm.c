@@ -0,0 +1,119 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+
+
+
+// KPM SM ASN.1 decoders of the version selected with KPM_VERSION. The first 
+// byte selects the decoder, see fuzz_sel_e
+
+#include "fuzz.h"
+#include "../sm/kpm_sm/kpm_data_ie_wrapper.h"
+
+#ifdef KPM_V2_01
+#include "../sm/kpm_sm/kpm_sm_v02.01/enc/kpm_enc_asn.h"
+#include "../sm/kpm_sm/kpm_sm_v02.01/dec/kpm_dec_asn.h"
+#elif defined(KPM_V2_03)
+#include "../sm/kpm_sm/kpm_sm_v02.03/enc/kpm_enc_asn.h"
+#include "../sm/kpm_sm/kpm_sm_v02.03/dec/kpm_dec_asn.h"
+#elif defined(KPM_V3_00)
+#include "../sm/kpm_sm/kpm_sm_v03.00/enc/kpm_enc_asn.h"
+#include "../sm/kpm_sm/kpm_sm_v03.00/dec/kpm_dec_asn.h"
+#endif
+
+int LLVMFuzzerTestOneInput(uint8_t const* data, size_t size)
+{
+  if(size == 0)
+    return 0;
+
+  size_t const len = size - 1;
+  uint8_t const* buf = data + 1;
+
+  switch(data[0] % END_FUZZ_SEL){
+    case EVENT_TRIGGER_FUZZ_SEL: {
+      kpm_event_trigger_def_t v = kpm_dec_event_trigger_asn(len, buf);
+      free_kpm_event_trigger_def(&v);
+      break;
+    }
+    case ACTION_DEF_FUZZ_SEL: {
+      kpm_act_def_t v = kpm_dec_action_def_asn(len, buf);
+      free_kpm_action_def(&v);
+      break;
+    }
+    case IND_HDR_FUZZ_SEL: {
+      kpm_ind_hdr_t v = kpm_dec_ind_hdr_asn(len, buf);
+      free_kpm_ind_hdr(&v);
+      break;
+    }
+    case IND_MSG_FUZZ_SEL: {
+      kpm_ind_msg_t v = kpm_dec_ind_msg_asn(len, buf);
+      free_kpm_ind_msg(&v);
+      break;
+    }
+    case FUNC_DEF_FUZZ_SEL: {
+      kpm_ran_function_def_t v = kpm_dec_func_def_asn(len, buf);
+      free_kpm_ran_function_def(&v);
+      break;
+    }
+    default:
+      // Not part of the KPM SM
+      break;
+  }
+
+  return 0;
+}
+
+void fuzz_seeds(char const* dir)
+{
+  kpm_event_trigger_def_t et = {.type = FORMAT_1_RIC_EVENT_TRIGGER};
+  et.kpm_ric_event_trigger_format_1.report_period_ms = 1000;
+  write_seed(dir, "event_trigger", EVENT_TRIGGER_FUZZ_SEL, kpm_enc_event_trigger_asn(&et));
+
+  enum_value_e no_label = TRUE_ENUM_VALUE;
+  label_info_lst_t label = {.noLabel = &no_label};
+  meas_info_format_1_lst_t info[2] = { 
+    {.meas_type = {.type = NAME_MEAS_TYPE, .name = {.len = 11, .buf = (uint8_t*)"DRB.UEThpDl"}}, .label_info_lst_len = 1, .label_info_lst = &label},
+    {.meas_type = {.type = NAME_MEAS_TYPE, .name = {.len = 12, .buf = (uint8_t*)"RRU.PrbTotDl"}}, .label_info_lst_len = 1, .label_info_lst = &label}};
+
+  kpm_act_def_t ad = {.type = FORMAT_1_ACTION_DEFINITION};
+  ad.frm_1.meas_info_lst_len = 2;
+  ad.frm_1.meas_info_lst = info;
+  ad.frm_1.gran_period_ms = 100;
+  write_seed(dir, "action_def", ACTION_DEF_FUZZ_SEL, kpm_enc_action_def_asn(&ad));
+
+  kpm_ind_hdr_t hdr = {.type = FORMAT_1_INDICATION_HEADER};
+  hdr.kpm_ric_ind_hdr_format_1.collectStartTime = 1700000000;
+  write_seed(dir, "ind_hdr", IND_HDR_FUZZ_SEL, kpm_enc_ind_hdr_asn(&hdr));
+
+  meas_record_lst_t rec[2] = {{.value = INTEGER_MEAS_VALUE, .int_val = 42}, 
+                              {.value = REAL_MEAS_VALUE, .real_val = 4.2}};
+  meas_data_lst_t meas_data = {.meas_record_len = 2, .meas_record_lst = rec};
+  uint32_t gran_period_ms = 100;
+
+  kpm_ind_msg_t msg = {.type = FORMAT_1_INDICATION_MESSAGE};
+  msg.frm_1.meas_data_lst_len = 1;
+  msg.frm_1.meas_data_lst = &meas_data;
+  msg.frm_1.meas_info_lst_len = 2;
+  msg.frm_1.meas_info_lst = info;
+  msg.frm_1.gran_period_ms = &gran_period_ms;
+  write_seed(dir, "ind_msg", IND_MSG_FUZZ_SEL, kpm_enc_ind_msg_asn(&msg));
+}
+
@@ -0,0 +1,151 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+
+
+
+// RC SM ASN.1 decoders. The first byte selects the decoder, see fuzz_sel_e.
+// The seeds are the random messages of the RC SM test
+
+#include "fuzz.h"
+#include "../sm/rc_sm/ie/rc_data_ie.h"
+#include "../sm/rc_sm/enc/rc_enc_asn.h"
+#include "../sm/rc_sm/dec/rc_dec_asn.h"
+#include "../sm/rc_sm/test/fill_rnd_data_rc.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define NUM_RND_SEEDS 8
+
+int LLVMFuzzerTestOneInput(uint8_t const* data, size_t size)
+{
+  if(size == 0)
+    return 0;
+
+  size_t const len = size - 1;
+  uint8_t const* buf = data + 1;
+
+  switch(data[0] % END_FUZZ_SEL){
+    case EVENT_TRIGGER_FUZZ_SEL: {
+      e2sm_rc_event_trigger_t v = rc_dec_event_trigger_asn(len, buf);
+      free_e2sm_rc_event_trigger(&v);
+      break;
+    }
+    case ACTION_DEF_FUZZ_SEL: {
+      e2sm_rc_action_def_t v = rc_dec_action_def_asn(len, buf);
+      free_e2sm_rc_action_def(&v);
+      break;
+    }
+    case IND_HDR_FUZZ_SEL: {
+      e2sm_rc_ind_hdr_t v = rc_dec_ind_hdr_asn(len, buf);
+      free_e2sm_rc_ind_hdr(&v);
+      break;
+    }
+    case IND_MSG_FUZZ_SEL: {
+      e2sm_rc_ind_msg_t v = rc_dec_ind_msg_asn(len, buf);
+      free_e2sm_rc_ind_msg(&v);
+      break;
+    }
+    case CALL_PROC_ID_FUZZ_SEL: {
+      e2sm_rc_cpid_t v = rc_dec_cpid_asn(len, buf);
+      free_e2sm_rc_cpid(&v);
+      break;
+    }
+    case CTRL_HDR_FUZZ_SEL: {
+      e2sm_rc_ctrl_hdr_t v = rc_dec_ctrl_hdr_asn(len, buf);
+      free_e2sm_rc_ctrl_hdr(&v);
+      break;
+    }
+    case CTRL_MSG_FUZZ_SEL: {
+      e2sm_rc_ctrl_msg_t v = rc_dec_ctrl_msg_asn(len, buf);
+      free_e2sm_rc_ctrl_msg(&v);
+      break;
+    }
+    case CTRL_OUT_FUZZ_SEL: {
+      e2sm_rc_ctrl_out_t v = rc_dec_ctrl_out_asn(len, buf);
+      free_e2sm_rc_ctrl_out(&v);
+      break;
+    }
+    case FUNC_DEF_FUZZ_SEL: {
+      e2sm_rc_func_def_t v = rc_dec_func_def_asn(len, buf);
+      free_e2sm_rc_func_def(&v);
+      break;
+    }
+    default:
+      break;
+  }
+
+  return 0;
+}
+
+static
+char const* name(char const* ie, int i)
+{
+  static char str[64];
+  snprintf(str, sizeof(str), "%s_%d", ie, i);
+  return str;
+}
+
+void fuzz_seeds(char const* dir)
+{
+  // Reproducible corpus
+  srand(42);
+
+  for(int i = 0; i < NUM_RND_SEEDS; ++i){
+    e2sm_rc_event_trigger_t event_trigger = fill_rnd_rc_event_trigger();
+    write_seed(dir, name("event_trigger", i), EVENT_TRIGGER_FUZZ_SEL, rc_enc_event_trigger_asn(&event_trigger));
+    free_e2sm_rc_event_trigger(&event_trigger);
+
+    e2sm_rc_action_def_t action_def = fill_rnd_rc_action_def();
+    write_seed(dir, name("action_def", i), ACTION_DEF_FUZZ_SEL, rc_enc_action_def_asn(&action_def));
+    free_e2sm_rc_action_def(&action_def);
+
+    e2sm_rc_ind_hdr_t ind_hdr = fill_rnd_rc_ind_hdr();
+    write_seed(dir, name("ind_hdr", i), IND_HDR_FUZZ_SEL, rc_enc_ind_hdr_asn(&ind_hdr));
+    free_e2sm_rc_ind_hdr(&ind_hdr);
+
+    e2sm_rc_ind_msg_t ind_msg = fill_rnd_rc_ind_msg();
+    write_seed(dir, name("ind_msg", i), IND_MSG_FUZZ_SEL, rc_enc_ind_msg_asn(&ind_msg));
+    free_e2sm_rc_ind_msg(&ind_msg);
+
+    e2sm_rc_cpid_t cpid = fill_rnd_rc_cpid();
+    write_seed(dir, name("cpid", i), CALL_PROC_ID_FUZZ_SEL, rc_enc_cpid_asn(&cpid));
+    free_e2sm_rc_cpid(&cpid);
+
+    e2sm_rc_ctrl_hdr_t ctrl_hdr = fill_rnd_rc_ctrl_hdr();
+    write_seed(dir, name("ctrl_hdr", i), CTRL_HDR_FUZZ_SEL, rc_enc_ctrl_hdr_asn(&ctrl_hdr));
+    free_e2sm_rc_ctrl_hdr(&ctrl_hdr);
+
+    e2sm_rc_ctrl_msg_t ctrl_msg = fill_rnd_rc_ctrl_msg();
+    write_seed(dir, name("ctrl_msg", i), CTRL_MSG_FUZZ_SEL, rc_enc_ctrl_msg_asn(&ctrl_msg));
+    free_e2sm_rc_ctrl_msg(&ctrl_msg);
+
+    e2sm_rc_ctrl_out_t ctrl_out = fill_rnd_rc_ctrl_out();
+    write_seed(dir, name("ctrl_out", i), CTRL_OUT_FUZZ_SEL, rc_enc_ctrl_out_asn(&ctrl_out));
+    free_e2sm_rc_ctrl_out(&ctrl_out);
+
+    e2sm_rc_func_def_t func_def = fill_rnd_rc_ran_func_def();
+    write_seed(dir, name("func_def", i), FUNC_DEF_FUZZ_SEL, rc_enc_func_def_asn(&func_def));
+    free_e2sm_rc_func_def(&func_def);
+  }
+}
+
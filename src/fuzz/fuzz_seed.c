@@ -0,0 +1,66 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+
+
+
+// Writes the seeds of the corpus. The asserts are compiled out with NDEBUG,
+// so the errors are checked explicitly
+
+#include "fuzz.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+void write_seed(char const* dir, char const* name, fuzz_sel_e sel, byte_array_t ba)
+{
+  assert(dir != NULL);
+  assert(name != NULL);
+  assert(sel <= END_FUZZ_SEL);
+
+  char path[512] = {0};
+  int const rc = snprintf(path, sizeof(path), "%s/%s", dir, name);
+  if(rc < 0 || rc >= (int)sizeof(path)){
+    printf("Path too long %s/%s\n", dir, name);
+    exit(EXIT_FAILURE);
+  }
+
+  FILE* fp = fopen(path, "wb");
+  if(fp == NULL){
+    printf("Could not create the seed %s\n", path);
+    exit(EXIT_FAILURE);
+  }
+
+  uint8_t const b = sel;
+  if(sel < END_FUZZ_SEL && fwrite(&b, 1, 1, fp) != 1){
+    printf("Could not write the seed %s\n", path);
+    exit(EXIT_FAILURE);
+  }
+  if(fwrite(ba.buf, 1, ba.len, fp) != ba.len){
+    printf("Could not write the seed %s\n", path);
+    exit(EXIT_FAILURE);
+  }
+  fclose(fp);
+
+  free_byte_array(ba);
+}
+
@@ -0,0 +1,89 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+
+
+
+// SLICE SM plain decoders. The first byte selects the decoder, see fuzz_sel_e
+
+#include "fuzz.h"
+#include "../sm/slice_sm/ie/slice_data_ie.h"
+#include "../sm/slice_sm/dec/slice_dec_plain.h"
+#include "../sm/slice_sm/enc/slice_enc_plain.h"
+
+#include <string.h>
+
+int LLVMFuzzerTestOneInput(uint8_t const* data, size_t size)
+{
+  if(size == 0)
+    return 0;
+
+  size_t const len = size - 1;
+  uint8_t const* buf = data + 1;
+
+  switch(data[0] % END_FUZZ_SEL){
+    case EVENT_TRIGGER_FUZZ_SEL:
+      FUZZ_DEC_PLAIN_POD(slice, event_trigger, len, buf);
+      break;
+    case IND_HDR_FUZZ_SEL:
+      FUZZ_DEC_PLAIN(slice, ind_hdr, len, buf);
+      break;
+    case IND_MSG_FUZZ_SEL:
+      FUZZ_DEC_PLAIN(slice, ind_msg, len, buf);
+      break;
+    case CTRL_HDR_FUZZ_SEL:
+      FUZZ_DEC_PLAIN(slice, ctrl_hdr, len, buf);
+      break;
+    case CTRL_MSG_FUZZ_SEL:
+      FUZZ_DEC_PLAIN(slice, ctrl_msg, len, buf);
+      break;
+    case CTRL_OUT_FUZZ_SEL:
+      FUZZ_DEC_PLAIN(slice, ctrl_out, len, buf);
+      break;
+    default:
+      // Not implemented by the SM
+      break;
+  }
+
+  return 0;
+}
+
+void fuzz_seeds(char const* dir)
+{
+  slice_event_trigger_t et = {.ms = 10};
+  write_seed(dir, "event_trigger", EVENT_TRIGGER_FUZZ_SEL, slice_enc_event_trigger_plain(&et));
+
+  slice_ind_hdr_t ind_hdr = {0};
+  write_seed(dir, "ind_hdr", IND_HDR_FUZZ_SEL, slice_enc_ind_hdr_plain(&ind_hdr));
+
+  slice_ind_msg_t msg = {0};
+  write_seed(dir, "ind_msg", IND_MSG_FUZZ_SEL, slice_enc_ind_msg_plain(&msg));
+
+  slice_ctrl_hdr_t ctrl_hdr = {0};
+  write_seed(dir, "ctrl_hdr", CTRL_HDR_FUZZ_SEL, slice_enc_ctrl_hdr_plain(&ctrl_hdr));
+
+  slice_ctrl_msg_t ctrl_msg = {0};
+  write_seed(dir, "ctrl_msg", CTRL_MSG_FUZZ_SEL, slice_enc_ctrl_msg_plain(&ctrl_msg));
+
+  slice_ctrl_out_t ctrl_out = {0};
+  write_seed(dir, "ctrl_out", CTRL_OUT_FUZZ_SEL, slice_enc_ctrl_out_plain(&ctrl_out));
+}
+
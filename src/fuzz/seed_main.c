@@ -0,0 +1,49 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+
+
+
+// Generates the seed corpus of a harness, e.g., ./seed_fuzz_mac corpus/mac
+
+#include "fuzz.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+
+int main(int argc, char* argv[])
+{
+  if(argc != 2){
+    printf("Usage: %s <corpus dir>\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  if(mkdir(argv[1], 0755) != 0 && errno != EEXIST){
+    printf("Could not create the corpus dir %s\n", argv[1]);
+    return EXIT_FAILURE;
+  }
+
+  fuzz_seeds(argv[1]);
+  return EXIT_SUCCESS;
+}
+
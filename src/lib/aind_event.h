@@ -31,6 +31,8 @@ typedef struct{
   sm_agent_t* sm;
   uint8_t action_id;
   void* ind_data;
+  // nearRT-RIC that subscribed, see ric_ag_t 
+  uint16_t ric_idx;
 } aind_event_t;
 
 typedef struct{
@@ -0,0 +1,582 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+#include "asio_uring.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static
+_Atomic asio_backend_e backend = EPOLL_ASIO_BACKEND;
+
+void set_backend_asio(asio_backend_e b)
+{
+  assert(b == EPOLL_ASIO_BACKEND || b == IO_URING_ASIO_BACKEND);
+  backend = b;
+}
+
+asio_backend_e backend_asio(void)
+{
+  return backend;
+}
+
+bool set_backend_str_asio(char const* name)
+{
+  assert(name != NULL);
+
+  if(strcmp(name, "epoll") == 0){
+    set_backend_asio(EPOLL_ASIO_BACKEND);
+    return true;
+  } else if(strcmp(name, "io_uring") == 0){
+    set_backend_asio(IO_URING_ASIO_BACKEND);
+    return true;
+  }
+  return false;
+}
+
+char const* backend_asio_str(asio_backend_e b)
+{
+  if(b == EPOLL_ASIO_BACKEND)
+    return "epoll";
+  if(b == IO_URING_ASIO_BACKEND)
+    return "io_uring";
+  return NULL;
+}
+
+uint64_t syscalls_asio_uring(asio_uring_t const* r)
+{
+  assert(r != NULL);
+  return r->syscalls;
+}
+
+asio_uring_t* create_asio_uring(void)
+{
+  if(backend_asio() != IO_URING_ASIO_BACKEND)
+    return NULL;
+
+  asio_uring_t* r = calloc(1, sizeof(asio_uring_t));
+  assert(r != NULL && "Memory exhausted");
+  if(init_asio_uring(r) == false){
+    printf("[ASIO]: Falling back to epoll\n");
+    free(r);
+    return NULL;
+  }
+  return r;
+}
+
+#if defined(__has_include) 
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#endif
+#endif
+
+// Multishot polls (5.13) are not advertised. IORING_FEAT_CQE_SKIP (5.17) is
+#if defined(IORING_FEAT_CQE_SKIP) && defined(IORING_FEAT_EXT_ARG)
+
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#define REQUIRED_FEATURES (IORING_FEAT_SINGLE_MMAP | IORING_FEAT_NODROP | IORING_FEAT_EXT_ARG | IORING_FEAT_CQE_SKIP)
+
+// user_data of the sqes. Bit 63 marks the timers, bits 32-62 hold the 
+// generation and bits 0-31 the fd or the timer slot
+#define TIMER_UD (1ULL << 63)
+// The removals only complete on failure, e.g., already expired
+#define REMOVE_UD UINT64_MAX
+
+static
+uint64_t user_data(bool timer, uint32_t gen, uint32_t idx)
+{
+  assert(gen < (1U << 31));
+  return (timer ? TIMER_UD : 0) | ((uint64_t)gen << 32) | idx;
+}
+
+static
+int64_t now_ns(void)
+{
+  struct timespec t = {0};
+  int const rc = clock_gettime(CLOCK_MONOTONIC, &t);
+  assert(rc == 0);
+  return t.tv_sec * 1000000000L + t.tv_nsec;
+}
+
+static
+int enter(asio_uring_t* r, unsigned to_submit, unsigned min_complete, unsigned flags, void* arg, size_t len_arg)
+{
+  r->syscalls += 1;
+  return syscall(__NR_io_uring_enter, r->fd, to_submit, min_complete, flags, arg, len_arg);
+}
+
+static
+uint32_t new_gen(asio_uring_t* r)
+{
+  r->next_gen = r->next_gen % ((1U << 31) - 1) + 1;
+  return r->next_gen;
+}
+
+// Not yet submitted. With the mutex locked
+static
+unsigned queued(asio_uring_t const* r)
+{
+  return *r->sq_tail - __atomic_load_n(r->sq_head, __ATOMIC_ACQUIRE);
+}
+
+// With the mutex locked
+static
+struct io_uring_sqe* get_sqe(asio_uring_t* r, size_t* idx)
+{
+  unsigned const tail = *r->sq_tail;
+  while(queued(r) == ASIO_URING_SQ_ENTRIES){
+    // Full. Hand them to the kernel
+    enter(r, ASIO_URING_SQ_ENTRIES, 0, 0, NULL, 0);
+  }
+
+  *idx = tail & r->sq_mask;
+  struct io_uring_sqe* sqe = &r->sqes[*idx];
+  memset(sqe, 0, sizeof(*sqe));
+  return sqe;
+}
+
+// With the mutex locked
+static
+void push_sqe(asio_uring_t* r, size_t idx)
+{
+  r->sq_array[idx] = idx;
+  __atomic_store_n(r->sq_tail, *r->sq_tail + 1, __ATOMIC_RELEASE);
+}
+
+// From threads other than the event loop, which submits with its next wait.
+// With the mutex locked
+static
+void submit(asio_uring_t* r)
+{
+  int const rc = enter(r, queued(r), 0, 0, NULL, 0);
+  // EBUSY/EAGAIN: the event loop submits them after reaping
+  if(rc < 0 && errno != EBUSY && errno != EAGAIN && errno != EINTR)
+    printf("[ASIO]: io_uring_enter failed: %s\n", strerror(errno));
+}
+
+static
+void arm_poll(asio_uring_t* r, int fd)
+{
+  size_t idx = 0;
+  struct io_uring_sqe* sqe = get_sqe(r, &idx);
+  sqe->opcode = IORING_OP_POLL_ADD;
+  sqe->fd = fd;
+  sqe->poll32_events = POLLIN;
+  sqe->len = r->fds[fd].edge ? IORING_POLL_ADD_MULTI : 0;
+  sqe->user_data = user_data(false, r->fds[fd].gen, fd);
+  push_sqe(r, idx);
+}
+
+static
+void arm_timer(asio_uring_t* r, size_t slot)
+{
+  asio_uring_timer_t const* t = &r->timers[slot];
+
+  size_t idx = 0;
+  struct io_uring_sqe* sqe = get_sqe(r, &idx);
+  r->ts[idx].tv_sec = t->next_ns / 1000000000L;
+  r->ts[idx].tv_nsec = t->next_ns % 1000000000L;
+
+  sqe->opcode = IORING_OP_TIMEOUT;
+  sqe->fd = -1;
+  sqe->addr = (uintptr_t)&r->ts[idx];
+  sqe->len = 1;
+  sqe->off = 0; // Not a completion counter, just a timer
+  sqe->timeout_flags = IORING_TIMEOUT_ABS;
+  sqe->user_data = user_data(true, t->gen, slot);
+  push_sqe(r, idx);
+}
+
+static
+void remove_sqe(asio_uring_t* r, uint8_t opcode, uint64_t target)
+{
+  size_t idx = 0;
+  struct io_uring_sqe* sqe = get_sqe(r, &idx);
+  sqe->opcode = opcode;
+  sqe->fd = -1;
+  sqe->addr = target;
+  sqe->flags = IOSQE_CQE_SKIP_SUCCESS;
+  sqe->user_data = REMOVE_UD;
+  push_sqe(r, idx);
+}
+
+bool init_asio_uring(asio_uring_t* r)
+{
+  assert(r != NULL);
+  memset(r, 0, sizeof(*r));
+
+  struct io_uring_params p = {.flags = IORING_SETUP_CQSIZE, .cq_entries = ASIO_URING_CQ_ENTRIES}; 
+  r->fd = syscall(__NR_io_uring_setup, ASIO_URING_SQ_ENTRIES, &p);
+  if(r->fd < 0){
+    printf("[ASIO]: io_uring not available: %s\n", strerror(errno));
+    return false;
+  }
+
+  if((p.features & REQUIRED_FEATURES) != REQUIRED_FEATURES || p.sq_entries != ASIO_URING_SQ_ENTRIES){
+    printf("[ASIO]: io_uring features 0x%x, 0x%x required. Kernel too old\n", p.features, REQUIRED_FEATURES);
+    close(r->fd);
+    return false;
+  }
+
+  size_t const len_sq = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+  size_t const len_cq = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+  r->len_ring = len_sq > len_cq ? len_sq : len_cq;
+  r->ring = mmap(NULL, r->len_ring, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, r->fd, IORING_OFF_SQ_RING);
+  assert(r->ring != MAP_FAILED);
+
+  r->len_sqes = p.sq_entries * sizeof(struct io_uring_sqe);
+  r->sqes = mmap(NULL, r->len_sqes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, r->fd, IORING_OFF_SQES);
+  assert(r->sqes != MAP_FAILED);
+
+  uint8_t* base = r->ring;
+  r->sq_head = (unsigned*)(base + p.sq_off.head);
+  r->sq_tail = (unsigned*)(base + p.sq_off.tail);
+  r->sq_mask = *(unsigned*)(base + p.sq_off.ring_mask);
+  r->sq_array = (unsigned*)(base + p.sq_off.array);
+  r->cq_head = (unsigned*)(base + p.cq_off.head);
+  r->cq_tail = (unsigned*)(base + p.cq_off.tail);
+  r->cq_mask = *(unsigned*)(base + p.cq_off.ring_mask);
+  r->cqes = (struct io_uring_cqe*)(base + p.cq_off.cqes);
+
+  r->ts = calloc(p.sq_entries, sizeof(struct __kernel_timespec));
+  assert(r->ts != NULL && "Memory exhausted");
+
+  int const rc = pthread_mutex_init(&r->mtx, NULL);
+  assert(rc == 0);
+
+  return true;
+}
+
+void free_asio_uring(asio_uring_t* r)
+{
+  assert(r != NULL);
+
+  // Cancels the polls and the timeouts
+  int rc = munmap(r->sqes, r->len_sqes);
+  assert(rc == 0);
+  rc = munmap(r->ring, r->len_ring);
+  assert(rc == 0);
+  rc = close(r->fd);
+  assert(rc == 0);
+
+  free(r->ts);
+  free(r->fds);
+  free(r->rearm);
+  free(r->timers);
+
+  rc = pthread_mutex_destroy(&r->mtx);
+  assert(rc == 0);
+}
+
+void add_fd_asio_uring(asio_uring_t* r, int fd, bool edge)
+{
+  assert(r != NULL);
+  assert(fd > -1 && fd < ASIO_URING_TIMER_ID);
+
+  pthread_mutex_lock(&r->mtx);
+
+  if((size_t)fd >= r->len_fds){
+    size_t const len = 2*fd + 16;
+    r->fds = realloc(r->fds, len * sizeof(asio_uring_fd_t));
+    assert(r->fds != NULL && "Memory exhausted");
+    memset(r->fds + r->len_fds, 0, (len - r->len_fds) * sizeof(asio_uring_fd_t));
+    r->len_fds = len;
+  }
+
+  assert(r->fds[fd].gen == 0 && "fd already registered");
+  r->fds[fd].gen = new_gen(r);
+  r->fds[fd].edge = edge;
+  arm_poll(r, fd);
+  submit(r);
+
+  pthread_mutex_unlock(&r->mtx);
+}
+
+void rm_fd_asio_uring(asio_uring_t* r, int fd)
+{
+  assert(r != NULL);
+  assert(fd > -1);
+
+  pthread_mutex_lock(&r->mtx);
+
+  assert((size_t)fd < r->len_fds && r->fds[fd].gen != 0 && "fd not registered");
+  uint64_t const ud = user_data(false, r->fds[fd].gen, fd);
+  r->fds[fd].gen = 0;
+
+  // The poll holds a reference to the file. Release it before the fd is closed
+  remove_sqe(r, IORING_OP_POLL_REMOVE, ud);
+  submit(r);
+
+  pthread_mutex_unlock(&r->mtx);
+}
+
+int create_timer_ms_asio_uring(asio_uring_t* r, long initial_ms, long interval_ms)
+{
+  assert(r != NULL);
+  assert(initial_ms > -1);
+  assert(interval_ms > -1);
+
+  pthread_mutex_lock(&r->mtx);
+
+  size_t slot = 0;
+  while(slot < r->len_timers && r->timers[slot].gen != 0)
+    ++slot;
+
+  if(slot == r->len_timers){
+    size_t const len = 2*r->len_timers + 16;
+    r->timers = realloc(r->timers, len * sizeof(asio_uring_timer_t));
+    assert(r->timers != NULL && "Memory exhausted");
+    memset(r->timers + r->len_timers, 0, (len - r->len_timers) * sizeof(asio_uring_timer_t));
+    r->len_timers = len;
+  }
+
+  asio_uring_timer_t* t = &r->timers[slot];
+  t->gen = new_gen(r);
+  t->next_ns = now_ns() + initial_ms * 1000000L;
+  t->interval_ns = interval_ms * 1000000L;
+
+  // As timerfd_settime(), a zero initial expiration disarms it
+  if(initial_ms > 0){
+    arm_timer(r, slot);
+    submit(r);
+  }
+
+  pthread_mutex_unlock(&r->mtx);
+
+  return ASIO_URING_TIMER_ID + slot;
+}
+
+void rm_timer_asio_uring(asio_uring_t* r, int id)
+{
+  assert(r != NULL);
+  assert(is_timer_asio_uring(id) == true);
+
+  size_t const slot = id - ASIO_URING_TIMER_ID;
+
+  pthread_mutex_lock(&r->mtx);
+
+  assert(slot < r->len_timers && r->timers[slot].gen != 0 && "Unknown timer");
+  uint64_t const ud = user_data(true, r->timers[slot].gen, slot);
+  memset(&r->timers[slot], 0, sizeof(asio_uring_timer_t));
+
+  remove_sqe(r, IORING_OP_TIMEOUT_REMOVE, ud);
+  submit(r);
+
+  pthread_mutex_unlock(&r->mtx);
+}
+
+// With the mutex locked. Returns the id to report, or -1 if none
+static
+int handle_cqe(asio_uring_t* r, struct io_uring_cqe const* cqe)
+{
+  if(cqe->user_data == REMOVE_UD)
+    return -1;
+
+  uint32_t const gen = (cqe->user_data >> 32) & ~(1U << 31);
+  uint32_t const idx = cqe->user_data & UINT32_MAX;
+
+  if(cqe->user_data & TIMER_UD){
+    // Removed in between
+    if(idx >= r->len_timers || r->timers[idx].gen != gen)
+      return -1;
+
+    if(cqe->res != -ETIME){
+      printf("[ASIO]: io_uring timeout failed: %s\n", strerror(-cqe->res));
+      return -1;
+    }
+
+    asio_uring_timer_t* t = &r->timers[idx];
+    if(t->interval_ns > 0){
+      // Coalesce the missed expirations, as a timerfd does
+      int64_t const now = now_ns();
+      int64_t const missed = now < t->next_ns ? 0 : (now - t->next_ns) / t->interval_ns;
+      t->next_ns += (missed + 1) * t->interval_ns;
+      arm_timer(r, idx);
+    }
+    return ASIO_URING_TIMER_ID + idx;
+  }
+
+  if(idx >= r->len_fds || r->fds[idx].gen != gen)
+    return -1;
+
+  if(cqe->res < 0){
+    printf("[ASIO]: io_uring poll of fd %u failed: %s\n", idx, strerror(-cqe->res));
+    return -1;
+  }
+
+  if(r->fds[idx].edge == false){
+    // Once the event loop handled this batch 
+    if(r->len_rearm == r->cap_rearm){
+      r->cap_rearm = 2*r->cap_rearm + 16;
+      r->rearm = realloc(r->rearm, r->cap_rearm * sizeof(uint64_t));
+      assert(r->rearm != NULL && "Memory exhausted");
+    }
+    r->rearm[r->len_rearm] = cqe->user_data;
+    r->len_rearm += 1;
+
+  } else if((cqe->flags & IORING_CQE_F_MORE) == 0){
+    // The kernel terminated the multishot poll, e.g., CQ overflow
+    arm_poll(r, idx);
+  }
+
+  return idx;
+}
+
+static
+size_t reap(asio_uring_t* r, size_t len, int dst[len])
+{
+  size_t num = 0;
+
+  pthread_mutex_lock(&r->mtx);
+
+  unsigned head = *r->cq_head;
+  unsigned const tail = __atomic_load_n(r->cq_tail, __ATOMIC_ACQUIRE);
+  while(head != tail && num < len){
+    int const id = handle_cqe(r, &r->cqes[head & r->cq_mask]);
+    if(id != -1){
+      dst[num] = id;
+      num += 1;
+    }
+    head += 1;
+  }
+  __atomic_store_n(r->cq_head, head, __ATOMIC_RELEASE);
+
+  pthread_mutex_unlock(&r->mtx);
+
+  return num;
+}
+
+// Returns the sqes to submit
+static
+unsigned rearm_level_polls(asio_uring_t* r)
+{
+  pthread_mutex_lock(&r->mtx);
+
+  for(size_t i = 0; i < r->len_rearm; ++i){
+    uint32_t const gen = r->rearm[i] >> 32;
+    uint32_t const fd = r->rearm[i] & UINT32_MAX;
+    // Removed in between
+    if(r->fds[fd].gen == gen)
+      arm_poll(r, fd);
+  }
+  r->len_rearm = 0;
+
+  unsigned const to_submit = queued(r);
+  pthread_mutex_unlock(&r->mtx);
+  return to_submit;
+}
+
+size_t event_asio_uring(asio_uring_t* r, int timeout_ms, size_t len, int dst[len])
+{
+  assert(r != NULL);
+  assert(timeout_ms > -1);
+  assert(len > 0);
+
+  // The previous batch was handled. If still readable, they complete at once
+  unsigned const to_submit = rearm_level_polls(r);
+
+  // Already completed, no syscall needed
+  size_t num = reap(r, len, dst);
+  if(num > 0)
+    return num;
+
+  // Submits the re-armed timers and polls, and waits. The kernel does not 
+  // wait if fewer than to_submit are submitted, i.e., another thread 
+  // submitted them in between. Then, no event is reported this time 
+  struct __kernel_timespec ts = {.tv_sec = timeout_ms / 1000, .tv_nsec = (timeout_ms % 1000) * 1000000L};
+  struct io_uring_getevents_arg arg = {.ts = (uintptr_t)&ts};
+  int const rc = enter(r, to_submit, 1, IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg, sizeof(arg));
+  if(rc < 0 && errno != ETIME && errno != EINTR && errno != EBUSY && errno != EAGAIN){
+    fprintf(stderr, "io_uring_enter() returned -1: errno %d, %s\n", errno, strerror(errno));
+    assert(0 != 0 && "io_uring_enter failed");
+  }
+
+  return reap(r, len, dst);
+}
+
+#else
+
+// The kernel headers predate the required features. The event loops stay on epoll
+
+bool init_asio_uring(asio_uring_t* r)
+{
+  assert(r != NULL);
+  memset(r, 0, sizeof(*r));
+  printf("[ASIO]: io_uring not supported by the kernel headers\n");
+  return false;
+}
+
+void free_asio_uring(asio_uring_t* r)
+{
+  (void)r;
+  assert(0!=0 && "Not initialized");
+}
+
+void add_fd_asio_uring(asio_uring_t* r, int fd, bool edge)
+{
+  (void)r;
+  (void)fd;
+  (void)edge;
+  assert(0!=0 && "Not initialized");
+}
+
+void rm_fd_asio_uring(asio_uring_t* r, int fd)
+{
+  (void)r;
+  (void)fd;
+  assert(0!=0 && "Not initialized");
+}
+
+int create_timer_ms_asio_uring(asio_uring_t* r, long initial_ms, long interval_ms)
+{
+  (void)r;
+  (void)initial_ms;
+  (void)interval_ms;
+  assert(0!=0 && "Not initialized");
+  return -1;
+}
+
+void rm_timer_asio_uring(asio_uring_t* r, int id)
+{
+  (void)r;
+  (void)id;
+  assert(0!=0 && "Not initialized");
+}
+
+size_t event_asio_uring(asio_uring_t* r, int timeout_ms, size_t len, int dst[len])
+{
+  (void)r;
+  (void)timeout_ms;
+  (void)len;
+  (void)dst;
+  assert(0!=0 && "Not initialized");
+  return 0;
+}
+
+#endif
@@ -0,0 +1,158 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+#ifndef ASYNC_INPUT_OUTPUT_URING_H
+#define ASYNC_INPUT_OUTPUT_URING_H
+
+// io_uring backend of the event loops, i.e., asio_ric, asio_iapp, 
+// asio_agent and asio_xapp. The readiness of the fds is reported through
+// polls: multishot for the edge triggered ones, and one shot re-armed
+// before the next wait for the level triggered ones. The timers are 
+// io_uring timeouts, so no timerfd is read on expiry. Completions are reaped
+// from the shared ring without syscalls, and the re-armed polls and timers
+// are submitted with the next wait, i.e., one io_uring_enter per batch.
+// Requires kernel 5.17, otherwise the event loops stay on epoll.
+// Selected through the configuration file:
+//  IO_BACKEND = io_uring 
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define ASIO_URING_SQ_ENTRIES 256
+#define ASIO_URING_CQ_ENTRIES 4096
+
+// Timer ids start here, far from the fds, so that the event loops can 
+// keep both in the same maps
+#define ASIO_URING_TIMER_ID (1 << 30)
+
+typedef enum{
+  EPOLL_ASIO_BACKEND,
+  IO_URING_ASIO_BACKEND,
+} asio_backend_e;
+
+// Process wide. Set before the event loops are initialized
+void set_backend_asio(asio_backend_e b);
+
+asio_backend_e backend_asio(void);
+
+// False if name is neither "epoll" nor "io_uring"
+bool set_backend_str_asio(char const* name);
+
+// NULL if unknown
+char const* backend_asio_str(asio_backend_e b);
+
+// From linux/io_uring.h and linux/time_types.h
+struct io_uring_sqe;
+struct io_uring_cqe;
+struct __kernel_timespec;
+
+typedef struct{
+  uint32_t gen; // 0 if not registered
+  bool edge;
+} asio_uring_fd_t;
+
+typedef struct{
+  uint32_t gen; // 0 if free
+  int64_t next_ns;
+  int64_t interval_ns;
+} asio_uring_timer_t;
+
+typedef struct{
+  int fd;
+
+  // Shared with the kernel
+  void* ring;
+  size_t len_ring;
+  struct io_uring_sqe* sqes;
+  size_t len_sqes;
+
+  unsigned* sq_head;
+  unsigned* sq_tail;
+  unsigned sq_mask;
+  unsigned* sq_array;
+
+  unsigned* cq_head;
+  unsigned* cq_tail;
+  unsigned cq_mask;
+  struct io_uring_cqe* cqes;
+
+  // The timeouts are read when submitted. One per sqe
+  struct __kernel_timespec* ts;
+
+  // Indexed by fd
+  asio_uring_fd_t* fds;
+  size_t len_fds;
+
+  // Level triggered polls that completed in the last batch
+  uint64_t* rearm;
+  size_t len_rearm;
+  size_t cap_rearm;
+
+  asio_uring_timer_t* timers;
+  size_t len_timers;
+
+  uint32_t next_gen;
+
+  // Submissions happen from any thread, the reaping only from the event loop
+  pthread_mutex_t mtx;
+
+  atomic_uint_fast64_t syscalls;
+} asio_uring_t;
+
+// False if the kernel does not support it
+bool init_asio_uring(asio_uring_t* r);
+
+// NULL if the backend is epoll or the kernel does not support io_uring
+asio_uring_t* create_asio_uring(void);
+
+void free_asio_uring(asio_uring_t* r);
+
+// Edge triggered: as EPOLLET, one event per wake-up, which may coalesce
+// several writes. Level triggered: reported again after the next 
+// event_asio_uring() call while still readable
+void add_fd_asio_uring(asio_uring_t* r, int fd, bool edge);
+
+// The fd is not closed
+void rm_fd_asio_uring(asio_uring_t* r, int fd);
+
+// Same semantic as a timerfd: initial_ms == 0 disarms it, interval_ms == 0 
+// is a one shot timer and late expirations are coalesced. Returns its id 
+int create_timer_ms_asio_uring(asio_uring_t* r, long initial_ms, long interval_ms);
+
+void rm_timer_asio_uring(asio_uring_t* r, int id);
+
+static inline
+bool is_timer_asio_uring(int id)
+{
+  return id >= ASIO_URING_TIMER_ID;
+}
+
+// Waits up to timeout_ms. Writes the ready fds and the expired timers.
+// Returns their number, 0 if none. Only from the event loop thread
+size_t event_asio_uring(asio_uring_t* r, int timeout_ms, size_t len, int dst[len]);
+
+// io_uring_enter calls since init_asio_uring()
+uint64_t syscalls_asio_uring(asio_uring_t const* r);
+
+#endif
@@ -0,0 +1,43 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+#ifndef CONN_STATE_H
+#define CONN_STATE_H
+
+// Connection of an E2 Node or an xApp with a nearRT-RIC, as reported to 
+// the application, e.g., to stop feeding a RIC that is not there
+
+typedef enum{
+  // E2 or E42 Setup Response received
+  CONNECTED_CONN_STATE,
+  // SCTP association lost. The setup is retried with backoff
+  DISCONNECTED_CONN_STATE,
+  // E2 or E42 Setup Request sent again after a timeout
+  RETRY_CONN_STATE,
+
+  END_CONN_STATE
+} conn_state_e;
+
+// addr of the nearRT-RIC. Called from the thread of the E2 Node or the xApp,
+// i.e., it must not block
+typedef void (*conn_state_cb)(char const* addr, conn_state_e state, void* data);
+
+#endif
@@ -47,5 +47,34 @@ typedef struct{
 #endif
 } e2ap_version_t;
 
+// Runtime view of the E2AP version the codec was compiled with
+typedef enum{
+  E2AP_V1_01_VERSION,
+  E2AP_V2_03_VERSION,
+  E2AP_V3_01_VERSION,
+
+  END_E2AP_VERSION
+} e2ap_version_e;
+
+#ifdef E2AP_V1
+#define E2AP_COMPILED_VERSION E2AP_V1_01_VERSION
+#elif E2AP_V2
+#define E2AP_COMPILED_VERSION E2AP_V2_03_VERSION
+#elif E2AP_V3
+#define E2AP_COMPILED_VERSION E2AP_V3_01_VERSION
+#endif
+
+static inline
+const char* e2ap_version_str(e2ap_version_e v)
+{
+  if(v == E2AP_V1_01_VERSION)
+    return "v1.01";
+  else if(v == E2AP_V2_03_VERSION)
+    return "v2.03";
+  else if(v == E2AP_V3_01_VERSION)
+    return "v3.01";
+  return "unknown";
+}
+
 #endif
 
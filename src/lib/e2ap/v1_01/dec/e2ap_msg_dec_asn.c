@@ -22,6 +22,7 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "e2ap_msg_dec_asn.h"
 
@@ -2045,8 +2046,8 @@ e2ap_msg_t e2ap_dec_node_configuration_update(const E2AP_PDU_t* pdu)
 e2ap_msg_t e2ap_dec_node_configuration_update_ack(const E2AP_PDU_t* pdu)
 {
   assert(pdu != NULL);
- assert(0!=0 && "Not implemented");
-  e2ap_msg_t ret;
+  // Not implemented, i.e., discarded
+  e2ap_msg_t ret = {.type = NONE_E2_MSG_TYPE};
   return ret;
 }
 
@@ -2055,8 +2056,8 @@ e2ap_msg_t e2ap_dec_node_configuration_update_ack(const E2AP_PDU_t* pdu)
 e2ap_msg_t e2ap_dec_node_configuration_update_failure(const E2AP_PDU_t* pdu)\
 {
   assert(pdu != NULL);
- assert(0!=0 && "Not implemented");
-  e2ap_msg_t ret;
+  // Not implemented, i.e., discarded
+  e2ap_msg_t ret = {.type = NONE_E2_MSG_TYPE};
   return ret;
 }
 
@@ -2065,8 +2066,8 @@ e2ap_msg_t e2ap_dec_node_configuration_update_failure(const E2AP_PDU_t* pdu)\
  e2ap_msg_t e2ap_dec_connection_update(const E2AP_PDU_t* pdu)
 {
   assert(pdu != NULL);
- assert(0!=0 && "Not implemented");
-  e2ap_msg_t ret;
+  // Not implemented, i.e., discarded
+  e2ap_msg_t ret = {.type = NONE_E2_MSG_TYPE};
   return ret;
 }
 
@@ -2075,8 +2076,8 @@ e2ap_msg_t e2ap_dec_node_configuration_update_failure(const E2AP_PDU_t* pdu)\
  e2ap_msg_t e2ap_dec_connection_update_ack(const E2AP_PDU_t* pdu)
 {
   assert(pdu != NULL);
- assert(0!=0 && "Not implemented");
-  e2ap_msg_t ret;
+  // Not implemented, i.e., discarded
+  e2ap_msg_t ret = {.type = NONE_E2_MSG_TYPE};
   return ret;
 }
 
@@ -2085,12 +2086,26 @@ e2ap_msg_t e2ap_dec_node_configuration_update_failure(const E2AP_PDU_t* pdu)\
 e2ap_msg_t e2ap_dec_connection_update_failure(const E2AP_PDU_t* pdu)
 {
   assert(pdu != NULL);
- assert(0!=0 && "Not implemented");
-  e2ap_msg_t ret;
+  // Not implemented, i.e., discarded
+  e2ap_msg_t ret = {.type = NONE_E2_MSG_TYPE};
   return ret;
 }
 
 
+// The xApp token and the consumer group travel as RAN Functions with a 
+// reserved ID and OID. A genuine RAN Function with that ID is kept as such
+static
+bool is_e42_setup_item(const RANfunction_Item_t* src, long id, char const* oid)
+{
+  if(src->ranFunctionID != id)
+    return false;
+
+  size_t const len = strlen(oid);
+  return src->ranFunctionOID != NULL 
+        && src->ranFunctionOID->size == len 
+        && memcmp(src->ranFunctionOID->buf, oid, len) == 0;
+}
+
 // xApp -> iApp
 e2ap_msg_t e2ap_dec_e42_setup_request(const struct E2AP_PDU* pdu)
 {
@@ -2114,15 +2129,39 @@ e2ap_msg_t e2ap_dec_e42_setup_request(const struct E2AP_PDU* pdu)
   assert(ran_list->value.present == E42setupRequestIEs__value_PR_RANfunctions_List);
 
   size_t const sz = ran_list->value.choice.RANfunctions_List.list.count;
-  sr->len_rf = sz;
+  RANfunction_ItemIEs_t** arr = (RANfunction_ItemIEs_t**)ran_list->value.choice.RANfunctions_List.list.array;
+
+  // xApp token and consumer group. Optional
+  for(size_t i = 0; i < sz; ++i){
+    const RANfunction_Item_t* src = &arr[i]->value.choice.RANfunction_Item;
+    if(is_e42_setup_item(src, E42_XAPP_TOKEN_RAN_FUNC_ID, E42_XAPP_TOKEN_OID)){
+      assert(sr->token == NULL && "Only one xApp token expected");
+      sr->token = calloc(1, sizeof(byte_array_t));
+      assert(sr->token != NULL && "Memory exhausted");
+      *sr->token = copy_ostring_to_ba(src->ranFunctionDefinition); 
+    } else if(is_e42_setup_item(src, E42_XAPP_GROUP_RAN_FUNC_ID, E42_XAPP_GROUP_OID)){
+      assert(sr->group == NULL && "Only one consumer group expected");
+      sr->group = calloc(1, sizeof(byte_array_t));
+      assert(sr->group != NULL && "Memory exhausted");
+      *sr->group = copy_ostring_to_ba(src->ranFunctionDefinition); 
+    }
+  }
+
+  sr->len_rf = sz - (sr->token != NULL) - (sr->group != NULL);
 
   if(sr->len_rf > 0){
     sr->ran_func_item = calloc(sr->len_rf, sizeof(ran_function_t));
   }
-  RANfunction_ItemIEs_t** arr = (RANfunction_ItemIEs_t**)ran_list->value.choice.RANfunctions_List.list.array;
-  for(size_t i =0; i < sr->len_rf; ++i){
-    ran_function_t* dst = &sr->ran_func_item[i];
+
+  size_t j = 0;
+  for(size_t i = 0; i < sz; ++i){
     const RANfunction_Item_t* src = &arr[i]->value.choice.RANfunction_Item;
+    if(is_e42_setup_item(src, E42_XAPP_TOKEN_RAN_FUNC_ID, E42_XAPP_TOKEN_OID) 
+        || is_e42_setup_item(src, E42_XAPP_GROUP_RAN_FUNC_ID, E42_XAPP_GROUP_OID))
+      continue;
+
+    ran_function_t* dst = &sr->ran_func_item[j];
+    j += 1;
 
     assert(src->ranFunctionID <= MAX_RAN_FUNC_ID);
     dst->id = src->ranFunctionID; 
@@ -2137,6 +2176,7 @@ e2ap_msg_t e2ap_dec_e42_setup_request(const struct E2AP_PDU* pdu)
       *dst->oid = copy_ostring_to_ba(*src->ranFunctionOID);
     }
   }
+  assert(j == sr->len_rf);
 
   return ret;
 }
@@ -2422,9 +2462,9 @@ e2_msg_type_t e2ap_get_msg_type(const E2AP_PDU_t* pdu)
 
 
     default:
-      assert(0 != 0  && "unhandled message");
+      // E.g., a procedure of another E2AP version
+      break;
   }
-  assert(0!=0 && "Invalid Path");
   return NONE_E2_MSG_TYPE;
 }
 
@@ -2439,7 +2479,11 @@ E2AP_PDU_t* e2ap_create_pdu(const uint8_t* buffer, int buffer_len)
   const asn_dec_rval_t rval = asn_decode_e2ap_v1_01(NULL, syntax, &asn_DEF_E2AP_PDU_e2ap_v1_01, (void**)&pdu, buffer, buffer_len);
   //printf("rval.code = %d\n", rval.code);
   //fprintf(stdout, "length of data %ld\n", rval.consumed);
-  assert(rval.code == RC_OK && "Are you sending data in ATS_ALIGEND_BASIC_PER syntax?");
+  // Not ATS_ALIGNED_BASIC_PER or not E2AP v1.01, e.g., a peer speaking another E2AP version 
+  if(rval.code != RC_OK){
+    ASN_STRUCT_FREE(asn_DEF_E2AP_PDU_e2ap_v1_01, pdu);
+    return NULL;
+  }
 
   //xer_fprint_e2ap_v1_01(stdout, &asn_DEF_E2AP_PDU_e2ap_v1_01, pdu);
   //fflush(stdout);
@@ -2451,10 +2495,18 @@ e2ap_msg_t e2ap_msg_dec_asn(e2ap_asn_t* asn, byte_array_t ba)
 {
   assert(ba.buf != NULL && ba.len > 0);
   E2AP_PDU_t* pdu = e2ap_create_pdu(ba.buf, ba.len);
-  assert(pdu != NULL);
+  if(pdu == NULL){
+    e2ap_msg_t msg = {.type = NONE_E2_MSG_TYPE};
+    return msg; 
+  }
   const e2_msg_type_t msg_type = e2ap_get_msg_type(pdu);  
   //printf("Decoding message type = %d \n", msg_type);
-  assert(asn->dec_msg[msg_type] != NULL);
+  // A well-formed PDU of a procedure without decoder is discarded too
+  if(msg_type == NONE_E2_MSG_TYPE || asn->dec_msg[msg_type] == NULL){
+    ASN_STRUCT_FREE(asn_DEF_E2AP_PDU_e2ap_v1_01,pdu);
+    e2ap_msg_t msg = {.type = NONE_E2_MSG_TYPE};
+    return msg; 
+  }
   e2ap_msg_t msg = asn->dec_msg[msg_type](pdu);
 //  xer_fprint_e2ap_v1_01(stdout, &asn_DEF_E2AP_PDU_e2ap_v1_01, pdu);
 //  fflush(stdout);
@@ -44,6 +44,18 @@ e42_setup_request_t cp_e42_setup_request(const e42_setup_request_t* src)
 
  dst.len_rf = src->len_rf;
 
+ if(src->token != NULL){
+  dst.token = calloc(1, sizeof(byte_array_t));
+  assert(dst.token != NULL && "Memory exausted");
+  *dst.token = copy_byte_array(*src->token);
+ }
+
+ if(src->group != NULL){
+  dst.group = calloc(1, sizeof(byte_array_t));
+  assert(dst.group != NULL && "Memory exausted");
+  *dst.group = copy_byte_array(*src->group);
+ }
+
  return dst;
 }
 
@@ -54,6 +66,16 @@ void free_e42_setup_request(e42_setup_request_t* src)
     free_ran_function(&src->ran_func_item[i]);
   }
   free(src->ran_func_item);
+
+  if(src->token != NULL){
+    free_byte_array(*src->token);
+    free(src->token);
+  }
+
+  if(src->group != NULL){
+    free_byte_array(*src->group);
+    free(src->group);
+  }
 }
 
 bool eq_e42_setup_request(const e42_setup_request_t* m0, const e42_setup_request_t* m1)
@@ -77,6 +99,17 @@ bool eq_e42_setup_request(const e42_setup_request_t* m0, const e42_setup_request
     if(eq_ran_function(&m0->ran_func_item[i], &m1->ran_func_item[i]) == false)
       return false;
   }
-  return true;
+
+  if(m0->token == NULL || m1->token == NULL){
+    if(m0->token != m1->token)
+      return false;
+  } else if(eq_byte_array(m0->token, m1->token) == false){
+    return false;
+  }
+
+  if(m0->group == NULL || m1->group == NULL)
+    return m0->group == m1->group;
+
+  return eq_byte_array(m0->group, m1->group);
 }
 
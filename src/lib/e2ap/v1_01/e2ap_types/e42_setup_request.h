@@ -25,9 +25,24 @@
 
 #include "common/e2ap_ran_function.h"
 
+// The xApp token travels in the list of RAN Functions, as a RAN Function
+// with a reserved ID and OID. iApps unaware of it just see one more RAN 
+// Function. The SM plugins of the nearRT-RIC and the xApp may not use the
+// reserved IDs, i.e., load_plugin_ric refuses them
+#define E42_XAPP_TOKEN_RAN_FUNC_ID 0
+#define E42_XAPP_TOKEN_OID "xApp-token"
+#define E42_XAPP_GROUP_RAN_FUNC_ID 1
+#define E42_XAPP_GROUP_OID "xApp-group"
+
 typedef struct e42_setup_request {
   ran_function_t* ran_func_item;
   size_t len_rf;
+
+  // Optional. Stable identity of the xApp, used to resume its session
+  byte_array_t* token;
+
+  // Optional. Consumer group that the xApp joins
+  byte_array_t* group;
 } e42_setup_request_t;
 
 
@@ -22,6 +22,9 @@
 
 #include "ric_subscription_failure.h"
 
+#include <assert.h>
+#include <stdlib.h>
+
 bool eq_ric_subscritption_failure(const ric_subscription_failure_t* m0, const ric_subscription_failure_t* m1)
 {
   if(m0 == m1) return true;
@@ -46,3 +49,28 @@ bool eq_ric_subscritption_failure(const ric_subscription_failure_t* m0, const ri
   return true;
 }
 
+
+ric_subscription_failure_t init_ric_subscription_failure(ric_gen_id_t ric_id, cause_t cause)
+{
+  ric_subscription_failure_t sf = {.ric_id = ric_id, .len_na = 1};
+
+  sf.not_admitted = calloc(1, sizeof(ric_action_not_admitted_t));
+  assert(sf.not_admitted != NULL && "Memory exhausted");
+  sf.not_admitted[0].ric_act_id = 0;
+  sf.not_admitted[0].cause = cause;
+
+  return sf;
+}
+
+// E2AP v1 carries one cause per action not admitted. The first one stands for all 
+cause_t cause_ric_subscription_failure(ric_subscription_failure_t const* sf)
+{
+  assert(sf != NULL);
+
+  if(sf->len_na == 0){
+    cause_t const c = {.present = CAUSE_MISC, .misc = CAUSE_MISC_UNSPECIFIED};
+    return c;
+  }
+
+  return sf->not_admitted[0].cause;
+}
@@ -40,4 +40,9 @@ typedef struct {
 
 bool eq_ric_subscritption_failure(const ric_subscription_failure_t* m0, const ric_subscription_failure_t* m1);
 
+// Failure of a subscription with one action, i.e., the ones of the RIC
+ric_subscription_failure_t init_ric_subscription_failure(ric_gen_id_t ric_id, cause_t cause);
+
+cause_t cause_ric_subscription_failure(ric_subscription_failure_t const* sf);
+
 #endif
@@ -2672,6 +2672,8 @@ struct E2AP_PDU* e2ap_enc_e42_setup_request_asn_pdu(const e42_setup_request_t* s
     ran_list->value.present = E42setupRequestIEs__value_PR_RANfunctions_List;
 
     for (size_t i = 0; i < sr->len_rf; ++i) {
+      uint16_t const id = sr->ran_func_item[i].id;
+      assert(id != E42_XAPP_TOKEN_RAN_FUNC_ID && id != E42_XAPP_GROUP_RAN_FUNC_ID && "RAN Function ID reserved by E42");
       RANfunction_ItemIEs_t* ran_function_item_ie = calloc(1,sizeof(RANfunction_ItemIEs_t));
       ran_function_item_ie->id = ProtocolIE_ID_id_RANfunction_Item;
       ran_function_item_ie->criticality = Criticality_reject;
@@ -2680,6 +2682,34 @@ struct E2AP_PDU* e2ap_enc_e42_setup_request_asn_pdu(const e42_setup_request_t* s
       int rc = ASN_SEQUENCE_ADD(&ran_list->value.choice.RANfunctions_List.list, ran_function_item_ie);
       assert(rc == 0);
     }
+
+    // xApp token. Optional
+    if(sr->token != NULL){
+      byte_array_t oid = cp_str_to_ba(E42_XAPP_TOKEN_OID);
+      ran_function_t tkn = {.id = E42_XAPP_TOKEN_RAN_FUNC_ID, .defn = *sr->token, .oid = &oid};
+      RANfunction_ItemIEs_t* ran_function_item_ie = calloc(1,sizeof(RANfunction_ItemIEs_t));
+      ran_function_item_ie->id = ProtocolIE_ID_id_RANfunction_Item;
+      ran_function_item_ie->criticality = Criticality_reject;
+      ran_function_item_ie->value.present = RANfunction_ItemIEs__value_PR_RANfunction_Item;
+      ran_function_item_ie->value.choice.RANfunction_Item = copy_ran_function(&tkn);
+      free_byte_array(oid);
+      int rc = ASN_SEQUENCE_ADD(&ran_list->value.choice.RANfunctions_List.list, ran_function_item_ie);
+      assert(rc == 0);
+    }
+
+    // Consumer group. Optional
+    if(sr->group != NULL){
+      byte_array_t oid = cp_str_to_ba(E42_XAPP_GROUP_OID);
+      ran_function_t grp = {.id = E42_XAPP_GROUP_RAN_FUNC_ID, .defn = *sr->group, .oid = &oid};
+      RANfunction_ItemIEs_t* ran_function_item_ie = calloc(1,sizeof(RANfunction_ItemIEs_t));
+      ran_function_item_ie->id = ProtocolIE_ID_id_RANfunction_Item;
+      ran_function_item_ie->criticality = Criticality_reject;
+      ran_function_item_ie->value.present = RANfunction_ItemIEs__value_PR_RANfunction_Item;
+      ran_function_item_ie->value.choice.RANfunction_Item = copy_ran_function(&grp);
+      free_byte_array(oid);
+      int rc = ASN_SEQUENCE_ADD(&ran_list->value.choice.RANfunctions_List.list, ran_function_item_ie);
+      assert(rc == 0);
+    }
     int rc = ASN_SEQUENCE_ADD(&out->protocolIEs.list, ran_list);
     assert(rc == 0);
   }
@@ -628,6 +628,16 @@ void e2ap_free_e42_setup_request(e42_setup_request_t* sr)
     free_ran_function(&sr->ran_func_item[i]);
   }
   free(sr->ran_func_item);
+
+  if(sr->token != NULL){
+    free_byte_array(*sr->token);
+    free(sr->token);
+  }
+
+  if(sr->group != NULL){
+    free_byte_array(*sr->group);
+    free(sr->group);
+  }
 }
 
 // iApp -> xApp
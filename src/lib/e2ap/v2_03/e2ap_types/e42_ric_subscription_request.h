@@ -30,6 +30,14 @@
 
 #include <stdbool.h>
 
+// Reserved RIC Action. Its definition carries the indication filter of the xApp,
+// evaluated at the iApp and never forwarded to the E2 Node
+#define E42_IND_FILTER_ACTION_ID 255
+
+// Reserved RIC Action. Its definition carries the overload policy of the xApp,
+// applied at the iApp and never forwarded to the E2 Node
+#define E42_OVERLOAD_ACTION_ID 254
+
 typedef struct{
  uint16_t xapp_id;
  global_e2_node_id_t id;
@@ -633,16 +633,14 @@ byte_array_t e2ap_enc_subscription_failure_asn_msg(const e2ap_msg_t* msg)
 
 E2AP_PDU_t* e2ap_enc_subscription_failure_asn_pdu(const ric_subscription_failure_t* sf)
 {
+  assert(sf != NULL);
+
   // Message Type. Mandatory
   E2AP_PDU_t* pdu = calloc(1, sizeof(E2AP_PDU_t));
   assert(pdu != NULL && "Memory exhausted");
- 
-  assert(0 != 0 && "Untested code");
-  (void)sf;
-
- /* 
   pdu->present = E2AP_PDU_PR_unsuccessfulOutcome;
   pdu->choice.unsuccessfulOutcome = calloc(1,sizeof(UnsuccessfulOutcome_t)); 
+  assert(pdu->choice.unsuccessfulOutcome != NULL && "Memory exhausted");
   pdu->choice.unsuccessfulOutcome->procedureCode = ProcedureCode_id_RICsubscription;
   pdu->choice.unsuccessfulOutcome->criticality = Criticality_reject;
   pdu->choice.unsuccessfulOutcome->value.present = UnsuccessfulOutcome__value_PR_RICsubscriptionFailure;
@@ -651,6 +649,7 @@ E2AP_PDU_t* e2ap_enc_subscription_failure_asn_pdu(const ric_subscription_failure
 
   // RIC Request ID. Mandatory
   RICsubscriptionFailure_IEs_t* req_id = calloc(1,sizeof(RICsubscriptionFailure_IEs_t));
+  assert(req_id != NULL && "Memory exhausted");
   req_id->id = ProtocolIE_ID_id_RICrequestID;
   req_id->criticality = Criticality_reject;
   req_id->value.present = RICsubscriptionFailure_IEs__value_PR_RICrequestID;
@@ -661,6 +660,7 @@ E2AP_PDU_t* e2ap_enc_subscription_failure_asn_pdu(const ric_subscription_failure
 
   // RAN Function ID. Mandatory 
   RICsubscriptionFailure_IEs_t* ran_func = calloc(1,sizeof(RICsubscriptionFailure_IEs_t));
+  assert(ran_func != NULL && "Memory exhausted");
   ran_func->id = ProtocolIE_ID_id_RANfunctionID;
   ran_func->criticality = Criticality_reject;
   ran_func->value.present = RICsubscriptionFailure_IEs__value_PR_RANfunctionID;
@@ -668,39 +668,19 @@ E2AP_PDU_t* e2ap_enc_subscription_failure_asn_pdu(const ric_subscription_failure
   rc = ASN_SEQUENCE_ADD(&out->protocolIEs.list, ran_func);
   assert(rc == 0);
 
-  // RIC Actions Not Admitted List
-  RICsubscriptionFailure_IEs_t* act_not_adm_list = calloc(1,sizeof(RICsubscriptionFailure_IEs_t));
-  act_not_adm_list->id = ProtocolIE_ID_id_RICactions_NotAdmitted;
-  act_not_adm_list->criticality = Criticality_reject;
-  act_not_adm_list->value.present = RICsubscriptionFailure_IEs__value_PR_RICaction_NotAdmitted_List;
-
-  for(size_t i = 0; i < sf->len_na; ++i) {
-    // RIC Action ID. Mandatory  
-    RICaction_NotAdmitted_ItemIEs_t* nai = calloc(1, sizeof(RICaction_NotAdmitted_ItemIEs_t)); 
-    nai->id = ProtocolIE_ID_id_RICaction_NotAdmitted_Item;	
-    nai->criticality = Criticality_reject;
-    nai->value.present = RICaction_NotAdmitted_ItemIEs__value_PR_RICaction_NotAdmitted_Item;
-    RICaction_NotAdmitted_Item_t* dst =  &nai->value.choice.RICaction_NotAdmitted_Item;
-    const ric_action_not_admitted_t* src = &sf->not_admitted[i];
-    dst->ricActionID = src->ric_act_id;
-    dst->cause = copy_cause(src->cause);
-    rc = ASN_SEQUENCE_ADD(&act_not_adm_list->value.choice.RICaction_NotAdmitted_List.list,nai);
-    assert(rc == 0);
-  }
-  rc = ASN_SEQUENCE_ADD(&out->protocolIEs.list, act_not_adm_list);
+  // Cause. Mandatory
+  RICsubscriptionFailure_IEs_t* cause = calloc(1,sizeof(RICsubscriptionFailure_IEs_t));
+  assert(cause != NULL && "Memory exhausted");
+  cause->id = ProtocolIE_ID_id_Cause;
+  cause->criticality = Criticality_reject;
+  cause->value.present = RICsubscriptionFailure_IEs__value_PR_Cause;
+  cause->value.choice.Cause = copy_cause(sf->cause);
+  rc = ASN_SEQUENCE_ADD(&out->protocolIEs.list, cause);
   assert(rc == 0);
 
- // Criticality Diagnosis. Optional
- if(sf->crit_diag  != NULL){
-  RICsubscriptionFailure_IEs_t* crit_diag = calloc(1,sizeof(RICsubscriptionFailure_IEs_t));
-  crit_diag->id = ProtocolIE_ID_id_CriticalityDiagnostics;
-  crit_diag->criticality = Criticality_reject;
-  crit_diag->value.present = RICsubscriptionFailure_IEs__value_PR_CriticalityDiagnostics; 
-  assert(0!=0 && "Not Implemented yet");
-  rc = ASN_SEQUENCE_ADD(&out->protocolIEs.list, crit_diag);
-  assert(rc == 0);
- }
- */
+  // Criticality Diagnosis. Optional
+  assert(sf->crit_diag == NULL && "Not Implemented yet");
+
   return pdu;
 }
 
@@ -2845,9 +2825,29 @@ byte_array_t e2ap_enc_removal_request_asn_msg(const e2ap_msg_t* msg)
 struct E2AP_PDU* e2ap_enc_removal_request_asn_pdu(const e2_removal_request_t* rr)
 {
   assert(rr != NULL);
-  assert(0 != 0 && "Not implemented");
-  struct E2AP_PDU* pdu = calloc(1, sizeof(struct E2AP_PDU));
+
+  // Message Type. Mandatory
+  E2AP_PDU_t* pdu = calloc(1, sizeof(E2AP_PDU_t));
   assert(pdu != NULL && "Memory exhausted");
+  pdu->present = E2AP_PDU_PR_initiatingMessage; 
+  pdu->choice.initiatingMessage = calloc(1, sizeof(InitiatingMessage_t));
+  assert(pdu->choice.initiatingMessage != NULL && "Memory exhausted");
+  pdu->choice.initiatingMessage->procedureCode = ProcedureCode_id_E2removal; 
+  pdu->choice.initiatingMessage->criticality = Criticality_reject;
+  pdu->choice.initiatingMessage->value.present = InitiatingMessage__value_PR_E2RemovalRequest; 
+
+  E2RemovalRequest_t* out = &pdu->choice.initiatingMessage->value.choice.E2RemovalRequest;
+
+  // Transaction ID. Mandatory
+  E2RemovalRequestIEs_t* trans_id = calloc(1, sizeof(E2RemovalRequestIEs_t)); 
+  assert(trans_id != NULL && "Memory exhausted");
+  trans_id->id = ProtocolIE_ID_id_TransactionID;	
+  trans_id->criticality = Criticality_reject;
+  trans_id->value.present = E2RemovalRequestIEs__value_PR_TransactionID;
+  trans_id->value.choice.TransactionID = rr->trans_id;
+  int const rc = ASN_SEQUENCE_ADD(&out->protocolIEs.list, trans_id);
+  assert(rc == 0);
+
   return pdu;
 }
 
@@ -3106,6 +3106,8 @@ struct E2AP_PDU* e2ap_enc_e42_setup_request_asn_pdu(const e42_setup_request_t* s
     ran_list->value.present = E42setupRequestIEs__value_PR_RANfunctions_List;
 
     for (size_t i = 0; i < sr->len_rf; ++i) {
+      uint16_t const id = sr->ran_func_item[i].id;
+      assert(id != E42_XAPP_TOKEN_RAN_FUNC_ID && id != E42_XAPP_GROUP_RAN_FUNC_ID && "RAN Function ID reserved by E42");
       RANfunction_ItemIEs_t* ran_function_item_ie = calloc(1,sizeof(RANfunction_ItemIEs_t));
       ran_function_item_ie->id = ProtocolIE_ID_id_RANfunction_Item;
       ran_function_item_ie->criticality = Criticality_reject;
@@ -3114,6 +3116,34 @@ struct E2AP_PDU* e2ap_enc_e42_setup_request_asn_pdu(const e42_setup_request_t* s
       int rc = ASN_SEQUENCE_ADD(&ran_list->value.choice.RANfunctions_List.list, ran_function_item_ie);
       assert(rc == 0);
     }
+
+    // xApp token. Optional
+    if(sr->token != NULL){
+      ran_function_t tkn = {.id = E42_XAPP_TOKEN_RAN_FUNC_ID, .defn = *sr->token};
+      tkn.oid = cp_str_to_ba(E42_XAPP_TOKEN_OID);
+      RANfunction_ItemIEs_t* ran_function_item_ie = calloc(1,sizeof(RANfunction_ItemIEs_t));
+      ran_function_item_ie->id = ProtocolIE_ID_id_RANfunction_Item;
+      ran_function_item_ie->criticality = Criticality_reject;
+      ran_function_item_ie->value.present = RANfunction_ItemIEs__value_PR_RANfunction_Item;
+      ran_function_item_ie->value.choice.RANfunction_Item = copy_ran_function(&tkn);
+      free_byte_array(tkn.oid);
+      int rc = ASN_SEQUENCE_ADD(&ran_list->value.choice.RANfunctions_List.list, ran_function_item_ie);
+      assert(rc == 0);
+    }
+
+    // Consumer group. Optional
+    if(sr->group != NULL){
+      ran_function_t grp = {.id = E42_XAPP_GROUP_RAN_FUNC_ID, .defn = *sr->group};
+      grp.oid = cp_str_to_ba(E42_XAPP_GROUP_OID);
+      RANfunction_ItemIEs_t* ran_function_item_ie = calloc(1,sizeof(RANfunction_ItemIEs_t));
+      ran_function_item_ie->id = ProtocolIE_ID_id_RANfunction_Item;
+      ran_function_item_ie->criticality = Criticality_reject;
+      ran_function_item_ie->value.present = RANfunction_ItemIEs__value_PR_RANfunction_Item;
+      ran_function_item_ie->value.choice.RANfunction_Item = copy_ran_function(&grp);
+      free_byte_array(grp.oid);
+      int rc = ASN_SEQUENCE_ADD(&ran_list->value.choice.RANfunctions_List.list, ran_function_item_ie);
+      assert(rc == 0);
+    }
     int rc = ASN_SEQUENCE_ADD(&out->protocolIEs.list, ran_list);
     assert(rc == 0);
   }
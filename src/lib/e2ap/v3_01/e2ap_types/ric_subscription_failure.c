@@ -22,6 +22,8 @@
 
 #include "ric_subscription_failure.h"
 
+#include <assert.h>
+
 bool eq_ric_subscritption_failure(const ric_subscription_failure_t* m0, const ric_subscription_failure_t* m1)
 {
   if(m0 == m1) return true;
@@ -40,3 +42,15 @@ bool eq_ric_subscritption_failure(const ric_subscription_failure_t* m0, const ri
   return true;
 }
 
+
+ric_subscription_failure_t init_ric_subscription_failure(ric_gen_id_t ric_id, cause_t cause)
+{
+  ric_subscription_failure_t sf = {.ric_id = ric_id, .cause = cause};
+  return sf;
+}
+
+cause_t cause_ric_subscription_failure(ric_subscription_failure_t const* sf)
+{
+  assert(sf != NULL);
+  return sf->cause;
+}
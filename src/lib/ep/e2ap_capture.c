@@ -0,0 +1,663 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+#include "e2ap_capture.h"
+#include "../../util/conf_file.h"
+
+#include <arpa/inet.h>
+#include <assert.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// pcapng blocks and options
+#define SHB_PCAPNG 0x0A0D0D0A
+#define IDB_PCAPNG 0x00000001
+#define EPB_PCAPNG 0x00000006
+#define BYTE_ORDER_MAGIC_PCAPNG 0x1A2B3C4D
+#define OPT_END_PCAPNG 0
+#define OPT_COMMENT_PCAPNG 1
+#define OPT_IF_NAME_PCAPNG 2
+#define OPT_SHB_USERAPPL_PCAPNG 4
+#define LINKTYPE_IPV4 228
+
+#define IPV4_HDR_LEN 20
+#define SCTP_HDR_LEN 12
+#define SCTP_DATA_HDR_LEN 16
+// The DATA chunk is padded to 4 bytes, and the IPv4 total length is 16 bits
+#define MAX_PAYLOAD_CAPTURE (((0xFFFF - IPV4_HDR_LEN - SCTP_HDR_LEN) & ~3) - SCTP_DATA_HDR_LEN)
+
+typedef struct{
+  e2ap_capture_hdr_t hdr;
+  int64_t tstamp_us;
+  byte_array_t ba;
+  // May be NULL
+  char* tag;
+  char* note;
+} cap_rec_t;
+
+typedef struct{
+  struct sockaddr_in peer;
+  char* tag;
+} cap_tag_t;
+
+typedef struct{
+  atomic_bool enabled;
+  // The RIC, an agent and an xApp may run in the same process
+  size_t users;
+
+  // Ring of files
+  char* base;
+  size_t num_files;
+  size_t file_size;
+  size_t idx;
+  size_t bytes;
+  FILE* fp;
+
+  // Pending messages. Ring buffer
+  cap_rec_t* rec;
+  size_t head;
+  size_t len;
+  atomic_uint_fast64_t dropped;
+
+  size_t len_tag;
+  cap_tag_t* tag;
+
+  // Synthetic SCTP/IPv4 fields
+  uint32_t tsn;
+  uint16_t ip_id;
+
+  uint32_t crc_lut[256];
+
+  bool stop;
+  pthread_t p;
+  pthread_mutex_t mtx;
+  pthread_cond_t cv;
+} e2ap_capture_t;
+
+static
+e2ap_capture_t cap = {0};
+
+static
+int64_t now_us(void)
+{
+  struct timespec tms = {0};
+  int const rc = clock_gettime(CLOCK_REALTIME, &tms);
+  assert(rc == 0);
+  return tms.tv_sec*1000000 + tms.tv_nsec/1000;
+}
+
+static
+void free_cap_rec(cap_rec_t* r)
+{
+  free_byte_array(r->ba);
+  free(r->tag);
+  free(r->note);
+}
+
+// CRC32c (Castagnoli) of the SCTP common header, RFC 4960 Appendix B
+static
+void init_crc32c(uint32_t lut[256])
+{
+  for(uint32_t i = 0; i < 256; ++i){
+    uint32_t c = i;
+    for(int j = 0; j < 8; ++j)
+      c = c & 1 ? (c >> 1) ^ 0x82F63B78 : c >> 1;
+    lut[i] = c;
+  }
+}
+
+static
+uint32_t crc32c(uint32_t const lut[256], uint8_t const* buf, size_t len)
+{
+  uint32_t c = 0xFFFFFFFF;
+  for(size_t i = 0; i < len; ++i)
+    c = lut[(c ^ buf[i]) & 0xFF] ^ (c >> 8);
+  return ~c;
+}
+
+static
+uint16_t ipv4_checksum(uint8_t const* hdr)
+{
+  uint32_t sum = 0;
+  for(size_t i = 0; i < IPV4_HDR_LEN; i += 2)
+    sum += (hdr[i] << 8) | hdr[i+1];
+  while(sum >> 16)
+    sum = (sum & 0xFFFF) + (sum >> 16);
+  return ~sum;
+}
+
+static
+void put_u16_be(uint8_t* dst, uint16_t v)
+{
+  dst[0] = v >> 8;
+  dst[1] = v;
+}
+
+static
+void put_u32_be(uint8_t* dst, uint32_t v)
+{
+  dst[0] = v >> 24;
+  dst[1] = v >> 16;
+  dst[2] = v >> 8;
+  dst[3] = v;
+}
+
+static
+size_t pad4(size_t len)
+{
+  return (len + 3) & ~(size_t)3;
+}
+
+// Host byte order, as told by the byte-order magic of the SHB
+static
+size_t put_u32(uint8_t* dst, uint32_t v)
+{
+  memcpy(dst, &v, sizeof(v));
+  return sizeof(v);
+}
+
+static
+size_t put_u16(uint8_t* dst, uint16_t v)
+{
+  memcpy(dst, &v, sizeof(v));
+  return sizeof(v);
+}
+
+static
+size_t put_opt(uint8_t* dst, uint16_t code, char const* val)
+{
+  size_t const len = strlen(val);
+  assert(len < UINT16_MAX);
+  size_t pos = put_u16(dst, code);
+  pos += put_u16(dst + pos, len);
+  memset(dst + pos, 0, pad4(len));
+  memcpy(dst + pos, val, len);
+  return pos + pad4(len);
+}
+
+static
+size_t len_opt(char const* val)
+{
+  return 4 + pad4(strlen(val));
+}
+
+static
+void write_block(uint8_t const* buf, size_t len)
+{
+  size_t const rc = fwrite(buf, 1, len, cap.fp);
+  if(rc != len)
+    printf("[E2AP]: Error writing the capture file\n");
+  cap.bytes += len;
+}
+
+static
+void write_headers(void)
+{
+  uint8_t buf[128] = {0};
+
+  // Section Header Block
+  size_t len = 28 + len_opt("FlexRIC") + 4;
+  size_t pos = put_u32(buf, SHB_PCAPNG);
+  pos += put_u32(buf + pos, len);
+  pos += put_u32(buf + pos, BYTE_ORDER_MAGIC_PCAPNG);
+  pos += put_u16(buf + pos, 1);
+  pos += put_u16(buf + pos, 0);
+  // Section length unknown
+  int64_t const sec_len = -1;
+  memcpy(buf + pos, &sec_len, sizeof(sec_len));
+  pos += sizeof(sec_len);
+  pos += put_opt(buf + pos, OPT_SHB_USERAPPL_PCAPNG, "FlexRIC");
+  pos += put_u32(buf + pos, OPT_END_PCAPNG);
+  pos += put_u32(buf + pos, len);
+  assert(pos == len);
+  write_block(buf, len);
+
+  // Interface Description Block. Microseconds
+  len = 20 + len_opt("e2ap") + 4;
+  pos = put_u32(buf, IDB_PCAPNG);
+  pos += put_u32(buf + pos, len);
+  pos += put_u16(buf + pos, LINKTYPE_IPV4);
+  pos += put_u16(buf + pos, 0);
+  pos += put_u32(buf + pos, 0);
+  pos += put_opt(buf + pos, OPT_IF_NAME_PCAPNG, "e2ap");
+  pos += put_u32(buf + pos, OPT_END_PCAPNG);
+  pos += put_u32(buf + pos, len);
+  assert(pos == len);
+  write_block(buf, len);
+}
+
+static
+void open_file(void)
+{
+  char path[512] = {0};
+  int const n = snprintf(path, sizeof(path), "%s_%lu.pcapng", cap.base, cap.idx);
+  assert(n > 0 && n < (int)sizeof(path) && "PCAP_FILE too long");
+
+  cap.fp = fopen(path, "wb");
+  assert(cap.fp != NULL && "Could not open PCAP_FILE");
+  cap.bytes = 0;
+
+  write_headers();
+}
+
+static
+void rotate_file(void)
+{
+  fclose(cap.fp);
+  cap.idx = (cap.idx + 1) % cap.num_files;
+  open_file();
+}
+
+// IPv4 + SCTP common header + DATA chunk
+static
+size_t fill_packet(uint8_t* dst, cap_rec_t const* r, size_t len_payload)
+{
+  e2ap_capture_hdr_t const* h = &r->hdr;
+  struct sockaddr_in const* src = h->tx ? &h->local : &h->peer;
+  struct sockaddr_in const* dst_addr = h->tx ? &h->peer : &h->local;
+
+  size_t const len_chunk = SCTP_DATA_HDR_LEN + len_payload;
+  size_t const len_sctp = SCTP_HDR_LEN + pad4(len_chunk);
+  size_t const len = IPV4_HDR_LEN + len_sctp;
+  assert(len <= 0xFFFF);
+  memset(dst, 0, len);
+
+  uint8_t* ip = dst;
+  ip[0] = 0x45;
+  put_u16_be(ip + 2, len);
+  put_u16_be(ip + 4, cap.ip_id++);
+  put_u16_be(ip + 6, 0x4000); // Don't fragment
+  ip[8] = 64;
+  ip[9] = IPPROTO_SCTP;
+  memcpy(ip + 12, &src->sin_addr.s_addr, 4);
+  memcpy(ip + 16, &dst_addr->sin_addr.s_addr, 4);
+  put_u16_be(ip + 10, ipv4_checksum(ip));
+
+  uint8_t* sctp = ip + IPV4_HDR_LEN;
+  memcpy(sctp, &src->sin_port, 2);
+  memcpy(sctp + 2, &dst_addr->sin_port, 2);
+  // Verification tag 0, as the handshake is not captured
+
+  uint8_t* chunk = sctp + SCTP_HDR_LEN;
+  chunk[0] = 0; // DATA
+  chunk[1] = 0x03; // Unfragmented
+  put_u16_be(chunk + 2, len_chunk);
+  put_u32_be(chunk + 4, cap.tsn++);
+  put_u16_be(chunk + 8, h->stream);
+  // The socket API keeps the PPID in network byte order
+  uint32_t const ppid = h->ppid != 0 ? h->ppid : htonl(E2AP_SCTP_PPID);
+  memcpy(chunk + 12, &ppid, 4);
+  memcpy(chunk + SCTP_DATA_HDR_LEN, r->ba.buf, len_payload);
+
+  // Stored in little endian, see RFC 4960 Appendix B
+  uint32_t const crc = crc32c(cap.crc_lut, sctp, len_sctp);
+  sctp[8] = crc;
+  sctp[9] = crc >> 8;
+  sctp[10] = crc >> 16;
+  sctp[11] = crc >> 24;
+
+  return len;
+}
+
+static
+void write_rec(cap_rec_t const* r, uint8_t* buf)
+{
+  size_t const len_payload = r->ba.len < MAX_PAYLOAD_CAPTURE ? r->ba.len : MAX_PAYLOAD_CAPTURE;
+
+  char comment[512] = {0};
+  int const n = snprintf(comment, sizeof(comment), "%s assoc %d stream %u%s%s%s%s%s", 
+                        r->hdr.tx ? "tx" : "rx", r->hdr.assoc_id, r->hdr.stream, 
+                        r->tag != NULL ? " peer " : "", r->tag != NULL ? r->tag : "",
+                        r->note != NULL ? " | " : "", r->note != NULL ? r->note : "",
+                        len_payload < r->ba.len ? " | truncated" : "");
+  assert(n > 0);
+
+  size_t const len_pkt = IPV4_HDR_LEN + SCTP_HDR_LEN + pad4(SCTP_DATA_HDR_LEN + len_payload);
+  size_t const len = 28 + pad4(len_pkt) + len_opt(comment) + 4 + 4;
+
+  if(cap.bytes + len > cap.file_size)
+    rotate_file();
+
+  size_t pos = put_u32(buf, EPB_PCAPNG);
+  pos += put_u32(buf + pos, len);
+  pos += put_u32(buf + pos, 0); // Interface ID
+  pos += put_u32(buf + pos, (uint64_t)r->tstamp_us >> 32);
+  pos += put_u32(buf + pos, r->tstamp_us);
+  pos += put_u32(buf + pos, len_pkt);
+  pos += put_u32(buf + pos, len_pkt);
+  size_t const filled = fill_packet(buf + pos, r, len_payload);
+  assert(filled == len_pkt);
+  memset(buf + pos + len_pkt, 0, pad4(len_pkt) - len_pkt);
+  pos += pad4(len_pkt);
+  pos += put_opt(buf + pos, OPT_COMMENT_PCAPNG, comment);
+  pos += put_u32(buf + pos, OPT_END_PCAPNG);
+  pos += put_u32(buf + pos, len);
+  assert(pos == len);
+
+  write_block(buf, len);
+}
+
+static
+void* writer_thread(void* arg)
+{
+  (void)arg;
+
+  cap_rec_t* batch = calloc(E2AP_CAPTURE_MAX_PENDING, sizeof(cap_rec_t));
+  assert(batch != NULL && "Memory exhausted");
+  // Largest EPB
+  uint8_t* buf = malloc(0x10000 + 1024);
+  assert(buf != NULL && "Memory exhausted");
+
+  while(true){
+    int rc = pthread_mutex_lock(&cap.mtx);
+    assert(rc == 0);
+
+    while(cap.stop == false && cap.len == 0){
+      rc = pthread_cond_wait(&cap.cv, &cap.mtx);
+      assert(rc == 0);
+    }
+
+    bool const stop = cap.stop;
+    size_t const len = cap.len;
+    for(size_t i = 0; i < len; ++i)
+      batch[i] = cap.rec[(cap.head + i) % E2AP_CAPTURE_MAX_PENDING];
+    cap.head = (cap.head + len) % E2AP_CAPTURE_MAX_PENDING;
+    cap.len = 0;
+
+    rc = pthread_mutex_unlock(&cap.mtx);
+    assert(rc == 0);
+
+    for(size_t i = 0; i < len; ++i){
+      write_rec(&batch[i], buf);
+      free_cap_rec(&batch[i]);
+    }
+    fflush(cap.fp);
+
+    if(stop == true)
+      break;
+  }
+
+  free(buf);
+  free(batch);
+  return NULL;
+}
+
+typedef struct{
+  size_t files;
+  size_t size;
+} ring_conf_t;
+
+static
+bool parse_ring_opt(char* key, char* val, void* data)
+{
+  ring_conf_t* r = (ring_conf_t*)data;
+
+  if(strcmp(key, "files") == 0){
+    long long n = 0;
+    bool const ok = parse_num_conf(val, 1, 999, &n);
+    r->files = n;
+    return ok;
+  }
+
+  // At least the headers and a full packet
+  if(strcmp(key, "size") == 0)
+    return parse_size_conf(val, &r->size) && r->size >= 0x10000 + 1024;
+
+  return false;
+}
+
+static
+bool parse_ring(char const* ring, size_t* files, size_t* size)
+{
+  ring_conf_t r = {.files = *files, .size = *size};
+  if(parse_kv_conf(strlen(ring), ring, parse_ring_opt, &r) == false)
+    return false;
+
+  *files = r.files;
+  *size = r.size;
+  return true;
+}
+
+void init_e2ap_capture(char const* path, char const* ring)
+{
+  if(path == NULL)
+    return;
+
+  if(cap.enabled == true){
+    cap.users += 1;
+    return;
+  }
+
+  cap.num_files = E2AP_CAPTURE_FILES;
+  cap.file_size = E2AP_CAPTURE_FILE_SIZE;
+  if(ring != NULL && parse_ring(ring, &cap.num_files, &cap.file_size) == false){
+    printf("[E2AP]: Malformed PCAP_RING = %s\n", ring);
+    assert(0 != 0 && "Malformed PCAP_RING");
+  }
+
+  // flexric.pcapng -> flexric_0.pcapng
+  cap.base = strdup(path);
+  assert(cap.base != NULL && "Memory exhausted");
+  size_t const len = strlen(cap.base);
+  if(len > 7 && strcmp(cap.base + len - 7, ".pcapng") == 0)
+    cap.base[len - 7] = '\0';
+
+  cap.idx = 0;
+  open_file();
+
+  cap.rec = calloc(E2AP_CAPTURE_MAX_PENDING, sizeof(cap_rec_t));
+  assert(cap.rec != NULL && "Memory exhausted");
+  cap.head = 0;
+  cap.len = 0;
+  cap.dropped = 0;
+  cap.len_tag = 0;
+  cap.tag = NULL;
+  cap.tsn = 1;
+  cap.ip_id = 0;
+  cap.stop = false;
+  init_crc32c(cap.crc_lut);
+
+  pthread_mutexattr_t attr = {0};
+#ifdef DEBUG
+  pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_ERRORCHECK);
+#endif
+  int rc = pthread_mutex_init(&cap.mtx, &attr);
+  assert(rc == 0);
+
+  pthread_condattr_t const* c_attr = NULL;
+  rc = pthread_cond_init(&cap.cv, c_attr);
+  assert(rc == 0);
+
+  rc = pthread_create(&cap.p, NULL, writer_thread, NULL);
+  assert(rc == 0);
+
+  cap.users = 1;
+  cap.enabled = true;
+
+  printf("[E2AP]: Capturing into %s_[0-%lu].pcapng, %lu bytes each\n", cap.base, cap.num_files - 1, cap.file_size);
+}
+
+void free_e2ap_capture(void)
+{
+  if(cap.enabled == false)
+    return;
+
+  assert(cap.users > 0);
+  cap.users -= 1;
+  if(cap.users > 0)
+    return;
+
+  int rc = pthread_mutex_lock(&cap.mtx);
+  assert(rc == 0);
+  cap.stop = true;
+  rc = pthread_cond_signal(&cap.cv);
+  assert(rc == 0);
+  rc = pthread_mutex_unlock(&cap.mtx);
+  assert(rc == 0);
+
+  rc = pthread_join(cap.p, NULL);
+  assert(rc == 0);
+
+  cap.enabled = false;
+
+  if(cap.dropped > 0)
+    printf("[E2AP]: Capture dropped %lu messages\n", cap.dropped);
+
+  fclose(cap.fp);
+  cap.fp = NULL;
+
+  assert(cap.len == 0);
+  free(cap.rec);
+  cap.rec = NULL;
+
+  for(size_t i = 0; i < cap.len_tag; ++i)
+    free(cap.tag[i].tag);
+  free(cap.tag);
+  cap.tag = NULL;
+  cap.len_tag = 0;
+
+  free(cap.base);
+  cap.base = NULL;
+
+  rc = pthread_cond_destroy(&cap.cv);
+  assert(rc == 0);
+  rc = pthread_mutex_destroy(&cap.mtx);
+  assert(rc == 0);
+}
+
+bool enabled_e2ap_capture(void)
+{
+  return cap.enabled;
+}
+
+static
+bool eq_peer(struct sockaddr_in const* m0, struct sockaddr_in const* m1)
+{
+  return m0->sin_addr.s_addr == m1->sin_addr.s_addr && m0->sin_port == m1->sin_port;
+}
+
+static
+char* find_tag(struct sockaddr_in const* peer)
+{
+  for(size_t i = 0; i < cap.len_tag; ++i){
+    if(eq_peer(&cap.tag[i].peer, peer))
+      return cap.tag[i].tag;
+  }
+  return NULL;
+}
+
+void capture_e2ap(e2ap_capture_hdr_t const* hdr, byte_array_t ba)
+{
+  assert(hdr != NULL);
+
+  if(cap.enabled == false)
+    return;
+
+  cap_rec_t r = {.hdr = *hdr, 
+                 .tstamp_us = now_us(),
+                 .ba = copy_byte_array(ba)};
+  // Owned by the sender
+  r.hdr.note = NULL;
+  if(hdr->note != NULL){
+    r.note = strdup(hdr->note);
+    assert(r.note != NULL && "Memory exhausted");
+  }
+
+  int rc = pthread_mutex_lock(&cap.mtx);
+  assert(rc == 0);
+
+  if(cap.stop == true || cap.len == E2AP_CAPTURE_MAX_PENDING){
+    cap.dropped += 1;
+    rc = pthread_mutex_unlock(&cap.mtx);
+    assert(rc == 0);
+    free_cap_rec(&r);
+    return;
+  }
+
+  char const* tag = find_tag(&hdr->peer);
+  if(tag != NULL){
+    r.tag = strdup(tag);
+    assert(r.tag != NULL && "Memory exhausted");
+  }
+
+  cap.rec[(cap.head + cap.len) % E2AP_CAPTURE_MAX_PENDING] = r;
+  cap.len += 1;
+
+  rc = pthread_cond_signal(&cap.cv);
+  assert(rc == 0);
+
+  rc = pthread_mutex_unlock(&cap.mtx);
+  assert(rc == 0);
+}
+
+void tag_e2ap_capture(struct sockaddr_in const* peer, char const* tag)
+{
+  assert(peer != NULL);
+
+  if(cap.enabled == false)
+    return;
+
+  int rc = pthread_mutex_lock(&cap.mtx);
+  assert(rc == 0);
+
+  size_t i = 0;
+  while(i < cap.len_tag && eq_peer(&cap.tag[i].peer, peer) == false)
+    i += 1;
+
+  if(i < cap.len_tag){
+    free(cap.tag[i].tag);
+    if(tag == NULL)
+      cap.tag[i] = cap.tag[--cap.len_tag];
+  } else if(tag != NULL){
+    cap.tag = realloc(cap.tag, (cap.len_tag + 1)*sizeof(cap_tag_t));
+    assert(cap.tag != NULL && "Memory exhausted");
+    cap.tag[i].peer = *peer;
+    cap.len_tag += 1;
+  }
+
+  if(tag != NULL){
+    cap.tag[i].tag = strdup(tag);
+    assert(cap.tag[i].tag != NULL && "Memory exhausted");
+  }
+
+  rc = pthread_mutex_unlock(&cap.mtx);
+  assert(rc == 0);
+}
+
+void init_conf_e2ap_capture(fr_args_t const* args)
+{
+  assert(args != NULL);
+
+  char* pcap = get_conf_pcap_file(args);
+  char* ring = get_conf_pcap_ring(args);
+  init_e2ap_capture(pcap, ring);
+  free(pcap);
+  free(ring);
+}
+
+uint64_t dropped_e2ap_capture(void)
+{
+  return cap.dropped;
+}
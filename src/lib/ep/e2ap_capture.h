@@ -0,0 +1,84 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+#ifndef E2AP_CAPTURE_H
+#define E2AP_CAPTURE_H
+
+// Capture of the E2 and E42 messages into a ring of pcapng files, e.g., 
+// flexric_0.pcapng ... flexric_3.pcapng. The messages are framed as IPv4/SCTP 
+// DATA chunks, so Wireshark dissects them as E2AP. Every packet carries a comment 
+// with the SCTP association, stream and the tag of the peer (e.g., the E2 Node), 
+// plus the note sent along with the message, if any.
+// The files are written by a dedicated thread. Messages are dropped if it 
+// does not keep up. Configured through the configuration file:
+//  PCAP_FILE = /tmp/flexric.pcapng
+//  PCAP_RING = files=4;size=16M
+
+#include "../../util/byte_array.h"
+#include "../../util/conf_file.h"
+
+#include <netinet/in.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#define E2AP_CAPTURE_FILES 4
+#define E2AP_CAPTURE_FILE_SIZE (16*1024*1024)
+#define E2AP_CAPTURE_MAX_PENDING 4096
+
+// Longer notes are truncated by their writers
+#define E2AP_CAPTURE_NOTE_LEN 128
+
+// E2AP SCTP Payload Protocol Identifier. Used if the peer did not set one
+#define E2AP_SCTP_PPID 70
+
+typedef struct{
+  bool tx;
+  struct sockaddr_in local;
+  struct sockaddr_in peer;
+  int32_t assoc_id;
+  uint16_t stream;
+  uint32_t ppid;
+  // E.g., the RIC Request ID rewritten by the iApp. NULL if none. Copied
+  char const* note;
+} e2ap_capture_hdr_t;
+
+// path may be NULL, i.e., disabled. ring may be NULL. Asserts if ring is malformed.
+// Later calls share the first capture, and need a free_e2ap_capture each
+void init_e2ap_capture(char const* path, char const* ring);
+
+// init_e2ap_capture with the PCAP_FILE and PCAP_RING keys of args
+void init_conf_e2ap_capture(fr_args_t const* args);
+
+// Writes the pending messages once the last user leaves
+void free_e2ap_capture(void);
+
+bool enabled_e2ap_capture(void);
+
+// Copies ba. Nothing if disabled
+void capture_e2ap(e2ap_capture_hdr_t const* hdr, byte_array_t ba);
+
+// Names the peer in the comments, e.g., the Global E2 Node ID. NULL removes it
+void tag_e2ap_capture(struct sockaddr_in const* peer, char const* tag);
+
+// Messages dropped as the writer did not keep up
+uint64_t dropped_e2ap_capture(void);
+
+#endif
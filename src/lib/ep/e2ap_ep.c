@@ -20,6 +20,7 @@
  */
 
 #include "e2ap_ep.h"
+#include "e2ap_capture.h"
 #include "../../util/alg_ds/ds/lock_guard/lock_guard.h"
 
 #include <pthread.h>
@@ -30,16 +31,44 @@ void e2ap_ep_init(e2ap_ep_t* ep)
   assert(rc == 0);
 }
 
+int e2ap_ep_listen_mem(e2ap_ep_t* ep, const char* addr, int port)
+{
+  assert(ep != NULL);
+  assert(ep->mem == NULL);
+
+  ep->mem = listen_mem_ep(addr, port);
+  assert(ep->mem != NULL && "Address already in use");
+  return fd_mem_ep(ep->mem);
+}
+
+int e2ap_ep_connect_mem(e2ap_ep_t* ep, const char* addr, int port)
+{
+  assert(ep != NULL);
+  assert(ep->mem == NULL);
+
+  ep->mem = connect_mem_ep(addr, port);
+  return fd_mem_ep(ep->mem);
+}
+
 void e2ap_ep_free(e2ap_ep_t* ep)
 {
   assert(ep != NULL);
   
-  int rc = close(ep->fd);
-  assert(rc == 0);
+  int rc = 0;
+  if(ep->mem != NULL){
+    // Closes the fd
+    close_mem_ep(ep->mem);
+    ep->mem = NULL;
+  } else {
+    rc = close(ep->fd);
+    assert(rc == 0);
+  }
 
   rc = pthread_mutex_destroy(&ep->mtx);
   assert(rc == 0);
 
+  memset(ep->local, 0, sizeof(ep->local));
+
 //  rc = shutdown(ep->fd, SHUT_RDWR);
 //  if(rc != 0){
 //    printf("[Warning]: in shutdown socket: %s \n", strerror(errno));
@@ -54,6 +83,77 @@ void e2ap_ep_free(e2ap_ep_t* ep)
 
 }
 
+// The address of the association if known, the one of the socket otherwise,
+// e.g., 0.0.0.0 for a server bound to any address
+static
+struct sockaddr_in sctp_local_addr(int fd, int32_t assoc_id)
+{
+  struct sockaddr_in local = {0};
+
+  struct sockaddr* addrs = NULL;
+  int const n = sctp_getladdrs(fd, assoc_id, &addrs);
+  if(n > 0){
+    struct sockaddr* it = addrs;
+    for(int i = 0; i < n; ++i){
+      if(it->sa_family == AF_INET){
+        memcpy(&local, it, sizeof(local));
+        sctp_freeladdrs(addrs);
+        return local;
+      }
+      it = (struct sockaddr*)((char*)it + (it->sa_family == AF_INET6 ? sizeof(struct sockaddr_in6) : sizeof(struct sockaddr_in)));
+    }
+  }
+  if(n > -1)
+    sctp_freeladdrs(addrs);
+
+  socklen_t len = sizeof(local);
+  if(getsockname(fd, (struct sockaddr*)&local, &len) != 0)
+    memset(&local, 0, sizeof(local));
+
+  return local;
+}
+
+// Called with the mtx of the ep locked. Only the first message of an 
+// association asks the kernel
+static
+struct sockaddr_in local_addr(e2ap_ep_t* ep, int32_t assoc_id)
+{
+  e2ap_ep_local_addr_t* l = &ep->local[(uint32_t)assoc_id % E2AP_EP_LOCAL_ADDR];
+  if(l->valid == false || l->fd != ep->fd || l->assoc_id != assoc_id){
+    l->addr = sctp_local_addr(ep->fd, assoc_id);
+    l->fd = ep->fd;
+    l->assoc_id = assoc_id;
+    l->valid = true;
+  }
+  return l->addr;
+}
+
+static
+void forget_local_addr(e2ap_ep_t* ep, int32_t assoc_id)
+{
+  e2ap_ep_local_addr_t* l = &ep->local[(uint32_t)assoc_id % E2AP_EP_LOCAL_ADDR];
+  if(l->assoc_id == assoc_id)
+    l->valid = false;
+}
+
+static
+void capture_sctp_msg(e2ap_ep_t const* ep, bool tx, sctp_info_t const* info, byte_array_t ba, char const* note)
+{
+  e2ap_capture_hdr_t hdr = {.tx = tx, 
+                            .peer = info->addr,
+                            .assoc_id = info->sri.sinfo_assoc_id,
+                            .stream = info->sri.sinfo_stream,
+                            .ppid = info->sri.sinfo_ppid,
+                            .note = note};
+
+  if(ep->mem != NULL)
+    hdr.local = addr_mem_ep(ep->mem);
+  else
+    hdr.local = local_addr((e2ap_ep_t*)ep, info->sri.sinfo_assoc_id);
+
+  capture_e2ap(&hdr, ba);
+}
+
 void e2ap_send_sctp_msg(const e2ap_ep_t* ep, sctp_msg_t* msg)
 {
   assert(ep != NULL);
@@ -65,15 +165,44 @@ void e2ap_send_sctp_msg(const e2ap_ep_t* ep, sctp_msg_t* msg)
 
   lock_guard(&((e2ap_ep_t*)ep)->mtx);
 
+  if(ep->mem != NULL){
+    // Without association, as SCTP without listening peer
+    if(send_mem_ep(ep->mem, addr, sri->sinfo_stream, sri->sinfo_ppid, ba) == false)
+      printf("Error sending sctp message \n");
+    else if(enabled_e2ap_capture() == true)
+      capture_sctp_msg(ep, true, &msg->info, ba, msg->note);
+    return;
+  }
+
   const int rc = sctp_sendmsg(
       ep->fd, (void *)ba.buf, ba.len, (struct sockaddr *)addr, sizeof(*addr),
       sri->sinfo_ppid, sri->sinfo_flags, sri->sinfo_stream, 0, 0);
   assert(rc != 0);
   if(rc == -1){
     printf("Error sending sctp message \n");
+  } else if(enabled_e2ap_capture() == true){
+    capture_sctp_msg(ep, true, &msg->info, ba, msg->note);
   }
 }
 
+void e2ap_shutdown_sctp_assoc(const e2ap_ep_t* ep, sctp_info_t const* info)
+{
+  assert(ep != NULL);
+  assert(info != NULL);
+
+  struct sockaddr_in const* addr = &info->addr; 
+
+  lock_guard(&((e2ap_ep_t*)ep)->mtx);
+
+  if(ep->mem != NULL){
+    shutdown_mem_ep(ep->mem, addr);
+    return;
+  }
+
+  const int rc = sctp_sendmsg(ep->fd, NULL, 0, (struct sockaddr *)addr, sizeof(*addr), 0, SCTP_EOF, 0, 0, 0);
+  if(rc == -1)
+    printf("Error shutting down the sctp association: %s\n", strerror(errno));
+}
 
 static
 struct sctp_shutdown_event cp_sn_shutdown_event(struct sctp_shutdown_event const* src)
@@ -206,10 +335,47 @@ union sctp_notification cp_sctp_notification(union sctp_notification const* src,
   return dst;
 }
 
+// The eof of the peer is notified as SCTP_SHUTDOWN_EVENT
+static
+sctp_msg_t recv_mem_msg(e2ap_ep_t* ep)
+{
+  mem_ep_msg_t msg = recv_mem_ep(ep->mem);
+
+  sctp_msg_t from = {.info.addr = msg.peer,
+                     .info.sri.sinfo_stream = msg.stream,
+                     .info.sri.sinfo_ppid = msg.ppid,
+                     .info.sri.sinfo_assoc_id = msg.assoc_id};
+
+  if(msg.eof == true){
+    from.type = SCTP_MSG_NOTIFICATION;
+    from.notif = calloc(1, sizeof(union sctp_notification));
+    assert(from.notif != NULL && "Memory exhausted");
+
+    from.notif->sn_shutdown_event.sse_type = SCTP_SHUTDOWN_EVENT;
+    from.notif->sn_shutdown_event.sse_length = sizeof(struct sctp_shutdown_event);
+    from.notif->sn_shutdown_event.sse_assoc_id = msg.assoc_id;
+    printf("[E2AP]: SCTP_SHUTDOWN_EVENT \n");
+  } else {
+    from.type = SCTP_MSG_PAYLOAD;
+    // Moved
+    from.ba = msg.ba;
+
+    if(enabled_e2ap_capture() == true)
+      capture_sctp_msg(ep, false, &from.info, from.ba, NULL);
+  }
+
+  return from;
+}
+
 sctp_msg_t e2ap_recv_sctp_msg(e2ap_ep_t* ep)
 {
   assert(ep != NULL);
 
+  if(ep->mem != NULL){
+    lock_guard(&ep->mtx);
+    return recv_mem_msg(ep);
+  }
+
   sctp_msg_t from = {0}; 
 
   from.ba.len = 32*1024;
@@ -236,9 +402,18 @@ sctp_msg_t e2ap_recv_sctp_msg(e2ap_ep_t* ep)
     assert(from.notif != NULL && "Memory exhausted");
 
     *from.notif = cp_sctp_notification((union sctp_notification*) buf, rc); 
+
+    union sctp_notification const* n = (union sctp_notification*)buf;
+    if(n->sn_header.sn_type == SCTP_SHUTDOWN_EVENT)
+      forget_local_addr(ep, n->sn_shutdown_event.sse_assoc_id);
+    else if(n->sn_header.sn_type == SCTP_ASSOC_CHANGE && n->sn_assoc_change.sac_state != SCTP_COMM_UP)
+      forget_local_addr(ep, n->sn_assoc_change.sac_assoc_id);
   } else {
     from.type = SCTP_MSG_PAYLOAD;
     from.ba.len = rc; // set actually received number of bytes
+
+    if(enabled_e2ap_capture() == true)
+      capture_sctp_msg(ep, false, &from.info, from.ba, NULL);
   }
 
   return from;
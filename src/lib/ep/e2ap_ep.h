@@ -35,22 +35,48 @@
 
 #include "util/byte_array.h"
 #include "sctp_msg.h"
+#include "mem_ep.h"
 
+#include <stdbool.h>
+
+// Slots of the local address cache. Indexed by the SCTP association ID 
+#define E2AP_EP_LOCAL_ADDR 64
+
+// Local address of an association, as written in the capture 
+typedef struct{
+  struct sockaddr_in addr;
+  int fd;
+  int32_t assoc_id;
+  bool valid;
+} e2ap_ep_local_addr_t;
 
 typedef struct{
   const char addr[16]; // only ipv4 supported
   const int port;
   const int fd;
   pthread_mutex_t mtx;
+  // Non NULL for the in-memory transport, see mem_ep.h
+  mem_ep_t* mem;
+  // Filled the first time an association is captured. Guarded by mtx
+  e2ap_ep_local_addr_t local[E2AP_EP_LOCAL_ADDR];
 } e2ap_ep_t;
 
 void e2ap_ep_init(e2ap_ep_t* ep);
 
+// In-memory endpoints, while enabled_mem_ep(). Return the fd to poll
+int e2ap_ep_listen_mem(e2ap_ep_t* ep, const char* addr, int port);
+
+int e2ap_ep_connect_mem(e2ap_ep_t* ep, const char* addr, int port);
+
 void e2ap_ep_free(e2ap_ep_t* ep);
 
 void e2ap_send_sctp_msg(const e2ap_ep_t* ep, sctp_msg_t* msg);
 
 sctp_msg_t e2ap_recv_sctp_msg(e2ap_ep_t* ep);
 
+// Graceful SCTP shutdown of the association of info, i.e., SCTP_EOF.
+// No SCTP_SHUTDOWN_EVENT is notified, as the shutdown is local
+void e2ap_shutdown_sctp_assoc(const e2ap_ep_t* ep, sctp_info_t const* info);
+
 #endif
 
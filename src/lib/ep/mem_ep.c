@@ -0,0 +1,431 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+#include "mem_ep.h"
+#include "../../util/alg_ds/ds/lock_guard/lock_guard.h"
+#include "../../util/alg_ds/ds/seq_container/seq_generic.h"
+
+#include <arpa/inet.h>
+#include <assert.h>
+#include <errno.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <time.h>
+#include <unistd.h>
+
+// Local addresses of the connecting endpoints, as ephemeral ports
+#define FIRST_PORT_MEM_EP 32768
+
+struct mem_ep_s{
+  struct sockaddr_in addr;
+  bool listening;
+  // Listening endpoint of a connecting one
+  struct sockaddr_in to;
+  // EFD_SEMAPHORE, i.e., one per queued message
+  int fd;
+  seq_arr_t queue; // mem_ep_msg_t
+};
+
+typedef struct{
+  mem_ep_t* conn;
+  mem_ep_t* lis;
+  int32_t id;
+} mem_assoc_t;
+
+static
+struct{
+  pthread_mutex_t mtx;
+  pthread_cond_t cv;
+  atomic_bool enabled;
+  size_t users;
+
+  seq_arr_t eps;    // mem_ep_t*
+  seq_arr_t assocs; // mem_assoc_t
+  int32_t last_assoc_id;
+  uint16_t next_port;
+  size_t in_flight;
+  // Incremented on every event, for wait_mem_ep()
+  uint64_t gen;
+} hub = {.mtx = PTHREAD_MUTEX_INITIALIZER, .cv = PTHREAD_COND_INITIALIZER};
+
+void free_mem_ep_msg(mem_ep_msg_t* msg)
+{
+  assert(msg != NULL);
+  if(msg->eof == false)
+    free_byte_array(msg->ba);
+}
+
+static
+void free_mem_ep_msg_wrapper(void* it)
+{
+  free_mem_ep_msg(it);
+}
+
+void init_mem_ep(void)
+{
+  lock_guard(&hub.mtx);
+  if(hub.users++ > 0)
+    return;
+
+  seq_init(&hub.eps, sizeof(mem_ep_t*));
+  seq_init(&hub.assocs, sizeof(mem_assoc_t));
+  hub.last_assoc_id = 0;
+  hub.next_port = FIRST_PORT_MEM_EP;
+  hub.in_flight = 0;
+  atomic_store(&hub.enabled, true);
+}
+
+void free_mem_ep(void)
+{
+  lock_guard(&hub.mtx);
+  assert(hub.users > 0);
+  if(--hub.users > 0)
+    return;
+
+  assert(seq_size(&hub.eps) == 0 && "Endpoint not closed");
+  assert(seq_size(&hub.assocs) == 0);
+  seq_free(&hub.eps, NULL);
+  seq_free(&hub.assocs, NULL);
+  atomic_store(&hub.enabled, false);
+}
+
+bool enabled_mem_ep(void)
+{
+  return atomic_load(&hub.enabled);
+}
+
+static
+struct sockaddr_in sockaddr_mem_ep(char const* addr, int port)
+{
+  assert(addr != NULL);
+  assert(port > 0 && port < 65536);
+
+  struct sockaddr_in dst = {.sin_family = AF_INET, .sin_port = htons(port)};
+  int const rc = inet_pton(AF_INET, addr, &dst.sin_addr);
+  assert(rc == 1 && "Only IPv4 addresses supported");
+  (void)rc;
+  return dst;
+}
+
+static
+bool eq_addr_mem_ep(struct sockaddr_in const* m0, struct sockaddr_in const* m1)
+{
+  return m0->sin_port == m1->sin_port && m0->sin_addr.s_addr == m1->sin_addr.s_addr;
+}
+
+// A listener bound to INADDR_ANY accepts any address of its port
+static
+bool accepts_mem_ep(mem_ep_t const* lis, struct sockaddr_in const* to)
+{
+  if(lis->listening == false || lis->addr.sin_port != to->sin_port)
+    return false;
+  return lis->addr.sin_addr.s_addr == htonl(INADDR_ANY) || lis->addr.sin_addr.s_addr == to->sin_addr.s_addr;
+}
+
+static
+mem_ep_t* new_mem_ep(struct sockaddr_in addr, bool listening)
+{
+  mem_ep_t* ep = calloc(1, sizeof(mem_ep_t));
+  assert(ep != NULL && "Memory exhausted");
+
+  ep->addr = addr;
+  ep->listening = listening;
+  ep->fd = eventfd(0, EFD_SEMAPHORE | EFD_CLOEXEC);
+  assert(ep->fd > -1);
+  seq_init(&ep->queue, sizeof(mem_ep_msg_t));
+
+  seq_push_back(&hub.eps, &ep, sizeof(ep));
+  return ep;
+}
+
+mem_ep_t* listen_mem_ep(char const* addr, int port)
+{
+  struct sockaddr_in const sa = sockaddr_mem_ep(addr, port);
+
+  lock_guard(&hub.mtx);
+  assert(atomic_load(&hub.enabled) == true);
+
+  for(size_t i = 0; i < seq_size(&hub.eps); ++i){
+    mem_ep_t const* it = *(mem_ep_t**)seq_at(&hub.eps, i);
+    if(it->listening == true && eq_addr_mem_ep(&it->addr, &sa))
+      return NULL;
+  }
+
+  return new_mem_ep(sa, true);
+}
+
+mem_ep_t* connect_mem_ep(char const* addr, int port)
+{
+  struct sockaddr_in const to = sockaddr_mem_ep(addr, port);
+
+  lock_guard(&hub.mtx);
+  assert(atomic_load(&hub.enabled) == true);
+  assert(hub.next_port != 0 && "Ephemeral ports exhausted");
+
+  struct sockaddr_in const local = {.sin_family = AF_INET, 
+                                    .sin_port = htons(hub.next_port++),
+                                    .sin_addr.s_addr = htonl(INADDR_LOOPBACK)};
+  mem_ep_t* ep = new_mem_ep(local, false);
+  ep->to = to;
+  return ep;
+}
+
+// Called with the lock held
+static
+void push_mem_ep(mem_ep_t* dst, mem_ep_msg_t const* msg)
+{
+  seq_push_back(&dst->queue, (void*)msg, sizeof(*msg));
+  hub.in_flight += 1;
+  hub.gen += 1;
+
+  uint64_t const one = 1;
+  ssize_t const rc = write(dst->fd, &one, sizeof(one));
+  assert(rc == sizeof(one));
+  (void)rc;
+
+  pthread_cond_broadcast(&hub.cv);
+}
+
+// Called with the lock held
+static
+void rm_assoc_mem_ep(size_t idx, mem_ep_t const* from)
+{
+  mem_assoc_t* a = seq_at(&hub.assocs, idx);
+  mem_ep_t* dst = a->conn == from ? a->lis : a->conn;
+
+  mem_ep_msg_t const eof = {.peer = from->addr, .assoc_id = a->id, .eof = true};
+  push_mem_ep(dst, &eof);
+
+  seq_erase(&hub.assocs, a, seq_next(&hub.assocs, a));
+}
+
+// Called with the lock held. NULL if not found
+static
+mem_assoc_t* find_assoc_mem_ep(mem_ep_t const* ep, struct sockaddr_in const* to, size_t* idx)
+{
+  for(size_t i = 0; i < seq_size(&hub.assocs); ++i){
+    mem_assoc_t* a = seq_at(&hub.assocs, i);
+    bool const found = ep->listening ? a->lis == ep && eq_addr_mem_ep(&a->conn->addr, to) 
+                                     : a->conn == ep;
+    if(found){
+      if(idx != NULL)
+        *idx = i;
+      return a;
+    }
+  }
+  return NULL;
+}
+
+// Called with the lock held
+static
+mem_ep_t* find_lis_mem_ep(struct sockaddr_in const* to)
+{
+  for(size_t i = 0; i < seq_size(&hub.eps); ++i){
+    mem_ep_t* it = *(mem_ep_t**)seq_at(&hub.eps, i);
+    if(accepts_mem_ep(it, to) == true)
+      return it;
+  }
+  return NULL;
+}
+
+void close_mem_ep(mem_ep_t* ep)
+{
+  assert(ep != NULL);
+
+  {
+    lock_guard(&hub.mtx);
+
+    for(size_t i = seq_size(&hub.assocs); i > 0; --i){
+      mem_assoc_t const* a = seq_at(&hub.assocs, i - 1);
+      if(a->conn == ep || a->lis == ep)
+        rm_assoc_mem_ep(i - 1, ep);
+    }
+
+    for(size_t i = 0; i < seq_size(&hub.eps); ++i){
+      mem_ep_t** it = seq_at(&hub.eps, i);
+      if(*it == ep){
+        seq_erase(&hub.eps, it, seq_next(&hub.eps, it));
+        break;
+      }
+    }
+
+    hub.in_flight -= seq_size(&ep->queue);
+    hub.gen += 1;
+    pthread_cond_broadcast(&hub.cv);
+  }
+
+  seq_free(&ep->queue, free_mem_ep_msg_wrapper);
+  int const rc = close(ep->fd);
+  assert(rc == 0);
+  (void)rc;
+  free(ep);
+}
+
+int fd_mem_ep(mem_ep_t const* ep)
+{
+  assert(ep != NULL);
+  return ep->fd;
+}
+
+struct sockaddr_in addr_mem_ep(mem_ep_t const* ep)
+{
+  assert(ep != NULL);
+  return ep->addr;
+}
+
+bool send_mem_ep(mem_ep_t* ep, struct sockaddr_in const* to, uint16_t stream, uint32_t ppid, byte_array_t ba)
+{
+  assert(ep != NULL);
+  assert(ba.buf != NULL && ba.len > 0);
+  assert(ep->listening == false || to != NULL);
+
+  lock_guard(&hub.mtx);
+
+  mem_assoc_t* a = find_assoc_mem_ep(ep, to, NULL);
+  if(a == NULL && ep->listening == false){
+    // Set up with the first message, as SCTP
+    mem_ep_t* lis = find_lis_mem_ep(&ep->to);
+    if(lis == NULL)
+      return false;
+
+    mem_assoc_t const new_a = {.conn = ep, .lis = lis, .id = ++hub.last_assoc_id};
+    seq_push_back(&hub.assocs, (void*)&new_a, sizeof(new_a));
+    a = seq_at(&hub.assocs, seq_size(&hub.assocs) - 1);
+  } 
+
+  if(a == NULL)
+    return false;
+
+  mem_ep_msg_t const msg = {.peer = ep->addr, 
+                            .assoc_id = a->id,
+                            .stream = stream,
+                            .ppid = ppid,
+                            .ba = copy_byte_array(ba)};
+
+  push_mem_ep(ep->listening ? a->conn : a->lis, &msg);
+  return true;
+}
+
+mem_ep_msg_t recv_mem_ep(mem_ep_t* ep)
+{
+  assert(ep != NULL);
+
+  uint64_t num = 0;
+  ssize_t rc = 0;
+  do{
+    rc = read(ep->fd, &num, sizeof(num));
+  } while(rc == -1 && errno == EINTR);
+  assert(rc == sizeof(num) && num == 1);
+
+  lock_guard(&hub.mtx);
+  assert(seq_size(&ep->queue) > 0);
+
+  mem_ep_msg_t* front = seq_front(&ep->queue);
+  mem_ep_msg_t const msg = *front;
+  seq_erase(&ep->queue, front, seq_next(&ep->queue, front));
+
+  hub.in_flight -= 1;
+  hub.gen += 1;
+  pthread_cond_broadcast(&hub.cv);
+  return msg;
+}
+
+void shutdown_mem_ep(mem_ep_t* ep, struct sockaddr_in const* to)
+{
+  assert(ep != NULL);
+
+  lock_guard(&hub.mtx);
+
+  size_t idx = 0;
+  if(find_assoc_mem_ep(ep, to, &idx) != NULL)
+    rm_assoc_mem_ep(idx, ep);
+}
+
+size_t in_flight_mem_ep(void)
+{
+  lock_guard(&hub.mtx);
+  return hub.in_flight;
+}
+
+static
+struct timespec add_ms(struct timespec t, int64_t ms)
+{
+  t.tv_sec += ms / 1000;
+  t.tv_nsec += (ms % 1000) * 1000000;
+  if(t.tv_nsec >= 1000000000){
+    t.tv_sec += 1;
+    t.tv_nsec -= 1000000000;
+  }
+  return t;
+}
+
+static
+bool before(struct timespec const* t0, struct timespec const* t1)
+{
+  return t0->tv_sec < t1->tv_sec || (t0->tv_sec == t1->tv_sec && t0->tv_nsec < t1->tv_nsec);
+}
+
+bool wait_mem_ep(bool (*pred)(void* arg), void* arg, int64_t timeout_ms)
+{
+  assert(pred != NULL);
+  assert(timeout_ms > -1);
+
+  struct timespec now = {0};
+  clock_gettime(CLOCK_REALTIME, &now);
+  struct timespec const end = add_ms(now, timeout_ms);
+
+  for(;;){
+    uint64_t gen = 0;
+    {
+      lock_guard(&hub.mtx);
+      gen = hub.gen;
+    }
+
+    // Without the lock, as pred may query the transport
+    if(pred(arg) == true)
+      return true;
+
+    clock_gettime(CLOCK_REALTIME, &now);
+    if(before(&now, &end) == false)
+      return false;
+
+    struct timespec poll = add_ms(now, POLL_MEM_EP_MS);
+    if(before(&end, &poll) == true)
+      poll = end;
+
+    lock_guard(&hub.mtx);
+    while(hub.gen == gen){
+      if(pthread_cond_timedwait(&hub.cv, &hub.mtx, &poll) == ETIMEDOUT)
+        break;
+    }
+  }
+}
+
+void kick_mem_ep(void)
+{
+  lock_guard(&hub.mtx);
+  hub.gen += 1;
+  pthread_cond_broadcast(&hub.cv);
+}
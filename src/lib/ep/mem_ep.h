@@ -0,0 +1,104 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+#ifndef E2AP_MEM_ENDPOINT_H
+#define E2AP_MEM_ENDPOINT_H
+
+// In-memory transport, i.e., a nearRT-RIC, its E2 Nodes and xApps in one 
+// process exchange the E2AP and E42AP messages through queues, without 
+// SCTP. Every endpoint created while enabled is in memory, see e2ap_ep.h. 
+// As with SCTP one-to-many sockets, an association is set up with the 
+// first message of the connecting endpoint, and a closed association is 
+// notified to the peer, i.e., SCTP_SHUTDOWN_EVENT.
+// The fd of an endpoint is an eventfd that is readable while messages are
+// queued, so the event loops poll it as a socket.
+// Intended for integration tests: every message and its delivery wake up
+// wait_mem_ep(), so a test steps on the protocol events, without sleeps
+
+#include "../../util/byte_array.h"
+
+#include <netinet/in.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define POLL_MEM_EP_MS 5
+
+typedef struct{
+  // The sender
+  struct sockaddr_in peer;
+  int32_t assoc_id;
+  uint16_t stream;
+  uint32_t ppid;
+  // The peer closed the association. No payload
+  bool eof;
+  byte_array_t ba;
+} mem_ep_msg_t;
+
+void free_mem_ep_msg(mem_ep_msg_t* msg);
+
+typedef struct mem_ep_s mem_ep_t;
+
+// Later calls share the first transport, and need a free_mem_ep each
+void init_mem_ep(void);
+
+// Asserts that every endpoint was closed once the last user leaves
+void free_mem_ep(void);
+
+bool enabled_mem_ep(void);
+
+// NULL if another endpoint listens at addr:port
+mem_ep_t* listen_mem_ep(char const* addr, int port);
+
+// To the endpoint listening at addr:port, which may not exist yet
+mem_ep_t* connect_mem_ep(char const* addr, int port);
+
+// The peers of its associations receive an eof. The queued messages are lost
+void close_mem_ep(mem_ep_t* ep);
+
+// Each 8 bytes read, i.e., recv_mem_ep(), consumes a message
+int fd_mem_ep(mem_ep_t const* ep);
+
+struct sockaddr_in addr_mem_ep(mem_ep_t const* ep);
+
+// Copies ba. to selects the association of a listening endpoint, and it is
+// ignored by a connecting one. False, and nothing sent, without association
+bool send_mem_ep(mem_ep_t* ep, struct sockaddr_in const* to, uint16_t stream, uint32_t ppid, byte_array_t ba);
+
+// Blocks until a message is queued
+mem_ep_msg_t recv_mem_ep(mem_ep_t* ep);
+
+// The peer receives an eof, i.e., SCTP_EOF
+void shutdown_mem_ep(mem_ep_t* ep, struct sockaddr_in const* to);
+
+// Messages sent and not yet received
+size_t in_flight_mem_ep(void);
+
+// Blocks until pred(arg) holds, or for timeout_ms. pred is evaluated after
+// every message sent or received, after kick_mem_ep(), and every 
+// POLL_MEM_EP_MS for the state changed after the last message, e.g., by
+// its handler. Returns the last value of pred
+bool wait_mem_ep(bool (*pred)(void* arg), void* arg, int64_t timeout_ms);
+
+// Wakes up wait_mem_ep(), e.g., after a callback of an xApp
+void kick_mem_ep(void);
+
+#endif
@@ -57,6 +57,8 @@ typedef struct{
     byte_array_t ba;
     union sctp_notification* notif;
   };
+  // Sent messages only. Comment of the capture, see e2ap_capture.h. Not owned
+  char const* note;
 } sctp_msg_t;
 
 void free_sctp_msg(sctp_msg_t* rcv);
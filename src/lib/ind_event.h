@@ -27,6 +27,7 @@
 #include <stdint.h>                               // for uint8_t
 #include "e2ap/ric_gen_id_wrapper.h"  // for ric_gen_id_t
 #include "../sm/sm_agent.h"
+#include "../util/byte_array.h"
 
 typedef struct{
   ric_gen_id_t ric_id;
@@ -46,6 +47,10 @@ typedef struct{
   void (*free_subs_aperiodic)(uint32_t ric_req_id);
   };
 
+  // Periodic events: the event trigger and the action definition as
+  // received. Equal ones produce the same indication 
+  byte_array_t subs;
+
 } ind_event_t;
 
 int cmp_ind_event(void const* m0_v, void const* m1_v);
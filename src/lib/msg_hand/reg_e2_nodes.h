@@ -28,6 +28,7 @@
 #include "e2_node_arr.h"
 #include "../../xApp/e2_node_arr_xapp.h"
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <pthread.h>
@@ -61,6 +62,8 @@ void add_reg_e2_node(reg_e2_nodes_t* i, global_e2_node_id_t const* id, size_t le
 
 void rm_reg_e2_node(reg_e2_nodes_t* n, global_e2_node_id_t const* id);
 
+bool present_reg_e2_node(reg_e2_nodes_t* n, global_e2_node_id_t const* id);
+
 size_t sz_reg_e2_node(reg_e2_nodes_t* n);
 
 assoc_rb_tree_t cp_reg_e2_node(reg_e2_nodes_t* n); 
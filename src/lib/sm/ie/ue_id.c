@@ -178,3 +178,20 @@ ue_id_e2sm_t cp_ue_id_e2sm(const ue_id_e2sm_t * src)
 
   return dst;
 }
+
+uint64_t num_ue_id_e2sm(ue_id_e2sm_t const* src)
+{
+  assert(src != NULL);
+
+  switch(src->type){
+    case GNB_UE_ID_E2SM: return src->gnb.amf_ue_ngap_id;
+    case GNB_DU_UE_ID_E2SM: return src->gnb_du.gnb_cu_ue_f1ap;
+    case GNB_CU_UP_UE_ID_E2SM: return src->gnb_cu_up.gnb_cu_cp_ue_e1ap;
+    case NG_ENB_UE_ID_E2SM: return src->ng_enb.amf_ue_ngap_id;
+    case NG_ENB_DU_UE_ID_E2SM: return src->ng_enb_du.ng_enb_cu_ue_w1ap_id;
+    case EN_GNB_UE_ID_E2SM: return src->en_gnb.enb_ue_x2ap_id;
+    case ENB_UE_ID_E2SM: return src->enb.mme_ue_s1ap_id;
+    default: assert(0!=0 && "Unknown UE ID type");
+  }
+  return 0;
+}
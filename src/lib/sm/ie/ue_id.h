@@ -48,6 +48,9 @@ bool eq_ue_id_e2sm(ue_id_e2sm_t const * m0, ue_id_e2sm_t const * m1);
 
 ue_id_e2sm_t cp_ue_id_e2sm(const ue_id_e2sm_t * src);
 
+// Main identifier of the UE within its type, e.g., the AMF UE NGAP ID of a gNB UE
+uint64_t num_ue_id_e2sm(ue_id_e2sm_t const* src);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,163 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+// Client of the admin socket of the nearRT-RIC, see admin_ric.h.
+//  flexric_admin [-s socket] [command ...]
+// Executes the command, or every line of stdin if no command is given.
+// Exits with 1 if any command fails
+
+#include "admin_ric.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+static
+int connect_admin(char const* path)
+{
+  struct sockaddr_un addr = {.sun_family = AF_UNIX};
+  if(strlen(path) >= sizeof(addr.sun_path)){
+    fprintf(stderr, "Socket path %s too long\n", path);
+    exit(EXIT_FAILURE);
+  }
+  strcpy(addr.sun_path, path);
+
+  int const fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  assert(fd != -1);
+
+  if(connect(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0){
+    fprintf(stderr, "Cannot connect to %s: %s. Is the nearRT-RIC running?\n", path, strerror(errno));
+    exit(EXIT_FAILURE);
+  }
+  return fd;
+}
+
+static
+void send_line(int fd, char const* line)
+{
+  size_t const len = strlen(line);
+  size_t pos = 0;
+  while(pos < len){
+    ssize_t const rc = send(fd, line + pos, len - pos, MSG_NOSIGNAL);
+    if(rc == -1 && errno == EINTR)
+      continue;
+    if(rc <= 0){
+      fprintf(stderr, "Connection closed by the nearRT-RIC\n");
+      exit(EXIT_FAILURE);
+    }
+    pos += rc;
+  }
+}
+
+// Prints the answer until the closing OK or ERR line. Returns false on ERR
+static
+bool print_answer(FILE* in)
+{
+  char* line = NULL;
+  size_t cap = 0;
+  bool ok = false;
+
+  for(;;){
+    if(getline(&line, &cap, in) == -1){
+      fprintf(stderr, "Connection closed by the nearRT-RIC\n");
+      exit(EXIT_FAILURE);
+    }
+
+    if(strcmp(line, "OK\n") == 0){
+      ok = true;
+      break;
+    }
+
+    if(strncmp(line, "ERR", 3) == 0){
+      fputs(line, stderr);
+      break;
+    }
+
+    fputs(line, stdout);
+  }
+
+  free(line);
+  fflush(stdout);
+  return ok;
+}
+
+static
+void usage(char const* name)
+{
+  fprintf(stderr, "Usage: %s [-s socket] [command ...]\n", name);
+  fprintf(stderr, "Default socket %s. Without command, reads the commands from stdin. Try: %s help\n", ADMIN_RIC_SOCKET, name);
+  exit(EXIT_FAILURE);
+}
+
+int main(int argc, char* argv[])
+{
+  char const* path = ADMIN_RIC_SOCKET;
+
+  int opt = 0;
+  while((opt = getopt(argc, argv, "s:h")) != -1){
+    if(opt == 's')
+      path = optarg;
+    else
+      usage(argv[0]);
+  }
+
+  int const fd = connect_admin(path);
+  FILE* in = fdopen(fd, "r");
+  assert(in != NULL);
+
+  bool ok = true;
+  if(optind < argc){
+    char line[ADMIN_RIC_MAX_LINE] = {0};
+    size_t len = 0;
+    for(int i = optind; i < argc; ++i){
+      int const rc = snprintf(line + len, sizeof(line) - len, "%s%s", argv[i], i + 1 < argc ? " " : "\n");
+      if(rc < 0 || (size_t)rc >= sizeof(line) - len){
+        fprintf(stderr, "Command too long\n");
+        return EXIT_FAILURE;
+      }
+      len += rc;
+    }
+    send_line(fd, line);
+    ok = print_answer(in);
+  } else {
+    char* line = NULL;
+    size_t cap = 0;
+    while(getline(&line, &cap, stdin) != -1){
+      // One command per line, also the last one
+      if(line[strlen(line) - 1] != '\n'){
+        send_line(fd, line);
+        send_line(fd, "\n");
+      } else {
+        send_line(fd, line);
+      }
+      ok &= print_answer(in);
+    }
+    free(line);
+  }
+
+  fclose(in);
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
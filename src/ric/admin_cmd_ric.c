@@ -0,0 +1,344 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+#include "admin_cmd_ric.h"
+#include "e2_node.h"
+#include "not_handler_ric.h"
+#include "iApp/e42_iapp_api.h"
+#include "lib/ep/e2ap_capture.h"
+#include "util/alg_ds/alg/defer.h"
+#include "util/alg_ds/ds/assoc_container/assoc_generic.h"
+#include "util/alg_ds/ds/lock_guard/lock_guard.h"
+#include "util/conf_file.h"
+#include "util/mem_acct.h"
+#include "util/ngran_types.h"
+
+#include <arpa/inet.h>
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+static
+bool parse_u64(char const* s, uint64_t max, uint64_t* dst)
+{
+  char* end = NULL;
+  unsigned long long const v = strtoull(s, &end, 10);
+  if(*s == '\0' || *s == '-' || *end != '\0' || v > max)
+    return false;
+  *dst = v;
+  return true;
+}
+
+static
+void print_e2_node_id(global_e2_node_id_t const* id, FILE* out)
+{
+  fprintf(out, "%s mcc %d mnc %d nb_id %u", get_ngran_name(id->type), id->plmn.mcc, id->plmn.mnc, id->nb_id.nb_id);
+  if(id->cu_du_id != NULL)
+    fprintf(out, " cu_du_id %lu", *id->cu_du_id);
+}
+
+// argv[0] = nb_id, argv[1] = cu_du_id, if present
+static
+char const* find_e2_node(near_ric_t* ric, size_t argc, char* argv[], global_e2_node_id_t* dst)
+{
+  uint64_t nb_id = 0;
+  uint64_t cu_du_id = 0;
+  if(argc < 1 || argc > 2 || parse_u64(argv[0], UINT32_MAX, &nb_id) == false)
+    return "expected <nb_id> [cu_du_id]";
+  if(argc == 2 && parse_u64(argv[1], UINT64_MAX, &cu_du_id) == false)
+    return "expected <nb_id> [cu_du_id]";
+
+  lock_guard(&ric->conn_e2_nodes_mtx);
+
+  e2_node_t const* found = NULL;
+  size_t num = 0;
+  for(size_t i = 0; i < seq_size(&ric->conn_e2_nodes); ++i){
+    e2_node_t const* n = seq_at(&ric->conn_e2_nodes, i);
+    if(n->id.nb_id.nb_id != nb_id)
+      continue;
+    if(argc == 2 && (n->id.cu_du_id == NULL || *n->id.cu_du_id != cu_du_id))
+      continue;
+    found = n;
+    num += 1;
+  }
+
+  if(num == 0)
+    return "unknown E2 Node";
+  if(num > 1)
+    return "ambiguous E2 Node, add the cu_du_id";
+
+  *dst = cp_global_e2_node_id(&found->id);
+  return NULL;
+}
+
+static
+char const* node_list(near_ric_t* ric, FILE* out)
+{
+  lock_guard(&ric->conn_e2_nodes_mtx);
+
+  for(size_t i = 0; i < seq_size(&ric->conn_e2_nodes); ++i){
+    e2_node_t const* n = seq_at(&ric->conn_e2_nodes, i);
+    print_e2_node_id(&n->id, out);
+    fprintf(out, " RAN functions %lu\n", n->len_acc);
+  }
+  return NULL;
+}
+
+static
+char const* node_show(near_ric_t* ric, global_e2_node_id_t const* id, FILE* out)
+{
+  print_e2_node_id(id, out);
+
+  sctp_info_t info = {0};
+  if(try_find_map_e2_node_sad(&ric->ep.e2_nodes, id, &info) == true){
+    char ip[INET_ADDRSTRLEN] = {0};
+    inet_ntop(AF_INET, &info.addr.sin_addr, ip, sizeof(ip));
+    fprintf(out, " addr %s:%u assoc %d", ip, ntohs(info.addr.sin_port), info.sri.sinfo_assoc_id);
+  }
+  fprintf(out, "\n");
+
+  lock_guard(&ric->conn_e2_nodes_mtx);
+
+  for(size_t i = 0; i < seq_size(&ric->conn_e2_nodes); ++i){
+    e2_node_t const* n = seq_at(&ric->conn_e2_nodes, i);
+    if(eq_global_e2_node_id(&n->id, id) == false)
+      continue;
+
+    for(size_t j = 0; j < n->len_acc; ++j){
+      // Only the RAN functions with an SM are accepted
+      sm_ric_t const* sm = sm_plugin_ric(&ric->plugin, n->accepted[j]);
+      fprintf(out, "RAN_FUNC_ID %u %s\n", n->accepted[j], sm->ran_func_name);
+    }
+  }
+  return NULL;
+}
+
+static
+char const* node_del(near_ric_t* ric, global_e2_node_id_t const* id)
+{
+  sctp_info_t info = {0};
+  if(try_find_map_e2_node_sad(&ric->ep.e2_nodes, id, &info) == false)
+    return "unknown E2 Node";
+
+  printf("[NEAR-RIC]: Removing E2 Node nb_id %u through the admin socket\n", id->nb_id.nb_id);
+
+  // No SCTP_SHUTDOWN_EVENT follows, as the nearRT-RIC shuts it down
+  e2ap_shutdown_sctp_assoc(&ric->ep.base, &info);
+
+  if(rm_e2_node_ric(ric, &info) == false)
+    return "E2 Node removed in between";
+
+  return NULL;
+}
+
+static
+char const* cmd_node(void* ctx, size_t argc, char* argv[], FILE* out)
+{
+  near_ric_t* ric = (near_ric_t*)ctx;
+
+  if(argc == 2 && strcmp(argv[1], "list") == 0)
+    return node_list(ric, out);
+
+  bool const show = argc > 2 && strcmp(argv[1], "show") == 0;
+  bool const del = argc > 2 && strcmp(argv[1], "del") == 0;
+  if(show == false && del == false)
+    return "expected list, show or del";
+
+  global_e2_node_id_t id = {0};
+  char const* err = find_e2_node(ric, argc - 2, argv + 2, &id);
+  if(err != NULL)
+    return err;
+
+  err = show ? node_show(ric, &id, out) : node_del(ric, &id);
+  free_global_e2_node_id(&id);
+  return err;
+}
+
+static
+char const* cmd_sub(void* ctx, size_t argc, char* argv[], FILE* out)
+{
+  (void)ctx;
+
+  if(argc == 2 && strcmp(argv[1], "list") == 0){
+    print_subs_iapp_api(out);
+    return NULL;
+  }
+
+  uint64_t ric_req_id = 0;
+  if(argc != 3 || strcmp(argv[1], "del") != 0 || parse_u64(argv[2], UINT32_MAX, &ric_req_id) == false)
+    return "expected list or del <ric_req_id>";
+
+  if(rm_sub_iapp_api(ric_req_id) == false)
+    return "unknown subscription";
+
+  fprintf(out, "RIC_REQ_ID %lu Subscription Delete Request sent\n", ric_req_id);
+  return NULL;
+}
+
+static
+char const* cmd_xapp(void* ctx, size_t argc, char* argv[], FILE* out)
+{
+  (void)ctx;
+
+  if(argc == 2 && strcmp(argv[1], "list") == 0){
+    print_xapps_iapp_api(out);
+    return NULL;
+  }
+
+  uint64_t xapp_id = 0;
+  if(argc != 3 || strcmp(argv[1], "del") != 0 || parse_u64(argv[2], UINT16_MAX, &xapp_id) == false)
+    return "expected list or del <xapp_id>";
+
+  if(rm_xapp_iapp_api(xapp_id) == false)
+    return "unknown xApp";
+
+  return NULL;
+}
+
+static
+char const* cmd_sm(void* ctx, size_t argc, char* argv[], FILE* out)
+{
+  near_ric_t* ric = (near_ric_t*)ctx;
+
+  if(argc != 2 || strcmp(argv[1], "list") != 0)
+    return "expected list";
+
+  // Loaded at start, and never modified afterwards
+  void* it = assoc_front(&ric->plugin.sm_ds);
+  void* end = assoc_end(&ric->plugin.sm_ds);
+  while(it != end){
+    sm_ric_t const* sm = assoc_value(&ric->plugin.sm_ds, it);
+    fprintf(out, "RAN_FUNC_ID %u %s\n", sm->ran_func_id, sm->ran_func_name);
+    it = assoc_next(&ric->plugin.sm_ds, it);
+  }
+  return NULL;
+}
+
+static
+char const* cmd_listener(void* ctx, size_t argc, char* argv[], FILE* out)
+{
+  near_ric_t* ric = (near_ric_t*)ctx;
+
+  if(argc == 2 && strcmp(argv[1], "list") == 0){
+    for(int i = 0; i < END_LISTENER_RIC; ++i)
+      fprintf(out, "%s %s\n", listener_ric_str(i), ric->listener_on[i] ? "on" : "off");
+    return NULL;
+  }
+
+  bool const on = argc == 3 && strcmp(argv[1], "on") == 0;
+  bool const off = argc == 3 && strcmp(argv[1], "off") == 0;
+  if(on == false && off == false)
+    return "expected list, on <name> or off <name>";
+
+  for(int i = 0; i < END_LISTENER_RIC; ++i){
+    if(strcmp(argv[2], listener_ric_str(i)) == 0){
+      ric->listener_on[i] = on;
+      return NULL;
+    }
+  }
+  return "unknown listener";
+}
+
+static
+char const* cmd_metrics(void* ctx, size_t argc, char* argv[], FILE* out)
+{
+  near_ric_t* ric = (near_ric_t*)ctx;
+  (void)argv;
+
+  if(argc != 1)
+    return "no arguments expected";
+
+  size_t num_nodes = 0;
+  {
+    lock_guard(&ric->conn_e2_nodes_mtx);
+    num_nodes = seq_size(&ric->conn_e2_nodes);
+  }
+
+  size_t num_pending = 0;
+  {
+    lock_guard(&ric->pend_mtx);
+    num_pending = bi_map_size(&ric->pending);
+  }
+
+  fprintf(out, "[NEAR-RIC]: E2 Nodes %lu\n", num_nodes);
+  fprintf(out, "[NEAR-RIC]: SMs %lu\n", size_plugin_ric(&ric->plugin));
+  fprintf(out, "[NEAR-RIC]: pending events %lu\n", num_pending);
+  fprintf(out, "[NEAR-RIC]: I/O backend %s\n", ric->io.ring != NULL ? "io_uring" : "epoll");
+  if(ric->io.ring != NULL)
+    fprintf(out, "[NEAR-RIC]: io_uring_enter calls %lu\n", syscalls_asio_uring(ric->io.ring));
+  print_msg_deadlines(&ric->deadlines, "NEAR-RIC", out);
+  if(enabled_e2ap_capture() == true)
+    fprintf(out, "[NEAR-RIC]: capture dropped %lu\n", dropped_e2ap_capture());
+
+  print_metrics_iapp_api(out);
+  print_mem_acct("NEAR-RIC", out);
+  return NULL;
+}
+
+static
+char const* cmd_mem(void* ctx, size_t argc, char* argv[], FILE* out)
+{
+  (void)ctx;
+
+  if(enabled_mem_acct() == false)
+    return "memory accounting not built, i.e., -DMEM_ACCT=ON";
+
+  if(argc == 1){
+    print_mem_acct("NEAR-RIC", out);
+    return NULL;
+  }
+
+  uint64_t max = 20;
+  if(strcmp(argv[1], "sites") != 0 || argc > 3 || (argc == 3 && parse_u64(argv[2], SIZE_MAX, &max) == false))
+    return "expected no arguments or sites [max]";
+
+  int64_t const live = print_sites_mem_acct("NEAR-RIC", max, out);
+  fprintf(out, "[NEAR-RIC]: %ld B live\n", live);
+  return NULL;
+}
+
+static
+admin_cmd_t const cmds[] = {
+  {.name = "node", .help = "list | show <nb_id> [cu_du_id] | del <nb_id> [cu_du_id]", .fp = cmd_node},
+  {.name = "sub", .help = "list | del <ric_req_id>", .fp = cmd_sub},
+  {.name = "xapp", .help = "list | del <xapp_id>", .fp = cmd_xapp},
+  {.name = "sm", .help = "list", .fp = cmd_sm},
+  {.name = "listener", .help = "list | on <name> | off <name>", .fp = cmd_listener},
+  {.name = "metrics", .help = "Counters of the nearRT-RIC and the iApp", .fp = cmd_metrics},
+  {.name = "mem", .help = "[sites [max]], live memory per component or per call site", .fp = cmd_mem},
+};
+
+void init_admin_cmd_ric(near_ric_t* ric, fr_args_t const* args)
+{
+  assert(ric != NULL);
+  assert(args != NULL);
+
+  ric->admin.fd = -1;
+
+  char* path = get_conf_admin_socket(args);
+  defer({ free(path); });
+
+  if(path != NULL && strcmp(path, "none") == 0)
+    return;
+
+  size_t const len = sizeof(cmds)/sizeof(cmds[0]);
+  init_admin_ric(&ric->admin, path != NULL ? path : ADMIN_RIC_SOCKET, ric, len, cmds);
+}
@@ -0,0 +1,40 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+e* For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+#ifndef ADMIN_CMD_RIC_H
+#define ADMIN_CMD_RIC_H
+
+// Commands of the admin socket of the nearRT-RIC, see admin_ric.h.
+// E2 Nodes are named by their nb_id, plus the cu_du_id if ambiguous, 
+// and subscriptions by their RIC Request ID towards the E2 Node:
+//  node list | node show <nb_id> [cu_du_id] | node del <nb_id> [cu_du_id]
+//  sub list | sub del <ric_req_id>
+//  xapp list | xapp del <xapp_id>
+//  sm list
+//  listener list | listener on <name> | listener off <name>
+//  metrics
+
+#include "near_ric.h"
+
+// Listens at ADMIN_SOCKET, or ADMIN_RIC_SOCKET if the key is not present
+void init_admin_cmd_ric(near_ric_t* ric, fr_args_t const* args);
+
+#endif
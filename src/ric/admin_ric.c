@@ -0,0 +1,291 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+#include "admin_ric.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// The stop flag is polled with this period
+#define POLL_PERIOD_MS 200
+
+static
+size_t split_args(char* line, size_t len, char* argv[len])
+{
+  size_t argc = 0;
+  char* save = NULL;
+  for(char* it = strtok_r(line, " \t\r", &save); it != NULL; it = strtok_r(NULL, " \t\r", &save)){
+    if(argc == len)
+      return len + 1;
+    argv[argc] = it;
+    argc += 1;
+  }
+  return argc;
+}
+
+static
+void help_admin(admin_ric_t const* a, FILE* out)
+{
+  fprintf(out, "%-32s %s\n", "help", "This list");
+  for(size_t i = 0; i < a->len_cmds; ++i)
+    fprintf(out, "%-32s %s\n", a->cmds[i].name, a->cmds[i].help);
+}
+
+void exec_admin_ric(admin_ric_t const* a, char* line, FILE* out)
+{
+  assert(a != NULL);
+  assert(line != NULL);
+  assert(out != NULL);
+
+  char* argv[ADMIN_RIC_MAX_ARGS] = {0};
+  size_t const argc = split_args(line, ADMIN_RIC_MAX_ARGS, argv);
+  if(argc > ADMIN_RIC_MAX_ARGS){
+    fprintf(out, "ERR too many arguments\n");
+    return;
+  }
+
+  // Empty lines are answered too, so that the client does not wait
+  if(argc == 0 || strcmp(argv[0], "help") == 0){
+    help_admin(a, out);
+    fprintf(out, "OK\n");
+    return;
+  }
+
+  admin_cmd_t const* cmd = NULL;
+  for(size_t i = 0; i < a->len_cmds && cmd == NULL; ++i){
+    if(strcmp(a->cmds[i].name, argv[0]) == 0)
+      cmd = &a->cmds[i];
+  }
+
+  if(cmd == NULL){
+    fprintf(out, "ERR unknown command %s, try help\n", argv[0]);
+    return;
+  }
+
+  char const* err = cmd->fp(a->ctx, argc, argv, out);
+  if(err == NULL)
+    fprintf(out, "OK\n");
+  else
+    fprintf(out, "ERR %s\n", err);
+}
+
+static
+bool send_all(int fd, char const* buf, size_t len)
+{
+  size_t pos = 0;
+  while(pos < len){
+    ssize_t const rc = send(fd, buf + pos, len - pos, MSG_NOSIGNAL);
+    if(rc == -1 && errno == EINTR)
+      continue;
+    if(rc <= 0)
+      return false;
+    pos += rc;
+  }
+  return true;
+}
+
+static
+bool answer_line(admin_ric_t const* a, int fd, char* line)
+{
+  char* buf = NULL;
+  size_t len = 0;
+  FILE* out = open_memstream(&buf, &len);
+  assert(out != NULL && "Memory exhausted");
+
+  exec_admin_ric(a, line, out);
+
+  int const rc = fclose(out);
+  assert(rc == 0);
+  bool const ok = send_all(fd, buf, len);
+  free(buf);
+  return ok;
+}
+
+static
+void serve_client(admin_ric_t* a, int fd)
+{
+  char buf[ADMIN_RIC_MAX_LINE] = {0};
+  size_t len = 0;
+  int idle_ms = 0;
+
+  while(a->stop == false && idle_ms < ADMIN_RIC_IDLE_MS){
+    struct pollfd p = {.fd = fd, .events = POLLIN};
+    int const rc = poll(&p, 1, POLL_PERIOD_MS);
+    if(rc == -1 && errno == EINTR)
+      continue;
+    assert(rc != -1);
+    if(rc == 0){
+      idle_ms += POLL_PERIOD_MS;
+      continue;
+    }
+
+    ssize_t const n = recv(fd, buf + len, sizeof(buf) - len, 0);
+    if(n <= 0)
+      return;
+    len += n;
+    idle_ms = 0;
+
+    // Every complete line
+    char* nl = memchr(buf, '\n', len);
+    while(nl != NULL){
+      *nl = '\0';
+      if(answer_line(a, fd, buf) == false)
+        return;
+
+      size_t const consumed = nl - buf + 1;
+      memmove(buf, nl + 1, len - consumed);
+      len -= consumed;
+      nl = memchr(buf, '\n', len);
+    }
+
+    if(len == sizeof(buf)){
+      char const err[] = "ERR line too long\n";
+      send_all(fd, err, sizeof(err) - 1);
+      return;
+    }
+  }
+}
+
+static
+void* admin_thread(void* arg)
+{
+  admin_ric_t* a = (admin_ric_t*)arg;
+
+  while(a->stop == false){
+    struct pollfd p = {.fd = a->fd, .events = POLLIN};
+    int const rc = poll(&p, 1, POLL_PERIOD_MS);
+    if(rc == -1 && errno == EINTR)
+      continue;
+    assert(rc != -1);
+    if(rc == 0)
+      continue;
+
+    int const fd = accept(a->fd, NULL, NULL);
+    if(fd == -1){
+      printf("[NEAR-RIC]: Admin socket accept failed: %s\n", strerror(errno));
+      continue;
+    }
+
+    serve_client(a, fd);
+    close(fd);
+  }
+
+  return NULL;
+}
+
+// Whether a listener answers at addr, e.g., another nearRT-RIC on the same 
+// host. A full backlog still means somebody listens
+static
+bool live_admin_socket(struct sockaddr_un const* addr)
+{
+  int const fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0);
+  assert(fd != -1);
+
+  int const rc = connect(fd, (struct sockaddr const*)addr, sizeof(*addr));
+  bool const live = rc == 0 || errno == EAGAIN;
+
+  close(fd);
+  return live;
+}
+
+bool init_admin_ric(admin_ric_t* a, char const* path, void* ctx, size_t len, admin_cmd_t const cmds[len])
+{
+  assert(a != NULL);
+  assert(path != NULL);
+  assert(len == 0 || cmds != NULL);
+
+  memset(a, 0, sizeof(*a));
+  a->fd = -1;
+
+  struct sockaddr_un addr = {.sun_family = AF_UNIX};
+  if(strlen(path) >= sizeof(addr.sun_path)){
+    printf("[NEAR-RIC]: Admin socket path %s too long. Admin socket disabled\n", path);
+    return false;
+  }
+  strcpy(addr.sun_path, path);
+
+  if(live_admin_socket(&addr) == true){
+    printf("[NEAR-RIC]: Admin socket %s in use by another process. Admin socket disabled\n", path);
+    return false;
+  }
+
+  int const fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  assert(fd != -1);
+
+  // Only the owner may connect. Linux creates the socket file with the mode 
+  // of the socket, so that there is no window with a wider one 
+  int rc = fchmod(fd, S_IRUSR | S_IWUSR);
+  assert(rc == 0);
+
+  // Left behind by a crashed nearRT-RIC, as nobody answered
+  unlink(path);
+
+  rc = bind(fd, (struct sockaddr*)&addr, sizeof(addr));
+  if(rc != 0){
+    printf("[NEAR-RIC]: Admin socket %s bind failed: %s. Admin socket disabled\n", path, strerror(errno));
+    close(fd);
+    return false;
+  }
+
+  rc = listen(fd, 4);
+  assert(rc == 0);
+
+  a->fd = fd;
+  a->path = strdup(path);
+  assert(a->path != NULL && "Memory exhausted");
+  a->ctx = ctx;
+  a->len_cmds = len;
+  a->cmds = cmds;
+  a->stop = false;
+
+  rc = pthread_create(&a->t, NULL, admin_thread, a);
+  assert(rc == 0);
+
+  printf("[NEAR-RIC]: Admin socket listening at %s\n", path);
+  return true;
+}
+
+void free_admin_ric(admin_ric_t* a)
+{
+  assert(a != NULL);
+
+  if(a->fd == -1)
+    return;
+
+  a->stop = true;
+  int rc = pthread_join(a->t, NULL);
+  assert(rc == 0);
+
+  rc = close(a->fd);
+  assert(rc == 0);
+  a->fd = -1;
+
+  unlink(a->path);
+  free(a->path);
+  a->path = NULL;
+}
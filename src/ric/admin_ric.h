@@ -0,0 +1,78 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+e* For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+#ifndef ADMIN_RIC_H
+#define ADMIN_RIC_H
+
+// Local admin socket (Unix domain) of the nearRT-RIC. Line based protocol:
+// one command per line, i.e., the name followed by its arguments separated
+// by blanks, e.g., "sub del 7". The answer is zero or more lines, closed by
+// a line with "OK" or "ERR <reason>". "help" lists the commands.
+// One client at a time is served by a dedicated thread, so the E2 event loop
+// never waits for it. Configured through the configuration file:
+//  ADMIN_SOCKET = /tmp/flexric_ric_admin.sock
+// "none" disables it
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#define ADMIN_RIC_SOCKET "/tmp/flexric_ric_admin.sock"
+#define ADMIN_RIC_MAX_LINE 512
+#define ADMIN_RIC_MAX_ARGS 8
+// A client that does not send a complete line in this time is dropped
+#define ADMIN_RIC_IDLE_MS 30000
+
+// argv[0] is the name of the command. Writes the answer into out.
+// Returns NULL on success, or the reason of the error
+typedef char const* (*admin_cmd_fp)(void* ctx, size_t argc, char* argv[], FILE* out);
+
+typedef struct{
+  char const* name;
+  char const* help;
+  admin_cmd_fp fp;
+} admin_cmd_t;
+
+typedef struct{
+  int fd;
+  char* path;
+
+  void* ctx;
+  size_t len_cmds;
+  admin_cmd_t const* cmds;
+
+  atomic_bool stop;
+  pthread_t t;
+} admin_ric_t;
+
+// Returns false, and the admin socket stays disabled, if path cannot be bound
+// or a live process, e.g., another nearRT-RIC, listens at it
+bool init_admin_ric(admin_ric_t* a, char const* path, void* ctx, size_t len, admin_cmd_t const cmds[len]);
+
+// Nothing if disabled
+void free_admin_ric(admin_ric_t* a);
+
+// Dispatches one line. Exposed for the tests. Writes the whole answer into out
+void exec_admin_ric(admin_ric_t const* a, char* line, FILE* out);
+
+#endif
@@ -45,6 +45,13 @@ void set_fd_non_blocking(int sfd)
 void init_asio_ric(asio_ric_t* io)
 {
   assert(io != NULL);
+
+  io->ring = create_asio_uring();
+  if(io->ring != NULL){
+    io->efd = -1;
+    return;
+  }
+
   const int flags = EPOLL_CLOEXEC; 
   const int efd = epoll_create1(flags);  
   assert(efd != -1);
@@ -56,6 +63,11 @@ void add_fd_asio_ric(asio_ric_t* io, int fd)
   assert(io != NULL);
   assert(fd > 0 && "fd cannot be negative, data corrupted");
 
+  if(io->ring != NULL){
+    add_fd_asio_uring(io->ring, fd, false);
+    return;
+  }
+
   set_fd_non_blocking(io->efd);
   const int op = EPOLL_CTL_ADD;
   const epoll_data_t e_data = {.fd = fd};
@@ -71,6 +83,9 @@ int create_timer_ms_asio_ric(asio_ric_t* io, long initial_ms, long interval_ms)
   assert(initial_ms > 0);
   assert(interval_ms > 0);
 
+  if(io->ring != NULL)
+    return create_timer_ms_asio_uring(io->ring, initial_ms, interval_ms);
+
   // Create the timer
   const int clockid = CLOCK_MONOTONIC;
   const int flags = TFD_NONBLOCK | TFD_CLOEXEC;
@@ -101,6 +116,17 @@ int create_timer_ms_asio_ric(asio_ric_t* io, long initial_ms, long interval_ms)
 void rm_fd_asio_ric(asio_ric_t* io, int fd)
 {
   assert(io != NULL);
+
+  if(io->ring != NULL && is_timer_asio_uring(fd) == true){
+    rm_timer_asio_uring(io->ring, fd);
+    return;
+  } else if(io->ring != NULL){
+    rm_fd_asio_uring(io->ring, fd);
+    int const rc = close(fd);
+    assert(rc == 0);
+    return;
+  }
+
   const int op = EPOLL_CTL_DEL;
   const epoll_data_t e_data = {.fd = fd};
   const int e_events = EPOLLIN; // open for reading
@@ -112,10 +138,32 @@ void rm_fd_asio_ric(asio_ric_t* io, int fd)
 
 }
 
+void consume_timer_asio_ric(asio_ric_t const* io, int fd)
+{
+  assert(io != NULL);
+  assert(fd > 0);
+
+  // Nothing to read from io_uring timeouts
+  if(io->ring != NULL && is_timer_asio_uring(fd) == true)
+    return;
+
+  uint64_t read_buf = 0;
+  ssize_t const bytes = read(fd, &read_buf, sizeof(read_buf));
+  assert(bytes == sizeof(read_buf));
+}
+
 fd_read_t event_asio_ric(asio_ric_t const* io)
 {
   assert(io != NULL);
 
+  if(io->ring != NULL){
+    fd_read_t fd_read = {.len = -1}; 
+    size_t const len = event_asio_uring(io->ring, 1000, sizeof(fd_read.fd)/sizeof(fd_read.fd[0]), fd_read.fd);
+    if(len > 0)
+      fd_read.len = len;
+    return fd_read;
+  }
+
   const int maxevents = 64;
   struct epoll_event events[maxevents];
   const int timeout_ms = 1000;
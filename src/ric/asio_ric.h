@@ -24,10 +24,13 @@
 #define ASYNC_INPUT_OUTPUT_RIC_H
 
 #include <stddef.h>
+#include "../lib/asio_uring.h"
 
 typedef struct{
   // epoll based fd
   int efd; 
+  // io_uring backend. NULL if epoll 
+  asio_uring_t* ring;
 
 } asio_ric_t;
 
@@ -40,6 +43,9 @@ int create_timer_ms_asio_ric(asio_ric_t* io, long initial_ms, long interval_ms);
 
 void rm_fd_asio_ric(asio_ric_t* io, int fd);
 
+// Acknowledges the expiration of a timer
+void consume_timer_asio_ric(asio_ric_t const* io, int fd);
+
 typedef struct{
   int fd[64];
   int len;
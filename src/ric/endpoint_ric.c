@@ -21,6 +21,8 @@
 
 
 #include "endpoint_ric.h"
+#include "lib/ep/e2ap_capture.h"
+#include "util/ngran_types.h"
 #include <arpa/inet.h>   // for inet_pton
 #include <assert.h>      // for assert
 #include <errno.h>       // for errno
@@ -90,7 +92,10 @@ void e2ap_init_ep_ric(e2ap_ep_ric_t* ep, const char* addr, int port)
 
   e2ap_ep_init(&ep->base); 
 
-  *(int*)(&ep->base.fd) = init_sctp_conn_server(addr, port);
+  if(enabled_mem_ep() == true)
+    *(int*)(&ep->base.fd) = e2ap_ep_listen_mem(&ep->base, addr, port);
+  else
+    *(int*)(&ep->base.fd) = init_sctp_conn_server(addr, port);
   *(int*)(&ep->base.port) = port;
   strncpy((char*)(&ep->base.addr), addr, 16);
 
@@ -116,14 +121,25 @@ sctp_msg_t e2ap_recv_msg_ric(e2ap_ep_ric_t* ep)
 }
 
 void e2ap_send_bytes_ric(const e2ap_ep_ric_t* ep, global_e2_node_id_t const* id , byte_array_t ba)
+{
+  e2ap_send_bytes_note_ric(ep, id, ba, NULL);
+}
+
+void e2ap_send_bytes_note_ric(const e2ap_ep_ric_t* ep, global_e2_node_id_t const* id, byte_array_t ba, char const* note)
 {
   assert(ba.buf && ba.len > 0);
   assert(ep != NULL);
 
-  sctp_info_t s = find_map_e2_node_sad(( map_e2_node_sockaddr_t*)&ep->e2_nodes, id);
+  sctp_info_t s = {0};
+  if(try_find_map_e2_node_sad((map_e2_node_sockaddr_t*)&ep->e2_nodes, id, &s) == false){
+    // Restored from the replica of a standby, and not set up again yet
+    printf("[NEAR-RIC]: E2 Node nb_id %u not associated. Message dropped\n", id->nb_id.nb_id);
+    return;
+  }
 
   sctp_msg_t msg = {.ba = ba,
-                    .info = s};
+                    .info = s,
+                    .note = note};
 
   e2ap_send_sctp_msg(&ep->base, &msg); // s.addr, &s.sri, ba);
 }
@@ -143,6 +159,14 @@ void e2ap_reg_sock_addr_ric(e2ap_ep_ric_t* ep, global_e2_node_id_t const* id, sc
   assert(s != NULL);
 
   add_map_e2_node_sad(&ep->e2_nodes,id, s );
+
+  if(enabled_e2ap_capture() == true){
+    char tag[128] = {0};
+    int const rc = snprintf(tag, sizeof(tag), "%s mcc %d mnc %d nb_id %u", get_ngran_name(id->type), id->plmn.mcc, id->plmn.mnc, id->nb_id.nb_id);
+    if(id->cu_du_id != NULL && rc > 0 && rc < (int)sizeof(tag))
+      snprintf(tag + rc, sizeof(tag) - rc, " cu_du_id %lu", *id->cu_du_id);
+    tag_e2ap_capture(&s->addr, tag);
+  }
 }
 
 global_e2_node_id_t* e2ap_rm_sock_addr_ric(e2ap_ep_ric_t* ep, sctp_info_t const* s)
@@ -150,6 +174,7 @@ global_e2_node_id_t* e2ap_rm_sock_addr_ric(e2ap_ep_ric_t* ep, sctp_info_t const*
   assert(ep != NULL);
   assert(s != NULL);
 
+  tag_e2ap_capture(&s->addr, NULL);
   return rm_map_sad_e2_node(&ep->e2_nodes, s);
 }
 
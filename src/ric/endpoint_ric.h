@@ -44,10 +44,14 @@ sctp_msg_t e2ap_recv_msg_ric(e2ap_ep_ric_t* ep);
 
 void e2ap_send_bytes_ric(const e2ap_ep_ric_t* ep, global_e2_node_id_t const* id, byte_array_t ba);
 
+// note, if not NULL, is written in the capture along with the message
+void e2ap_send_bytes_note_ric(const e2ap_ep_ric_t* ep, global_e2_node_id_t const* id, byte_array_t ba, char const* note);
+
 void e2ap_send_sctp_msg_ric(const e2ap_ep_ric_t* ep, sctp_msg_t* msg);
 
 void e2ap_reg_sock_addr_ric(e2ap_ep_ric_t* ric, global_e2_node_id_t const* id, sctp_info_t const* s);
 
+// NULL if s is not registered, e.g., removed through the admin socket
 global_e2_node_id_t* e2ap_rm_sock_addr_ric(e2ap_ep_ric_t* ric, sctp_info_t const* s);
 
 #endif
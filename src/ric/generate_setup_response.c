@@ -27,6 +27,7 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 
 
 typedef uint16_t accepted_ran_function_t;
@@ -35,17 +36,36 @@ typedef uint16_t accepted_ran_function_t;
 typedef struct{
  size_t len_acc;
   accepted_ran_function_t* acc; 
+  size_t len_rej;
+  rejected_ran_function_t* rej;
 } accepted_pair_t ;
 
+// The agent advertises the encoding of the plain SMs in the RAN Function
+// Definition. A RAN function that the RIC plug-in cannot decode is rejected
+// here, instead of failing later while decoding its first message
+static
+bool compatible_sm_enc(sm_ric_t const* sm, ran_function_t const* rf)
+{
+  sm_enc_e enc = END_SM_ENC;
+  if(ran_func_def_sm_enc(rf->defn.len, rf->defn.buf, &enc) == false)
+    return true;
+
+  if(enc != sm->enc){
+    printf("[NEAR-RIC]: RAN function ID %d encoded in %s while the RIC SM expects %s, thus rejecting \n", rf->id, sm_enc_str(enc), sm_enc_str(sm->enc));
+    return false;
+  }
+
+  return true;
+}
+
 accepted_pair_t accept_ran_func(near_ric_t* ric, const e2_setup_request_t* req)
 {
-  // All the functions are accepted
-  accepted_pair_t dst = {.len_acc = req->len_rf }; 
+  accepted_pair_t dst = {0}; 
 
-  dst.acc = calloc(dst.len_acc, sizeof(accepted_ran_function_t));
+  dst.acc = calloc(req->len_rf, sizeof(accepted_ran_function_t));
   assert(dst.acc != NULL && "Memory exhausted");
 
-  for (size_t i = 0; i < dst.len_acc; ++i) {
+  for (size_t i = 0; i < req->len_rf; ++i) {
     void* start_it = assoc_front(&ric->plugin.sm_ds);
     void* end_it = assoc_end(&ric->plugin.sm_ds);
     uint16_t const id = req->ran_func_item[i].id;
@@ -54,8 +74,22 @@ accepted_pair_t accept_ran_func(near_ric_t* ric, const e2_setup_request_t* req)
 
     if(it != end_it){
       assert(id == *(uint16_t*)assoc_key(&ric->plugin.sm_ds, it) );
-      dst.acc[i] = id;
       sm_ric_t* sm = (sm_ric_t*)assoc_value(&ric->plugin.sm_ds, it);
+
+      if(compatible_sm_enc(sm, &req->ran_func_item[i]) == false){
+        if(dst.rej == NULL){
+          dst.rej = calloc(req->len_rf, sizeof(rejected_ran_function_t));
+          assert(dst.rej != NULL && "Memory exhausted");
+        }
+        dst.rej[dst.len_rej].id = id;
+        dst.rej[dst.len_rej].cause.present = CAUSE_PROTOCOL;
+        dst.rej[dst.len_rej].cause.protocol = CAUSE_PROTOCOL_TRANSFER_SYNTAX_ERROR;
+        dst.len_rej += 1;
+        continue;
+      }
+
+      dst.acc[dst.len_acc] = id;
+      dst.len_acc += 1;
       char def[33] = {0};
       memcpy(def, sm->ran_func_name, 32);
       printf("[NEAR-RIC]: Accepting RAN function ID %d with def = %s \n", id, def);
@@ -90,8 +124,8 @@ e2_setup_response_t generate_setup_response_v1(near_ric_t* ric, const e2_setup_r
       .id.near_ric_id.double_word = 25,
       .accepted = acc.acc,
       .len_acc = acc.len_acc,
-      .rejected = NULL,
-      .len_rej = 0,
+      .rejected = acc.rej,
+      .len_rej = acc.len_rej,
       .comp_conf_update_ack_list = NULL,
       .len_ccual = 0
   };
@@ -126,8 +160,8 @@ e2_setup_response_t generate_setup_response_v2(near_ric_t* ric, const e2_setup_r
       .id.near_ric_id.double_word = 25,
       .accepted = acc.acc,
       .len_acc = acc.len_acc,
-      .rejected = NULL,
-      .len_rej = 0,
+      .rejected = acc.rej,
+      .len_rej = acc.len_rej,
       .comp_config_add_ack = add_ack,
       .len_ccaa  = len_ccaa
   };
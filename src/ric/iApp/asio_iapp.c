@@ -66,6 +66,12 @@ void init_asio_iapp(asio_iapp_t* io)
 {
   assert(io != NULL);
 
+  io->ring = create_asio_uring();
+  if(io->ring != NULL){
+    io->efd = -1;
+    return;
+  }
+
   io->efd = init_epoll();
   set_fd_non_blocking(io->efd);
 }
@@ -73,6 +79,12 @@ void init_asio_iapp(asio_iapp_t* io)
 void add_fd_asio_iapp(asio_iapp_t* io, int fd)
 {
   assert(io != NULL);
+
+  if(io->ring != NULL){
+    add_fd_asio_uring(io->ring, fd, true);
+    return;
+  }
+
   const int op = EPOLL_CTL_ADD;
   const epoll_data_t e_data = {.fd = fd};
   const int e_events = EPOLLIN | EPOLLET; // open for reading and edge triggered instead of level triggered
@@ -85,6 +97,17 @@ void add_fd_asio_iapp(asio_iapp_t* io, int fd)
 void rm_fd_asio_iapp(asio_iapp_t* io, int fd)
 {
   assert(io != NULL);
+
+  if(io->ring != NULL && is_timer_asio_uring(fd) == true){
+    rm_timer_asio_uring(io->ring, fd);
+    return;
+  } else if(io->ring != NULL){
+    rm_fd_asio_uring(io->ring, fd);
+    int const rc = close(fd);
+    assert(rc == 0);
+    return;
+  }
+
   const int op = EPOLL_CTL_DEL;
   const epoll_data_t e_data = {.fd = fd};
   const int e_events = EPOLLIN; // open for reading
@@ -101,6 +124,9 @@ int create_timer_ms_asio_iapp(asio_iapp_t* io, long initial_ms, long interval_ms
   assert(initial_ms > -1);
   assert(interval_ms > -1);
 
+  if(io->ring != NULL)
+    return create_timer_ms_asio_uring(io->ring, initial_ms, interval_ms);
+
   // Create the timer
   const int clockid = CLOCK_MONOTONIC;
   const int flags = TFD_NONBLOCK | TFD_CLOEXEC;
@@ -127,10 +153,30 @@ int create_timer_ms_asio_iapp(asio_iapp_t* io, long initial_ms, long interval_ms
   return tfd;
 }
 
+void consume_timer_asio_iapp(asio_iapp_t const* io, int fd)
+{
+  assert(io != NULL);
+  assert(fd > 0);
+
+  // Nothing to read from io_uring timeouts
+  if(io->ring != NULL && is_timer_asio_uring(fd) == true)
+    return;
+
+  uint64_t read_buf = 0;
+  ssize_t const bytes = read(fd, &read_buf, sizeof(read_buf));
+  assert(bytes == sizeof(read_buf));
+}
+
 int event_asio_iapp(asio_iapp_t const* io)
 {
   assert(io != NULL);
 
+  if(io->ring != NULL){
+    int fd = -1;
+    size_t const len = event_asio_uring(io->ring, 1000, 1, &fd);
+    return len == 0 ? -1 : fd;
+  }
+
   const int maxevents = 1;
   struct epoll_event events[maxevents];
   const int timeout_ms = 1000;
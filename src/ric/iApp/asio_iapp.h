@@ -24,11 +24,15 @@
 #ifndef ASYNC_INPUT_OUTPUT_IAPP_H
 #define ASYNC_INPUT_OUTPUT_IAPP_H
 
+#include "../../lib/asio_uring.h"
+
 
 typedef struct{
 
   // epoll based fd
   int efd; 
+  // io_uring backend. NULL if epoll 
+  asio_uring_t* ring;
 
 } asio_iapp_t;
 
@@ -47,6 +51,9 @@ void add_fd_asio_iapp(asio_iapp_t* io, int fd);
 
 void rm_fd_asio_iapp(asio_iapp_t* io, int fd);
 
+// Acknowledges the expiration of a timer
+void consume_timer_asio_iapp(asio_iapp_t const* io, int fd);
+
 int create_timer_ms_asio_iapp(asio_iapp_t* io, long initial_ms, long interval_ms);
 
 int event_asio_iapp(asio_iapp_t const* io);
@@ -0,0 +1,571 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+
+#include "consumer_group.h"
+
+#include "../../util/alg_ds/ds/lock_guard/lock_guard.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+static
+void free_shared_sub(void* it)
+{
+  assert(it != NULL);
+  shared_sub_t* s = (shared_sub_t*)it;
+
+  free_byte_array(s->group);
+  free_global_e2_node_id(&s->id);
+  free_byte_array(s->key);
+
+  // Actions not admitted do not own memory 
+  free(s->resp.admitted);
+  free(s->resp.not_admitted);
+
+  seq_free(&s->members, NULL);
+}
+
+static
+void free_cg_xapp(void* it)
+{
+  assert(it != NULL);
+  cg_xapp_t* x = (cg_xapp_t*)it;
+  free_byte_array(x->group);
+}
+
+static
+void append(byte_array_t* ba, void const* src, size_t len)
+{
+  if(len == 0)
+    return;
+
+  ba->buf = realloc(ba->buf, ba->len + len);
+  assert(ba->buf != NULL && "Memory exhausted");
+  memcpy(ba->buf + ba->len, src, len);
+  ba->len += len;
+}
+
+// Two subscriptions are shared iff their keys are equal
+static
+byte_array_t gen_key(ric_subscription_request_t const* sr)
+{
+  byte_array_t ba = {0};
+
+  append(&ba, &sr->ric_id.ran_func_id, sizeof(sr->ric_id.ran_func_id));
+  append(&ba, &sr->event_trigger.len, sizeof(sr->event_trigger.len));
+  append(&ba, sr->event_trigger.buf, sr->event_trigger.len);
+
+  append(&ba, &sr->len_action, sizeof(sr->len_action));
+  for(size_t i = 0; i < sr->len_action; ++i){
+    ric_action_t const* a = &sr->action[i];
+    append(&ba, &a->id, sizeof(a->id));
+    append(&ba, &a->type, sizeof(a->type));
+
+    size_t const len_def = a->definition != NULL ? a->definition->len : 0;
+    append(&ba, &len_def, sizeof(len_def));
+    if(a->definition != NULL)
+      append(&ba, a->definition->buf, a->definition->len);
+
+    uint8_t const subseq = a->subseq_action != NULL;
+    append(&ba, &subseq, sizeof(subseq));
+    if(a->subseq_action != NULL){
+      append(&ba, &a->subseq_action->type, sizeof(a->subseq_action->type));
+      uint32_t const wait_ms = a->subseq_action->time_to_wait_ms != NULL ? *a->subseq_action->time_to_wait_ms : 0;
+      append(&ba, &wait_ms, sizeof(wait_ms));
+    }
+  }
+
+  return ba;
+}
+
+// FNV-1a 
+static
+uint64_t hash_bytes(uint64_t h, void const* src, size_t len)
+{
+  uint8_t const* p = (uint8_t const*)src;
+  for(size_t i = 0; i < len; ++i){
+    h ^= p[i];
+    h *= 0x100000001b3ULL;
+  }
+  return h;
+}
+
+static
+uint64_t hash_shared_sub(global_e2_node_id_t const* id, byte_array_t key)
+{
+  uint64_t h = 0xcbf29ce484222325ULL;
+  h = hash_bytes(h, &id->type, sizeof(id->type));
+  h = hash_bytes(h, &id->plmn.mcc, sizeof(id->plmn.mcc));
+  h = hash_bytes(h, &id->plmn.mnc, sizeof(id->plmn.mnc));
+  h = hash_bytes(h, &id->nb_id.nb_id, sizeof(id->nb_id.nb_id));
+  if(id->cu_du_id != NULL)
+    h = hash_bytes(h, id->cu_du_id, sizeof(*id->cu_du_id));
+  return hash_bytes(h, key.buf, key.len);
+}
+
+// splitmix64 finalizer
+static
+uint64_t mix(uint64_t x)
+{
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ULL;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebULL;
+  x ^= x >> 31;
+  return x;
+}
+
+static
+cg_xapp_t* find_xapp(consumer_groups_t* cg, uint16_t xapp_id)
+{
+  for(size_t i = 0; i < seq_size(&cg->xapps); ++i){
+    cg_xapp_t* x = seq_at(&cg->xapps, i);
+    if(x->xapp_id == xapp_id)
+      return x;
+  }
+  return NULL;
+}
+
+static
+shared_sub_t* find_ric_req_id(consumer_groups_t* cg, uint32_t ric_req_id)
+{
+  for(size_t i = 0; i < seq_size(&cg->subs); ++i){
+    shared_sub_t* s = seq_at(&cg->subs, i);
+    if(s->ric_id.ric_req_id == ric_req_id && s->ric_id.ric_req_id != 0)
+      return s;
+  }
+  return NULL;
+}
+
+static
+cg_member_t* find_member(shared_sub_t* s, xapp_ric_id_t const* x)
+{
+  for(size_t i = 0; i < seq_size(&s->members); ++i){
+    cg_member_t* m = seq_at(&s->members, i);
+    if(eq_xapp_ric_gen_id(&m->x, x) == true)
+      return m;
+  }
+  return NULL;
+}
+
+static
+shared_sub_t* find_shared_sub(consumer_groups_t* cg, xapp_ric_id_t const* x, cg_member_t** m)
+{
+  for(size_t i = 0; i < seq_size(&cg->subs); ++i){
+    shared_sub_t* s = seq_at(&cg->subs, i);
+    *m = find_member(s, x);
+    if(*m != NULL)
+      return s;
+  }
+  return NULL;
+}
+
+static
+void erase_member(shared_sub_t* s, cg_member_t* m)
+{
+  seq_erase(&s->members, m, seq_next(&s->members, m));
+}
+
+static
+void erase_shared_sub(consumer_groups_t* cg, shared_sub_t* s)
+{
+  free_shared_sub(s);
+  seq_erase(&cg->subs, s, seq_next(&cg->subs, s));
+}
+
+void init_consumer_groups(consumer_groups_t* cg)
+{
+  assert(cg != NULL);
+
+  seq_init(&cg->xapps, sizeof(cg_xapp_t));
+  seq_init(&cg->subs, sizeof(shared_sub_t));
+
+  pthread_mutexattr_t const* attr = NULL;
+  int const rc = pthread_mutex_init(&cg->mtx, attr);
+  assert(rc == 0);
+}
+
+void free_consumer_groups(consumer_groups_t* cg)
+{
+  assert(cg != NULL);
+
+  seq_free(&cg->xapps, free_cg_xapp);
+  seq_free(&cg->subs, free_shared_sub);
+
+  int const rc = pthread_mutex_destroy(&cg->mtx);
+  assert(rc == 0);
+}
+
+void join_consumer_group(consumer_groups_t* cg, uint16_t xapp_id, byte_array_t group)
+{
+  assert(cg != NULL);
+  assert(xapp_id != CONSUMER_GROUP_XAPP_ID);
+  assert(group.len > 0 && group.buf != NULL);
+
+  lock_guard(&cg->mtx);
+
+  cg_xapp_t* x = find_xapp(cg, xapp_id);
+  if(x != NULL){
+    // Resumed session 
+    assert(eq_byte_array(&x->group, &group) == true && "An xApp cannot change its group");
+    return;
+  }
+
+  cg_xapp_t new_x = {.xapp_id = xapp_id, .group = copy_byte_array(group)};
+  seq_push_back(&cg->xapps, &new_x, sizeof(new_x));
+}
+
+size_t num_subs_consumer_group(consumer_groups_t* cg, uint16_t xapp_id)
+{
+  assert(cg != NULL);
+
+  lock_guard(&cg->mtx);
+
+  cg_xapp_t* x = find_xapp(cg, xapp_id);
+  if(x == NULL)
+    return 0;
+
+  size_t n = 0;
+  for(size_t i = 0; i < seq_size(&cg->subs); ++i){
+    shared_sub_t* s = seq_at(&cg->subs, i);
+    if(eq_byte_array(&s->group, &x->group) == true)
+      n += 1;
+  }
+  return n;
+}
+
+static
+ric_subscription_response_t cp_resp(ric_subscription_response_t const* src, ric_gen_id_t ric_id)
+{
+  ric_subscription_response_t dst = cp_ric_subscription_respponse(src);
+  dst.ric_id = ric_id;
+  return dst;
+}
+
+cg_sub_ans_t sub_consumer_group(consumer_groups_t* cg, xapp_ric_id_t const* x, global_e2_node_id_t const* id, ric_subscription_request_t const* sr)
+{
+  assert(cg != NULL);
+  assert(x != NULL);
+  assert(id != NULL);
+  assert(sr != NULL);
+
+  lock_guard(&cg->mtx);
+
+  cg_sub_ans_t ans = {.type = NONE_SHARED_SUB};
+
+  cg_xapp_t const* xapp = find_xapp(cg, x->xapp_id);
+  if(xapp == NULL)
+    return ans;
+
+  byte_array_t key = gen_key(sr);
+
+  cg_member_t m = {.x = *x};
+  for(size_t i = 0; i < seq_size(&cg->subs); ++i){
+    shared_sub_t* s = seq_at(&cg->subs, i);
+    if(s->deleting == true 
+        || eq_byte_array(&s->group, &xapp->group) == false 
+        || eq_global_e2_node_id(&s->id, id) == false
+        || eq_byte_array(&s->key, &key) == false)
+      continue;
+
+    free_byte_array(key);
+    if(find_member(s, x) != NULL){
+      ans.type = DUP_SHARED_SUB;
+      return ans;
+    }
+
+    if(s->acked == true){
+      m.answered = true;
+      ans.type = JOINED_SHARED_SUB;
+      ans.resp = cp_resp(&s->resp, x->ric_id);
+    } else {
+      ans.type = PENDING_SHARED_SUB;
+    }
+    seq_push_back(&s->members, &m, sizeof(m));
+    return ans;
+  }
+
+  shared_sub_t s = {.group = copy_byte_array(xapp->group),
+                    .id = cp_global_e2_node_id(id),
+                    .key = key,
+                    .h = hash_shared_sub(id, key),
+                    .ric_id = x->ric_id};
+  // Set by the RIC
+  s.ric_id.ric_req_id = 0;
+  seq_init(&s.members, sizeof(cg_member_t));
+  seq_push_back(&s.members, &m, sizeof(m));
+  seq_push_back(&cg->subs, &s, sizeof(s));
+
+  ans.type = NEW_SHARED_SUB;
+  return ans;
+}
+
+void set_ric_req_id_consumer_group(consumer_groups_t* cg, xapp_ric_id_t const* x, uint32_t ric_req_id)
+{
+  assert(cg != NULL);
+  assert(x != NULL);
+  assert(ric_req_id != 0);
+
+  lock_guard(&cg->mtx);
+
+  cg_member_t* m = NULL;
+  shared_sub_t* s = find_shared_sub(cg, x, &m);
+  assert(s != NULL && "Shared subscription not found");
+  assert(s->ric_id.ric_req_id == 0 && "RIC Request ID already set");
+
+  s->ric_id.ric_req_id = ric_req_id;
+}
+
+seq_arr_t ack_consumer_group(consumer_groups_t* cg, ric_subscription_response_t const* resp)
+{
+  assert(cg != NULL);
+  assert(resp != NULL);
+
+  lock_guard(&cg->mtx);
+
+  seq_arr_t arr = {0};
+  seq_init(&arr, sizeof(xapp_ric_id_t));
+
+  shared_sub_t* s = find_ric_req_id(cg, resp->ric_id.ric_req_id);
+  assert(s != NULL && "Shared subscription not found");
+  assert(s->acked == false && "Subscription Response already received");
+
+  s->acked = true;
+  s->resp = cp_resp(resp, s->ric_id);
+
+  for(size_t i = 0; i < seq_size(&s->members); ++i){
+    cg_member_t* m = seq_at(&s->members, i);
+    assert(m->answered == false);
+    m->answered = true;
+    seq_push_back(&arr, &m->x, sizeof(xapp_ric_id_t));
+  }
+
+  return arr;
+}
+
+// Nobody was answered, as the subscription was never acked 
+static
+seq_arr_t erase_failed_shared_sub(consumer_groups_t* cg, shared_sub_t* s)
+{
+  assert(s->acked == false && "Subscription Response already received");
+
+  seq_arr_t arr = {0};
+  seq_init(&arr, sizeof(xapp_ric_id_t));
+
+  for(size_t i = 0; i < seq_size(&s->members); ++i){
+    cg_member_t* m = seq_at(&s->members, i);
+    assert(m->answered == false);
+    seq_push_back(&arr, &m->x, sizeof(xapp_ric_id_t));
+  }
+
+  erase_shared_sub(cg, s);
+  return arr;
+}
+
+seq_arr_t fail_consumer_group(consumer_groups_t* cg, uint32_t ric_req_id)
+{
+  assert(cg != NULL);
+
+  lock_guard(&cg->mtx);
+
+  // The last member may have left in between, and the shared subscription with it
+  shared_sub_t* s = find_ric_req_id(cg, ric_req_id);
+  if(s == NULL){
+    seq_arr_t arr = {0};
+    seq_init(&arr, sizeof(xapp_ric_id_t));
+    return arr;
+  }
+
+  return erase_failed_shared_sub(cg, s);
+}
+
+seq_arr_t abort_consumer_group(consumer_groups_t* cg, xapp_ric_id_t const* x)
+{
+  assert(cg != NULL);
+  assert(x != NULL);
+
+  lock_guard(&cg->mtx);
+
+  cg_member_t* m = NULL;
+  shared_sub_t* s = find_shared_sub(cg, x, &m);
+  assert(s != NULL && "Shared subscription not found");
+  assert(s->ric_id.ric_req_id == 0 && "RIC Request ID already set");
+
+  return erase_failed_shared_sub(cg, s);
+}
+
+bool route_consumer_group(consumer_groups_t* cg, uint32_t ric_req_id, byte_array_t ue, xapp_ric_id_t* dst)
+{
+  assert(cg != NULL);
+  assert(dst != NULL);
+
+  lock_guard(&cg->mtx);
+
+  shared_sub_t* s = find_ric_req_id(cg, ric_req_id);
+  if(s == NULL)
+    return false;
+
+  // Rendezvous hashing. The member with the highest score wins 
+  uint64_t const h = ue.len > 0 ? hash_bytes(s->h, ue.buf, ue.len) : s->h;
+  uint64_t best = 0;
+  cg_member_t* win = NULL;
+  for(size_t i = 0; i < seq_size(&s->members); ++i){
+    cg_member_t* m = seq_at(&s->members, i);
+    if(m->answered == false)
+      continue;
+
+    uint64_t const score = mix(h ^ mix(m->x.xapp_id));
+    if(win == NULL || score > best){
+      best = score;
+      win = m;
+    }
+  }
+
+  if(win == NULL)
+    return false;
+
+  *dst = win->x;
+  return true;
+}
+
+cg_unsub_ans_t unsub_consumer_group(consumer_groups_t* cg, xapp_ric_id_t const* x)
+{
+  assert(cg != NULL);
+  assert(x != NULL);
+
+  lock_guard(&cg->mtx);
+
+  cg_unsub_ans_t ans = {.type = NONE_UNSUB_SHARED_SUB};
+
+  cg_member_t* m = NULL;
+  shared_sub_t* s = find_shared_sub(cg, x, &m);
+  if(s == NULL)
+    return ans;
+
+  if(seq_size(&s->members) > 1){
+    erase_member(s, m);
+    ans.type = LEFT_UNSUB_SHARED_SUB;
+    return ans;
+  }
+
+  // The member stays until the Subscription Delete Response arrives
+  assert(s->deleting == false);
+  s->deleting = true;
+  ans.type = LAST_UNSUB_SHARED_SUB;
+  ans.shared = (xapp_ric_id_t){.ric_id = s->ric_id, .xapp_id = CONSUMER_GROUP_XAPP_ID};
+  return ans;
+}
+
+xapp_ric_id_xpct_t del_consumer_group(consumer_groups_t* cg, uint32_t ric_req_id)
+{
+  assert(cg != NULL);
+
+  lock_guard(&cg->mtx);
+
+  xapp_ric_id_xpct_t ans = {.has_value = false};
+
+  shared_sub_t* s = find_ric_req_id(cg, ric_req_id);
+  assert(s != NULL && "Shared subscription not found");
+  assert(s->deleting == true);
+  assert(seq_size(&s->members) < 2);
+
+  if(seq_size(&s->members) == 1){
+    cg_member_t* m = seq_front(&s->members);
+    ans.has_value = true;
+    ans.xapp_ric_id = m->x;
+  }
+
+  erase_shared_sub(cg, s);
+  return ans;
+}
+
+seq_arr_t leave_consumer_group(consumer_groups_t* cg, uint16_t xapp_id)
+{
+  assert(cg != NULL);
+
+  lock_guard(&cg->mtx);
+
+  seq_arr_t arr = {0};
+  seq_init(&arr, sizeof(e2_node_ric_id_t));
+
+  cg_xapp_t* x = find_xapp(cg, xapp_id);
+  if(x == NULL)
+    return arr;
+
+  free_cg_xapp(x);
+  seq_erase(&cg->xapps, x, seq_next(&cg->xapps, x));
+
+  size_t i = 0;
+  while(i < seq_size(&cg->subs)){
+    shared_sub_t* s = seq_at(&cg->subs, i);
+
+    size_t j = 0;
+    while(j < seq_size(&s->members)){
+      cg_member_t* m = seq_at(&s->members, j);
+      if(m->x.xapp_id == xapp_id)
+        erase_member(s, m);
+      else
+        j += 1;
+    }
+
+    if(seq_size(&s->members) > 0 || s->deleting == true){
+      i += 1;
+      continue;
+    }
+
+    // The forwarding happens right after sub_consumer_group() in the iApp thread
+    assert(s->ric_id.ric_req_id != 0 && "Shared subscription never forwarded");
+
+    // Kept until the Subscription Delete Response arrives
+    s->deleting = true;
+    e2_node_ric_id_t n = {.e2_node_id = cp_global_e2_node_id(&s->id),
+                          .ric_id = s->ric_id,
+                          .ric_req_type = SUBSCRIPTION_RIC_REQUEST_TYPE};
+    seq_push_back(&arr, &n, sizeof(n));
+    i += 1;
+  }
+
+  return arr;
+}
+
+size_t rm_e2_node_consumer_group(consumer_groups_t* cg, global_e2_node_id_t const* id)
+{
+  assert(cg != NULL);
+  assert(id != NULL);
+
+  lock_guard(&cg->mtx);
+
+  size_t n = 0;
+  size_t i = 0;
+  while(i < seq_size(&cg->subs)){
+    shared_sub_t* s = seq_at(&cg->subs, i);
+    if(eq_global_e2_node_id(&s->id, id) == false){
+      i += 1;
+      continue;
+    }
+    erase_shared_sub(cg, s);
+    n += 1;
+  }
+
+  return n;
+}
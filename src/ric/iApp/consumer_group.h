@@ -0,0 +1,163 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+
+#ifndef CONSUMER_GROUP_IAPP_H
+#define CONSUMER_GROUP_IAPP_H 
+
+#include "../../lib/e2ap/e2ap_global_node_id_wrapper.h"
+#include "../../lib/e2ap/ric_subscription_request_wrapper.h"
+#include "../../lib/e2ap/ric_subscription_response_wrapper.h"
+#include "../../util/alg_ds/ds/seq_container/seq_generic.h"
+#include "../../util/byte_array.h"
+
+#include "e2_node_ric_id.h"
+#include "xapp_ric_id.h"
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// xApps that join the same consumer group share one E2 subscription per 
+// (E2 Node, RAN Function, event trigger and actions). Each indication of
+// a shared subscription is delivered to one member, chosen by rendezvous
+// hashing of the E2 Node, the subscription key and the UE that the 
+// indication reports on, as told by the SM (sm_ric_t conflate.key, e.g.,
+// RC and KPM format 3). Thus, the UEs of one subscription spread over the
+// members, and every UE sticks to one member. The indications without a 
+// UE go to the member of the subscription. A membership change only moves
+// the UEs and subscriptions of the member that joined or left.
+
+// xApp ID of the shared subscriptions in map_ric_id
+#define CONSUMER_GROUP_XAPP_ID UINT16_MAX
+
+typedef struct{
+  xapp_ric_id_t x; // RIC Request ID as known by the member
+  bool answered; // Subscription Response forwarded
+} cg_member_t;
+
+typedef struct{
+  byte_array_t group;
+  global_e2_node_id_t id;
+  // RAN Function ID, event trigger and actions
+  byte_array_t key;
+  // Rendezvous hash of id and key
+  uint64_t h;
+
+  // RIC Request ID towards the E2 Node
+  ric_gen_id_t ric_id;
+
+  // Subscription Response from the E2 Node, valid once acked
+  bool acked;
+  ric_subscription_response_t resp;
+
+  // Subscription Delete Request forwarded. Nobody else joins it
+  bool deleting;
+
+  seq_arr_t members; // cg_member_t
+} shared_sub_t;
+
+typedef struct{
+  uint16_t xapp_id;
+  byte_array_t group;
+} cg_xapp_t;
+
+typedef struct{
+  seq_arr_t xapps; // cg_xapp_t
+  seq_arr_t subs; // shared_sub_t
+  pthread_mutex_t mtx;
+} consumer_groups_t;
+
+void init_consumer_groups(consumer_groups_t* cg);
+
+void free_consumer_groups(consumer_groups_t* cg);
+
+void join_consumer_group(consumer_groups_t* cg, uint16_t xapp_id, byte_array_t group);
+
+// Number of shared subscriptions of the xApp's group. Testing purposes
+size_t num_subs_consumer_group(consumer_groups_t* cg, uint16_t xapp_id);
+
+typedef enum{
+  // Not in a group. Plain subscription
+  NONE_SHARED_SUB,
+  // First member. Forward it and call set_ric_req_id_consumer_group()
+  NEW_SHARED_SUB,
+  // Answer the xApp with resp
+  JOINED_SHARED_SUB,
+  // Waiting for the E2 Node. Answered in ack_consumer_group()
+  PENDING_SHARED_SUB,
+  // The xApp already uses its RIC Request ID in the shared subscription. 
+  // Answer it with a failure
+  DUP_SHARED_SUB,
+} cg_sub_e;
+
+typedef struct{
+  cg_sub_e type;
+  ric_subscription_response_t resp; // Only valid for JOINED_SHARED_SUB. Owned by the caller
+} cg_sub_ans_t;
+
+cg_sub_ans_t sub_consumer_group(consumer_groups_t* cg, xapp_ric_id_t const* x, global_e2_node_id_t const* id, ric_subscription_request_t const* sr);
+
+// RIC Request ID assigned by the RIC to a NEW_SHARED_SUB 
+void set_ric_req_id_consumer_group(consumer_groups_t* cg, xapp_ric_id_t const* x, uint32_t ric_req_id);
+
+// Subscription Response rx. Returns the members waiting for it (xapp_ric_id_t) 
+seq_arr_t ack_consumer_group(consumer_groups_t* cg, ric_subscription_response_t const* resp);
+
+// Subscription Failure rx. Removes the shared subscription and returns 
+// the members waiting for it (xapp_ric_id_t) 
+seq_arr_t fail_consumer_group(consumer_groups_t* cg, uint32_t ric_req_id);
+
+// The RIC could not forward the NEW_SHARED_SUB of x, e.g., RIC Request IDs 
+// exhausted. Removes the shared subscription and returns its members (xapp_ric_id_t) 
+seq_arr_t abort_consumer_group(consumer_groups_t* cg, xapp_ric_id_t const* x);
+
+// Member that receives an indication of the shared subscription. ue is 
+// empty if the indication does not report on one UE
+bool route_consumer_group(consumer_groups_t* cg, uint32_t ric_req_id, byte_array_t ue, xapp_ric_id_t* dst);
+
+typedef enum{
+  NONE_UNSUB_SHARED_SUB,
+  // Other members remain. Answer the xApp directly
+  LEFT_UNSUB_SHARED_SUB,
+  // Last member. Forward the delete of the shared subscription
+  LAST_UNSUB_SHARED_SUB,
+} cg_unsub_e;
+
+typedef struct{
+  cg_unsub_e type;
+  xapp_ric_id_t shared; // Only valid for LAST_UNSUB_SHARED_SUB
+} cg_unsub_ans_t;
+
+cg_unsub_ans_t unsub_consumer_group(consumer_groups_t* cg, xapp_ric_id_t const* x);
+
+// Subscription Delete Response rx. Removes the shared subscription and
+// returns the member that asked for it, if still there 
+xapp_ric_id_xpct_t del_consumer_group(consumer_groups_t* cg, uint32_t ric_req_id);
+
+// The xApp left. Returns the shared subscriptions without members, 
+// to be deleted at the E2 Nodes (e2_node_ric_id_t) 
+seq_arr_t leave_consumer_group(consumer_groups_t* cg, uint16_t xapp_id);
+
+// The E2 Node left. Returns the number of shared subscriptions removed
+size_t rm_e2_node_consumer_group(consumer_groups_t* cg, global_e2_node_id_t const* id);
+
+#endif
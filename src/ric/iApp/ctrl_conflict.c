@@ -0,0 +1,312 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+
+
+#include "ctrl_conflict.h"
+#include "../../util/alg_ds/ds/lock_guard/lock_guard.h"
+#include "../../util/conf_file.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct{
+  global_e2_node_id_t id;
+  uint16_t ran_func_id;
+  byte_array_t target;
+  byte_array_t param;
+  byte_array_t val;
+
+  uint16_t xapp_id;
+  int32_t prio;
+  int64_t tstamp;
+} ctrl_record_t;
+
+static
+void free_ctrl_record(void* it)
+{
+  assert(it != NULL);
+  ctrl_record_t* r = (ctrl_record_t*)it;
+  free_global_e2_node_id(&r->id);
+  free_byte_array(r->target);
+  free_byte_array(r->param);
+  free_byte_array(r->val);
+}
+
+void free_sm_ctrl_targets(size_t len, sm_ctrl_target_t* t)
+{
+  assert(len == 0 || t != NULL);
+  for(size_t i = 0; i < len; ++i){
+    free_byte_array(t[i].target);
+    free_byte_array(t[i].param);
+    free_byte_array(t[i].val);
+  }
+  free(t);
+}
+
+static
+bool parse_policy(char const* s, ctrl_conflict_policy_e* dst)
+{
+  if(strcmp(s, "log") == 0)
+    *dst = LOG_CTRL_CONFLICT_POLICY;
+  else if(strcmp(s, "first") == 0)
+    *dst = FIRST_WINS_CTRL_CONFLICT_POLICY;
+  else if(strcmp(s, "priority") == 0)
+    *dst = PRIORITY_CTRL_CONFLICT_POLICY;
+  else
+    return false;
+  return true;
+}
+
+static
+bool parse_prio(char* s, ctrl_conflicts_t* c)
+{
+  char* save = NULL;
+  for(char* it = strtok_r(s, ",", &save); it != NULL; it = strtok_r(NULL, ",", &save)){
+    char* colon = strrchr(it, ':');
+    if(colon == NULL || colon == it || colon[1] == '\0')
+      return false;
+    *colon = '\0';
+
+    char* end = NULL;
+    long const prio = strtol(colon + 1, &end, 10);
+    if(*end != '\0')
+      return false;
+
+    c->prio = realloc(c->prio, (c->len_prio + 1)*sizeof(ctrl_prio_t));
+    assert(c->prio != NULL && "Memory exhausted");
+    c->prio[c->len_prio] = (ctrl_prio_t){.identity = cp_str_to_ba(it), .prio = prio};
+    c->len_prio += 1;
+  }
+  return c->len_prio > 0;
+}
+
+static
+bool parse_opt(char* key, char* val, void* data)
+{
+  ctrl_conflicts_t* c = (ctrl_conflicts_t*)data;
+
+  if(strcmp(key, "win") == 0){
+    long long ms = 0;
+    bool const ok = parse_num_conf(val, 1, INT32_MAX, &ms);
+    c->window_us = ms*1000;
+    return ok;
+  }
+
+  if(strcmp(key, "prio") == 0 && c->len_prio == 0)
+    return parse_prio(val, c);
+
+  return false;
+}
+
+// The policy and then the options, e.g., priority;win=500;prio=mobility:10
+static
+bool parse_conf(char const* conf, ctrl_conflicts_t* c)
+{
+  size_t const len = strcspn(conf, ";");
+  char policy[16] = {0};
+  if(len >= sizeof(policy))
+    return false;
+  memcpy(policy, conf, len);
+
+  if(parse_policy(policy, &c->policy) == false)
+    return false;
+
+  char const* opt = conf[len] == ';' ? conf + len + 1 : conf + len;
+  return parse_kv_conf(strlen(opt), opt, parse_opt, c);
+}
+
+void init_ctrl_conflicts(ctrl_conflicts_t* c, char const* conf, char const* audit)
+{
+  assert(c != NULL);
+
+  c->enabled = conf != NULL;
+  c->policy = LOG_CTRL_CONFLICT_POLICY;
+  c->window_us = CTRL_CONFLICT_WINDOW_MS*1000;
+  c->len_prio = 0;
+  c->prio = NULL;
+  c->audit = stdout;
+
+  if(conf != NULL && parse_conf(conf, c) == false){
+    printf("[iApp]: Malformed CTRL_CONFLICT = %s\n", conf);
+    assert(0 != 0 && "Malformed CTRL_CONFLICT");
+  }
+
+  if(audit != NULL){
+    c->audit = fopen(audit, "a");
+    assert(c->audit != NULL && "Could not open CTRL_AUDIT_LOG");
+  }
+
+  seq_init(&c->rec, sizeof(ctrl_record_t));
+
+  pthread_mutexattr_t attr = {0};
+  int rc = pthread_mutex_init(&c->mtx, &attr);
+  assert(rc == 0);
+
+  if(c->enabled)
+    printf("[iApp]: Control conflicts policy %d window %ld ms\n", c->policy, c->window_us/1000);
+}
+
+void free_ctrl_conflicts(ctrl_conflicts_t* c)
+{
+  assert(c != NULL);
+
+  for(size_t i = 0; i < c->len_prio; ++i)
+    free_byte_array(c->prio[i].identity);
+  free(c->prio);
+
+  seq_free(&c->rec, free_ctrl_record);
+
+  if(c->audit != stdout)
+    fclose(c->audit);
+
+  int rc = pthread_mutex_destroy(&c->mtx);
+  assert(rc == 0);
+}
+
+static
+int32_t find_prio(ctrl_conflicts_t const* c, byte_array_t identity)
+{
+  for(size_t i = 0; i < c->len_prio; ++i){
+    if(eq_byte_array(&c->prio[i].identity, &identity))
+      return c->prio[i].prio;
+  }
+  return 0;
+}
+
+static
+void expire(ctrl_conflicts_t* c, int64_t now)
+{
+  size_t i = 0;
+  while(i < seq_size(&c->rec)){
+    ctrl_record_t* r = seq_at(&c->rec, i);
+    if(r->tstamp + c->window_us > now){
+      ++i;
+      continue;
+    }
+    free_ctrl_record(r);
+    seq_erase(&c->rec, r, seq_next(&c->rec, r));
+  }
+}
+
+static
+ctrl_record_t* find_record(ctrl_conflicts_t* c, global_e2_node_id_t const* id, uint16_t ran_func_id, sm_ctrl_target_t const* t)
+{
+  size_t const sz = seq_size(&c->rec);
+  for(size_t i = 0; i < sz; ++i){
+    ctrl_record_t* r = seq_at(&c->rec, i);
+    if(r->ran_func_id == ran_func_id 
+        && eq_byte_array(&r->target, &t->target) 
+        && eq_byte_array(&r->param, &t->param)
+        && eq_global_e2_node_id(&r->id, id))
+      return r;
+  }
+  return NULL;
+}
+
+static
+void audit(ctrl_conflicts_t* c, int64_t now, char const* decision, ctrl_record_t const* old, uint16_t xapp_id, sm_ctrl_target_t const* t)
+{
+  fprintf(c->audit, "%ld %s RAN_FUNC_ID %u nb_id %u target %.*s param %.*s xApp %u vs xApp %u (%ld us ago)\n", 
+          now, decision, old->ran_func_id, old->id.nb_id.nb_id, 
+          (int)t->target.len, (char const*)t->target.buf, (int)t->param.len, (char const*)t->param.buf,
+          xapp_id, old->xapp_id, now - old->tstamp);
+  fflush(c->audit);
+}
+
+bool check_ctrl_conflict(ctrl_conflicts_t* c, int64_t now, 
+                         global_e2_node_id_t const* id, uint16_t ran_func_id, 
+                         uint16_t xapp_id, byte_array_t identity, 
+                         size_t len, sm_ctrl_target_t const t[len])
+{
+  assert(c != NULL);
+  assert(id != NULL);
+  assert(len == 0 || t != NULL);
+
+  if(c->enabled == false)
+    return true;
+
+  lock_guard(&c->mtx);
+
+  expire(c, now);
+
+  int32_t const prio = find_prio(c, identity);
+
+  // The control is accepted or rejected as a whole
+  bool accept = true;
+  for(size_t i = 0; i < len; ++i){
+    ctrl_record_t const* r = find_record(c, id, ran_func_id, &t[i]);
+    if(r == NULL || r->xapp_id == xapp_id || eq_byte_array(&r->val, &t[i].val))
+      continue;
+
+    if(c->policy == LOG_CTRL_CONFLICT_POLICY){
+      audit(c, now, "CONFLICT", r, xapp_id, &t[i]);
+    } else if(c->policy == PRIORITY_CTRL_CONFLICT_POLICY && prio > r->prio){
+      audit(c, now, "PREEMPTED", r, xapp_id, &t[i]);
+    } else {
+      audit(c, now, "REJECTED", r, xapp_id, &t[i]);
+      accept = false;
+    }
+  }
+
+  if(accept == false)
+    return false;
+
+  for(size_t i = 0; i < len; ++i){
+    ctrl_record_t* r = find_record(c, id, ran_func_id, &t[i]);
+    if(r != NULL){
+      free_byte_array(r->val);
+    } else {
+      ctrl_record_t n = {.id = cp_global_e2_node_id(id),
+                         .ran_func_id = ran_func_id,
+                         .target = copy_byte_array(t[i].target),
+                         .param = copy_byte_array(t[i].param)};
+      seq_push_back(&c->rec, &n, sizeof(ctrl_record_t));
+      r = seq_at(&c->rec, seq_size(&c->rec) - 1);
+    }
+    r->val = copy_byte_array(t[i].val);
+    r->xapp_id = xapp_id;
+    r->prio = prio;
+    r->tstamp = now;
+  }
+
+  return true;
+}
+
+void rm_e2_node_ctrl_conflicts(ctrl_conflicts_t* c, global_e2_node_id_t const* id)
+{
+  assert(c != NULL);
+  assert(id != NULL);
+
+  lock_guard(&c->mtx);
+
+  size_t i = 0;
+  while(i < seq_size(&c->rec)){
+    ctrl_record_t* r = seq_at(&c->rec, i);
+    if(eq_global_e2_node_id(&r->id, id) == false){
+      ++i;
+      continue;
+    }
+    free_ctrl_record(r);
+    seq_erase(&c->rec, r, seq_next(&c->rec, r));
+  }
+}
@@ -0,0 +1,97 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+
+
+
+#ifndef CONTROL_CONFLICT_IAPP_H
+#define CONTROL_CONFLICT_IAPP_H
+
+// Conflicting controls from different xApps, e.g., two xApps setting the same
+// RAN Parameter of the same UE to different values within a short time.
+// Configured through the RIC configuration file:
+//  CTRL_CONFLICT = priority;win=500;prio=mobility:10,energy:5
+//  CTRL_AUDIT_LOG = /tmp/ctrl_audit.log
+// Policies:
+//  log       Forward the control and record the conflict 
+//  first     Reject the control. The first xApp keeps the target for the window
+//  priority  The xApp with the higher priority wins. Ties are solved as first
+// Priorities are assigned to the xApp identities, i.e., XAPP_TOKEN. Default 0
+
+#include "../../lib/e2ap/e2ap_global_node_id_wrapper.h"
+#include "../../sm/sm_ric.h"
+#include "../../util/alg_ds/ds/seq_container/seq_generic.h"
+#include "../../util/byte_array.h"
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define CTRL_CONFLICT_WINDOW_MS 1000
+
+typedef enum{
+  LOG_CTRL_CONFLICT_POLICY,
+  FIRST_WINS_CTRL_CONFLICT_POLICY,
+  PRIORITY_CTRL_CONFLICT_POLICY,
+
+  END_CTRL_CONFLICT_POLICY
+} ctrl_conflict_policy_e;
+
+typedef struct{
+  byte_array_t identity;
+  int32_t prio;
+} ctrl_prio_t;
+
+typedef struct{
+  // Disabled without CTRL_CONFLICT 
+  bool enabled;
+  ctrl_conflict_policy_e policy;
+  int64_t window_us;
+
+  size_t len_prio;
+  ctrl_prio_t* prio;
+
+  // ctrl_record_t. Last control per (E2 Node, RAN Function, target, parameter) within the window
+  seq_arr_t rec;
+
+  // Decisions on conflicting controls. stdout without CTRL_AUDIT_LOG
+  FILE* audit;
+
+  pthread_mutex_t mtx;
+} ctrl_conflicts_t;
+
+// conf and audit may be NULL. Asserts if conf is malformed
+void init_ctrl_conflicts(ctrl_conflicts_t* c, char const* conf, char const* audit);
+
+void free_ctrl_conflicts(ctrl_conflicts_t* c);
+
+// Returns false if the control must be rejected. identity may be empty
+bool check_ctrl_conflict(ctrl_conflicts_t* c, int64_t now, 
+                         global_e2_node_id_t const* id, uint16_t ran_func_id, 
+                         uint16_t xapp_id, byte_array_t identity, 
+                         size_t len, sm_ctrl_target_t const t[len]);
+
+void rm_e2_node_ctrl_conflicts(ctrl_conflicts_t* c, global_e2_node_id_t const* id);
+
+void free_sm_ctrl_targets(size_t len, sm_ctrl_target_t* t);
+
+#endif
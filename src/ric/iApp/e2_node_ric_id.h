@@ -28,6 +28,8 @@
 typedef enum{
   SUBSCRIPTION_RIC_REQUEST_TYPE,
   CONTROL_RIC_REQUEST_TYPE,
+  // Error-only control (NAck). Nothing comes back on success
+  NACK_CONTROL_RIC_REQUEST_TYPE,
 
   END_RIC_REQUEST_TYPE,
 } ric_request_type_e;
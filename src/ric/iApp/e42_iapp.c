@@ -17,11 +17,31 @@
 #include "../../util/time_now_us.h"
 
 #include <stdio.h>
+#include <arpa/inet.h>
 #include <pthread.h>
 
-e42_iapp_t* init_e42_iapp(const char* addr, near_ric_if_t ric_if)
+static
+void send_ind_overload_iapp(void* ctx, uint16_t xapp_id, byte_array_t ba)
+{
+  assert(ctx != NULL);
+  e42_iapp_t* iapp = (e42_iapp_t*)ctx;
+
+  // The endpoint is closed, or the xApp left in between
+  if(iapp->stop_token == true || lost_ind_xapp_session(&iapp->sessions, xapp_id) == true)
+    return;
+
+  // Resumed, but its association is registered after the E42 SETUP-RESPONSE
+  sctp_msg_t sctp_msg = {0};
+  if(try_find_map_xapps_sad(&iapp->ep.xapps, xapp_id, &sctp_msg.info) == false)
+    return;
+  sctp_msg.ba = ba;
+  e2ap_send_sctp_msg_iapp(&iapp->ep, &sctp_msg);
+}
+
+e42_iapp_t* init_e42_iapp(const char* addr, near_ric_if_t ric_if, fr_args_t const* args)
 {
   assert(addr != NULL);
+  assert(args != NULL);
 //  assert(ric != NULL);
 
   printf("[iApp]: Initializing ... \n");
@@ -59,9 +79,31 @@ e42_iapp_t* init_e42_iapp(const char* addr, near_ric_if_t ric_if)
 
   init_map_ric_id(&iapp->map_ric_id);
 
+  // Replicated towards the standby nearRT-RIC
+  map_ric_id_obs_t obs = {0};
+  if(obs_map_ric_id_near_ric_gen(ric_if.type, &obs) == true)
+    set_obs_map_ric_id(&iapp->map_ric_id, obs);
 
   iapp->xapp_id = 7;
 
+  init_xapp_sessions(&iapp->sessions);
+
+  init_consumer_groups(&iapp->groups);
+
+  init_ind_filters(&iapp->filters);
+
+  init_ind_overloads(&iapp->overloads, send_ind_overload_iapp, iapp);
+
+  char* conflict = get_conf_ctrl_conflict(args);
+  char* audit = get_conf_ctrl_audit_log(args);
+  init_ctrl_conflicts(&iapp->conflicts, conflict, audit);
+  free(conflict);
+  free(audit);
+
+  char* deadline = get_conf_msg_deadline(args);
+  init_msg_deadlines(&iapp->deadlines, deadline);
+  free(deadline);
+
   iapp->stop_token = false;
   iapp->stopped = false;
 
@@ -77,15 +119,6 @@ bool net_pkt(const e42_iapp_t* iapp, int fd)
   return fd == iapp->ep.base.fd;
 }
 
-static
-void consume_fd(int fd)
-{
-  assert(fd > 0);
-  uint64_t read_buf = 0;
-  ssize_t const bytes = read(fd,&read_buf, sizeof(read_buf));
-  assert(bytes == sizeof(read_buf));
-}
-
 static inline
 bool pend_event(e42_iapp_t* iapp, int fd, pending_event_t** p_ev)
 {
@@ -162,11 +195,43 @@ void gen_e2ap_subs_delete(void const* it, void const* data)
 
   ric_subscription_delete_request_t dst = {.ric_id = n->ric_id}; 
 
-  fwd_ric_subscription_request_delete_gen(iapp->ric_if.type, &n->e2_node_id, &dst, notify_msg_iapp_api);
+  fwd_ric_subscription_request_delete_gen(iapp->ric_if.type, &n->e2_node_id, &dst, NULL, notify_msg_iapp_api);
 }
 
-static
-void rm_if_pending_subs(e42_iapp_t* iapp, uint16_t xapp_id)
+void restore_iapp(e42_iapp_t* iapp, repl_state_t const* s)
+{
+  assert(iapp != NULL);
+  assert(s != NULL);
+
+  int64_t const now = time_now_us();
+  seq_arr_t const* xapps = &s->xapps;
+  for(void* it = seq_front((seq_arr_t*)xapps); it != seq_end((seq_arr_t*)xapps); it = seq_next((seq_arr_t*)xapps, it)){
+    repl_xapp_t const* x = (repl_xapp_t const*)it;
+    xapp_session_ans_t const ans = attach_xapp_session(&iapp->sessions, x->token, x->xapp_id);
+    assert(ans.type == NEW_XAPP_SESSION && ans.xapp_id == x->xapp_id);
+    // Until the xApp sets up again, or XAPP_SESSION_GRACE_MS elapse 
+    detach_xapp_session(&iapp->sessions, x->xapp_id, now);
+  }
+
+  if(s->next_xapp_id > iapp->xapp_id)
+    iapp->xapp_id = s->next_xapp_id;
+
+  int rc = pthread_rwlock_wrlock(&iapp->map_ric_id.rw);
+  assert(rc == 0);
+
+  seq_arr_t const* subs = &s->subs;
+  for(void* it = seq_front((seq_arr_t*)subs); it != seq_end((seq_arr_t*)subs); it = seq_next((seq_arr_t*)subs, it)){
+    map_ric_id_entry_t const* e = (map_ric_id_entry_t const*)it;
+    e2_node_ric_id_t n = cp_e2_node_ric_id(&e->node);
+    xapp_ric_id_t x = e->xapp;
+    add_map_ric_id(&iapp->map_ric_id, &n, &x);
+  }
+
+  rc = pthread_rwlock_unlock(&iapp->map_ric_id.rw);
+  assert(rc == 0);
+}
+
+void rm_pending_subs_iapp(e42_iapp_t* iapp, uint16_t xapp_id)
 {
   assert(iapp != NULL);
 
@@ -182,15 +247,56 @@ void rm_if_pending_subs(e42_iapp_t* iapp, uint16_t xapp_id)
   void* l = seq_end(&arr);
   void* data = iapp;
   for_each_arr(&arr, f, l, gen_e2ap_subs_delete, data);
+
+  // Shared subscriptions left without members 
+  seq_arr_t shared = leave_consumer_group(&iapp->groups, xapp_id);
+  defer({ seq_arr_free(&shared, free_e2_node_ric_id_wrapper); } );
+
+  if(seq_size(&shared) > 0){
+    printf("[NEAR-RIC]: Automatically removing %lu shared subscription(s)\n", seq_size(&shared));
+  }
+
+  f = seq_front(&shared);
+  l = seq_end(&shared);
+  for_each_arr(&shared, f, l, gen_e2ap_subs_delete, data);
+}
+
+static
+void expire_sessions(e42_iapp_t* iapp)
+{
+  assert(iapp != NULL);
+
+  uint16_t xapp_id[32] = {0};
+  size_t const len = sizeof(xapp_id)/sizeof(xapp_id[0]);
+  int64_t const grace_us = XAPP_SESSION_GRACE_MS*1000;
+
+  size_t n = 0;
+  do{
+    n = expire_xapp_session(&iapp->sessions, time_now_us(), grace_us, len, xapp_id); 
+    for(size_t i = 0; i < n; ++i){
+      printf("[NEAR-RIC]: xApp %d did not come back\n", xapp_id[i]);
+      rm_pending_subs_iapp(iapp, xapp_id[i]);
+      rm_xapp_near_ric_gen(iapp->ric_if.type, xapp_id[i]);
+    }
+  } while(n == len);
 }
 
 static
 void e2_event_loop_iapp(e42_iapp_t* iapp)
 {
   assert(iapp != NULL);
+  int64_t last_expire = time_now_us();
   while(iapp->stop_token == false){ 
 
     async_event_t e = next_async_event_iapp(iapp); 
+    int64_t const rcv = time_now_us();
+
+    // Not more than once per second
+    int64_t const now = rcv;
+    if(now - last_expire > 1000000){
+      expire_sessions(iapp);
+      last_expire = now;
+    }
     assert(e.type != UNKNOWN_EVENT && "Unknown event triggered ");
 
     switch(e.type){
@@ -201,9 +307,18 @@ void e2_event_loop_iapp(e42_iapp_t* iapp)
           e2ap_msg_t msg = e2ap_msg_dec_iapp(&iapp->ap, e.msg.ba);
           defer( { e2ap_msg_free_iapp(&iapp->ap, &msg);} );
 
+          // Undecodable or of an unsupported procedure, e.g., of another E2AP version
+          if(msg.type == NONE_E2_MSG_TYPE){
+            printf("[iApp]: Undecodable or unsupported E2AP PDU from an xApp discarded\n");
+            break;
+          }
+
           e2ap_msg_t ans = e2ap_msg_handle_iapp(iapp, &msg);
           defer( { e2ap_msg_free_iapp(&iapp->ap, &ans);} );
 
+          // The iApp handles the xApp messages one at a time, so only flag the late ones
+          check_msg_deadline(&iapp->deadlines, e2ap_msg_class(msg.type), rcv, time_now_us());
+
           if(ans.type == E42_SETUP_RESPONSE){
             const uint16_t xapp_id = ans.u_msgs.e42_stp_resp.xapp_id;
             e2ap_reg_sock_addr_iapp(&iapp->ep, xapp_id, &e.msg.info);;
@@ -231,15 +346,22 @@ void e2_event_loop_iapp(e42_iapp_t* iapp)
       case PENDING_EVENT:
         {
           printf("[nearRT-RIC] Pending event timeout happened. Communication lost?\n");
-          consume_fd(e.fd);
+          consume_timer_asio_iapp(&iapp->io, e.fd);
           break;
         }
       case SCTP_CONNECTION_SHUTDOWN_EVENT: 
         {
           defer({free_sctp_msg(&e.msg);});
-          uint16_t const xapp_id = find_map_xapps_xid(&iapp->ep.xapps, &e.msg.info);
+          uint16_t xapp_id = 0;
+          if(try_find_map_xapps_xid(&iapp->ep.xapps, &e.msg.info, &xapp_id) == false){
+            printf("[NEAR-RIC]: xApp without E42 SETUP-RESPONSE disconnected\n");
+            break;
+          }
           printf("[NEAR-RIC]: xApp %d disconnected!\n", xapp_id);
-          rm_if_pending_subs(iapp, xapp_id);
+          if(detach_xapp_session(&iapp->sessions, xapp_id, time_now_us()) == true)
+            printf("[NEAR-RIC]: Keeping the subscriptions of xApp %d for %d ms\n", xapp_id, XAPP_SESSION_GRACE_MS);
+          else
+            rm_pending_subs_iapp(iapp, xapp_id);
           break;
         }
       case CHECK_STOP_TOKEN_EVENT:
@@ -287,7 +409,7 @@ void free_e42_iapp(e42_iapp_t* iapp)
 
   iapp->stop_token = true;
   while(iapp->stopped == false){
-    sleep(1);
+    usleep(1000);
   }
 
   // Emulator
@@ -297,6 +419,18 @@ void free_e42_iapp(e42_iapp_t* iapp)
 
   free_map_ric_id(&iapp->map_ric_id);
 
+  free_xapp_sessions(&iapp->sessions);
+
+  free_consumer_groups(&iapp->groups);
+
+  free_ind_filters(&iapp->filters);
+
+  free_ind_overloads(&iapp->overloads);
+
+  free_ctrl_conflicts(&iapp->conflicts);
+
+  print_msg_deadlines(&iapp->deadlines, "iApp", stdout);
+
   free(iapp);
 }
 
@@ -309,6 +443,10 @@ void add_e2_node_iapp_v1(e42_iapp_t* i, global_e2_node_id_t* id, size_t len, ran
   assert(len > 0);
   assert(ran_func != NULL);
 
+  // Restored from the replica of a standby, and now set up again 
+  if(present_reg_e2_node(&i->e2_nodes, id) == true)
+    rm_reg_e2_node(&i->e2_nodes, id);
+
   add_reg_e2_node_v1(&i->e2_nodes,id, len, ran_func);
 }
 #else
@@ -319,6 +457,10 @@ void add_e2_node_iapp(e42_iapp_t* i, global_e2_node_id_t* id, size_t len, ran_fu
   assert(len > 0);
   assert(ran_func != NULL);
 
+  // Restored from the replica of a standby, and now set up again 
+  if(present_reg_e2_node(&i->e2_nodes, id) == true)
+    rm_reg_e2_node(&i->e2_nodes, id);
+
   add_reg_e2_node(&i->e2_nodes,id, len, ran_func, len_cca, cca);
 }
 #endif
@@ -329,6 +471,19 @@ void rm_e2_node_iapp(e42_iapp_t* i, global_e2_node_id_t* id)
   assert(id != NULL);
 
   rm_reg_e2_node(&i->e2_nodes,id);
+
+  // The RIC Request IDs of the E2 Node are released and can be reused
+  size_t const num_rm = rm_e2_node_map_ric_id(&i->map_ric_id, id);
+  if(num_rm > 0)
+    printf("[iApp]: Removed %lu request(s) towards the lost E2 Node\n", num_rm);
+
+  rm_e2_node_consumer_group(&i->groups, id);
+
+  rm_e2_node_ind_filters(&i->filters, id);
+
+  rm_e2_node_ind_overloads(&i->overloads, id);
+
+  rm_e2_node_ctrl_conflicts(&i->conflicts, id);
 }
 
 void notify_msg_iapp(e42_iapp_t* iapp, e2ap_msg_t const* msg)
@@ -337,8 +492,10 @@ void notify_msg_iapp(e42_iapp_t* iapp, e2ap_msg_t const* msg)
   assert(msg != NULL);
   assert(msg->type == RIC_INDICATION 
       || msg->type == RIC_SUBSCRIPTION_RESPONSE 
+      || msg->type == RIC_SUBSCRIPTION_FAILURE
       || msg->type == RIC_SUBSCRIPTION_DELETE_RESPONSE
-      || msg->type == RIC_CONTROL_ACKNOWLEDGE);
+      || msg->type == RIC_CONTROL_ACKNOWLEDGE
+      || msg->type == RIC_CONTROL_FAILURE);
 
 
   e2ap_msg_t ans = e2ap_msg_handle_iapp(iapp, msg);
@@ -347,3 +504,168 @@ void notify_msg_iapp(e42_iapp_t* iapp, e2ap_msg_t const* msg)
   assert(ans.type ==  NONE_E2_MSG_TYPE );
 }
 
+
+///////
+// Admin socket
+///////
+
+static
+char const* ric_req_type_str(ric_request_type_e t)
+{
+  if(t == SUBSCRIPTION_RIC_REQUEST_TYPE)
+    return "subscription";
+  if(t == CONTROL_RIC_REQUEST_TYPE)
+    return "control";
+  if(t == NACK_CONTROL_RIC_REQUEST_TYPE)
+    return "control-nack";
+  return "unknown";
+}
+
+static
+size_t num_subs_xapp(seq_arr_t* subs, uint16_t xapp_id)
+{
+  size_t n = 0;
+  for(size_t i = 0; i < seq_size(subs); ++i){
+    map_ric_id_entry_t const* e = seq_at(subs, i);
+    n += e->xapp.xapp_id == xapp_id && e->node.ric_req_type == SUBSCRIPTION_RIC_REQUEST_TYPE;
+  }
+  return n;
+}
+
+void print_xapps_iapp(e42_iapp_t* iapp, FILE* out)
+{
+  assert(iapp != NULL);
+  assert(out != NULL);
+
+  seq_arr_t xapps = all_map_xapps_sad(&iapp->ep.xapps);
+  defer({ seq_free(&xapps, NULL); } );
+  seq_arr_t subs = all_map_ric_id(&iapp->map_ric_id);
+  defer({ seq_free(&subs, free_map_ric_id_entry_wrapper); } );
+
+  for(size_t i = 0; i < seq_size(&xapps); ++i){
+    xapp_sad_t const* x = seq_at(&xapps, i);
+    char ip[INET_ADDRSTRLEN] = {0};
+    inet_ntop(AF_INET, &x->info.addr.sin_addr, ip, sizeof(ip));
+
+    byte_array_t id = identity_xapp_session(&iapp->sessions, x->xapp_id);
+    fprintf(out, "xApp %u addr %s:%u assoc %d subscriptions %lu identity %.*s\n", x->xapp_id, ip, ntohs(x->info.addr.sin_port), 
+            x->info.sri.sinfo_assoc_id, num_subs_xapp(&subs, x->xapp_id), (int)id.len, id.len > 0 ? (char*)id.buf : "-");
+    free_byte_array(id);
+  }
+}
+
+void print_subs_iapp(e42_iapp_t* iapp, FILE* out)
+{
+  assert(iapp != NULL);
+  assert(out != NULL);
+
+  seq_arr_t subs = all_map_ric_id(&iapp->map_ric_id);
+  defer({ seq_free(&subs, free_map_ric_id_entry_wrapper); } );
+
+  for(size_t i = 0; i < seq_size(&subs); ++i){
+    map_ric_id_entry_t const* e = seq_at(&subs, i);
+    global_e2_node_id_t const* n = &e->node.e2_node_id;
+
+    fprintf(out, "RIC_REQ_ID %u %s RAN_FUNC_ID %u E2 Node %s mcc %d mnc %d nb_id %u", e->node.ric_id.ric_req_id, 
+            ric_req_type_str(e->node.ric_req_type), e->node.ric_id.ran_func_id, get_ngran_name(n->type), n->plmn.mcc, n->plmn.mnc, n->nb_id.nb_id);
+    if(n->cu_du_id != NULL)
+      fprintf(out, " cu_du_id %lu", *n->cu_du_id);
+
+    if(e->xapp.xapp_id == CONSUMER_GROUP_XAPP_ID)
+      fprintf(out, " -> consumer group");
+    else
+      fprintf(out, " -> xApp %u RIC_REQ_ID %u", e->xapp.xapp_id, e->xapp.ric_id.ric_req_id);
+
+    ind_overload_stats_t st = {0};
+    if(stats_ind_overload(&iapp->overloads, e->node.ric_id.ric_req_id, &st) == true)
+      fprintf(out, " ind in %lu out %lu dropped %lu conflated %lu thinned %lu queued %lu", 
+              st.ind_in, st.ind_out, st.dropped, st.conflated, st.thinned, st.queued);
+    fprintf(out, "\n");
+  }
+}
+
+void print_metrics_iapp(e42_iapp_t* iapp, FILE* out)
+{
+  assert(iapp != NULL);
+  assert(out != NULL);
+
+  seq_arr_t xapps = all_map_xapps_sad(&iapp->ep.xapps);
+  size_t const num_xapps = seq_size(&xapps);
+  seq_free(&xapps, NULL);
+
+  size_t num[END_RIC_REQUEST_TYPE] = {0};
+  seq_arr_t subs = all_map_ric_id(&iapp->map_ric_id);
+  defer({ seq_free(&subs, free_map_ric_id_entry_wrapper); } );
+  for(size_t i = 0; i < seq_size(&subs); ++i){
+    map_ric_id_entry_t const* e = seq_at(&subs, i);
+    assert(e->node.ric_req_type < END_RIC_REQUEST_TYPE);
+    num[e->node.ric_req_type] += 1;
+  }
+
+  fprintf(out, "[iApp]: xApps %lu\n", num_xapps);
+  for(int i = 0; i < END_RIC_REQUEST_TYPE; ++i)
+    fprintf(out, "[iApp]: %s requests %lu\n", ric_req_type_str(i), num[i]);
+  print_msg_deadlines(&iapp->deadlines, "iApp", out);
+}
+
+bool rm_sub_iapp(e42_iapp_t* iapp, uint32_t ric_req_id)
+{
+  assert(iapp != NULL);
+
+  if(ric_req_id == 0)
+    return false;
+
+  seq_arr_t subs = all_map_ric_id(&iapp->map_ric_id);
+  defer({ seq_free(&subs, free_map_ric_id_entry_wrapper); } );
+
+  map_ric_id_entry_t const* e = NULL;
+  for(size_t i = 0; i < seq_size(&subs) && e == NULL; ++i){
+    map_ric_id_entry_t const* it = seq_at(&subs, i);
+    if(it->node.ric_id.ric_req_id == ric_req_id && it->node.ric_req_type == SUBSCRIPTION_RIC_REQUEST_TYPE)
+      e = it;
+  }
+  if(e == NULL)
+    return false;
+
+  // Without the entry, the Delete Response is not forwarded to the xApp, 
+  // as it did not ask for it
+  ric_request_type_e type = END_RIC_REQUEST_TYPE;
+  xapp_ric_id_xpct_t const x = try_rm_map_ric_id(&iapp->map_ric_id, ric_req_id, &type);
+  if(x.has_value == false)
+    return false; // Deleted in between
+
+  if(x.xapp_ric_id.xapp_id == CONSUMER_GROUP_XAPP_ID)
+    del_consumer_group(&iapp->groups, ric_req_id);
+  rm_ind_filter(&iapp->filters, ric_req_id);
+  rm_ind_overload(&iapp->overloads, ric_req_id);
+
+  printf("[iApp]: Deleting RIC_REQ_ID %u of xApp %u through the admin socket\n", ric_req_id, x.xapp_ric_id.xapp_id);
+  gen_e2ap_subs_delete(&e->node, iapp);
+  return true;
+}
+
+bool rm_xapp_iapp(e42_iapp_t* iapp, uint16_t xapp_id)
+{
+  assert(iapp != NULL);
+
+  seq_arr_t xapps = all_map_xapps_sad(&iapp->ep.xapps);
+  defer({ seq_free(&xapps, NULL); } );
+
+  xapp_sad_t const* x = NULL;
+  for(size_t i = 0; i < seq_size(&xapps) && x == NULL; ++i){
+    xapp_sad_t const* it = seq_at(&xapps, i);
+    if(it->xapp_id == xapp_id)
+      x = it;
+  }
+  if(x == NULL)
+    return false;
+
+  printf("[iApp]: Removing xApp %u through the admin socket\n", xapp_id);
+
+  // First, so that the Delete Responses do not reach the xApp
+  e2ap_shutdown_sctp_assoc(&iapp->ep.base, &x->info);
+  rm_xapp_session(&iapp->sessions, xapp_id);
+  rm_pending_subs_iapp(iapp, xapp_id);
+  rm_xapp_near_ric_gen(iapp->ric_if.type, xapp_id);
+  return true;
+}
@@ -39,6 +39,12 @@
 #include "e2ap_iapp.h"
 #include "endpoint_iapp.h"
 #include "map_ric_id.h"
+#include "xapp_session.h"
+#include "consumer_group.h"
+#include "ind_filter.h"
+#include "ind_overload.h"
+#include "ctrl_conflict.h"
+#include "msg_deadline.h"
 
 #include <stdatomic.h>
 #include <stdbool.h>
@@ -56,6 +62,8 @@ static_assert(0!=0, "Unknown E2AP version");
 
 
 
+#define NACK_CTRL_WINDOW_IAPP 1024
+
 typedef struct e42_iapp_s e42_iapp_t;
 
 typedef e2ap_msg_t (*handle_msg_fp_iapp)(struct e42_iapp_s*, const e2ap_msg_t* msg) ;
@@ -71,18 +79,42 @@ typedef struct e42_iapp_s
   // Registered xApps
   uint32_t xapp_id;
 
+  // Sessions of the xApps that presented a token
+  xapp_sessions_t sessions;
+
+  // xApps sharing subscriptions
+  consumer_groups_t groups;
+
+  // Indication filters attached to the subscriptions
+  ind_filters_t filters;
+
+  // Queues and overload policies of the subscriptions of slow xApps
+  ind_overloads_t overloads;
+
+  // Conflicting controls from different xApps
+  ctrl_conflicts_t conflicts;
+
+  // Per class time from reception until the xApp message is handled 
+  msg_deadlines_t deadlines;
+
   // Registered E2 Nodes 
   reg_e2_nodes_t e2_nodes;
 
   map_ric_id_t map_ric_id;
 
+  // NAck (error-only) controls never hear back on success. Their RIC Request IDs
+  // are kept for the last NACK_CTRL_WINDOW_IAPP requests to route a late failure
+  uint32_t nack_ctrl[NACK_CTRL_WINDOW_IAPP];
+  size_t nack_ctrl_len;
+  size_t nack_ctrl_pos;
+
   near_ric_if_t ric_if;
 
   atomic_bool stop_token;
   atomic_bool stopped;
 } e42_iapp_t;
 
-e42_iapp_t* init_e42_iapp(const char* addr, near_ric_if_t ric_if); //, int port);
+e42_iapp_t* init_e42_iapp(const char* addr, near_ric_if_t ric_if, fr_args_t const* args); //, int port);
 
 // Blocking call
 void start_e42_iapp(e42_iapp_t* iapp);
@@ -99,6 +131,29 @@ void rm_e2_node_iapp(e42_iapp_t* i, global_e2_node_id_t* id);
 
 void notify_msg_iapp(e42_iapp_t* iapp, e2ap_msg_t const* msg);
 
+// Deletes the subscriptions of the xApp at the E2 Nodes
+void rm_pending_subs_iapp(e42_iapp_t* iapp, uint16_t xapp_id);
+
+// Standby nearRT-RIC taking over, before start_e42_iapp(). The sessions wait 
+// detached for their xApps, with their subscriptions, see repl_ric.h
+void restore_iapp(e42_iapp_t* iapp, repl_state_t const* s);
+
+// Admin socket of the nearRT-RIC, see admin_ric.h
+
+void print_xapps_iapp(e42_iapp_t* iapp, FILE* out);
+
+void print_subs_iapp(e42_iapp_t* iapp, FILE* out);
+
+void print_metrics_iapp(e42_iapp_t* iapp, FILE* out);
+
+// Deletes the subscription at the E2 Node. The xApp is not told, its indications 
+// just stop. False if ric_req_id (E2 side) is not a subscription
+bool rm_sub_iapp(e42_iapp_t* iapp, uint32_t ric_req_id);
+
+// Shuts down the association of the xApp, ends its session and deletes its 
+// subscriptions. False if unknown
+bool rm_xapp_iapp(e42_iapp_t* iapp, uint16_t xapp_id);
+
 #undef NUM_HANDLE_MSG
 
 #endif
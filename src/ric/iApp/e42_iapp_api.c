@@ -48,12 +48,17 @@ void* static_start_iapp(void* a)
   return NULL;
 }
 
-void init_iapp_api(const char* addr, near_ric_if_t ric_if)
+void init_iapp_api(const char* addr, near_ric_if_t ric_if, fr_args_t const* args)
 {
   assert(iapp == NULL);
 
-  iapp = init_e42_iapp(addr, ric_if);
+  iapp = init_e42_iapp(addr, ric_if, args);
   assert(iapp->io.efd < 1024);
+}
+
+void start_iapp_api(void)
+{
+  assert(iapp != NULL);
 
   // Spawn a new thread for the iapp
   const int rc = pthread_create(&thrd_iapp, NULL, static_start_iapp, NULL);
@@ -66,6 +71,15 @@ void stop_iapp_api(void)
   free_e42_iapp(iapp);
   int const rc = pthread_join(thrd_iapp,NULL);
   assert(rc == 0);
+  // A later nearRT-RIC in the process, e.g., a standby that took over
+  iapp = NULL;
+}
+
+void restore_iapp_api(repl_state_t const* s)
+{
+  assert(iapp != NULL);
+  assert(s != NULL);
+  restore_iapp(iapp, s);
 }
 
 
@@ -101,3 +115,33 @@ void notify_msg_iapp_api(e2ap_msg_t const* msg)
   notify_msg_iapp(iapp, msg);
 }
 
+
+void print_xapps_iapp_api(FILE* out)
+{
+  assert(iapp != NULL);
+  print_xapps_iapp(iapp, out);
+}
+
+void print_subs_iapp_api(FILE* out)
+{
+  assert(iapp != NULL);
+  print_subs_iapp(iapp, out);
+}
+
+void print_metrics_iapp_api(FILE* out)
+{
+  assert(iapp != NULL);
+  print_metrics_iapp(iapp, out);
+}
+
+bool rm_sub_iapp_api(uint32_t ric_req_id)
+{
+  assert(iapp != NULL);
+  return rm_sub_iapp(iapp, ric_req_id);
+}
+
+bool rm_xapp_iapp_api(uint16_t xapp_id)
+{
+  assert(iapp != NULL);
+  return rm_xapp_iapp(iapp, xapp_id);
+}
@@ -27,16 +27,25 @@
 #include "../../lib/e2ap/e2ap_ran_function_wrapper.h"
 #include "../../lib/e2ap/type_defs_wrapper.h"    
 #include "near_ric_if.h"
+#include "../../util/conf_file.h"
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <stddef.h>
+#include <stdio.h>
 
 typedef struct near_ric_s near_ric_t;
 
-void init_iapp_api(const char* addr, near_ric_if_t ric);
+void init_iapp_api(const char* addr, near_ric_if_t ric, fr_args_t const* args);
+
+// Spawns the thread of the iApp, i.e., it handles the xApps from now on
+void start_iapp_api(void);
   
 void stop_iapp_api(void);     
 
+// Standby nearRT-RIC taking over, between init_iapp_api() and start_iapp_api()
+void restore_iapp_api(repl_state_t const* s);
+
 #ifdef E2AP_V1 
 void add_e2_node_iapp_api_v1(global_e2_node_id_t* id, size_t len, ran_function_t const ran_func[len]);
 #elif defined(E2AP_V2) || defined(E2AP_V3)
@@ -49,5 +58,17 @@ void rm_e2_node_iapp_api(global_e2_node_id_t* id);
 
 void notify_msg_iapp_api(e2ap_msg_t const* msg);
 
+// Admin socket of the nearRT-RIC, see e42_iapp.h
+
+void print_xapps_iapp_api(FILE* out);
+
+void print_subs_iapp_api(FILE* out);
+
+void print_metrics_iapp_api(FILE* out);
+
+bool rm_sub_iapp_api(uint32_t ric_req_id);
+
+bool rm_xapp_iapp_api(uint16_t xapp_id);
+
 #endif
 
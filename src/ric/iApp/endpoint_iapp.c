@@ -21,6 +21,7 @@
 
 
 #include "endpoint_iapp.h"
+#include "lib/ep/e2ap_capture.h"
 #include <arpa/inet.h>   // for inet_pton
 #include <assert.h>      // for assert
 #include <errno.h>       // for errno
@@ -95,7 +96,10 @@ void e2ap_init_ep_iapp(e2ap_ep_iapp_t* ep, const char* addr, int port)
 
   e2ap_ep_init(&ep->base); 
 
-  *(int*)(&ep->base.fd) = init_sctp_conn_server(addr, port);
+  if(enabled_mem_ep() == true)
+    *(int*)(&ep->base.fd) = e2ap_ep_listen_mem(&ep->base, addr, port);
+  else
+    *(int*)(&ep->base.fd) = init_sctp_conn_server(addr, port);
   *(int*)(&ep->base.port) = port;
   strncpy((char*)(&ep->base.addr), addr, 16);
 
@@ -147,5 +151,11 @@ void e2ap_reg_sock_addr_iapp(e2ap_ep_iapp_t* ep, uint16_t xapp_id,   sctp_info_t
   assert(s != NULL);
 
   add_map_xapps_sad(&ep->xapps, xapp_id, s);
+
+  if(enabled_e2ap_capture() == true){
+    char tag[32] = {0};
+    snprintf(tag, sizeof(tag), "xApp %u", xapp_id);
+    tag_e2ap_capture(&s->addr, tag);
+  }
 }
 
@@ -41,26 +41,26 @@
                           default:                     stop_near_ric_iapp) ()
 
 
-#define fwd_ric_subscription_request_gen(T,U,V,W) _Generic ((T), \
+#define fwd_ric_subscription_request_gen(T,U,V,W,X) _Generic ((T), \
                                           near_ric_if_emulator_t*:        fwd_ric_subscription_request_emulator, \
                                           const near_ric_if_emulator_t*:  fwd_ric_subscription_request_emulator, \
                                           near_ric_t*:                 fwd_ric_subscription_request, \
                                           const near_ric_t*:           fwd_ric_subscription_request, \
-                                          default:                     fwd_ric_subscription_request_emulator) (T,U,V,W)
+                                          default:                     fwd_ric_subscription_request_emulator) (T,U,V,W,X)
 
-#define fwd_ric_subscription_request_delete_gen(T,U,V,W) _Generic ((T), \
+#define fwd_ric_subscription_request_delete_gen(T,U,V,W,X) _Generic ((T), \
                                           near_ric_if_emulator_t*:        fwd_ric_subscription_request_delete_emulator, \
                                           const near_ric_if_emulator_t*:  fwd_ric_subscription_request_delete_emulator, \
                                           near_ric_t*:                 fwd_ric_subscription_request_delete, \
                                           const near_ric_t*:           fwd_ric_subscription_request_delete, \
-                                          default:                     fwd_ric_subscription_request_delete_emulator) (T,U,V,W)
+                                          default:                     fwd_ric_subscription_request_delete_emulator) (T,U,V,W,X)
 
-#define fwd_ric_control_request_gen(T,U,V,W) _Generic ((T), \
+#define fwd_ric_control_request_gen(T,U,V,W,X) _Generic ((T), \
                                           near_ric_if_emulator_t*:        fwd_ric_control_request_emulator, \
                                           const  near_ric_if_emulator_t*: fwd_ric_control_request_emulator, \
                                           near_ric_t*:                 fwd_ric_control_request, \
                                           const   near_ric_t*:         fwd_ric_control_request, \
-                                          default:                     fwd_ric_control_request_emulator) (T,U,V,W)
+                                          default:                     fwd_ric_control_request_emulator) (T,U,V,W,X)
 */
 
 #define start_near_ric_iapp_gen(T) _Generic ((T), \
@@ -74,20 +74,45 @@
                           default:                     stop_near_ric_iapp) ()
 
 
-#define fwd_ric_subscription_request_gen(T,U,V,W) _Generic ((T), \
+#define fwd_ric_subscription_request_gen(T,U,V,W,X) _Generic ((T), \
                                           near_ric_t*:                 fwd_ric_subscription_request, \
                                           const near_ric_t*:           fwd_ric_subscription_request, \
-                                          default:                     fwd_ric_subscription_request) (T,U,V,W)
+                                          default:                     fwd_ric_subscription_request) (T,U,V,W,X)
 
-#define fwd_ric_subscription_request_delete_gen(T,U,V,W) _Generic ((T), \
+#define fwd_ric_subscription_request_delete_gen(T,U,V,W,X) _Generic ((T), \
                                           near_ric_t*:                 fwd_ric_subscription_request_delete, \
                                           const near_ric_t*:           fwd_ric_subscription_request_delete, \
-                                          default:                     fwd_ric_subscription_request_delete) (T,U,V,W)
+                                          default:                     fwd_ric_subscription_request_delete) (T,U,V,W,X)
 
-#define fwd_ric_control_request_gen(T,U,V,W) _Generic ((T), \
+#define fwd_ric_control_request_gen(T,U,V,W,X) _Generic ((T), \
                                           near_ric_t*:                 fwd_ric_control_request, \
                                           const   near_ric_t*:         fwd_ric_control_request, \
-                                          default:                     fwd_ric_control_request) (T,U,V,W)
+                                          default:                     fwd_ric_control_request) (T,U,V,W,X)
+
+#define release_ric_control_request_gen(T,U) _Generic ((T), \
+                                          near_ric_t*:                 release_ric_control_request, \
+                                          const   near_ric_t*:         release_ric_control_request, \
+                                          default:                     release_ric_control_request) (T,U)
+
+#define sm_near_ric_gen(T,U) _Generic ((T), \
+                                          near_ric_t*:                 sm_near_ric, \
+                                          const   near_ric_t*:         sm_near_ric, \
+                                          default:                     sm_near_ric) (T,U)
+
+#define obs_map_ric_id_near_ric_gen(T,U) _Generic ((T), \
+                                          near_ric_t*:                 obs_map_ric_id_near_ric, \
+                                          const   near_ric_t*:         obs_map_ric_id_near_ric, \
+                                          default:                     obs_map_ric_id_near_ric) (T,U)
+
+#define add_xapp_near_ric_gen(T,U,V,W) _Generic ((T), \
+                                          near_ric_t*:                 add_xapp_near_ric, \
+                                          const   near_ric_t*:         add_xapp_near_ric, \
+                                          default:                     add_xapp_near_ric) (T,U,V,W)
+
+#define rm_xapp_near_ric_gen(T,U) _Generic ((T), \
+                                          near_ric_t*:                 rm_xapp_near_ric, \
+                                          const   near_ric_t*:         rm_xapp_near_ric, \
+                                          default:                     rm_xapp_near_ric) (T,U)
 
 #endif
 
@@ -0,0 +1,220 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+
+#include "ind_filter.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+static
+void free_ind_filter(ind_filter_t* f)
+{
+  assert(f != NULL);
+
+  printf("[iApp]: Indication filter RIC_REQ_ID %u forwarded %lu/%lu indications and %lu/%lu bytes\n", 
+      f->ric_req_id, atomic_load(&f->ind_out), atomic_load(&f->ind_in), atomic_load(&f->bytes_out), atomic_load(&f->bytes_in));
+
+  f->sm->filter.free(f->sm, f->filter);
+  free_global_e2_node_id(&f->id);
+  free(f);
+}
+
+static
+void free_ind_filter_wrapper(void* it)
+{
+  assert(it != NULL);
+  free_ind_filter(*(ind_filter_t**)it);
+}
+
+void init_ind_filters(ind_filters_t* f)
+{
+  assert(f != NULL);
+
+  seq_init(&f->arr, sizeof(ind_filter_t*));
+
+  pthread_rwlockattr_t const* attr = NULL;
+  int const rc = pthread_rwlock_init(&f->rw, attr);
+  assert(rc == 0);
+}
+
+void free_ind_filters(ind_filters_t* f)
+{
+  assert(f != NULL);
+
+  seq_free(&f->arr, free_ind_filter_wrapper);
+
+  int const rc = pthread_rwlock_destroy(&f->rw);
+  assert(rc == 0);
+}
+
+ric_subscription_request_t split_ind_filter(ric_subscription_request_t const* src, byte_array_t const** filter, byte_array_t const** overload)
+{
+  assert(src != NULL);
+  assert(filter != NULL);
+  assert(overload != NULL);
+
+  *filter = NULL;
+  *overload = NULL;
+
+  ric_subscription_request_t dst = *src;
+  dst.action = calloc(src->len_action, sizeof(ric_action_t));
+  assert(dst.action != NULL && "Memory exhausted");
+  dst.len_action = 0;
+
+  for(size_t i = 0; i < src->len_action; ++i){
+    ric_action_t const* a = &src->action[i];
+    if(a->id == E42_IND_FILTER_ACTION_ID && a->definition != NULL && *filter == NULL)
+      *filter = a->definition;
+    else if(a->id == E42_OVERLOAD_ACTION_ID && a->definition != NULL && *overload == NULL)
+      *overload = a->definition;
+    else
+      dst.action[dst.len_action++] = *a;
+  }
+
+  // Nothing left to subscribe to. Let the E2 Node refuse it
+  if(dst.len_action == 0){
+    *filter = NULL;
+    *overload = NULL;
+    dst.len_action = src->len_action;
+    for(size_t i = 0; i < src->len_action; ++i)
+      dst.action[i] = src->action[i];
+  }
+
+  return dst;
+}
+
+void add_ind_filter(ind_filters_t* f, uint32_t ric_req_id, global_e2_node_id_t const* id, sm_ric_t const* sm, void* filter)
+{
+  assert(f != NULL);
+  assert(id != NULL);
+  assert(sm != NULL);
+  assert(filter != NULL);
+
+  ind_filter_t* n = calloc(1, sizeof(ind_filter_t));
+  assert(n != NULL && "Memory exhausted");
+  n->ric_req_id = ric_req_id;
+  n->id = cp_global_e2_node_id(id);
+  n->sm = sm;
+  n->filter = filter;
+
+  int rc = pthread_rwlock_wrlock(&f->rw);
+  assert(rc == 0);
+
+  seq_push_back(&f->arr, &n, sizeof(ind_filter_t*));
+
+  rc = pthread_rwlock_unlock(&f->rw);
+  assert(rc == 0);
+}
+
+void rm_ind_filter(ind_filters_t* f, uint32_t ric_req_id)
+{
+  assert(f != NULL);
+
+  int rc = pthread_rwlock_wrlock(&f->rw);
+  assert(rc == 0);
+
+  for(size_t i = 0; i < seq_size(&f->arr); ++i){
+    ind_filter_t** it = seq_at(&f->arr, i);
+    if((*it)->ric_req_id == ric_req_id){
+      free_ind_filter(*it);
+      seq_erase(&f->arr, it, seq_next(&f->arr, it));
+      break;
+    }
+  }
+
+  rc = pthread_rwlock_unlock(&f->rw);
+  assert(rc == 0);
+}
+
+size_t rm_e2_node_ind_filters(ind_filters_t* f, global_e2_node_id_t const* id)
+{
+  assert(f != NULL);
+  assert(id != NULL);
+
+  int rc = pthread_rwlock_wrlock(&f->rw);
+  assert(rc == 0);
+
+  size_t n = 0;
+  size_t i = 0;
+  while(i < seq_size(&f->arr)){
+    ind_filter_t** it = seq_at(&f->arr, i);
+    if(eq_global_e2_node_id(&(*it)->id, id) == false){
+      i += 1;
+      continue;
+    }
+    free_ind_filter(*it);
+    seq_erase(&f->arr, it, seq_next(&f->arr, it));
+    n += 1;
+  }
+
+  rc = pthread_rwlock_unlock(&f->rw);
+  assert(rc == 0);
+
+  return n;
+}
+
+bool apply_ind_filter(ind_filters_t* f, ric_indication_t* ind)
+{
+  assert(f != NULL);
+  assert(ind != NULL);
+
+  // Indications are processed in parallel by the task manager
+  int rc = pthread_rwlock_rdlock(&f->rw);
+  assert(rc == 0);
+
+  ind_filter_t* n = NULL;
+  for(size_t i = 0; i < seq_size(&f->arr); ++i){
+    ind_filter_t* it = *(ind_filter_t**)seq_at(&f->arr, i);
+    if(it->ric_req_id == ind->ric_id.ric_req_id){
+      n = it;
+      break;
+    }
+  }
+
+  bool fwd = true;
+  if(n != NULL){
+    sm_ind_data_t const src = {.ind_hdr = ind->hdr.buf,
+                               .len_hdr = ind->hdr.len,
+                               .ind_msg = ind->msg.buf,
+                               .len_msg = ind->msg.len};
+
+    // Under the read lock, i.e., concurrently with other indications of n
+    atomic_fetch_add_explicit(&n->ind_in, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&n->bytes_in, ind->msg.len, memory_order_relaxed);
+
+    byte_array_t dst = {0};
+    fwd = n->sm->filter.apply(n->sm, n->filter, &src, &dst);
+    if(fwd == true){
+      free_byte_array(ind->msg);
+      ind->msg = dst;
+
+      atomic_fetch_add_explicit(&n->ind_out, 1, memory_order_relaxed);
+      atomic_fetch_add_explicit(&n->bytes_out, dst.len, memory_order_relaxed);
+    }
+  }
+
+  rc = pthread_rwlock_unlock(&f->rw);
+  assert(rc == 0);
+
+  return fwd;
+}
@@ -0,0 +1,78 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+
+#ifndef IND_FILTER_IAPP_H
+#define IND_FILTER_IAPP_H 
+
+#include "../../lib/e2ap/e2ap_global_node_id_wrapper.h"
+#include "../../lib/e2ap/e42_ric_subscription_request_wrapper.h"
+#include "../../lib/e2ap/ric_indication_wrapper.h"
+#include "../../lib/e2ap/ric_subscription_request_wrapper.h"
+#include "../../sm/sm_ric.h"
+#include "../../util/alg_ds/ds/seq_container/seq_generic.h"
+#include "../../util/byte_array.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// Indication filters attached by the xApps to their subscriptions, through
+// the E42_IND_FILTER_ACTION_ID action. The SM evaluates them and re-encodes 
+// the projected message, so only the requested records cross the E42 socket
+typedef struct{
+  uint32_t ric_req_id; // E2 Node side
+  global_e2_node_id_t id;
+
+  sm_ric_t const* sm;
+  void* filter;
+
+  atomic_uint_fast64_t ind_in;
+  atomic_uint_fast64_t ind_out;
+  atomic_uint_fast64_t bytes_in;
+  atomic_uint_fast64_t bytes_out;
+} ind_filter_t;
+
+typedef struct{
+  seq_arr_t arr; // ind_filter_t*
+  pthread_rwlock_t rw;
+} ind_filters_t;
+
+void init_ind_filters(ind_filters_t* f);
+
+void free_ind_filters(ind_filters_t* f);
+
+// Shallow copy of src without the filter and overload actions. Only its action
+// array is owned, and must be freed. filter and overload point into src 
+ric_subscription_request_t split_ind_filter(ric_subscription_request_t const* src, byte_array_t const** filter, byte_array_t const** overload);
+
+void add_ind_filter(ind_filters_t* f, uint32_t ric_req_id, global_e2_node_id_t const* id, sm_ric_t const* sm, void* filter);
+
+void rm_ind_filter(ind_filters_t* f, uint32_t ric_req_id);
+
+size_t rm_e2_node_ind_filters(ind_filters_t* f, global_e2_node_id_t const* id);
+
+// Returns false if the indication must not be forwarded. The message 
+// of ind is replaced by the projected one if a filter is attached
+bool apply_ind_filter(ind_filters_t* f, ric_indication_t* ind);
+
+#endif
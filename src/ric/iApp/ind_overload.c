@@ -0,0 +1,396 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+
+
+#include "ind_overload.h"
+#include "../../util/alg_ds/ds/lock_guard/lock_guard.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct{
+  uint16_t xapp_id;
+  // Conflation key. Empty if none
+  byte_array_t key;
+  byte_array_t ba;
+} ind_queued_t;
+
+typedef struct{
+  uint32_t ric_req_id; // E2 Node side
+  global_e2_node_id_t id;
+  sm_ric_t const* sm;
+  overload_conf_t conf;
+
+  // ind_queued_t. FIFO
+  seq_arr_t q;
+
+  ind_overload_stats_t stats;
+
+  // Report rate
+  uint32_t thin_cnt;
+  int64_t period_start;
+  uint64_t period_drop;
+  uint32_t overloaded;
+  uint32_t recovered;
+} ind_overload_t;
+
+static
+void free_ind_queued(void* it)
+{
+  assert(it != NULL);
+  ind_queued_t* q = (ind_queued_t*)it;
+  free_byte_array(q->key);
+  free_byte_array(q->ba);
+}
+
+static
+void free_ind_overload(ind_overload_t* o)
+{
+  assert(o != NULL);
+
+  ind_overload_stats_t const* s = &o->stats;
+  printf("[iApp]: Overload RIC_REQ_ID %u sent %lu/%lu indications, dropped %lu, conflated %lu, thinned %lu, discarded %lu\n",
+      o->ric_req_id, s->ind_out, s->ind_in, s->dropped, s->conflated, s->thinned, seq_size(&o->q));
+
+  seq_free(&o->q, free_ind_queued);
+  free_global_e2_node_id(&o->id);
+  free(o);
+}
+
+static
+void free_ind_overload_wrapper(void* it)
+{
+  assert(it != NULL);
+  free_ind_overload(*(ind_overload_t**)it);
+}
+
+static
+void* sender_thread(void* arg)
+{
+  ind_overloads_t* o = (ind_overloads_t*)arg;
+
+  while(true){
+    int rc = pthread_mutex_lock(&o->mtx);
+    assert(rc == 0);
+
+    while(o->stop == false && o->pending == 0){
+      rc = pthread_cond_wait(&o->cv, &o->mtx);
+      assert(rc == 0);
+    }
+
+    if(o->stop == true){
+      rc = pthread_mutex_unlock(&o->mtx);
+      assert(rc == 0);
+      break;
+    }
+
+    // One indication per subscription and round, so a busy subscription
+    // does not starve the others
+    size_t const sz = seq_size(&o->arr);
+    ind_queued_t q = {0};
+    for(size_t i = 0; i < sz; ++i){
+      size_t const idx = (o->next + i) % sz;
+      ind_overload_t* it = *(ind_overload_t**)seq_at(&o->arr, idx);
+      if(seq_size(&it->q) == 0)
+        continue;
+
+      q = *(ind_queued_t*)seq_front(&it->q);
+      seq_erase(&it->q, seq_front(&it->q), seq_next(&it->q, seq_front(&it->q)));
+      it->stats.ind_out += 1;
+      o->next = idx + 1;
+      break;
+    }
+    assert(q.ba.buf != NULL && "Pending indications not found");
+    o->pending -= 1;
+
+    rc = pthread_mutex_unlock(&o->mtx);
+    assert(rc == 0);
+
+    // Blocks while the xApp does not keep up 
+    o->send(o->ctx, q.xapp_id, q.ba);
+    free_ind_queued(&q);
+  }
+
+  return NULL;
+}
+
+void init_ind_overloads(ind_overloads_t* o, send_ind_overload_fp send, void* ctx)
+{
+  assert(o != NULL);
+  assert(send != NULL);
+
+  seq_init(&o->arr, sizeof(ind_overload_t*));
+  o->next = 0;
+  o->pending = 0;
+  o->send = send;
+  o->ctx = ctx;
+  o->stop = false;
+
+  pthread_mutexattr_t attr = {0};
+#ifdef DEBUG
+  pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_ERRORCHECK);
+#endif
+  int rc = pthread_mutex_init(&o->mtx, &attr);
+  assert(rc == 0);
+
+  pthread_condattr_t const* c_attr = NULL;
+  rc = pthread_cond_init(&o->cv, c_attr);
+  assert(rc == 0);
+
+  rc = pthread_create(&o->p, NULL, sender_thread, o);
+  assert(rc == 0);
+}
+
+void free_ind_overloads(ind_overloads_t* o)
+{
+  assert(o != NULL);
+
+  {
+    lock_guard(&o->mtx);
+    o->stop = true;
+    int const rc = pthread_cond_signal(&o->cv);
+    assert(rc == 0);
+  }
+
+  int rc = pthread_join(o->p, NULL);
+  assert(rc == 0);
+
+  seq_free(&o->arr, free_ind_overload_wrapper);
+
+  rc = pthread_cond_destroy(&o->cv);
+  assert(rc == 0);
+
+  rc = pthread_mutex_destroy(&o->mtx);
+  assert(rc == 0);
+}
+
+void add_ind_overload(ind_overloads_t* o, uint32_t ric_req_id, global_e2_node_id_t const* id, sm_ric_t const* sm, overload_conf_t conf)
+{
+  assert(o != NULL);
+  assert(id != NULL);
+  assert(conf.policy < END_OVERLOAD_POLICY);
+  assert(conf.depth > 0 && conf.depth <= OVERLOAD_MAX_DEPTH);
+
+  ind_overload_t* n = calloc(1, sizeof(ind_overload_t));
+  assert(n != NULL && "Memory exhausted");
+  n->ric_req_id = ric_req_id;
+  n->id = cp_global_e2_node_id(id);
+  n->sm = sm;
+  n->conf = conf;
+  n->stats.thin = 1;
+  n->period_start = -1;
+  seq_init(&n->q, sizeof(ind_queued_t));
+
+  if(conf.policy == KEEP_LATEST_OVERLOAD_POLICY && (sm == NULL || sm->conflate.key == NULL))
+    printf("[iApp]: RIC_REQ_ID %u keep_latest not supported by the SM. Dropping the oldest\n", ric_req_id);
+
+  printf("[iApp]: Overload policy %s depth %lu for RIC_REQ_ID %u\n", overload_policy_str(conf.policy), conf.depth, ric_req_id);
+
+  lock_guard(&o->mtx);
+  seq_push_back(&o->arr, &n, sizeof(ind_overload_t*));
+}
+
+// The sender thread may hold an indication of it, which it owns
+static
+void erase_ind_overload(ind_overloads_t* o, size_t idx)
+{
+  ind_overload_t** it = seq_at(&o->arr, idx);
+  assert(o->pending >= seq_size(&(*it)->q));
+  o->pending -= seq_size(&(*it)->q);
+  free_ind_overload(*it);
+  seq_erase(&o->arr, it, seq_next(&o->arr, it));
+}
+
+void rm_ind_overload(ind_overloads_t* o, uint32_t ric_req_id)
+{
+  assert(o != NULL);
+
+  lock_guard(&o->mtx);
+
+  for(size_t i = 0; i < seq_size(&o->arr); ++i){
+    ind_overload_t* it = *(ind_overload_t**)seq_at(&o->arr, i);
+    if(it->ric_req_id == ric_req_id){
+      erase_ind_overload(o, i);
+      break;
+    }
+  }
+}
+
+size_t rm_e2_node_ind_overloads(ind_overloads_t* o, global_e2_node_id_t const* id)
+{
+  assert(o != NULL);
+  assert(id != NULL);
+
+  lock_guard(&o->mtx);
+
+  size_t n = 0;
+  size_t i = 0;
+  while(i < seq_size(&o->arr)){
+    ind_overload_t* it = *(ind_overload_t**)seq_at(&o->arr, i);
+    if(eq_global_e2_node_id(&it->id, id) == false){
+      i += 1;
+      continue;
+    }
+    erase_ind_overload(o, i);
+    n += 1;
+  }
+
+  return n;
+}
+
+static
+ind_overload_t* find_ind_overload(ind_overloads_t* o, uint32_t ric_req_id)
+{
+  for(size_t i = 0; i < seq_size(&o->arr); ++i){
+    ind_overload_t* it = *(ind_overload_t**)seq_at(&o->arr, i);
+    if(it->ric_req_id == ric_req_id)
+      return it;
+  }
+  return NULL;
+}
+
+// Halve the report rate while the xApp keeps dropping, and double it 
+// back once it keeps up
+static
+void update_rate(ind_overload_t* o, int64_t now)
+{
+  if(o->period_start < 0)
+    o->period_start = now;
+
+  if(now - o->period_start < OVERLOAD_PERIOD_MS*1000)
+    return;
+
+  if(o->period_drop > 0){
+    o->recovered = 0;
+    o->overloaded += 1;
+    if(o->overloaded >= OVERLOAD_PERSIST_PERIODS && o->stats.thin < OVERLOAD_MAX_THIN){
+      o->stats.thin *= 2;
+      o->overloaded = 0;
+      printf("[iApp]: RIC_REQ_ID %u overloaded. Sending 1 out of %u indications\n", o->ric_req_id, o->stats.thin);
+    }
+  } else {
+    o->overloaded = 0;
+    o->recovered += 1;
+    if(o->recovered >= OVERLOAD_PERSIST_PERIODS && o->stats.thin > 1){
+      o->stats.thin /= 2;
+      o->recovered = 0;
+      printf("[iApp]: RIC_REQ_ID %u recovering. Sending 1 out of %u indications\n", o->ric_req_id, o->stats.thin);
+    }
+  }
+
+  o->period_start = now;
+  o->period_drop = 0;
+}
+
+static
+ind_queued_t* find_key(ind_overload_t* o, byte_array_t key)
+{
+  void* it = seq_front(&o->q);
+  void* end = seq_end(&o->q);
+  while(it != end){
+    ind_queued_t* q = (ind_queued_t*)it;
+    if(eq_byte_array(&q->key, &key))
+      return q;
+    it = seq_next(&o->q, it);
+  }
+  return NULL;
+}
+
+bool push_ind_overload(ind_overloads_t* o, int64_t now, uint32_t ric_req_id, uint16_t xapp_id, sm_ind_data_t const* src, byte_array_t* ba)
+{
+  assert(o != NULL);
+  assert(src != NULL);
+  assert(ba != NULL);
+
+  lock_guard(&o->mtx);
+
+  ind_overload_t* n = find_ind_overload(o, ric_req_id);
+  if(n == NULL)
+    return false;
+
+  ind_queued_t q = {.xapp_id = xapp_id, .ba = *ba};
+  *ba = (byte_array_t){0};
+
+  n->stats.ind_in += 1;
+  update_rate(n, now);
+
+  if(n->conf.policy == KEEP_LATEST_OVERLOAD_POLICY && n->sm != NULL && n->sm->conflate.key != NULL)
+    q.key = n->sm->conflate.key(n->sm, src);
+
+  // The latest indication of the UE replaces the queued one, in place
+  if(q.key.len > 0){
+    ind_queued_t* old = find_key(n, q.key);
+    if(old != NULL){
+      free_ind_queued(old);
+      *old = q;
+      n->stats.conflated += 1;
+      n->period_drop += 1;
+      return true;
+    }
+  } else if(n->stats.thin > 1){
+    n->thin_cnt = (n->thin_cnt + 1) % n->stats.thin;
+    if(n->thin_cnt != 0){
+      free_ind_queued(&q);
+      n->stats.thinned += 1;
+      return true;
+    }
+  }
+
+  if(seq_size(&n->q) == n->conf.depth){
+    n->stats.dropped += 1;
+    n->period_drop += 1;
+    if(n->conf.policy == DROP_NEWEST_OVERLOAD_POLICY){
+      free_ind_queued(&q);
+      return true;
+    }
+    void* front = seq_front(&n->q);
+    free_ind_queued(front);
+    seq_erase(&n->q, front, seq_next(&n->q, front));
+    o->pending -= 1;
+  }
+
+  seq_push_back(&n->q, &q, sizeof(ind_queued_t));
+  o->pending += 1;
+
+  int const rc = pthread_cond_signal(&o->cv);
+  assert(rc == 0);
+
+  return true;
+}
+
+bool stats_ind_overload(ind_overloads_t* o, uint32_t ric_req_id, ind_overload_stats_t* dst)
+{
+  assert(o != NULL);
+  assert(dst != NULL);
+
+  lock_guard(&o->mtx);
+
+  ind_overload_t* n = find_ind_overload(o, ric_req_id);
+  if(n == NULL)
+    return false;
+
+  *dst = n->stats;
+  dst->queued = seq_size(&n->q);
+  return true;
+}
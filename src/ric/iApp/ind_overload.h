@@ -0,0 +1,98 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+
+
+
+#ifndef IND_OVERLOAD_IAPP_H
+#define IND_OVERLOAD_IAPP_H
+
+// Overload protection for slow xApps. The xApp selects a policy per 
+// subscription through the E42_OVERLOAD_ACTION_ID action, see overload_conf.h. 
+// Its indications are then queued, and sent by one thread, so a slow xApp 
+// never stalls the threads that process the indications of the E2 Nodes. 
+// If indications are dropped during OVERLOAD_PERSIST_PERIODS consecutive 
+// periods, the report rate is halved, i.e., only one out of thin indications 
+// is queued. It recovers once the xApp keeps up. Conflated indications are 
+// never thinned, as every UE must be reported
+
+#include "../../lib/e2ap/e2ap_global_node_id_wrapper.h"
+#include "../../sm/sm_ric.h"
+#include "../../util/alg_ds/ds/seq_container/seq_generic.h"
+#include "../../util/byte_array.h"
+#include "../../util/overload_conf.h"
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#define OVERLOAD_PERIOD_MS 1000
+#define OVERLOAD_PERSIST_PERIODS 3
+#define OVERLOAD_MAX_THIN 64
+
+typedef struct{
+  uint64_t ind_in;
+  uint64_t ind_out;
+  uint64_t dropped;
+  uint64_t conflated;
+  uint64_t thinned;
+  uint32_t thin;
+  size_t queued;
+} ind_overload_stats_t;
+
+// Sends the encoded E42 message to the xApp. May block
+typedef void (*send_ind_overload_fp)(void* ctx, uint16_t xapp_id, byte_array_t ba);
+
+typedef struct{
+  // ind_overload_t*
+  seq_arr_t arr;
+  // Round robin among the subscriptions
+  size_t next;
+  size_t pending;
+
+  send_ind_overload_fp send;
+  void* ctx;
+
+  bool stop;
+  pthread_t p;
+  pthread_mutex_t mtx;
+  pthread_cond_t cv;
+} ind_overloads_t;
+
+void init_ind_overloads(ind_overloads_t* o, send_ind_overload_fp send, void* ctx);
+
+// The queued indications are discarded
+void free_ind_overloads(ind_overloads_t* o);
+
+// sm may be NULL
+void add_ind_overload(ind_overloads_t* o, uint32_t ric_req_id, global_e2_node_id_t const* id, sm_ric_t const* sm, overload_conf_t conf);
+
+void rm_ind_overload(ind_overloads_t* o, uint32_t ric_req_id);
+
+size_t rm_e2_node_ind_overloads(ind_overloads_t* o, global_e2_node_id_t const* id);
+
+// Returns false if the subscription is not protected, and the caller must send ba. 
+// Otherwise, ba is moved, and queued or dropped. src is only read by keep_latest
+bool push_ind_overload(ind_overloads_t* o, int64_t now, uint32_t ric_req_id, uint16_t xapp_id, sm_ind_data_t const* src, byte_array_t* ba);
+
+bool stats_ind_overload(ind_overloads_t* o, uint32_t ric_req_id, ind_overload_stats_t* dst);
+
+#endif
@@ -92,6 +92,16 @@ void init_map_ric_id(map_ric_id_t* map)
   size_t key_sz_2 = sizeof(xapp_ric_id_t); //);
 
   bi_map_init(&map->bimap, key_sz_1, key_sz_2, cmp_e2_node_ric_req_wrapper, cmp_xapp_ric_gen_id_wrapper, free_xapp_ric_gen_id, free_e2_node_ric_req);
+
+  map->obs = (map_ric_id_obs_t){0};
+}
+
+void set_obs_map_ric_id(map_ric_id_t* map, map_ric_id_obs_t obs)
+{
+  assert(map != NULL);
+  assert(obs.add != NULL && obs.rm != NULL);
+
+  map->obs = obs;
 }
 
 void free_map_ric_id(map_ric_id_t* map)
@@ -148,16 +158,18 @@ void add_map_ric_id(map_ric_id_t* map, e2_node_ric_id_t* node, xapp_ric_id_t* x)
   assert(it == end && "ric_req_id already in the map");
 
   bi_map_insert(&map->bimap, node, sizeof(e2_node_ric_id_t), x, sizeof(xapp_ric_id_t));
+
+  if(map->obs.add != NULL)
+    map->obs.add(map->obs.ctx, node, x);
 }
 
-void rm_map_ric_id(map_ric_id_t* map, xapp_ric_id_t const* ric_id)
+// WARNING: The write lock must be already acquired when calling this function
+static
+void rm_map_ric_id_locked(map_ric_id_t* map, xapp_ric_id_t const* ric_id)
 {
   assert(map != NULL);
   assert(ric_id != NULL);
 
-  int rc = pthread_rwlock_wrlock(&map->rw);
-  assert(rc == 0);
-
   // left: key1:   e2_node_ric_id_t | value: xapp_ric_id_t
   // right: key2:  xapp_ric_id_t | value: e2_node_ric_id_t  
 
@@ -167,14 +179,58 @@ void rm_map_ric_id(map_ric_id_t* map, xapp_ric_id_t const* ric_id)
 
   //printf("Removing xapp_ric_id xapp %d ric_req_id %d node ric id %d \n", ric_id->xapp_id, ric_id->ric_id.ric_req_id,  n->ric_id.ric_req_id);
 
+  if(map->obs.rm != NULL)
+    map->obs.rm(map->obs.ctx, n, ric_id);
+
   free_e2_node_ric_id(n);
   free(n);
+}
+
+void rm_map_ric_id(map_ric_id_t* map, xapp_ric_id_t const* ric_id)
+{
+  assert(map != NULL);
+  assert(ric_id != NULL);
+
+  int rc = pthread_rwlock_wrlock(&map->rw);
+  assert(rc == 0);
+
+  rm_map_ric_id_locked(map, ric_id);
+
+  rc = pthread_rwlock_unlock(&map->rw);
+  assert(rc == 0);
+}
+
+xapp_ric_id_xpct_t try_rm_map_ric_id(map_ric_id_t* map, uint32_t ric_req_id, ric_request_type_e* type)
+{
+  assert(map != NULL);
+  assert(ric_req_id > 0);
+  assert(type != NULL);
+
+  e2_node_ric_id_t dummy_node = {.ric_id.ric_req_id = ric_req_id}; 
+
+  xapp_ric_id_xpct_t ans = {.has_value = false};
+
+  int rc = pthread_rwlock_wrlock(&map->rw);
+  assert(rc == 0);
+
+  assoc_rb_tree_t* left = &map->bimap.left; 
+  void* it = assoc_front(left);
+  void* end = assoc_end(left);
+  it = find_if(left, it, end, &dummy_node, eq_e2_node_ric_req);
+  if(it != end){
+    ans.has_value = true;
+    ans.xapp_ric_id = *(xapp_ric_id_t*)assoc_value(left, it);
+    *type = ((e2_node_ric_id_t*)assoc_key(left, it))->ric_req_type;
+    rm_map_ric_id_locked(map, &ans.xapp_ric_id);
+  }
 
   rc = pthread_rwlock_unlock(&map->rw);
   assert(rc == 0);
+
+  return ans;
 }
 
-xapp_ric_id_xpct_t find_xapp_map_ric_id(map_ric_id_t* map, uint16_t ric_req_id)
+xapp_ric_id_xpct_t find_xapp_map_ric_id(map_ric_id_t* map, uint32_t ric_req_id)
 {
   assert(map != NULL);
   assert(ric_req_id > 0 );
@@ -272,3 +328,72 @@ seq_arr_t find_all_subs_map_ric_id(map_ric_id_t* map, uint16_t xapp_id)
   return arr;
 }
 
+void free_map_ric_id_entry_wrapper(void* src)
+{
+  assert(src != NULL);
+  map_ric_id_entry_t* e = (map_ric_id_entry_t*)src;
+  free_e2_node_ric_id(&e->node);
+}
+
+seq_arr_t all_map_ric_id(map_ric_id_t* map)
+{
+  assert(map != NULL);
+
+  seq_arr_t arr = {0}; 
+  seq_init(&arr, sizeof(map_ric_id_entry_t));
+
+  int rc = pthread_rwlock_rdlock(&map->rw);
+  assert(rc == 0);
+
+  assoc_rb_tree_t* left = &map->bimap.left; 
+
+  void* it = assoc_front(left);
+  void* end = assoc_end(left);
+  while(it != end){
+    map_ric_id_entry_t tmp = {.node = cp_e2_node_ric_id(assoc_key(left, it)), 
+                              .xapp = *(xapp_ric_id_t*)assoc_value(left, it)};
+    seq_push_back(&arr, &tmp, sizeof(map_ric_id_entry_t));
+    it = assoc_next(left, it);
+  }
+
+  rc = pthread_rwlock_unlock(&map->rw);
+  assert(rc == 0);
+
+  return arr;
+}
+
+size_t rm_e2_node_map_ric_id(map_ric_id_t* map, global_e2_node_id_t const* id)
+{
+  assert(map != NULL);
+  assert(id != NULL);
+
+  // array of xapp_ric_id_t 
+  seq_arr_t arr = {0}; 
+  seq_init(&arr, sizeof(xapp_ric_id_t));
+  defer({ seq_free(&arr, NULL); } );
+
+  int rc = pthread_rwlock_rdlock(&map->rw);
+  assert(rc == 0);
+
+  assoc_rb_tree_t* right = &map->bimap.right; 
+  void* it = assoc_front(right);
+  void* end = assoc_end(right);
+  while(it != end){
+    e2_node_ric_id_t* n = (e2_node_ric_id_t*)assoc_value(right, it);
+    if(eq_global_e2_node_id(&n->e2_node_id, id) == true)
+      seq_push_back(&arr, assoc_key(right, it), sizeof(xapp_ric_id_t));
+    it = assoc_next(right, it);
+  }
+
+  rc = pthread_rwlock_unlock(&map->rw);
+  assert(rc == 0);
+
+  void* f = seq_front(&arr);
+  void* l = seq_end(&arr);
+  while(f != l){
+    rm_map_ric_id(map, (xapp_ric_id_t*)f);
+    f = seq_next(&arr, f);
+  }
+
+  return seq_size(&arr);
+}
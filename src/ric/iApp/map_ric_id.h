@@ -23,6 +23,7 @@
 #define MAP_RIC_ID_H 
 
 #include "../../util/alg_ds/ds/assoc_container/assoc_generic.h"
+#include "../../util/alg_ds/ds/assoc_container/bimap.h"
 
 #include "e2_node_ric_id.h"
 
@@ -30,6 +31,21 @@
 #include <pthread.h>
 
 
+typedef struct{
+  e2_node_ric_id_t node;
+  xapp_ric_id_t xapp;
+} map_ric_id_entry_t;
+
+void free_map_ric_id_entry_wrapper(void* src);
+
+// Observer of the changes, e.g., the replication towards the standby
+// nearRT-RIC. Called under the write lock, i.e., in the order of the changes
+typedef struct{
+  void (*add)(void* ctx, e2_node_ric_id_t const* node, xapp_ric_id_t const* x);
+  void (*rm)(void* ctx, e2_node_ric_id_t const* node, xapp_ric_id_t const* x);
+  void* ctx;
+} map_ric_id_obs_t;
+
 typedef struct
 {
 //  assoc_rb_tree_t tree; // key: ric_req_id | value:   xapp_ric_id_t
@@ -37,6 +53,9 @@ typedef struct
   bi_map_t bimap; // left: key:   e2_node_ric_req_t | value: xapp_ric_id_t
                   // right: key:  xapp_ric_id_t | value: e2_node_ric_req_t  
   pthread_rwlock_t rw;
+
+  // Optional
+  map_ric_id_obs_t obs;
 } map_ric_id_t;
 
 
@@ -44,18 +63,30 @@ void init_map_ric_id(map_ric_id_t* map);
 
 void free_map_ric_id( map_ric_id_t* map);
 
+// Before any change
+void set_obs_map_ric_id(map_ric_id_t* map, map_ric_id_obs_t obs);
+
 void add_map_ric_id(map_ric_id_t* map, e2_node_ric_id_t* node, xapp_ric_id_t* x);
 
 void rm_map_ric_id(map_ric_id_t* map, xapp_ric_id_t const* ric_id);
 
+// Removes the entry of ric_req_id, if present. Safe against concurrent removals
+xapp_ric_id_xpct_t try_rm_map_ric_id(map_ric_id_t* map, uint32_t ric_req_id, ric_request_type_e* type);
+
 //void rm_map_ric_id(map_ric_id_t* map, e2_node_ric_req_t* node); // uint16_t ric_req_id);
 
-xapp_ric_id_xpct_t find_xapp_map_ric_id(map_ric_id_t* map, uint16_t ric_req_id);
+xapp_ric_id_xpct_t find_xapp_map_ric_id(map_ric_id_t* map, uint32_t ric_req_id);
 
 e2_node_ric_id_t find_ric_req_map_ric_id(map_ric_id_t* map, xapp_ric_id_t* x);
 
 // array of e2_node_ric_id_t 
 seq_arr_t find_all_subs_map_ric_id(map_ric_id_t* map, uint16_t xapp_id); 
 
+// Copy of every request. Array of map_ric_id_entry_t
+seq_arr_t all_map_ric_id(map_ric_id_t* map);
+
+// Removes all the requests towards an E2 Node. Returns the number removed
+size_t rm_e2_node_map_ric_id(map_ric_id_t* map, global_e2_node_id_t const* id);
+
 #endif
 
@@ -139,7 +139,13 @@ void add_map_xapps_sad(map_xapps_sockaddr_t* m, uint16_t xapp_id, sctp_info_t* s
   void* end = assoc_end(tree);
 
   it = find_if(tree, it, end, &xapp_id, eq_uint16_wrapper);
-  assert(it == end && "xApp ID already registered in the tree");
+  if(it != end){
+    // xApp that resumed its session through a new association.
+    // Replaced under the same lock, so that the xApp ID is always found
+    void (*free_sctp_info)(void*) = NULL;
+    sctp_info_t* old = bi_map_extract_left(&m->bimap, &xapp_id, sizeof(uint16_t), free_sctp_info);
+    free(old);
+  }
 
  // sctp_info_t* info = calloc(1, sizeof(sctp_info_t)); 
 //  assert(info != NULL && "Memory exhausted");
@@ -201,6 +207,55 @@ sctp_info_t find_map_xapps_sad(map_xapps_sockaddr_t* m, uint16_t xapp_id)
   return s;
 }
 
+bool try_find_map_xapps_sad(map_xapps_sockaddr_t* m, uint16_t xapp_id, sctp_info_t* s)
+{
+  assert(m != NULL);
+  assert(s != NULL);
+
+  int rc = pthread_rwlock_rdlock(&m->rw);
+  assert(rc == 0);
+
+  assoc_rb_tree_t* tree = &m->bimap.left;
+
+  void* it = assoc_front(tree);
+  void* end = assoc_end(tree);
+
+  it = find_if(tree, it, end, &xapp_id, eq_uint16_wrapper);
+  bool const found = it != end;
+  if(found)
+    *s = *(sctp_info_t*)assoc_value(tree, it);  
+
+  rc = pthread_rwlock_unlock(&m->rw); 
+  assert(rc == 0);
+
+  return found;
+}
+
+bool try_find_map_xapps_xid(map_xapps_sockaddr_t* m, sctp_info_t const* s, uint16_t* xapp_id)
+{
+  assert(m != NULL);
+  assert(s != NULL);
+  assert(xapp_id != NULL);
+
+  int rc = pthread_rwlock_rdlock(&m->rw);
+  assert(rc == 0);
+
+  assoc_rb_tree_t* tree = &m->bimap.right;
+
+  void* it = assoc_front(tree);
+  void* end = assoc_end(tree);
+
+  it = find_if(tree, it, end, s, eq_sctp_info_wrapper);
+  bool const found = it != end;
+  if(found)
+    *xapp_id = *(uint16_t*)assoc_value(tree, it);  
+
+  rc = pthread_rwlock_unlock(&m->rw); 
+  assert(rc == 0);
+
+  return found;
+}
+
 uint16_t find_map_xapps_xid(map_xapps_sockaddr_t* m, sctp_info_t const* s)
 {
   assert(m != NULL);
@@ -226,3 +281,30 @@ uint16_t find_map_xapps_xid(map_xapps_sockaddr_t* m, sctp_info_t const* s)
 }
 
 
+
+seq_arr_t all_map_xapps_sad(map_xapps_sockaddr_t* m)
+{
+  assert(m != NULL);
+
+  seq_arr_t arr = {0};
+  seq_init(&arr, sizeof(xapp_sad_t));
+
+  int rc = pthread_rwlock_rdlock(&m->rw);
+  assert(rc == 0);
+
+  assoc_rb_tree_t* tree = &m->bimap.left;
+
+  void* it = assoc_front(tree);
+  void* end = assoc_end(tree);
+  while(it != end){
+    xapp_sad_t tmp = {.xapp_id = *(uint16_t*)assoc_key(tree, it), 
+                      .info = *(sctp_info_t*)assoc_value(tree, it)};
+    seq_push_back(&arr, &tmp, sizeof(xapp_sad_t));
+    it = assoc_next(tree, it);
+  }
+
+  rc = pthread_rwlock_unlock(&m->rw); 
+  assert(rc == 0);
+
+  return arr;
+}
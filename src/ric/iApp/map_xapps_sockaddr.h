@@ -25,6 +25,7 @@
 #include "../../lib/e2ap/e2ap_global_node_id_wrapper.h"
 #include "../../util/alg_ds/ds/assoc_container/assoc_generic.h"
 #include "../../util/alg_ds/ds/assoc_container/bimap.h"
+#include "../../util/alg_ds/ds/seq_container/seq_generic.h"
 #include "../../lib/ep/sctp_msg.h"
 
 #include <netinet/in.h>
@@ -51,8 +52,24 @@ void rm_map_xapps_sad(map_xapps_sockaddr_t* m, uint16_t xapp_id);
 
 sctp_info_t find_map_xapps_sad(map_xapps_sockaddr_t* m, uint16_t xapp_id);
 
+// False if the xApp has no association yet, e.g., a session restored from
+// the primary nearRT-RIC before its E42 SETUP-RESPONSE
+bool try_find_map_xapps_sad(map_xapps_sockaddr_t* m, uint16_t xapp_id, sctp_info_t* s);
+
 uint16_t find_map_xapps_xid(map_xapps_sockaddr_t* m, sctp_info_t const* s);
 
+// False if the association never got an E42 SETUP-RESPONSE, e.g., it was 
+// not answered as no E2 Node was connected
+bool try_find_map_xapps_xid(map_xapps_sockaddr_t* m, sctp_info_t const* s, uint16_t* xapp_id);
+
+typedef struct{
+  uint16_t xapp_id;
+  sctp_info_t info;
+} xapp_sad_t;
+
+// Array of xapp_sad_t
+seq_arr_t all_map_xapps_sad(map_xapps_sockaddr_t* m);
+
 #endif
 
 
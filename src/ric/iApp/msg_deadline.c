@@ -0,0 +1,186 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+
+
+
+#include "msg_deadline.h"
+#include "../../util/conf_file.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// E2AP ProcedureCode values. Common to E2AP v1.01, v2.03 and v3.01
+#define E2AP_PROC_CODE_RIC_CONTROL 4
+#define E2AP_PROC_CODE_RIC_INDICATION 5
+
+static
+bool parse_ms(char const* val, int64_t* dst)
+{
+  long long ms = 0;
+  if(parse_num_conf(val, 1, INT32_MAX, &ms) == false)
+    return false;
+  *dst = ms*1000;
+  return true;
+}
+
+static
+bool parse_opt(char* key, char* val, void* data)
+{
+  msg_deadlines_t* d = (msg_deadlines_t*)data;
+
+  if(strcmp(key, "ctrl") == 0)
+    return parse_ms(val, &d->deadline_us[CTRL_MSG_CLASS]);
+  if(strcmp(key, "ind") == 0)
+    return parse_ms(val, &d->deadline_us[IND_MSG_CLASS]);
+  if(strcmp(key, "mgmt") == 0)
+    return parse_ms(val, &d->deadline_us[MGMT_MSG_CLASS]);
+
+  long long drop = 0;
+  if(strcmp(key, "drop") == 0 && parse_num_conf(val, 0, 1, &drop) == true){
+    d->drop_ind = drop == 1;
+    return true;
+  }
+
+  return false;
+}
+
+static
+bool parse_conf(char const* conf, msg_deadlines_t* d)
+{
+  return parse_kv_conf(strlen(conf), conf, parse_opt, d);
+}
+
+void init_msg_deadlines(msg_deadlines_t* d, char const* conf)
+{
+  assert(d != NULL);
+
+  d->deadline_us[CTRL_MSG_CLASS] = MSG_DEADLINE_CTRL_MS*1000;
+  d->deadline_us[IND_MSG_CLASS] = MSG_DEADLINE_IND_MS*1000;
+  d->deadline_us[MGMT_MSG_CLASS] = MSG_DEADLINE_MGMT_MS*1000;
+  d->drop_ind = false;
+
+  if(conf != NULL && parse_conf(conf, d) == false){
+    printf("[NEAR-RIC]: Malformed MSG_DEADLINE = %s\n", conf);
+    assert(0 != 0 && "Malformed MSG_DEADLINE");
+  }
+
+  for(int i = 0; i < END_MSG_CLASS; ++i){
+    atomic_init(&d->stats[i].num, 0);
+    atomic_init(&d->stats[i].expired, 0);
+    atomic_init(&d->stats[i].dropped, 0);
+    atomic_init(&d->stats[i].max_wait_us, 0);
+  }
+}
+
+char const* msg_class_str(msg_class_e c)
+{
+  switch(c){
+    case CTRL_MSG_CLASS:
+      return "control";
+    case IND_MSG_CLASS:
+      return "indication";
+    case MGMT_MSG_CLASS:
+      return "management";
+    default:
+      assert(0 != 0 && "Unknown message class");
+  }
+  return NULL;
+}
+
+msg_class_e e2ap_msg_class(e2_msg_type_t type)
+{
+  switch(type){
+    case RIC_CONTROL_REQUEST:
+    case RIC_CONTROL_ACKNOWLEDGE:
+    case RIC_CONTROL_FAILURE:
+    case E42_RIC_CONTROL_REQUEST:
+      return CTRL_MSG_CLASS;
+    case RIC_INDICATION:
+      return IND_MSG_CLASS;
+    default:
+      return MGMT_MSG_CLASS;
+  }
+}
+
+msg_class_e peek_e2ap_msg_class(byte_array_t ba)
+{
+  // APER E2AP-PDU: the CHOICE index (initiating, successful or unsuccessful 
+  // outcome) fills the first octet and the ProcedureCode (0..255) the second
+  if(ba.len < 2 || ba.buf == NULL || (ba.buf[0] & 0x9F) != 0 || ba.buf[0] > 0x40)
+    return MGMT_MSG_CLASS;
+
+  if(ba.buf[1] == E2AP_PROC_CODE_RIC_CONTROL)
+    return CTRL_MSG_CLASS;
+  if(ba.buf[1] == E2AP_PROC_CODE_RIC_INDICATION)
+    return IND_MSG_CLASS;
+  return MGMT_MSG_CLASS;
+}
+
+static
+void update_max_wait(msg_class_stats_t* s, int64_t wait)
+{
+  int_fast64_t cur = atomic_load_explicit(&s->max_wait_us, memory_order_relaxed);
+  while(wait > cur && atomic_compare_exchange_weak(&s->max_wait_us, &cur, wait) == false)
+    ;
+}
+
+bool check_msg_deadline(msg_deadlines_t* d, msg_class_e c, int64_t rcv, int64_t now)
+{
+  assert(d != NULL);
+  assert(c < END_MSG_CLASS);
+
+  msg_class_stats_t* s = &d->stats[c];
+  atomic_fetch_add_explicit(&s->num, 1, memory_order_relaxed);
+
+  int64_t const wait = now - rcv;
+  update_max_wait(s, wait);
+
+  if(wait <= d->deadline_us[c])
+    return true;
+
+  uint64_t const expired = atomic_fetch_add_explicit(&s->expired, 1, memory_order_relaxed) + 1;
+  bool const drop = c == IND_MSG_CLASS && d->drop_ind == true;
+  if(drop)
+    atomic_fetch_add_explicit(&s->dropped, 1, memory_order_relaxed);
+
+  // Do not flood stdout under overload
+  if(expired == 1 || expired % 1024 == 0)
+    printf("[NEAR-RIC]: %s message %s after %ld us, deadline %ld us. %lu expired so far\n", 
+           msg_class_str(c), drop ? "dropped" : "late", wait, d->deadline_us[c], expired);
+
+  return drop == false;
+}
+
+void print_msg_deadlines(msg_deadlines_t const* d, char const* who, FILE* out)
+{
+  assert(d != NULL);
+  assert(who != NULL);
+  assert(out != NULL);
+
+  for(int i = 0; i < END_MSG_CLASS; ++i){
+    msg_class_stats_t const* s = &d->stats[i];
+    fprintf(out, "[%s]: %s messages %lu expired %lu dropped %lu max wait %ld us\n", who, msg_class_str(i), 
+           atomic_load(&s->num), atomic_load(&s->expired), atomic_load(&s->dropped), atomic_load(&s->max_wait_us));
+  }
+}
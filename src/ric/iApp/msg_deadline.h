@@ -0,0 +1,87 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+
+
+
+#ifndef MESSAGE_DEADLINE_RIC_H
+#define MESSAGE_DEADLINE_RIC_H
+
+// Near-RT control loops have a budget of 10 ms - 1 s. Messages are classified 
+// and stamped at reception, and checked against the deadline of their class 
+// when they are processed. Configured through the RIC configuration file:
+//  MSG_DEADLINE = ctrl=10;ind=100;mgmt=1000;drop=1
+// Deadlines in ms. With drop=1, expired indications are discarded, since stale 
+// measurements are useless for the loop. Expired control and management 
+// messages are only flagged, as xApps may be waiting for them.
+
+#include "../../lib/e2ap/type_defs_wrapper.h"
+#include "../../util/byte_array.h"
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define MSG_DEADLINE_CTRL_MS 10
+#define MSG_DEADLINE_IND_MS 100
+#define MSG_DEADLINE_MGMT_MS 1000
+
+// Ordered by priority, i.e., the task manager lane 
+typedef enum{
+  CTRL_MSG_CLASS,
+  IND_MSG_CLASS,
+  MGMT_MSG_CLASS,
+
+  END_MSG_CLASS
+} msg_class_e;
+
+typedef struct{
+  atomic_uint_fast64_t num;
+  atomic_uint_fast64_t expired;
+  atomic_uint_fast64_t dropped;
+  atomic_int_fast64_t max_wait_us;
+} msg_class_stats_t;
+
+typedef struct{
+  int64_t deadline_us[END_MSG_CLASS];
+  bool drop_ind;
+
+  msg_class_stats_t stats[END_MSG_CLASS];
+} msg_deadlines_t;
+
+// conf may be NULL. Asserts if conf is malformed
+void init_msg_deadlines(msg_deadlines_t* d, char const* conf);
+
+char const* msg_class_str(msg_class_e c);
+
+msg_class_e e2ap_msg_class(e2_msg_type_t type);
+
+// Class of an APER encoded E2AP PDU, without decoding it. 
+// MGMT_MSG_CLASS if it cannot tell
+msg_class_e peek_e2ap_msg_class(byte_array_t ba);
+
+// rcv and now in us. Returns false if the message must be dropped
+bool check_msg_deadline(msg_deadlines_t* d, msg_class_e c, int64_t rcv, int64_t now);
+
+void print_msg_deadlines(msg_deadlines_t const* d, char const* who, FILE* out);
+
+#endif
@@ -29,6 +29,7 @@ a* You may obtain a copy of the License at
 #include "util/compare.h"
 #include "util/alg_ds/ds/lock_guard/lock_guard.h"
 #include "util/time_now_us.h"
+#include "lib/ep/e2ap_capture.h"
 
 #include "iapp_if_generic.h"
 #include "xapp_ric_id.h"
@@ -38,16 +39,42 @@ a* You may obtain a copy of the License at
 
 
 
+// The capture shows the RIC Request IDs as rewritten by the iApp. The note, 
+// sent along with the message, correlates both sides. NULL if not capturing
+static
+char const* note_e2_ric_req_id(char note[static E2AP_CAPTURE_NOTE_LEN], uint32_t e2_ric_req_id, xapp_ric_id_t const* x)
+{
+  if(enabled_e2ap_capture() == false)
+    return NULL;
+
+  int const rc = snprintf(note, E2AP_CAPTURE_NOTE_LEN, "E2 RIC_REQ_ID %u -> xApp %u RIC_REQ_ID %u", e2_ric_req_id, x->xapp_id, x->ric_id.ric_req_id);
+  assert(rc > -1);
+  return note;
+}
+
+static
+char const* note_xapp_ric_req_id(char note[static E2AP_CAPTURE_NOTE_LEN], uint16_t xapp_id, uint32_t ric_req_id)
+{
+  if(enabled_e2ap_capture() == false)
+    return NULL;
+
+  int const rc = snprintf(note, E2AP_CAPTURE_NOTE_LEN, "xApp %u RIC_REQ_ID %u", xapp_id, ric_req_id);
+  assert(rc > -1);
+  return note;
+}
+
 static
 bool check_valid_msg_type(e2_msg_type_t msg_type )
 {
   return 
          msg_type == RIC_SUBSCRIPTION_RESPONSE
+      || msg_type == RIC_SUBSCRIPTION_FAILURE
       || msg_type == E42_SETUP_REQUEST
       || msg_type == E42_RIC_SUBSCRIPTION_REQUEST
       || msg_type == E42_RIC_SUBSCRIPTION_DELETE_REQUEST
       || msg_type == E42_RIC_CONTROL_REQUEST
       || msg_type == RIC_CONTROL_ACKNOWLEDGE
+      || msg_type == RIC_CONTROL_FAILURE
       || msg_type == RIC_INDICATION
       || msg_type == RIC_SUBSCRIPTION_DELETE_RESPONSE;
 }
@@ -59,11 +86,13 @@ void init_handle_msg_iapp(size_t len, handle_msg_fp_iapp (*handle_msg)[len])
   memset((*handle_msg), 0, sizeof(handle_msg_fp_iapp)*len);
 
   (*handle_msg)[RIC_SUBSCRIPTION_RESPONSE] = e2ap_handle_subscription_response_iapp;
+  (*handle_msg)[RIC_SUBSCRIPTION_FAILURE] = e2ap_handle_subscription_failure_iapp;
   (*handle_msg)[E42_SETUP_REQUEST] = e2ap_handle_e42_setup_request_iapp;
   (*handle_msg)[E42_RIC_SUBSCRIPTION_REQUEST] = e2ap_handle_e42_ric_subscription_request_iapp;
   (*handle_msg)[E42_RIC_SUBSCRIPTION_DELETE_REQUEST] = e2ap_handle_e42_ric_subscription_delete_request_iapp;
   (*handle_msg)[E42_RIC_CONTROL_REQUEST] = e2ap_handle_e42_ric_control_request_iapp;
   (*handle_msg)[RIC_CONTROL_ACKNOWLEDGE] = e2ap_handle_e42_ric_control_ack_iapp;
+  (*handle_msg)[RIC_CONTROL_FAILURE] = e2ap_handle_e42_ric_control_failure_iapp;
   (*handle_msg)[RIC_INDICATION] = e2ap_handle_ric_indication_iapp;
   (*handle_msg)[RIC_SUBSCRIPTION_DELETE_RESPONSE] = e2ap_handle_subscription_delete_response_iapp;
 
@@ -83,6 +112,72 @@ void init_handle_msg_iapp(size_t len, handle_msg_fp_iapp (*handle_msg)[len])
 
 }
 
+// Moving transfers the ownership of resp
+static
+void send_subscription_response(e42_iapp_t* iapp, xapp_ric_id_t const* x, ric_subscription_response_t* resp)
+{
+  assert(iapp != NULL);
+  assert(x != NULL);
+  assert(resp != NULL);
+
+  e2ap_msg_t ans = {.type = RIC_SUBSCRIPTION_RESPONSE};
+  defer({ e2ap_msg_free_iapp(&iapp->ap, &ans);} );
+  ric_subscription_response_t* dst = &ans.u_msgs.ric_sub_resp;
+  *dst = mv_ric_subscription_respponse(resp);
+  char note[E2AP_CAPTURE_NOTE_LEN];
+  sctp_msg_t sctp_msg = {.note = note_e2_ric_req_id(note, dst->ric_id.ric_req_id, x)}; 
+  dst->ric_id = x->ric_id;
+
+  sctp_msg.info = find_map_xapps_sad(&iapp->ep.xapps, x->xapp_id);
+  sctp_msg.ba = e2ap_msg_enc_iapp(&iapp->ap, &ans); 
+  defer({ free_sctp_msg(&sctp_msg); } );
+       
+  e2ap_send_sctp_msg_iapp(&iapp->ep, &sctp_msg);
+}
+
+// note may be NULL
+static
+void send_subscription_failure(e42_iapp_t* iapp, xapp_ric_id_t const* x, cause_t cause, char const* note)
+{
+  assert(iapp != NULL);
+  assert(x != NULL);
+
+  e2ap_msg_t ans = {.type = RIC_SUBSCRIPTION_FAILURE,
+                    .u_msgs.ric_sub_fail = init_ric_subscription_failure(x->ric_id, cause) };
+  defer({ e2ap_msg_free_iapp(&iapp->ap, &ans);} );
+
+  sctp_msg_t sctp_msg = {.note = note}; 
+  sctp_msg.info = find_map_xapps_sad(&iapp->ep.xapps, x->xapp_id);
+  sctp_msg.ba = e2ap_msg_enc_iapp(&iapp->ap, &ans); 
+  defer({ free_sctp_msg(&sctp_msg); } );
+       
+  e2ap_send_sctp_msg_iapp(&iapp->ep, &sctp_msg);
+
+  printf("[iApp]: RIC_SUBSCRIPTION_FAILURE tx RAN_FUNC_ID %d RIC_REQ_ID %d \n", x->ric_id.ran_func_id, x->ric_id.ric_req_id);
+}
+
+// note may be NULL
+static
+void send_subscription_delete_response(e42_iapp_t* iapp, xapp_ric_id_t const* x, char const* note)
+{
+  assert(iapp != NULL);
+  assert(x != NULL);
+
+  e2ap_msg_t ans = {.type = RIC_SUBSCRIPTION_DELETE_RESPONSE };
+  defer( { e2ap_msg_free_iapp(&iapp->ap, &ans); } );
+  ric_subscription_delete_response_t* dst = &ans.u_msgs.ric_sub_del_resp;
+  dst->ric_id = x->ric_id;
+
+  sctp_msg_t sctp_msg = {.note = note};
+  sctp_msg.info = find_map_xapps_sad(&iapp->ep.xapps, x->xapp_id);
+  sctp_msg.ba = e2ap_msg_enc_iapp(&iapp->ap, &ans); 
+  defer({ free_sctp_msg(&sctp_msg); } );
+       
+  e2ap_send_sctp_msg_iapp(&iapp->ep, &sctp_msg);
+
+  printf("[iApp]: RIC_SUBSCRIPTION_DELETE_RESPONSE tx RAN_FUNC_ID %d RIC_REQ_ID %d \n", x->ric_id.ran_func_id, x->ric_id.ric_req_id);
+}
+
 e2ap_msg_t e2ap_handle_subscription_response_iapp(e42_iapp_t* iapp, const e2ap_msg_t* msg)
 {
   assert(iapp != NULL);
@@ -98,18 +193,64 @@ e2ap_msg_t e2ap_handle_subscription_response_iapp(e42_iapp_t* iapp, const e2ap_m
   assert(src->ric_id.ran_func_id == x.ric_id.ran_func_id);
   assert(src->ric_id.ric_inst_id == x.ric_id.ric_inst_id);
 
-  e2ap_msg_t ans = {.type = RIC_SUBSCRIPTION_RESPONSE};
-  defer({ e2ap_msg_free_iapp(&iapp->ap, &ans);} );
-  ric_subscription_response_t* dst = &ans.u_msgs.ric_sub_resp;
-  *dst = mv_ric_subscription_respponse(src);
-  dst->ric_id.ric_req_id = x.ric_id.ric_req_id;
+  if(x.xapp_id == CONSUMER_GROUP_XAPP_ID){
+    // Every member that asked for it gets its own copy
+    seq_arr_t arr = ack_consumer_group(&iapp->groups, src);
+    defer({ seq_arr_free(&arr, NULL); } );
+    for(size_t i = 0; i < seq_size(&arr); ++i){
+      xapp_ric_id_t const* m = seq_at(&arr, i);
+      ric_subscription_response_t tmp = cp_ric_subscription_respponse(src);
+      send_subscription_response(iapp, m, &tmp);
+    }
+    e2ap_msg_t none = {.type = NONE_E2_MSG_TYPE};
+    return none;
+  }
 
-  sctp_msg_t sctp_msg = {0}; 
-  sctp_msg.info = find_map_xapps_sad(&iapp->ep.xapps, x.xapp_id);
-  sctp_msg.ba = e2ap_msg_enc_iapp(&iapp->ap, &ans); 
-  defer({ free_sctp_msg(&sctp_msg); } );
-       
-  e2ap_send_sctp_msg_iapp(&iapp->ep, &sctp_msg);
+  send_subscription_response(iapp, &x, (ric_subscription_response_t*)src);
+
+  e2ap_msg_t none = {.type = NONE_E2_MSG_TYPE};
+  return none;
+}
+
+e2ap_msg_t e2ap_handle_subscription_failure_iapp(e42_iapp_t* iapp, const e2ap_msg_t* msg)
+{
+  assert(iapp != NULL);
+  assert(msg != NULL);
+  assert(msg->type == RIC_SUBSCRIPTION_FAILURE);
+
+  ric_subscription_failure_t const* src = &msg->u_msgs.ric_sub_fail; 
+
+  xapp_ric_id_xpct_t const xpctd = find_xapp_map_ric_id(&iapp->map_ric_id, src->ric_id.ric_req_id);
+  if(xpctd.has_value == false){
+    printf("[iApp]: SUBSCRIPTION FAILURE rx RAN_FUNC_ID %d RIC REQ ID %d but no xApp associated\n",  src->ric_id.ran_func_id, src->ric_id.ric_req_id);
+    e2ap_msg_t none = {.type = NONE_E2_MSG_TYPE};
+    return none;
+  }
+  xapp_ric_id_t const x = xpctd.xapp_ric_id; 
+
+  assert(src->ric_id.ran_func_id == x.ric_id.ran_func_id);
+  assert(src->ric_id.ric_inst_id == x.ric_id.ric_inst_id);
+
+  cause_t const cause = cause_ric_subscription_failure(src);
+  char note[E2AP_CAPTURE_NOTE_LEN];
+
+  if(x.xapp_id == CONSUMER_GROUP_XAPP_ID){
+    // Every member waiting for it
+    seq_arr_t arr = fail_consumer_group(&iapp->groups, src->ric_id.ric_req_id);
+    defer({ seq_arr_free(&arr, NULL); } );
+    for(size_t i = 0; i < seq_size(&arr); ++i){
+      xapp_ric_id_t const* m = seq_at(&arr, i);
+      send_subscription_failure(iapp, m, cause, note_e2_ric_req_id(note, src->ric_id.ric_req_id, m));
+    }
+  } else {
+    send_subscription_failure(iapp, &x, cause, note_e2_ric_req_id(note, src->ric_id.ric_req_id, &x));
+  }
+
+  rm_map_ric_id(&iapp->map_ric_id, &x);
+
+  rm_ind_filter(&iapp->filters, src->ric_id.ric_req_id);
+
+  rm_ind_overload(&iapp->overloads, src->ric_id.ric_req_id);
 
   e2ap_msg_t none = {.type = NONE_E2_MSG_TYPE};
   return none;
@@ -138,21 +279,21 @@ e2ap_msg_t e2ap_handle_subscription_delete_response_iapp(e42_iapp_t* iapp, const
   assert(src->ric_id.ran_func_id == x.ric_id.ran_func_id);
   assert(src->ric_id.ric_inst_id == x.ric_id.ric_inst_id);
 
-  e2ap_msg_t ans = {.type = RIC_SUBSCRIPTION_DELETE_RESPONSE };
-  defer( { e2ap_msg_free_iapp(&iapp->ap, &ans); } );
-  ric_subscription_delete_response_t* dst = &ans.u_msgs.ric_sub_del_resp;
-  dst->ric_id = x.ric_id;
+  char note[E2AP_CAPTURE_NOTE_LEN];
+  if(x.xapp_id == CONSUMER_GROUP_XAPP_ID){
+    // The last member may have left in between
+    xapp_ric_id_xpct_t const last = del_consumer_group(&iapp->groups, src->ric_id.ric_req_id);
+    if(last.has_value == true)
+      send_subscription_delete_response(iapp, &last.xapp_ric_id, note_e2_ric_req_id(note, src->ric_id.ric_req_id, &last.xapp_ric_id));
+  } else {
+    send_subscription_delete_response(iapp, &x, note_e2_ric_req_id(note, src->ric_id.ric_req_id, &x));
+  }
 
-  sctp_msg_t sctp_msg = {0};
-  sctp_msg.info = find_map_xapps_sad(&iapp->ep.xapps, x.xapp_id);
-  sctp_msg.ba = e2ap_msg_enc_iapp(&iapp->ap, &ans); 
-  defer({ free_sctp_msg(&sctp_msg); } );
-       
-  e2ap_send_sctp_msg_iapp(&iapp->ep, &sctp_msg);
+  rm_map_ric_id(&iapp->map_ric_id, &x);
 
-  printf("[iApp]: RIC_SUBSCRIPTION_DELETE_RESPONSE tx RAN_FUNC_ID %d RIC_REQ_ID %d \n", x.ric_id.ran_func_id, x.ric_id.ric_req_id);
+  rm_ind_filter(&iapp->filters, src->ric_id.ric_req_id);
 
-  rm_map_ric_id(&iapp->map_ric_id, &x);
+  rm_ind_overload(&iapp->overloads, src->ric_id.ric_req_id);
 
   e2ap_msg_t none = {.type = NONE_E2_MSG_TYPE};
   return none;
@@ -187,6 +328,8 @@ e2ap_msg_t e2ap_handle_e42_ric_control_ack_iapp(e42_iapp_t* iapp, const e2ap_msg
   sctp_msg.ba = e2ap_msg_enc_iapp(&iapp->ap, &ans); 
   defer({ free_sctp_msg(&sctp_msg); } );
        
+  char note[E2AP_CAPTURE_NOTE_LEN];
+  sctp_msg.note = note_e2_ric_req_id(note, src->ric_id.ric_req_id, &x);
   e2ap_send_sctp_msg_iapp(&iapp->ep, &sctp_msg);
 
   printf("[iApp]: RIC_CONTROL_ACKNOWLEDGE tx\n");
@@ -197,6 +340,49 @@ e2ap_msg_t e2ap_handle_e42_ric_control_ack_iapp(e42_iapp_t* iapp, const e2ap_msg
   return none;
 }
 
+e2ap_msg_t e2ap_handle_e42_ric_control_failure_iapp(e42_iapp_t* iapp, const e2ap_msg_t* msg)
+{
+  assert(iapp != NULL);
+  assert(msg != NULL);
+  assert(msg->type == RIC_CONTROL_FAILURE);
+
+  ric_control_failure_t const* src = &msg->u_msgs.ric_ctrl_fail; 
+
+  ric_request_type_e type = END_RIC_REQUEST_TYPE;
+  xapp_ric_id_xpct_t const xpctd = try_rm_map_ric_id(&iapp->map_ric_id, src->ric_id.ric_req_id, &type);
+  if(xpctd.has_value == false){
+    // NAck control already out of the window, or a control from the RIC itself
+    printf("[iApp]: RIC_CONTROL_FAILURE rx for unknown RIC_REQ_ID %d. Discarding\n", src->ric_id.ric_req_id);
+    e2ap_msg_t none = {.type = NONE_E2_MSG_TYPE};
+    return none;
+  }
+  xapp_ric_id_t const x = xpctd.xapp_ric_id; 
+  assert(type == CONTROL_RIC_REQUEST_TYPE || type == NACK_CONTROL_RIC_REQUEST_TYPE);
+
+  e2ap_msg_t ans = {.type = RIC_CONTROL_FAILURE};
+  ric_control_failure_t* dst = &ans.u_msgs.ric_ctrl_fail;
+  dst->ric_id = x.ric_id;
+  dst->cause = src->cause;
+
+  sctp_msg_t sctp_msg = {0};
+  sctp_msg.info = find_map_xapps_sad(&iapp->ep.xapps, x.xapp_id);
+  sctp_msg.ba = e2ap_msg_enc_iapp(&iapp->ap, &ans); 
+  defer({ free_sctp_msg(&sctp_msg); } );
+       
+  char note[E2AP_CAPTURE_NOTE_LEN];
+  sctp_msg.note = note_e2_ric_req_id(note, src->ric_id.ric_req_id, &x);
+  e2ap_send_sctp_msg_iapp(&iapp->ep, &sctp_msg);
+
+  printf("[iApp]: RIC_CONTROL_FAILURE tx\n");
+
+  // Ack controls are released by the RIC along with the pending event 
+  if(type == NACK_CONTROL_RIC_REQUEST_TYPE)
+    release_ric_control_request_gen(iapp->ric_if.type, src->ric_id.ric_req_id);
+
+  e2ap_msg_t none = {.type = NONE_E2_MSG_TYPE};
+  return none;
+}
+
 static
 e42_setup_response_t generate_setup_response(e42_iapp_t* iapp, e42_setup_request_t const* req)
 {
@@ -212,10 +398,36 @@ e42_setup_response_t generate_setup_response(e42_iapp_t* iapp, e42_setup_request
   e2_node_arr_t ans = generate_e2_node_arr( &iapp->e2_nodes); 
 
 
-  e42_setup_response_t sr = {.xapp_id = iapp->xapp_id++,
+  e42_setup_response_t sr = {.xapp_id = iapp->xapp_id,
                              .len_e2_nodes_conn = ans.len,
                              .nodes = ans.n};
 
+  if(req->token == NULL){
+    iapp->xapp_id++;
+  } else {
+    xapp_session_ans_t const s = attach_xapp_session(&iapp->sessions, *req->token, iapp->xapp_id);
+    sr.xapp_id = s.xapp_id;
+
+    if(s.type == NEW_XAPP_SESSION){
+      iapp->xapp_id++;
+    } else if(s.type == RESUMED_XAPP_SESSION){
+      // The new association replaces the old one when the E42 Setup Response is sent
+      printf("[iApp]: xApp %d resumed its session. %lu indications lost while detached\n", s.xapp_id, s.lost_ind);
+    } else if(s.type == RESTARTED_XAPP_SESSION){
+      printf("[iApp]: xApp %d restarted as xApp %d. Removing its old subscriptions\n", s.old_xapp_id, s.xapp_id);
+      iapp->xapp_id++;
+      rm_pending_subs_iapp(iapp, s.old_xapp_id);
+      rm_xapp_near_ric_gen(iapp->ric_if.type, s.old_xapp_id);
+    } else {
+      assert(0!=0 && "Unknown xApp session type");
+    }
+  }
+
+  add_xapp_near_ric_gen(iapp->ric_if.type, sr.xapp_id, iapp->xapp_id, req->token);
+
+  if(req->group != NULL)
+    join_consumer_group(&iapp->groups, sr.xapp_id, *req->group);
+
   return sr;
 }
 
@@ -229,6 +441,14 @@ e2ap_msg_t e2ap_handle_e42_setup_request_iapp(e42_iapp_t* iapp, const e2ap_msg_t
 
   printf("[iApp]: E42 SETUP-REQUEST rx\n");
 
+  // The E42 SETUP-RESPONSE carries at least one E2 Node, e.g., not the case
+  // right after a restart. The xApp retries with backoff
+  if(sz_reg_e2_node(&iapp->e2_nodes) == 0){
+    printf("[iApp]: No E2 Node connected. E42 SETUP-REQUEST not answered\n");
+    e2ap_msg_t ans = {.type = NONE_E2_MSG_TYPE};
+    return ans;
+  }
+
   e2ap_msg_t ans = {.type = E42_SETUP_RESPONSE };
   ans.u_msgs.e42_stp_resp = generate_setup_response(iapp, req); 
 
@@ -237,6 +457,25 @@ e2ap_msg_t e2ap_handle_e42_setup_request_iapp(e42_iapp_t* iapp, const e2ap_msg_t
   return ans;
 }
 
+// The members of a consumer group share the UEs of an indication stream
+static
+bool route_consumer_group_iapp(e42_iapp_t* iapp, ric_indication_t const* src, xapp_ric_id_t* dst)
+{
+  sm_ric_t const* sm = sm_near_ric_gen(iapp->ric_if.type, src->ric_id.ran_func_id);
+
+  byte_array_t ue = {0};
+  if(sm->conflate.key != NULL){
+    sm_ind_data_t const ind = {.ind_hdr = src->hdr.buf,
+                               .len_hdr = src->hdr.len,
+                               .ind_msg = src->msg.buf,
+                               .len_msg = src->msg.len};
+    ue = sm->conflate.key(sm, &ind);
+  }
+  defer({ free_byte_array(ue); });
+
+  return route_consumer_group(&iapp->groups, src->ric_id.ric_req_id, ue, dst);
+}
+
 e2ap_msg_t e2ap_handle_ric_indication_iapp(e42_iapp_t* iapp, const e2ap_msg_t* msg)
 {
   assert(iapp != NULL);
@@ -253,23 +492,59 @@ e2ap_msg_t e2ap_handle_ric_indication_iapp(e42_iapp_t* iapp, const e2ap_msg_t* m
     return none;
   }
   
-  xapp_ric_id_t const x = xpctd.xapp_ric_id; 
+  xapp_ric_id_t x = xpctd.xapp_ric_id; 
 
   assert(src->ric_id.ran_func_id == x.ric_id.ran_func_id);
   assert(src->ric_id.ric_inst_id == x.ric_id.ric_inst_id);
 
+  if(x.xapp_id == CONSUMER_GROUP_XAPP_ID && route_consumer_group_iapp(iapp, src, &x) == false){
+    // No member answered yet, or all of them left
+    e2ap_msg_t none = {.type = NONE_E2_MSG_TYPE};
+    return none;
+  }
+
+  // The xApp is detached, but its session is still alive
+  if(lost_ind_xapp_session(&iapp->sessions, x.xapp_id) == true){
+    e2ap_msg_t none = {.type = NONE_E2_MSG_TYPE};
+    return none;
+  }
+
   e2ap_msg_t ans = {.type = RIC_INDICATION};
   defer( { e2ap_msg_free_iapp(&iapp->ap, &ans); } );
   ric_indication_t* dst = &ans.u_msgs.ric_ind;
   // Moving transfers ownership
   *dst = mv_ric_indication((ric_indication_t*)src);
-  dst->ric_id.ric_req_id = x.ric_id.ric_req_id;
+
+  // Nothing the xApp asked for
+  if(apply_ind_filter(&iapp->filters, dst) == false){
+    e2ap_msg_t none = {.type = NONE_E2_MSG_TYPE};
+    return none;
+  }
+
+  dst->ric_id = x.ric_id;
 
   sctp_msg_t sctp_msg = {0}; 
-  sctp_msg.info = find_map_xapps_sad(&iapp->ep.xapps, x.xapp_id);
   sctp_msg.ba = e2ap_msg_enc_iapp(&iapp->ap, &ans); 
   defer({ free_sctp_msg(&sctp_msg); } );
 
+  // Queued if the xApp selected an overload policy
+  sm_ind_data_t const ind = {.ind_hdr = dst->hdr.buf,
+                             .len_hdr = dst->hdr.len,
+                             .ind_msg = dst->msg.buf,
+                             .len_msg = dst->msg.len};
+  if(push_ind_overload(&iapp->overloads, time_now_us(), src->ric_id.ric_req_id, x.xapp_id, &ind, &sctp_msg.ba) == true){
+    e2ap_msg_t none = {.type = NONE_E2_MSG_TYPE};
+    return none;
+  }
+
+  // A session restored from the primary nearRT-RIC is attached before the
+  // association of the xApp is registered, i.e., when the E42 SETUP-RESPONSE is sent
+  if(try_find_map_xapps_sad(&iapp->ep.xapps, x.xapp_id, &sctp_msg.info) == false){
+    e2ap_msg_t none = {.type = NONE_E2_MSG_TYPE};
+    return none;
+  }
+  char note[E2AP_CAPTURE_NOTE_LEN];
+  sctp_msg.note = note_e2_ric_req_id(note, src->ric_id.ric_req_id, &x);
   e2ap_send_sctp_msg_iapp(&iapp->ep, &sctp_msg);
 
   e2ap_msg_t none = {.type = NONE_E2_MSG_TYPE};
@@ -316,13 +591,24 @@ e2ap_msg_t e2ap_handle_e42_ric_subscription_delete_request_iapp(e42_iapp_t* iapp
                       .xapp_id = src->xapp_id 
                     };
 
+  cg_unsub_ans_t const u = unsub_consumer_group(&iapp->groups, &x);
+  if(u.type == LEFT_UNSUB_SHARED_SUB){
+    // Other members still use it 
+    e2ap_msg_t ans = {.type = RIC_SUBSCRIPTION_DELETE_RESPONSE};
+    ans.u_msgs.ric_sub_del_resp.ric_id = x.ric_id;
+    return ans;
+  } else if(u.type == LAST_UNSUB_SHARED_SUB){
+    x = u.shared;
+  }
+
   e2_node_ric_id_t n = find_ric_req_map_ric_id(&iapp->map_ric_id, &x);
   assert(n.ric_req_type == SUBSCRIPTION_RIC_REQUEST_TYPE);
 
   ric_subscription_delete_request_t dst = cp_ric_subscription_delete_request(&src->sdr);
-  dst.ric_id.ric_req_id = n.ric_id.ric_req_id;
+  dst.ric_id = n.ric_id;
 
-  fwd_ric_subscription_request_delete_gen(iapp->ric_if.type, &n.e2_node_id, &dst, notify_msg_iapp_api);
+  char note[E2AP_CAPTURE_NOTE_LEN];
+  fwd_ric_subscription_request_delete_gen(iapp->ric_if.type, &n.e2_node_id, &dst, note_xapp_ric_req_id(note, src->xapp_id, src->sdr.ric_id.ric_req_id), notify_msg_iapp_api);
 
   printf("[iApp]: RIC_SUBSCRIPTION_DELETE_REQUEST tx RIC_REQ_ID %d \n",n.ric_id.ric_req_id);
 
@@ -345,12 +631,75 @@ e2ap_msg_t e2ap_handle_e42_ric_subscription_request_iapp(e42_iapp_t* iapp, const
   xapp_ric_id_t xapp_ric_id = {.ric_id = e42_sr->sr.ric_id,
                                 .xapp_id = e42_sr->xapp_id };
 
+  cg_sub_ans_t const cg = sub_consumer_group(&iapp->groups, &xapp_ric_id, &e42_sr->id, &e42_sr->sr);
+  if(cg.type == JOINED_SHARED_SUB){
+    printf("[iApp]: xApp %d joined a shared subscription RAN_FUNC_ID %d \n", xapp_ric_id.xapp_id, xapp_ric_id.ric_id.ran_func_id);
+    e2ap_msg_t ans = {.type = RIC_SUBSCRIPTION_RESPONSE};
+    ans.u_msgs.ric_sub_resp = cg.resp;
+    return ans;
+  } else if(cg.type == PENDING_SHARED_SUB){
+    e2ap_msg_t ans = {.type = NONE_E2_MSG_TYPE};
+    return ans;
+  } else if(cg.type == DUP_SHARED_SUB){
+    printf("[iApp]: xApp %d reused RIC_REQ_ID %d in a shared subscription. Rejected\n", xapp_ric_id.xapp_id, xapp_ric_id.ric_id.ric_req_id);
+    cause_t const cause = {.present = CAUSE_RICREQUEST, .ricRequest = CAUSE_RIC_DUPLICATE_ACTION};
+    e2ap_msg_t ans = {.type = RIC_SUBSCRIPTION_FAILURE, 
+                      .u_msgs.ric_sub_fail = init_ric_subscription_failure(e42_sr->sr.ric_id, cause) };
+    return ans;
+  }
+
+  // The filter and the overload policy are evaluated here, the E2 Node never sees them
+  byte_array_t const* ba_filter = NULL;
+  byte_array_t const* ba_overload = NULL;
+  ric_subscription_request_t const sr = split_ind_filter(&e42_sr->sr, &ba_filter, &ba_overload);
+  defer({ free(sr.action); });
+  sm_ric_t const* sm = NULL;
+  if(ba_filter != NULL || ba_overload != NULL)
+    sm = sm_near_ric_gen(iapp->ric_if.type, sr.ric_id.ran_func_id);
+  void* filter = NULL;
+  if(ba_filter != NULL){
+    if(sm->filter.compile != NULL)
+      filter = sm->filter.compile(sm, *ba_filter);
+    if(filter == NULL)
+      printf("[iApp]: Indication filter rejected by RAN_FUNC_ID %d. Forwarding every record\n", sr.ric_id.ran_func_id);
+  }
+  overload_conf_t overload = {0};
+  bool const has_overload = ba_overload != NULL && parse_overload_conf(*ba_overload, &overload);
+  if(ba_overload != NULL && has_overload == false)
+    printf("[iApp]: Malformed overload policy for RAN_FUNC_ID %d. Sending every indication\n", sr.ric_id.ran_func_id);
 
   // I do not like the mtx here but there is a data race if not
   int rc = pthread_rwlock_wrlock(&iapp->map_ric_id.rw); 
   assert(rc == 0);
 
-  uint16_t const new_ric_id = fwd_ric_subscription_request_gen(iapp->ric_if.type, &e42_sr->id, &e42_sr->sr, notify_msg_iapp_api);
+  char note[E2AP_CAPTURE_NOTE_LEN];
+  uint32_t const new_ric_id = fwd_ric_subscription_request_gen(iapp->ric_if.type, &e42_sr->id, &sr, note_xapp_ric_req_id(note, e42_sr->xapp_id, e42_sr->sr.ric_id.ric_req_id), notify_msg_iapp_api);
+
+  if(new_ric_id == RIC_REQ_ID_NONE){
+    rc = pthread_rwlock_unlock(&iapp->map_ric_id.rw); 
+    assert(rc == 0);
+
+    if(filter != NULL)
+      sm->filter.free(sm, filter);
+
+    printf("[iApp]: RIC Request IDs exhausted. SUBSCRIPTION-REQUEST RAN_FUNC_ID %d not forwarded\n", sr.ric_id.ran_func_id);
+    cause_t const cause = {.present = CAUSE_RICSERVICE, .ricService = CAUSE_RICSERVICE_RIC_RESOURCE_LIMIT};
+
+    if(cg.type == NEW_SHARED_SUB){
+      // The members that joined in between fail too
+      seq_arr_t arr = abort_consumer_group(&iapp->groups, &xapp_ric_id);
+      defer({ seq_arr_free(&arr, NULL); } );
+      for(size_t i = 0; i < seq_size(&arr); ++i)
+        send_subscription_failure(iapp, seq_at(&arr, i), cause, NULL);
+
+      e2ap_msg_t ans = {.type = NONE_E2_MSG_TYPE};
+      return ans; 
+    }
+
+    e2ap_msg_t ans = {.type = RIC_SUBSCRIPTION_FAILURE, 
+                      .u_msgs.ric_sub_fail = init_ric_subscription_failure(e42_sr->sr.ric_id, cause) };
+    return ans; 
+  }
 
   e2_node_ric_id_t n = { .ric_id = e42_sr->sr.ric_id, //  new_ric_id,
                           .e2_node_id = cp_global_e2_node_id(&e42_sr->id), 
@@ -358,8 +707,19 @@ e2ap_msg_t e2ap_handle_e42_ric_subscription_request_iapp(e42_iapp_t* iapp, const
 
   n.ric_id.ric_req_id = new_ric_id;
 
+  if(cg.type == NEW_SHARED_SUB){
+    set_ric_req_id_consumer_group(&iapp->groups, &xapp_ric_id, new_ric_id);
+    xapp_ric_id = (xapp_ric_id_t){.ric_id = n.ric_id, .xapp_id = CONSUMER_GROUP_XAPP_ID};
+  }
 
   add_map_ric_id(&iapp->map_ric_id, &n, &xapp_ric_id);
+
+  if(filter != NULL)
+    add_ind_filter(&iapp->filters, new_ric_id, &e42_sr->id, sm, filter);
+
+  if(has_overload == true)
+    add_ind_overload(&iapp->overloads, new_ric_id, &e42_sr->id, sm, overload);
+
   rc = pthread_rwlock_unlock(&iapp->map_ric_id.rw); 
   assert(rc == 0);
 
@@ -370,6 +730,56 @@ e2ap_msg_t e2ap_handle_e42_ric_subscription_request_iapp(e42_iapp_t* iapp, const
 }
 
 // xApp -> iApp
+// A successful NAck control never produces an answer. When the window is full, 
+// the oldest one is considered successful and its RIC Request ID released
+static
+void push_nack_ctrl(e42_iapp_t* iapp, uint32_t ric_req_id)
+{
+  assert(iapp != NULL);
+  assert(iapp->nack_ctrl_len <= NACK_CTRL_WINDOW_IAPP);
+
+  if(iapp->nack_ctrl_len == NACK_CTRL_WINDOW_IAPP){
+    uint32_t const old = iapp->nack_ctrl[iapp->nack_ctrl_pos];
+
+    // It may have already been removed by a RIC Control Failure or an E2 Node disconnection  
+    ric_request_type_e type = END_RIC_REQUEST_TYPE;
+    xapp_ric_id_xpct_t const x = try_rm_map_ric_id(&iapp->map_ric_id, old, &type);
+    if(x.has_value == true){
+      assert(type == NACK_CONTROL_RIC_REQUEST_TYPE);
+      release_ric_control_request_gen(iapp->ric_if.type, old);
+    }
+  } else {
+    iapp->nack_ctrl_len += 1;
+  }
+
+  iapp->nack_ctrl[iapp->nack_ctrl_pos] = ric_req_id;
+  iapp->nack_ctrl_pos = (iapp->nack_ctrl_pos + 1) % NACK_CTRL_WINDOW_IAPP;
+}
+
+// Returns false if the control conflicts with the ones of other xApps and the policy rejects it
+static
+bool check_ctrl_conflict_iapp(e42_iapp_t* iapp, e42_ric_control_request_t const* cr)
+{
+  if(iapp->conflicts.enabled == false)
+    return true;
+
+  uint16_t const ran_func_id = cr->ctrl_req.ric_id.ran_func_id;
+  sm_ric_t const* sm = sm_near_ric_gen(iapp->ric_if.type, ran_func_id);
+  if(sm->conflict.targets == NULL)
+    return true;
+
+  sm_ctrl_req_data_t const src = {.ctrl_hdr = cr->ctrl_req.hdr.buf, .len_hdr = cr->ctrl_req.hdr.len,
+                                  .ctrl_msg = cr->ctrl_req.msg.buf, .len_msg = cr->ctrl_req.msg.len};
+  sm_ctrl_target_t* t = NULL;
+  size_t const len = sm->conflict.targets(sm, &src, &t);
+  defer({ free_sm_ctrl_targets(len, t); });
+
+  byte_array_t identity = identity_xapp_session(&iapp->sessions, cr->xapp_id);
+  defer({ free_byte_array(identity); });
+
+  return check_ctrl_conflict(&iapp->conflicts, time_now_us(), &cr->id, ran_func_id, cr->xapp_id, identity, len, t);
+}
+
 e2ap_msg_t e2ap_handle_e42_ric_control_request_iapp(e42_iapp_t* iapp, const e2ap_msg_t* msg)
 {
   assert(iapp != NULL);
@@ -384,22 +794,65 @@ e2ap_msg_t e2ap_handle_e42_ric_control_request_iapp(e42_iapp_t* iapp, const e2ap
   xapp_ric_id_t xapp_ric_id = {.ric_id = e42_cr->ctrl_req.ric_id,
                                 .xapp_id = e42_cr->xapp_id};
 
+  ric_control_ack_req_t const* ack = e42_cr->ctrl_req.ack_req;
+
+  if(check_ctrl_conflict_iapp(iapp, e42_cr) == false){
+    printf("[iApp]: E42_RIC_CONTROL_REQUEST from xApp %d rejected. Conflicting control\n", e42_cr->xapp_id);
+    // Fire-and-forget controls never hear back
+    if(ack != NULL && *ack == RIC_CONTROL_REQUEST_NO_ACK){
+      e2ap_msg_t ans = {.type = NONE_E2_MSG_TYPE};
+      return ans; 
+    }
+
+    e2ap_msg_t ans = {.type = RIC_CONTROL_FAILURE};
+    ans.u_msgs.ric_ctrl_fail.ric_id = e42_cr->ctrl_req.ric_id;
+    ans.u_msgs.ric_ctrl_fail.cause.present = CAUSE_MISC;
+    ans.u_msgs.ric_ctrl_fail.cause.misc = CAUSE_MISC_OM_INTERVENTION;
+    return ans;
+  }
+
+  // Fire-and-forget. Nothing comes back, so nothing to map 
+  if(ack != NULL && *ack == RIC_CONTROL_REQUEST_NO_ACK){
+    char note[E2AP_CAPTURE_NOTE_LEN];
+    fwd_ric_control_request_gen(iapp->ric_if.type, &e42_cr->id, &e42_cr->ctrl_req, note_xapp_ric_req_id(note, e42_cr->xapp_id, e42_cr->ctrl_req.ric_id.ric_req_id), notify_msg_iapp_api);
+    e2ap_msg_t ans = {.type = NONE_E2_MSG_TYPE};
+    return ans; 
+  }
+
+  bool const nack = ack != NULL && *ack == RIC_CONTROL_REQUEST_NACK;
+
   // I do not like the mtx here but there is a data race if not
   int rc = pthread_rwlock_wrlock(&iapp->map_ric_id.rw); 
   assert(rc == 0);
 
-  uint16_t new_ric_id = fwd_ric_control_request_gen(iapp->ric_if.type, &e42_cr->id, &e42_cr->ctrl_req, notify_msg_iapp_api);
+  char note[E2AP_CAPTURE_NOTE_LEN];
+  uint32_t const new_ric_id = fwd_ric_control_request_gen(iapp->ric_if.type, &e42_cr->id, &e42_cr->ctrl_req, note_xapp_ric_req_id(note, e42_cr->xapp_id, e42_cr->ctrl_req.ric_id.ric_req_id), notify_msg_iapp_api);
+
+  if(new_ric_id == RIC_REQ_ID_NONE){
+    rc = pthread_rwlock_unlock(&iapp->map_ric_id.rw); 
+    assert(rc == 0);
+
+    printf("[iApp]: RIC Request IDs exhausted. E42_RIC_CONTROL_REQUEST from xApp %d not forwarded\n", e42_cr->xapp_id);
+    e2ap_msg_t ans = {.type = RIC_CONTROL_FAILURE};
+    ans.u_msgs.ric_ctrl_fail.ric_id = e42_cr->ctrl_req.ric_id;
+    ans.u_msgs.ric_ctrl_fail.cause.present = CAUSE_RICSERVICE;
+    ans.u_msgs.ric_ctrl_fail.cause.ricService = CAUSE_RICSERVICE_RIC_RESOURCE_LIMIT;
+    return ans;
+  }
 
   e2_node_ric_id_t n = { .ric_id = e42_cr->ctrl_req.ric_id, //  new_ric_id,
                           .e2_node_id = cp_global_e2_node_id(&e42_cr->id),
-                          .ric_req_type = CONTROL_RIC_REQUEST_TYPE }; 
+                          .ric_req_type = nack ? NACK_CONTROL_RIC_REQUEST_TYPE : CONTROL_RIC_REQUEST_TYPE }; 
   n.ric_id.ric_req_id = new_ric_id;
 
   add_map_ric_id(&iapp->map_ric_id, &n, &xapp_ric_id);
   rc = pthread_rwlock_unlock(&iapp->map_ric_id.rw); 
   assert(rc == 0);
 
-  printf("[iApp]: E42_RIC_CONTROL_REQUEST rx\n");
+  if(nack)
+    push_nack_ctrl(iapp, new_ric_id);
+  else
+    printf("[iApp]: E42_RIC_CONTROL_REQUEST rx\n");
 
   e2ap_msg_t ans = {.type = NONE_E2_MSG_TYPE};
   return ans; 
@@ -48,6 +48,9 @@ e2ap_msg_t e2ap_handle_control_request_iapp(e42_iapp_t* ag, const e2ap_msg_t* ms
 // E2 -> RIC
 e2ap_msg_t e2ap_handle_subscription_response_iapp(e42_iapp_t* ag, const e2ap_msg_t* msg);
 
+// E2 -> RIC
+e2ap_msg_t e2ap_handle_subscription_failure_iapp(e42_iapp_t* ag, const e2ap_msg_t* msg);
+
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // O-RAN E2APv01.01: Messages for Global Procedures ///////////////////////////////////////////////
@@ -118,5 +121,8 @@ e2ap_msg_t e2ap_handle_subscription_delete_response_iapp( e42_iapp_t* iapp, cons
 // iApp -> xApp 
 e2ap_msg_t e2ap_handle_e42_ric_control_ack_iapp(e42_iapp_t* iapp, const e2ap_msg_t* msg);
 
+// iApp -> xApp 
+e2ap_msg_t e2ap_handle_e42_ric_control_failure_iapp(e42_iapp_t* iapp, const e2ap_msg_t* msg);
+
 #endif
 
@@ -0,0 +1,226 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+
+#include "xapp_session.h"
+
+#include "../../util/alg_ds/ds/lock_guard/lock_guard.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+static
+void free_xapp_session(void* it)
+{
+  assert(it != NULL);
+  xapp_session_t* s = (xapp_session_t*)it; 
+  free_byte_array(s->identity);
+  free_byte_array(s->instance);
+}
+
+// <identity>/<instance>. Without '/', the whole token is the identity
+static
+void split_token(byte_array_t token, byte_array_t* identity, byte_array_t* instance)
+{
+  size_t pos = token.len;
+  for(size_t i = token.len; i > 0; --i){
+    if(token.buf[i-1] == '/'){
+      pos = i - 1;
+      break;
+    }
+  }
+
+  *identity = (byte_array_t){.len = pos, .buf = token.buf};
+  if(pos < token.len)
+    *instance = (byte_array_t){.len = token.len - pos - 1, .buf = token.buf + pos + 1};
+  else
+    *instance = (byte_array_t){.len = 0, .buf = NULL};
+}
+
+static
+xapp_session_t* find_xapp_id(xapp_sessions_t* s, uint16_t xapp_id)
+{
+  void* it = seq_front(&s->arr);
+  void* end = seq_end(&s->arr);
+  while(it != end){
+    xapp_session_t* x = (xapp_session_t*)it;
+    if(x->xapp_id == xapp_id)
+      return x;
+    it = seq_next(&s->arr, it);
+  }
+  return NULL;
+}
+
+void init_xapp_sessions(xapp_sessions_t* s)
+{
+  assert(s != NULL);
+
+  seq_init(&s->arr, sizeof(xapp_session_t));
+
+  pthread_mutexattr_t const* attr = NULL;
+  int const rc = pthread_mutex_init(&s->mtx, attr);
+  assert(rc == 0);
+}
+
+void free_xapp_sessions(xapp_sessions_t* s)
+{
+  assert(s != NULL);
+
+  seq_free(&s->arr, free_xapp_session);
+
+  int const rc = pthread_mutex_destroy(&s->mtx);
+  assert(rc == 0);
+}
+
+xapp_session_ans_t attach_xapp_session(xapp_sessions_t* s, byte_array_t token, uint16_t new_xapp_id)
+{
+  assert(s != NULL);
+  assert(token.len > 0 && token.buf != NULL);
+
+  byte_array_t identity = {0};
+  byte_array_t instance = {0};
+  split_token(token, &identity, &instance);
+
+  lock_guard(&s->mtx);
+
+  void* it = seq_front(&s->arr);
+  void* end = seq_end(&s->arr);
+  while(it != end){
+    xapp_session_t* x = (xapp_session_t*)it;
+    if(eq_byte_array(&x->identity, &identity) == false){
+      it = seq_next(&s->arr, it);
+      continue;
+    }
+
+    xapp_session_ans_t ans = {.lost_ind = x->lost_ind};
+    if(eq_byte_array(&x->instance, &instance) == true){
+      ans.type = RESUMED_XAPP_SESSION; 
+      ans.xapp_id = x->xapp_id;
+    } else {
+      ans.type = RESTARTED_XAPP_SESSION; 
+      ans.xapp_id = new_xapp_id;
+      ans.old_xapp_id = x->xapp_id;
+
+      free_byte_array(x->instance);
+      x->instance = copy_byte_array(instance);
+      x->xapp_id = new_xapp_id;
+    }
+
+    x->attached = true;
+    x->lost_ind = 0;
+    return ans;
+  }
+
+  xapp_session_t x = {.identity = copy_byte_array(identity),
+                      .instance = copy_byte_array(instance),
+                      .xapp_id = new_xapp_id,
+                      .attached = true};
+  seq_push_back(&s->arr, &x, sizeof(x));
+
+  xapp_session_ans_t ans = {.type = NEW_XAPP_SESSION, .xapp_id = new_xapp_id};
+  return ans;
+}
+
+bool detach_xapp_session(xapp_sessions_t* s, uint16_t xapp_id, int64_t now)
+{
+  assert(s != NULL);
+
+  lock_guard(&s->mtx);
+
+  xapp_session_t* x = find_xapp_id(s, xapp_id);
+  if(x == NULL)
+    return false;
+
+  x->attached = false;
+  x->detach_tstamp = now;
+  return true;
+}
+
+bool rm_xapp_session(xapp_sessions_t* s, uint16_t xapp_id)
+{
+  assert(s != NULL);
+
+  lock_guard(&s->mtx);
+
+  xapp_session_t* x = find_xapp_id(s, xapp_id);
+  if(x == NULL)
+    return false;
+
+  free_xapp_session(x);
+  seq_erase(&s->arr, x, seq_next(&s->arr, x));
+  return true;
+}
+
+byte_array_t identity_xapp_session(xapp_sessions_t* s, uint16_t xapp_id)
+{
+  assert(s != NULL);
+
+  lock_guard(&s->mtx);
+
+  xapp_session_t* x = find_xapp_id(s, xapp_id);
+  if(x == NULL)
+    return (byte_array_t){.len = 0, .buf = NULL};
+
+  return copy_byte_array(x->identity);
+}
+
+bool lost_ind_xapp_session(xapp_sessions_t* s, uint16_t xapp_id)
+{
+  assert(s != NULL);
+
+  lock_guard(&s->mtx);
+
+  xapp_session_t* x = find_xapp_id(s, xapp_id);
+  if(x == NULL || x->attached == true)
+    return false;
+
+  x->lost_ind += 1;
+  return true;
+}
+
+size_t expire_xapp_session(xapp_sessions_t* s, int64_t now, int64_t grace_us, size_t len, uint16_t xapp_id[len])
+{
+  assert(s != NULL);
+  assert(grace_us > 0);
+
+  lock_guard(&s->mtx);
+
+  size_t n = 0;
+  size_t i = 0;
+  while(i < seq_size(&s->arr) && n < len){
+    xapp_session_t* x = (xapp_session_t*)seq_at(&s->arr, i);
+    if(x->attached == true || now - x->detach_tstamp < grace_us){
+      i += 1;
+      continue;
+    }
+
+    xapp_id[n] = x->xapp_id;
+    n += 1;
+
+    free_xapp_session(x);
+    // The array may shrink, so the index is kept instead of the iterator 
+    seq_erase(&s->arr, x, seq_next(&s->arr, x));
+  }
+
+  return n;
+}
+
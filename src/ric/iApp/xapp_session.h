@@ -0,0 +1,99 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+
+#ifndef XAPP_SESSION_IAPP_H
+#define XAPP_SESSION_IAPP_H 
+
+#include "../../util/alg_ds/ds/seq_container/seq_generic.h"
+#include "../../util/byte_array.h"
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// Grace period during which the subscriptions of a disconnected xApp,
+// that presented a token, stay alive waiting for it to come back
+#define XAPP_SESSION_GRACE_MS 10000
+
+// xApp session, keyed by the token presented in the E42 Setup Request.
+// The token has the format <identity>/<instance>. The identity is stable 
+// across restarts, while the instance changes every time the xApp starts
+typedef struct{
+  byte_array_t identity;
+  byte_array_t instance;
+
+  uint16_t xapp_id;
+
+  bool attached;
+  int64_t detach_tstamp; // us 
+
+  // Indications dropped while the xApp was detached
+  uint64_t lost_ind;
+} xapp_session_t;
+
+typedef struct{
+  seq_arr_t arr; // xapp_session_t
+  pthread_mutex_t mtx;
+} xapp_sessions_t;
+
+typedef enum{
+  NEW_XAPP_SESSION,
+  // Same instance. The subscriptions and the xApp ID are kept
+  RESUMED_XAPP_SESSION,
+  // Same identity, new instance. The subscriptions of the old instance 
+  // cannot be resumed as their handles died with it
+  RESTARTED_XAPP_SESSION,
+} xapp_session_e;
+
+typedef struct{
+  xapp_session_e type;
+  uint16_t xapp_id;
+  uint16_t old_xapp_id; // Only valid for RESTARTED_XAPP_SESSION
+  uint64_t lost_ind;
+} xapp_session_ans_t;
+
+void init_xapp_sessions(xapp_sessions_t* s);
+
+void free_xapp_sessions(xapp_sessions_t* s);
+
+// new_xapp_id is assigned if the session cannot be resumed
+xapp_session_ans_t attach_xapp_session(xapp_sessions_t* s, byte_array_t token, uint16_t new_xapp_id);
+
+// Returns false if the xApp did not present a token
+bool detach_xapp_session(xapp_sessions_t* s, uint16_t xapp_id, int64_t now);
+
+// Ends the session, e.g., the xApp was removed through the admin socket.
+// Returns false if the xApp did not present a token
+bool rm_xapp_session(xapp_sessions_t* s, uint16_t xapp_id);
+
+// Stable identity of the xApp. Empty if it did not present a token. Free it
+byte_array_t identity_xapp_session(xapp_sessions_t* s, uint16_t xapp_id);
+
+// Returns true, and counts the indication as lost, if the xApp is detached 
+bool lost_ind_xapp_session(xapp_sessions_t* s, uint16_t xapp_id);
+
+// Removes the sessions detached for longer than grace_us
+// Returns the number of expired sessions, and their xApp IDs in xapp_id[]
+size_t expire_xapp_session(xapp_sessions_t* s, int64_t now, int64_t grace_us, size_t len, uint16_t xapp_id[len]);
+
+#endif
+
@@ -0,0 +1,681 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+
+#include "ind_line_proto.h"
+
+#include "../../lib/sm/ie/cell_global_id.h"
+#include "../../lib/sm/ie/ue_id.h"
+#include "../../sm/rc_sm/ie/ir/ran_param_list.h"
+#include "../../sm/rc_sm/ie/ir/ran_param_struct.h"
+#include "../../util/ngran_types.h"
+
+#include <assert.h>
+#include <inttypes.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct{
+  char node[64];
+  char const* ran;
+  // Empty if absent
+  char cell[48];
+} ind_tags_t;
+
+static
+ind_tags_t init_tags(global_e2_node_id_t const* id)
+{
+  ind_tags_t t = {0};
+  if(id == NULL)
+    return t;
+
+  int const rc = snprintf(t.node, sizeof(t.node), "%d-%d-%u", id->plmn.mcc, id->plmn.mnc, id->nb_id.nb_id);
+  if(id->cu_du_id != NULL && rc > 0 && rc < (int)sizeof(t.node))
+    snprintf(t.node + rc, sizeof(t.node) - rc, "-%" PRIu64, (uint64_t)*id->cu_du_id);
+  t.ran = get_ngran_name(id->type);
+  return t;
+}
+
+static
+void to_cell_tag(cell_global_id_t const* c, char* dst, size_t len)
+{
+  assert(c != NULL);
+
+  if(c->type == NR_CGI_RAT_TYPE)
+    snprintf(dst, len, "%u-%u-%" PRIu64, c->nr_cgi.plmn_id.mcc, c->nr_cgi.plmn_id.mnc, (uint64_t)c->nr_cgi.nr_cell_id);
+  else if(c->type == EUTRA_CGI_RAT_TYPE)
+    snprintf(dst, len, "%u-%u-%u", c->eutra.plmn_id.mcc, c->eutra.plmn_id.mnc, c->eutra.eutra_cell_id);
+  else
+    assert(0 != 0 && "Unknown RAT type");
+}
+
+static
+void begin_point(line_proto_t* lp, char const* meas, ind_tags_t const* t)
+{
+  begin_line_proto(lp, meas);
+  tag_line_proto(lp, "node", t->node);
+  tag_line_proto(lp, "ran", t->ran != NULL ? t->ran : "");
+  tag_line_proto(lp, "cell", t->cell);
+}
+
+// SMs stamp their indications in us. Stamp with the reception otherwise
+static
+int64_t tstamp_ns(int64_t tstamp_us, int64_t now_ns)
+{
+  return tstamp_us > 0 ? tstamp_us*1000 : now_ns;
+}
+
+static
+size_t mac_line_proto(ind_tags_t const* t, mac_ind_msg_t const* msg, int64_t now_ns, line_proto_t* lp)
+{
+  int64_t const ts = tstamp_ns(msg->tstamp, now_ns);
+
+  size_t cnt = 0;
+  for(size_t i = 0; i < msg->len_ue_stats; ++i){
+    mac_ue_stats_impl_t const* s = &msg->ue_stats[i];
+
+    begin_point(lp, "mac", t);
+    tag_u64_line_proto(lp, "ue", s->rnti);
+
+    int_line_proto(lp, "dl_aggr_tbs", s->dl_aggr_tbs);
+    int_line_proto(lp, "ul_aggr_tbs", s->ul_aggr_tbs);
+    int_line_proto(lp, "dl_aggr_bytes_sdus", s->dl_aggr_bytes_sdus);
+    int_line_proto(lp, "ul_aggr_bytes_sdus", s->ul_aggr_bytes_sdus);
+    int_line_proto(lp, "dl_curr_tbs", s->dl_curr_tbs);
+    int_line_proto(lp, "ul_curr_tbs", s->ul_curr_tbs);
+    int_line_proto(lp, "dl_sched_rb", s->dl_sched_rb);
+    int_line_proto(lp, "ul_sched_rb", s->ul_sched_rb);
+    float_line_proto(lp, "pusch_snr", s->pusch_snr);
+    float_line_proto(lp, "pucch_snr", s->pucch_snr);
+    float_line_proto(lp, "dl_bler", s->dl_bler);
+    float_line_proto(lp, "ul_bler", s->ul_bler);
+
+    char key[16] = {0};
+    for(size_t j = 0; j < 5; ++j){
+      snprintf(key, sizeof(key), "dl_harq_%zu", j);
+      int_line_proto(lp, key, s->dl_harq[j]);
+      snprintf(key, sizeof(key), "ul_harq_%zu", j);
+      int_line_proto(lp, key, s->ul_harq[j]);
+    }
+    int_line_proto(lp, "dl_num_harq", s->dl_num_harq);
+    int_line_proto(lp, "ul_num_harq", s->ul_num_harq);
+
+    int_line_proto(lp, "dl_aggr_prb", s->dl_aggr_prb);
+    int_line_proto(lp, "ul_aggr_prb", s->ul_aggr_prb);
+    int_line_proto(lp, "dl_aggr_sdus", s->dl_aggr_sdus);
+    int_line_proto(lp, "ul_aggr_sdus", s->ul_aggr_sdus);
+    int_line_proto(lp, "dl_aggr_retx_prb", s->dl_aggr_retx_prb);
+    int_line_proto(lp, "ul_aggr_retx_prb", s->ul_aggr_retx_prb);
+    int_line_proto(lp, "bsr", s->bsr);
+    int_line_proto(lp, "frame", s->frame);
+    int_line_proto(lp, "slot", s->slot);
+    int_line_proto(lp, "wb_cqi", s->wb_cqi);
+    int_line_proto(lp, "dl_mcs1", s->dl_mcs1);
+    int_line_proto(lp, "ul_mcs1", s->ul_mcs1);
+    int_line_proto(lp, "dl_mcs2", s->dl_mcs2);
+    int_line_proto(lp, "ul_mcs2", s->ul_mcs2);
+    int_line_proto(lp, "phr", s->phr);
+
+    cnt += end_line_proto(lp, ts);
+  }
+  return cnt;
+}
+
+static
+size_t rlc_line_proto(ind_tags_t const* t, rlc_ind_msg_t const* msg, int64_t now_ns, line_proto_t* lp)
+{
+  int64_t const ts = tstamp_ns(msg->tstamp, now_ns);
+
+  size_t cnt = 0;
+  for(size_t i = 0; i < msg->len; ++i){
+    rlc_radio_bearer_stats_t const* rb = &msg->rb[i];
+
+    begin_point(lp, "rlc", t);
+    tag_u64_line_proto(lp, "ue", rb->rnti);
+    tag_u64_line_proto(lp, "rb", rb->rbid);
+
+    int_line_proto(lp, "mode", rb->mode);
+    int_line_proto(lp, "txpdu_pkts", rb->txpdu_pkts);
+    int_line_proto(lp, "txpdu_bytes", rb->txpdu_bytes);
+    int_line_proto(lp, "txpdu_wt_ms", rb->txpdu_wt_ms);
+    int_line_proto(lp, "txpdu_dd_pkts", rb->txpdu_dd_pkts);
+    int_line_proto(lp, "txpdu_dd_bytes", rb->txpdu_dd_bytes);
+    int_line_proto(lp, "txpdu_retx_pkts", rb->txpdu_retx_pkts);
+    int_line_proto(lp, "txpdu_retx_bytes", rb->txpdu_retx_bytes);
+    int_line_proto(lp, "txpdu_segmented", rb->txpdu_segmented);
+    int_line_proto(lp, "txpdu_status_pkts", rb->txpdu_status_pkts);
+    int_line_proto(lp, "txpdu_status_bytes", rb->txpdu_status_bytes);
+    int_line_proto(lp, "txbuf_occ_bytes", rb->txbuf_occ_bytes);
+    int_line_proto(lp, "txbuf_occ_pkts", rb->txbuf_occ_pkts);
+    int_line_proto(lp, "rxpdu_pkts", rb->rxpdu_pkts);
+    int_line_proto(lp, "rxpdu_bytes", rb->rxpdu_bytes);
+    int_line_proto(lp, "rxpdu_dup_pkts", rb->rxpdu_dup_pkts);
+    int_line_proto(lp, "rxpdu_dup_bytes", rb->rxpdu_dup_bytes);
+    int_line_proto(lp, "rxpdu_dd_pkts", rb->rxpdu_dd_pkts);
+    int_line_proto(lp, "rxpdu_dd_bytes", rb->rxpdu_dd_bytes);
+    int_line_proto(lp, "rxpdu_ow_pkts", rb->rxpdu_ow_pkts);
+    int_line_proto(lp, "rxpdu_ow_bytes", rb->rxpdu_ow_bytes);
+    int_line_proto(lp, "rxpdu_status_pkts", rb->rxpdu_status_pkts);
+    int_line_proto(lp, "rxpdu_status_bytes", rb->rxpdu_status_bytes);
+    int_line_proto(lp, "rxbuf_occ_bytes", rb->rxbuf_occ_bytes);
+    int_line_proto(lp, "rxbuf_occ_pkts", rb->rxbuf_occ_pkts);
+    int_line_proto(lp, "txsdu_pkts", rb->txsdu_pkts);
+    int_line_proto(lp, "txsdu_bytes", rb->txsdu_bytes);
+    float_line_proto(lp, "txsdu_avg_time_to_tx", rb->txsdu_avg_time_to_tx);
+    int_line_proto(lp, "txsdu_wt_us", rb->txsdu_wt_us);
+    int_line_proto(lp, "rxsdu_pkts", rb->rxsdu_pkts);
+    int_line_proto(lp, "rxsdu_bytes", rb->rxsdu_bytes);
+    int_line_proto(lp, "rxsdu_dd_pkts", rb->rxsdu_dd_pkts);
+    int_line_proto(lp, "rxsdu_dd_bytes", rb->rxsdu_dd_bytes);
+
+    cnt += end_line_proto(lp, ts);
+  }
+  return cnt;
+}
+
+static
+size_t pdcp_line_proto(ind_tags_t const* t, pdcp_ind_msg_t const* msg, int64_t now_ns, line_proto_t* lp)
+{
+  int64_t const ts = tstamp_ns(msg->tstamp, now_ns);
+
+  size_t cnt = 0;
+  for(size_t i = 0; i < msg->len; ++i){
+    pdcp_radio_bearer_stats_t const* rb = &msg->rb[i];
+
+    begin_point(lp, "pdcp", t);
+    tag_u64_line_proto(lp, "ue", rb->rnti);
+    tag_u64_line_proto(lp, "rb", rb->rbid);
+
+    int_line_proto(lp, "mode", rb->mode);
+    int_line_proto(lp, "txpdu_pkts", rb->txpdu_pkts);
+    int_line_proto(lp, "txpdu_bytes", rb->txpdu_bytes);
+    int_line_proto(lp, "txpdu_sn", rb->txpdu_sn);
+    int_line_proto(lp, "rxpdu_pkts", rb->rxpdu_pkts);
+    int_line_proto(lp, "rxpdu_bytes", rb->rxpdu_bytes);
+    int_line_proto(lp, "rxpdu_sn", rb->rxpdu_sn);
+    int_line_proto(lp, "rxpdu_oo_pkts", rb->rxpdu_oo_pkts);
+    int_line_proto(lp, "rxpdu_oo_bytes", rb->rxpdu_oo_bytes);
+    int_line_proto(lp, "rxpdu_dd_pkts", rb->rxpdu_dd_pkts);
+    int_line_proto(lp, "rxpdu_dd_bytes", rb->rxpdu_dd_bytes);
+    int_line_proto(lp, "rxpdu_ro_count", rb->rxpdu_ro_count);
+    int_line_proto(lp, "txsdu_pkts", rb->txsdu_pkts);
+    int_line_proto(lp, "txsdu_bytes", rb->txsdu_bytes);
+    int_line_proto(lp, "rxsdu_pkts", rb->rxsdu_pkts);
+    int_line_proto(lp, "rxsdu_bytes", rb->rxsdu_bytes);
+
+    cnt += end_line_proto(lp, ts);
+  }
+  return cnt;
+}
+
+static
+size_t gtp_line_proto(ind_tags_t const* t, gtp_ind_msg_t const* msg, int64_t now_ns, line_proto_t* lp)
+{
+  int64_t const ts = tstamp_ns(msg->tstamp, now_ns);
+
+  size_t cnt = 0;
+  for(size_t i = 0; i < msg->len; ++i){
+    gtp_ngu_t_stats_t const* s = &msg->ngut[i];
+
+    begin_point(lp, "gtp", t);
+    tag_u64_line_proto(lp, "ue", s->rnti);
+
+    int_line_proto(lp, "teidgnb", s->teidgnb);
+    int_line_proto(lp, "qfi", s->qfi);
+    int_line_proto(lp, "teidupf", s->teidupf);
+
+    cnt += end_line_proto(lp, ts);
+  }
+  return cnt;
+}
+
+static
+void slice_params_line_proto(slice_params_t const* p, line_proto_t* lp)
+{
+  int_line_proto(lp, "alg", p->type);
+
+  if(p->type == SLICE_ALG_SM_V0_STATIC){
+    int_line_proto(lp, "pos_low", p->u.sta.pos_low);
+    int_line_proto(lp, "pos_high", p->u.sta.pos_high);
+  } else if(p->type == SLICE_ALG_SM_V0_NVS){
+    int_line_proto(lp, "nvs_conf", p->u.nvs.conf);
+    if(p->u.nvs.conf == SLICE_SM_NVS_V0_RATE){
+      float_line_proto(lp, "mbps_required", p->u.nvs.u.rate.u1.mbps_required);
+      float_line_proto(lp, "mbps_reference", p->u.nvs.u.rate.u2.mbps_reference);
+    } else {
+      float_line_proto(lp, "pct_reserved", p->u.nvs.u.capacity.u.pct_reserved);
+    }
+  } else if(p->type == SLICE_ALG_SM_V0_SCN19){
+    int_line_proto(lp, "scn19_conf", p->u.scn19.conf);
+  } else if(p->type == SLICE_ALG_SM_V0_EDF){
+    int_line_proto(lp, "deadline", p->u.edf.deadline);
+    int_line_proto(lp, "guaranteed_prbs", p->u.edf.guaranteed_prbs);
+    int_line_proto(lp, "max_replenish", p->u.edf.max_replenish);
+  }
+}
+
+static
+size_t slice_conf_line_proto(ind_tags_t const* t, char const* dir, ul_dl_slice_conf_t const* conf, int64_t ts, line_proto_t* lp)
+{
+  size_t cnt = 0;
+  for(size_t i = 0; i < conf->len_slices; ++i){
+    fr_slice_t const* s = &conf->slices[i];
+
+    begin_point(lp, "slice", t);
+    tag_line_proto(lp, "dir", dir);
+    tag_u64_line_proto(lp, "slice", s->id);
+
+    str_line_proto(lp, "label", s->label, s->len_label);
+    str_line_proto(lp, "sched", s->sched, s->len_sched);
+    str_line_proto(lp, "slice_sched", conf->sched_name, conf->len_sched_name);
+    slice_params_line_proto(&s->params, lp);
+
+    cnt += end_line_proto(lp, ts);
+  }
+  return cnt;
+}
+
+static
+size_t slice_line_proto(ind_tags_t const* t, slice_ind_msg_t const* msg, int64_t now_ns, line_proto_t* lp)
+{
+  int64_t const ts = tstamp_ns(msg->tstamp, now_ns);
+
+  size_t cnt = slice_conf_line_proto(t, "dl", &msg->slice_conf.dl, ts, lp);
+  cnt += slice_conf_line_proto(t, "ul", &msg->slice_conf.ul, ts, lp);
+
+  for(size_t i = 0; i < msg->ue_slice_conf.len_ue_slice; ++i){
+    ue_slice_assoc_t const* ue = &msg->ue_slice_conf.ues[i];
+
+    begin_point(lp, "slice_ue", t);
+    tag_u64_line_proto(lp, "ue", ue->rnti);
+
+    int_line_proto(lp, "dl_id", ue->dl_id);
+    int_line_proto(lp, "ul_id", ue->ul_id);
+
+    cnt += end_line_proto(lp, ts);
+  }
+  return cnt;
+}
+
+static
+char const* tc_queue_str(tc_queue_e type)
+{
+  switch(type){
+    case TC_QUEUE_FIFO: return "fifo";
+    case TC_QUEUE_CODEL: return "codel";
+    case TC_QUEUE_ECN_CODEL: return "ecn_codel";
+    default: assert(0 != 0 && "Unknown queue type");
+  }
+  return "";
+}
+
+// One point per queue, with its shaper and policer
+static
+size_t tc_line_proto(ind_tags_t const* t, tc_ind_msg_t const* msg, int64_t now_ns, line_proto_t* lp)
+{
+  int64_t const ts = tstamp_ns(msg->tstamp, now_ns);
+
+  size_t cnt = 0;
+  for(size_t i = 0; i < msg->len_q; ++i){
+    tc_queue_t const* q = &msg->q[i];
+
+    begin_point(lp, "tc", t);
+    tag_u64_line_proto(lp, "queue", q->id);
+    tag_line_proto(lp, "type", tc_queue_str(q->type));
+
+    // The queues share the layout of their counters
+    static_assert(offsetof(tc_queue_fifo_t, last_sojourn_time) == offsetof(tc_queue_codel_t, last_sojourn_time)
+                  && offsetof(tc_queue_fifo_t, last_sojourn_time) == offsetof(tc_queue_ecn_codel_t, last_sojourn_time), "Queue layout mismatch");
+    tc_queue_fifo_t const* c = q->type == TC_QUEUE_CODEL ? (tc_queue_fifo_t const*)&q->codel : &q->fifo;
+    int_line_proto(lp, "bytes", c->bytes);
+    int_line_proto(lp, "pkts", c->pkts);
+    int_line_proto(lp, "bytes_fwd", c->bytes_fwd);
+    int_line_proto(lp, "pkts_fwd", c->pkts_fwd);
+    float_line_proto(lp, "avg_sojourn_time", c->avg_sojourn_time);
+    int_line_proto(lp, "last_sojourn_time", c->last_sojourn_time);
+    if(q->type == TC_QUEUE_ECN_CODEL)
+      int_line_proto(lp, "marked_pkts", q->ecn.mrk.marked_pkts);
+    else
+      int_line_proto(lp, "dropped_pkts", c->drp.dropped_pkts);
+
+    tc_shp_t const* shp = &msg->shp[i];
+    int_line_proto(lp, "shp_active", shp->active);
+    int_line_proto(lp, "shp_max_rate_kbps", shp->max_rate_kbps);
+    float_line_proto(lp, "shp_rate_kbps", shp->mtr.bnd_flt);
+
+    tc_plc_t const* plc = &msg->plc[i];
+    int_line_proto(lp, "plc_active", plc->active);
+    float_line_proto(lp, "plc_max_rate_kbps", plc->max_rate_kbps);
+    float_line_proto(lp, "plc_rate_kbps", plc->mtr.bnd_flt);
+    int_line_proto(lp, "plc_dropped_pkts", plc->drp.dropped_pkts);
+    int_line_proto(lp, "plc_marked_pkts", plc->mrk.marked_pkts);
+    int_line_proto(lp, "plc_dst_id", plc->dst_id);
+
+    cnt += end_line_proto(lp, ts);
+  }
+  return cnt;
+}
+
+static
+void meas_type_key(meas_type_t const* m, char* dst, size_t len)
+{
+  if(m->type == NAME_MEAS_TYPE){
+    size_t const n = m->name.len < len - 1 ? m->name.len : len - 1;
+    memcpy(dst, m->name.buf, n);
+    dst[n] = '\0';
+  } else {
+    snprintf(dst, len, "id_%u", m->id);
+  }
+}
+
+static
+void meas_record_line_proto(char const* key, meas_record_lst_t const* r, line_proto_t* lp)
+{
+  if(r->value == INTEGER_MEAS_VALUE)
+    int_line_proto(lp, key, r->int_val);
+  else if(r->value == REAL_MEAS_VALUE)
+    float_line_proto(lp, key, r->real_val);
+}
+
+// One point per granularity period, i.e., per meas_data_lst item. Record j
+// is the measurement j of type
+static
+size_t kpm_meas_line_proto(ind_tags_t const* t, ue_id_e2sm_t const* ue,
+                           size_t len_data, meas_data_lst_t const* data,
+                           size_t len_type, meas_type_t const* const* type,
+                           uint32_t const* gran_period_ms, int64_t ts, line_proto_t* lp)
+{
+  int64_t const gran_ns = gran_period_ms != NULL ? *gran_period_ms*1000000LL : 0;
+
+  size_t cnt = 0;
+  for(size_t i = 0; i < len_data; ++i){
+    meas_data_lst_t const* d = &data[i];
+
+    begin_point(lp, "kpm", t);
+    if(ue != NULL)
+      tag_u64_line_proto(lp, "ue", num_ue_id_e2sm(ue));
+
+    for(size_t j = 0; j < d->meas_record_len; ++j){
+      char key[64] = {0};
+      if(j < len_type)
+        meas_type_key(type[j], key, sizeof(key));
+      if(key[0] == '\0')
+        snprintf(key, sizeof(key), "record_%zu", j);
+      meas_record_line_proto(key, &d->meas_record_lst[j], lp);
+    }
+    if(d->incomplete_flag != NULL)
+      bool_line_proto(lp, "incomplete", true);
+
+    cnt += end_line_proto(lp, ts + i*gran_ns);
+  }
+  return cnt;
+}
+
+static
+size_t kpm_frm_1_line_proto(ind_tags_t const* t, ue_id_e2sm_t const* ue, kpm_ind_msg_format_1_t const* m, int64_t ts, line_proto_t* lp)
+{
+  meas_type_t const** type = calloc(m->meas_info_lst_len + 1, sizeof(meas_type_t const*));
+  assert(type != NULL && "Memory exhausted");
+  for(size_t i = 0; i < m->meas_info_lst_len; ++i)
+    type[i] = &m->meas_info_lst[i].meas_type;
+
+  size_t const cnt = kpm_meas_line_proto(t, ue, m->meas_data_lst_len, m->meas_data_lst, m->meas_info_lst_len, type, m->gran_period_ms, ts, lp);
+  free(type);
+  return cnt;
+}
+
+static
+size_t kpm_frm_2_line_proto(ind_tags_t const* t, kpm_ind_msg_format_2_t const* m, int64_t ts, line_proto_t* lp)
+{
+  meas_type_t const** type = calloc(m->meas_info_cond_ue_lst_len + 1, sizeof(meas_type_t const*));
+  assert(type != NULL && "Memory exhausted");
+  for(size_t i = 0; i < m->meas_info_cond_ue_lst_len; ++i)
+    type[i] = &m->meas_info_cond_ue_lst[i].meas_type;
+
+  size_t const cnt = kpm_meas_line_proto(t, NULL, m->meas_data_lst_len, m->meas_data_lst, m->meas_info_cond_ue_lst_len, type, m->gran_period_ms, ts, lp);
+  free(type);
+  return cnt;
+}
+
+static
+int64_t kpm_tstamp_ns(kpm_ind_hdr_t const* hdr, int64_t now_ns)
+{
+  if(hdr->type != FORMAT_1_INDICATION_HEADER || hdr->kpm_ric_ind_hdr_format_1.collectStartTime == 0)
+    return now_ns;
+
+  int64_t const t = hdr->kpm_ric_ind_hdr_format_1.collectStartTime;
+#if defined(KPM_V3_00)
+  // us
+  return t*1000;
+#else
+  // s
+  return t*1000000000;
+#endif
+}
+
+static
+size_t kpm_line_proto(ind_tags_t const* tags, kpm_rd_ind_data_t const* kpm, int64_t now_ns, line_proto_t* lp)
+{
+  ind_tags_t t = *tags;
+  // The action definition is only known at the subscriber
+  kpm_act_def_t const* ad = kpm->act_def;
+  if(ad != NULL && ad->type == FORMAT_1_ACTION_DEFINITION && ad->frm_1.cell_global_id != NULL)
+    to_cell_tag(ad->frm_1.cell_global_id, t.cell, sizeof(t.cell));
+
+  int64_t const ts = kpm_tstamp_ns(&kpm->ind.hdr, now_ns);
+  kpm_ind_msg_t const* msg = &kpm->ind.msg;
+
+  if(msg->type == FORMAT_1_INDICATION_MESSAGE)
+    return kpm_frm_1_line_proto(&t, NULL, &msg->frm_1, ts, lp);
+
+  if(msg->type == FORMAT_2_INDICATION_MESSAGE)
+    return kpm_frm_2_line_proto(&t, &msg->frm_2, ts, lp);
+
+  assert(msg->type == FORMAT_3_INDICATION_MESSAGE && "Unknown KPM Indication Message format");
+  size_t cnt = 0;
+  for(size_t i = 0; i < msg->frm_3.ue_meas_report_lst_len; ++i){
+    meas_report_per_ue_t const* r = &msg->frm_3.meas_report_per_ue[i];
+    cnt += kpm_frm_1_line_proto(&t, &r->ue_meas_report_lst, &r->ind_msg_format_1, ts, lp);
+  }
+  return cnt;
+}
+
+static
+void ran_param_value_line_proto(char const* key, ran_parameter_value_t const* v, line_proto_t* lp)
+{
+  assert(v != NULL);
+
+  switch(v->type){
+    case BOOLEAN_RAN_PARAMETER_VALUE:
+      bool_line_proto(lp, key, v->bool_ran);
+      break;
+    case INTEGER_RAN_PARAMETER_VALUE:
+      int_line_proto(lp, key, v->int_ran);
+      break;
+    case REAL_RAN_PARAMETER_VALUE:
+      float_line_proto(lp, key, v->real_ran);
+      break;
+    case PRINTABLESTRING_RAN_PARAMETER_VALUE:
+      str_line_proto(lp, key, (char const*)v->printable_str_ran.buf, v->printable_str_ran.len);
+      break;
+    case BIT_STRING_RAN_PARAMETER_VALUE:
+    case OCTET_STRING_RAN_PARAMETER_VALUE:
+      // Opaque to a time series
+      break;
+    default:
+      assert(0 != 0 && "Unknown RAN Parameter value type");
+  }
+}
+
+// Flattens the RAN Parameters into fields, e.g., p1.3[0].7 is the RAN
+// Parameter 7 of the first item of the list 3 of the structure 1
+static
+void seq_ran_param_line_proto(char* key, size_t len_key, size_t off, size_t sz, seq_ran_param_t const* p, line_proto_t* lp)
+{
+  for(size_t i = 0; i < sz; ++i){
+    int const n = snprintf(key + off, len_key - off, off == 0 ? "p%u" : ".%u", p[i].ran_param_id);
+    // Too deep
+    if(n < 0 || off + n >= len_key)
+      continue;
+
+    ran_param_val_type_t const* v = &p[i].ran_param_val;
+    if(v->type == ELEMENT_KEY_FLAG_TRUE_RAN_PARAMETER_VAL_TYPE){
+      ran_param_value_line_proto(key, v->flag_true, lp);
+    } else if(v->type == ELEMENT_KEY_FLAG_FALSE_RAN_PARAMETER_VAL_TYPE){
+      ran_param_value_line_proto(key, v->flag_false, lp);
+    } else if(v->type == STRUCTURE_RAN_PARAMETER_VAL_TYPE){
+      assert(v->strct != NULL);
+      seq_ran_param_line_proto(key, len_key, off + n, v->strct->sz_ran_param_struct, v->strct->ran_param_struct, lp);
+    } else if(v->type == LIST_RAN_PARAMETER_VAL_TYPE){
+      assert(v->lst != NULL);
+      for(size_t j = 0; j < v->lst->sz_lst_ran_param; ++j){
+        int const m = snprintf(key + off + n, len_key - off - n, "[%zu]", j);
+        if(m < 0 || off + n + m >= len_key)
+          continue;
+        ran_param_struct_t const* s = &v->lst->lst_ran_param[j].ran_param_struct;
+        seq_ran_param_line_proto(key, len_key, off + n + m, s->sz_ran_param_struct, s->ran_param_struct, lp);
+      }
+    } else {
+      assert(0 != 0 && "Unknown RAN Parameter type");
+    }
+  }
+  key[off] = '\0';
+}
+
+static
+void params_line_proto(size_t sz, seq_ran_param_t const* p, line_proto_t* lp)
+{
+  char key[128] = {0};
+  seq_ran_param_line_proto(key, sizeof(key), 0, sz, p, lp);
+}
+
+static
+void rc_begin_point(ind_tags_t const* t, e2sm_rc_ind_hdr_t const* hdr, ue_id_e2sm_t const* ue, line_proto_t* lp)
+{
+  begin_point(lp, "rc", t);
+
+  // The UE of the message, if any, prevails
+  if(ue == NULL && hdr->format == FORMAT_2_E2SM_RC_IND_HDR)
+    ue = &hdr->frmt_2.ue_id;
+  else if(ue == NULL && hdr->format == FORMAT_3_E2SM_RC_IND_HDR)
+    ue = hdr->frmt_3.ue_id;
+  if(ue != NULL)
+    tag_u64_line_proto(lp, "ue", num_ue_id_e2sm(ue));
+
+  if(hdr->format == FORMAT_1_E2SM_RC_IND_HDR && hdr->frmt_1.ev_trigger_id != NULL){
+    int_line_proto(lp, "ev_trigger_id", *hdr->frmt_1.ev_trigger_id);
+  } else if(hdr->format == FORMAT_2_E2SM_RC_IND_HDR){
+    int_line_proto(lp, "ric_style_type", hdr->frmt_2.ric_style_type);
+    int_line_proto(lp, "ins_ind_id", hdr->frmt_2.ins_ind_id);
+  } else if(hdr->format == FORMAT_3_E2SM_RC_IND_HDR && hdr->frmt_3.ev_trigger_cond != NULL){
+    int_line_proto(lp, "ev_trigger_cond", *hdr->frmt_3.ev_trigger_cond);
+  }
+}
+
+// RC carries no timestamp
+static
+size_t rc_line_proto(ind_tags_t const* tags, rc_rd_ind_data_t const* rc, int64_t ts, line_proto_t* lp)
+{
+  e2sm_rc_ind_hdr_t const* hdr = &rc->ind.hdr;
+  e2sm_rc_ind_msg_t const* msg = &rc->ind.msg;
+  ind_tags_t t = *tags;
+
+  size_t cnt = 0;
+  switch(msg->format){
+    case FORMAT_1_E2SM_RC_IND_MSG:
+      rc_begin_point(&t, hdr, NULL, lp);
+      params_line_proto(msg->frmt_1.sz_seq_ran_param, msg->frmt_1.seq_ran_param, lp);
+      cnt += end_line_proto(lp, ts);
+      break;
+    case FORMAT_2_E2SM_RC_IND_MSG:
+      for(size_t i = 0; i < msg->frmt_2.sz_seq_ue_id; ++i){
+        seq_ue_id_t const* u = &msg->frmt_2.seq_ue_id[i];
+        rc_begin_point(&t, hdr, &u->ue_id, lp);
+        params_line_proto(u->sz_seq_ran_param, u->seq_ran_param, lp);
+        cnt += end_line_proto(lp, ts);
+      }
+      break;
+    case FORMAT_3_E2SM_RC_IND_MSG:
+      for(size_t i = 0; i < msg->frmt_3.sz_seq_cell_info; ++i){
+        seq_cell_info_t const* c = &msg->frmt_3.seq_cell_info[i];
+        to_cell_tag(&c->cell_global_id, t.cell, sizeof(t.cell));
+        rc_begin_point(&t, hdr, NULL, lp);
+        bool_line_proto(lp, "cell_ctx_info", c->cell_ctx_info != NULL);
+        bool_line_proto(lp, "cell_deleted", c->cell_del != NULL && *c->cell_del == true);
+        bool_line_proto(lp, "neighbour_rela_tbl", c->neighbour_rela_tbl != NULL);
+        cnt += end_line_proto(lp, ts);
+      }
+      break;
+    case FORMAT_4_E2SM_RC_IND_MSG:
+      for(size_t i = 0; i < msg->frmt_4.sz_seq_ue_info; ++i){
+        seq_ue_info_t const* u = &msg->frmt_4.seq_ue_info[i];
+        to_cell_tag(&u->cell_global_id, t.cell, sizeof(t.cell));
+        rc_begin_point(&t, hdr, &u->ue_id, lp);
+        bool_line_proto(lp, "ue_ctx_info", u->ue_ctx_info != NULL);
+        cnt += end_line_proto(lp, ts);
+      }
+      for(size_t i = 0; i < msg->frmt_4.sz_seq_cell_info_2; ++i){
+        seq_cell_info_2_t const* c = &msg->frmt_4.seq_cell_info_2[i];
+        to_cell_tag(&c->cell_global_id, t.cell, sizeof(t.cell));
+        rc_begin_point(&t, hdr, NULL, lp);
+        bool_line_proto(lp, "cell_ctx_info", c->cell_ctx_info != NULL);
+        bool_line_proto(lp, "neighbour_rela_tbl", c->neighbour_rela_tbl != NULL);
+        cnt += end_line_proto(lp, ts);
+      }
+      break;
+    case FORMAT_5_E2SM_RC_IND_MSG:
+      rc_begin_point(&t, hdr, NULL, lp);
+      params_line_proto(msg->frmt_5.sz_seq_ran_param, msg->frmt_5.seq_ran_param, lp);
+      cnt += end_line_proto(lp, ts);
+      break;
+    case FORMAT_6_E2SM_RC_IND_MSG:
+      rc_begin_point(&t, hdr, NULL, lp);
+      int_line_proto(lp, "ins_styles", msg->frmt_6.sz_seq_ins_style_ind_msg);
+      cnt += end_line_proto(lp, ts);
+      break;
+    default:
+      assert(0 != 0 && "Unknown RC Indication Message format");
+  }
+  return cnt;
+}
+
+size_t to_line_proto_ind(global_e2_node_id_t const* id, sm_ag_if_rd_ind_t const* data, int64_t now_ns, line_proto_t* dst)
+{
+  assert(data != NULL);
+  assert(dst != NULL);
+
+  ind_tags_t const t = init_tags(id);
+
+  switch(data->type){
+    case MAC_STATS_V0: return mac_line_proto(&t, &data->mac.msg, now_ns, dst);
+    case RLC_STATS_V0: return rlc_line_proto(&t, &data->rlc.msg, now_ns, dst);
+    case PDCP_STATS_V0: return pdcp_line_proto(&t, &data->pdcp.msg, now_ns, dst);
+    case SLICE_STATS_V0: return slice_line_proto(&t, &data->slice.msg, now_ns, dst);
+    case TC_STATS_V0: return tc_line_proto(&t, &data->tc.msg, now_ns, dst);
+    case GTP_STATS_V0: return gtp_line_proto(&t, &data->gtp.msg, now_ns, dst);
+    case KPM_STATS_V3_0: return kpm_line_proto(&t, &data->kpm, now_ns, dst);
+    case RAN_CTRL_STATS_V1_03: return rc_line_proto(&t, &data->rc, now_ns, dst);
+    default: assert(0 != 0 && "Unknown data type");
+  }
+  return 0;
+}
@@ -0,0 +1,46 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+
+#ifndef INDICATION_LINE_PROTOCOL_H
+#define INDICATION_LINE_PROTOCOL_H
+
+// Points of the indications of every SM, shared by the influx and the
+// telemetry file sinks.
+//
+// Measurements: mac, rlc, pdcp, gtp, slice, slice_ue, tc, kpm and rc.
+// Tags: node (mcc-mnc-nb_id[-cu_du_id]) and ran (node type) of the E2 Node,
+// ue (RNTI, or the main E2SM UE ID), rb, and cell (mcc-mnc-cell_id) where
+// the SM carries it, plus SM specific ones e.g., slice, dir or queue
+
+#include "../../lib/e2ap/e2ap_global_node_id_wrapper.h"
+#include "../../sm/agent_if/read/sm_ag_if_rd.h"
+#include "line_proto.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+// id: NULL if the E2 Node is unknown
+// Appends the points of an indication to dst, in its format. now_ns
+// timestamps the ones without. Returns the number of points appended
+size_t to_line_proto_ind(global_e2_node_id_t const* id, sm_ag_if_rd_ind_t const* data, int64_t now_ns, line_proto_t* dst);
+
+#endif
@@ -23,9 +23,24 @@
 #ifndef INFLUX_LISTENER_H
 #define INFLUX_LISTENER_H
 
-#include "sm/agent_if/read/sm_ag_if_rd.h"
+// Exports the indications to InfluxDB in line protocol, with the points of
+// ind_line_proto. Points are batched and spooled by influx_export.
+// Disabled unless INFLUX_SINK is set.
 
-void notify_influx_listener(sm_ag_if_rd_ind_t const* data);
+#include "../../lib/e2ap/e2ap_global_node_id_wrapper.h"
+#include "../../sm/agent_if/read/sm_ag_if_rd.h"
+#include "influx_export.h"
 
-#endif
+// sink NULL disables the listener
+void init_influx_listener(char const* sink, char const* batch, char const* spool);
+
+void free_influx_listener(void);
+
+// id: NULL if the E2 Node is unknown
+void notify_influx_listener(global_e2_node_id_t const* id, sm_ag_if_rd_ind_t const* data);
 
+void flush_influx_listener(void);
+
+influx_export_stats_t stats_influx_listener(void);
+
+#endif
@@ -0,0 +1,698 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+#include "influx_export.h"
+#include "../../util/conf_file.h"
+
+#include <arpa/inet.h>
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+// Spool chunks replayed between two rounds of new batches
+#define REPLAY_CHUNKS 64
+// Longest point that can be replayed
+#define MAX_LINE_LEN (64*1024)
+// Bounds the TCP connect and send, and the ICMP wait of the UDP probe
+#define SEND_TIMEOUT_MS 1000
+#define PROBE_WAIT_MS 10
+
+static
+int64_t now_ms(void)
+{
+  struct timespec tms = {0};
+  int const rc = clock_gettime(CLOCK_MONOTONIC, &tms);
+  assert(rc == 0);
+  return tms.tv_sec*1000 + tms.tv_nsec/1000000;
+}
+
+static
+size_t count_lines(char const* s, size_t len)
+{
+  size_t n = 0;
+  for(char const* it = memchr(s, '\n', len); it != NULL; it = memchr(it + 1, '\n', len - (it + 1 - s)))
+    n += 1;
+  return n;
+}
+
+static
+bool parse_sink(char const* sink, bool* tcp, struct sockaddr_in* addr)
+{
+  if(strncmp(sink, "udp://", 6) == 0)
+    *tcp = false;
+  else if(strncmp(sink, "tcp://", 6) == 0)
+    *tcp = true;
+  else
+    return false;
+
+  char* host = strdup(sink + 6);
+  assert(host != NULL && "Memory exhausted");
+
+  bool ok = false;
+  char* colon = strrchr(host, ':');
+  if(colon != NULL){
+    *colon = '\0';
+    char* end = NULL;
+    long const port = strtol(colon + 1, &end, 10);
+
+    struct addrinfo hints = {.ai_family = AF_INET};
+    struct addrinfo* res = NULL;
+    if(*host != '\0' && *end == '\0' && port > 0 && port < 65536 && getaddrinfo(host, NULL, &hints, &res) == 0){
+      *addr = *(struct sockaddr_in*)res->ai_addr;
+      addr->sin_port = htons(port);
+      freeaddrinfo(res);
+      ok = true;
+    }
+  }
+
+  free(host);
+  return ok;
+}
+
+static
+bool parse_ms(char const* s, int64_t* dst)
+{
+  long long v = 0;
+  bool const ok = parse_num_conf(s, 1, INT32_MAX, &v);
+  *dst = v;
+  return ok;
+}
+
+typedef struct{
+  influx_export_t* e;
+  int64_t retry_ms;
+} batch_conf_t;
+
+static
+bool parse_batch_opt(char* key, char* val, void* data)
+{
+  batch_conf_t* b = (batch_conf_t*)data;
+  influx_export_t* e = b->e;
+
+  // A batch is one datagram over UDP
+  if(strcmp(key, "size") == 0)
+    return parse_size_conf(val, &e->batch_size) && e->batch_size <= 65507;
+  if(strcmp(key, "ms") == 0)
+    return parse_ms(val, &e->flush_ms);
+  if(strcmp(key, "spool") == 0)
+    return parse_size_conf(val, &e->spool_max);
+  if(strcmp(key, "retry") == 0)
+    return parse_ms(val, &b->retry_ms);
+
+  return false;
+}
+
+static
+bool parse_batch(char const* batch, influx_export_t* e, int64_t* retry_ms)
+{
+  batch_conf_t b = {.e = e, .retry_ms = *retry_ms};
+  bool const ok = parse_kv_conf(strlen(batch), batch, parse_batch_opt, &b);
+  *retry_ms = b.retry_ms;
+  return ok;
+}
+
+static
+void update_spool_len(influx_export_t* e, size_t len)
+{
+  int rc = pthread_mutex_lock(&e->mtx);
+  assert(rc == 0);
+  e->stats.spool_len = len;
+  rc = pthread_mutex_unlock(&e->mtx);
+  assert(rc == 0);
+}
+
+static
+void set_reachable(influx_export_t* e, bool reachable)
+{
+  int rc = pthread_mutex_lock(&e->mtx);
+  assert(rc == 0);
+  e->stats.reachable = reachable;
+  rc = pthread_mutex_unlock(&e->mtx);
+  assert(rc == 0);
+}
+
+static
+void close_sink(influx_export_t* e)
+{
+  if(e->connected == false)
+    return;
+
+  close(e->fd);
+  e->fd = -1;
+  e->connected = false;
+  e->retry_at_ms = now_ms() + next_backoff(&e->backoff);
+  set_reachable(e, false);
+
+  char addr[INET_ADDRSTRLEN] = {0};
+  inet_ntop(AF_INET, &e->addr.sin_addr, addr, sizeof(addr));
+  printf("[INFLUX]: Sink %s:%d unreachable. Spooling\n", addr, ntohs(e->addr.sin_port));
+}
+
+// A connected UDP socket learns that nobody listens through an ICMP error,
+// returned by the next call. Thus, an empty datagram probes the sink
+static
+bool probe_udp(int fd)
+{
+  if(send(fd, "", 0, 0) == -1)
+    return false;
+
+  struct pollfd pfd = {.fd = fd, .events = POLLIN};
+  poll(&pfd, 1, PROBE_WAIT_MS);
+
+  int err = 0;
+  socklen_t len = sizeof(err);
+  int const rc = getsockopt(fd, SOL_SOCKET, SO_ERROR, &err, &len);
+  assert(rc == 0);
+  return err == 0;
+}
+
+static
+bool connect_sink(influx_export_t* e)
+{
+  assert(e->connected == false);
+
+  int const fd = socket(AF_INET, e->tcp ? SOCK_STREAM : SOCK_DGRAM, 0);
+  assert(fd > -1 && "Error creating the socket");
+
+  struct timeval tv = {.tv_sec = SEND_TIMEOUT_MS/1000, .tv_usec = (SEND_TIMEOUT_MS % 1000)*1000};
+  int rc = setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+  assert(rc == 0);
+
+  rc = connect(fd, (struct sockaddr const*)&e->addr, sizeof(e->addr));
+  if(rc == -1 || (e->tcp == false && probe_udp(fd) == false)){
+    close(fd);
+    return false;
+  }
+
+  e->fd = fd;
+  e->connected = true;
+  reset_backoff(&e->backoff);
+  set_reachable(e, true);
+  return true;
+}
+
+static
+bool reachable(influx_export_t* e)
+{
+  if(e->connected == true)
+    return true;
+
+  if(now_ms() < e->retry_at_ms)
+    return false;
+
+  if(connect_sink(e) == true)
+    return true;
+
+  e->retry_at_ms = now_ms() + next_backoff(&e->backoff);
+  return false;
+}
+
+// sent: bytes that left, i.e., the peer may have received a partial line
+static
+bool send_all(influx_export_t* e, char const* buf, size_t len, size_t* sent)
+{
+  *sent = 0;
+  while(*sent < len){
+    ssize_t const rc = send(e->fd, buf + *sent, len - *sent, MSG_NOSIGNAL);
+    if(rc == -1 && errno == EINTR)
+      continue;
+    if(rc == -1)
+      return false;
+    // Datagrams leave whole
+    if(e->tcp == false && (size_t)rc != len)
+      return false;
+    *sent += rc;
+  }
+  return true;
+}
+
+static
+void add_sent(influx_export_t* e, size_t len, bool replay)
+{
+  int rc = pthread_mutex_lock(&e->mtx);
+  assert(rc == 0);
+  e->stats.bytes += len;
+  e->stats.batches += 1;
+  if(replay == true)
+    e->stats.replayed += len;
+  rc = pthread_mutex_unlock(&e->mtx);
+  assert(rc == 0);
+}
+
+static
+size_t spool_len(influx_export_t* e)
+{
+  int rc = pthread_mutex_lock(&e->mtx);
+  assert(rc == 0);
+  size_t const len = e->stats.spool_len;
+  rc = pthread_mutex_unlock(&e->mtx);
+  assert(rc == 0);
+  return len;
+}
+
+// Drops the replayed prefix, i.e., [0, spool_off), so that it takes no room 
+// from the new batches and a restart does not send it again. Called by the 
+// writer thread only, as spool and replay. A crash meanwhile repeats points
+static
+void compact_spool(influx_export_t* e)
+{
+  if(e->spool_fd == -1 || e->spool_off == 0)
+    return;
+
+  size_t const len = spool_len(e);
+  assert(e->spool_off <= len);
+  size_t const left = len - e->spool_off;
+
+  char buf[4096];
+  size_t done = 0;
+  while(done < left){
+    size_t const n = left - done < sizeof(buf) ? left - done : sizeof(buf);
+    ssize_t const rc = pread(e->spool_fd, buf, n, e->spool_off + done);
+    assert(rc == (ssize_t)n && "Spool not readable");
+
+    size_t w = 0;
+    while(w < n){
+      ssize_t const m = pwrite(e->spool_fd, buf + w, n - w, done + w);
+      assert(m > 0 && "Spool not writable");
+      w += m;
+    }
+    done += n;
+  }
+
+  int const rc = ftruncate(e->spool_fd, left);
+  assert(rc == 0);
+  e->spool_off = 0;
+  update_spool_len(e, left);
+}
+
+static
+void spool(influx_export_t* e, char const* buf, size_t len)
+{
+  // The sink was lost while replaying
+  compact_spool(e);
+
+  int rc = pthread_mutex_lock(&e->mtx);
+  assert(rc == 0);
+
+  size_t const off = e->stats.spool_len;
+  bool const fits = e->spool_fd > -1 && off + len <= e->spool_max;
+  if(fits == true){
+    e->stats.spool_len += len;
+    e->stats.spooled += len;
+  } else {
+    e->stats.dropped += count_lines(buf, len);
+  }
+
+  rc = pthread_mutex_unlock(&e->mtx);
+  assert(rc == 0);
+
+  if(fits == false)
+    return;
+
+  size_t done = 0;
+  while(done < len){
+    ssize_t const n = pwrite(e->spool_fd, buf + done, len - done, off + done);
+    assert(n > 0 && "Spool not writable");
+    done += n;
+  }
+}
+
+static
+void deliver(influx_export_t* e, influx_batch_t const* b)
+{
+  size_t sent = 0;
+  if(reachable(e) == true){
+    if(send_all(e, b->buf, b->len, &sent) == true){
+      add_sent(e, b->len, false);
+      return;
+    }
+    close_sink(e);
+  }
+
+  // The partial line is dropped by the sink, so spool it whole
+  while(sent > 0 && b->buf[sent - 1] != '\n')
+    sent -= 1;
+  spool(e, b->buf + sent, b->len - sent);
+}
+
+// Whole lines of the spool from spool_off, up to the batch size
+static
+size_t read_chunk(influx_export_t* e, char* buf, size_t left)
+{
+  size_t n = left < e->batch_size ? left : e->batch_size;
+  ssize_t rc = pread(e->spool_fd, buf, n, e->spool_off);
+  assert(rc == (ssize_t)n && "Spool not readable");
+
+  size_t last = n;
+  while(last > 0 && buf[last - 1] != '\n')
+    last -= 1;
+  if(last > 0)
+    return last;
+
+  // Point longer than a batch
+  n = left < MAX_LINE_LEN ? left : MAX_LINE_LEN;
+  rc = pread(e->spool_fd, buf, n, e->spool_off);
+  assert(rc == (ssize_t)n && "Spool not readable");
+  char const* end = memchr(buf, '\n', n);
+  // Truncated, e.g., the process died while spooling. Skipped
+  return end != NULL ? (size_t)(end + 1 - buf) : n;
+}
+
+static
+void replay(influx_export_t* e, char* buf)
+{
+  if(e->spool_fd == -1)
+    return;
+
+  size_t const len = spool_len(e);
+  for(int i = 0; i < REPLAY_CHUNKS && e->spool_off < len && reachable(e) == true; ++i){
+    size_t const n = read_chunk(e, buf, len - e->spool_off);
+    if(buf[n - 1] != '\n'){
+      e->spool_off += n;
+      continue;
+    }
+
+    size_t sent = 0;
+    if(send_all(e, buf, n, &sent) == false){
+      while(sent > 0 && buf[sent - 1] != '\n')
+        sent -= 1;
+      e->spool_off += sent;
+      close_sink(e);
+      break;
+    }
+    e->spool_off += n;
+    add_sent(e, n, true);
+  }
+
+  // New batches are spooled by this thread only, i.e., len is still the end
+  if(e->spool_off == len || reachable(e) == false)
+    compact_spool(e);
+}
+
+// Called with the mutex held
+static
+void seal(influx_export_t* e)
+{
+  if(e->cur.len == 0)
+    return;
+
+  if(e->len == INFLUX_EXPORT_MAX_PENDING){
+    influx_batch_t* old = &e->pending[e->head];
+    e->stats.dropped += count_lines(old->buf, old->len);
+    free(old->buf);
+    e->head = (e->head + 1) % INFLUX_EXPORT_MAX_PENDING;
+    e->len -= 1;
+    e->handled += 1;
+  }
+
+  e->pending[(e->head + e->len) % INFLUX_EXPORT_MAX_PENDING] = e->cur;
+  e->len += 1;
+  e->queued += 1;
+  e->cur = (influx_batch_t){0};
+
+  int const rc = pthread_cond_broadcast(&e->cv);
+  assert(rc == 0);
+}
+
+static
+struct timespec abs_time(int64_t ms)
+{
+  struct timespec ts = {.tv_sec = ms/1000, .tv_nsec = (ms % 1000)*1000000};
+  return ts;
+}
+
+// Called with the mutex held. Returns when a batch is ready, or the spool
+// may be replayed
+static
+void wait_work(influx_export_t* e)
+{
+  while(e->stop == false && e->len == 0){
+    int64_t const now = now_ms();
+    int64_t deadline = INT64_MAX;
+    if(e->cur.len > 0)
+      deadline = e->cur_since_ms + e->flush_ms;
+    if(e->spool_off < e->stats.spool_len){
+      int64_t const retry = e->connected ? now : e->retry_at_ms;
+      deadline = retry < deadline ? retry : deadline;
+    }
+
+    if(deadline <= now)
+      break;
+
+    int rc = 0;
+    if(deadline == INT64_MAX){
+      rc = pthread_cond_wait(&e->cv, &e->mtx);
+    } else {
+      struct timespec const ts = abs_time(deadline);
+      rc = pthread_cond_timedwait(&e->cv, &e->mtx, &ts);
+    }
+    assert(rc == 0 || rc == ETIMEDOUT);
+  }
+
+  if(e->cur.len > 0 && (e->stop == true || now_ms() - e->cur_since_ms >= e->flush_ms))
+    seal(e);
+}
+
+static
+void* writer_thread(void* arg)
+{
+  influx_export_t* e = (influx_export_t*)arg;
+
+  influx_batch_t* batch = calloc(INFLUX_EXPORT_MAX_PENDING, sizeof(influx_batch_t));
+  assert(batch != NULL && "Memory exhausted");
+  size_t const len_buf = e->batch_size > MAX_LINE_LEN ? e->batch_size : MAX_LINE_LEN;
+  char* buf = malloc(len_buf);
+  assert(buf != NULL && "Memory exhausted");
+
+  while(true){
+    int rc = pthread_mutex_lock(&e->mtx);
+    assert(rc == 0);
+
+    wait_work(e);
+
+    bool const stop = e->stop;
+    size_t const len = e->len;
+    for(size_t i = 0; i < len; ++i)
+      batch[i] = e->pending[(e->head + i) % INFLUX_EXPORT_MAX_PENDING];
+    e->head = (e->head + len) % INFLUX_EXPORT_MAX_PENDING;
+    e->len = 0;
+
+    rc = pthread_mutex_unlock(&e->mtx);
+    assert(rc == 0);
+
+    for(size_t i = 0; i < len; ++i){
+      deliver(e, &batch[i]);
+      free(batch[i].buf);
+    }
+
+    // The spool is kept for the next run when stopping, without its 
+    // replayed prefix
+    if(stop == false)
+      replay(e, buf);
+    else
+      compact_spool(e);
+
+    rc = pthread_mutex_lock(&e->mtx);
+    assert(rc == 0);
+    e->handled += len;
+    rc = pthread_cond_broadcast(&e->cv);
+    assert(rc == 0);
+    rc = pthread_mutex_unlock(&e->mtx);
+    assert(rc == 0);
+
+    if(stop == true)
+      break;
+  }
+
+  free(buf);
+  free(batch);
+  return NULL;
+}
+
+void init_influx_export(influx_export_t* e, char const* sink, char const* batch, char const* spool)
+{
+  assert(e != NULL);
+  assert(sink != NULL);
+
+  *e = (influx_export_t){0};
+  e->fd = -1;
+  e->spool_fd = -1;
+  e->batch_size = INFLUX_EXPORT_BATCH_SIZE;
+  e->flush_ms = INFLUX_EXPORT_FLUSH_MS;
+  e->spool_max = INFLUX_EXPORT_SPOOL_SIZE;
+
+  if(parse_sink(sink, &e->tcp, &e->addr) == false){
+    printf("[INFLUX]: Malformed INFLUX_SINK = %s\n", sink);
+    assert(0 != 0 && "Malformed INFLUX_SINK");
+  }
+
+  int64_t retry_ms = INFLUX_EXPORT_RETRY_MS;
+  if(batch != NULL && parse_batch(batch, e, &retry_ms) == false){
+    printf("[INFLUX]: Malformed INFLUX_BATCH = %s\n", batch);
+    assert(0 != 0 && "Malformed INFLUX_BATCH");
+  }
+  int64_t const max_ms = 30*retry_ms;
+  init_backoff(&e->backoff, retry_ms, max_ms);
+
+  if(spool != NULL){
+    e->spool_fd = open(spool, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if(e->spool_fd == -1){
+      printf("[INFLUX]: Spool %s: %s\n", spool, strerror(errno));
+      assert(0 != 0 && "Spool not writable");
+    }
+
+    // Points left by the previous run
+    struct stat st = {0};
+    int const rc = fstat(e->spool_fd, &st);
+    assert(rc == 0);
+    e->stats.spool_len = st.st_size;
+  }
+
+  e->pending = calloc(INFLUX_EXPORT_MAX_PENDING, sizeof(influx_batch_t));
+  assert(e->pending != NULL && "Memory exhausted");
+
+  pthread_mutexattr_t attr = {0};
+#ifdef DEBUG
+  pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_ERRORCHECK);
+#endif
+  int rc = pthread_mutex_init(&e->mtx, &attr);
+  assert(rc == 0);
+
+  pthread_condattr_t c_attr = {0};
+  rc = pthread_condattr_init(&c_attr);
+  assert(rc == 0);
+  rc = pthread_condattr_setclock(&c_attr, CLOCK_MONOTONIC);
+  assert(rc == 0);
+  rc = pthread_cond_init(&e->cv, &c_attr);
+  assert(rc == 0);
+  rc = pthread_condattr_destroy(&c_attr);
+  assert(rc == 0);
+
+  rc = pthread_create(&e->p, NULL, writer_thread, e);
+  assert(rc == 0);
+}
+
+void free_influx_export(influx_export_t* e)
+{
+  assert(e != NULL);
+
+  int rc = pthread_mutex_lock(&e->mtx);
+  assert(rc == 0);
+  e->stop = true;
+  seal(e);
+  rc = pthread_cond_broadcast(&e->cv);
+  assert(rc == 0);
+  rc = pthread_mutex_unlock(&e->mtx);
+  assert(rc == 0);
+
+  rc = pthread_join(e->p, NULL);
+  assert(rc == 0);
+
+  assert(e->len == 0);
+  free(e->pending);
+
+  if(e->connected == true)
+    close(e->fd);
+  if(e->spool_fd > -1)
+    close(e->spool_fd);
+
+  rc = pthread_mutex_destroy(&e->mtx);
+  assert(rc == 0);
+  rc = pthread_cond_destroy(&e->cv);
+  assert(rc == 0);
+}
+
+void push_influx_export(influx_export_t* e, char const* lines, size_t len)
+{
+  assert(e != NULL);
+  assert(lines != NULL);
+  assert(len > 0 && lines[len - 1] == '\n' && "Not whole points");
+
+  int rc = pthread_mutex_lock(&e->mtx);
+  assert(rc == 0);
+
+  char const* it = lines;
+  char const* end = lines + len;
+  while(it != end){
+    char const* nl = memchr(it, '\n', end - it);
+    size_t const len_line = nl + 1 - it;
+
+    if(e->cur.len > 0 && e->cur.len + len_line > e->batch_size)
+      seal(e);
+
+    if(e->cur.len == 0){
+      size_t const cap = len_line > e->batch_size ? len_line : e->batch_size;
+      e->cur.buf = malloc(cap);
+      assert(e->cur.buf != NULL && "Memory exhausted");
+      e->cur_since_ms = now_ms();
+    }
+
+    memcpy(e->cur.buf + e->cur.len, it, len_line);
+    e->cur.len += len_line;
+    e->stats.points += 1;
+    it = nl + 1;
+  }
+
+  if(e->cur.len >= e->batch_size)
+    seal(e);
+
+  rc = pthread_mutex_unlock(&e->mtx);
+  assert(rc == 0);
+}
+
+void flush_influx_export(influx_export_t* e)
+{
+  assert(e != NULL);
+
+  int rc = pthread_mutex_lock(&e->mtx);
+  assert(rc == 0);
+
+  seal(e);
+  uint64_t const target = e->queued;
+  while(e->handled < target){
+    rc = pthread_cond_wait(&e->cv, &e->mtx);
+    assert(rc == 0);
+  }
+
+  rc = pthread_mutex_unlock(&e->mtx);
+  assert(rc == 0);
+}
+
+influx_export_stats_t stats_influx_export(influx_export_t* e)
+{
+  assert(e != NULL);
+
+  int rc = pthread_mutex_lock(&e->mtx);
+  assert(rc == 0);
+  influx_export_stats_t const s = e->stats;
+  rc = pthread_mutex_unlock(&e->mtx);
+  assert(rc == 0);
+  return s;
+}
@@ -0,0 +1,130 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+#ifndef INFLUX_EXPORT_H
+#define INFLUX_EXPORT_H
+
+// Batched export of line protocol points, see line_proto.h, to a UDP or TCP
+// sink, e.g., the socket_listener of Telegraf or the UDP service of InfluxDB.
+// Points are packed into batches of at most size bytes (one datagram each over
+// UDP), which leave once full or ms after their first point. A dedicated
+// thread sends them. While the sink is unreachable, the batches are appended
+// to a bounded spool file, and replayed once it is back. The replayed points
+// leave the spool once drained, when the sink is lost again, or on stop. Replays
+// may repeat points, which InfluxDB overwrites, as they keep their series and
+// timestamp.
+// Over UDP, the sink is unreachable once an ICMP error arrives, i.e., the batch
+// sent just before it went down is lost. Configured through the configuration file:
+//  INFLUX_SINK = udp://127.0.0.1:8094
+//  INFLUX_BATCH = size=1400;ms=100;spool=64M;retry=1000
+//  INFLUX_SPOOL = /var/tmp/flexric_influx.lp
+// retry is the base of the exponential backoff of the reconnections, capped at
+// 30 times it, see util/backoff.h
+
+#include "../../util/backoff.h"
+
+#include <netinet/in.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define INFLUX_EXPORT_BATCH_SIZE 1400
+#define INFLUX_EXPORT_FLUSH_MS 100
+#define INFLUX_EXPORT_SPOOL_SIZE (64*1024*1024)
+#define INFLUX_EXPORT_RETRY_MS 1000
+#define INFLUX_EXPORT_MAX_PENDING 1024
+
+typedef struct{
+  // Points accepted
+  uint64_t points;
+  uint64_t batches;
+  // Sent, including the replayed ones
+  uint64_t bytes;
+  // Written to and sent from the spool
+  uint64_t spooled;
+  uint64_t replayed;
+  // Points dropped, as the spool was full or absent, or the queue overflowed
+  uint64_t dropped;
+  // Bytes in the spool, still to be replayed
+  size_t spool_len;
+  bool reachable;
+} influx_export_stats_t;
+
+typedef struct{
+  char* buf;
+  size_t len;
+} influx_batch_t;
+
+typedef struct{
+  // Sink
+  bool tcp;
+  struct sockaddr_in addr;
+  int fd;
+  bool connected;
+  backoff_t backoff;
+  int64_t retry_at_ms;
+
+  size_t batch_size;
+  int64_t flush_ms;
+
+  // Spool. -1 if absent
+  int spool_fd;
+  size_t spool_max;
+  size_t spool_off;
+
+  // Batch being filled
+  influx_batch_t cur;
+  int64_t cur_since_ms;
+
+  // Full batches. Ring buffer
+  influx_batch_t* pending;
+  size_t head;
+  size_t len;
+
+  // Batches queued and handled, see flush_influx_export
+  uint64_t queued;
+  uint64_t handled;
+
+  influx_export_stats_t stats;
+
+  bool stop;
+  pthread_t p;
+  pthread_mutex_t mtx;
+  pthread_cond_t cv;
+} influx_export_t;
+
+// sink: udp://<host>:<port> or tcp://<host>:<port>. batch and spool may be NULL.
+// Asserts if malformed
+void init_influx_export(influx_export_t* e, char const* sink, char const* batch, char const* spool);
+
+// Sends or spools the pending points
+void free_influx_export(influx_export_t* e);
+
+// lines: whole points, i.e., every point ends with a line feed
+void push_influx_export(influx_export_t* e, char const* lines, size_t len);
+
+// Returns once the points pushed before were sent or spooled
+void flush_influx_export(influx_export_t* e);
+
+influx_export_stats_t stats_influx_export(influx_export_t* e);
+
+#endif
@@ -0,0 +1,275 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+#include "line_proto.h"
+
+#include <assert.h>
+#include <inttypes.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static
+void reserve(line_proto_t* lp, size_t len)
+{
+  if(lp->len + len + 1 <= lp->cap)
+    return;
+
+  size_t cap = lp->cap == 0 ? 256 : lp->cap;
+  while(cap < lp->len + len + 1)
+    cap *= 2;
+
+  lp->buf = realloc(lp->buf, cap);
+  assert(lp->buf != NULL && "Memory exhausted");
+  lp->cap = cap;
+}
+
+static
+void append(line_proto_t* lp, char const* s, size_t len)
+{
+  reserve(lp, len);
+  memcpy(lp->buf + lp->len, s, len);
+  lp->len += len;
+  lp->buf[lp->len] = '\0';
+}
+
+static
+void append_char(line_proto_t* lp, char c)
+{
+  append(lp, &c, 1);
+}
+
+// Escapes the characters in esc with a backslash
+static
+void append_esc(line_proto_t* lp, char const* s, size_t len, char const* esc)
+{
+  reserve(lp, 2*len);
+  for(size_t i = 0; i < len; ++i){
+    // A line feed would start a new point
+    char const c = s[i] == '\n' ? ' ' : s[i];
+    if(strchr(esc, c) != NULL)
+      lp->buf[lp->len++] = '\\';
+    lp->buf[lp->len++] = c;
+  }
+  lp->buf[lp->len] = '\0';
+}
+
+// JSON string, quotes included
+static
+void append_json(line_proto_t* lp, char const* s, size_t len)
+{
+  // Worst case, every character as \u00XX
+  reserve(lp, 6*len + 2);
+  lp->buf[lp->len++] = '"';
+  for(size_t i = 0; i < len; ++i){
+    unsigned char const c = s[i];
+    if(c == '"' || c == '\\'){
+      lp->buf[lp->len++] = '\\';
+      lp->buf[lp->len++] = c;
+    } else if(c < 0x20){
+      lp->len += snprintf(lp->buf + lp->len, 7, "\\u%04x", c);
+    } else {
+      lp->buf[lp->len++] = c;
+    }
+  }
+  lp->buf[lp->len++] = '"';
+  lp->buf[lp->len] = '\0';
+}
+
+void init_line_proto(line_proto_t* lp, line_proto_fmt_e fmt)
+{
+  assert(lp != NULL);
+  assert(fmt < END_LINE_PROTO);
+  *lp = (line_proto_t){.fmt = fmt};
+}
+
+bool fmt_line_proto(char const* name, line_proto_fmt_e* fmt)
+{
+  assert(name != NULL);
+  assert(fmt != NULL);
+
+  if(strcmp(name, "line") == 0)
+    *fmt = INFLUX_LINE_PROTO;
+  else if(strcmp(name, "json") == 0)
+    *fmt = JSON_LINE_PROTO;
+  else
+    return false;
+  return true;
+}
+
+void free_line_proto(line_proto_t* lp)
+{
+  assert(lp != NULL);
+  free(lp->buf);
+  *lp = (line_proto_t){.fmt = lp->fmt};
+}
+
+void clear_line_proto(line_proto_t* lp)
+{
+  assert(lp != NULL);
+  lp->len = 0;
+  lp->start = 0;
+  lp->open = false;
+  if(lp->buf != NULL)
+    lp->buf[0] = '\0';
+}
+
+void begin_line_proto(line_proto_t* lp, char const* meas)
+{
+  assert(lp != NULL);
+  assert(meas != NULL && meas[0] != '\0');
+  assert(lp->open == false && "Previous point not ended");
+
+  lp->start = lp->len;
+  lp->num_tags = 0;
+  lp->num_fields = 0;
+  lp->open = true;
+
+  if(lp->fmt == JSON_LINE_PROTO){
+    append(lp, "{\"meas\":", 8);
+    append_json(lp, meas, strlen(meas));
+    append(lp, ",\"tags\":{", 9);
+  } else {
+    append_esc(lp, meas, strlen(meas), ", ");
+  }
+}
+
+void tag_line_proto(line_proto_t* lp, char const* key, char const* val)
+{
+  assert(lp != NULL);
+  assert(key != NULL);
+  assert(val != NULL);
+  assert(lp->open == true);
+  assert(lp->num_fields == 0 && "Tags go before the fields");
+
+  if(val[0] == '\0')
+    return;
+
+  if(lp->fmt == JSON_LINE_PROTO){
+    if(lp->num_tags > 0)
+      append_char(lp, ',');
+    append_json(lp, key, strlen(key));
+    append_char(lp, ':');
+    append_json(lp, val, strlen(val));
+  } else {
+    append_char(lp, ',');
+    append_esc(lp, key, strlen(key), ",= ");
+    append_char(lp, '=');
+    append_esc(lp, val, strlen(val), ",= ");
+  }
+  lp->num_tags += 1;
+}
+
+void tag_u64_line_proto(line_proto_t* lp, char const* key, uint64_t val)
+{
+  char s[24] = {0};
+  snprintf(s, sizeof(s), "%" PRIu64, val);
+  tag_line_proto(lp, key, s);
+}
+
+static
+void field_key(line_proto_t* lp, char const* key)
+{
+  assert(lp != NULL);
+  assert(key != NULL && key[0] != '\0');
+  assert(lp->open == true);
+
+  if(lp->fmt == JSON_LINE_PROTO){
+    // The first field closes the tags
+    if(lp->num_fields == 0)
+      append(lp, "},\"fields\":{", 12);
+    else
+      append_char(lp, ',');
+    append_json(lp, key, strlen(key));
+    append_char(lp, ':');
+  } else {
+    append_char(lp, lp->num_fields == 0 ? ' ' : ',');
+    append_esc(lp, key, strlen(key), ",= ");
+    append_char(lp, '=');
+  }
+  lp->num_fields += 1;
+}
+
+void int_line_proto(line_proto_t* lp, char const* key, int64_t val)
+{
+  field_key(lp, key);
+
+  char s[24] = {0};
+  char const* fmt = lp->fmt == JSON_LINE_PROTO ? "%" PRId64 : "%" PRId64 "i";
+  int const rc = snprintf(s, sizeof(s), fmt, val);
+  assert(rc > 0 && rc < (int)sizeof(s));
+  append(lp, s, rc);
+}
+
+void float_line_proto(line_proto_t* lp, char const* key, double val)
+{
+  if(isfinite(val) == false)
+    return;
+
+  field_key(lp, key);
+
+  char s[32] = {0};
+  int const rc = snprintf(s, sizeof(s), "%.17g", val);
+  assert(rc > 0 && rc < (int)sizeof(s));
+  append(lp, s, rc);
+}
+
+void bool_line_proto(line_proto_t* lp, char const* key, bool val)
+{
+  field_key(lp, key);
+  append(lp, val ? "true" : "false", val ? 4 : 5);
+}
+
+void str_line_proto(line_proto_t* lp, char const* key, char const* val, size_t len)
+{
+  assert(val != NULL || len == 0);
+
+  field_key(lp, key);
+  if(lp->fmt == JSON_LINE_PROTO){
+    append_json(lp, val, len);
+  } else {
+    append_char(lp, '"');
+    append_esc(lp, val, len, "\"\\");
+    append_char(lp, '"');
+  }
+}
+
+bool end_line_proto(line_proto_t* lp, int64_t tstamp_ns)
+{
+  assert(lp != NULL);
+  assert(lp->open == true);
+  lp->open = false;
+
+  if(lp->num_fields == 0){
+    lp->len = lp->start;
+    if(lp->buf != NULL)
+      lp->buf[lp->len] = '\0';
+    return false;
+  }
+
+  char s[32] = {0};
+  char const* fmt = lp->fmt == JSON_LINE_PROTO ? "},\"ts\":%" PRId64 "}\n" : " %" PRId64 "\n";
+  int const rc = snprintf(s, sizeof(s), fmt, tstamp_ns);
+  assert(rc > 0 && rc < (int)sizeof(s));
+  append(lp, s, rc);
+  return true;
+}
@@ -0,0 +1,93 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+#ifndef LINE_PROTOCOL_H
+#define LINE_PROTOCOL_H
+
+// Builder of telemetry points, one per line, in InfluxDB line protocol:
+//
+//  <measurement>[,<tag>=<value>...] <field>=<value>[,<field>=<value>...] <timestamp ns>
+//
+// e.g., mac,node=505-1-1,ue=1234 dl_aggr_tbs=100i,pusch_snr=21.5 1700000000000000000
+// Measurements, tag keys, tag values and field keys are escaped. Integers carry
+// the i suffix.
+//
+// or in JSON Lines:
+//
+// {"meas":"mac","tags":{"node":"505-1-1","ue":"1234"},"fields":{"dl_aggr_tbs":100,"pusch_snr":21.5},"ts":1700000000000000000}
+//
+// Non-finite floats are skipped in both, as neither has a representation for them
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef enum{
+  INFLUX_LINE_PROTO,
+  JSON_LINE_PROTO,
+
+  END_LINE_PROTO
+} line_proto_fmt_e;
+
+typedef struct{
+  char* buf;
+  size_t len;
+  size_t cap;
+
+  line_proto_fmt_e fmt;
+
+  // Start of the point being built
+  size_t start;
+  size_t num_tags;
+  size_t num_fields;
+  bool open;
+} line_proto_t;
+
+void init_line_proto(line_proto_t* lp, line_proto_fmt_e fmt);
+
+// name: "line" or "json". Returns false if unknown
+bool fmt_line_proto(char const* name, line_proto_fmt_e* fmt);
+
+void free_line_proto(line_proto_t* lp);
+
+// Drops all the points
+void clear_line_proto(line_proto_t* lp);
+
+void begin_line_proto(line_proto_t* lp, char const* meas);
+
+// Tags go before the fields. Tags with an empty value are skipped
+void tag_line_proto(line_proto_t* lp, char const* key, char const* val);
+
+void tag_u64_line_proto(line_proto_t* lp, char const* key, uint64_t val);
+
+void int_line_proto(line_proto_t* lp, char const* key, int64_t val);
+
+void float_line_proto(line_proto_t* lp, char const* key, double val);
+
+void bool_line_proto(line_proto_t* lp, char const* key, bool val);
+
+void str_line_proto(line_proto_t* lp, char const* key, char const* val, size_t len);
+
+// Closes the point. A point without fields is invalid, and thus dropped.
+// Returns whether the point was kept
+bool end_line_proto(line_proto_t* lp, int64_t tstamp_ns);
+
+#endif
@@ -25,8 +25,9 @@
 #include <assert.h>
 #include <stdio.h>
 
-void notify_redis_listener(sm_ag_if_rd_ind_t const* data)
+void notify_redis_listener(global_e2_node_id_t const* id, sm_ag_if_rd_ind_t const* data)
 {
+  (void)id;
   assert(data != NULL);
   assert(data->type == MAC_STATS_V0 || data->type == RLC_STATS_V0 || data->type == PDCP_STATS_V0 
       || data->type == SLICE_STATS_V0 || data->type == KPM_STATS_V3_0 || data->type == GTP_STATS_V0
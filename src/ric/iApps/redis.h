@@ -23,9 +23,10 @@
 #ifndef REDIS_LISTENER_H
 #define REDIS_LISTENER_H
 
+#include "lib/e2ap/e2ap_global_node_id_wrapper.h"
 #include "sm/agent_if/read/sm_ag_if_rd.h"
 
-void notify_redis_listener(sm_ag_if_rd_ind_t const* data);
+void notify_redis_listener(global_e2_node_id_t const* id, sm_ag_if_rd_ind_t const* data);
 
 #endif
 
@@ -24,9 +24,30 @@
 #ifndef LISTENER_STDOUT_H
 #define LISTENER_STDOUT_H
 
+// Writes the indications to a rotating telemetry file, see telemetry_file.h,
+// with the points of ind_line_proto. JSON Lines by default, or InfluxDB line
+// protocol. Configured through the configuration file:
+//  TELEMETRY_FILE = /var/log/flexric/telemetry.jsonl
+//  TELEMETRY_FORMAT = json or line
+//  TELEMETRY_ROTATE = size=64M;age=3600;keep=4;gzip=1;buf=4M;ms=1000
+
+#include "../../lib/e2ap/e2ap_global_node_id_wrapper.h"
 #include "../../sm/agent_if/read/sm_ag_if_rd.h"
+#include "telemetry_file.h"
 
-void notify_stdout_listener(sm_ag_if_rd_ind_t const* data);
+#define TELEMETRY_FILE_PATH "log.txt"
+
+// path NULL: TELEMETRY_FILE_PATH. format and rotate may be NULL
+void init_stdout_listener(char const* path, char const* format, char const* rotate);
+
+void free_stdout_listener(void);
+
+// id: NULL if the E2 Node is unknown
+void notify_stdout_listener(global_e2_node_id_t const* id, sm_ag_if_rd_ind_t const* data);
+
+void flush_stdout_listener(void);
+
+telemetry_file_stats_t stats_stdout_listener(void);
 
 #endif
 
@@ -25,11 +25,17 @@
 #ifndef SUBSCRIPTION_RIC_H
 #define SUBSCRIPTION_RIC_H
 
+#include "../../lib/e2ap/e2ap_global_node_id_wrapper.h"
 #include "../../sm/agent_if/read/sm_ag_if_rd.h"
 
+#include <stdatomic.h>
+
 typedef struct{
   char name[32];
-  void (*fp)(sm_ag_if_rd_ind_t const* data);
+  // id: E2 Node that sent the indication. NULL if unknown
+  void (*fp)(global_e2_node_id_t const* id, sm_ag_if_rd_ind_t const* data);
+  // NULL if always on. Toggled through the admin socket
+  atomic_bool const* on;
 } subs_ric_t;
 
 
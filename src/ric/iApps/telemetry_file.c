@@ -0,0 +1,511 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+#include "telemetry_file.h"
+#include "../../util/conf_file.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#ifdef TELEMETRY_GZIP
+#include <zlib.h>
+#endif
+
+// Room for the .<n>.gz suffixes
+#define MAX_PATH_LEN (PATH_MAX - 32)
+
+static
+int64_t now_ms(void)
+{
+  struct timespec tms = {0};
+  int const rc = clock_gettime(CLOCK_MONOTONIC, &tms);
+  assert(rc == 0);
+  return tms.tv_sec*1000 + tms.tv_nsec/1000000;
+}
+
+static
+size_t count_lines(char const* s, size_t len)
+{
+  size_t n = 0;
+  for(char const* it = memchr(s, '\n', len); it != NULL; it = memchr(it + 1, '\n', len - (it + 1 - s)))
+    n += 1;
+  return n;
+}
+
+static
+bool parse_rotate_opt(char* key, char* val, void* data)
+{
+  telemetry_file_t* t = (telemetry_file_t*)data;
+
+  bool ok = false;
+  long long v = 0;
+  if(strcmp(key, "size") == 0){
+    ok = parse_size_conf(val, &t->max_size);
+  } else if(strcmp(key, "age") == 0){
+    ok = parse_num_conf(val, 0, INT32_MAX, &v);
+    t->max_age_ms = v*1000;
+  } else if(strcmp(key, "keep") == 0){
+    ok = parse_num_conf(val, 0, 1000, &v);
+    t->keep = v;
+  } else if(strcmp(key, "gzip") == 0){
+    ok = parse_num_conf(val, 0, 1, &v);
+    t->gzip = v == 1;
+  } else if(strcmp(key, "buf") == 0){
+    ok = parse_size_conf(val, &t->buf_size);
+  } else if(strcmp(key, "ms") == 0){
+    ok = parse_num_conf(val, 1, INT32_MAX, &v);
+    t->flush_ms = v;
+  }
+  return ok;
+}
+
+static
+bool parse_rotate(char const* rotate, telemetry_file_t* t)
+{
+  return parse_kv_conf(strlen(rotate), rotate, parse_rotate_opt, t);
+}
+
+// Path of the rotated segment n, e.g., telemetry.jsonl.2.gz
+static
+void segment_path(telemetry_file_t const* t, size_t n, bool gz, char* dst)
+{
+  int const rc = snprintf(dst, PATH_MAX, "%s.%zu%s", t->path, n, gz ? ".gz" : "");
+  assert(rc > 0 && rc < PATH_MAX);
+}
+
+static
+void open_segment(telemetry_file_t* t)
+{
+  t->fd = open(t->path, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+  if(t->fd == -1){
+    printf("[TELEMETRY]: File %s: %s\n", t->path, strerror(errno));
+    assert(0 != 0 && "Telemetry file not writable");
+  }
+
+  struct stat st = {0};
+  int const rc = fstat(t->fd, &st);
+  assert(rc == 0);
+  t->size = st.st_size;
+  t->opened_ms = now_ms();
+}
+
+#ifdef TELEMETRY_GZIP
+// Into a temporary file first, so that a crash does not leave a truncated .gz
+static
+bool compress_segment(char const* src, char const* dst)
+{
+  int const fd = open(src, O_RDONLY | O_CLOEXEC);
+  if(fd == -1)
+    return false;
+
+  char tmp[PATH_MAX] = {0};
+  int const rc = snprintf(tmp, sizeof(tmp), "%s.tmp", dst);
+  assert(rc > 0 && rc < (int)sizeof(tmp));
+
+  gzFile gz = gzopen(tmp, "wb");
+  if(gz == NULL){
+    close(fd);
+    return false;
+  }
+
+  bool ok = true;
+  char buf[64*1024];
+  for(;;){
+    ssize_t const n = read(fd, buf, sizeof(buf));
+    if(n == -1 && errno == EINTR)
+      continue;
+    if(n <= 0){
+      ok = n == 0;
+      break;
+    }
+    if(gzwrite(gz, buf, n) != n){
+      ok = false;
+      break;
+    }
+  }
+  close(fd);
+  ok = gzclose(gz) == Z_OK && ok;
+
+  if(ok == true && rename(tmp, dst) == 0){
+    unlink(src);
+    return true;
+  }
+  unlink(tmp);
+  return false;
+}
+#endif
+
+// path.<keep> is deleted, path.<n> becomes path.<n+1> and path becomes path.1
+static
+void rotate_segment(telemetry_file_t* t, bool* compressed)
+{
+  *compressed = false;
+
+  int rc = close(t->fd);
+  assert(rc == 0);
+  t->fd = -1;
+
+  char src[PATH_MAX] = {0};
+  char dst[PATH_MAX] = {0};
+
+  if(t->keep == 0){
+    unlink(t->path);
+  } else {
+    for(size_t i = 0; i < 2; ++i){
+      segment_path(t, t->keep, i == 1, dst);
+      unlink(dst);
+    }
+
+    // The .gz and plain variants, as the compression may have failed
+    for(size_t n = t->keep - 1; n > 0; --n){
+      for(size_t i = 0; i < 2; ++i){
+        segment_path(t, n, i == 1, src);
+        segment_path(t, n + 1, i == 1, dst);
+        rename(src, dst);
+      }
+    }
+
+    segment_path(t, 1, false, dst);
+    rc = rename(t->path, dst);
+    if(rc != 0)
+      printf("[TELEMETRY]: Rotating %s: %s\n", t->path, strerror(errno));
+
+#ifdef TELEMETRY_GZIP
+    if(rc == 0 && t->gzip == true){
+      segment_path(t, 1, true, src);
+      *compressed = compress_segment(dst, src);
+    }
+#endif
+  }
+
+  open_segment(t);
+}
+
+// On failure, the partial write is cut, so that the file keeps whole points
+static
+bool write_all(telemetry_file_t* t, char const* buf, size_t len)
+{
+  size_t off = 0;
+  while(off < len){
+    ssize_t const rc = write(t->fd, buf + off, len - off);
+    if(rc == -1 && errno == EINTR)
+      continue;
+
+    if(rc < 1){
+      if(t->failing == false)
+        printf("[TELEMETRY]: Writing %s: %s. Dropping points\n", t->path, strerror(rc == 0 ? ENOSPC : errno));
+      t->failing = true;
+      if(off > 0 && ftruncate(t->fd, t->size) != 0)
+        t->size += off;
+      return false;
+    }
+    off += rc;
+  }
+
+  t->size += len;
+  t->failing = false;
+  return true;
+}
+
+static
+bool rotation_due(telemetry_file_t const* t)
+{
+  if(t->size == 0)
+    return false;
+
+  return t->size >= t->max_size || (t->max_age_ms > 0 && now_ms() - t->opened_ms >= t->max_age_ms);
+}
+
+static
+void wait_work(telemetry_file_t* t)
+{
+  while(t->stop == false && t->req == t->done && t->cur.len < t->write_size){
+    int64_t const now = now_ms();
+    int64_t deadline = INT64_MAX;
+    if(t->cur.len > 0)
+      deadline = t->last_write_ms + t->flush_ms;
+    // Read only by this thread
+    if(t->max_age_ms > 0 && t->size > 0){
+      int64_t const age = t->opened_ms + t->max_age_ms;
+      deadline = age < deadline ? age : deadline;
+    }
+
+    if(deadline <= now)
+      break;
+
+    int rc = 0;
+    if(deadline == INT64_MAX){
+      rc = pthread_cond_wait(&t->cv, &t->mtx);
+    } else {
+      struct timespec ts = {.tv_sec = deadline/1000, .tv_nsec = (deadline % 1000)*1000000};
+      rc = pthread_cond_timedwait(&t->cv, &t->mtx, &ts);
+    }
+    assert(rc == 0 || rc == ETIMEDOUT);
+  }
+}
+
+static
+void* writer_thread(void* arg)
+{
+  telemetry_file_t* t = (telemetry_file_t*)arg;
+
+  for(;;){
+    int rc = pthread_mutex_lock(&t->mtx);
+    assert(rc == 0);
+
+    wait_work(t);
+
+    if(t->stop == true && t->cur.len == 0){
+      t->done = t->req;
+      rc = pthread_mutex_unlock(&t->mtx);
+      assert(rc == 0);
+      break;
+    }
+
+    // The flushes requested until now are done by this round
+    uint64_t const req = t->req;
+    bool const rotate = t->rotate;
+    t->rotate = false;
+
+    // Double buffering. The callers fill cur while out is written
+    assert(t->out.len == 0);
+    telemetry_buf_t const tmp = t->out;
+    t->out = t->cur;
+    t->cur = tmp;
+    t->last_write_ms = now_ms();
+
+    rc = pthread_mutex_unlock(&t->mtx);
+    assert(rc == 0);
+
+    size_t const len = t->out.len;
+    uint64_t dropped = 0;
+    if(len > 0 && write_all(t, t->out.buf, len) == false)
+      dropped = count_lines(t->out.buf, len);
+    t->out.len = 0;
+
+    bool rotated = false;
+    bool compressed = false;
+    if(rotate == true ? t->size > 0 : rotation_due(t) == true){
+      rotate_segment(t, &compressed);
+      rotated = true;
+    }
+
+    rc = pthread_mutex_lock(&t->mtx);
+    assert(rc == 0);
+
+    t->done = req;
+    t->stats.bytes += dropped == 0 ? len : 0;
+    t->stats.dropped += dropped;
+    t->stats.rotations += rotated;
+    t->stats.compressed += compressed;
+    t->stats.size = t->size;
+
+    rc = pthread_cond_broadcast(&t->cv);
+    assert(rc == 0);
+    rc = pthread_mutex_unlock(&t->mtx);
+    assert(rc == 0);
+  }
+
+  return NULL;
+}
+
+void init_telemetry_file(telemetry_file_t* t, char const* path, char const* rotate)
+{
+  assert(t != NULL);
+  assert(path != NULL);
+
+  *t = (telemetry_file_t){0};
+  t->fd = -1;
+  t->max_size = TELEMETRY_FILE_SEGMENT_SIZE;
+  t->keep = TELEMETRY_FILE_KEEP;
+  t->buf_size = TELEMETRY_FILE_BUF_SIZE;
+  t->flush_ms = TELEMETRY_FILE_FLUSH_MS;
+
+  if(strlen(path) == 0 || strlen(path) > MAX_PATH_LEN){
+    printf("[TELEMETRY]: Invalid TELEMETRY_FILE = %s\n", path);
+    assert(0 != 0 && "Invalid TELEMETRY_FILE");
+  }
+
+  if(rotate != NULL && parse_rotate(rotate, t) == false){
+    printf("[TELEMETRY]: Malformed TELEMETRY_ROTATE = %s\n", rotate);
+    assert(0 != 0 && "Malformed TELEMETRY_ROTATE");
+  }
+
+#ifndef TELEMETRY_GZIP
+  if(t->gzip == true){
+    printf("[TELEMETRY]: Built without TELEMETRY_GZIP. Rotated segments not compressed\n");
+    t->gzip = false;
+  }
+#endif
+
+  // A write starts before the buffer fills
+  t->write_size = t->buf_size/2 < TELEMETRY_FILE_WRITE_SIZE ? t->buf_size/2 : TELEMETRY_FILE_WRITE_SIZE;
+
+  t->path = strdup(path);
+  assert(t->path != NULL && "Memory exhausted");
+
+  t->cur.buf = malloc(t->buf_size);
+  assert(t->cur.buf != NULL && "Memory exhausted");
+  t->out.buf = malloc(t->buf_size);
+  assert(t->out.buf != NULL && "Memory exhausted");
+
+  // Keep the points of the previous run
+  open_segment(t);
+  if(t->size > 0){
+    bool compressed = false;
+    rotate_segment(t, &compressed);
+    t->stats.rotations += 1;
+    t->stats.compressed += compressed;
+  }
+  t->last_write_ms = now_ms();
+
+  pthread_mutexattr_t attr = {0};
+#ifdef DEBUG
+  pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_ERRORCHECK);
+#endif
+  int rc = pthread_mutex_init(&t->mtx, &attr);
+  assert(rc == 0);
+
+  pthread_condattr_t c_attr = {0};
+  rc = pthread_condattr_init(&c_attr);
+  assert(rc == 0);
+  rc = pthread_condattr_setclock(&c_attr, CLOCK_MONOTONIC);
+  assert(rc == 0);
+  rc = pthread_cond_init(&t->cv, &c_attr);
+  assert(rc == 0);
+  rc = pthread_condattr_destroy(&c_attr);
+  assert(rc == 0);
+
+  rc = pthread_create(&t->p, NULL, writer_thread, t);
+  assert(rc == 0);
+}
+
+void free_telemetry_file(telemetry_file_t* t)
+{
+  assert(t != NULL);
+
+  int rc = pthread_mutex_lock(&t->mtx);
+  assert(rc == 0);
+  t->stop = true;
+  rc = pthread_cond_broadcast(&t->cv);
+  assert(rc == 0);
+  rc = pthread_mutex_unlock(&t->mtx);
+  assert(rc == 0);
+
+  rc = pthread_join(t->p, NULL);
+  assert(rc == 0);
+
+  assert(t->cur.len == 0);
+  free(t->cur.buf);
+  free(t->out.buf);
+  free(t->path);
+
+  rc = close(t->fd);
+  assert(rc == 0);
+
+  rc = pthread_mutex_destroy(&t->mtx);
+  assert(rc == 0);
+  rc = pthread_cond_destroy(&t->cv);
+  assert(rc == 0);
+}
+
+void push_telemetry_file(telemetry_file_t* t, char const* lines, size_t len)
+{
+  assert(t != NULL);
+  assert(lines != NULL);
+  assert(len > 0 && lines[len - 1] == '\n' && "Not whole points");
+
+  size_t const num = count_lines(lines, len);
+
+  int rc = pthread_mutex_lock(&t->mtx);
+  assert(rc == 0);
+
+  t->stats.points += num;
+  if(t->cur.len + len > t->buf_size){
+    // The writer lags behind, e.g., a slow disk
+    t->stats.dropped += num;
+  } else {
+    size_t const prev = t->cur.len;
+    memcpy(t->cur.buf + t->cur.len, lines, len);
+    t->cur.len += len;
+
+    // The writer sleeps without deadline while the buffer is empty
+    if(prev == 0 || (prev < t->write_size && t->cur.len >= t->write_size)){
+      rc = pthread_cond_broadcast(&t->cv);
+      assert(rc == 0);
+    }
+  }
+
+  rc = pthread_mutex_unlock(&t->mtx);
+  assert(rc == 0);
+}
+
+static
+void request_flush(telemetry_file_t* t, bool rotate)
+{
+  int rc = pthread_mutex_lock(&t->mtx);
+  assert(rc == 0);
+
+  uint64_t const req = ++t->req;
+  t->rotate |= rotate;
+  rc = pthread_cond_broadcast(&t->cv);
+  assert(rc == 0);
+
+  while(t->done < req){
+    rc = pthread_cond_wait(&t->cv, &t->mtx);
+    assert(rc == 0);
+  }
+
+  rc = pthread_mutex_unlock(&t->mtx);
+  assert(rc == 0);
+}
+
+void flush_telemetry_file(telemetry_file_t* t)
+{
+  assert(t != NULL);
+  request_flush(t, false);
+}
+
+void rotate_telemetry_file(telemetry_file_t* t)
+{
+  assert(t != NULL);
+  request_flush(t, true);
+}
+
+telemetry_file_stats_t stats_telemetry_file(telemetry_file_t* t)
+{
+  assert(t != NULL);
+
+  int rc = pthread_mutex_lock(&t->mtx);
+  assert(rc == 0);
+  telemetry_file_stats_t const s = t->stats;
+  rc = pthread_mutex_unlock(&t->mtx);
+  assert(rc == 0);
+  return s;
+}
@@ -0,0 +1,121 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+#ifndef TELEMETRY_FILE_H
+#define TELEMETRY_FILE_H
+
+// Rotating file of telemetry points, one per line, see line_proto.h. The
+// callers only append to a bounded buffer. A dedicated thread writes it once
+// it holds 64 KiB, or ms after the previous write. Points that do not fit
+// in the buffer are dropped. The current segment is path. Once it reaches size
+// bytes or age seconds, it becomes path.1, path.1 path.2 and so on, up to
+// path.<keep>, which is deleted, i.e., at most (keep+1)*size bytes plus a
+// write on disk. With gzip=1, the rotated segments are compressed into
+// path.<n>.gz by the same thread. A non-empty path left by a previous run is
+// rotated at start. Configured through the configuration file:
+//  TELEMETRY_FILE = /var/log/flexric/telemetry.jsonl
+//  TELEMETRY_ROTATE = size=64M;age=3600;keep=4;gzip=1;buf=4M;ms=1000
+// age=0 disables the rotation by age. gzip needs the TELEMETRY_GZIP build
+// option, i.e., zlib
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define TELEMETRY_FILE_SEGMENT_SIZE (64*1024*1024)
+#define TELEMETRY_FILE_KEEP 4
+#define TELEMETRY_FILE_BUF_SIZE (4*1024*1024)
+#define TELEMETRY_FILE_WRITE_SIZE (64*1024)
+#define TELEMETRY_FILE_FLUSH_MS 1000
+
+typedef struct{
+  // Points accepted
+  uint64_t points;
+  // Written, including the rotated segments
+  uint64_t bytes;
+  // Points dropped, as the buffer was full or the write failed
+  uint64_t dropped;
+  uint64_t rotations;
+  uint64_t compressed;
+  // Bytes in the current segment
+  size_t size;
+} telemetry_file_stats_t;
+
+typedef struct{
+  char* buf;
+  size_t len;
+} telemetry_buf_t;
+
+typedef struct{
+  char* path;
+  int fd;
+  // Of the current segment. Only read and written by the writer
+  size_t size;
+  int64_t opened_ms;
+  // The last write failed
+  bool failing;
+
+  size_t max_size;
+  int64_t max_age_ms;
+  size_t keep;
+  bool gzip;
+  size_t buf_size;
+  size_t write_size;
+  int64_t flush_ms;
+
+  // Filled by the callers, swapped with out by the writer
+  telemetry_buf_t cur;
+  telemetry_buf_t out;
+  int64_t last_write_ms;
+
+  // Flushes requested and done, see flush_telemetry_file
+  uint64_t req;
+  uint64_t done;
+  bool rotate;
+
+  telemetry_file_stats_t stats;
+
+  bool stop;
+  pthread_t p;
+  pthread_mutex_t mtx;
+  pthread_cond_t cv;
+} telemetry_file_t;
+
+// rotate may be NULL. Asserts if malformed or path is not writable
+void init_telemetry_file(telemetry_file_t* t, char const* path, char const* rotate);
+
+// Writes the pending points
+void free_telemetry_file(telemetry_file_t* t);
+
+// lines: whole points, i.e., every point ends with a line feed
+void push_telemetry_file(telemetry_file_t* t, char const* lines, size_t len);
+
+// Returns once the points pushed before were written or dropped
+void flush_telemetry_file(telemetry_file_t* t);
+
+// Rotates the current segment, if not empty, once the points pushed before
+// were written
+void rotate_telemetry_file(telemetry_file_t* t);
+
+telemetry_file_stats_t stats_telemetry_file(telemetry_file_t* t);
+
+#endif
@@ -133,11 +133,40 @@ global_e2_node_id_t* rm_map_sad_e2_node(map_e2_node_sockaddr_t* m, sctp_info_t c
   assert(s != NULL);
 
   lock_guard(&m->mtx);
+
+  // Removed in between, e.g., through the admin socket
+  void* it = assoc_front(&m->map.right);
+  void* end = assoc_end(&m->map.right);
+  it = find_if(&m->map.right, it, end, (sctp_info_t*)s, eq_sctp_info_wrapper);
+  if(it == end)
+    return NULL;
+
   void (*free_sctp_info)(void*) = NULL;
   global_e2_node_id_t* id = bi_map_extract_right(&m->map, (sctp_info_t*) s, sizeof(sctp_info_t), free_sctp_info);
   return id;
 }
 
+bool try_find_map_e2_node_sad(map_e2_node_sockaddr_t* m, global_e2_node_id_t const* id, sctp_info_t* dst)
+{
+  assert(m != NULL);
+  assert(id != NULL);
+  assert(dst != NULL);
+
+  lock_guard(&m->mtx);
+
+  assoc_rb_tree_t* tree = &m->map.left;  
+
+  void* it = assoc_front(tree);
+  void* end = assoc_end(tree);
+
+  it = find_if(tree, it, end, (global_e2_node_id_t*)id, eq_global_e2_node_id_wrapper);
+  if(it == end)
+    return false;
+
+  *dst = *(sctp_info_t*)assoc_value(tree, it);  
+  return true;
+}
+
 sctp_info_t find_map_e2_node_sad(map_e2_node_sockaddr_t* m, global_e2_node_id_t const* id)
 {
   assert(m != NULL);
@@ -31,6 +31,7 @@
 #include "../lib/ep/sctp_msg.h"
 
 #include <netinet/in.h>
+#include <stdbool.h>
 #include <pthread.h>
 
 typedef struct{
@@ -51,8 +52,12 @@ void add_map_e2_node_sad(map_e2_node_sockaddr_t* m, global_e2_node_id_t const* i
 
 //void rm_map_e2_node_sad(map_e2_node_sockaddr_t* m, global_e2_node_id_t* id);
 
+// NULL if s is not registered
 global_e2_node_id_t* rm_map_sad_e2_node(map_e2_node_sockaddr_t* m, sctp_info_t const* s);
 
+// False if id is not registered
+bool try_find_map_e2_node_sad(map_e2_node_sockaddr_t* m, global_e2_node_id_t const* id, sctp_info_t* dst);
+
 sctp_info_t find_map_e2_node_sad(map_e2_node_sockaddr_t* m, global_e2_node_id_t const* id);
 
 sctp_info_t find_map_e2_node_sad(map_e2_node_sockaddr_t * m, global_e2_node_id_t const* id);
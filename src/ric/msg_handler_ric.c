@@ -65,14 +65,24 @@ bool check_valid_msg_type(e2_msg_type_t msg_type)
   return false;
 }
 
+// Returns false if the pending event is gone, i.e., it timed out and the 
+// answer arrives late, or the answer was synthesized on its timeout
 static
-void stop_pending_event(near_ric_t* ric, pending_event_ric_t* ev )
+bool stop_pending_event(near_ric_t* ric, pending_event_ric_t* ev )
 {
   assert(ric != NULL);
   assert(ev != NULL);
 
   int rc = pthread_mutex_lock(&ric->pend_mtx);
   assert(rc == 0);
+
+  assoc_rb_tree_t* tree = &ric->pending.right;
+  if(find_if(tree, assoc_front(tree), assoc_end(tree), ev, eq_pending_event_ric) == assoc_end(tree)){
+    rc = pthread_mutex_unlock(&ric->pend_mtx);
+    assert(rc == 0);
+    return false;
+  }
+
   void (*free_pending_event)(void*) = NULL; 
   int* fd = bi_map_extract_right(&ric->pending, ev, sizeof(*ev), free_pending_event);
   rc = pthread_mutex_unlock(&ric->pend_mtx);
@@ -83,6 +93,7 @@ void stop_pending_event(near_ric_t* ric, pending_event_ric_t* ev )
   //printf("fd value in stopping pending event = %d \n", *fd);
   rm_fd_asio_ric(&ric->io, *fd);
   free(fd);
+  return true;
 }
 
 e2ap_msg_t e2ap_msg_handle_ric(near_ric_t* ric, const e2ap_msg_t* msg)
@@ -110,12 +121,25 @@ e2ap_msg_t e2ap_msg_handle_ric(near_ric_t* ric, const e2ap_msg_t* msg)
   ric_subscription_response_t const* resp = &msg->u_msgs.ric_sub_resp;
 
   pending_event_ric_t ev = {.ev = SUBSCRIPTION_REQUEST_PENDING_EVENT, .id = resp->ric_id }; 
-  stop_pending_event(ric, &ev);
+  if(stop_pending_event(ric, &ev) == false){
+    // Already answered with a failure and its ID released
+    printf("[NEAR-RIC]: SUBSCRIPTION RESPONSE rx RAN_FUNC_ID %d RIC_REQ_ID %d after its timeout. Discarding\n", resp->ric_id.ran_func_id, resp->ric_id.ric_req_id);
+    e2ap_msg_t ans = {.type = NONE_E2_MSG_TYPE};
+    return ans;
+  }
 
   assert(resp->len_na == 0 && "No other case implemented");
   assert(resp->len_admitted == 1 && "No other case implemented");
   assert(resp->admitted[0].ric_act_id == 0 && "No other case implemented");
 
+  // Once per subscription, so that the indications do not look it up 
+  // in the RIC Request ID allocator
+  global_e2_node_id_t node = {0};
+  if(node_ric_req_id(&ric->req_id, resp->ric_id.ric_req_id, &node) == true){
+    add_sub_node_ric(&ric->sub_node, resp->ric_id.ric_req_id, &node);
+    free_global_e2_node_id(&node);
+  }
+
   // Active Request
 //  act_req_t req = {.id = resp->ric_id};
 
@@ -139,7 +163,25 @@ e2ap_msg_t e2ap_msg_handle_ric(near_ric_t* ric, const e2ap_msg_t* msg)
   assert(ric != NULL);
   assert(msg != NULL);
   assert(msg->type == RIC_SUBSCRIPTION_FAILURE);
-  assert(0!=0 && "Not implemented");
+
+  ric_subscription_failure_t const* fail = &msg->u_msgs.ric_sub_fail;
+
+  pending_event_ric_t ev = {.ev = SUBSCRIPTION_REQUEST_PENDING_EVENT, .id = fail->ric_id }; 
+  if(stop_pending_event(ric, &ev) == false){
+    printf("[NEAR-RIC]: SUBSCRIPTION FAILURE rx RAN_FUNC_ID %d RIC_REQ_ID %d after its timeout. Discarding\n", fail->ric_id.ran_func_id, fail->ric_id.ric_req_id);
+    e2ap_msg_t ans = {.type = NONE_E2_MSG_TYPE};
+    return ans;
+  }
+
+  cause_t const cause = cause_ric_subscription_failure(fail);
+  printf("[NEAR-RIC]: SUBSCRIPTION FAILURE rx RAN_FUNC_ID %d RIC_REQ_ID %d CAUSE %d\n", fail->ric_id.ran_func_id, fail->ric_id.ric_req_id, cause.present);
+
+#ifndef TEST_AGENT_RIC  
+  notify_msg_iapp_api(msg);
+#endif
+
+  // Released after the iApp removed its mapping, as in the Subscription Delete Response
+  release_ric_req_id(&ric->req_id, fail->ric_id.ric_req_id);
 
   e2ap_msg_t ans = {.type = NONE_E2_MSG_TYPE};
   return ans;
@@ -155,11 +197,20 @@ e2ap_msg_t e2ap_msg_handle_ric(near_ric_t* ric, const e2ap_msg_t* msg)
   ric_subscription_delete_response_t const* resp = &msg->u_msgs.ric_sub_del_resp;
 
   pending_event_ric_t ev = {.ev = SUBSCRIPTION_DELETE_REQUEST_PENDING_EVENT, .id = resp->ric_id }; 
-  stop_pending_event(ric, &ev);
+  if(stop_pending_event(ric, &ev) == false){
+    printf("[NEAR-RIC]: SUBSCRIPTION DELETE RESPONSE rx RAN_FUNC_ID %d RIC_REQ_ID %d after its timeout. Discarding\n", resp->ric_id.ran_func_id, resp->ric_id.ric_req_id);
+    e2ap_msg_t ans = {.type = NONE_E2_MSG_TYPE};
+    return ans;
+  }
 
 #ifndef TEST_AGENT_RIC  
   notify_msg_iapp_api(msg);
 #endif
+
+  // Released after the iApp removed its mapping. Otherwise, the ID 
+  // could be handed out again while still in the iApp
+  rm_sub_node_ric(&ric->sub_node, resp->ric_id.ric_req_id);
+  release_ric_req_id(&ric->req_id, resp->ric_id.ric_req_id);
   e2ap_msg_t ans = {.type = NONE_E2_MSG_TYPE};
   return ans;
 }
@@ -170,15 +221,38 @@ e2ap_msg_t e2ap_msg_handle_ric(near_ric_t* ric, const e2ap_msg_t* msg)
   assert(ric != NULL);
   assert(msg != NULL);
   assert(msg->type == RIC_SUBSCRIPTION_DELETE_FAILURE);
-  assert(0!=0 && "Not implemented");
 
-  e2ap_msg_t ans = {.type = NONE_E2_MSG_TYPE };
+  ric_subscription_delete_failure_t const* fail = &msg->u_msgs.ric_sub_del_fail;
+
+  pending_event_ric_t ev = {.ev = SUBSCRIPTION_DELETE_REQUEST_PENDING_EVENT, .id = fail->ric_id }; 
+  if(stop_pending_event(ric, &ev) == false){
+    printf("[NEAR-RIC]: SUBSCRIPTION DELETE FAILURE rx RAN_FUNC_ID %d RIC_REQ_ID %d after its timeout. Discarding\n", fail->ric_id.ran_func_id, fail->ric_id.ric_req_id);
+    e2ap_msg_t ans = {.type = NONE_E2_MSG_TYPE};
+    return ans;
+  }
+
+  printf("[NEAR-RIC]: SUBSCRIPTION DELETE FAILURE rx RAN_FUNC_ID %d RIC_REQ_ID %d CAUSE %d\n", fail->ric_id.ran_func_id, fail->ric_id.ric_req_id, fail->cause.present);
+
+  // The xApp already gave the subscription up. As in a timeout, the 
+  // nearRT-RIC forgets it and the E2 Node stays with a stale one 
+#ifndef TEST_AGENT_RIC  
+  e2ap_msg_t const resp = {.type = RIC_SUBSCRIPTION_DELETE_RESPONSE, 
+                           .u_msgs.ric_sub_del_resp.ric_id = fail->ric_id};
+  notify_msg_iapp_api(&resp);
+#endif
+
+  rm_sub_node_ric(&ric->sub_node, fail->ric_id.ric_req_id);
+  release_ric_req_id(&ric->req_id, fail->ric_id.ric_req_id);
+  e2ap_msg_t ans = {.type = NONE_E2_MSG_TYPE};
   return ans;
 }
 
 static
-void publish_ind_msg(near_ric_t* ric,  uint16_t ran_func_id, sm_ag_if_rd_ind_t* d)
+void publish_ind_msg(near_ric_t* ric, uint16_t ran_func_id, uint32_t ric_req_id, sm_ag_if_rd_ind_t* d)
 {
+  // The listeners tag the data with its E2 Node
+  sub_node_t node = {0};
+  bool const has_node = find_sub_node_ric(&ric->sub_node, ric_req_id, &node);
 
   // find RIC request ID, pass the data to the assoc. SM
   void* start_it = assoc_front(&ric->pub_sub);
@@ -194,7 +268,8 @@ void publish_ind_msg(near_ric_t* ric,  uint16_t ran_func_id, sm_ag_if_rd_ind_t*
     void* it_end = seq_end(arr);
     while(it != it_end){
       subs_ric_t* sub = (subs_ric_t*)it;
-      sub->fp(d);
+      if(sub->on == NULL || *sub->on == true)
+        sub->fp(has_node ? &node.id : NULL, d);
       it = seq_next(arr, it);
     }
     start_it = assoc_next(&ric->pub_sub, start_it);
@@ -231,7 +306,7 @@ void publish_ind_msg(near_ric_t* ric,  uint16_t ran_func_id, sm_ag_if_rd_ind_t*
         || d.type == KPM_STATS_V3_0 || d.type == RAN_CTRL_STATS_V1_03 
         || d.type == GTP_STATS_V0 || d.type == TC_STATS_V0 );
 
-  publish_ind_msg(ric, ran_func_id, &d);
+  publish_ind_msg(ric, ran_func_id, ric_ind->ric_id.ric_req_id, &d);
 
   // Notify the iApp
 #ifndef TEST_AGENT_RIC  
@@ -255,7 +330,11 @@ void publish_ind_msg(near_ric_t* ric,  uint16_t ran_func_id, sm_ag_if_rd_ind_t*
 #endif
 
   pending_event_ric_t ev = {.ev = CONTROL_REQUEST_PENDING_EVENT, .id = ack->ric_id }; 
-  stop_pending_event(ric, &ev);
+  if(stop_pending_event(ric, &ev) == false){
+    printf("[NEAR-RIC]: CONTROL ACKNOWLEDGE rx RAN_FUNC_ID %d RIC_REQ_ID %d after its timeout. Discarding\n", ack->ric_id.ran_func_id, ack->ric_id.ric_req_id);
+    e2ap_msg_t ans = {.type = NONE_E2_MSG_TYPE};
+    return ans;
+  }
 
   printf("[NEAR-RIC]: CONTROL ACKNOWLEDGE rx\n");
 
@@ -263,6 +342,8 @@ void publish_ind_msg(near_ric_t* ric,  uint16_t ran_func_id, sm_ag_if_rd_ind_t*
   notify_msg_iapp_api(msg);
 #endif
 
+  release_ric_req_id(&ric->req_id, ack->ric_id.ric_req_id);
+
   e2ap_msg_t ans = {.type = NONE_E2_MSG_TYPE};
   return ans;
 }
@@ -273,9 +354,25 @@ void publish_ind_msg(near_ric_t* ric,  uint16_t ran_func_id, sm_ag_if_rd_ind_t*
   assert(ric != NULL);
   assert(msg != NULL);
   assert(msg->type == RIC_CONTROL_FAILURE);
-  assert(0!=0 && "not implemented" );
 
-  e2ap_msg_t ans = {0};
+  ric_control_failure_t const* fail = &msg->u_msgs.ric_ctrl_fail;
+
+  printf("[NEAR-RIC]: CONTROL FAILURE rx RAN_FUNC_ID %d RIC_REQ_ID %d CAUSE %d\n", fail->ric_id.ran_func_id, fail->ric_id.ric_req_id, fail->cause.present);
+
+  // Ack controls have a pending event. NAck (error-only) controls do not, 
+  // and their RIC Request ID is released by the iApp. Neither has an Ack 
+  // control that timed out, and the iApp discards it as unknown
+  pending_event_ric_t ev = {.ev = CONTROL_REQUEST_PENDING_EVENT, .id = fail->ric_id }; 
+  bool const ack_ctrl = stop_pending_event(ric, &ev);
+
+#ifndef TEST_AGENT_RIC  
+  notify_msg_iapp_api(msg);
+#endif
+
+  if(ack_ctrl == true)
+    release_ric_req_id(&ric->req_id, fail->ric_id.ric_req_id);
+
+  e2ap_msg_t ans = {.type = NONE_E2_MSG_TYPE};
   return ans;
 }
   
@@ -295,6 +392,41 @@ void publish_ind_msg(near_ric_t* ric,  uint16_t ran_func_id, sm_ag_if_rd_ind_t*
   return ans;
 }
 
+// Shallow copy of the RAN functions accepted in the E2 Setup Response
+static
+ran_function_t* accepted_ran_func(e2_setup_request_t const* req, e2_setup_response_t const* resp, size_t* len)
+{
+  assert(req != NULL);
+  assert(resp != NULL);
+  assert(len != NULL);
+
+  *len = 0;
+  if(resp->len_acc == 0)
+    return NULL;
+
+  ran_function_t* rf = calloc(resp->len_acc, sizeof(ran_function_t));
+  assert(rf != NULL && "Memory exhausted");
+
+  for(size_t i = 0; i < req->len_rf; ++i){
+    for(size_t j = 0; j < resp->len_acc; ++j){
+      if(req->ran_func_item[i].id == resp->accepted[j]){
+        rf[*len] = req->ran_func_item[i];
+        *len += 1;
+        break;
+      }
+    }
+  }
+
+  return rf;
+}
+
+static
+bool eq_e2_node_id(void const* it, void const* id)
+{
+  e2_node_t const* n = (e2_node_t const*)it;
+  return eq_global_e2_node_id(&n->id, id);
+}
+
 // E2 -> RIC
  e2ap_msg_t e2ap_handle_setup_request_ric(near_ric_t* ric, const e2ap_msg_t* msg)
 {
@@ -325,19 +457,34 @@ void publish_ind_msg(near_ric_t* ric,  uint16_t ran_func_id, sm_ag_if_rd_ind_t*
   else
     printf("[E2AP]: E2 SETUP-REQUEST rx from PLMN %3d.%*d Node ID %d RAN type %s ID %ld\n", plmn->mcc, plmn->mnc_digit_len, plmn->mnc, req->id.nb_id.nb_id, ran_type, *req->id.cu_du_id);
 
-  // Add the E2 Node into the iApp
+  e2ap_msg_t ans = {.type = E2_SETUP_RESPONSE };
+  ans.u_msgs.e2_stp_resp = generate_setup_response(&ric->ap.version.type, ric, req); 
+
+  // Add the E2 Node into the iApp. Only the accepted RAN functions are
+  // exposed to the xApps
+  size_t len_rf = 0;
+  ran_function_t* rf = accepted_ran_func(req, &ans.u_msgs.e2_stp_resp, &len_rf);
+  defer({ free(rf); });
+  if(len_rf > 0){
 #ifdef E2AP_V1
-  add_e2_node_iapp_api_v1((global_e2_node_id_t*)&req->id, req->len_rf, req->ran_func_item);
+    add_e2_node_iapp_api_v1((global_e2_node_id_t*)&req->id, len_rf, rf);
 #else
-  add_e2_node_iapp_api((global_e2_node_id_t*)&req->id, req->len_rf, req->ran_func_item, req->len_cca, req->comp_conf_add);
+    add_e2_node_iapp_api((global_e2_node_id_t*)&req->id, len_rf, rf, req->len_cca, req->comp_conf_add);
 #endif
-  e2ap_msg_t ans = {.type = E2_SETUP_RESPONSE };
-  ans.u_msgs.e2_stp_resp = generate_setup_response(&ric->ap.version.type, ric, req); 
+  }
 
   e2_node_t n = {0};
   init_e2_node(&n, &req->id, ans.u_msgs.e2_stp_resp.len_acc, ans.u_msgs.e2_stp_resp.accepted); 
 
   lock_guard(&ric->conn_e2_nodes_mtx);
+
+  // Restored from the replica of a standby, and now set up again 
+  void* it = find_if(&ric->conn_e2_nodes, seq_front(&ric->conn_e2_nodes), seq_end(&ric->conn_e2_nodes), (void*)&req->id, eq_e2_node_id);
+  if(it != seq_end(&ric->conn_e2_nodes)){
+    free_e2_node(it);
+    seq_erase(&ric->conn_e2_nodes, it, seq_next(&ric->conn_e2_nodes, it));
+  }
+
   seq_push_back(&ric->conn_e2_nodes, &n, sizeof(n));
 
   return ans;
@@ -25,6 +25,7 @@
 
 #include "msg_handler_ric.h"
 #include "not_handler_ric.h"
+#include "admin_cmd_ric.h"
 
 #include "iApps/redis.h"
 #include "iApps/stdout.h"
@@ -39,7 +40,9 @@
 #include "util/alg_ds/alg/alg.h"
 #include "util/alg_ds/ds/lock_guard/lock_guard.h"
 #include "util/compare.h"
+#include "util/time_now_us.h"
 
+#include <arpa/inet.h>
 #include <assert.h>
 #include <dlfcn.h>
 #include <limits.h>
@@ -47,6 +50,8 @@
 #include <stdlib.h>
 #include <stdio.h>
 
+static_assert(END_MSG_CLASS <= TASK_MAN_NUM_PRIO, "One task manager lane per message class");
+
 static inline
 void free_fd(void* key, void* value)
 {
@@ -105,23 +110,33 @@ void register_listeners_for_ran_func_id(near_ric_t* ric, uint16_t const* ran_fun
   } 
 }
 
+char const* listener_ric_str(listener_ric_e l)
+{
+  assert(l < END_LISTENER_RIC);
+  char const* name[END_LISTENER_RIC] = {"stdout", "redis", "influx"};
+  return name[l];
+}
+
 static
 void load_default_pub_sub_ric(near_ric_t* ric)
 {
   assert(ric != NULL);
 
+  for(int i = 0; i < END_LISTENER_RIC; ++i)
+    ric->listener_on[i] = true;
+
   void* it = assoc_front(&ric->plugin.sm_ds);
   void* end_it = assoc_end(&ric->plugin.sm_ds);
   while(it != end_it){
     const uint16_t *ran_func_id = assoc_key(&ric->plugin.sm_ds, it);
 
-    subs_ric_t std_listener = {.name = "stdout listener", .fp = notify_stdout_listener };
+    subs_ric_t std_listener = {.name = "stdout listener", .fp = notify_stdout_listener, .on = &ric->listener_on[STDOUT_LISTENER_RIC] };
     register_listeners_for_ran_func_id(ric, ran_func_id, std_listener);
 
-    subs_ric_t redis_listener = {.name = "redis listener", .fp = notify_redis_listener };
+    subs_ric_t redis_listener = {.name = "redis listener", .fp = notify_redis_listener, .on = &ric->listener_on[REDIS_LISTENER_RIC] };
     register_listeners_for_ran_func_id(ric, ran_func_id, redis_listener);
 
-    subs_ric_t influx_listener = {.name = "influx listener", .fp = notify_influx_listener };
+    subs_ric_t influx_listener = {.name = "influx listener", .fp = notify_influx_listener, .on = &ric->listener_on[INFLUX_LISTENER_RIC] };
     register_listeners_for_ran_func_id(ric, ran_func_id, influx_listener);
 
 //    subs_ric_t nng_listener = {.name = "nanomsg listener", .fp = notify_nng_listener };
@@ -202,6 +217,9 @@ near_ric_t* init_near_ric(fr_args_t const* args)
   near_ric_t* ric = calloc(1, sizeof(near_ric_t));
   assert(ric != NULL);
 
+  // The standby blocks here, until it takes over
+  init_repl_ric(&ric->repl, args);
+
   char* addr = get_near_ric_ip(args);
   defer({ free(addr); } );
 
@@ -228,17 +246,32 @@ near_ric_t* init_near_ric(fr_args_t const* args)
 
   init_pending_events(ric);
 
+  // Before the iApp, as the restored subscriptions take their RIC Request IDs 
+  init_ric_req_id_alloc(&ric->req_id);
+  init_sub_node_ric(&ric->sub_node);
+
   near_ric_if_t ric_if = {.type = ric};
-  init_iapp_api(addr, ric_if);
+  init_iapp_api(addr, ric_if, args);
+
+  if(ric->repl.role == STANDBY_REPL_ROLE)
+    restore_repl_ric(&ric->repl, ric);
+
+  start_iapp_api();
 
   uint32_t const num_threads = TASK_MAN_NUMBER_THREADS;
   printf("[NEAR-RIC]: Initializing Task Manager with %u threads \n", num_threads);
   init_task_manager(&ric->man, num_threads);
 
-  ric->req_id = 1021; // 0 could be a sign of a bug
+  char* deadline = get_conf_msg_deadline(args);
+  init_msg_deadlines(&ric->deadlines, deadline);
+  free(deadline);
+
   ric->stop_token = false;
   ric->server_stopped = false;
 
+  // Last, as the commands may touch everything above
+  init_admin_cmd_ric(ric, args);
+
   return ric;
 }
 
@@ -250,15 +283,6 @@ bool net_pkt(e2ap_ep_t const *ep, int fd)
   return fd == ep->fd;
 }
 
-static inline
-void consume_fd(int fd)
-{
-  assert(fd > 0);
-  uint64_t read_buf = 0;
-  ssize_t const bytes = read(fd,&read_buf, sizeof(read_buf));
-  assert(bytes == sizeof(read_buf));
-}
-
 /*
 static inline
 bool eq_sock_addr(void const* m0_v, void const* m1_v)
@@ -338,7 +362,10 @@ bool pend_event(near_ric_t* ric, int fd, pending_event_t** p_ev)
 
   void* it = find_if(&ric->pending.left,start_it, end_it, &fd, eq_fd);
 
-  assert(it != end_it);
+  // The answer stopped it after epoll reported the timer  
+  if(it == end_it)
+    return false;
+
   *p_ev = assoc_value(&ric->pending.left ,it);
   }
   return *p_ev != NULL;
@@ -381,7 +408,8 @@ async_event_arr_t next_asio_event_ric(near_ric_t* ric)
     } else if (pend_event(ric,fd_read.fd[i], &dst->p_ev) == true){
       dst->type = PENDING_EVENT;
     } else {
-      assert( 0!=0 && "Unknown event happened!");
+      // Pending event stopped meanwhile. Nothing to do
+      dst->type = CHECK_STOP_TOKEN_EVENT;
     }
   }
 
@@ -391,6 +419,8 @@ async_event_arr_t next_asio_event_ric(near_ric_t* ric)
 typedef struct{
   near_ric_t* ric;
   sctp_msg_t msg;
+  msg_class_e cls;
+  int64_t rcv;
 } ric_sctp_msg_t ;
 
 // This task will run in parallel
@@ -406,9 +436,22 @@ void sctp_msg_arrived_event(void* arg)
   sctp_msg_t const* sctp_msg = &ric_ev->msg;
   defer({free_sctp_msg((sctp_msg_t*)sctp_msg);});
 
+  // Waited in the task manager beyond its deadline. Not worth decoding 
+  if(check_msg_deadline(&ric->deadlines, ric_ev->cls, ric_ev->rcv, time_now_us()) == false)
+    return;
+
   e2ap_msg_t const msg = e2ap_msg_dec_ric(&ric->ap, sctp_msg->ba); 
   defer({e2ap_msg_free_ric(&ric->ap, (e2ap_msg_t*)&msg); } );
 
+  // A node speaking another E2AP version must not bring down the other associations 
+  if(msg.type == NONE_E2_MSG_TYPE){
+    char addr[INET_ADDRSTRLEN] = {0};
+    inet_ntop(AF_INET, &sctp_msg->info.addr.sin_addr, addr, sizeof(addr));
+    printf("[NEAR-RIC]: Undecodable or unsupported E2AP PDU from %s:%d discarded. Is the E2 Node speaking E2AP %s?\n", 
+        addr, ntohs(sctp_msg->info.addr.sin_port), e2ap_version_str(E2AP_COMPILED_VERSION));
+    return;
+  }
+
   if(msg.type == E2_SETUP_REQUEST){
     global_e2_node_id_t const* id = &msg.u_msgs.e2_stp_req.id;
     //printf("Received message with id = %d, port = %d \n", id->nb_id.nb_id, sctp_msg->info.addr.sin_port);
@@ -418,6 +461,10 @@ void sctp_msg_arrived_event(void* arg)
   e2ap_msg_t ans = e2ap_msg_handle_ric(ric, &msg);
   defer({e2ap_msg_free_ric(&ric->ap, &ans);});
 
+  // The standby replays the E2 Setup Request as it takes over
+  if(ans.type == E2_SETUP_RESPONSE)
+    add_e2_node_repl_ric(&ric->repl, &msg.u_msgs.e2_stp_req.id, sctp_msg->ba);
+
   if(ans.type != NONE_E2_MSG_TYPE){
     sctp_msg_t sctp_msg2 = { .info = sctp_msg->info }; 
     defer({free_sctp_msg(&sctp_msg2);});
@@ -427,6 +474,88 @@ void sctp_msg_arrived_event(void* arg)
   }
 }
 
+static
+char const* pending_event_str(pending_event_t ev)
+{
+  if(ev == SUBSCRIPTION_REQUEST_PENDING_EVENT)
+    return "SUBSCRIPTION REQUEST";
+  else if(ev == SUBSCRIPTION_DELETE_REQUEST_PENDING_EVENT)
+    return "SUBSCRIPTION DELETE REQUEST";
+  else if(ev == CONTROL_REQUEST_PENDING_EVENT)
+    return "CONTROL REQUEST";
+
+  assert(0!=0 && "Unknown pending event");
+  return "";
+}
+
+static
+e2ap_msg_t timeout_answer(pending_event_ric_t const* ev)
+{
+  assert(ev != NULL);
+
+  cause_t const cause = {.present = CAUSE_TRANSPORT, .transport = CAUSE_TRANSPORT_UNSPECIFIED};
+
+  if(ev->ev == SUBSCRIPTION_REQUEST_PENDING_EVENT){
+    e2ap_msg_t msg = {.type = RIC_SUBSCRIPTION_FAILURE, 
+                      .u_msgs.ric_sub_fail = init_ric_subscription_failure(ev->id, cause)};
+    return msg;
+  } else if(ev->ev == SUBSCRIPTION_DELETE_REQUEST_PENDING_EVENT){
+    // Considered deleted. Its indications, if any, are discarded as unknown
+    e2ap_msg_t msg = {.type = RIC_SUBSCRIPTION_DELETE_RESPONSE, 
+                      .u_msgs.ric_sub_del_resp.ric_id = ev->id};
+    return msg;
+  } 
+
+  assert(ev->ev == CONTROL_REQUEST_PENDING_EVENT && "Unknown pending event");
+  e2ap_msg_t msg = {.type = RIC_CONTROL_FAILURE, 
+                    .u_msgs.ric_ctrl_fail.ric_id = ev->id, 
+                    .u_msgs.ric_ctrl_fail.cause = cause};
+  return msg;
+}
+
+// No answer from the E2 Node. The answer is synthesized and handled as if it 
+// had arrived, so that the iApp, the xApp and the RIC Request ID are cleaned up.
+// A late answer finds no pending event and is discarded, see msg_handler_ric.c
+static
+void timeout_pending_event(near_ric_t* ric, int fd)
+{
+  assert(ric != NULL);
+  assert(fd > 0);
+
+  pending_event_ric_t ev = {0};
+  {
+    lock_guard(&ric->pend_mtx);
+
+    void* it = find_if(&ric->pending.left, assoc_front(&ric->pending.left), assoc_end(&ric->pending.left), &fd, eq_fd);
+    // The answer arrived meanwhile
+    if(it == assoc_end(&ric->pending.left))
+      return;
+
+    ev = *(pending_event_ric_t*)assoc_value(&ric->pending.left, it);
+  }
+
+  printf("[NEAR-RIC]: %s RAN_FUNC_ID %d RIC_REQ_ID %d timeout. Communication with E2 Node lost?\n", pending_event_str(ev.ev), ev.id.ran_func_id, ev.id.ric_req_id);
+
+  e2ap_msg_t msg = timeout_answer(&ev);
+  defer({ e2ap_msg_free_ric(&ric->ap, &msg); });
+
+  e2ap_msg_t const ans = e2ap_msg_handle_ric(ric, &msg);
+  assert(ans.type == NONE_E2_MSG_TYPE);
+}
+
+// The messages still queued in the task manager when the nearRT-RIC stops
+static
+void free_pending_task(void* it)
+{
+  assert(it != NULL);
+  task_t* t = (task_t*)it;
+  assert(t->func == sctp_msg_arrived_event);
+
+  ric_sctp_msg_t* ric_ev = (ric_sctp_msg_t*)t->args;
+  free_sctp_msg(&ric_ev->msg);
+  free(ric_ev);
+}
+
 static
 void e2_event_loop_ric(near_ric_t* ric)
 {
@@ -448,15 +577,17 @@ void e2_event_loop_ric(near_ric_t* ric)
             ric_sctp->ric = ric;
             // Pass ownership
             ric_sctp->msg = e.msg;
+            ric_sctp->cls = peek_e2ap_msg_class(e.msg.ba);
+            ric_sctp->rcv = time_now_us();
             task_t t = {.args = ric_sctp, .func = sctp_msg_arrived_event};
-            // Execute tasks in parallel
-            async_task_manager(&ric->man, t);
+            // Execute tasks in parallel. Controls overtake indications and management
+            async_prio_task_manager(&ric->man, t, ric_sctp->cls);
             break;
           }
         case PENDING_EVENT:
           {
-            printf("Pending event timeout happened. Communication with E2 Node lost?\n");
-            consume_fd(e.fd);
+            consume_timer_asio_ric(&ric->io, e.fd);
+            timeout_pending_event(ric, e.fd);
 
             break;
           }
@@ -498,13 +629,19 @@ void free_near_ric(near_ric_t* ric)
 {
   assert(ric != NULL);
 
+  free_admin_ric(&ric->admin);
+
+  stop_repl_ric(&ric->repl);
+
   ric->stop_token = true;
+  // Fine grained, as a standby waits for the addresses to take over
   while(ric->server_stopped == false){
-    sleep(1);
+    usleep(1000);
   }
 
-  void (*clean)(void*) = NULL;
-  free_task_manager(&ric->man, clean);
+  free_task_manager(&ric->man, free_pending_task);
+
+  print_msg_deadlines(&ric->deadlines, "NEAR-RIC", stdout);
 
   e2ap_free_ep_ric(&ric->ep);
 
@@ -522,17 +659,26 @@ void free_near_ric(near_ric_t* ric)
 
   bi_map_free(&ric->pending);
 
+  free_ric_req_id_alloc(&ric->req_id);
+  free_sub_node_ric(&ric->sub_node);
+
   stop_iapp_api();
 
+  // Last, the standby takes over once the addresses are released
+  free_repl_ric(&ric->repl);
+
   free(ric);
 }
 
 static
-ric_subscription_request_t generate_subscription_request(near_ric_t* ric, sm_ric_t const* sm, uint16_t ran_func_id, void* cmd)
+ric_subscription_request_t generate_subscription_request(near_ric_t* ric, uint32_t ric_req_id, sm_ric_t const* sm, uint16_t ran_func_id, void* cmd)
 {
   assert(ric != NULL);
+  assert(ric_req_id != RIC_REQ_ID_NONE);
   ric_subscription_request_t sr = {0}; 
-  const ric_gen_id_t ric_id = {.ric_req_id = ric->req_id++ ,.ric_inst_id = 0, .ran_func_id = ran_func_id};
+  const ric_gen_id_t ric_id = {.ric_req_id = ric_req_id,
+                               .ric_inst_id = 0, 
+                               .ran_func_id = ran_func_id};
 
   sm_subs_data_t data = sm->proc.on_subscription(sm, cmd);
 
@@ -595,9 +741,15 @@ uint16_t report_service_near_ric(near_ric_t* ric, global_e2_node_id_t const* id,
   assert(ran_func_id < 150 && "Not still reached upper limit");
   assert(cmd != NULL);
 
+  uint32_t const ric_req_id = alloc_ric_req_id(&ric->req_id, id, ran_func_id);
+  if(ric_req_id == RIC_REQ_ID_NONE){
+    printf("[NEAR-RIC]: RIC Request IDs exhausted. Report Service not sent\n");
+    return RIC_REQ_ID_NONE;
+  }
+
   sm_ric_t* sm = sm_plugin_ric(&ric->plugin ,ran_func_id); 
   
-  ric_subscription_request_t sr = generate_subscription_request(ric, sm, ran_func_id, cmd);  
+  ric_subscription_request_t sr = generate_subscription_request(ric, ric_req_id, sm, ran_func_id, cmd);  
 
   // A pending event is created along with a timer of 3000 ms,
   // after which an event will be generated
@@ -689,13 +841,16 @@ void rm_report_service_near_ric(near_ric_t* ric, global_e2_node_id_t const* id,
 }
 
 static
-ric_control_request_t generate_control_request(near_ric_t* ric, sm_ric_t* sm, void* ctrl)
+ric_control_request_t generate_control_request(near_ric_t* ric, uint32_t ric_req_id, sm_ric_t* sm, void* ctrl)
 {
   assert(ric != NULL);
+  assert(ric_req_id != RIC_REQ_ID_NONE);
   assert(sm != NULL);
   assert(ctrl != NULL);
 
-  const ric_gen_id_t ric_id = {.ric_req_id = ric->req_id++ ,.ric_inst_id = 0, .ran_func_id = sm->ran_func_id};
+  const ric_gen_id_t ric_id = {.ric_req_id = ric_req_id,
+                               .ric_inst_id = 0,
+                               .ran_func_id = sm->ran_func_id};
 
   ric_control_request_t ctrl_req = {.ric_id = ric_id };
   ctrl_req.ack_req = malloc(sizeof(ric_control_ack_req_t ));
@@ -721,9 +876,15 @@ void control_service_near_ric(near_ric_t* ric, global_e2_node_id_t const* id, ui
 //  assert(ran_func_id == SM_RC_ID || ran_func_id == SM_SLICE_ID || ran_func_id == SM_TC_ID );
   assert(ran_func_id == 3 || ran_func_id == 145 || ran_func_id == 146);
 
+  uint32_t const ric_req_id = alloc_ric_req_id(&ric->req_id, id, ran_func_id);
+  if(ric_req_id == RIC_REQ_ID_NONE){
+    printf("[NEAR-RIC]: RIC Request IDs exhausted. Control Service not sent\n");
+    return;
+  }
+
   sm_ric_t* sm = sm_plugin_ric(&ric->plugin ,ran_func_id); 
 
-  ric_control_request_t ctrl_req = generate_control_request(ric, sm, ctrl);
+  ric_control_request_t ctrl_req = generate_control_request(ric, ric_req_id, sm, ctrl);
 
   // A pending event is created along with a timer of 3000 ms,
   // after which an event will be generated
@@ -788,15 +949,20 @@ void stop_near_ric_iapp()
 //  assert(0!=0 && "not implemented");
 }
 
-uint16_t fwd_ric_subscription_request(near_ric_t* ric, global_e2_node_id_t const* id, ric_subscription_request_t const* sr, void (*f)(e2ap_msg_t const* msg))
+uint32_t fwd_ric_subscription_request(near_ric_t* ric, global_e2_node_id_t const* id, ric_subscription_request_t const* sr_xapp, char const* note, void (*f)(e2ap_msg_t const* msg))
 {
   assert(ric != NULL);
-  assert(sr != NULL);
+  assert(id != NULL);
+  assert(sr_xapp != NULL);
   assert(f != NULL);
-  uint16_t const ric_req_id = ric->req_id++;
-
-  *(uint16_t*)&sr->ric_id.ric_req_id = ric_req_id;
 
+  // Shallow copy. The xApp's message is not modified, only the RIC Request ID differs 
+  ric_subscription_request_t sr_ric = *sr_xapp;
+  ric_subscription_request_t const* sr = &sr_ric;
+  sr_ric.ric_id.ric_req_id = alloc_ric_req_id(&ric->req_id, id, sr->ric_id.ran_func_id);
+  uint32_t const ric_req_id = sr->ric_id.ric_req_id;
+  if(ric_req_id == RIC_REQ_ID_NONE)
+    return RIC_REQ_ID_NONE;
 
   // A pending event is created along with a timer of 3000 ms,
   // after which an event will be generated
@@ -813,12 +979,12 @@ uint16_t fwd_ric_subscription_request(near_ric_t* ric, global_e2_node_id_t const
   byte_array_t ba_msg = e2ap_enc_subscription_request_ric(&ric->ap, sr); 
   defer({ free_byte_array(ba_msg); });
 
-  e2ap_send_bytes_ric(&ric->ep, id, ba_msg);
+  e2ap_send_bytes_note_ric(&ric->ep, id, ba_msg, note);
    
   return ric_req_id;
 }
 
-void fwd_ric_subscription_request_delete(near_ric_t* ric, global_e2_node_id_t const* id, ric_subscription_delete_request_t const* sdr, void (*f)(e2ap_msg_t const* msg))
+void fwd_ric_subscription_request_delete(near_ric_t* ric, global_e2_node_id_t const* id, ric_subscription_delete_request_t const* sdr, char const* note, void (*f)(e2ap_msg_t const* msg))
 {
   assert(ric != NULL);
   assert(sdr != NULL);
@@ -848,38 +1014,96 @@ void fwd_ric_subscription_request_delete(near_ric_t* ric, global_e2_node_id_t co
   byte_array_t ba_msg = e2ap_enc_subscription_delete_request_ric(&ric->ap, sdr); 
   defer({ free_byte_array(ba_msg); });
 
-  e2ap_send_bytes_ric(&ric->ep, id, ba_msg);
+  e2ap_send_bytes_note_ric(&ric->ep, id, ba_msg, note);
 
   printf("[NEAR-RIC]: SUBSCRIPTION DELETE REQUEST tx RAN FUNC ID %d RIC_REQ_ID %d \n", sdr->ric_id.ran_func_id, sdr->ric_id.ric_req_id);
 }
 
-uint16_t fwd_ric_control_request(near_ric_t* ric, global_e2_node_id_t const* id, ric_control_request_t const* cr,  void (*f)(e2ap_msg_t const* msg))
+uint32_t fwd_ric_control_request(near_ric_t* ric, global_e2_node_id_t const* id, ric_control_request_t const* cr_xapp, char const* note, void (*f)(e2ap_msg_t const* msg))
 {
   assert(ric != NULL);
-  assert(cr != NULL);
+  assert(id != NULL);
+  assert(cr_xapp != NULL);
   assert(f != NULL);
 
-  uint16_t const ric_req_id = ric->req_id++;
-  *(uint16_t*)&cr->ric_id.ric_req_id = ric_req_id;
+  // Shallow copy. The xApp's message is not modified, only the RIC Request ID differs 
+  ric_control_request_t cr_ric = *cr_xapp;
+  ric_control_request_t const* cr = &cr_ric;
+  cr_ric.ric_id.ric_req_id = alloc_ric_req_id(&ric->req_id, id, cr->ric_id.ran_func_id);
+  uint32_t const ric_req_id = cr->ric_id.ric_req_id;
+  if(ric_req_id == RIC_REQ_ID_NONE)
+    return RIC_REQ_ID_NONE;
 
-  // A pending event is created along with a timer of 3000 ms,
-  // after which an event will be generated
-  pending_event_ric_t ev = {.ev = CONTROL_REQUEST_PENDING_EVENT, .id = cr->ric_id };
+  // An absent RIC Control Ack Request IE is treated as Ack
+  ric_control_ack_req_t const ack = cr->ack_req == NULL ? RIC_CONTROL_REQUEST_ACK : *cr->ack_req;
 
-  long const wait_ms = 3000;
-  int fd_timer = create_timer_ms_asio_ric(&ric->io, wait_ms, wait_ms); 
-  {
-    lock_guard(&ric->pend_mtx);
-    bi_map_insert(&ric->pending, &fd_timer, sizeof(fd_timer), &ev, sizeof(ev)); 
+  if(ack == RIC_CONTROL_REQUEST_ACK){
+    // A pending event is created along with a timer of 3000 ms,
+    // after which an event will be generated
+    pending_event_ric_t ev = {.ev = CONTROL_REQUEST_PENDING_EVENT, .id = cr->ric_id };
+
+    long const wait_ms = 3000;
+    int fd_timer = create_timer_ms_asio_ric(&ric->io, wait_ms, wait_ms); 
+    {
+      lock_guard(&ric->pend_mtx);
+      bi_map_insert(&ric->pending, &fd_timer, sizeof(fd_timer), &ev, sizeof(ev)); 
+    }
   }
 
   byte_array_t ba_msg = e2ap_enc_control_request_ric(&ric->ap, cr); 
   defer({ free_byte_array(ba_msg); } );
 
-  e2ap_send_bytes_ric(&ric->ep, id, ba_msg);
+  e2ap_send_bytes_note_ric(&ric->ep, id, ba_msg, note);
 
-  printf("[NEAR-RIC]: CONTROL SERVICE sent\n");
+  // Printing every fire-and-forget control would bound the control rate  
+  if(ack == RIC_CONTROL_REQUEST_ACK)
+    printf("[NEAR-RIC]: CONTROL SERVICE sent\n");
+
+  // NoAck: nothing will come back. NAck: the ID lives until a RIC Control Failure 
+  // arrives or until the iApp gives up on it, see release_ric_control_request 
+  if(ack == RIC_CONTROL_REQUEST_NO_ACK)
+    release_ric_req_id(&ric->req_id, ric_req_id);
 
   return ric_req_id; 
 }
 
+void release_ric_control_request(near_ric_t* ric, uint32_t ric_req_id)
+{
+  assert(ric != NULL);
+
+  release_ric_req_id(&ric->req_id, ric_req_id);
+}
+
+sm_ric_t const* sm_near_ric(near_ric_t* ric, uint16_t ran_func_id)
+{
+  assert(ric != NULL);
+
+  return sm_plugin_ric(&ric->plugin, ran_func_id);
+}
+
+bool obs_map_ric_id_near_ric(near_ric_t* ric, map_ric_id_obs_t* obs)
+{
+  assert(ric != NULL);
+  assert(obs != NULL);
+
+  if(ric->repl.role != PRIMARY_REPL_ROLE)
+    return false;
+
+  *obs = obs_map_ric_id_repl_ric(&ric->repl);
+  return true;
+}
+
+void add_xapp_near_ric(near_ric_t* ric, uint16_t xapp_id, uint16_t next_xapp_id, byte_array_t const* token)
+{
+  assert(ric != NULL);
+
+  add_xapp_repl_ric(&ric->repl, xapp_id, next_xapp_id, token);
+}
+
+void rm_xapp_near_ric(near_ric_t* ric, uint16_t xapp_id)
+{
+  assert(ric != NULL);
+
+  rm_xapp_repl_ric(&ric->repl, xapp_id);
+}
+
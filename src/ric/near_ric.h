@@ -33,6 +33,11 @@ e* For more information about the OpenAirInterface (OAI) Software Alliance:
 #include "sm/sm_ric.h"
 #include "plugin_ric.h"
 #include "map_e2_node_sockaddr.h"
+#include "ric_req_id_alloc.h"
+#include "sub_node_ric.h"
+#include "iApp/msg_deadline.h"
+#include "admin_ric.h"
+#include "repl_ric.h"
 #include "../lib/e2ap/e2ap_version.h"
 
 #include <stdatomic.h>
@@ -49,6 +54,17 @@ static_assert(0!=0, "Unknown E2AP version");
 #endif
 
 
+// Listeners of the indications within the nearRT-RIC
+typedef enum{
+  STDOUT_LISTENER_RIC,
+  REDIS_LISTENER_RIC,
+  INFLUX_LISTENER_RIC,
+
+  END_LISTENER_RIC
+} listener_ric_e;
+
+char const* listener_ric_str(listener_ric_e l);
+
 struct near_ric_s;
 typedef struct e2ap_msg_s (*e2ap_handle_msg_fp_ric)(struct near_ric_s* ric, const struct e2ap_msg_s* msg);
 
@@ -65,13 +81,17 @@ typedef struct near_ric_s
 
   // Publish/Subscribed update function pointers per sm 
   assoc_rb_tree_t pub_sub; // seq_arr_t per SM 
+  atomic_bool listener_on[END_LISTENER_RIC];
  
   // Connected E2 Nodes
   seq_arr_t conn_e2_nodes; // e2_node_t 
   pthread_mutex_t conn_e2_nodes_mtx;
 
-  // Monotonically increasing RIC request ID
-  atomic_int req_id;
+  // Live RIC Request IDs per (E2 Node, RAN Function)
+  ric_req_id_alloc_t req_id;
+
+  // E2 Node of the live subscriptions. Read by every indication
+  sub_node_ric_t sub_node;
 
   // Pending events
   bi_map_t pending; // left: fd, right: pending_event_ric_t   
@@ -79,7 +99,15 @@ typedef struct near_ric_s
 
   // Task manager/Thread pool
   // It processes the Indication messages in parallel
+  // One lane per msg_class_e, i.e., control > indication > management 
   task_manager_t man;
+  msg_deadlines_t deadlines;
+
+  // Local admin socket
+  admin_ric_t admin;
+
+  // Active/standby replication
+  repl_ric_t repl;
 
   atomic_bool server_stopped;
   atomic_bool stop_token;
@@ -99,6 +127,7 @@ seq_arr_t conn_e2_nodes(near_ric_t* ric);
 //size_t num_conn_e2_nodes(near_ric_t* ric);
 
 
+// Returns RIC_REQ_ID_NONE if the RIC Request IDs are exhausted. Nothing is sent
 uint16_t report_service_near_ric(near_ric_t* ric, global_e2_node_id_t const* id, uint16_t ran_func_id, void* cmd);
 
 void rm_report_service_near_ric(near_ric_t* ric, global_e2_node_id_t const* id, uint16_t ran_func_id, uint16_t act_id);
@@ -117,11 +146,30 @@ void start_near_ric_iapp(near_ric_t* ric);
 
 void stop_near_ric_iapp();
 
-uint16_t fwd_ric_subscription_request(near_ric_t* ric,  global_e2_node_id_t const* id, ric_subscription_request_t const* sr, void (*f)(e2ap_msg_t const* msg));
+// The fwd_* functions return the RIC Request ID towards the E2 Node, or 
+// RIC_REQ_ID_NONE if the IDs are exhausted. Nothing is sent then.
+// note, if not NULL, is written in the capture along with the message
+uint32_t fwd_ric_subscription_request(near_ric_t* ric,  global_e2_node_id_t const* id, ric_subscription_request_t const* sr, char const* note, void (*f)(e2ap_msg_t const* msg));
+
+void fwd_ric_subscription_request_delete(near_ric_t* ric, global_e2_node_id_t const* id,  ric_subscription_delete_request_t const* sdr, char const* note, void (*f)(e2ap_msg_t const* msg));
+
+uint32_t fwd_ric_control_request(near_ric_t* ric, global_e2_node_id_t const* id, ric_control_request_t const* cr, char const* note, void (*f)(e2ap_msg_t const* msg));
+
+// Release the RIC Request ID of a NAck control request that did not fail
+void release_ric_control_request(near_ric_t* ric, uint32_t ric_req_id);
+
+// SM of a loaded RAN Function, e.g., to filter the indications of the xApps
+sm_ric_t const* sm_near_ric(near_ric_t* ric, uint16_t ran_func_id);
+
+// Replicated towards the standby nearRT-RIC, if any. See repl_ric.h
+
+// False if the subscriptions of the iApp are not replicated
+bool obs_map_ric_id_near_ric(near_ric_t* ric, map_ric_id_obs_t* obs);
 
-void fwd_ric_subscription_request_delete(near_ric_t* ric, global_e2_node_id_t const* id,  ric_subscription_delete_request_t const* sdr, void (*f)(e2ap_msg_t const* msg));
+// E42 Setup of an xApp. token NULL if it did not present one
+void add_xapp_near_ric(near_ric_t* ric, uint16_t xapp_id, uint16_t next_xapp_id, byte_array_t const* token);
 
-uint16_t fwd_ric_control_request(near_ric_t* ric, global_e2_node_id_t const* id, ric_control_request_t const* cr,  void (*f)(e2ap_msg_t const* msg));
+void rm_xapp_near_ric(near_ric_t* ric, uint16_t xapp_id);
 
 #undef NUM_HANDLE_MSG  
 
@@ -23,6 +23,11 @@
 #include "near_ric_api.h"
 #include "near_ric.h"  // for control_service_near_ric, free_near_ric, init_
 #include "../util/conf_file.h"
+#include "../lib/ep/e2ap_capture.h"
+#include "iApps/influx.h"
+#include "iApps/stdout.h"
+#include "../lib/asio_uring.h"
+#include "../util/mem_acct.h"
 #include <assert.h>    // for assert
 #include <pthread.h>   // for pthread_create, pthread_join, pthread_t
 #include <stddef.h>    // for NULL
@@ -57,10 +62,48 @@ void* static_start_near_ric(void* a)
 
 
 
+static
+void init_io_backend(fr_args_t const* args)
+{
+  char* name = get_conf_io_backend(args);
+  if(name != NULL && set_backend_str_asio(name) == false)
+    printf("[NEAR-RIC]: Unknown IO_BACKEND %s. Using %s\n", name, backend_asio_str(backend_asio()));
+  free(name);
+}
+
+static
+void init_influx(fr_args_t const* args)
+{
+  char* sink = get_conf_influx_sink(args);
+  char* batch = get_conf_influx_batch(args);
+  char* spool = get_conf_influx_spool(args);
+  init_influx_listener(sink, batch, spool);
+  free(sink);
+  free(batch);
+  free(spool);
+}
+
+static
+void init_telemetry(fr_args_t const* args)
+{
+  char* path = get_conf_telemetry_file(args);
+  char* format = get_conf_telemetry_format(args);
+  char* rotate = get_conf_telemetry_rotate(args);
+  init_stdout_listener(path, format, rotate);
+  free(path);
+  free(format);
+  free(rotate);
+}
+
 void init_near_ric_api(fr_args_t const* args)
 {
   assert(ric == NULL);
 
+  init_conf_e2ap_capture(args);
+  init_influx(args);
+  init_telemetry(args);
+  init_io_backend(args);
+
   ric = init_near_ric(args);
   assert(ric != NULL && "Memory exhausted");
 
@@ -75,6 +118,13 @@ void stop_near_ric_api()
   free_near_ric(ric);
   int const rc = pthread_join(t_near_ric, NULL);
   assert(rc  == 0);
+
+  free_e2ap_capture();
+  // The listeners run in the RIC threads, joined above
+  free_influx_listener();
+  free_stdout_listener();
+
+  report_leaks_mem_acct("NEAR-RIC", stdout);
 }
 
 
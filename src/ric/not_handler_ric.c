@@ -2,6 +2,7 @@
 
 #include <assert.h>
 #include <stdbool.h>
+#include <stdio.h>
 
 #include "e2_node.h"
 
@@ -20,16 +21,18 @@ bool eq_global_e2_node_id_e2_node(void const* it, void const* val)
   return eq_global_e2_node_id(&n->id, id);
 }
 
-void notification_handle_ric(near_ric_t* ric, sctp_msg_t const* msg)
+bool rm_e2_node_ric(near_ric_t* ric, sctp_info_t const* info)
 {
   assert(ric != NULL);
-  assert(msg != NULL && msg->type == SCTP_MSG_NOTIFICATION);
-
-  assert(msg->notif->sn_header.sn_type == SCTP_SHUTDOWN_EVENT && "Only shutdown event supported");
+  assert(info != NULL);
 
-  global_e2_node_id_t* id = e2ap_rm_sock_addr_ric(&ric->ep, &msg->info);
+  global_e2_node_id_t* id = e2ap_rm_sock_addr_ric(&ric->ep, info);
+  if(id == NULL)
+    return false;
   defer( { free_global_e2_node_id(id);  free(id); } );
 
+  // E2 Nodes without any accepted RAN function were not added to the iApp
+  bool exposed = false;
   {
   lock_guard(&ric->conn_e2_nodes_mtx);
 
@@ -44,6 +47,7 @@ void notification_handle_ric(near_ric_t* ric, sctp_msg_t const* msg)
   // seq_erase_free(&ric->conn_e2_nodes, it, it_next, free_e2_node_void);
   // Therefore, this nasty solution adopted
   e2_node_t *n = (e2_node_t *)it;
+  exposed = n->len_acc > 0;
   free_e2_node(n);
 
   void* it_next = seq_next(&ric->conn_e2_nodes, it);
@@ -53,6 +57,27 @@ void notification_handle_ric(near_ric_t* ric, sctp_msg_t const* msg)
   }
 
   // delete it from the iApp
-  rm_e2_node_iapp_api(id);
+  if(exposed)
+    rm_e2_node_iapp_api(id);
+
+  rm_e2_node_repl_ric(&ric->repl, id);
+
+  rm_node_sub_node_ric(&ric->sub_node, id);
+  size_t const num_rel = release_node_ric_req_id(&ric->req_id, id);
+  if(num_rel > 0)
+    printf("[NEAR-RIC]: Released %lu RIC Request ID(s) of the lost E2 Node\n", num_rel);
+
+  return true;
+}
+
+void notification_handle_ric(near_ric_t* ric, sctp_msg_t const* msg)
+{
+  assert(ric != NULL);
+  assert(msg != NULL && msg->type == SCTP_MSG_NOTIFICATION);
+
+  assert(msg->notif->sn_header.sn_type == SCTP_SHUTDOWN_EVENT && "Only shutdown event supported");
+
+  if(rm_e2_node_ric(ric, &msg->info) == false)
+    printf("[NEAR-RIC]: SCTP shutdown of an E2 Node already removed\n");
 }
 
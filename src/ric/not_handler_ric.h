@@ -3,7 +3,13 @@
 
 #include "near_ric.h"
 
+#include <stdbool.h>
+
 void notification_handle_ric(near_ric_t* ric, sctp_msg_t const* msg);
 
+// Forgets the E2 Node of the association, in the nearRT-RIC and in the iApp.
+// False if it was already removed
+bool rm_e2_node_ric(near_ric_t* ric, sctp_info_t const* info);
+
 #endif
 
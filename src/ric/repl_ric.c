@@ -0,0 +1,585 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+#include "repl_ric.h"
+
+#include "near_ric.h"
+#include "e2ap_ric.h"
+#include "msg_handler_ric.h"
+#include "iApp/e42_iapp_api.h"
+
+#include "../util/alg_ds/ds/lock_guard/lock_guard.h"
+#include "../util/time_now_us.h"
+
+#include <arpa/inet.h>
+#include <assert.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/sctp.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/socket.h>
+
+/////
+// Endpoints 
+/////
+
+static
+int init_sctp_conn_server(const char* addr, int port)
+{
+  struct sockaddr_in server_addr = {.sin_family = AF_INET,
+                                    .sin_port = htons(port)};
+  int rc = inet_pton(AF_INET, addr, &server_addr.sin_addr);
+  assert(rc == 1 && "Incorrect HA_PEER IP address");
+
+  int const fd = socket(AF_INET, SOCK_SEQPACKET, IPPROTO_SCTP);
+  assert(fd != -1);
+
+  rc = bind(fd, (struct sockaddr*)&server_addr, sizeof(server_addr));
+  if(rc == -1)
+    printf("[NEAR-RIC]: Replication bind error %s\n", strerror(errno));
+  assert(rc != -1);
+
+  struct sctp_event_subscribe evnts = {.sctp_data_io_event = 1, 
+                                       .sctp_shutdown_event = 1};
+  rc = setsockopt(fd, IPPROTO_SCTP, SCTP_EVENTS, &evnts, sizeof(evnts));
+  assert(rc != -1);
+
+  const int no_delay = 1;
+  setsockopt(fd, IPPROTO_SCTP, SCTP_NODELAY, &no_delay, sizeof(no_delay));
+
+  rc = listen(fd, 1);
+  assert(rc != -1);
+  return fd;
+}
+
+static
+int init_sctp_conn_client(void)
+{
+  int const fd = socket(AF_INET, SOCK_SEQPACKET, IPPROTO_SCTP);
+  assert(fd != -1);
+
+  struct sctp_event_subscribe evnts = {.sctp_data_io_event = 1,
+                                       .sctp_shutdown_event = 1}; 
+  int rc = setsockopt(fd, IPPROTO_SCTP, SCTP_EVENTS, &evnts, sizeof (evnts));
+  assert(rc == 0);
+
+  const int no_delay = 1;
+  rc = setsockopt(fd, IPPROTO_SCTP, SCTP_NODELAY, &no_delay, sizeof(no_delay));
+  assert(rc == 0);
+  return fd;
+}
+
+// HA_PEER = <ip>:<port>
+static
+void parse_ha_peer(char const* peer, char addr[16], int* port)
+{
+  char const* colon = strrchr(peer, ':');
+  assert(colon != NULL && "HA_PEER format is <ip>:<port>");
+  assert(colon - peer > 0 && colon - peer < 16 && "Incorrect HA_PEER IP address");
+
+  memcpy(addr, peer, colon - peer);
+  addr[colon - peer] = '\0';
+  *port = atoi(colon + 1);
+  assert(*port > 0 && *port < 65535 && "Incorrect HA_PEER port");
+}
+
+static
+void send_rec(repl_ric_t* r, repl_rec_t const* rec)
+{
+  sctp_msg_t msg = {.info = r->peer, .ba = enc_repl_rec(rec)};
+  e2ap_send_sctp_msg(&r->ep, &msg);
+  free_byte_array(msg.ba);
+}
+
+static
+void free_out_msg(void* it)
+{
+  sctp_msg_t* msg = (sctp_msg_t*)it;
+  free_byte_array(msg->ba);
+}
+
+// Under mtx. Takes ownership of ba
+static
+void push_out(repl_ric_t* r, byte_array_t ba)
+{
+  sctp_msg_t msg = {.info = r->peer, .ba = ba};
+  seq_push_back(&r->out, &msg, sizeof(msg));
+
+  int const rc = pthread_cond_signal(&r->cv);
+  assert(rc == 0);
+}
+
+// Blocks for at most timeout_ms. False if nothing arrived
+static
+bool recv_rec(repl_ric_t* r, int timeout_ms, sctp_msg_t* msg)
+{
+  struct pollfd pfd = {.fd = r->ep.fd, .events = POLLIN};
+  int const rc = poll(&pfd, 1, timeout_ms);
+  assert(rc != -1 || errno == EINTR);
+  if(rc < 1)
+    return false;
+
+  *msg = e2ap_recv_sctp_msg(&r->ep);
+  return true;
+}
+
+/////
+// Primary 
+/////
+
+// Under mtx. The queued changes are part of the snapshot
+static
+void push_snapshot(repl_ric_t* r)
+{
+  seq_free(&r->out, free_out_msg);
+  seq_init(&r->out, sizeof(sctp_msg_t));
+
+  seq_arr_t arr = snapshot_repl_state(&r->state);
+  for(void* it = seq_front(&arr); it != seq_end(&arr); it = seq_next(&arr, it))
+    push_out(r, *(byte_array_t*)it);
+  // The records are owned by out
+  seq_free(&arr, NULL);
+}
+
+// Comparison time independent of where the secrets differ
+static
+bool eq_secret(byte_array_t const* m0, byte_array_t const* m1)
+{
+  if(m0->len != m1->len)
+    return false;
+
+  uint8_t diff = 0;
+  for(size_t i = 0; i < m0->len; ++i)
+    diff |= m0->buf[i] ^ m1->buf[i];
+  return diff == 0;
+}
+
+// Blocks until there are records to send. Empty once stopped and drained
+static
+seq_arr_t wait_out(repl_ric_t* r)
+{
+  lock_guard(&r->mtx);
+
+  while(seq_size(&r->out) == 0 && r->stop_token == false){
+    int const rc = pthread_cond_wait(&r->cv, &r->mtx);
+    assert(rc == 0);
+  }
+
+  seq_arr_t const batch = r->out;
+  seq_init(&r->out, sizeof(sctp_msg_t));
+  return batch;
+}
+
+static
+void* start_sender(void* arg)
+{
+  repl_ric_t* r = (repl_ric_t*)arg;
+
+  while(true){
+    seq_arr_t batch = wait_out(r);
+    defer({ seq_free(&batch, free_out_msg); });
+    if(seq_size(&batch) == 0)
+      break;
+
+    // Without the lock, i.e., the changes go on while the standby is slow
+    for(void* it = seq_front(&batch); it != seq_end(&batch); it = seq_next(&batch, it))
+      e2ap_send_sctp_msg(&r->ep, (sctp_msg_t*)it);
+  }
+
+  return NULL;
+}
+
+static
+void* start_primary(void* arg)
+{
+  repl_ric_t* r = (repl_ric_t*)arg;
+
+  while(r->stop_token == false){
+    sctp_msg_t msg = {0};
+    if(recv_rec(r, REPL_HEARTBEAT_MS, &msg) == false){
+      lock_guard(&r->mtx);
+      if(r->peer_on == true)
+        push_out(r, enc_repl_rec(&(repl_rec_t){.type = HEARTBEAT_REPL_REC}));
+      continue;
+    }
+    defer({ free_sctp_msg(&msg); });
+
+    lock_guard(&r->mtx);
+    if(msg.type == SCTP_MSG_NOTIFICATION){
+      // Other peers, e.g., the rejected ones, come and go
+      if(r->peer_on == true && msg.info.sri.sinfo_assoc_id == r->peer.sri.sinfo_assoc_id){
+        printf("[NEAR-RIC]: Standby nearRT-RIC lost\n");
+        r->peer_on = false;
+      }
+      continue;
+    }
+
+    repl_rec_t rec = {0};
+    if(dec_repl_rec(msg.ba, &rec) == false){
+      printf("[NEAR-RIC]: Malformed replication record discarded\n");
+      continue;
+    }
+    defer({ free_repl_rec(&rec); });
+    if(rec.type != HELLO_REPL_REC){
+      printf("[NEAR-RIC]: Unexpected replication record discarded\n");
+      continue;
+    }
+
+    char addr[INET_ADDRSTRLEN] = {0};
+    inet_ntop(AF_INET, &msg.info.addr.sin_addr, addr, sizeof(addr));
+    if(eq_secret(&rec.ba, &r->secret) == false){
+      printf("[NEAR-RIC]: Replication peer at %s without HA_SECRET rejected\n", addr);
+      continue;
+    }
+
+    printf("[NEAR-RIC]: Standby nearRT-RIC at %s attached. Sending the snapshot\n", addr);
+
+    r->peer = msg.info;
+    r->peer_on = true;
+    push_snapshot(r);
+  }
+
+  return NULL;
+}
+
+static
+void emit(repl_ric_t* r, repl_rec_t const* rec)
+{
+  lock_guard(&r->mtx);
+
+  if(r->role != PRIMARY_REPL_ROLE || r->stopped == true)
+    return;
+
+  apply_repl_state(&r->state, rec);
+  if(r->peer_on == true)
+    push_out(r, enc_repl_rec(rec));
+}
+
+static
+void obs_add_sub(void* ctx, e2_node_ric_id_t const* node, xapp_ric_id_t const* x)
+{
+  // Controls live for a round trip
+  if(node->ric_req_type != SUBSCRIPTION_RIC_REQUEST_TYPE)
+    return;
+
+  repl_rec_t const rec = {.type = SUB_ADD_REPL_REC, .node = node->e2_node_id, 
+                          .node_ric_id = node->ric_id, .xapp = *x};
+  emit(ctx, &rec);
+}
+
+static
+void obs_rm_sub(void* ctx, e2_node_ric_id_t const* node, xapp_ric_id_t const* x)
+{
+  (void)x;
+  if(node->ric_req_type != SUBSCRIPTION_RIC_REQUEST_TYPE)
+    return;
+
+  repl_rec_t const rec = {.type = SUB_RM_REPL_REC, .node_ric_id.ric_req_id = node->ric_id.ric_req_id};
+  emit(ctx, &rec);
+}
+
+/////
+// Standby 
+/////
+
+// Returns once the primary is lost
+static
+void wait_primary(repl_ric_t* r)
+{
+  bool synced = false;
+  int64_t last_rx = 0;
+  int64_t last_hello = 0;
+
+  while(true){
+    int64_t now = time_now_us();
+
+    // The primary may not be up yet
+    if(synced == false && now - last_hello > REPL_DEAD_MS*1000){
+      send_rec(r, &(repl_rec_t){.type = HELLO_REPL_REC, .ba = r->secret});
+      last_hello = now;
+    }
+
+    sctp_msg_t msg = {0};
+    if(recv_rec(r, REPL_HEARTBEAT_MS, &msg) == true){
+      defer({ free_sctp_msg(&msg); });
+
+      if(msg.type == SCTP_MSG_NOTIFICATION){
+        if(synced == true){
+          printf("[NEAR-RIC]: Association with the primary nearRT-RIC lost\n");
+          return;
+        }
+        continue;
+      }
+
+      repl_rec_t rec = {0};
+      if(dec_repl_rec(msg.ba, &rec) == false){
+        printf("[NEAR-RIC]: Malformed replication record discarded\n");
+        continue;
+      }
+
+      if(synced == false)
+        printf("[NEAR-RIC]: Replicating the primary nearRT-RIC\n");
+      apply_repl_state(&r->state, &rec);
+      free_repl_rec(&rec);
+
+      synced = true;
+      last_rx = time_now_us();
+    }
+
+    now = time_now_us();
+    if(synced == true && now - last_rx > REPL_DEAD_MS*1000){
+      printf("[NEAR-RIC]: Primary nearRT-RIC silent for %d ms\n", REPL_DEAD_MS);
+      return;
+    }
+  }
+}
+
+/////
+// Public 
+/////
+
+static
+repl_role_e get_role(fr_args_t const* args)
+{
+  char* role = get_conf_ha_role(args);
+  if(role == NULL)
+    return NONE_REPL_ROLE;
+  defer({ free(role); });
+
+  if(strcasecmp(role, "PRIMARY") == 0)
+    return PRIMARY_REPL_ROLE;
+  if(strcasecmp(role, "STANDBY") == 0)
+    return STANDBY_REPL_ROLE;
+
+  assert(0!=0 && "Unknown HA_ROLE. PRIMARY or STANDBY");
+  return NONE_REPL_ROLE;
+}
+
+void init_repl_ric(repl_ric_t* r, fr_args_t const* args)
+{
+  assert(r != NULL);
+  assert(args != NULL);
+
+  memset(r, 0, sizeof(*r));
+  r->role = get_role(args);
+
+  int rc = pthread_mutex_init(&r->mtx, NULL);
+  assert(rc == 0);
+
+  rc = pthread_cond_init(&r->cv, NULL);
+  assert(rc == 0);
+
+  init_repl_state(&r->state);
+  seq_init(&r->out, sizeof(sctp_msg_t));
+
+  if(r->role == NONE_REPL_ROLE)
+    return;
+
+  char* peer = get_conf_ha_peer(args);
+  assert(peer != NULL && "HA_ROLE without HA_PEER");
+
+  char* secret = get_conf_ha_secret(args);
+  assert(secret != NULL && strlen(secret) > 0 && "HA_ROLE without HA_SECRET");
+  // Owns secret
+  r->secret = (byte_array_t){.len = strlen(secret), .buf = (uint8_t*)secret};
+  char addr[16] = {0};
+  int port = 0;
+  parse_ha_peer(peer, addr, &port);
+  free(peer);
+
+  e2ap_ep_init(&r->ep);
+  *(int*)(&r->ep.port) = port;
+  strcpy((char*)r->ep.addr, addr);
+
+  if(r->role == PRIMARY_REPL_ROLE){
+    if(enabled_mem_ep() == true)
+      *(int*)(&r->ep.fd) = e2ap_ep_listen_mem(&r->ep, addr, port);
+    else
+      *(int*)(&r->ep.fd) = init_sctp_conn_server(addr, port);
+
+    printf("[NEAR-RIC]: Primary nearRT-RIC. Replicating at %s:%d\n", addr, port);
+
+    rc = pthread_create(&r->t, NULL, start_primary, r);
+    assert(rc == 0);
+    rc = pthread_create(&r->t_send, NULL, start_sender, r);
+    assert(rc == 0);
+    return;
+  }
+
+  r->peer.addr = (struct sockaddr_in){.sin_family = AF_INET, .sin_port = htons(port)};
+  rc = inet_pton(AF_INET, addr, &r->peer.addr.sin_addr);
+  assert(rc == 1 && "Incorrect HA_PEER IP address");
+
+  if(enabled_mem_ep() == true)
+    *(int*)(&r->ep.fd) = e2ap_ep_connect_mem(&r->ep, addr, port);
+  else
+    *(int*)(&r->ep.fd) = init_sctp_conn_client();
+
+  printf("[NEAR-RIC]: Standby of the primary nearRT-RIC at %s:%d\n", addr, port);
+
+  wait_primary(r);
+
+  e2ap_ep_free(&r->ep);
+
+  printf("[NEAR-RIC]: Taking over. %lu E2 Node(s), %lu xApp session(s) and %lu subscription(s) replicated\n", 
+      seq_size(&r->state.nodes), seq_size(&r->state.xapps), seq_size(&r->state.subs));
+}
+
+void stop_repl_ric(repl_ric_t* r)
+{
+  assert(r != NULL);
+
+  lock_guard(&r->mtx);
+  r->stopped = true;
+}
+
+void free_repl_ric(repl_ric_t* r)
+{
+  assert(r != NULL);
+
+  if(r->role == PRIMARY_REPL_ROLE){
+    stop_repl_ric(r);
+    r->stop_token = true;
+    int rc = pthread_join(r->t, NULL);
+    assert(rc == 0);
+
+    // The queued changes are sent first
+    {
+      lock_guard(&r->mtx);
+      rc = pthread_cond_signal(&r->cv);
+      assert(rc == 0);
+    }
+    rc = pthread_join(r->t_send, NULL);
+    assert(rc == 0);
+
+    // The standby takes over
+    e2ap_ep_free(&r->ep);
+  }
+
+  free_repl_state(&r->state);
+  seq_free(&r->out, free_out_msg);
+  free_byte_array(r->secret);
+
+  int rc = pthread_cond_destroy(&r->cv);
+  assert(rc == 0);
+
+  rc = pthread_mutex_destroy(&r->mtx);
+  assert(rc == 0);
+}
+
+static
+void restore_e2_node(near_ric_t* ric, repl_node_t const* n)
+{
+  e2ap_msg_t msg = e2ap_msg_dec_ric(&ric->ap, n->setup);
+  defer({ e2ap_msg_free_ric(&ric->ap, &msg); });
+  assert(msg.type == E2_SETUP_REQUEST && "Replicated E2 Setup Request expected");
+
+  // The E2 Setup Response is not sent, the E2 Node sets up again
+  e2ap_msg_t ans = e2ap_handle_setup_request_ric(ric, &msg);
+  e2ap_msg_free_ric(&ric->ap, &ans);
+}
+
+void restore_repl_ric(repl_ric_t* r, near_ric_t* ric)
+{
+  assert(r != NULL);
+  assert(ric != NULL);
+  assert(r->role == STANDBY_REPL_ROLE);
+
+  seq_arr_t* nodes = &r->state.nodes;
+  for(void* it = seq_front(nodes); it != seq_end(nodes); it = seq_next(nodes, it))
+    restore_e2_node(ric, it);
+
+  size_t const num_subs = seq_size(&r->state.subs);
+  prune_repl_state(&r->state);
+
+  seq_arr_t* subs = &r->state.subs;
+  for(void* it = seq_front(subs); it != seq_end(subs); it = seq_next(subs, it)){
+    map_ric_id_entry_t const* e = (map_ric_id_entry_t const*)it;
+    bool const ok = take_ric_req_id(&ric->req_id, e->node.ric_id.ric_req_id, &e->node.e2_node_id, e->node.ric_id.ran_func_id);
+    assert(ok == true && "Replicated RIC Request ID already live");
+    add_sub_node_ric(&ric->sub_node, e->node.ric_id.ric_req_id, &e->node.e2_node_id);
+  }
+
+  restore_iapp_api(&r->state);
+
+  printf("[NEAR-RIC]: Restored %lu E2 Node(s) and %lu subscription(s) of %lu xApp session(s). %lu subscription(s) dropped\n", 
+      seq_size(nodes), seq_size(subs), seq_size(&r->state.xapps), num_subs - seq_size(subs));
+
+  // Not a standby anymore 
+  free_repl_state(&r->state);
+  init_repl_state(&r->state);
+  r->role = NONE_REPL_ROLE;
+}
+
+void add_e2_node_repl_ric(repl_ric_t* r, global_e2_node_id_t const* id, byte_array_t setup)
+{
+  assert(r != NULL);
+  assert(id != NULL);
+
+  repl_rec_t const rec = {.type = NODE_ADD_REPL_REC, .node = *id, .ba = setup};
+  emit(r, &rec);
+}
+
+void rm_e2_node_repl_ric(repl_ric_t* r, global_e2_node_id_t const* id)
+{
+  assert(r != NULL);
+  assert(id != NULL);
+
+  repl_rec_t const rec = {.type = NODE_RM_REPL_REC, .node = *id};
+  emit(r, &rec);
+}
+
+void add_xapp_repl_ric(repl_ric_t* r, uint16_t xapp_id, uint16_t next_xapp_id, byte_array_t const* token)
+{
+  assert(r != NULL);
+
+  repl_rec_t const rec = {.type = XAPP_ADD_REPL_REC, .xapp_id = xapp_id, .next_xapp_id = next_xapp_id, 
+                          .ba = token != NULL ? *token : (byte_array_t){0}};
+  emit(r, &rec);
+}
+
+void rm_xapp_repl_ric(repl_ric_t* r, uint16_t xapp_id)
+{
+  assert(r != NULL);
+
+  repl_rec_t const rec = {.type = XAPP_RM_REPL_REC, .xapp_id = xapp_id};
+  emit(r, &rec);
+}
+
+bool peer_on_repl_ric(repl_ric_t* r)
+{
+  assert(r != NULL);
+
+  lock_guard(&r->mtx);
+  return r->peer_on;
+}
+
+map_ric_id_obs_t obs_map_ric_id_repl_ric(repl_ric_t* r)
+{
+  assert(r != NULL);
+
+  map_ric_id_obs_t obs = {.add = obs_add_sub, .rm = obs_rm_sub, .ctx = r};
+  return obs;
+}
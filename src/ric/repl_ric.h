@@ -0,0 +1,130 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+#ifndef REPL_RIC_H
+#define REPL_RIC_H
+
+// Active/standby nearRT-RICs. The primary (HA_ROLE = PRIMARY) listens at 
+// HA_PEER and replicates towards the standby (HA_ROLE = STANDBY) the state 
+// changes, i.e., the E2 Setups of the E2 Nodes, the subscriptions of the 
+// xApps and their sessions, see repl_state.h. The standby connects to 
+// HA_PEER, receives a snapshot and then, the changes as they happen, without
+// binding any listener. It presents HA_SECRET, shared by both, and the 
+// primary ignores the peers without it. The changes are queued and sent by 
+// a thread of the primary, so they never wait for the standby. The primary is lost once the association ends, or 
+// after REPL_DEAD_MS without records, heartbeats included. Then, the standby 
+// takes over: it binds the E2 and E42 listeners at its NEAR_RIC_IP, i.e., 
+// the address of the primary on the same host or one that moves along, and 
+// restores the replica. The E2 Nodes keep sending the indications of their 
+// subscriptions and set up again. The xApps with a token (XAPP_TOKEN) resume 
+// their sessions, and their subscriptions, within XAPP_SESSION_GRACE_MS. 
+// Not replicated: the requests waiting for the E2 Node, the controls, the 
+// consumer groups, the indication filters and the overload policies. The 
+// subscriptions of the xApps without a token can not be resumed, so they are
+// not restored. Once it took over, the standby does not replicate itself
+
+#include "../lib/e2ap/e2ap_global_node_id_wrapper.h"
+#include "../lib/ep/e2ap_ep.h"
+#include "../util/byte_array.h"
+#include "../util/conf_file.h"
+#include "iApp/map_ric_id.h"
+#include "repl_state.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#define REPL_HEARTBEAT_MS 100
+
+#define REPL_DEAD_MS 1000
+
+typedef enum{
+  NONE_REPL_ROLE,
+  PRIMARY_REPL_ROLE,
+  STANDBY_REPL_ROLE,
+} repl_role_e;
+
+typedef struct{
+  repl_role_e role;
+
+  // Primary: listens. Standby: connects
+  e2ap_ep_t ep;
+
+  // HA_SECRET
+  byte_array_t secret;
+
+  // Primary: the association of the standby. Standby: the primary
+  sctp_info_t peer;
+  bool peer_on;
+
+  // Primary: the mirror sent as snapshot. Standby: the replica 
+  repl_state_t state;
+
+  // Primary: records to send, in order
+  seq_arr_t out; // sctp_msg_t
+  pthread_cond_t cv;
+
+  // Protects peer, peer_on, state, out and stopped
+  pthread_mutex_t mtx;
+
+  // Changes not replicated anymore, while the heartbeats go on
+  bool stopped;
+
+  // Primary: receives the HELLOs and sends the heartbeats
+  pthread_t t;
+  // Primary: sends out 
+  pthread_t t_send;
+  atomic_bool stop_token;
+} repl_ric_t;
+
+struct near_ric_s;
+
+// Blocks the standby until the primary is lost
+void init_repl_ric(repl_ric_t* r, fr_args_t const* args);
+
+// The changes that follow, e.g., the ones of the shutdown, are not 
+// replicated. The standby takes over after free_repl_ric()
+void stop_repl_ric(repl_ric_t* r);
+
+void free_repl_ric(repl_ric_t* r);
+
+// Standby, once it took over. Before the iApp handles any xApp message
+void restore_repl_ric(repl_ric_t* r, struct near_ric_s* ric);
+
+// Changes at the primary. Nothing happens in other roles 
+
+void add_e2_node_repl_ric(repl_ric_t* r, global_e2_node_id_t const* id, byte_array_t setup);
+
+void rm_e2_node_repl_ric(repl_ric_t* r, global_e2_node_id_t const* id);
+
+// token NULL if the xApp did not present one
+void add_xapp_repl_ric(repl_ric_t* r, uint16_t xapp_id, uint16_t next_xapp_id, byte_array_t const* token);
+
+void rm_xapp_repl_ric(repl_ric_t* r, uint16_t xapp_id);
+
+// Primary: the standby is attached, i.e., it receives the changes
+bool peer_on_repl_ric(repl_ric_t* r);
+
+// Subscriptions of the iApp
+map_ric_id_obs_t obs_map_ric_id_repl_ric(repl_ric_t* r);
+
+#endif
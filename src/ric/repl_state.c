@@ -0,0 +1,503 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+#include "repl_state.h"
+
+#include "../util/byte_reader.h"
+#include "../util/plain_wire.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Upper bound of a record without its bytes, i.e., SUB_ADD is 46 bytes long
+#define MAX_LEN_REPL_REC 64
+
+void free_repl_rec(repl_rec_t* r)
+{
+  assert(r != NULL);
+
+  free_global_e2_node_id(&r->node);
+  free_byte_array(r->ba);
+}
+
+/////
+// Encoding 
+/////
+
+static
+uint8_t* put_node(uint8_t* it, global_e2_node_id_t const* id)
+{
+  it = put_u32_plain_wire(it, id->type);
+  it = put_u16_plain_wire(it, id->plmn.mcc);
+  it = put_u16_plain_wire(it, id->plmn.mnc);
+  it = put_u8_plain_wire(it, id->plmn.mnc_digit_len);
+  it = put_u32_plain_wire(it, id->nb_id.nb_id);
+  it = put_u32_plain_wire(it, id->nb_id.unused);
+  it = put_u8_plain_wire(it, id->cu_du_id != NULL);
+  if(id->cu_du_id != NULL)
+    it = put_u64_plain_wire(it, *id->cu_du_id);
+  return it;
+}
+
+static
+uint8_t* put_gen_id(uint8_t* it, ric_gen_id_t const* id)
+{
+  it = put_u32_plain_wire(it, id->ric_req_id);
+  it = put_u16_plain_wire(it, id->ric_inst_id);
+  return put_u16_plain_wire(it, id->ran_func_id);
+}
+
+static
+uint8_t* put_bytes(uint8_t* it, byte_array_t ba)
+{
+  it = put_u32_plain_wire(it, ba.len);
+  if(ba.len > 0)
+    memcpy(it, ba.buf, ba.len);
+  return it + ba.len;
+}
+
+byte_array_t enc_repl_rec(repl_rec_t const* r)
+{
+  assert(r != NULL);
+  assert(r->type < END_REPL_REC);
+
+  byte_array_t ba = {.buf = malloc(MAX_LEN_REPL_REC + r->ba.len)};
+  assert(ba.buf != NULL && "Memory exhausted");
+
+  uint8_t* it = put_u8_plain_wire(ba.buf, REPL_STATE_VERSION);
+  it = put_u8_plain_wire(it, r->type);
+
+  switch(r->type){
+    case HELLO_REPL_REC:
+      it = put_bytes(it, r->ba);
+      break;
+    case RESET_REPL_REC:
+    case HEARTBEAT_REPL_REC:
+      break;
+    case NODE_ADD_REPL_REC:
+      it = put_node(it, &r->node);
+      it = put_bytes(it, r->ba);
+      break;
+    case NODE_RM_REPL_REC:
+      it = put_node(it, &r->node);
+      break;
+    case SUB_ADD_REPL_REC:
+      it = put_node(it, &r->node);
+      it = put_gen_id(it, &r->node_ric_id);
+      it = put_gen_id(it, &r->xapp.ric_id);
+      it = put_u16_plain_wire(it, r->xapp.xapp_id);
+      break;
+    case SUB_RM_REPL_REC:
+      it = put_u32_plain_wire(it, r->node_ric_id.ric_req_id);
+      break;
+    case XAPP_ADD_REPL_REC:
+      it = put_u16_plain_wire(it, r->xapp_id);
+      it = put_u16_plain_wire(it, r->next_xapp_id);
+      it = put_bytes(it, r->ba);
+      break;
+    case XAPP_RM_REPL_REC:
+      it = put_u16_plain_wire(it, r->xapp_id);
+      break;
+    default:
+      assert(0!=0 && "Unknown record");
+  }
+
+  ba.len = it - ba.buf;
+  assert(ba.len <= MAX_LEN_REPL_REC + r->ba.len);
+  return ba;
+}
+
+/////
+// Decoding 
+/////
+
+static
+void get_node(byte_reader_t* rd, global_e2_node_id_t* id)
+{
+  uint32_t type = 0;
+  get_u32_byte_reader(rd, &type);
+  id->type = type;
+  get_u16_byte_reader(rd, &id->plmn.mcc);
+  get_u16_byte_reader(rd, &id->plmn.mnc);
+  get_u8_byte_reader(rd, &id->plmn.mnc_digit_len);
+  get_u32_byte_reader(rd, &id->nb_id.nb_id);
+  get_u32_byte_reader(rd, &id->nb_id.unused);
+
+  bool has_cu_du_id = false;
+  get_bool_byte_reader(rd, &has_cu_du_id);
+  if(has_cu_du_id == true){
+    uint64_t cu_du_id = 0;
+    if(get_u64_byte_reader(rd, &cu_du_id) == true){
+      id->cu_du_id = malloc(sizeof(uint64_t));
+      assert(id->cu_du_id != NULL && "Memory exhausted");
+      *id->cu_du_id = cu_du_id;
+    }
+  }
+}
+
+static
+void get_gen_id(byte_reader_t* rd, ric_gen_id_t* id)
+{
+  get_u32_byte_reader(rd, &id->ric_req_id);
+  get_u16_byte_reader(rd, &id->ric_inst_id);
+  get_u16_byte_reader(rd, &id->ran_func_id);
+}
+
+static
+void get_bytes(byte_reader_t* rd, byte_array_t* ba)
+{
+  uint32_t len = 0;
+  get_u32_byte_reader(rd, &len);
+  if(len == 0 || fits_byte_reader(rd, len, 1) == false)
+    return;
+
+  ba->buf = malloc(len);
+  assert(ba->buf != NULL && "Memory exhausted");
+  ba->len = len;
+  get_bytes_byte_reader(rd, len, ba->buf);
+}
+
+bool dec_repl_rec(byte_array_t ba, repl_rec_t* r)
+{
+  assert(r != NULL);
+
+  *r = (repl_rec_t){0};
+  byte_reader_t rd = init_byte_reader(ba.len, ba.buf);
+
+  uint8_t version = 0;
+  uint8_t type = 0;
+  get_u8_byte_reader(&rd, &version);
+  get_u8_byte_reader(&rd, &type);
+  if(rd.err == true || version != REPL_STATE_VERSION || type >= END_REPL_REC)
+    return false;
+
+  r->type = type;
+  switch(r->type){
+    case HELLO_REPL_REC:
+      get_bytes(&rd, &r->ba);
+      break;
+    case RESET_REPL_REC:
+    case HEARTBEAT_REPL_REC:
+      break;
+    case NODE_ADD_REPL_REC:
+      get_node(&rd, &r->node);
+      get_bytes(&rd, &r->ba);
+      break;
+    case NODE_RM_REPL_REC:
+      get_node(&rd, &r->node);
+      break;
+    case SUB_ADD_REPL_REC:
+      get_node(&rd, &r->node);
+      get_gen_id(&rd, &r->node_ric_id);
+      get_gen_id(&rd, &r->xapp.ric_id);
+      get_u16_byte_reader(&rd, &r->xapp.xapp_id);
+      break;
+    case SUB_RM_REPL_REC:
+      get_u32_byte_reader(&rd, &r->node_ric_id.ric_req_id);
+      break;
+    case XAPP_ADD_REPL_REC:
+      get_u16_byte_reader(&rd, &r->xapp_id);
+      get_u16_byte_reader(&rd, &r->next_xapp_id);
+      get_bytes(&rd, &r->ba);
+      break;
+    case XAPP_RM_REPL_REC:
+      get_u16_byte_reader(&rd, &r->xapp_id);
+      break;
+    default:
+      assert(0!=0 && "Unknown record");
+  }
+
+  if(done_byte_reader(&rd) == false
+      || (r->type == NODE_ADD_REPL_REC && r->ba.len == 0)){
+    free_repl_rec(r);
+    *r = (repl_rec_t){0};
+    return false;
+  }
+
+  return true;
+}
+
+/////
+// Replica 
+/////
+
+static
+void free_repl_node(void* it)
+{
+  assert(it != NULL);
+  repl_node_t* n = (repl_node_t*)it;
+  free_global_e2_node_id(&n->id);
+  free_byte_array(n->setup);
+}
+
+static
+void free_repl_sub(void* it)
+{
+  assert(it != NULL);
+  map_ric_id_entry_t* e = (map_ric_id_entry_t*)it;
+  free_e2_node_ric_id(&e->node);
+}
+
+static
+void free_repl_xapp(void* it)
+{
+  assert(it != NULL);
+  repl_xapp_t* x = (repl_xapp_t*)it;
+  free_byte_array(x->token);
+}
+
+void init_repl_state(repl_state_t* s)
+{
+  assert(s != NULL);
+
+  seq_init(&s->nodes, sizeof(repl_node_t));
+  seq_init(&s->subs, sizeof(map_ric_id_entry_t));
+  seq_init(&s->xapps, sizeof(repl_xapp_t));
+  s->next_xapp_id = 0;
+}
+
+void free_repl_state(repl_state_t* s)
+{
+  assert(s != NULL);
+
+  seq_free(&s->nodes, free_repl_node);
+  seq_free(&s->subs, free_repl_sub);
+  seq_free(&s->xapps, free_repl_xapp);
+}
+
+static
+bool eq_node(void const* it, void const* id)
+{
+  repl_node_t const* n = (repl_node_t const*)it;
+  return eq_global_e2_node_id(&n->id, id);
+}
+
+static
+bool eq_sub(void const* it, void const* ric_req_id)
+{
+  map_ric_id_entry_t const* e = (map_ric_id_entry_t const*)it;
+  return e->node.ric_id.ric_req_id == *(uint32_t const*)ric_req_id;
+}
+
+static
+bool eq_xapp(void const* it, void const* xapp_id)
+{
+  repl_xapp_t const* x = (repl_xapp_t const*)it;
+  return x->xapp_id == *(uint16_t const*)xapp_id;
+}
+
+static
+void* find_repl(seq_arr_t* arr, void const* key, bool (*eq)(void const* it, void const* key))
+{
+  void* it = seq_front(arr);
+  void* end = seq_end(arr);
+  while(it != end){
+    if(eq(it, key) == true)
+      return it;
+    it = seq_next(arr, it);
+  }
+  return NULL;
+}
+
+static
+void erase_repl(seq_arr_t* arr, void* it, void (*f)(void*))
+{
+  f(it);
+  seq_erase(arr, it, seq_next(arr, it));
+}
+
+static
+void add_node(repl_state_t* s, repl_rec_t const* r)
+{
+  // The E2 Node set up again, e.g., after its association was lost
+  void* it = find_repl(&s->nodes, &r->node, eq_node);
+  if(it != NULL)
+    erase_repl(&s->nodes, it, free_repl_node);
+
+  repl_node_t n = {.id = cp_global_e2_node_id(&r->node), .setup = copy_byte_array(r->ba)};
+  seq_push_back(&s->nodes, &n, sizeof(n));
+}
+
+static
+void rm_node(repl_state_t* s, repl_rec_t const* r)
+{
+  void* it = find_repl(&s->nodes, &r->node, eq_node);
+  if(it != NULL)
+    erase_repl(&s->nodes, it, free_repl_node);
+}
+
+static
+void add_sub(repl_state_t* s, repl_rec_t const* r)
+{
+  void* it = find_repl(&s->subs, &r->node_ric_id.ric_req_id, eq_sub);
+  assert(it == NULL && "RIC Request ID already replicated");
+
+  map_ric_id_entry_t e = {.node.e2_node_id = cp_global_e2_node_id(&r->node),
+                          .node.ric_id = r->node_ric_id,
+                          .node.ric_req_type = SUBSCRIPTION_RIC_REQUEST_TYPE,
+                          .xapp = r->xapp};
+  seq_push_back(&s->subs, &e, sizeof(e));
+}
+
+static
+void rm_sub(repl_state_t* s, repl_rec_t const* r)
+{
+  void* it = find_repl(&s->subs, &r->node_ric_id.ric_req_id, eq_sub);
+  if(it != NULL)
+    erase_repl(&s->subs, it, free_repl_sub);
+}
+
+static
+void add_xapp(repl_state_t* s, repl_rec_t const* r)
+{
+  s->next_xapp_id = r->next_xapp_id;
+  if(r->ba.len == 0)
+    return;
+
+  // Resumed session
+  void* it = find_repl(&s->xapps, &r->xapp_id, eq_xapp);
+  if(it != NULL)
+    erase_repl(&s->xapps, it, free_repl_xapp);
+
+  repl_xapp_t x = {.xapp_id = r->xapp_id, .token = copy_byte_array(r->ba)};
+  seq_push_back(&s->xapps, &x, sizeof(x));
+}
+
+static
+void rm_xapp(repl_state_t* s, repl_rec_t const* r)
+{
+  void* it = find_repl(&s->xapps, &r->xapp_id, eq_xapp);
+  if(it != NULL)
+    erase_repl(&s->xapps, it, free_repl_xapp);
+}
+
+void apply_repl_state(repl_state_t* s, repl_rec_t const* r)
+{
+  assert(s != NULL);
+  assert(r != NULL);
+
+  switch(r->type){
+    case HELLO_REPL_REC:
+    case HEARTBEAT_REPL_REC:
+      break;
+    case RESET_REPL_REC:
+      free_repl_state(s);
+      init_repl_state(s);
+      break;
+    case NODE_ADD_REPL_REC:
+      add_node(s, r);
+      break;
+    case NODE_RM_REPL_REC:
+      rm_node(s, r);
+      break;
+    case SUB_ADD_REPL_REC:
+      add_sub(s, r);
+      break;
+    case SUB_RM_REPL_REC:
+      rm_sub(s, r);
+      break;
+    case XAPP_ADD_REPL_REC:
+      add_xapp(s, r);
+      break;
+    case XAPP_RM_REPL_REC:
+      rm_xapp(s, r);
+      break;
+    default:
+      assert(0!=0 && "Unknown record");
+  }
+}
+
+static
+void push_rec(seq_arr_t* arr, repl_rec_t const* r)
+{
+  byte_array_t ba = enc_repl_rec(r);
+  seq_push_back(arr, &ba, sizeof(ba));
+}
+
+seq_arr_t snapshot_repl_state(repl_state_t const* s)
+{
+  assert(s != NULL);
+
+  seq_arr_t arr = {0};
+  seq_init(&arr, sizeof(byte_array_t));
+
+  push_rec(&arr, &(repl_rec_t){.type = RESET_REPL_REC});
+
+  seq_arr_t* nodes = (seq_arr_t*)&s->nodes;
+  for(void* it = seq_front(nodes); it != seq_end(nodes); it = seq_next(nodes, it)){
+    repl_node_t const* n = (repl_node_t const*)it;
+    push_rec(&arr, &(repl_rec_t){.type = NODE_ADD_REPL_REC, .node = n->id, .ba = n->setup});
+  }
+
+  // xApps without session still advance the next xApp ID
+  seq_arr_t* xapps = (seq_arr_t*)&s->xapps;
+  push_rec(&arr, &(repl_rec_t){.type = XAPP_ADD_REPL_REC, .next_xapp_id = s->next_xapp_id});
+  for(void* it = seq_front(xapps); it != seq_end(xapps); it = seq_next(xapps, it)){
+    repl_xapp_t const* x = (repl_xapp_t const*)it;
+    push_rec(&arr, &(repl_rec_t){.type = XAPP_ADD_REPL_REC, .xapp_id = x->xapp_id, .next_xapp_id = s->next_xapp_id, .ba = x->token});
+  }
+
+  seq_arr_t* subs = (seq_arr_t*)&s->subs;
+  for(void* it = seq_front(subs); it != seq_end(subs); it = seq_next(subs, it)){
+    map_ric_id_entry_t const* e = (map_ric_id_entry_t const*)it;
+    push_rec(&arr, &(repl_rec_t){.type = SUB_ADD_REPL_REC, .node = e->node.e2_node_id, .node_ric_id = e->node.ric_id, .xapp = e->xapp});
+  }
+
+  return arr;
+}
+
+static
+void free_ba_it(void* it)
+{
+  assert(it != NULL);
+  free_byte_array(*(byte_array_t*)it);
+}
+
+void free_snapshot_repl_state(seq_arr_t* arr)
+{
+  assert(arr != NULL);
+  seq_free(arr, free_ba_it);
+}
+
+bool session_repl_state(repl_state_t const* s, uint16_t xapp_id)
+{
+  assert(s != NULL);
+  return find_repl((seq_arr_t*)&s->xapps, &xapp_id, eq_xapp) != NULL;
+}
+
+void prune_repl_state(repl_state_t* s)
+{
+  assert(s != NULL);
+
+  void* it = seq_front(&s->subs);
+  while(it != seq_end(&s->subs)){
+    map_ric_id_entry_t const* e = (map_ric_id_entry_t const*)it;
+    bool const node = find_repl(&s->nodes, &e->node.e2_node_id, eq_node) != NULL;
+    bool const xapp = find_repl(&s->xapps, &e->xapp.xapp_id, eq_xapp) != NULL;
+    if(node == true && xapp == true){
+      it = seq_next(&s->subs, it);
+      continue;
+    }
+    // The array is contiguous, it points to the next one
+    erase_repl(&s->subs, it, free_repl_sub);
+  }
+}
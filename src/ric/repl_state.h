@@ -0,0 +1,134 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+#ifndef REPL_STATE_RIC_H
+#define REPL_STATE_RIC_H
+
+// Replica of the state that a standby nearRT-RIC needs to take over, see 
+// repl_ric.h, and the records that change it. Versioned, little-endian:
+//
+//  record  = version:u8 type:u8 body
+//  node    = type:u32 mcc:u16 mnc:u16 mnc_digit_len:u8 nb_id:u32 unused:u32
+//            has_cu_du_id:u8 [cu_du_id:u64]
+//  gen_id  = ric_req_id:u32 ric_inst_id:u16 ran_func_id:u16
+//  bytes   = len:u32 byte*len
+//
+//  HELLO                    bytes                 HA_SECRET of the standby
+//  RESET, HEARTBEAT         no body
+//  NODE_ADD                 node bytes            E2 Setup Request, as received
+//  NODE_RM                  node
+//  SUB_ADD                  node gen_id gen_id xapp_id:u16   E2 Node, xApp
+//  SUB_RM                   ric_req_id:u32
+//  XAPP_ADD                 xapp_id:u16 next_xapp_id:u16 bytes   token
+//  XAPP_RM                  xapp_id:u16
+//
+// Incompatible changes bump REPL_STATE_VERSION, i.e., the primary and the 
+// standby run the same version
+
+#include "../lib/e2ap/e2ap_global_node_id_wrapper.h"
+#include "../util/alg_ds/ds/seq_container/seq_generic.h"
+#include "../util/byte_array.h"
+#include "iApp/map_ric_id.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define REPL_STATE_VERSION 1
+
+typedef enum{
+  // Standby -> primary. Asks for the snapshot, with the shared secret
+  HELLO_REPL_REC,
+  // First record of the snapshot. Clears the replica
+  RESET_REPL_REC,
+  HEARTBEAT_REPL_REC,
+
+  NODE_ADD_REPL_REC,
+  NODE_RM_REPL_REC,
+  SUB_ADD_REPL_REC,
+  SUB_RM_REPL_REC,
+  // E42 Setup. The token is empty if the xApp has no session
+  XAPP_ADD_REPL_REC,
+  XAPP_RM_REPL_REC,
+
+  END_REPL_REC
+} repl_rec_e;
+
+typedef struct{
+  repl_rec_e type;
+
+  // NODE_ADD, NODE_RM and SUB_ADD
+  global_e2_node_id_t node;
+  // NODE_ADD: E2 Setup Request. XAPP_ADD: token. HELLO: secret
+  byte_array_t ba;
+
+  // SUB_ADD. SUB_RM only fills node_ric_id.ric_req_id
+  ric_gen_id_t node_ric_id;
+  xapp_ric_id_t xapp;
+
+  // XAPP_ADD and XAPP_RM
+  uint16_t xapp_id;
+  uint16_t next_xapp_id;
+} repl_rec_t;
+
+// Deep copy of the decoded node and ba
+void free_repl_rec(repl_rec_t* r);
+
+byte_array_t enc_repl_rec(repl_rec_t const* r);
+
+// False if malformed or of another version. Free it on success
+bool dec_repl_rec(byte_array_t ba, repl_rec_t* r);
+
+typedef struct{
+  global_e2_node_id_t id;
+  byte_array_t setup;
+} repl_node_t;
+
+typedef struct{
+  uint16_t xapp_id;
+  byte_array_t token;
+} repl_xapp_t;
+
+typedef struct{
+  seq_arr_t nodes; // repl_node_t
+  seq_arr_t subs; // map_ric_id_entry_t
+  seq_arr_t xapps; // repl_xapp_t. Only the ones with session
+  uint16_t next_xapp_id;
+} repl_state_t;
+
+void init_repl_state(repl_state_t* s);
+
+void free_repl_state(repl_state_t* s);
+
+void apply_repl_state(repl_state_t* s, repl_rec_t const* r);
+
+// Encoded records that rebuild s, RESET first. Array of byte_array_t
+seq_arr_t snapshot_repl_state(repl_state_t const* s);
+
+void free_snapshot_repl_state(seq_arr_t* arr);
+
+// Drops the subscriptions that can not be restored, i.e., the ones of E2
+// Nodes without E2 Setup or of xApps without session
+void prune_repl_state(repl_state_t* s);
+
+// The xApp presented a token, i.e., it can resume its session
+bool session_repl_state(repl_state_t const* s, uint16_t xapp_id);
+
+#endif
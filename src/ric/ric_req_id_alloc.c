@@ -0,0 +1,274 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+
+#include "ric_req_id_alloc.h"
+
+#include "../util/alg_ds/ds/lock_guard/lock_guard.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+static inline
+int cmp_ric_req_id(void const* m0_v, void const* m1_v)
+{
+  assert(m0_v != NULL);
+  assert(m1_v != NULL);
+
+  uint32_t const* m0 = (uint32_t const*)m0_v;
+  uint32_t const* m1 = (uint32_t const*)m1_v;
+
+  if(*m0 < *m1) return -1;
+  if(*m0 == *m1) return 0;
+  return 1;
+}
+
+static
+void free_ric_req_id_ns(void* key, void* value)
+{
+  assert(key != NULL);
+  assert(value != NULL);
+  (void)key;
+
+  ric_req_id_ns_t* ns = (ric_req_id_ns_t*)value;
+  free_global_e2_node_id(&ns->id);
+  free(ns);
+}
+
+static inline
+bool test_bit(uint8_t const* live, uint32_t id)
+{
+  return (live[id >> 3] >> (id & 7)) & 1;
+}
+
+static inline
+void set_bit(uint8_t* live, uint32_t id)
+{
+  live[id >> 3] |= (uint8_t)(1 << (id & 7));
+}
+
+static inline
+void clear_bit(uint8_t* live, uint32_t id)
+{
+  live[id >> 3] &= (uint8_t)~(1 << (id & 7));
+}
+
+void init_ric_req_id_alloc(ric_req_id_alloc_t* a)
+{
+  assert(a != NULL);
+
+  memset(a->live, 0, sizeof(a->live));
+  assoc_init(&a->ns, sizeof(uint32_t), cmp_ric_req_id, free_ric_req_id_ns);
+
+  // Legacy starting point. It eases reading the logs 
+  a->next = 1021;
+  a->len_live = 0;
+
+  pthread_mutexattr_t attr = {0};
+#ifdef DEBUG
+  pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_ERRORCHECK); 
+#endif
+  int rc = pthread_mutex_init(&a->mtx, &attr);
+  assert(rc == 0);
+}
+
+void free_ric_req_id_alloc(ric_req_id_alloc_t* a)
+{
+  assert(a != NULL);
+
+  assoc_free(&a->ns);
+
+  int rc = pthread_mutex_destroy(&a->mtx);
+  assert(rc == 0);
+}
+
+uint32_t alloc_ric_req_id(ric_req_id_alloc_t* a, global_e2_node_id_t const* id, uint16_t ran_func_id)
+{
+  assert(a != NULL);
+  assert(id != NULL);
+
+  lock_guard(&a->mtx);
+
+  if(a->len_live == RIC_REQ_ID_MAX)
+    return RIC_REQ_ID_NONE;
+
+  // A free ID exists, so at most RIC_REQ_ID_MAX steps
+  uint32_t ric_req_id = a->next;
+  for(size_t i = 0; test_bit(a->live, ric_req_id) == true; ++i){
+    assert(i < RIC_REQ_ID_MAX);
+    ric_req_id = ric_req_id == RIC_REQ_ID_MAX ? 1 : ric_req_id + 1;
+  }
+  a->next = ric_req_id == RIC_REQ_ID_MAX ? 1 : ric_req_id + 1;
+
+  set_bit(a->live, ric_req_id);
+  a->len_live += 1;
+
+  ric_req_id_ns_t* ns = calloc(1, sizeof(ric_req_id_ns_t));
+  assert(ns != NULL && "Memory exhausted");
+  ns->id = cp_global_e2_node_id(id);
+  ns->ran_func_id = ran_func_id;
+  assoc_insert(&a->ns, &ric_req_id, sizeof(ric_req_id), ns);
+
+  return ric_req_id;
+}
+
+bool take_ric_req_id(ric_req_id_alloc_t* a, uint32_t ric_req_id, global_e2_node_id_t const* id, uint16_t ran_func_id)
+{
+  assert(a != NULL);
+  assert(ric_req_id > 0 && ric_req_id <= RIC_REQ_ID_MAX);
+  assert(id != NULL);
+
+  lock_guard(&a->mtx);
+
+  if(test_bit(a->live, ric_req_id) == true)
+    return false;
+
+  set_bit(a->live, ric_req_id);
+  a->len_live += 1;
+
+  ric_req_id_ns_t* ns = calloc(1, sizeof(ric_req_id_ns_t));
+  assert(ns != NULL && "Memory exhausted");
+  ns->id = cp_global_e2_node_id(id);
+  ns->ran_func_id = ran_func_id;
+  assoc_insert(&a->ns, &ric_req_id, sizeof(ric_req_id), ns);
+
+  return true;
+}
+
+void release_ric_req_id(ric_req_id_alloc_t* a, uint32_t ric_req_id)
+{
+  assert(a != NULL);
+  assert(ric_req_id > 0 && ric_req_id <= RIC_REQ_ID_MAX);
+
+  lock_guard(&a->mtx);
+
+  // Releasing twice e.g., timeout and late answer, is harmless
+  if(test_bit(a->live, ric_req_id) == false)
+    return;
+
+  clear_bit(a->live, ric_req_id);
+  a->len_live -= 1;
+
+  ric_req_id_ns_t* ns = assoc_extract(&a->ns, &ric_req_id);
+  assert(ns != NULL);
+  free_global_e2_node_id(&ns->id);
+  free(ns);
+}
+
+size_t release_node_ric_req_id(ric_req_id_alloc_t* a, global_e2_node_id_t const* id)
+{
+  assert(a != NULL);
+  assert(id != NULL);
+
+  lock_guard(&a->mtx);
+
+  size_t cnt = 0;
+  void* it = assoc_front(&a->ns);
+  void* end = assoc_end(&a->ns);
+  while(it != end){
+    uint32_t const ric_req_id = *(uint32_t*)assoc_key(&a->ns, it);
+    ric_req_id_ns_t* ns = assoc_value(&a->ns, it);
+    // The iterator is invalidated after the extraction 
+    it = assoc_next(&a->ns, it);
+
+    if(eq_global_e2_node_id(&ns->id, id) == false)
+      continue;
+
+    uint32_t key = ric_req_id;
+    ns = assoc_extract(&a->ns, &key);
+    free_global_e2_node_id(&ns->id);
+    free(ns);
+
+    clear_bit(a->live, ric_req_id);
+    a->len_live -= 1;
+    cnt += 1;
+  }
+
+  return cnt;
+}
+
+bool live_ric_req_id(ric_req_id_alloc_t* a, uint32_t ric_req_id)
+{
+  assert(a != NULL);
+
+  if(ric_req_id == 0 || ric_req_id > RIC_REQ_ID_MAX)
+    return false;
+
+  lock_guard(&a->mtx);
+  return test_bit(a->live, ric_req_id);
+}
+
+bool node_ric_req_id(ric_req_id_alloc_t* a, uint32_t ric_req_id, global_e2_node_id_t* dst)
+{
+  assert(a != NULL);
+  assert(dst != NULL);
+
+  if(ric_req_id == 0 || ric_req_id > RIC_REQ_ID_MAX)
+    return false;
+
+  lock_guard(&a->mtx);
+
+  if(test_bit(a->live, ric_req_id) == false)
+    return false;
+
+  void* it = assoc_front(&a->ns);
+  void* end = assoc_end(&a->ns);
+  while(it != end){
+    if(*(uint32_t*)assoc_key(&a->ns, it) == ric_req_id){
+      ric_req_id_ns_t const* ns = assoc_value(&a->ns, it);
+      *dst = cp_global_e2_node_id(&ns->id);
+      return true;
+    }
+    it = assoc_next(&a->ns, it);
+  }
+
+  assert(0 != 0 && "Live ID without namespace");
+  return false;
+}
+
+size_t num_live_ric_req_id(ric_req_id_alloc_t* a)
+{
+  assert(a != NULL);
+
+  lock_guard(&a->mtx);
+  return a->len_live;
+}
+
+size_t num_live_ns_ric_req_id(ric_req_id_alloc_t* a, global_e2_node_id_t const* id, uint16_t ran_func_id)
+{
+  assert(a != NULL);
+  assert(id != NULL);
+
+  lock_guard(&a->mtx);
+
+  size_t cnt = 0;
+  void* it = assoc_front(&a->ns);
+  void* end = assoc_end(&a->ns);
+  while(it != end){
+    ric_req_id_ns_t const* ns = assoc_value(&a->ns, it);
+    if(ns->ran_func_id == ran_func_id && eq_global_e2_node_id(&ns->id, id) == true)
+      cnt += 1;
+    it = assoc_next(&a->ns, it);
+  }
+
+  return cnt;
+}
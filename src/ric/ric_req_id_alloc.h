@@ -0,0 +1,88 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+
+#ifndef RIC_REQ_ID_ALLOC_H
+#define RIC_REQ_ID_ALLOC_H
+
+#include "../lib/e2ap/e2ap_global_node_id_wrapper.h"
+#include "../util/alg_ds/ds/assoc_container/assoc_generic.h"
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// E2AP RICrequestID.ricRequestorID is INTEGER (0..65535).
+// The value 0 is never handed out, as it is usually a sign of a bug
+#define RIC_REQ_ID_MAX 65535
+
+// Returned when every ID is live
+#define RIC_REQ_ID_NONE 0
+
+// Namespace of a live RIC Request ID i.e., (E2 Node, RAN Function)
+typedef struct{
+  global_e2_node_id_t id;
+  uint16_t ran_func_id;
+} ric_req_id_ns_t;
+
+typedef struct{
+  // Bitmap of live IDs. Replies from the E2 Nodes are matched in the
+  // pending events and in the iApp without the E2 Node, therefore, 
+  // an ID is live in at most one namespace
+  uint8_t live[(RIC_REQ_ID_MAX + 1)/8];
+
+  assoc_rb_tree_t ns; // key: uint32_t ric_req_id | value: ric_req_id_ns_t*
+  
+  // Next-fit cursor. Freed IDs are recycled once the cursor wraps 
+  uint32_t next;
+  size_t len_live;
+
+  pthread_mutex_t mtx;
+} ric_req_id_alloc_t;
+
+void init_ric_req_id_alloc(ric_req_id_alloc_t* a);
+
+void free_ric_req_id_alloc(ric_req_id_alloc_t* a);
+
+// Returns an ID in [1, RIC_REQ_ID_MAX] not live in any namespace, or 
+// RIC_REQ_ID_NONE if the space is exhausted
+uint32_t alloc_ric_req_id(ric_req_id_alloc_t* a, global_e2_node_id_t const* id, uint16_t ran_func_id);
+
+// Marks a given ID as live, e.g., restored from the replica of the primary
+// nearRT-RIC. Returns false if it was already live
+bool take_ric_req_id(ric_req_id_alloc_t* a, uint32_t ric_req_id, global_e2_node_id_t const* id, uint16_t ran_func_id);
+
+void release_ric_req_id(ric_req_id_alloc_t* a, uint32_t ric_req_id);
+
+// Releases all the IDs of an E2 Node e.g., after the SCTP association is lost
+size_t release_node_ric_req_id(ric_req_id_alloc_t* a, global_e2_node_id_t const* id);
+
+bool live_ric_req_id(ric_req_id_alloc_t* a, uint32_t ric_req_id);
+
+// Copies the E2 Node of a live ID into dst. Free it with free_global_e2_node_id
+bool node_ric_req_id(ric_req_id_alloc_t* a, uint32_t ric_req_id, global_e2_node_id_t* dst);
+
+size_t num_live_ric_req_id(ric_req_id_alloc_t* a);
+
+size_t num_live_ns_ric_req_id(ric_req_id_alloc_t* a, global_e2_node_id_t const* id, uint16_t ran_func_id);
+
+#endif
@@ -0,0 +1,152 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+
+#include "sub_node_ric.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+static
+void free_node(global_e2_node_id_t* n)
+{
+  if(n == NULL)
+    return;
+
+  free_global_e2_node_id(n);
+  free(n);
+}
+
+void init_sub_node_ric(sub_node_ric_t* s)
+{
+  assert(s != NULL);
+
+  // 512 KiB of virtual memory. Only the pages of live IDs are touched 
+  s->node = calloc(RIC_REQ_ID_MAX + 1, sizeof(global_e2_node_id_t*));
+  assert(s->node != NULL && "Memory exhausted");
+
+  pthread_rwlockattr_t attr = {0};
+  int const rc = pthread_rwlock_init(&s->rw, &attr);
+  assert(rc == 0);
+}
+
+void free_sub_node_ric(sub_node_ric_t* s)
+{
+  assert(s != NULL);
+
+  for(size_t i = 0; i < RIC_REQ_ID_MAX + 1; ++i)
+    free_node(s->node[i]);
+  free(s->node);
+
+  int const rc = pthread_rwlock_destroy(&s->rw);
+  assert(rc == 0);
+}
+
+void add_sub_node_ric(sub_node_ric_t* s, uint32_t ric_req_id, global_e2_node_id_t const* id)
+{
+  assert(s != NULL);
+  assert(ric_req_id > 0 && ric_req_id <= RIC_REQ_ID_MAX);
+  assert(id != NULL);
+
+  global_e2_node_id_t* n = calloc(1, sizeof(global_e2_node_id_t));
+  assert(n != NULL && "Memory exhausted");
+  *n = cp_global_e2_node_id(id);
+
+  int rc = pthread_rwlock_wrlock(&s->rw);
+  assert(rc == 0);
+
+  global_e2_node_id_t* old = s->node[ric_req_id];
+  s->node[ric_req_id] = n;
+
+  rc = pthread_rwlock_unlock(&s->rw);
+  assert(rc == 0);
+
+  free_node(old);
+}
+
+void rm_sub_node_ric(sub_node_ric_t* s, uint32_t ric_req_id)
+{
+  assert(s != NULL);
+  assert(ric_req_id > 0 && ric_req_id <= RIC_REQ_ID_MAX);
+
+  int rc = pthread_rwlock_wrlock(&s->rw);
+  assert(rc == 0);
+
+  global_e2_node_id_t* old = s->node[ric_req_id];
+  s->node[ric_req_id] = NULL;
+
+  rc = pthread_rwlock_unlock(&s->rw);
+  assert(rc == 0);
+
+  free_node(old);
+}
+
+size_t rm_node_sub_node_ric(sub_node_ric_t* s, global_e2_node_id_t const* id)
+{
+  assert(s != NULL);
+  assert(id != NULL);
+
+  size_t cnt = 0;
+
+  int rc = pthread_rwlock_wrlock(&s->rw);
+  assert(rc == 0);
+
+  for(size_t i = 1; i < RIC_REQ_ID_MAX + 1; ++i){
+    if(s->node[i] == NULL || eq_global_e2_node_id(s->node[i], id) == false)
+      continue;
+
+    free_node(s->node[i]);
+    s->node[i] = NULL;
+    cnt += 1;
+  }
+
+  rc = pthread_rwlock_unlock(&s->rw);
+  assert(rc == 0);
+
+  return cnt;
+}
+
+bool find_sub_node_ric(sub_node_ric_t* s, uint32_t ric_req_id, sub_node_t* dst)
+{
+  assert(s != NULL);
+  assert(dst != NULL);
+
+  if(ric_req_id == 0 || ric_req_id > RIC_REQ_ID_MAX)
+    return false;
+
+  int rc = pthread_rwlock_rdlock(&s->rw);
+  assert(rc == 0);
+
+  global_e2_node_id_t const* n = s->node[ric_req_id];
+  if(n != NULL){
+    dst->id = *n;
+    if(n->cu_du_id != NULL){
+      dst->cu_du_id = *n->cu_du_id;
+      dst->id.cu_du_id = &dst->cu_du_id;
+    }
+  }
+
+  rc = pthread_rwlock_unlock(&s->rw);
+  assert(rc == 0);
+
+  return n != NULL;
+}
@@ -0,0 +1,66 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+
+#ifndef SUB_NODE_RIC_H
+#define SUB_NODE_RIC_H
+
+// E2 Node of the live subscriptions, cached at Subscription Response time.
+// Every indication reads it to tag its data, therefore, the lookup is
+// O(1) and does not contend with the RIC Request ID allocator
+
+#include "../lib/e2ap/e2ap_global_node_id_wrapper.h"
+#include "ric_req_id_alloc.h"
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct{
+  // Indexed by the RIC Request ID. NULL if no live subscription 
+  global_e2_node_id_t** node;
+  pthread_rwlock_t rw;
+} sub_node_ric_t;
+
+// Copy of a cached E2 Node without allocations. id.cu_du_id, if any, 
+// points to cu_du_id, i.e., do not move it nor free it
+typedef struct{
+  global_e2_node_id_t id;
+  uint64_t cu_du_id;
+} sub_node_t;
+
+void init_sub_node_ric(sub_node_ric_t* s);
+
+void free_sub_node_ric(sub_node_ric_t* s);
+
+// Replaces the E2 Node of ric_req_id, if any
+void add_sub_node_ric(sub_node_ric_t* s, uint32_t ric_req_id, global_e2_node_id_t const* id);
+
+// Removing an absent ID e.g., a failed subscription, is harmless
+void rm_sub_node_ric(sub_node_ric_t* s, uint32_t ric_req_id);
+
+// Removes the subscriptions of an E2 Node e.g., after the SCTP association is lost
+size_t rm_node_sub_node_ric(sub_node_ric_t* s, global_e2_node_id_t const* id);
+
+bool find_sub_node_ric(sub_node_ric_t* s, uint32_t ric_req_id, sub_node_t* dst);
+
+#endif
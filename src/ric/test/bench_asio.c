@@ -0,0 +1,185 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+// Event loop of the nearRT-RIC with the epoll and the io_uring backends.
+// NUM_PEERS E2 Nodes, emulated with SEQPACKET sockets, send NUM_MSG messages
+// as fast as possible, while NUM_TIMERS periodic timers expire every ms, as
+// the pending event timers do. Reports the throughput and the syscalls of 
+// the event loop per event, i.e., epoll_wait and timerfd reads vs 
+// io_uring_enter. The recv of every message is the same in both backends
+
+#include "../asio_ric.h"
+#include "../../lib/asio_uring.h"
+#include "../../util/time_now_us.h"
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#define NUM_PEERS 8
+#define NUM_MSG 200000
+#define MSG_SIZE 256
+#define NUM_TIMERS 32
+#define TIMER_MS 1
+
+typedef struct{
+  int tx[NUM_PEERS];
+} producer_t;
+
+static
+void* producer_thread(void* arg)
+{
+  producer_t const* p = (producer_t const*)arg;
+  uint8_t msg[MSG_SIZE] = {0};
+
+  for(size_t i = 0; i < NUM_MSG; ++i){
+    ssize_t const rc = send(p->tx[i % NUM_PEERS], msg, sizeof(msg), 0);
+    assert(rc == sizeof(msg));
+  }
+  return NULL;
+}
+
+typedef struct{
+  int64_t elapsed_us;
+  size_t expirations;
+  size_t loop_syscalls;
+  size_t events;
+} result_t;
+
+static
+result_t run(asio_backend_e b)
+{
+  set_backend_asio(b);
+
+  asio_ric_t io = {0};
+  init_asio_ric(&io);
+  if(b == IO_URING_ASIO_BACKEND && io.ring == NULL){
+    result_t r = {0};
+    return r;
+  }
+
+  int rx[NUM_PEERS] = {0};
+  producer_t p = {0};
+  for(size_t i = 0; i < NUM_PEERS; ++i){
+    int sv[2] = {0};
+    int const rc = socketpair(AF_UNIX, SOCK_SEQPACKET, 0, sv);
+    assert(rc == 0);
+    rx[i] = sv[0];
+    p.tx[i] = sv[1];
+    add_fd_asio_ric(&io, rx[i]);
+  }
+
+  int timers[NUM_TIMERS] = {0};
+  for(size_t i = 0; i < NUM_TIMERS; ++i)
+    timers[i] = create_timer_ms_asio_ric(&io, TIMER_MS, TIMER_MS);
+
+  uint64_t const syscalls_start = io.ring != NULL ? syscalls_asio_uring(io.ring) : 0;
+  int64_t const start = time_now_us();
+
+  pthread_t t;
+  int rc = pthread_create(&t, NULL, producer_thread, &p);
+  assert(rc == 0);
+
+  result_t r = {0};
+  size_t msgs = 0;
+  uint8_t buf[MSG_SIZE] = {0};
+  while(msgs < NUM_MSG){
+    fd_read_t const rd = event_asio_ric(&io);
+    if(io.ring == NULL)
+      r.loop_syscalls += 1;
+
+    for(int i = 0; i < rd.len; ++i){
+      int const fd = rd.fd[i];
+      r.events += 1;
+
+      bool timer = false;
+      for(size_t j = 0; j < NUM_TIMERS && timer == false; ++j)
+        timer = fd == timers[j];
+
+      if(timer == true){
+        consume_timer_asio_ric(&io, fd);
+        r.expirations += 1;
+        if(io.ring == NULL)
+          r.loop_syscalls += 1;
+      } else {
+        ssize_t const bytes = recv(fd, buf, sizeof(buf), 0);
+        assert(bytes == sizeof(buf));
+        msgs += 1;
+      }
+    }
+  }
+
+  r.elapsed_us = time_now_us() - start;
+  if(io.ring != NULL)
+    r.loop_syscalls = syscalls_asio_uring(io.ring) - syscalls_start;
+
+  rc = pthread_join(t, NULL);
+  assert(rc == 0);
+
+  for(size_t i = 0; i < NUM_TIMERS; ++i)
+    rm_fd_asio_ric(&io, timers[i]);
+  for(size_t i = 0; i < NUM_PEERS; ++i){
+    rm_fd_asio_ric(&io, rx[i]);
+    close(p.tx[i]);
+  }
+
+  if(io.ring != NULL){
+    free_asio_uring(io.ring);
+    free(io.ring);
+  } else {
+    close(io.efd);
+  }
+
+  return r;
+}
+
+static
+void print_result(asio_backend_e b, result_t const* r)
+{
+  if(r->events == 0){
+    printf("%-8s not supported by the kernel\n", backend_asio_str(b));
+    return;
+  }
+
+  printf("%-8s %9.0f msg/s %6zu timer expirations %8zu loop syscalls %5.3f syscalls/event\n", 
+      backend_asio_str(b), 
+      NUM_MSG / (r->elapsed_us / 1000000.0), 
+      r->expirations, 
+      r->loop_syscalls,
+      (double)r->loop_syscalls / r->events);
+}
+
+int main()
+{
+  printf("%d messages of %d bytes from %d peers, %d timers every %d ms\n", NUM_MSG, MSG_SIZE, NUM_PEERS, NUM_TIMERS, TIMER_MS);
+
+  result_t const ep = run(EPOLL_ASIO_BACKEND);
+  print_result(EPOLL_ASIO_BACKEND, &ep);
+
+  result_t const ur = run(IO_URING_ASIO_BACKEND);
+  print_result(IO_URING_ASIO_BACKEND, &ur);
+
+  return EXIT_SUCCESS;
+}
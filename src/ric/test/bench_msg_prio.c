@@ -0,0 +1,169 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+
+
+
+// Control-path latency under a management storm, with and without the 
+// task manager priority lanes. Every management task burns MGMT_COST_US, as a
+// slow subscription setup or DB write would, while controls arrive periodically
+
+#include "../iApp/msg_deadline.h"
+#include "../../util/alg_ds/ds/task_man/task_manager.h"
+#include "../../util/time_now_us.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define NUM_THREADS 2
+#define NUM_MGMT 20000
+#define MGMT_COST_US 100
+#define NUM_IND 20000
+#define IND_COST_US 10
+#define NUM_CTRL 500
+#define CTRL_PERIOD_US 1000
+
+typedef struct{
+  msg_deadlines_t deadlines;
+  int64_t lat[NUM_CTRL];
+  atomic_size_t len_lat;
+  atomic_size_t done;
+} bench_t;
+
+typedef struct{
+  bench_t* b;
+  msg_class_e cls;
+  int64_t rcv;
+} bench_msg_t;
+
+static
+void spin_us(int64_t us)
+{
+  int64_t const end = time_now_us() + us;
+  while(time_now_us() < end)
+    ;
+}
+
+static
+void process_msg(void* arg)
+{
+  bench_msg_t* m = (bench_msg_t*)arg;
+  bench_t* b = m->b;
+  int64_t const now = time_now_us();
+
+  check_msg_deadline(&b->deadlines, m->cls, m->rcv, now);
+
+  if(m->cls == CTRL_MSG_CLASS){
+    size_t const idx = atomic_fetch_add(&b->len_lat, 1);
+    assert(idx < NUM_CTRL);
+    b->lat[idx] = now - m->rcv;
+  } else if(m->cls == IND_MSG_CLASS){
+    spin_us(IND_COST_US);
+  } else {
+    spin_us(MGMT_COST_US);
+  }
+
+  atomic_fetch_add(&b->done, 1);
+  free(m);
+}
+
+static
+void push_msg(task_manager_t* man, bench_t* b, msg_class_e cls, bool prio)
+{
+  bench_msg_t* m = malloc(sizeof(bench_msg_t));
+  assert(m != NULL && "Memory exhausted");
+  *m = (bench_msg_t){.b = b, .cls = cls, .rcv = time_now_us()};
+
+  task_t t = {.args = m, .func = process_msg};
+  if(prio)
+    async_prio_task_manager(man, t, cls);
+  else
+    async_task_manager(man, t);
+}
+
+static
+int cmp_int64(void const* a, void const* b)
+{
+  int64_t const x = *(int64_t const*)a;
+  int64_t const y = *(int64_t const*)b;
+  return (x > y) - (x < y);
+}
+
+static
+int64_t percentile(size_t len, int64_t const lat[len], double p)
+{
+  size_t idx = (size_t)(p*len);
+  return lat[idx < len ? idx : len - 1];
+}
+
+static
+void run(bool prio)
+{
+  bench_t* b = calloc(1, sizeof(bench_t));
+  assert(b != NULL && "Memory exhausted");
+  init_msg_deadlines(&b->deadlines, NULL);
+
+  task_manager_t man = {0};
+  init_task_manager(&man, NUM_THREADS);
+
+  // The storm arrives at once, e.g., an xApp subscribing to every E2 Node
+  for(size_t i = 0; i < NUM_MGMT; ++i)
+    push_msg(&man, b, MGMT_MSG_CLASS, prio);
+
+  // Indications and controls keep on flowing
+  size_t const ind_per_ctrl = NUM_IND / NUM_CTRL;
+  for(size_t i = 0; i < NUM_CTRL; ++i){
+    for(size_t j = 0; j < ind_per_ctrl; ++j)
+      push_msg(&man, b, IND_MSG_CLASS, prio);
+    push_msg(&man, b, CTRL_MSG_CLASS, prio);
+    usleep(CTRL_PERIOD_US);
+  }
+
+  size_t const total = NUM_MGMT + ind_per_ctrl*NUM_CTRL + NUM_CTRL;
+  while(atomic_load(&b->done) < total)
+    usleep(1000);
+
+  free_task_manager(&man, NULL);
+
+  size_t const len = atomic_load(&b->len_lat);
+  assert(len == NUM_CTRL);
+  qsort(b->lat, len, sizeof(int64_t), cmp_int64);
+
+  printf("[BENCH]: %s control latency p50 %ld us p99 %ld us p99.9 %ld us max %ld us\n", 
+         prio ? "Priority lanes" : "FIFO          ", 
+         percentile(len, b->lat, 0.5), percentile(len, b->lat, 0.99), 
+         percentile(len, b->lat, 0.999), b->lat[len - 1]);
+  print_msg_deadlines(&b->deadlines, "BENCH", stdout);
+
+  free(b);
+}
+
+int main()
+{
+  printf("[BENCH]: %d management tasks of %d us, %d indications of %d us, %d controls every %d us, %d threads\n", 
+         NUM_MGMT, MGMT_COST_US, NUM_IND, IND_COST_US, NUM_CTRL, CTRL_PERIOD_US, NUM_THREADS);
+  run(false);
+  run(true);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,268 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+#include "../admin_ric.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+static
+char const* cmd_echo(void* ctx, size_t argc, char* argv[], FILE* out)
+{
+  int* calls = (int*)ctx;
+  *calls += 1;
+
+  for(size_t i = 1; i < argc; ++i)
+    fprintf(out, "%s\n", argv[i]);
+  return NULL;
+}
+
+static
+char const* cmd_fail(void* ctx, size_t argc, char* argv[], FILE* out)
+{
+  (void)ctx;
+  (void)argc;
+  (void)argv;
+  fprintf(out, "partial\n");
+  return "it failed";
+}
+
+static
+admin_cmd_t const cmds[] = {
+  {.name = "echo", .help = "<args>", .fp = cmd_echo},
+  {.name = "fail", .help = "Always fails", .fp = cmd_fail},
+};
+
+static
+char* exec_line(admin_ric_t const* a, char const* line)
+{
+  char* buf = NULL;
+  size_t len = 0;
+  FILE* out = open_memstream(&buf, &len);
+  assert(out != NULL);
+
+  char* cp = strdup(line);
+  exec_admin_ric(a, cp, out);
+  free(cp);
+
+  fclose(out);
+  return buf;
+}
+
+static
+void test_exec(void)
+{
+  int calls = 0;
+  admin_ric_t a = {.ctx = &calls, .len_cmds = 2, .cmds = cmds};
+
+  char* ans = exec_line(&a, "echo  a\tb ");
+  assert(strcmp(ans, "a\nb\nOK\n") == 0);
+  assert(calls == 1);
+  free(ans);
+
+  ans = exec_line(&a, "fail");
+  assert(strcmp(ans, "partial\nERR it failed\n") == 0);
+  free(ans);
+
+  ans = exec_line(&a, "nope 1");
+  assert(strcmp(ans, "ERR unknown command nope, try help\n") == 0);
+  free(ans);
+
+  ans = exec_line(&a, "echo 1 2 3 4 5 6 7 8");
+  assert(strcmp(ans, "ERR too many arguments\n") == 0);
+  assert(calls == 1);
+  free(ans);
+
+  ans = exec_line(&a, "help");
+  assert(strstr(ans, "echo") != NULL);
+  assert(strstr(ans, "Always fails") != NULL);
+  assert(strcmp(ans + strlen(ans) - 3, "OK\n") == 0);
+  free(ans);
+
+  // Answered as help
+  ans = exec_line(&a, "  ");
+  assert(strstr(ans, "echo") != NULL);
+  free(ans);
+}
+
+static
+int connect_admin(char const* path)
+{
+  struct sockaddr_un addr = {.sun_family = AF_UNIX};
+  strcpy(addr.sun_path, path);
+  int const fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  assert(fd != -1);
+  int const rc = connect(fd, (struct sockaddr*)&addr, sizeof(addr));
+  assert(rc == 0);
+  return fd;
+}
+
+// Reads until n closing lines, i.e., OK or ERR, arrived
+static
+void read_answers(int fd, size_t n, char* dst, size_t len)
+{
+  size_t pos = 0;
+  size_t found = 0;
+  while(found < n){
+    assert(pos + 1 < len);
+    ssize_t const rc = recv(fd, dst + pos, len - pos - 1, 0);
+    assert(rc > 0);
+    pos += rc;
+    dst[pos] = '\0';
+
+    found = 0;
+    for(char const* it = dst; *it != '\0'; it = strchr(it, '\n') + 1){
+      if(strncmp(it, "OK\n", 3) == 0 || strncmp(it, "ERR", 3) == 0)
+        found += 1;
+      if(strchr(it, '\n') == NULL)
+        break;
+    }
+  }
+}
+
+static
+void test_socket(void)
+{
+  char path[64] = {0};
+  snprintf(path, sizeof(path), "/tmp/test_admin_ric_%d.sock", getpid());
+
+  int calls = 0;
+  admin_ric_t a = {0};
+  bool ok = init_admin_ric(&a, path, &calls, 2, cmds);
+  assert(ok == true);
+
+  struct stat st = {0};
+  int rc = stat(path, &st);
+  assert(rc == 0);
+  assert((st.st_mode & 0077) == 0);
+
+  // Pipelined, and split in arbitrary chunks
+  int fd = connect_admin(path);
+  char const req[] = "echo x\nfail\nech";
+  rc = send(fd, req, sizeof(req) - 1, 0);
+  assert(rc == sizeof(req) - 1);
+  usleep(50000);
+  rc = send(fd, "o y\n", 4, 0);
+  assert(rc == 4);
+
+  char ans[1024] = {0};
+  read_answers(fd, 3, ans, sizeof(ans));
+  assert(strcmp(ans, "x\nOK\npartial\nERR it failed\ny\nOK\n") == 0);
+  assert(calls == 2);
+
+  // A line longer than the buffer closes the connection
+  char long_line[ADMIN_RIC_MAX_LINE + 16];
+  memset(long_line, 'a', sizeof(long_line));
+  rc = send(fd, long_line, sizeof(long_line), MSG_NOSIGNAL);
+  assert(rc > 0);
+  memset(ans, 0, sizeof(ans));
+  read_answers(fd, 1, ans, sizeof(ans));
+  assert(strcmp(ans, "ERR line too long\n") == 0);
+  close(fd);
+
+  // The next client is served
+  fd = connect_admin(path);
+  rc = send(fd, "echo z\n", 7, 0);
+  assert(rc == 7);
+  memset(ans, 0, sizeof(ans));
+  read_answers(fd, 1, ans, sizeof(ans));
+  assert(strcmp(ans, "z\nOK\n") == 0);
+
+  // The connected client does not block the shutdown
+  free_admin_ric(&a);
+  close(fd);
+
+  rc = stat(path, &st);
+  assert(rc == -1);
+
+  // Nothing to do
+  free_admin_ric(&a);
+}
+
+// A second nearRT-RIC does not steal the socket of a live one, but it takes
+// over the one left behind by a crashed one
+static
+void test_in_use(void)
+{
+  char path[64] = {0};
+  snprintf(path, sizeof(path), "/tmp/test_admin_ric_%d.sock", getpid());
+
+  int calls = 0;
+  admin_ric_t a = {0};
+  bool ok = init_admin_ric(&a, path, &calls, 2, cmds);
+  assert(ok == true);
+
+  admin_ric_t b = {0};
+  ok = init_admin_ric(&b, path, &calls, 2, cmds);
+  assert(ok == false);
+  assert(b.fd == -1);
+  free_admin_ric(&b);
+
+  // The first one still answers
+  int fd = connect_admin(path);
+  int rc = send(fd, "echo x\n", 7, 0);
+  assert(rc == 7);
+  char ans[64] = {0};
+  read_answers(fd, 1, ans, sizeof(ans));
+  assert(strcmp(ans, "x\nOK\n") == 0);
+  close(fd);
+  free_admin_ric(&a);
+
+  // Bound, but nobody listens
+  struct sockaddr_un addr = {.sun_family = AF_UNIX};
+  strcpy(addr.sun_path, path);
+  fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  assert(fd != -1);
+  rc = bind(fd, (struct sockaddr*)&addr, sizeof(addr));
+  assert(rc == 0);
+  close(fd);
+
+  ok = init_admin_ric(&b, path, &calls, 2, cmds);
+  assert(ok == true);
+  free_admin_ric(&b);
+}
+
+static
+void test_bad_path(void)
+{
+  admin_ric_t a = {0};
+  bool const ok = init_admin_ric(&a, "/nonexistent/dir/admin.sock", NULL, 2, cmds);
+  assert(ok == false);
+  assert(a.fd == -1);
+  free_admin_ric(&a);
+}
+
+int main()
+{
+  test_exec();
+  test_socket();
+  test_in_use();
+  test_bad_path();
+
+  printf("Success\n");
+  return EXIT_SUCCESS;
+}
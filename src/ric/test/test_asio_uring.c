@@ -0,0 +1,248 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+#include "../asio_ric.h"
+#include "../../lib/asio_uring.h"
+#include "../../util/time_now_us.h"
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+static
+void send_msg(int fd, char const* msg)
+{
+  ssize_t const rc = send(fd, msg, strlen(msg), 0);
+  assert(rc == (ssize_t)strlen(msg));
+}
+
+static
+void recv_msg(int fd, char const* msg)
+{
+  char buf[64] = {0};
+  ssize_t const rc = recv(fd, buf, sizeof(buf) - 1, 0);
+  assert(rc == (ssize_t)strlen(msg));
+  assert(strcmp(buf, msg) == 0);
+}
+
+static
+size_t wait_events(asio_uring_t* r, int timeout_ms, int dst[8])
+{
+  return event_asio_uring(r, timeout_ms, 8, dst);
+}
+
+// As the SCTP endpoints, one message per event
+static
+void test_level(asio_uring_t* r)
+{
+  int sv[2] = {0};
+  int rc = socketpair(AF_UNIX, SOCK_SEQPACKET, 0, sv);
+  assert(rc == 0);
+
+  add_fd_asio_uring(r, sv[0], false);
+
+  int ev[8] = {0};
+  assert(wait_events(r, 10, ev) == 0);
+
+  send_msg(sv[1], "a");
+  send_msg(sv[1], "b");
+
+  // Reported again while readable
+  assert(wait_events(r, 1000, ev) == 1 && ev[0] == sv[0]);
+  recv_msg(sv[0], "a");
+  assert(wait_events(r, 1000, ev) == 1 && ev[0] == sv[0]);
+  recv_msg(sv[0], "b");
+  assert(wait_events(r, 10, ev) == 0);
+
+  // Stale completions of removed fds are dropped
+  send_msg(sv[1], "c");
+  usleep(10000);
+  rm_fd_asio_uring(r, sv[0]);
+  assert(wait_events(r, 10, ev) == 0);
+
+  close(sv[0]);
+  close(sv[1]);
+}
+
+// As EPOLLET, once per wake-up
+static
+void test_edge(asio_uring_t* r)
+{
+  int sv[2] = {0};
+  int rc = socketpair(AF_UNIX, SOCK_SEQPACKET, 0, sv);
+  assert(rc == 0);
+
+  add_fd_asio_uring(r, sv[0], true);
+
+  int ev[8] = {0};
+  send_msg(sv[1], "a");
+  assert(wait_events(r, 1000, ev) == 1 && ev[0] == sv[0]);
+  // Not read, but not reported again
+  assert(wait_events(r, 10, ev) == 0);
+
+  send_msg(sv[1], "b");
+  assert(wait_events(r, 1000, ev) == 1 && ev[0] == sv[0]);
+  recv_msg(sv[0], "a");
+  recv_msg(sv[0], "b");
+
+  rm_fd_asio_uring(r, sv[0]);
+  close(sv[0]);
+  close(sv[1]);
+}
+
+static
+void test_timers(asio_uring_t* r)
+{
+  int ev[8] = {0};
+
+  int const disarmed = create_timer_ms_asio_uring(r, 0, 5);
+  int const one_shot = create_timer_ms_asio_uring(r, 5, 0);
+  assert(is_timer_asio_uring(disarmed) && is_timer_asio_uring(one_shot));
+  assert(disarmed != one_shot);
+
+  assert(wait_events(r, 1000, ev) == 1 && ev[0] == one_shot);
+  assert(wait_events(r, 30, ev) == 0);
+  rm_timer_asio_uring(r, one_shot);
+  rm_timer_asio_uring(r, disarmed);
+
+  // The missed expirations are coalesced, as with a timerfd
+  int64_t const start = time_now_us();
+  int const periodic = create_timer_ms_asio_uring(r, 10, 10);
+  usleep(55000);
+  assert(wait_events(r, 1000, ev) == 1 && ev[0] == periodic);
+  assert(wait_events(r, 1000, ev) == 1 && ev[0] == periodic);
+  int64_t const elapsed = time_now_us() - start;
+  // The 6th expiration, in the period grid
+  assert(elapsed >= 60000);
+
+  // Stale completions of removed timers are dropped
+  usleep(15000);
+  rm_timer_asio_uring(r, periodic);
+  assert(wait_events(r, 30, ev) == 0);
+}
+
+typedef struct{
+  asio_uring_t* r;
+  int id;
+} timer_thread_t;
+
+static
+void* create_timer_thread(void* arg)
+{
+  timer_thread_t* t = (timer_thread_t*)arg;
+  usleep(20000);
+  t->id = create_timer_ms_asio_uring(t->r, 10, 10);
+  return NULL;
+}
+
+// Submissions from other threads while the event loop waits
+static
+void test_other_thread(asio_uring_t* r)
+{
+  timer_thread_t arg = {.r = r, .id = -1};
+
+  pthread_t t;
+  int rc = pthread_create(&t, NULL, create_timer_thread, &arg);
+  assert(rc == 0);
+
+  int64_t const start = time_now_us();
+  int ev[8] = {0};
+  assert(wait_events(r, 1000, ev) == 1);
+  assert(time_now_us() - start < 500000);
+
+  rc = pthread_join(t, NULL);
+  assert(rc == 0);
+  assert(ev[0] == arg.id);
+  rm_timer_asio_uring(r, arg.id);
+}
+
+// The event loop of the nearRT-RIC, with either backend
+static
+void test_asio_ric(asio_backend_e b)
+{
+  set_backend_asio(b);
+
+  asio_ric_t io = {0};
+  init_asio_ric(&io);
+
+  int sv[2] = {0};
+  int rc = socketpair(AF_UNIX, SOCK_SEQPACKET, 0, sv);
+  assert(rc == 0);
+  add_fd_asio_ric(&io, sv[0]);
+  int const tfd = create_timer_ms_asio_ric(&io, 10, 10);
+
+  send_msg(sv[1], "a");
+  send_msg(sv[1], "b");
+
+  size_t msgs = 0;
+  size_t expirations = 0;
+  while(msgs < 2 || expirations < 3){
+    fd_read_t const rd = event_asio_ric(&io);
+    for(int i = 0; i < rd.len; ++i){
+      if(rd.fd[i] == tfd){
+        consume_timer_asio_ric(&io, tfd);
+        expirations += 1;
+      } else {
+        assert(rd.fd[i] == sv[0]);
+        recv_msg(sv[0], msgs == 0 ? "a" : "b");
+        msgs += 1;
+      }
+    }
+  }
+
+  rm_fd_asio_ric(&io, tfd);
+  rm_fd_asio_ric(&io, sv[0]);
+  close(sv[1]);
+
+  if(io.ring != NULL){
+    free_asio_uring(io.ring);
+    free(io.ring);
+  } else {
+    close(io.efd);
+  }
+}
+
+int main()
+{
+  asio_uring_t r = {0};
+  if(init_asio_uring(&r) == false){
+    printf("io_uring not supported. Testing only epoll\n");
+    test_asio_ric(EPOLL_ASIO_BACKEND);
+    printf("Success\n");
+    return EXIT_SUCCESS;
+  }
+
+  test_level(&r);
+  test_edge(&r);
+  test_timers(&r);
+  test_other_thread(&r);
+  free_asio_uring(&r);
+
+  test_asio_ric(EPOLL_ASIO_BACKEND);
+  test_asio_ric(IO_URING_ASIO_BACKEND);
+
+  printf("Success\n");
+  return EXIT_SUCCESS;
+}
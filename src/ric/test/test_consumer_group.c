@@ -0,0 +1,375 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+
+
+#include "../iApp/consumer_group.h"
+#include "../../util/ngran_types.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NUM_XAPPS 4
+#define NUM_NODES 64
+
+static
+global_e2_node_id_t gen_node_id(uint32_t nb_id)
+{
+  global_e2_node_id_t id = {.type = ngran_gNB,
+                            .plmn = {.mcc = 505, .mnc = 1, .mnc_digit_len = 2},
+                            .nb_id = {.nb_id = nb_id, .unused = 0} };
+  return id;
+}
+
+static
+ric_subscription_request_t gen_sub(ric_action_t* act, byte_array_t* def)
+{
+  static uint8_t trigger[] = {1, 2, 3, 4};
+  static uint8_t defn[] = {'p', 'r', 'b'};
+  *def = (byte_array_t){.len = sizeof(defn), .buf = defn};
+  *act = (ric_action_t){.id = 0, .type = RIC_ACT_REPORT, .definition = def};
+
+  ric_subscription_request_t sr = {.ric_id = {.ran_func_id = 2},
+                                   .event_trigger = {.len = sizeof(trigger), .buf = trigger},
+                                   .action = act,
+                                   .len_action = 1};
+  return sr;
+}
+
+static
+xapp_ric_id_t gen_xapp_ric_id(uint16_t xapp_id, uint32_t node)
+{
+  // Every xApp picks its own RIC Request IDs 
+  xapp_ric_id_t x = {.ric_id = {.ran_func_id = 2, .ric_req_id = 1000 + node}, .xapp_id = xapp_id};
+  return x;
+}
+
+// Subscribes every xApp of the group to the same SM at every E2 Node
+static
+void subscribe_all(consumer_groups_t* cg, size_t num_xapps, uint16_t const xapp_id[num_xapps])
+{
+  ric_action_t act = {0};
+  byte_array_t def = {0};
+  ric_subscription_request_t sr = gen_sub(&act, &def);
+
+  for(uint32_t n = 0; n < NUM_NODES; ++n){
+    global_e2_node_id_t id = gen_node_id(n);
+
+    for(size_t i = 0; i < num_xapps; ++i){
+      xapp_ric_id_t x = gen_xapp_ric_id(xapp_id[i], n);
+      cg_sub_ans_t ans = sub_consumer_group(cg, &x, &id, &sr);
+      if(i == 0){
+        // Only the first member goes to the E2 Node
+        assert(ans.type == NEW_SHARED_SUB);
+        set_ric_req_id_consumer_group(cg, &x, n + 1);
+      } else {
+        assert(ans.type == PENDING_SHARED_SUB);
+      }
+    }
+
+    // The Subscription Response reaches every member
+    ric_subscription_response_t resp = {.ric_id = {.ran_func_id = 2, .ric_req_id = n + 1}};
+    seq_arr_t arr = ack_consumer_group(cg, &resp);
+    assert(seq_size(&arr) == num_xapps);
+    seq_free(&arr, NULL);
+  }
+
+  assert(num_subs_consumer_group(cg, xapp_id[0]) == NUM_NODES);
+}
+
+static
+uint16_t route(consumer_groups_t* cg, uint32_t node)
+{
+  xapp_ric_id_t dst = {0};
+  bool const found = route_consumer_group(cg, node + 1, (byte_array_t){0}, &dst);
+  assert(found == true);
+  // The indication carries the RIC Request ID of the member
+  assert(dst.ric_id.ric_req_id == 1000 + node);
+  return dst.xapp_id;
+}
+
+static
+void test_share_and_rebalance(void)
+{
+  consumer_groups_t cg = {0};
+  init_consumer_groups(&cg);
+
+  byte_array_t loc = cp_str_to_ba("localization");
+  uint16_t const xapp_id[NUM_XAPPS] = {7, 8, 9, 10};
+  for(size_t i = 0; i < NUM_XAPPS; ++i)
+    join_consumer_group(&cg, xapp_id[i], loc);
+
+  subscribe_all(&cg, NUM_XAPPS, xapp_id);
+
+  // Every E2 Node is owned by one member, and the load is spread
+  uint16_t owner[NUM_NODES] = {0};
+  size_t load[NUM_XAPPS] = {0};
+  for(uint32_t n = 0; n < NUM_NODES; ++n){
+    owner[n] = route(&cg, n);
+    assert(owner[n] >= 7 && owner[n] <= 10);
+    load[owner[n] - 7] += 1;
+    // Sticky
+    assert(route(&cg, n) == owner[n]);
+  }
+  for(size_t i = 0; i < NUM_XAPPS; ++i)
+    assert(load[i] > 0);
+
+  // xApp 8 leaves. Only its E2 Nodes move
+  seq_arr_t orphan = leave_consumer_group(&cg, 8);
+  assert(seq_size(&orphan) == 0);
+  seq_free(&orphan, free_e2_node_ric_id_wrapper);
+
+  for(uint32_t n = 0; n < NUM_NODES; ++n){
+    uint16_t const new_owner = route(&cg, n);
+    assert(new_owner != 8);
+    if(owner[n] != 8)
+      assert(new_owner == owner[n]);
+  }
+
+  // A member unsubscribing does not reach the E2 Node, but the last one does
+  xapp_ric_id_t x7 = gen_xapp_ric_id(7, 0);
+  xapp_ric_id_t x9 = gen_xapp_ric_id(9, 0);
+  xapp_ric_id_t x10 = gen_xapp_ric_id(10, 0);
+  assert(unsub_consumer_group(&cg, &x7).type == LEFT_UNSUB_SHARED_SUB);
+  assert(unsub_consumer_group(&cg, &x9).type == LEFT_UNSUB_SHARED_SUB);
+  cg_unsub_ans_t last = unsub_consumer_group(&cg, &x10);
+  assert(last.type == LAST_UNSUB_SHARED_SUB);
+  assert(last.shared.xapp_id == CONSUMER_GROUP_XAPP_ID);
+  assert(last.shared.ric_id.ric_req_id == 1);
+
+  xapp_ric_id_xpct_t del = del_consumer_group(&cg, 1);
+  assert(del.has_value == true);
+  assert(eq_xapp_ric_gen_id(&del.xapp_ric_id, &x10) == true);
+  assert(num_subs_consumer_group(&cg, 7) == NUM_NODES - 1);
+
+  // The remaining members leave. The shared subscriptions are orphaned
+  uint16_t const rest[] = {7, 9, 10};
+  for(size_t i = 0; i < 3; ++i){
+    seq_arr_t arr = leave_consumer_group(&cg, rest[i]);
+    assert(seq_size(&arr) == (i < 2 ? 0 : NUM_NODES - 1));
+    seq_free(&arr, free_e2_node_ric_id_wrapper);
+  }
+
+  // Subscription Delete Responses without anybody to answer
+  for(uint32_t n = 1; n < NUM_NODES; ++n){
+    del = del_consumer_group(&cg, n + 1);
+    assert(del.has_value == false);
+  }
+
+  free_byte_array(loc);
+  free_consumer_groups(&cg);
+}
+
+static
+void test_late_joiner_and_groups(void)
+{
+  consumer_groups_t cg = {0};
+  init_consumer_groups(&cg);
+
+  byte_array_t a = cp_str_to_ba("a");
+  byte_array_t b = cp_str_to_ba("b");
+  join_consumer_group(&cg, 7, a);
+  join_consumer_group(&cg, 8, a);
+  join_consumer_group(&cg, 9, b);
+
+  ric_action_t act = {0};
+  byte_array_t def = {0};
+  ric_subscription_request_t sr = gen_sub(&act, &def);
+  global_e2_node_id_t id = gen_node_id(1);
+
+  // Not in a group 
+  xapp_ric_id_t x11 = gen_xapp_ric_id(11, 0);
+  assert(sub_consumer_group(&cg, &x11, &id, &sr).type == NONE_SHARED_SUB);
+
+  xapp_ric_id_t x7 = gen_xapp_ric_id(7, 0);
+  assert(sub_consumer_group(&cg, &x7, &id, &sr).type == NEW_SHARED_SUB);
+  set_ric_req_id_consumer_group(&cg, &x7, 42);
+
+  ric_action_admitted_t adm = {.ric_act_id = 0};
+  ric_subscription_response_t resp = {.ric_id = {.ran_func_id = 2, .ric_req_id = 42}, .admitted = &adm, .len_admitted = 1};
+  seq_arr_t arr = ack_consumer_group(&cg, &resp);
+  assert(seq_size(&arr) == 1);
+  seq_free(&arr, NULL);
+
+  // Late joiner is answered with the response of the E2 Node
+  xapp_ric_id_t x8 = gen_xapp_ric_id(8, 0);
+  x8.ric_id.ric_req_id = 5;
+  cg_sub_ans_t ans = sub_consumer_group(&cg, &x8, &id, &sr);
+  assert(ans.type == JOINED_SHARED_SUB);
+  assert(ans.resp.ric_id.ric_req_id == 5);
+  assert(ans.resp.len_admitted == 1 && ans.resp.admitted[0].ric_act_id == 0);
+  free(ans.resp.admitted);
+
+  // Other group, other subscription
+  xapp_ric_id_t x9 = gen_xapp_ric_id(9, 0);
+  assert(sub_consumer_group(&cg, &x9, &id, &sr).type == NEW_SHARED_SUB);
+  set_ric_req_id_consumer_group(&cg, &x9, 43);
+
+  // Different action definition, different subscription
+  uint8_t other[] = {'r', 's', 'r', 'p'};
+  def = (byte_array_t){.len = sizeof(other), .buf = other};
+  xapp_ric_id_t x7_b = gen_xapp_ric_id(7, 1);
+  assert(sub_consumer_group(&cg, &x7_b, &id, &sr).type == NEW_SHARED_SUB);
+  set_ric_req_id_consumer_group(&cg, &x7_b, 44);
+  assert(num_subs_consumer_group(&cg, 7) == 2);
+
+  // The E2 Node leaves
+  assert(rm_e2_node_consumer_group(&cg, &id) == 3);
+  assert(num_subs_consumer_group(&cg, 7) == 0);
+
+  free_byte_array(a);
+  free_byte_array(b);
+  free_consumer_groups(&cg);
+}
+
+// The subscriptions of one E2 Node, e.g., one per UE, spread over the members
+static
+void test_key_spread_and_dup(void)
+{
+  consumer_groups_t cg = {0};
+  init_consumer_groups(&cg);
+
+  byte_array_t loc = cp_str_to_ba("localization");
+  for(uint16_t i = 0; i < NUM_XAPPS; ++i)
+    join_consumer_group(&cg, 7 + i, loc);
+
+  ric_action_t act = {0};
+  byte_array_t def = {0};
+  ric_subscription_request_t sr = gen_sub(&act, &def);
+  global_e2_node_id_t id = gen_node_id(1);
+
+  size_t load[NUM_XAPPS] = {0};
+  for(uint32_t ue = 0; ue < NUM_NODES; ++ue){
+    uint8_t defn[] = {'u', 'e', ue};
+    def = (byte_array_t){.len = sizeof(defn), .buf = defn};
+
+    for(uint16_t i = 0; i < NUM_XAPPS; ++i){
+      xapp_ric_id_t x = gen_xapp_ric_id(7 + i, ue);
+      cg_sub_ans_t const ans = sub_consumer_group(&cg, &x, &id, &sr);
+      assert(ans.type == (i == 0 ? NEW_SHARED_SUB : PENDING_SHARED_SUB));
+      if(i == 0)
+        set_ric_req_id_consumer_group(&cg, &x, ue + 1);
+    }
+
+    ric_subscription_response_t resp = {.ric_id = {.ran_func_id = 2, .ric_req_id = ue + 1}};
+    seq_arr_t arr = ack_consumer_group(&cg, &resp);
+    assert(seq_size(&arr) == NUM_XAPPS);
+    seq_free(&arr, NULL);
+
+    uint16_t const owner = route(&cg, ue);
+    assert(owner >= 7 && owner < 7 + NUM_XAPPS);
+    load[owner - 7] += 1;
+  }
+  for(size_t i = 0; i < NUM_XAPPS; ++i)
+    assert(load[i] > 0);
+
+  // A member reusing its RIC Request ID is rejected, not added twice
+  uint8_t defn[] = {'u', 'e', 0};
+  def = (byte_array_t){.len = sizeof(defn), .buf = defn};
+  xapp_ric_id_t x8 = gen_xapp_ric_id(8, 0);
+  assert(sub_consumer_group(&cg, &x8, &id, &sr).type == DUP_SHARED_SUB);
+  assert(unsub_consumer_group(&cg, &x8).type == LEFT_UNSUB_SHARED_SUB);
+  assert(unsub_consumer_group(&cg, &x8).type == NONE_UNSUB_SHARED_SUB);
+
+  assert(rm_e2_node_consumer_group(&cg, &id) == NUM_NODES);
+
+  free_byte_array(loc);
+  free_consumer_groups(&cg);
+}
+
+static
+uint16_t route_ue(consumer_groups_t* cg, uint32_t ue)
+{
+  char str[16] = {0};
+  snprintf(str, sizeof(str), "ue/0/%u", ue);
+  byte_array_t const key = {.len = strlen(str), .buf = (uint8_t*)str};
+
+  xapp_ric_id_t dst = {0};
+  bool const found = route_consumer_group(cg, 1, key, &dst);
+  assert(found == true);
+  return dst.xapp_id;
+}
+
+// One subscription covers every UE of one E2 Node. Its indications spread
+// over the members by the UE that they report on
+static
+void test_ue_spread(void)
+{
+  consumer_groups_t cg = {0};
+  init_consumer_groups(&cg);
+
+  byte_array_t loc = cp_str_to_ba("localization");
+  for(uint16_t i = 0; i < NUM_XAPPS; ++i)
+    join_consumer_group(&cg, 7 + i, loc);
+
+  ric_action_t act = {0};
+  byte_array_t def = {0};
+  ric_subscription_request_t sr = gen_sub(&act, &def);
+  global_e2_node_id_t id = gen_node_id(1);
+  for(uint16_t i = 0; i < NUM_XAPPS; ++i){
+    xapp_ric_id_t x = gen_xapp_ric_id(7 + i, 0);
+    cg_sub_ans_t const ans = sub_consumer_group(&cg, &x, &id, &sr);
+    if(i == 0)
+      set_ric_req_id_consumer_group(&cg, &x, 1);
+    assert(ans.type == (i == 0 ? NEW_SHARED_SUB : PENDING_SHARED_SUB));
+  }
+  ric_subscription_response_t resp = {.ric_id = {.ran_func_id = 2, .ric_req_id = 1}};
+  seq_arr_t arr = ack_consumer_group(&cg, &resp);
+  seq_free(&arr, NULL);
+
+  uint16_t owner[NUM_NODES] = {0};
+  size_t load[NUM_XAPPS] = {0};
+  for(uint32_t ue = 0; ue < NUM_NODES; ++ue){
+    owner[ue] = route_ue(&cg, ue);
+    load[owner[ue] - 7] += 1;
+    // Sticky
+    assert(route_ue(&cg, ue) == owner[ue]);
+  }
+  for(size_t i = 0; i < NUM_XAPPS; ++i)
+    assert(load[i] > 0);
+
+  // xApp 9 leaves. Only its UEs move
+  seq_arr_t orphan = leave_consumer_group(&cg, 9);
+  assert(seq_size(&orphan) == 0);
+  seq_free(&orphan, free_e2_node_ric_id_wrapper);
+  for(uint32_t ue = 0; ue < NUM_NODES; ++ue){
+    uint16_t const now = route_ue(&cg, ue);
+    assert(now != 9);
+    assert(owner[ue] == 9 || now == owner[ue]);
+  }
+
+  assert(rm_e2_node_consumer_group(&cg, &id) == 1);
+  free_byte_array(loc);
+  free_consumer_groups(&cg);
+}
+
+int main()
+{
+  test_share_and_rebalance();
+  test_late_joiner_and_groups();
+  test_key_spread_and_dup();
+  test_ue_spread();
+
+  printf("Success\n");
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,214 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+
+
+
+#include "../iApp/ctrl_conflict.h"
+#include "../../util/ngran_types.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define AUDIT_PATH "/tmp/test_ctrl_conflict.log"
+#define RC_RAN_FUNC_ID 3
+
+static
+global_e2_node_id_t gen_node_id(uint32_t nb_id)
+{
+  global_e2_node_id_t id = {.type = ngran_gNB,
+                            .plmn = {.mcc = 505, .mnc = 1, .mnc_digit_len = 2},
+                            .nb_id = {.nb_id = nb_id, .unused = 0} };
+  return id;
+}
+
+// The targets are owned by the caller, as the ones returned by the SM
+static
+sm_ctrl_target_t gen_target(char const* target, char const* param, char const* val)
+{
+  sm_ctrl_target_t t = {.target = cp_str_to_ba(target),
+                        .param = cp_str_to_ba(param),
+                        .val = cp_str_to_ba(val)};
+  return t;
+}
+
+static
+bool check(ctrl_conflicts_t* c, int64_t now, uint32_t nb_id, uint16_t xapp_id, char const* identity, char const* target, char const* val)
+{
+  global_e2_node_id_t id = gen_node_id(nb_id);
+  byte_array_t ident = cp_str_to_ba(identity);
+
+  sm_ctrl_target_t* t = calloc(1, sizeof(sm_ctrl_target_t));
+  assert(t != NULL && "Memory exhausted");
+  t[0] = gen_target(target, "1/2/3", val);
+
+  bool const ans = check_ctrl_conflict(c, now, &id, RC_RAN_FUNC_ID, xapp_id, ident, 1, t);
+
+  free_sm_ctrl_targets(1, t);
+  free_byte_array(ident);
+  return ans;
+}
+
+static
+size_t count_audit(char const* decision)
+{
+  FILE* fp = fopen(AUDIT_PATH, "r");
+  assert(fp != NULL);
+
+  size_t cnt = 0;
+  char line[512] = {0};
+  while(fgets(line, sizeof(line), fp) != NULL){
+    if(strstr(line, decision) != NULL)
+      ++cnt;
+  }
+  fclose(fp);
+  return cnt;
+}
+
+static
+void test_disabled(void)
+{
+  ctrl_conflicts_t c = {0};
+  init_ctrl_conflicts(&c, NULL, NULL);
+
+  assert(check(&c, 0, 1, 7, "a", "ue/0/1", "10") == true);
+  assert(check(&c, 1, 1, 8, "b", "ue/0/1", "20") == true);
+
+  free_ctrl_conflicts(&c);
+}
+
+static
+void test_log(void)
+{
+  remove(AUDIT_PATH);
+  ctrl_conflicts_t c = {0};
+  init_ctrl_conflicts(&c, "log", AUDIT_PATH);
+
+  assert(check(&c, 0, 1, 7, "a", "ue/0/1", "10") == true);
+  // Forwarded and recorded
+  assert(check(&c, 1, 1, 8, "b", "ue/0/1", "20") == true);
+  assert(count_audit("CONFLICT") == 1);
+
+  free_ctrl_conflicts(&c);
+}
+
+static
+void test_first_wins(void)
+{
+  remove(AUDIT_PATH);
+  ctrl_conflicts_t c = {0};
+  init_ctrl_conflicts(&c, "first;win=500", AUDIT_PATH);
+  assert(c.window_us == 500*1000);
+
+  int64_t const t0 = 1000000;
+  assert(check(&c, t0, 1, 7, "a", "ue/0/1", "10") == true);
+  // Same xApp, or same value, or different UE, or different E2 Node do not conflict
+  assert(check(&c, t0 + 1, 1, 7, "a", "ue/0/1", "11") == true);
+  assert(check(&c, t0 + 2, 1, 8, "b", "ue/0/1", "11") == true);
+  assert(check(&c, t0 + 3, 1, 8, "b", "ue/0/2", "20") == true);
+  assert(check(&c, t0 + 4, 2, 8, "b", "ue/0/1", "20") == true);
+
+  // Different value from a different xApp within the window
+  assert(check(&c, t0 + 5, 1, 9, "c", "ue/0/1", "20") == false);
+  assert(count_audit("REJECTED") == 1);
+
+  // After the window, the target is free again
+  assert(check(&c, t0 + 500*1000 + 2, 1, 8, "b", "ue/0/1", "20") == true);
+  assert(check(&c, t0 + 500*1000 + 3, 1, 7, "a", "ue/0/1", "10") == false);
+  assert(count_audit("REJECTED") == 2);
+
+  // A disconnected E2 Node forgets its records, but not the ones of the other E2 Nodes
+  assert(check(&c, t0 + 500*1000 + 4, 2, 8, "b", "ue/0/1", "20") == true);
+  global_e2_node_id_t id = gen_node_id(1);
+  rm_e2_node_ctrl_conflicts(&c, &id);
+  assert(check(&c, t0 + 500*1000 + 5, 1, 7, "a", "ue/0/1", "10") == true);
+  assert(check(&c, t0 + 500*1000 + 6, 2, 7, "a", "ue/0/1", "10") == false);
+
+  free_ctrl_conflicts(&c);
+}
+
+static
+void test_priority(void)
+{
+  remove(AUDIT_PATH);
+  ctrl_conflicts_t c = {0};
+  init_ctrl_conflicts(&c, "priority;prio=mobility:10,energy:5", AUDIT_PATH);
+  assert(c.len_prio == 2);
+
+  assert(check(&c, 0, 1, 7, "energy", "ue/0/1", "10") == true);
+  // Higher priority preempts
+  assert(check(&c, 1, 1, 8, "mobility", "ue/0/1", "20") == true);
+  assert(count_audit("PREEMPTED") == 1);
+  // Lower priority, and unknown identities (0), are rejected
+  assert(check(&c, 2, 1, 7, "energy", "ue/0/1", "10") == false);
+  assert(check(&c, 3, 1, 9, "", "ue/0/1", "30") == false);
+  assert(count_audit("REJECTED") == 2);
+
+  // Ties are solved as first wins
+  assert(check(&c, 4, 1, 7, "energy", "", "on") == true);
+  assert(check(&c, 5, 1, 9, "energy", "", "off") == false);
+
+  free_ctrl_conflicts(&c);
+}
+
+static
+void test_atomic_reject(void)
+{
+  ctrl_conflicts_t c = {0};
+  init_ctrl_conflicts(&c, "first", AUDIT_PATH);
+
+  global_e2_node_id_t id = gen_node_id(1);
+  byte_array_t ident = {0};
+
+  sm_ctrl_target_t* t = calloc(2, sizeof(sm_ctrl_target_t));
+  assert(t != NULL && "Memory exhausted");
+  t[0] = gen_target("ue/0/1", "1/2/3", "10");
+  t[1] = gen_target("ue/0/1", "1/2/4", "10");
+  assert(check_ctrl_conflict(&c, 0, &id, RC_RAN_FUNC_ID, 7, ident, 2, t) == true);
+  free_sm_ctrl_targets(2, t);
+
+  // The second target conflicts, so none of them is recorded
+  t = calloc(2, sizeof(sm_ctrl_target_t));
+  assert(t != NULL && "Memory exhausted");
+  t[0] = gen_target("ue/0/2", "1/2/3", "20");
+  t[1] = gen_target("ue/0/1", "1/2/4", "20");
+  assert(check_ctrl_conflict(&c, 1, &id, RC_RAN_FUNC_ID, 8, ident, 2, t) == false);
+  free_sm_ctrl_targets(2, t);
+
+  assert(check(&c, 2, 1, 9, "", "ue/0/2", "30") == true);
+
+  free_ctrl_conflicts(&c);
+}
+
+int main()
+{
+  test_disabled();
+  test_log();
+  test_first_wins();
+  test_priority();
+  test_atomic_reject();
+
+  remove(AUDIT_PATH);
+  printf("Success\n");
+  return EXIT_SUCCESS;
+}
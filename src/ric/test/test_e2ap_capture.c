@@ -0,0 +1,330 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+#include "../../lib/ep/e2ap_capture.h"
+
+#include <arpa/inet.h>
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define NUM_MSG 1000
+#define LEN_PAYLOAD 200
+#define NUM_FILES 3
+
+// The peer is tagged in between. The truncated message fills a file, 
+// and the other two keep the last ~450 messages
+#define TAG_FROM 700
+#define TAG_TO 900
+
+// Minimum size of a file, i.e., 65K
+#define FILE_SIZE (0x10000 + 1024)
+
+static
+struct sockaddr_in init_addr(char const* ip, uint16_t port)
+{
+  struct sockaddr_in addr = {.sin_family = AF_INET, .sin_port = htons(port)};
+  int const rc = inet_pton(AF_INET, ip, &addr.sin_addr);
+  assert(rc == 1);
+  return addr;
+}
+
+static
+e2ap_capture_hdr_t init_hdr(bool tx)
+{
+  e2ap_capture_hdr_t hdr = {.tx = tx,
+                            .local = init_addr("127.0.0.1", 36421),
+                            .peer = init_addr("10.0.0.2", 38472),
+                            .assoc_id = 7, 
+                            .stream = 0,
+                            .ppid = 0};
+  return hdr;
+}
+
+static
+byte_array_t init_payload(uint32_t seq, size_t len)
+{
+  byte_array_t ba = {.len = len};
+  ba.buf = malloc(len);
+  assert(ba.buf != NULL);
+  for(size_t i = 0; i < len; ++i)
+    ba.buf[i] = (seq + i) & 0xFF;
+  memcpy(ba.buf, &seq, sizeof(seq));
+  return ba;
+}
+
+static
+uint32_t rd_u32(uint8_t const* src)
+{
+  uint32_t v = 0;
+  memcpy(&v, src, sizeof(v));
+  return v;
+}
+
+static
+uint16_t rd_u16(uint8_t const* src)
+{
+  uint16_t v = 0;
+  memcpy(&v, src, sizeof(v));
+  return v;
+}
+
+static
+uint16_t rd_u16_be(uint8_t const* src)
+{
+  return (src[0] << 8) | src[1];
+}
+
+// Bitwise, to cross-check the table of the capture
+static
+uint32_t crc32c_bitwise(uint8_t const* buf, size_t len)
+{
+  uint32_t c = 0xFFFFFFFF;
+  for(size_t i = 0; i < len; ++i){
+    c ^= buf[i];
+    for(int j = 0; j < 8; ++j)
+      c = (c >> 1) ^ (0x82F63B78 & -(c & 1));
+  }
+  return ~c;
+}
+
+static
+void check_ipv4_sctp(uint8_t const* pkt, size_t len, size_t len_payload, bool tx)
+{
+  // IPv4. The checksum over the header, with the checksum, is zero
+  assert(pkt[0] == 0x45);
+  assert(rd_u16_be(pkt + 2) == len);
+  assert(pkt[9] == IPPROTO_SCTP);
+  uint32_t sum = 0;
+  for(size_t i = 0; i < 20; i += 2)
+    sum += rd_u16_be(pkt + i);
+  while(sum >> 16)
+    sum = (sum & 0xFFFF) + (sum >> 16);
+  assert(sum == 0xFFFF);
+
+  struct sockaddr_in const local = init_addr("127.0.0.1", 36421);
+  struct sockaddr_in const peer = init_addr("10.0.0.2", 38472);
+  struct sockaddr_in const* src = tx ? &local : &peer;
+  assert(memcmp(pkt + 12, &src->sin_addr.s_addr, 4) == 0);
+
+  // SCTP common header
+  uint8_t sctp[0x10000] = {0};
+  size_t const len_sctp = len - 20;
+  memcpy(sctp, pkt + 20, len_sctp);
+  assert(memcmp(sctp, &src->sin_port, 2) == 0);
+  uint32_t const crc = sctp[8] | sctp[9] << 8 | sctp[10] << 16 | (uint32_t)sctp[11] << 24;
+  memset(sctp + 8, 0, 4);
+  assert(crc32c_bitwise(sctp, len_sctp) == crc);
+
+  // DATA chunk
+  uint8_t const* chunk = pkt + 20 + 12;
+  assert(chunk[0] == 0);
+  assert(chunk[1] == 0x03);
+  assert(rd_u16_be(chunk + 2) == 16 + len_payload);
+  uint32_t ppid = 0;
+  memcpy(&ppid, chunk + 12, 4);
+  assert(ntohl(ppid) == E2AP_SCTP_PPID);
+}
+
+typedef struct{
+  size_t len;
+  uint32_t seq[NUM_MSG];
+  char comment[NUM_MSG][256];
+  bool truncated;
+} read_pkts_t;
+
+static
+void read_file(char const* path, read_pkts_t* out)
+{
+  FILE* fp = fopen(path, "rb");
+  assert(fp != NULL);
+
+  uint8_t* buf = malloc(2*FILE_SIZE);
+  assert(buf != NULL);
+  size_t const len = fread(buf, 1, 2*FILE_SIZE, fp);
+  fclose(fp);
+  assert(len > 0 && len <= FILE_SIZE);
+
+  // Section Header Block and Interface Description Block
+  assert(rd_u32(buf) == 0x0A0D0D0A);
+  assert(rd_u32(buf + 8) == 0x1A2B3C4D);
+  size_t pos = rd_u32(buf + 4);
+  assert(rd_u32(buf + pos - 4) == pos);
+  assert(rd_u32(buf + pos) == 1);
+  assert(rd_u16(buf + pos + 8) == 228);
+  pos += rd_u32(buf + pos + 4);
+
+  while(pos < len){
+    uint8_t const* b = buf + pos;
+    assert(rd_u32(b) == 6);
+    uint32_t const len_blk = rd_u32(b + 4);
+    assert(len_blk % 4 == 0);
+    assert(pos + len_blk <= len);
+    assert(rd_u32(b + len_blk - 4) == len_blk);
+
+    uint32_t const cap_len = rd_u32(b + 20);
+    assert(cap_len == rd_u32(b + 24));
+    uint8_t const* pkt = b + 28;
+    size_t const len_payload = rd_u16_be(pkt + 20 + 12 + 2) - 16;
+
+    // Comment option
+    uint8_t const* opt = pkt + ((cap_len + 3) & ~3u);
+    assert(rd_u16(opt) == 1);
+    uint16_t const len_comment = rd_u16(opt + 2);
+    assert(len_comment < 256);
+
+    uint32_t seq = 0;
+    memcpy(&seq, pkt + 20 + 12 + 16, sizeof(seq));
+    assert(seq < NUM_MSG + 1);
+    bool const tx = seq % 2 == 0;
+    check_ipv4_sctp(pkt, cap_len, len_payload, tx);
+
+    if(seq == NUM_MSG){
+      // The oversized message
+      out->truncated = true;
+      assert(strstr((char const*)opt + 4, "| truncated") != NULL);
+    } else {
+      assert(len_payload == LEN_PAYLOAD);
+      byte_array_t exp = init_payload(seq, LEN_PAYLOAD);
+      assert(memcmp(pkt + 20 + 12 + 16, exp.buf, exp.len) == 0);
+      free_byte_array(exp);
+
+      assert(out->len < NUM_MSG);
+      out->seq[out->len] = seq;
+      memcpy(out->comment[out->len], opt + 4, len_comment);
+      out->comment[out->len][len_comment] = '\0';
+      out->len += 1;
+    }
+
+    pos += len_blk;
+  }
+  assert(pos == len);
+
+  free(buf);
+}
+
+static
+void test_ring(char const* dir)
+{
+  char path[256] = {0};
+  snprintf(path, sizeof(path), "%s/flexric.pcapng", dir);
+
+  init_e2ap_capture(path, "files=3;size=65K");
+  assert(enabled_e2ap_capture() == true);
+
+  // A second user, e.g., the agent running in the nearRT-RIC process
+  init_e2ap_capture(path, NULL);
+  free_e2ap_capture();
+  assert(enabled_e2ap_capture() == true);
+
+  struct sockaddr_in const peer = init_addr("10.0.0.2", 38472);
+  for(uint32_t seq = 0; seq < NUM_MSG; ++seq){
+    if(seq == TAG_FROM)
+      tag_e2ap_capture(&peer, "gNB mcc 505 mnc 1 nb_id 1");
+    if(seq == TAG_TO)
+      tag_e2ap_capture(&peer, NULL);
+    // Reused by the next message, i.e., copied by the capture
+    char note[E2AP_CAPTURE_NOTE_LEN] = {0};
+    snprintf(note, sizeof(note), "xApp 7 RIC_REQ_ID %u", seq);
+
+    e2ap_capture_hdr_t hdr = init_hdr(seq % 2 == 0);
+    if(seq % 10 == 0)
+      hdr.note = note;
+    byte_array_t ba = init_payload(seq, LEN_PAYLOAD);
+    capture_e2ap(&hdr, ba);
+    free_byte_array(ba);
+
+    // Let the writer keep up
+    if(seq % 100 == 0)
+      usleep(1000);
+  }
+
+  e2ap_capture_hdr_t const hdr = init_hdr(true);
+  byte_array_t ba = init_payload(NUM_MSG, 70000);
+  capture_e2ap(&hdr, ba);
+  free_byte_array(ba);
+
+  free_e2ap_capture();
+  assert(enabled_e2ap_capture() == false);
+  assert(dropped_e2ap_capture() == 0);
+
+  // Nothing but the ring
+  char file[256] = {0};
+  snprintf(file, sizeof(file), "%s/flexric_%d.pcapng", dir, NUM_FILES);
+  assert(access(file, F_OK) != 0);
+
+  read_pkts_t* pkts = calloc(1, sizeof(read_pkts_t));
+  assert(pkts != NULL);
+  for(int i = 0; i < NUM_FILES; ++i){
+    snprintf(file, sizeof(file), "%s/flexric_%d.pcapng", dir, i);
+    read_file(file, pkts);
+    unlink(file);
+  }
+
+  // The oldest messages were overwritten. The rest are all there
+  assert(pkts->truncated == true);
+  assert(pkts->len > 0 && pkts->len < NUM_MSG);
+  uint32_t min_seq = NUM_MSG;
+  for(size_t i = 0; i < pkts->len; ++i)
+    min_seq = pkts->seq[i] < min_seq ? pkts->seq[i] : min_seq;
+  assert(min_seq > 0);
+  assert(pkts->len == NUM_MSG - min_seq);
+  assert(min_seq < TAG_FROM && "Too small sample");
+
+  for(size_t i = 0; i < pkts->len; ++i){
+    uint32_t const seq = pkts->seq[i];
+    char const* c = pkts->comment[i];
+
+    char exp[256] = {0};
+    snprintf(exp, sizeof(exp), "%s assoc 7 stream 0", seq % 2 == 0 ? "tx" : "rx");
+    assert(strncmp(c, exp, strlen(exp)) == 0);
+
+    bool const tagged = seq >= TAG_FROM && seq < TAG_TO;
+    assert((strstr(c, " peer gNB mcc 505 mnc 1 nb_id 1") != NULL) == tagged);
+
+    snprintf(exp, sizeof(exp), "| xApp 7 RIC_REQ_ID %u", seq);
+    assert((strstr(c, exp) != NULL) == (seq % 10 == 0));
+  }
+
+  free(pkts);
+}
+
+int main()
+{
+  char dir[] = "/tmp/test_e2ap_capture_XXXXXX";
+  char* d = mkdtemp(dir);
+  assert(d != NULL);
+
+  // Disabled
+  init_e2ap_capture(NULL, NULL);
+  assert(enabled_e2ap_capture() == false);
+  free_e2ap_capture();
+
+  test_ring(dir);
+
+  int const rc = rmdir(dir);
+  assert(rc == 0);
+
+  printf("Success\n");
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,340 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+
+
+
+#include "../iApp/ind_overload.h"
+#include "../../util/ngran_types.h"
+
+#include <assert.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define MAX_RCV 1024
+
+// Artificially slow xApp. It blocks while the gate is closed, 
+// and takes delay_us per indication
+static struct{
+  atomic_bool open;
+  atomic_int delay_us;
+  atomic_size_t entered;
+  atomic_size_t len;
+  char rcv[MAX_RCV][16];
+} xapp;
+
+static
+void slow_xapp_send(void* ctx, uint16_t xapp_id, byte_array_t ba)
+{
+  assert(ctx == &xapp);
+  assert(xapp_id == 42);
+  assert(ba.len < 16);
+
+  xapp.entered += 1;
+  while(xapp.open == false)
+    usleep(100);
+  usleep(xapp.delay_us);
+
+  size_t const i = xapp.len;
+  assert(i < MAX_RCV);
+  memcpy(xapp.rcv[i], ba.buf, ba.len);
+  xapp.rcv[i][ba.len] = '\0';
+  xapp.len = i + 1;
+}
+
+static
+void reset_xapp(bool open, int delay_us)
+{
+  xapp.open = open;
+  xapp.delay_us = delay_us;
+  xapp.entered = 0;
+  xapp.len = 0;
+}
+
+static
+void wait_entered(size_t n)
+{
+  while(xapp.entered < n)
+    usleep(100);
+}
+
+static
+void wait_rcv(size_t n)
+{
+  while(xapp.len < n)
+    usleep(100);
+}
+
+static
+global_e2_node_id_t gen_node_id(uint32_t nb_id)
+{
+  global_e2_node_id_t id = {.type = ngran_gNB,
+                            .plmn = {.mcc = 505, .mnc = 1, .mnc_digit_len = 2},
+                            .nb_id = {.nb_id = nb_id, .unused = 0} };
+  return id;
+}
+
+// The header carries the UE, the message the payload
+static
+byte_array_t key_test(sm_ric_t const* sm, sm_ind_data_t const* src)
+{
+  assert(sm != NULL);
+  byte_array_t ba = {.len = src->len_hdr, .buf = malloc(src->len_hdr)};
+  assert(ba.buf != NULL);
+  memcpy(ba.buf, src->ind_hdr, src->len_hdr);
+  return ba;
+}
+
+static
+bool push(ind_overloads_t* o, int64_t now, uint32_t ric_req_id, char const* ue, char const* payload)
+{
+  sm_ind_data_t const src = {.ind_hdr = (uint8_t*)ue, .len_hdr = strlen(ue),
+                             .ind_msg = (uint8_t*)payload, .len_msg = strlen(payload)};
+  byte_array_t ba = cp_str_to_ba(payload);
+  bool const queued = push_ind_overload(o, now, ric_req_id, 42, &src, &ba);
+  if(queued == false)
+    free_byte_array(ba);
+  else
+    assert(ba.buf == NULL && "Not moved");
+  return queued;
+}
+
+static
+overload_conf_t conf(char const* str)
+{
+  byte_array_t ba = cp_str_to_ba(str);
+  overload_conf_t c = {0};
+  bool const ok = parse_overload_conf(ba, &c);
+  assert(ok == true);
+  free_byte_array(ba);
+  return c;
+}
+
+static
+void check_rcv(size_t len, char const* exp[len])
+{
+  wait_rcv(len);
+  usleep(5000);
+  assert(xapp.len == len);
+  for(size_t i = 0; i < len; ++i){
+    if(strcmp(xapp.rcv[i], exp[i]) != 0)
+      printf("Indication %lu received %s expected %s\n", i, xapp.rcv[i], exp[i]);
+    assert(strcmp(xapp.rcv[i], exp[i]) == 0);
+  }
+}
+
+static
+void test_parse(void)
+{
+  char const* valid[] = {"policy=drop_oldest", "policy=drop_newest;depth=1", "depth=4096;policy=keep_latest", "depth=8"};
+  for(size_t i = 0; i < sizeof(valid)/sizeof(valid[0]); ++i){
+    byte_array_t ba = cp_str_to_ba(valid[i]);
+    overload_conf_t c = {0};
+    assert(parse_overload_conf(ba, &c) == true);
+    free_byte_array(ba);
+  }
+
+  overload_conf_t c = conf("depth=8");
+  assert(c.policy == DROP_OLDEST_OVERLOAD_POLICY && c.depth == 8);
+  c = conf("policy=keep_latest");
+  assert(c.policy == KEEP_LATEST_OVERLOAD_POLICY && c.depth == OVERLOAD_DEPTH);
+
+  char const* invalid[] = {"", "policy=lifo", "depth=0", "depth=4097", "depth=", "depth=8x", "policy", "rate=10"};
+  for(size_t i = 0; i < sizeof(invalid)/sizeof(invalid[0]); ++i){
+    byte_array_t ba = cp_str_to_ba(invalid[i]);
+    overload_conf_t c = {0};
+    assert(parse_overload_conf(ba, &c) == false);
+    free_byte_array(ba);
+  }
+}
+
+// The xApp is stuck sending "0" while the others arrive
+static
+void test_drop(char const* policy, size_t len, char const* exp[len])
+{
+  ind_overloads_t o = {0};
+  init_ind_overloads(&o, slow_xapp_send, &xapp);
+  reset_xapp(false, 0);
+
+  global_e2_node_id_t id = gen_node_id(1);
+  add_ind_overload(&o, 10, &id, NULL, conf(policy));
+
+  // Not protected. The caller sends it
+  assert(push(&o, 0, 11, "", "x") == false);
+
+  assert(push(&o, 0, 10, "", "0") == true);
+  wait_entered(1);
+
+  char str[16] = {0};
+  for(int i = 1; i <= 10; ++i){
+    snprintf(str, sizeof(str), "%d", i);
+    assert(push(&o, 0, 10, "", str) == true);
+  }
+
+  ind_overload_stats_t s = {0};
+  assert(stats_ind_overload(&o, 10, &s) == true);
+  assert(s.ind_in == 11 && s.ind_out == 1 && s.dropped == 6 && s.queued == 4);
+
+  xapp.open = true;
+  check_rcv(len, exp);
+
+  assert(stats_ind_overload(&o, 10, &s) == true);
+  assert(s.ind_out == 5 && s.queued == 0);
+  assert(stats_ind_overload(&o, 11, &s) == false);
+
+  free_ind_overloads(&o);
+}
+
+static
+void test_keep_latest(void)
+{
+  ind_overloads_t o = {0};
+  init_ind_overloads(&o, slow_xapp_send, &xapp);
+  reset_xapp(false, 0);
+
+  sm_ric_t sm = {0};
+  sm.conflate.key = key_test;
+
+  global_e2_node_id_t id = gen_node_id(1);
+  add_ind_overload(&o, 10, &id, &sm, conf("policy=keep_latest;depth=3"));
+
+  push(&o, 0, 10, "ue1", "a0");
+  wait_entered(1);
+
+  push(&o, 0, 10, "ue1", "a1");
+  push(&o, 0, 10, "ue2", "b1");
+  push(&o, 0, 10, "ue1", "a2");
+  push(&o, 0, 10, "ue2", "b2");
+  push(&o, 0, 10, "ue3", "c1");
+  // Full. A new UE drops the oldest
+  push(&o, 0, 10, "ue4", "d1");
+  // Reports on the whole E2 Node are not conflated
+  push(&o, 0, 10, "", "e1");
+
+  ind_overload_stats_t s = {0};
+  assert(stats_ind_overload(&o, 10, &s) == true);
+  assert(s.conflated == 2 && s.dropped == 2 && s.queued == 3);
+
+  xapp.open = true;
+  char const* exp[] = {"a0", "c1", "d1", "e1"};
+  check_rcv(4, exp);
+
+  free_ind_overloads(&o);
+}
+
+// The report rate is halved while the xApp drops, and restored once it keeps up
+static
+void test_rate(void)
+{
+  ind_overloads_t o = {0};
+  init_ind_overloads(&o, slow_xapp_send, &xapp);
+  reset_xapp(true, 2000);
+
+  global_e2_node_id_t id = gen_node_id(1);
+  add_ind_overload(&o, 10, &id, NULL, conf("policy=drop_oldest;depth=2"));
+
+  // 100 indications/s of simulated time, way faster than the xApp 
+  int64_t now = 0;
+  for(int i = 0; i < 2*OVERLOAD_PERSIST_PERIODS*100 + 1; ++i){
+    push(&o, now, 10, "", "x");
+    now += 10*1000;
+  }
+
+  ind_overload_stats_t s = {0};
+  assert(stats_ind_overload(&o, 10, &s) == true);
+  printf("Overloaded: in %lu out %lu dropped %lu thinned %lu thin %u\n", s.ind_in, s.ind_out, s.dropped, s.thinned, s.thin);
+  assert(s.dropped > 0);
+  assert(s.thin == 4);
+  assert(s.thinned > 0);
+
+  // Slow enough for the xApp
+  xapp.delay_us = 0;
+  for(int i = 0; i < (2*OVERLOAD_PERSIST_PERIODS + 1)*10 + 1; ++i){
+    while(stats_ind_overload(&o, 10, &s) == true && s.queued > 0)
+      usleep(100);
+    push(&o, now, 10, "", "x");
+    now += 100*1000;
+  }
+
+  while(stats_ind_overload(&o, 10, &s) == true && s.queued > 0)
+    usleep(100);
+  usleep(5000);
+  assert(stats_ind_overload(&o, 10, &s) == true);
+  printf("Recovered: in %lu out %lu dropped %lu thinned %lu thin %u\n", s.ind_in, s.ind_out, s.dropped, s.thinned, s.thin);
+  assert(s.thin == 1);
+  assert(s.ind_in == s.ind_out + s.dropped + s.thinned);
+
+  free_ind_overloads(&o);
+}
+
+// Queued indications are discarded when the E2 Node leaves
+static
+void test_rm_e2_node(void)
+{
+  ind_overloads_t o = {0};
+  init_ind_overloads(&o, slow_xapp_send, &xapp);
+  reset_xapp(false, 0);
+
+  global_e2_node_id_t id_1 = gen_node_id(1);
+  global_e2_node_id_t id_2 = gen_node_id(2);
+  add_ind_overload(&o, 10, &id_1, NULL, conf("depth=4"));
+  add_ind_overload(&o, 20, &id_2, NULL, conf("depth=4"));
+  add_ind_overload(&o, 30, &id_1, NULL, conf("depth=4"));
+
+  push(&o, 0, 20, "", "n2");
+  wait_entered(1);
+  push(&o, 0, 10, "", "a");
+  push(&o, 0, 30, "", "b");
+  push(&o, 0, 20, "", "c");
+
+  assert(rm_e2_node_ind_overloads(&o, &id_1) == 2);
+  assert(push(&o, 0, 10, "", "d") == false);
+
+  xapp.open = true;
+  char const* exp[] = {"n2", "c"};
+  check_rcv(2, exp);
+
+  rm_ind_overload(&o, 20);
+  assert(push(&o, 0, 20, "", "e") == false);
+
+  free_ind_overloads(&o);
+}
+
+int main()
+{
+  test_parse();
+
+  char const* oldest[] = {"0", "7", "8", "9", "10"};
+  test_drop("policy=drop_oldest;depth=4", 5, oldest);
+
+  char const* newest[] = {"0", "1", "2", "3", "4"};
+  test_drop("policy=drop_newest;depth=4", 5, newest);
+
+  test_keep_latest();
+  test_rate();
+  test_rm_e2_node();
+
+  printf("Success\n");
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,579 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+
+#include "../iApps/influx.h"
+#include "../iApps/influx_export.h"
+#include "../iApps/ind_line_proto.h"
+#include "../iApps/line_proto.h"
+#include "../../sm/rc_sm/ie/ir/ran_param_list.h"
+#include "../../sm/rc_sm/ie/ir/ran_param_struct.h"
+#include "../../util/ngran_types.h"
+
+#include <arpa/inet.h>
+#include <assert.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+static
+global_e2_node_id_t gen_node_id(uint64_t* cu_du_id)
+{
+  global_e2_node_id_t id = {.type = ngran_gNB_CU,
+                            .plmn = {.mcc = 505, .mnc = 1, .mnc_digit_len = 2},
+                            .nb_id = {.nb_id = 7, .unused = 0},
+                            .cu_du_id = cu_du_id };
+  return id;
+}
+
+static
+size_t count_lines(char const* s, size_t len)
+{
+  size_t n = 0;
+  for(size_t i = 0; i < len; ++i)
+    n += s[i] == '\n';
+  return n;
+}
+
+// Measurements, tags and string fields are escaped. Non-finite floats are
+// skipped, and a point without fields is dropped
+static
+void test_line_proto(void)
+{
+  line_proto_t lp = {0};
+  init_line_proto(&lp, INFLUX_LINE_PROTO);
+
+  begin_line_proto(&lp, "m e,a");
+  tag_line_proto(&lp, "k=y", "a b,c");
+  tag_line_proto(&lp, "empty", "");
+  int_line_proto(&lp, "i", -3);
+  float_line_proto(&lp, "nan", 0.0/0.0);
+  float_line_proto(&lp, "f", 2.5);
+  bool_line_proto(&lp, "b", true);
+  str_line_proto(&lp, "s", "a\"b\\c\nd", 7);
+  assert(end_line_proto(&lp, 42) == true);
+
+  char const* exp = "m\\ e\\,a,k\\=y=a\\ b\\,c i=-3i,f=2.5,b=true,s=\"a\\\"b\\\\c d\" 42\n";
+  assert(strcmp(lp.buf, exp) == 0);
+
+  size_t const len = lp.len;
+  begin_line_proto(&lp, "m");
+  tag_line_proto(&lp, "k", "v");
+  float_line_proto(&lp, "inf", 1.0/0.0);
+  assert(end_line_proto(&lp, 43) == false);
+  assert(lp.len == len);
+
+  free_line_proto(&lp);
+}
+
+// Same point in JSON Lines. Control characters are escaped as \u00XX
+static
+void test_json_line_proto(void)
+{
+  line_proto_t lp = {0};
+  line_proto_fmt_e fmt = END_LINE_PROTO;
+  assert(fmt_line_proto("json", &fmt) == true && fmt == JSON_LINE_PROTO);
+  assert(fmt_line_proto("csv", &fmt) == false);
+  init_line_proto(&lp, fmt);
+
+  begin_line_proto(&lp, "m e,a");
+  tag_line_proto(&lp, "k=y", "a b,c");
+  tag_line_proto(&lp, "empty", "");
+  tag_u64_line_proto(&lp, "ue", 7);
+  int_line_proto(&lp, "i", -3);
+  float_line_proto(&lp, "nan", 0.0/0.0);
+  float_line_proto(&lp, "f", 2.5);
+  bool_line_proto(&lp, "b", true);
+  str_line_proto(&lp, "s", "a\"b\\c\nd", 7);
+  assert(end_line_proto(&lp, 42) == true);
+
+  char const* exp = "{\"meas\":\"m e,a\",\"tags\":{\"k=y\":\"a b,c\",\"ue\":\"7\"},"
+                    "\"fields\":{\"i\":-3,\"f\":2.5,\"b\":true,\"s\":\"a\\\"b\\\\c\\u000ad\"},\"ts\":42}\n";
+  assert(strcmp(lp.buf, exp) == 0);
+
+  // Without tags
+  size_t const len = lp.len;
+  begin_line_proto(&lp, "m");
+  int_line_proto(&lp, "i", 1);
+  assert(end_line_proto(&lp, 43) == true);
+  assert(strcmp(lp.buf + len, "{\"meas\":\"m\",\"tags\":{},\"fields\":{\"i\":1},\"ts\":43}\n") == 0);
+
+  free_line_proto(&lp);
+}
+
+static
+void test_mac(void)
+{
+  mac_ue_stats_impl_t ue[2] = {{.rnti = 1234, .dl_aggr_tbs = 100, .pusch_snr = 20.5, .phr = -3},
+                               {.rnti = 5678, .wb_cqi = 15}};
+  sm_ag_if_rd_ind_t d = {.type = MAC_STATS_V0};
+  d.mac.msg = (mac_ind_msg_t){.len_ue_stats = 2, .ue_stats = ue, .tstamp = 1700000000000001};
+
+  uint64_t cu_du_id = 3;
+  global_e2_node_id_t id = gen_node_id(&cu_du_id);
+
+  line_proto_t lp = {0};
+  init_line_proto(&lp, INFLUX_LINE_PROTO);
+  assert(to_line_proto_ind(&id, &d, 1, &lp) == 2);
+  assert(count_lines(lp.buf, lp.len) == 2);
+
+  char const* first = "mac,node=505-1-7-3,ran=ngran_gNB_CU,ue=1234 dl_aggr_tbs=100i,";
+  assert(strncmp(lp.buf, first, strlen(first)) == 0);
+  assert(strstr(lp.buf, ",pusch_snr=20.5,") != NULL);
+  assert(strstr(lp.buf, ",phr=-3i 1700000000000001000\n") != NULL);
+  assert(strstr(lp.buf, "mac,node=505-1-7-3,ran=ngran_gNB_CU,ue=5678 ") != NULL);
+  assert(strstr(lp.buf, ",wb_cqi=15i,") != NULL);
+
+  // Unknown E2 Node and no timestamp
+  clear_line_proto(&lp);
+  d.mac.msg.tstamp = 0;
+  d.mac.msg.len_ue_stats = 1;
+  assert(to_line_proto_ind(NULL, &d, 99, &lp) == 1);
+  assert(strncmp(lp.buf, "mac,ue=1234 ", 12) == 0);
+  assert(strstr(lp.buf, " 99\n") != NULL);
+
+  free_line_proto(&lp);
+}
+
+// KPM Indication Message Format 3. One point per UE with a measurement per field
+static
+void test_kpm(void)
+{
+  char name0[] = "DRB.UEThpDl";
+  char name1[] = "RRU.PrbTotDl";
+  meas_info_format_1_lst_t info[2] = {{.meas_type = {.type = NAME_MEAS_TYPE, .name = {.len = strlen(name0), .buf = (uint8_t*)name0}}},
+                                      {.meas_type = {.type = NAME_MEAS_TYPE, .name = {.len = strlen(name1), .buf = (uint8_t*)name1}}}};
+
+  meas_record_lst_t rec[2][2] = {{{.value = REAL_MEAS_VALUE, .real_val = 12.5}, {.value = INTEGER_MEAS_VALUE, .int_val = 40}},
+                                 {{.value = REAL_MEAS_VALUE, .real_val = 0.5}, {.value = NO_VALUE_MEAS_VALUE}}};
+  meas_data_lst_t data[2] = {{.meas_record_len = 2, .meas_record_lst = rec[0]},
+                             {.meas_record_len = 2, .meas_record_lst = rec[1]}};
+
+  meas_report_per_ue_t ue[2] = {0};
+  for(size_t i = 0; i < 2; ++i){
+    ue[i].ue_meas_report_lst = (ue_id_e2sm_t){.type = GNB_UE_ID_E2SM, .gnb.amf_ue_ngap_id = 42 + i};
+    ue[i].ind_msg_format_1 = (kpm_ind_msg_format_1_t){.meas_data_lst_len = 1, .meas_data_lst = &data[i],
+                                                      .meas_info_lst_len = 2, .meas_info_lst = info};
+  }
+
+  sm_ag_if_rd_ind_t d = {.type = KPM_STATS_V3_0};
+  d.kpm.ind.hdr.type = FORMAT_1_INDICATION_HEADER;
+#if defined(KPM_V3_00)
+  d.kpm.ind.hdr.kpm_ric_ind_hdr_format_1.collectStartTime = 1700000000000000;
+#else
+  d.kpm.ind.hdr.kpm_ric_ind_hdr_format_1.collectStartTime = 1700000000;
+#endif
+  d.kpm.ind.msg.type = FORMAT_3_INDICATION_MESSAGE;
+  d.kpm.ind.msg.frm_3 = (kpm_ind_msg_format_3_t){.ue_meas_report_lst_len = 2, .meas_report_per_ue = ue};
+
+  global_e2_node_id_t id = gen_node_id(NULL);
+
+  line_proto_t lp = {0};
+  init_line_proto(&lp, INFLUX_LINE_PROTO);
+  assert(to_line_proto_ind(&id, &d, 1, &lp) == 2);
+
+  char const* exp = "kpm,node=505-1-7,ran=ngran_gNB_CU,ue=42 DRB.UEThpDl=12.5,RRU.PrbTotDl=40i 1700000000000000000\n"
+                    "kpm,node=505-1-7,ran=ngran_gNB_CU,ue=43 DRB.UEThpDl=0.5 1700000000000000000\n";
+  assert(strcmp(lp.buf, exp) == 0);
+
+  free_line_proto(&lp);
+}
+
+// Nested RAN Parameters are flattened into one field each
+static
+void test_rc(void)
+{
+  ran_parameter_value_t five = {.type = INTEGER_RAN_PARAMETER_VALUE, .int_ran = 5};
+  seq_ran_param_t leaf = {.ran_param_id = 3, .ran_param_val = {.type = ELEMENT_KEY_FLAG_FALSE_RAN_PARAMETER_VAL_TYPE, .flag_false = &five}};
+  lst_ran_param_t item = {.ran_param_struct = {.sz_ran_param_struct = 1, .ran_param_struct = &leaf}};
+  ran_param_list_t lst = {.sz_lst_ran_param = 1, .lst_ran_param = &item};
+  seq_ran_param_t in_strct = {.ran_param_id = 2, .ran_param_val = {.type = LIST_RAN_PARAMETER_VAL_TYPE, .lst = &lst}};
+  ran_param_struct_t strct = {.sz_ran_param_struct = 1, .ran_param_struct = &in_strct};
+
+  char str[] = "a b";
+  ran_parameter_value_t s = {.type = PRINTABLESTRING_RAN_PARAMETER_VALUE, .printable_str_ran = {.len = 3, .buf = (uint8_t*)str}};
+  seq_ran_param_t p[2] = {{.ran_param_id = 1, .ran_param_val = {.type = STRUCTURE_RAN_PARAMETER_VAL_TYPE, .strct = &strct}},
+                          {.ran_param_id = 4, .ran_param_val = {.type = ELEMENT_KEY_FLAG_TRUE_RAN_PARAMETER_VAL_TYPE, .flag_true = &s}}};
+
+  sm_ag_if_rd_ind_t d = {.type = RAN_CTRL_STATS_V1_03};
+  d.rc.ind.hdr.format = FORMAT_2_E2SM_RC_IND_HDR;
+  d.rc.ind.hdr.frmt_2 = (e2sm_rc_ind_hdr_frmt_2_t){.ue_id = {.type = GNB_UE_ID_E2SM, .gnb.amf_ue_ngap_id = 9}, .ric_style_type = 2, .ins_ind_id = 1};
+  d.rc.ind.msg.format = FORMAT_1_E2SM_RC_IND_MSG;
+  d.rc.ind.msg.frmt_1 = (e2sm_rc_ind_msg_frmt_1_t){.sz_seq_ran_param = 2, .seq_ran_param = p};
+
+  line_proto_t lp = {0};
+  init_line_proto(&lp, INFLUX_LINE_PROTO);
+  assert(to_line_proto_ind(NULL, &d, 77, &lp) == 1);
+
+  char const* exp = "rc,ue=9 ric_style_type=2i,ins_ind_id=1i,p1.2[0].3=5i,p4=\"a b\" 77\n";
+  assert(strcmp(lp.buf, exp) == 0);
+
+  // Cells are tagged
+  seq_cell_info_t cell = {.cell_global_id = {.type = NR_CGI_RAT_TYPE, .nr_cgi = {.plmn_id = {.mcc = 208, .mnc = 95}, .nr_cell_id = 12345}}};
+  d.rc.ind.hdr.format = FORMAT_1_E2SM_RC_IND_HDR;
+  d.rc.ind.hdr.frmt_1 = (e2sm_rc_ind_hdr_frmt_1_t){0};
+  d.rc.ind.msg.format = FORMAT_3_E2SM_RC_IND_MSG;
+  d.rc.ind.msg.frmt_3 = (e2sm_rc_ind_msg_frmt_3_t){.sz_seq_cell_info = 1, .seq_cell_info = &cell};
+
+  clear_line_proto(&lp);
+  assert(to_line_proto_ind(NULL, &d, 78, &lp) == 1);
+  assert(strncmp(lp.buf, "rc,cell=208-95-12345 ", 21) == 0);
+
+  free_line_proto(&lp);
+}
+
+static
+int bind_local(int type, uint16_t* port)
+{
+  int const fd = socket(AF_INET, type, 0);
+  assert(fd > -1);
+
+  struct sockaddr_in addr = {.sin_family = AF_INET, .sin_addr.s_addr = htonl(INADDR_LOOPBACK)};
+  int rc = bind(fd, (struct sockaddr*)&addr, sizeof(addr));
+  assert(rc == 0);
+
+  socklen_t len = sizeof(addr);
+  rc = getsockname(fd, (struct sockaddr*)&addr, &len);
+  assert(rc == 0);
+  *port = ntohs(addr.sin_port);
+  return fd;
+}
+
+// Point i, 40 bytes or so
+static
+size_t gen_point(size_t i, char* dst, size_t len)
+{
+  int const rc = snprintf(dst, len, "test,ue=%zu value=%zui %zu\n", i % 16, i, 1000 + i);
+  assert(rc > 0 && rc < (int)len);
+  return rc;
+}
+
+static
+void push_points(influx_export_t* e, size_t from, size_t num)
+{
+  for(size_t i = from; i < from + num; ++i){
+    char p[64] = {0};
+    size_t const len = gen_point(i, p, sizeof(p));
+    push_influx_export(e, p, len);
+  }
+}
+
+// Marks the points received. Returns the number of new ones
+static
+size_t mark_points(char const* buf, size_t len, bool* seen, size_t num)
+{
+  size_t cnt = 0;
+  char const* it = buf;
+  while(it < buf + len){
+    char const* nl = memchr(it, '\n', buf + len - it);
+    assert(nl != NULL && "Partial point");
+
+    size_t ue = 0, val = 0, ts = 0;
+    int const rc = sscanf(it, "test,ue=%zu value=%zui %zu", &ue, &val, &ts);
+    assert(rc == 3 && val < num && ts == 1000 + val);
+    cnt += seen[val] == false;
+    seen[val] = true;
+    it = nl + 1;
+  }
+  return cnt;
+}
+
+// Every datagram holds whole points and fits a batch
+static
+void test_udp_batches(void)
+{
+  uint16_t port = 0;
+  int const fd = bind_local(SOCK_DGRAM, &port);
+
+  char sink[64] = {0};
+  snprintf(sink, sizeof(sink), "udp://127.0.0.1:%u", port);
+
+  influx_export_t e = {0};
+  init_influx_export(&e, sink, "size=512;ms=20", NULL);
+
+  size_t const num = 1000;
+  push_points(&e, 0, num);
+  flush_influx_export(&e);
+
+  bool seen[1000] = {0};
+  size_t recv_points = 0;
+  size_t datagrams = 0;
+  while(recv_points < num){
+    struct pollfd pfd = {.fd = fd, .events = POLLIN};
+    int const rc = poll(&pfd, 1, 1000);
+    assert(rc == 1 && "Datagrams lost");
+
+    char buf[2048] = {0};
+    ssize_t const len = recv(fd, buf, sizeof(buf), 0);
+    // The empty probe of the exporter
+    if(len == 0)
+      continue;
+    assert(len > 0 && len <= 512);
+    recv_points += mark_points(buf, len, seen, num);
+    datagrams += 1;
+  }
+  // Batches are filled
+  assert(datagrams < num*45/512 + 2);
+
+  influx_export_stats_t const s = stats_influx_export(&e);
+  assert(s.points == num);
+  assert(s.dropped == 0 && s.spooled == 0);
+  assert(s.reachable == true);
+
+  free_influx_export(&e);
+  close(fd);
+}
+
+static
+void read_all_tcp(int lfd, bool* seen, size_t num)
+{
+  int const fd = accept(lfd, NULL, NULL);
+  assert(fd > -1);
+
+  size_t recv_points = 0;
+  char buf[8192] = {0};
+  size_t len = 0;
+  while(recv_points < num){
+    struct pollfd pfd = {.fd = fd, .events = POLLIN};
+    int const rc = poll(&pfd, 1, 5000);
+    assert(rc == 1 && "Points not replayed");
+
+    ssize_t const n = recv(fd, buf + len, sizeof(buf) - len, 0);
+    assert(n > 0);
+    len += n;
+
+    // Whole points only. The rest waits for the next read
+    size_t end = len;
+    while(end > 0 && buf[end - 1] != '\n')
+      end -= 1;
+    recv_points += mark_points(buf, end, seen, num);
+    memmove(buf, buf + end, len - end);
+    len -= end;
+  }
+  close(fd);
+}
+
+// The points pushed while nobody listens are spooled, and replayed in
+// order once the sink is back
+static
+void test_tcp_spool_replay(void)
+{
+  uint16_t port = 0;
+  // Bound but not listening, i.e., connections are refused
+  int const lfd = bind_local(SOCK_STREAM, &port);
+
+  char spool[] = "/tmp/test_influx_XXXXXX";
+  int const sfd = mkstemp(spool);
+  assert(sfd > -1);
+  close(sfd);
+
+  char sink[64] = {0};
+  snprintf(sink, sizeof(sink), "tcp://127.0.0.1:%u", port);
+
+  influx_export_t e = {0};
+  init_influx_export(&e, sink, "size=1400;ms=10;retry=20", spool);
+
+  size_t const num = 500;
+  push_points(&e, 0, num/2);
+  flush_influx_export(&e);
+
+  influx_export_stats_t s = stats_influx_export(&e);
+  assert(s.reachable == false);
+  assert(s.spooled > 0 && s.spool_len == s.spooled);
+  assert(s.dropped == 0);
+
+  int rc = listen(lfd, 1);
+  assert(rc == 0);
+  push_points(&e, num/2, num/2);
+
+  bool seen[500] = {0};
+  read_all_tcp(lfd, seen, num);
+  for(size_t i = 0; i < num; ++i)
+    assert(seen[i] == true);
+
+  flush_influx_export(&e);
+  s = stats_influx_export(&e);
+  assert(s.reachable == true);
+  assert(s.replayed == s.spooled);
+  assert(s.spool_len == 0);
+
+  free_influx_export(&e);
+  close(lfd);
+  unlink(spool);
+}
+
+// A full spool drops the new points. The spool survives a restart
+static
+void test_spool_bound(void)
+{
+  uint16_t port = 0;
+  int fd = bind_local(SOCK_DGRAM, &port);
+  // Nobody listens. The ICMP error tells the exporter
+  close(fd);
+
+  char spool[] = "/tmp/test_influx_XXXXXX";
+  int const sfd = mkstemp(spool);
+  assert(sfd > -1);
+  close(sfd);
+
+  char sink[64] = {0};
+  snprintf(sink, sizeof(sink), "udp://127.0.0.1:%u", port);
+
+  influx_export_t e = {0};
+  init_influx_export(&e, sink, "size=256;ms=10;spool=1K;retry=60000", spool);
+
+  size_t const num = 200;
+  push_points(&e, 0, num);
+  flush_influx_export(&e);
+
+  influx_export_stats_t const s = stats_influx_export(&e);
+  assert(s.reachable == false);
+  assert(s.spool_len <= 1024 && s.spool_len > 0);
+  assert(s.dropped > 0);
+  free_influx_export(&e);
+
+  FILE* f = fopen(spool, "r");
+  assert(f != NULL);
+  char buf[2048] = {0};
+  size_t const len = fread(buf, 1, sizeof(buf), f);
+  fclose(f);
+  assert(len == s.spool_len);
+  size_t const spooled = count_lines(buf, len);
+  assert(spooled + s.dropped == num);
+
+  // Restart with the sink up. The spooled points are replayed
+  fd = bind_local(SOCK_DGRAM, &port);
+  snprintf(sink, sizeof(sink), "udp://127.0.0.1:%u", port);
+  init_influx_export(&e, sink, "size=256;ms=10", spool);
+
+  bool seen[200] = {0};
+  size_t recv_points = 0;
+  while(recv_points < spooled){
+    struct pollfd pfd = {.fd = fd, .events = POLLIN};
+    int const rc = poll(&pfd, 1, 1000);
+    assert(rc == 1 && "Spool not replayed");
+
+    char dgram[512] = {0};
+    ssize_t const n = recv(fd, dgram, sizeof(dgram), 0);
+    assert(n >= 0);
+    recv_points += mark_points(dgram, n, seen, num);
+  }
+
+  free_influx_export(&e);
+  close(fd);
+  unlink(spool);
+}
+
+// Stopping in the middle of a replay keeps only the points not sent yet, 
+// i.e., the next run does not send the replayed ones again
+static
+void test_spool_compact(void)
+{
+  char spool[] = "/tmp/test_influx_XXXXXX";
+  int const sfd = mkstemp(spool);
+  assert(sfd > -1);
+
+  size_t const num = 20000;
+  for(size_t i = 0; i < num; ++i){
+    char p[64] = {0};
+    size_t const len = gen_point(i, p, sizeof(p));
+    ssize_t const n = write(sfd, p, len);
+    assert(n == (ssize_t)len);
+  }
+  close(sfd);
+
+  uint16_t port = 0;
+  int const fd = bind_local(SOCK_DGRAM, &port);
+  char sink[64] = {0};
+  snprintf(sink, sizeof(sink), "udp://127.0.0.1:%u", port);
+
+  influx_export_t e = {0};
+  init_influx_export(&e, sink, "size=256;ms=10", spool);
+
+  // Stop once the replay started 
+  bool* seen = calloc(num, sizeof(bool));
+  assert(seen != NULL);
+  size_t recv_points = 0;
+  while(recv_points == 0){
+    struct pollfd pfd = {.fd = fd, .events = POLLIN};
+    int const rc = poll(&pfd, 1, 1000);
+    assert(rc == 1 && "Spool not replayed");
+
+    char dgram[512] = {0};
+    ssize_t const n = recv(fd, dgram, sizeof(dgram), 0);
+    assert(n >= 0);
+    recv_points += mark_points(dgram, n, seen, num);
+  }
+  free_influx_export(&e);
+
+  // Drain the datagrams sent before the stop 
+  while(true){
+    char dgram[512] = {0};
+    ssize_t const n = recv(fd, dgram, sizeof(dgram), MSG_DONTWAIT);
+    if(n < 0)
+      break;
+    mark_points(dgram, n, seen, num);
+  }
+
+  // Whole points, from the first one not replayed up to the last one
+  FILE* f = fopen(spool, "r");
+  assert(f != NULL);
+  char line[64] = {0};
+  size_t first = num;
+  size_t next = num;
+  while(fgets(line, sizeof(line), f) != NULL){
+    size_t ue = 0, val = 0, ts = 0;
+    int const rc = sscanf(line, "test,ue=%zu value=%zui %zu", &ue, &val, &ts);
+    assert(rc == 3 && ts == 1000 + val);
+    if(first == num)
+      first = next = val;
+    assert(val == next);
+    assert(seen[val] == false && "Replayed point kept");
+    next += 1;
+  }
+  fclose(f);
+  assert(first == num || next == num);
+  assert(first > 0 && "Replayed prefix kept");
+
+  free(seen);
+  close(fd);
+  unlink(spool);
+}
+
+int main()
+{
+  test_line_proto();
+  test_json_line_proto();
+  test_mac();
+  test_kpm();
+  test_rc();
+  test_udp_batches();
+  test_tcp_spool_replay();
+  test_spool_bound();
+  test_spool_compact();
+
+  printf("[INFLUX]: Test passed\n");
+  return EXIT_SUCCESS;
+}
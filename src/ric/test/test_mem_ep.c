@@ -0,0 +1,240 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+#include "../../lib/ep/mem_ep.h"
+
+#include <arpa/inet.h>
+#include <assert.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NUM_CLIENTS 4
+#define NUM_MSG 1000
+
+static
+byte_array_t init_payload(uint32_t v)
+{
+  byte_array_t ba = {.len = sizeof(v)};
+  ba.buf = malloc(ba.len);
+  assert(ba.buf != NULL);
+  memcpy(ba.buf, &v, sizeof(v));
+  return ba;
+}
+
+static
+uint32_t payload(byte_array_t ba)
+{
+  assert(ba.len == sizeof(uint32_t));
+  uint32_t v = 0;
+  memcpy(&v, ba.buf, sizeof(v));
+  return v;
+}
+
+static
+bool readable(mem_ep_t const* ep)
+{
+  struct pollfd pfd = {.fd = fd_mem_ep(ep), .events = POLLIN};
+  return poll(&pfd, 1, 0) == 1;
+}
+
+static
+void test_assoc(void)
+{
+  init_mem_ep();
+  assert(enabled_mem_ep() == true);
+
+  mem_ep_t* lis = listen_mem_ep("127.0.0.1", 36421);
+  assert(lis != NULL);
+  assert(listen_mem_ep("127.0.0.1", 36421) == NULL);
+
+  mem_ep_t* cli = connect_mem_ep("127.0.0.1", 36421);
+  // Another port, i.e., no association
+  mem_ep_t* lost = connect_mem_ep("127.0.0.1", 36422);
+  byte_array_t ba = init_payload(0);
+  assert(send_mem_ep(lost, NULL, 0, 0, ba) == false);
+  close_mem_ep(lost);
+  assert(in_flight_mem_ep() == 0);
+
+  // Set up with the first message
+  assert(readable(lis) == false);
+  assert(send_mem_ep(cli, NULL, 0, 7, ba) == true);
+  assert(in_flight_mem_ep() == 1);
+  assert(readable(lis) == true);
+
+  mem_ep_msg_t msg = recv_mem_ep(lis);
+  struct sockaddr_in const cli_addr = addr_mem_ep(cli);
+  assert(msg.eof == false && msg.ppid == 7 && msg.assoc_id > 0);
+  assert(msg.peer.sin_port == cli_addr.sin_port);
+  assert(payload(msg.ba) == 0);
+  assert(readable(lis) == false && in_flight_mem_ep() == 0);
+  free_mem_ep_msg(&msg);
+
+  // Reply through the association
+  assert(send_mem_ep(lis, &msg.peer, 1, 0, ba) == true);
+  mem_ep_msg_t rep = recv_mem_ep(cli);
+  assert(rep.eof == false && rep.stream == 1 && rep.assoc_id == msg.assoc_id);
+  assert(rep.peer.sin_port == htons(36421));
+  free_mem_ep_msg(&rep);
+
+  // Closed association
+  shutdown_mem_ep(lis, &msg.peer);
+  mem_ep_msg_t eof = recv_mem_ep(cli);
+  assert(eof.eof == true && eof.assoc_id == msg.assoc_id);
+  free_mem_ep_msg(&eof);
+  assert(send_mem_ep(lis, &msg.peer, 0, 0, ba) == false);
+
+  // A new one with the next message
+  assert(send_mem_ep(cli, NULL, 0, 0, ba) == true);
+  msg = recv_mem_ep(lis);
+  assert(msg.assoc_id > rep.assoc_id);
+  free_mem_ep_msg(&msg);
+
+  // The listener learns the closed endpoint
+  close_mem_ep(cli);
+  eof = recv_mem_ep(lis);
+  assert(eof.eof == true && eof.peer.sin_port == cli_addr.sin_port);
+  free_mem_ep_msg(&eof);
+
+  free_byte_array(ba);
+  close_mem_ep(lis);
+  free_mem_ep();
+  assert(enabled_mem_ep() == false);
+}
+
+typedef struct{
+  mem_ep_t* ep;
+  uint32_t id;
+} client_t;
+
+static
+void* client_thread(void* arg)
+{
+  client_t* c = arg;
+  for(uint32_t i = 0; i < NUM_MSG; ++i){
+    byte_array_t ba = init_payload(c->id * NUM_MSG + i);
+    bool const sent = send_mem_ep(c->ep, NULL, 0, 0, ba);
+    assert(sent == true);
+    free_byte_array(ba);
+
+    // Echo from the server
+    mem_ep_msg_t msg = recv_mem_ep(c->ep);
+    assert(msg.eof == false && payload(msg.ba) == c->id * NUM_MSG + i);
+    free_mem_ep_msg(&msg);
+  }
+  return NULL;
+}
+
+static
+void* server_thread(void* arg)
+{
+  mem_ep_t* lis = arg;
+  uint32_t next[NUM_CLIENTS] = {0};
+  for(size_t i = 0; i < NUM_CLIENTS * NUM_MSG; ++i){
+    mem_ep_msg_t msg = recv_mem_ep(lis);
+    assert(msg.eof == false);
+
+    // In order within an association
+    uint32_t const v = payload(msg.ba);
+    assert(v % NUM_MSG == next[v / NUM_MSG]);
+    next[v / NUM_MSG] += 1;
+
+    bool const sent = send_mem_ep(lis, &msg.peer, 0, 0, msg.ba);
+    assert(sent == true);
+    free_mem_ep_msg(&msg);
+  }
+  return NULL;
+}
+
+static
+bool idle(void* arg)
+{
+  size_t const* done = arg;
+  return *done == 1 && in_flight_mem_ep() == 0;
+}
+
+static
+bool never(void* arg)
+{
+  (void)arg;
+  return false;
+}
+
+static
+void test_threads(void)
+{
+  init_mem_ep();
+  // Shared
+  init_mem_ep();
+
+  mem_ep_t* lis = listen_mem_ep("0.0.0.0", 36421);
+  assert(lis != NULL);
+
+  client_t c[NUM_CLIENTS] = {0};
+  pthread_t t[NUM_CLIENTS];
+  for(uint32_t i = 0; i < NUM_CLIENTS; ++i){
+    c[i].ep = connect_mem_ep("127.0.0.1", 36421);
+    c[i].id = i;
+    int const rc = pthread_create(&t[i], NULL, client_thread, &c[i]);
+    assert(rc == 0);
+  }
+
+  pthread_t srv;
+  int rc = pthread_create(&srv, NULL, server_thread, lis);
+  assert(rc == 0);
+
+  for(uint32_t i = 0; i < NUM_CLIENTS; ++i){
+    rc = pthread_join(t[i], NULL);
+    assert(rc == 0);
+  }
+  rc = pthread_join(srv, NULL);
+  assert(rc == 0);
+
+  size_t done = 1;
+  assert(wait_mem_ep(idle, &done, 1000) == true);
+  assert(wait_mem_ep(never, NULL, 10) == false);
+
+  for(uint32_t i = 0; i < NUM_CLIENTS; ++i)
+    close_mem_ep(c[i].ep);
+
+  // The eofs of the clients
+  assert(in_flight_mem_ep() == NUM_CLIENTS);
+  close_mem_ep(lis);
+  assert(in_flight_mem_ep() == 0);
+
+  free_mem_ep();
+  assert(enabled_mem_ep() == true);
+  free_mem_ep();
+  assert(enabled_mem_ep() == false);
+}
+
+int main()
+{
+  assert(enabled_mem_ep() == false);
+
+  test_assoc();
+  test_threads();
+
+  printf("Success\n");
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,225 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+
+
+#include "../repl_state.h"
+#include "../../util/ngran_types.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static
+global_e2_node_id_t gen_node_id(uint32_t nb_id)
+{
+  global_e2_node_id_t id = {.type = ngran_gNB,
+                            .plmn = {.mcc = 505, .mnc = 1, .mnc_digit_len = 2},
+                            .nb_id = {.nb_id = nb_id, .unused = 0} };
+  return id;
+}
+
+static
+repl_rec_t gen_sub(uint32_t nb_id, uint32_t ric_req_id, uint16_t xapp_id)
+{
+  repl_rec_t r = {.type = SUB_ADD_REPL_REC, 
+                  .node = gen_node_id(nb_id),
+                  .node_ric_id = {.ric_req_id = ric_req_id, .ran_func_id = 2},
+                  .xapp = {.ric_id = {.ric_req_id = 1000 + ric_req_id, .ran_func_id = 2}, .xapp_id = xapp_id}};
+  return r;
+}
+
+static
+void round_trip(repl_rec_t const* r)
+{
+  byte_array_t ba = enc_repl_rec(r);
+
+  repl_rec_t dst = {0};
+  assert(dec_repl_rec(ba, &dst) == true);
+  assert(dst.type == r->type);
+  assert(eq_global_e2_node_id(&dst.node, &r->node) == true);
+  assert(eq_byte_array(&dst.ba, &r->ba) == true);
+  assert(memcmp(&dst.node_ric_id, &r->node_ric_id, sizeof(ric_gen_id_t)) == 0);
+  assert(memcmp(&dst.xapp, &r->xapp, sizeof(xapp_ric_id_t)) == 0);
+  assert(dst.xapp_id == r->xapp_id);
+  assert(dst.next_xapp_id == r->next_xapp_id);
+  free_repl_rec(&dst);
+
+  // Truncated
+  for(size_t i = 0; i < ba.len; ++i){
+    byte_array_t tr = {.len = i, .buf = ba.buf};
+    assert(dec_repl_rec(tr, &dst) == false);
+  }
+
+  // Other version
+  ba.buf[0] += 1;
+  assert(dec_repl_rec(ba, &dst) == false);
+
+  free_byte_array(ba);
+}
+
+static
+void test_codec(void)
+{
+  uint64_t cu_du_id = 3584;
+  uint8_t setup[] = {0x00, 0x01, 0x02, 0x03, 0xff};
+  uint8_t token[] = {'x', 'a', 'p', 'p'};
+
+  repl_rec_t r = {.type = HELLO_REPL_REC, .ba = {.len = sizeof(token), .buf = token}};
+  round_trip(&r);
+  r = (repl_rec_t){.type = HEARTBEAT_REPL_REC};
+  round_trip(&r);
+
+  r = (repl_rec_t){.type = NODE_ADD_REPL_REC, .node = gen_node_id(1), .ba = {.len = sizeof(setup), .buf = setup}};
+  round_trip(&r);
+  r.node.type = ngran_gNB_DU;
+  r.node.cu_du_id = &cu_du_id;
+  round_trip(&r);
+
+  r = (repl_rec_t){.type = NODE_RM_REPL_REC, .node = gen_node_id(2)};
+  round_trip(&r);
+
+  r = gen_sub(3, 4, 7);
+  round_trip(&r);
+
+  r = (repl_rec_t){.type = SUB_RM_REPL_REC, .node_ric_id.ric_req_id = 4};
+  round_trip(&r);
+
+  r = (repl_rec_t){.type = XAPP_ADD_REPL_REC, .xapp_id = 7, .next_xapp_id = 8, .ba = {.len = sizeof(token), .buf = token}};
+  round_trip(&r);
+
+  r = (repl_rec_t){.type = XAPP_RM_REPL_REC, .xapp_id = 7};
+  round_trip(&r);
+
+  // An E2 Node without E2 Setup Request can not be restored
+  r = (repl_rec_t){.type = NODE_ADD_REPL_REC, .node = gen_node_id(1)};
+  byte_array_t ba = enc_repl_rec(&r);
+  repl_rec_t dst = {0};
+  assert(dec_repl_rec(ba, &dst) == false);
+  free_byte_array(ba);
+
+  // Trailing bytes
+  r = (repl_rec_t){.type = XAPP_RM_REPL_REC, .xapp_id = 7};
+  ba = enc_repl_rec(&r);
+  uint8_t longer[64] = {0};
+  assert(ba.len < sizeof(longer));
+  memcpy(longer, ba.buf, ba.len);
+  assert(dec_repl_rec((byte_array_t){.len = ba.len + 1, .buf = longer}, &dst) == false);
+  free_byte_array(ba);
+}
+
+static
+void apply(repl_state_t* s, repl_rec_t const* r)
+{
+  // Through the wire, as the standby sees it
+  byte_array_t ba = enc_repl_rec(r);
+  repl_rec_t dst = {0};
+  assert(dec_repl_rec(ba, &dst) == true);
+  apply_repl_state(s, &dst);
+  free_repl_rec(&dst);
+  free_byte_array(ba);
+}
+
+static
+void test_snapshot_and_prune(void)
+{
+  uint8_t setup[] = {0x20, 0x00};
+  uint8_t token[] = {'k', 'p', 'm'};
+
+  repl_state_t primary = {0};
+  init_repl_state(&primary);
+
+  for(uint32_t i = 0; i < 3; ++i){
+    repl_rec_t n = {.type = NODE_ADD_REPL_REC, .node = gen_node_id(i), .ba = {.len = sizeof(setup), .buf = setup}};
+    apply(&primary, &n);
+  }
+  // The E2 Node 0 set up again
+  repl_rec_t n = {.type = NODE_ADD_REPL_REC, .node = gen_node_id(0), .ba = {.len = sizeof(setup), .buf = setup}};
+  apply(&primary, &n);
+  assert(seq_size(&primary.nodes) == 3);
+
+  // xApp 7 with session, xApp 8 without
+  repl_rec_t x = {.type = XAPP_ADD_REPL_REC, .xapp_id = 7, .next_xapp_id = 8, .ba = {.len = sizeof(token), .buf = token}};
+  apply(&primary, &x);
+  x = (repl_rec_t){.type = XAPP_ADD_REPL_REC, .xapp_id = 8, .next_xapp_id = 9};
+  apply(&primary, &x);
+  assert(seq_size(&primary.xapps) == 1);
+  assert(primary.next_xapp_id == 9);
+  assert(session_repl_state(&primary, 7) == true);
+  assert(session_repl_state(&primary, 8) == false);
+
+  for(uint32_t i = 0; i < 3; ++i){
+    repl_rec_t sub = gen_sub(i, 10 + i, 7);
+    apply(&primary, &sub);
+    sub = gen_sub(i, 20 + i, 8);
+    apply(&primary, &sub);
+  }
+  repl_rec_t rm = {.type = SUB_RM_REPL_REC, .node_ric_id.ric_req_id = 21};
+  apply(&primary, &rm);
+  assert(seq_size(&primary.subs) == 5);
+
+  // The standby attaches late
+  repl_state_t standby = {0};
+  init_repl_state(&standby);
+  repl_rec_t old = gen_sub(9, 99, 7);
+  apply(&standby, &old);
+
+  seq_arr_t snap = snapshot_repl_state(&primary);
+  for(void* it = seq_front(&snap); it != seq_end(&snap); it = seq_next(&snap, it)){
+    repl_rec_t dst = {0};
+    assert(dec_repl_rec(*(byte_array_t*)it, &dst) == true);
+    apply_repl_state(&standby, &dst);
+    free_repl_rec(&dst);
+  }
+  free_snapshot_repl_state(&snap);
+
+  assert(seq_size(&standby.nodes) == 3);
+  assert(seq_size(&standby.subs) == 5);
+  assert(seq_size(&standby.xapps) == 1);
+  assert(standby.next_xapp_id == 9);
+
+  // Deltas after the snapshot
+  repl_rec_t lost = {.type = NODE_RM_REPL_REC, .node = gen_node_id(1)};
+  apply(&standby, &lost);
+  assert(seq_size(&standby.nodes) == 2);
+
+  // Only xApp 7 at the E2 Nodes 0 and 2 is restored
+  prune_repl_state(&standby);
+  assert(seq_size(&standby.subs) == 2);
+  for(size_t i = 0; i < seq_size(&standby.subs); ++i){
+    map_ric_id_entry_t const* e = seq_at(&standby.subs, i);
+    assert(e->xapp.xapp_id == 7);
+    assert(e->node.ric_id.ric_req_id == 10 || e->node.ric_id.ric_req_id == 12);
+  }
+
+  free_repl_state(&standby);
+  free_repl_state(&primary);
+}
+
+int main()
+{
+  test_codec();
+  test_snapshot_and_prune();
+
+  printf("Success\n");
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,220 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+
+#include "../ric_req_id_alloc.h"
+#include "../sub_node_ric.h"
+#include "../../util/ngran_types.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+static
+global_e2_node_id_t gen_node_id(uint32_t nb_id)
+{
+  global_e2_node_id_t id = {.type = ngran_gNB,
+                            .plmn = {.mcc = 505, .mnc = 1, .mnc_digit_len = 2},
+                            .nb_id = {.nb_id = nb_id, .unused = 0} };
+  return id;
+}
+
+// A 100 Hz per-UE control loop allocates and releases one ID per control.
+// Meanwhile, long-lived subscriptions keep their IDs. Wrap around several
+// times and check that no live ID is ever handed out twice
+static
+void test_wraparound_stress(void)
+{
+  ric_req_id_alloc_t a = {0};
+  init_ric_req_id_alloc(&a);
+
+  global_e2_node_id_t n0 = gen_node_id(1);
+  global_e2_node_id_t n1 = gen_node_id(2);
+
+  uint32_t subs[64] = {0};
+  for(size_t i = 0; i < 64; ++i){
+    subs[i] = alloc_ric_req_id(&a, i % 2 ? &n0 : &n1, 2);
+    assert(subs[i] > 0 && subs[i] <= RIC_REQ_ID_MAX);
+  }
+
+  size_t const num_ctrl = 8*RIC_REQ_ID_MAX; 
+  for(size_t i = 0; i < num_ctrl; ++i){
+    uint32_t const id = alloc_ric_req_id(&a, &n0, 3);
+    assert(id > 0 && id <= RIC_REQ_ID_MAX);
+    for(size_t j = 0; j < 64; ++j)
+      assert(id != subs[j] && "Live subscription ID reused");
+
+    assert(live_ric_req_id(&a, id) == true);
+    release_ric_req_id(&a, id);
+    assert(live_ric_req_id(&a, id) == false);
+  }
+
+  assert(num_live_ric_req_id(&a) == 64);
+  assert(num_live_ns_ric_req_id(&a, &n0, 2) == 32);
+  assert(num_live_ns_ric_req_id(&a, &n1, 2) == 32);
+  assert(num_live_ns_ric_req_id(&a, &n0, 3) == 0);
+
+  free_ric_req_id_alloc(&a);
+}
+
+// Fill the whole ID space, check that no ID is handed out, release one 
+// ID and check that it is recycled
+static
+void test_exhaustion_recycle(void)
+{
+  ric_req_id_alloc_t a = {0};
+  init_ric_req_id_alloc(&a);
+
+  global_e2_node_id_t n0 = gen_node_id(1);
+
+  for(size_t i = 0; i < RIC_REQ_ID_MAX; ++i){
+    uint32_t const id = alloc_ric_req_id(&a, &n0, 2);
+    assert(id > 0 && id <= RIC_REQ_ID_MAX);
+  }
+  assert(num_live_ric_req_id(&a) == RIC_REQ_ID_MAX);
+
+  // Full. The caller answers with a failure
+  assert(alloc_ric_req_id(&a, &n0, 2) == RIC_REQ_ID_NONE);
+  assert(num_live_ric_req_id(&a) == RIC_REQ_ID_MAX);
+
+  release_ric_req_id(&a, 4242);
+  // Double release is harmless
+  release_ric_req_id(&a, 4242);
+  assert(num_live_ric_req_id(&a) == RIC_REQ_ID_MAX - 1);
+
+  uint32_t const id = alloc_ric_req_id(&a, &n0, 2);
+  assert(id == 4242);
+
+  free_ric_req_id_alloc(&a);
+}
+
+// IDs of a lost E2 Node are released while other nodes keep theirs 
+static
+void test_release_node(void)
+{
+  ric_req_id_alloc_t a = {0};
+  init_ric_req_id_alloc(&a);
+
+  global_e2_node_id_t n0 = gen_node_id(1);
+  global_e2_node_id_t n1 = gen_node_id(2);
+
+  uint32_t ids_n1[128] = {0};
+  for(size_t i = 0; i < 128; ++i){
+    alloc_ric_req_id(&a, &n0, 142);
+    ids_n1[i] = alloc_ric_req_id(&a, &n1, 142);
+  }
+
+  size_t const rel = release_node_ric_req_id(&a, &n0);
+  assert(rel == 128);
+  assert(num_live_ric_req_id(&a) == 128);
+  for(size_t i = 0; i < 128; ++i)
+    assert(live_ric_req_id(&a, ids_n1[i]) == true);
+
+  global_e2_node_id_t node = {0};
+  assert(node_ric_req_id(&a, ids_n1[7], &node) == true);
+  assert(eq_global_e2_node_id(&node, &n1) == true);
+  free_global_e2_node_id(&node);
+  assert(node_ric_req_id(&a, ids_n1[7] - 1, &node) == false);
+
+  free_ric_req_id_alloc(&a);
+}
+
+// IDs restored from a replica are never handed out again, and are released
+// as the allocated ones 
+static
+void test_take(void)
+{
+  ric_req_id_alloc_t a = {0};
+  init_ric_req_id_alloc(&a);
+
+  global_e2_node_id_t n0 = gen_node_id(1);
+
+  assert(take_ric_req_id(&a, 1021, &n0, 142) == true);
+  assert(take_ric_req_id(&a, 1023, &n0, 142) == true);
+  assert(take_ric_req_id(&a, 1023, &n0, 142) == false);
+  assert(num_live_ric_req_id(&a) == 2);
+  assert(num_live_ns_ric_req_id(&a, &n0, 142) == 2);
+
+  assert(alloc_ric_req_id(&a, &n0, 2) == 1022);
+  assert(alloc_ric_req_id(&a, &n0, 2) == 1024);
+
+  release_ric_req_id(&a, 1023);
+  assert(live_ric_req_id(&a, 1023) == false);
+  assert(release_node_ric_req_id(&a, &n0) == 3);
+  assert(num_live_ric_req_id(&a) == 0);
+
+  free_ric_req_id_alloc(&a);
+}
+
+// The E2 Node cached per subscription outlives neither the subscription
+// nor the E2 Node, and its copy does not allocate
+static
+void test_sub_node(void)
+{
+  sub_node_ric_t s = {0};
+  init_sub_node_ric(&s);
+
+  global_e2_node_id_t n0 = gen_node_id(1);
+  global_e2_node_id_t n1 = gen_node_id(2);
+  uint64_t du_id = 42;
+  n1.cu_du_id = &du_id;
+
+  add_sub_node_ric(&s, 1021, &n0);
+  add_sub_node_ric(&s, 1022, &n1);
+  add_sub_node_ric(&s, RIC_REQ_ID_MAX, &n0);
+
+  sub_node_t node = {0};
+  assert(find_sub_node_ric(&s, 1021, &node) == true);
+  assert(eq_global_e2_node_id(&node.id, &n0) == true);
+  assert(find_sub_node_ric(&s, 1022, &node) == true);
+  assert(eq_global_e2_node_id(&node.id, &n1) == true);
+  assert(node.id.cu_du_id == &node.cu_du_id && node.cu_du_id == 42);
+  assert(find_sub_node_ric(&s, 1023, &node) == false);
+  assert(find_sub_node_ric(&s, 0, &node) == false);
+  assert(find_sub_node_ric(&s, RIC_REQ_ID_MAX + 1, &node) == false);
+
+  // A recycled ID takes the E2 Node of its new subscription
+  add_sub_node_ric(&s, 1021, &n1);
+  assert(find_sub_node_ric(&s, 1021, &node) == true);
+  assert(eq_global_e2_node_id(&node.id, &n1) == true);
+
+  rm_sub_node_ric(&s, 1022);
+  rm_sub_node_ric(&s, 1022);
+  assert(find_sub_node_ric(&s, 1022, &node) == false);
+
+  assert(rm_node_sub_node_ric(&s, &n0) == 1);
+  assert(find_sub_node_ric(&s, RIC_REQ_ID_MAX, &node) == false);
+  assert(find_sub_node_ric(&s, 1021, &node) == true);
+
+  free_sub_node_ric(&s);
+}
+
+int main()
+{
+  test_wraparound_stress();
+  test_exhaustion_recycle();
+  test_release_node();
+  test_take();
+  test_sub_node();
+
+  printf("[RIC REQ ID ALLOC]: Test passed\n");
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,438 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+
+#include "../iApps/ind_line_proto.h"
+#include "../iApps/line_proto.h"
+#include "../iApps/stdout.h"
+#include "../iApps/telemetry_file.h"
+
+#include <assert.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef TELEMETRY_GZIP
+#include <zlib.h>
+#endif
+
+static
+char dir[] = "/tmp/test_telemetry_XXXXXX";
+
+static
+void gen_path(char const* name, char* dst, size_t len)
+{
+  int const rc = snprintf(dst, len, "%s/%s", dir, name);
+  assert(rc > 0 && rc < (int)len);
+}
+
+static
+bool exists(char const* path, size_t n, char const* suffix)
+{
+  char p[256] = {0};
+  if(n == 0)
+    snprintf(p, sizeof(p), "%s%s", path, suffix);
+  else
+    snprintf(p, sizeof(p), "%s.%zu%s", path, n, suffix);
+  struct stat st = {0};
+  return stat(p, &st) == 0;
+}
+
+// Returns a NULL terminated copy of the file
+static
+char* read_file(char const* path, size_t* len)
+{
+  FILE* fp = fopen(path, "r");
+  assert(fp != NULL);
+  int rc = fseek(fp, 0, SEEK_END);
+  assert(rc == 0);
+  long const sz = ftell(fp);
+  assert(sz > -1);
+  rewind(fp);
+
+  char* buf = calloc(sz + 1, 1);
+  assert(buf != NULL);
+  size_t const n = fread(buf, 1, sz, fp);
+  assert(n == (size_t)sz);
+  fclose(fp);
+
+  *len = n;
+  return buf;
+}
+
+static
+void remove_all(char const* path, size_t keep)
+{
+  char p[256] = {0};
+  unlink(path);
+  for(size_t n = 1; n <= keep + 1; ++n){
+    snprintf(p, sizeof(p), "%s.%zu", path, n);
+    unlink(p);
+    snprintf(p, sizeof(p), "%s.%zu.gz", path, n);
+    unlink(p);
+  }
+}
+
+// Points of 100 bytes, numbered
+static
+void push_point(telemetry_file_t* t, size_t i)
+{
+  char p[101] = {0};
+  memset(p, 'x', 99);
+  int const rc = snprintf(p, sizeof(p), "%06zu", i);
+  assert(rc == 6);
+  p[6] = ' ';
+  p[99] = '\n';
+  push_telemetry_file(t, p, 100);
+}
+
+// Whole points only, in order, starting at *next
+static
+void check_points(char const* path, size_t* next)
+{
+  size_t len = 0;
+  char* buf = read_file(path, &len);
+  assert(len % 100 == 0);
+  for(size_t off = 0; off < len; off += 100){
+    assert(buf[off + 99] == '\n');
+    assert((size_t)atoi(buf + off) == *next);
+    *next += 1;
+  }
+  free(buf);
+}
+
+// Segments rotate once over size, and only keep of them are kept. No point is
+// lost nor cut
+static
+void test_rotate_size(void)
+{
+  char path[128] = {0};
+  gen_path("size.jsonl", path, sizeof(path));
+
+  telemetry_file_t t = {0};
+  init_telemetry_file(&t, path, "size=1K;keep=2;ms=10");
+
+  // 11 points per segment, as the rotation follows a write
+  for(size_t i = 0; i < 35; ++i){
+    push_point(&t, i);
+    flush_telemetry_file(&t);
+  }
+
+  telemetry_file_stats_t const s = stats_telemetry_file(&t);
+  assert(s.points == 35);
+  assert(s.bytes == 3500);
+  assert(s.dropped == 0);
+  assert(s.rotations == 3);
+  assert(s.size == 200);
+
+  assert(exists(path, 0, "") && exists(path, 1, "") && exists(path, 2, ""));
+  assert(exists(path, 3, "") == false);
+
+  free_telemetry_file(&t);
+
+  // The oldest segment, points 0 to 10, was deleted
+  size_t next = 11;
+  char p[256] = {0};
+  snprintf(p, sizeof(p), "%s.2", path);
+  check_points(p, &next);
+  snprintf(p, sizeof(p), "%s.1", path);
+  check_points(p, &next);
+  check_points(path, &next);
+  assert(next == 35);
+
+  remove_all(path, 2);
+}
+
+// The file of a previous run is rotated at start, and an empty one is not
+static
+void test_rotate_restart(void)
+{
+  char path[128] = {0};
+  gen_path("restart.jsonl", path, sizeof(path));
+
+  telemetry_file_t t = {0};
+  init_telemetry_file(&t, path, NULL);
+  push_point(&t, 0);
+  free_telemetry_file(&t);
+
+  init_telemetry_file(&t, path, NULL);
+  assert(stats_telemetry_file(&t).rotations == 1);
+  assert(stats_telemetry_file(&t).size == 0);
+  free_telemetry_file(&t);
+
+  init_telemetry_file(&t, path, NULL);
+  assert(stats_telemetry_file(&t).rotations == 0);
+  rotate_telemetry_file(&t);
+  assert(stats_telemetry_file(&t).rotations == 0);
+  free_telemetry_file(&t);
+
+  size_t next = 0;
+  char p[256] = {0};
+  snprintf(p, sizeof(p), "%s.1", path);
+  check_points(p, &next);
+  assert(next == 1);
+  assert(exists(path, 2, "") == false);
+
+  remove_all(path, TELEMETRY_FILE_KEEP);
+}
+
+// A non-empty segment rotates after age seconds, even without new points
+static
+void test_rotate_age(void)
+{
+  char path[128] = {0};
+  gen_path("age.jsonl", path, sizeof(path));
+
+  telemetry_file_t t = {0};
+  init_telemetry_file(&t, path, "age=1;ms=10");
+  push_point(&t, 0);
+  flush_telemetry_file(&t);
+  assert(stats_telemetry_file(&t).rotations == 0);
+
+  for(size_t i = 0; i < 200 && stats_telemetry_file(&t).rotations == 0; ++i)
+    usleep(10*1000);
+  assert(stats_telemetry_file(&t).rotations == 1);
+  assert(exists(path, 1, "") == true);
+
+  // Points are written ms after the previous write, without flush
+  push_point(&t, 1);
+  for(size_t i = 0; i < 200 && stats_telemetry_file(&t).bytes < 200; ++i)
+    usleep(10*1000);
+  assert(stats_telemetry_file(&t).bytes == 200);
+
+  free_telemetry_file(&t);
+  remove_all(path, TELEMETRY_FILE_KEEP);
+}
+
+// Points beyond the buffer are dropped, not blocking the caller
+static
+void test_drop(void)
+{
+  char path[128] = {0};
+  gen_path("drop.jsonl", path, sizeof(path));
+
+  telemetry_file_t t = {0};
+  init_telemetry_file(&t, path, "buf=1K");
+
+  char lines[2000] = {0};
+  memset(lines, 'x', sizeof(lines));
+  for(size_t i = 99; i < sizeof(lines); i += 100)
+    lines[i] = '\n';
+  push_telemetry_file(&t, lines, sizeof(lines));
+  push_telemetry_file(&t, lines, 500);
+  flush_telemetry_file(&t);
+
+  telemetry_file_stats_t const s = stats_telemetry_file(&t);
+  assert(s.points == 25);
+  assert(s.dropped == 20);
+  assert(s.bytes == 500);
+
+  free_telemetry_file(&t);
+  remove_all(path, TELEMETRY_FILE_KEEP);
+}
+
+#ifdef TELEMETRY_GZIP
+static
+void test_gzip(void)
+{
+  char path[128] = {0};
+  gen_path("gzip.jsonl", path, sizeof(path));
+
+  telemetry_file_t t = {0};
+  init_telemetry_file(&t, path, "gzip=1;keep=2");
+  for(size_t i = 0; i < 50; ++i)
+    push_point(&t, i);
+  rotate_telemetry_file(&t);
+  push_point(&t, 50);
+  rotate_telemetry_file(&t);
+
+  telemetry_file_stats_t const s = stats_telemetry_file(&t);
+  assert(s.rotations == 2);
+  assert(s.compressed == 2);
+  free_telemetry_file(&t);
+
+  assert(exists(path, 1, ".gz") == true && exists(path, 1, "") == false);
+  assert(exists(path, 2, ".gz") == true && exists(path, 2, "") == false);
+
+  char p[256] = {0};
+  snprintf(p, sizeof(p), "%s.2.gz", path);
+  gzFile gz = gzopen(p, "rb");
+  assert(gz != NULL);
+  char buf[6000] = {0};
+  int const n = gzread(gz, buf, sizeof(buf));
+  assert(n == 5000);
+  gzclose(gz);
+  for(size_t i = 0; i < 50; ++i)
+    assert((size_t)atoi(buf + 100*i) == i && buf[100*i + 99] == '\n');
+
+  remove_all(path, 2);
+}
+#endif
+
+static
+global_e2_node_id_t gen_node_id(void)
+{
+  global_e2_node_id_t id = {.type = ngran_gNB,
+                            .plmn = {.mcc = 505, .mnc = 1, .mnc_digit_len = 2},
+                            .nb_id = {.nb_id = 7, .unused = 0}};
+  return id;
+}
+
+// One indication of every SM
+static
+size_t gen_ind(sm_ag_if_rd_ind_e type, sm_ag_if_rd_ind_t* d)
+{
+  static mac_ue_stats_impl_t mac = {.rnti = 1234, .dl_aggr_tbs = 100};
+  static rlc_radio_bearer_stats_t rlc = {.rnti = 1234, .rbid = 1};
+  static pdcp_radio_bearer_stats_t pdcp = {.rnti = 1234, .rbid = 1};
+  static gtp_ngu_t_stats_t gtp = {.rnti = 1234};
+  static fr_slice_t slice = {.id = 1};
+  static ue_slice_assoc_t ue_slice = {.rnti = 1234};
+  static tc_queue_t q = {.type = TC_QUEUE_FIFO};
+  static tc_shp_t shp = {0};
+  static tc_plc_t plc = {0};
+
+  static meas_record_lst_t rec = {.value = INTEGER_MEAS_VALUE, .int_val = 40};
+  static meas_data_lst_t data = {.meas_record_len = 1, .meas_record_lst = &rec};
+
+  static ran_parameter_value_t five = {.type = INTEGER_RAN_PARAMETER_VALUE, .int_ran = 5};
+  static seq_ran_param_t param = {.ran_param_id = 1, .ran_param_val = {.type = ELEMENT_KEY_FLAG_FALSE_RAN_PARAMETER_VAL_TYPE, .flag_false = &five}};
+
+  *d = (sm_ag_if_rd_ind_t){.type = type};
+  switch(type){
+    case MAC_STATS_V0:
+      d->mac.msg = (mac_ind_msg_t){.len_ue_stats = 1, .ue_stats = &mac, .tstamp = 1700000000000001};
+      return 1;
+    case RLC_STATS_V0:
+      d->rlc.msg = (rlc_ind_msg_t){.len = 1, .rb = &rlc};
+      return 1;
+    case PDCP_STATS_V0:
+      d->pdcp.msg = (pdcp_ind_msg_t){.len = 1, .rb = &pdcp};
+      return 1;
+    case SLICE_STATS_V0:
+      d->slice.msg.slice_conf.dl = (ul_dl_slice_conf_t){.len_slices = 1, .slices = &slice};
+      d->slice.msg.ue_slice_conf = (ue_slice_conf_t){.len_ue_slice = 1, .ues = &ue_slice};
+      return 2;
+    case TC_STATS_V0:
+      d->tc.msg = (tc_ind_msg_t){.len_q = 1, .q = &q, .shp = &shp, .plc = &plc};
+      return 1;
+    case GTP_STATS_V0:
+      d->gtp.msg = (gtp_ind_msg_t){.len = 1, .ngut = &gtp};
+      return 1;
+    case KPM_STATS_V3_0:
+      d->kpm.ind.hdr.type = FORMAT_1_INDICATION_HEADER;
+      d->kpm.ind.msg.type = FORMAT_1_INDICATION_MESSAGE;
+      d->kpm.ind.msg.frm_1 = (kpm_ind_msg_format_1_t){.meas_data_lst_len = 1, .meas_data_lst = &data};
+      return 1;
+    case RAN_CTRL_STATS_V1_03:
+      d->rc.ind.hdr.format = FORMAT_1_E2SM_RC_IND_HDR;
+      d->rc.ind.msg.format = FORMAT_1_E2SM_RC_IND_MSG;
+      d->rc.ind.msg.frmt_1 = (e2sm_rc_ind_msg_frmt_1_t){.sz_seq_ran_param = 1, .seq_ran_param = &param};
+      return 1;
+    default:
+      assert(0 != 0 && "Unknown data type");
+  }
+  return 0;
+}
+
+// The listener writes one JSON object per line for the indications of every SM
+static
+void test_listener(void)
+{
+  char path[128] = {0};
+  gen_path("listener.jsonl", path, sizeof(path));
+
+  init_stdout_listener(path, NULL, NULL);
+
+  global_e2_node_id_t id = gen_node_id();
+  sm_ag_if_rd_ind_e const types[] = {MAC_STATS_V0, RLC_STATS_V0, PDCP_STATS_V0, SLICE_STATS_V0,
+                                     TC_STATS_V0, GTP_STATS_V0, KPM_STATS_V3_0, RAN_CTRL_STATS_V1_03};
+  char const* meas[] = {"mac", "rlc", "pdcp", "slice", "tc", "gtp", "kpm", "rc"};
+
+  size_t num = 0;
+  for(size_t i = 0; i < sizeof(types)/sizeof(types[0]); ++i){
+    sm_ag_if_rd_ind_t d = {0};
+    num += gen_ind(types[i], &d);
+    notify_stdout_listener(&id, &d);
+  }
+  flush_stdout_listener();
+
+  telemetry_file_stats_t const s = stats_stdout_listener();
+  assert(s.points == num);
+  assert(s.dropped == 0);
+
+  size_t len = 0;
+  char* buf = read_file(path, &len);
+  assert(s.bytes == len);
+
+  size_t lines = 0;
+  for(char* it = buf; it < buf + len; ++lines){
+    char* nl = strchr(it, '\n');
+    assert(nl != NULL && nl[-1] == '}');
+    assert(strncmp(it, "{\"meas\":\"", 9) == 0);
+    assert(strstr(it, "\"tags\":{\"node\":\"505-1-7\",\"ran\":\"ngran_gNB\"") != NULL);
+    it = nl + 1;
+  }
+  assert(lines == num);
+
+  for(size_t i = 0; i < sizeof(meas)/sizeof(meas[0]); ++i){
+    char m[32] = {0};
+    snprintf(m, sizeof(m), "{\"meas\":\"%s\"", meas[i]);
+    assert(strstr(buf, m) != NULL);
+  }
+  assert(strstr(buf, "\"fields\":{\"dl_aggr_tbs\":100,") != NULL);
+  assert(strstr(buf, ",\"ts\":1700000000000001000}\n") != NULL);
+  assert(strstr(buf, "\"p1\":5") != NULL);
+  free(buf);
+
+  free_stdout_listener();
+
+  // Disabled, thus ignored
+  sm_ag_if_rd_ind_t d = {0};
+  gen_ind(MAC_STATS_V0, &d);
+  notify_stdout_listener(&id, &d);
+
+  remove_all(path, TELEMETRY_FILE_KEEP);
+}
+
+int main()
+{
+  char* d = mkdtemp(dir);
+  assert(d != NULL);
+
+  test_rotate_size();
+  test_rotate_restart();
+  test_rotate_age();
+  test_drop();
+#ifdef TELEMETRY_GZIP
+  test_gzip();
+#endif
+  test_listener();
+
+  int const rc = rmdir(dir);
+  assert(rc == 0);
+
+  printf("[TELEMETRY]: Test passed\n");
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,160 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+
+
+
+#include "../iApp/xapp_session.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define GRACE_US (XAPP_SESSION_GRACE_MS * 1000)
+
+static
+byte_array_t token(char const* str)
+{
+  return (byte_array_t){.len = strlen(str), .buf = (uint8_t*)str};
+}
+
+// The same instance comes back within the grace period
+static
+void test_resume(void)
+{
+  xapp_sessions_t s = {0};
+  init_xapp_sessions(&s);
+
+  xapp_session_ans_t ans = attach_xapp_session(&s, token("kpm-mon/1"), 7);
+  assert(ans.type == NEW_XAPP_SESSION && ans.xapp_id == 7);
+
+  // Attached, the indications are sent
+  assert(lost_ind_xapp_session(&s, 7) == false);
+
+  int64_t const now = 1000000;
+  assert(detach_xapp_session(&s, 7, now) == true);
+
+  // Detached, the indications are counted as lost
+  for(size_t i = 0; i < 3; ++i)
+    assert(lost_ind_xapp_session(&s, 7) == true);
+
+  uint16_t id[4] = {0};
+  assert(expire_xapp_session(&s, now + GRACE_US - 1, GRACE_US, 4, id) == 0);
+
+  // Same xApp ID, i.e., same subscriptions 
+  ans = attach_xapp_session(&s, token("kpm-mon/1"), 8);
+  assert(ans.type == RESUMED_XAPP_SESSION && ans.xapp_id == 7);
+  assert(ans.lost_ind == 3);
+  assert(lost_ind_xapp_session(&s, 7) == false);
+
+  // Attached sessions never expire
+  assert(expire_xapp_session(&s, now + 10 * GRACE_US, GRACE_US, 4, id) == 0);
+
+  byte_array_t identity = identity_xapp_session(&s, 7);
+  assert(identity.len == strlen("kpm-mon") && memcmp(identity.buf, "kpm-mon", identity.len) == 0);
+  free_byte_array(identity);
+
+  free_xapp_sessions(&s);
+}
+
+// The xApp does not come back within the grace period
+static
+void test_grace_expiry(void)
+{
+  xapp_sessions_t s = {0};
+  init_xapp_sessions(&s);
+
+  attach_xapp_session(&s, token("kpm-mon/1"), 7);
+  attach_xapp_session(&s, token("rc-ctrl/1"), 9);
+
+  int64_t const now = 1000000;
+  assert(detach_xapp_session(&s, 7, now) == true);
+  assert(detach_xapp_session(&s, 9, now + GRACE_US / 2) == true);
+
+  // Only the first one expired. Its subscriptions go with it
+  uint16_t id[4] = {0};
+  assert(expire_xapp_session(&s, now + GRACE_US, GRACE_US, 4, id) == 1);
+  assert(id[0] == 7);
+  assert(lost_ind_xapp_session(&s, 7) == false);
+
+  // Too late, it starts from scratch
+  xapp_session_ans_t ans = attach_xapp_session(&s, token("kpm-mon/1"), 10);
+  assert(ans.type == NEW_XAPP_SESSION && ans.xapp_id == 10);
+
+  assert(expire_xapp_session(&s, now + 2 * GRACE_US, GRACE_US, 4, id) == 1);
+  assert(id[0] == 9);
+
+  // Without a token, there is no session
+  assert(detach_xapp_session(&s, 11, now) == false);
+  byte_array_t identity = identity_xapp_session(&s, 11);
+  assert(identity.len == 0 && identity.buf == NULL);
+
+  free_xapp_sessions(&s);
+}
+
+// The xApp restarted, i.e., same identity with a new instance
+static
+void test_new_instance(void)
+{
+  xapp_sessions_t s = {0};
+  init_xapp_sessions(&s);
+
+  attach_xapp_session(&s, token("kpm-mon/1"), 7);
+
+  int64_t const now = 1000000;
+  assert(detach_xapp_session(&s, 7, now) == true);
+  assert(lost_ind_xapp_session(&s, 7) == true);
+
+  // The old handles died with the old instance
+  xapp_session_ans_t ans = attach_xapp_session(&s, token("kpm-mon/2"), 8);
+  assert(ans.type == RESTARTED_XAPP_SESSION);
+  assert(ans.xapp_id == 8 && ans.old_xapp_id == 7);
+
+  // The new instance replaces the old one
+  uint16_t id[4] = {0};
+  assert(expire_xapp_session(&s, now + 10 * GRACE_US, GRACE_US, 4, id) == 0);
+  assert(detach_xapp_session(&s, 7, now) == false);
+  assert(detach_xapp_session(&s, 8, now) == true);
+
+  ans = attach_xapp_session(&s, token("kpm-mon/2"), 9);
+  assert(ans.type == RESUMED_XAPP_SESSION && ans.xapp_id == 8);
+
+  // The old instance comes back late, and takes over again
+  ans = attach_xapp_session(&s, token("kpm-mon/1"), 10);
+  assert(ans.type == RESTARTED_XAPP_SESSION);
+  assert(ans.xapp_id == 10 && ans.old_xapp_id == 8);
+
+  assert(rm_xapp_session(&s, 10) == true);
+  assert(rm_xapp_session(&s, 10) == false);
+
+  free_xapp_sessions(&s);
+}
+
+int main()
+{
+  test_resume();
+  test_grace_expiry();
+  test_new_instance();
+
+  printf("Success\n");
+  return EXIT_SUCCESS;
+}
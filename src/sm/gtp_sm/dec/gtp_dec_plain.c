@@ -21,32 +21,25 @@
 
 
 #include "gtp_dec_plain.h"
+#include "../ie/gtp_wire_plain.h"
 
 #include <assert.h>
+#include <stdio.h>
 #include <stdlib.h>
-#include <string.h>
 
-static inline
-size_t next_pow2(size_t x)
+// Corrupt or truncated data is not decoded. An empty IE is returned instead
+static
+void corrupt_ie(char const* ie, size_t len)
 {
-  static_assert(sizeof(x) == 8, "Need this size to work correctly");
-  x -= 1;
-	x |= (x >> 1);
-	x |= (x >> 2);
-	x |= (x >> 4);
-	x |= (x >> 8);
-	x |= (x >> 16);
-	x |= (x >> 32);
-	
-	return x + 1;
-
+  printf("[E2SM GTP]: Corrupt %s of %lu bytes. Not decoded \n", ie, len);
 }
 
 gtp_event_trigger_t gtp_dec_event_trigger_plain(size_t len, uint8_t const ev_tr[len])
 {
-  gtp_event_trigger_t ev = {0};
-  memcpy(&ev.ms, ev_tr, sizeof(ev.ms));
-  return ev;
+  gtp_event_trigger_t ret = {0};
+  if(dec_gtp_event_trigger_plain_wire(len, ev_tr, &ret) == false)
+    corrupt_ie("event trigger", len);
+  return ret;
 }
 
 gtp_action_def_t gtp_dec_action_def_plain(size_t len, uint8_t const action_def[len])
@@ -59,37 +52,17 @@ gtp_action_def_t gtp_dec_action_def_plain(size_t len, uint8_t const action_def[l
 
 gtp_ind_hdr_t gtp_dec_ind_hdr_plain(size_t len, uint8_t const ind_hdr[len])
 {
-  assert(len == sizeof(gtp_ind_hdr_t)); 
-  gtp_ind_hdr_t ret;
-  memcpy(&ret, ind_hdr, len);
+  gtp_ind_hdr_t ret = {0};
+  if(dec_gtp_ind_hdr_plain_wire(len, ind_hdr, &ret) == false)
+    corrupt_ie("indication header", len);
   return ret;
 }
 
 gtp_ind_msg_t gtp_dec_ind_msg_plain(size_t len, uint8_t const ind_msg[len])
 {
-  assert(next_pow2(len) >= sizeof(gtp_ind_msg_t) - sizeof(gtp_ngu_t_stats_t*) && "Less bytes than the case where there are not active Radio bearers! Next pow2 trick used for aligned struct");
   gtp_ind_msg_t ret = {0};
-
-  memcpy(&ret.len, ind_msg, sizeof(ret.len));
-  if(ret.len > 0){
-    ret.ngut = calloc(ret.len, sizeof(gtp_ngu_t_stats_t) );
-    assert(ret.ngut != NULL && "memory exhausted");
-  }
-
-  void const* it = ind_msg + sizeof(ret.len);
-  for(uint32_t i = 0; i < ret.len; ++i){
-  memcpy(&ret.ngut[i], it, sizeof(ret.ngut[i]) );
-  it += sizeof(ret.ngut[i]); 
-  }
-  
-  memcpy(&ret.tstamp, it, sizeof(ret.tstamp));
-  it += sizeof(ret.tstamp);
-
-//  memcpy(&ret.slot, it, sizeof(ret.slot));
-//  it += sizeof(ret.slot);
- 
-  assert(it == &ind_msg[len] && "Mismatch of data layout");
-
+  if(dec_gtp_ind_msg_plain_wire(len, ind_msg, &ret) == false)
+    corrupt_ie("indication message", len);
   return ret;
 }
 
@@ -101,17 +74,17 @@ gtp_call_proc_id_t gtp_dec_call_proc_id_plain(size_t len, uint8_t const call_pro
 
 gtp_ctrl_hdr_t gtp_dec_ctrl_hdr_plain(size_t len, uint8_t const ctrl_hdr[len])
 {
-  assert(len == sizeof(gtp_ctrl_hdr_t)); 
-  gtp_ctrl_hdr_t ret;
-  memcpy(&ret, ctrl_hdr, len);
+  gtp_ctrl_hdr_t ret = {0};
+  if(dec_gtp_ctrl_hdr_plain_wire(len, ctrl_hdr, &ret) == false)
+    corrupt_ie("control header", len);
   return ret;
 }
 
 gtp_ctrl_msg_t gtp_dec_ctrl_msg_plain(size_t len, uint8_t const ctrl_msg[len])
 {
-  assert(len == sizeof(gtp_ctrl_msg_t)); 
-  gtp_ctrl_msg_t ret;
-  memcpy(&ret, ctrl_msg, len);
+  gtp_ctrl_msg_t ret = {0};
+  if(dec_gtp_ctrl_msg_plain_wire(len, ctrl_msg, &ret) == false)
+    corrupt_ie("control message", len);
   return ret;
 }
 
@@ -22,6 +22,7 @@
 
 
 #include "gtp_enc_plain.h"
+#include "../ie/gtp_wire_plain.h"
 
 #include <assert.h>
 #include <stdlib.h>
@@ -30,15 +31,7 @@
 byte_array_t gtp_enc_event_trigger_plain(gtp_event_trigger_t const* event_trigger)
 {
   assert(event_trigger != NULL);
-  byte_array_t  ba = {0};
- 
-  ba.len = sizeof(event_trigger->ms);
-  ba.buf = malloc(ba.len);
-  assert(ba.buf != NULL && "Memory exhausted");
-
-  memcpy(ba.buf, &event_trigger->ms, ba.len);
-
-  return ba;
+  return enc_gtp_event_trigger_plain_wire(event_trigger);
 }
 
 byte_array_t gtp_enc_action_def_plain(gtp_action_def_t const* action_def)
@@ -53,50 +46,13 @@ byte_array_t gtp_enc_action_def_plain(gtp_action_def_t const* action_def)
 byte_array_t gtp_enc_ind_hdr_plain(gtp_ind_hdr_t const* ind_hdr)
 {
   assert(ind_hdr != NULL);
-
-  byte_array_t ba = {0};
-
-  ba.len = sizeof(gtp_ind_hdr_t);
-  ba.buf = calloc(ba.len, sizeof(uint8_t));
-  assert(ba.buf != NULL && "memory exhausted");
-  memcpy(ba.buf, ind_hdr, ba.len);
-
-  return ba;
+  return enc_gtp_ind_hdr_plain_wire(ind_hdr);
 }
 
 byte_array_t gtp_enc_ind_msg_plain(gtp_ind_msg_t const* ind_msg)
 {
   assert(ind_msg != NULL);
-
-  byte_array_t ba = {0};
-
-  size_t const sz = sizeof(ind_msg->len) + 
-                  sizeof(gtp_ngu_t_stats_t)*ind_msg->len + 
-                  sizeof(ind_msg->tstamp);
-
-//  printf("Size of the byte array = %lu\n", sz);
-
-  ba.buf = malloc(sz); 
-  assert(ba.buf != NULL && "Memory exhausted");
-
-  memcpy(ba.buf, &ind_msg->len, sizeof(ind_msg->len));
-
-  void* it = ba.buf + sizeof(ind_msg->len);
-  for(uint32_t i = 0; i < ind_msg->len ; ++i){
-    memcpy(it, &ind_msg->ngut[i], sizeof(ind_msg->ngut[i]));
-    it += sizeof(ind_msg->ngut[i]);
-  }
-
-  memcpy(it, &ind_msg->tstamp, sizeof(ind_msg->tstamp));
-  it += sizeof(ind_msg->tstamp);
-
-//  memcpy(it, &ind_msg->slot, sizeof(ind_msg->slot));
-//  it += sizeof(ind_msg->slot);
-
-  assert(it == ba.buf + sz && "Mismatch of data layout");
-
-  ba.len = sz;
-  return ba;
+  return enc_gtp_ind_msg_plain_wire(ind_msg);
 }
 
 byte_array_t gtp_enc_call_proc_id_plain(gtp_call_proc_id_t const* call_proc_id)
@@ -111,29 +67,13 @@ byte_array_t gtp_enc_call_proc_id_plain(gtp_call_proc_id_t const* call_proc_id)
 byte_array_t gtp_enc_ctrl_hdr_plain(gtp_ctrl_hdr_t const* ctrl_hdr)
 {
   assert(ctrl_hdr != NULL);
-  byte_array_t  ba = {0};
-  ba.len = sizeof(gtp_ctrl_hdr_t);
-  ba.buf = calloc(ba.len, sizeof(uint8_t)); 
-  assert(ba.buf != NULL && "Memory exhausted");
-
-  memcpy(ba.buf, ctrl_hdr, sizeof(gtp_ctrl_hdr_t));
-
-  return ba;
+  return enc_gtp_ctrl_hdr_plain_wire(ctrl_hdr);
 }
 
 byte_array_t gtp_enc_ctrl_msg_plain(gtp_ctrl_msg_t const* ctrl_msg)
 {
   assert(ctrl_msg != NULL);
-
-  byte_array_t  ba = {0};
-  ba.len = sizeof(gtp_ctrl_msg_t);
-
-  ba.buf = calloc(ba.len, sizeof(uint8_t)); 
-  assert(ba.buf != NULL && "Memory exhausted");
-
-  memcpy(ba.buf, ctrl_msg, ba.len);
-
-  return ba;
+  return enc_gtp_ctrl_msg_plain_wire(ctrl_msg);
 }
 
 byte_array_t gtp_enc_ctrl_out_plain(gtp_ctrl_out_t const* ctrl) 
@@ -21,6 +21,7 @@
 
 
 #include "gtp_sm_agent.h"
+#include "../sm_enc.h"
 #include "gtp_sm_id.h"
 #include "enc/gtp_enc_generic.h"
 #include "dec/gtp_dec_generic.h"
@@ -145,14 +146,7 @@ sm_e2_setup_data_t on_e2_setup_gtp_sm_ag(sm_agent_t const* sm_agent)
   // ToDO: Fill RAN Function from the RAN
   sm_e2_setup_data_t setup = {.len_rfd =0, .ran_fun_def = NULL  }; 
 
-  size_t const sz = strnlen(SM_GTP_STR, 256);
-  assert(sz < 256 && "Buffer overeflow?");
-
-  setup.len_rfd = sz;
-  setup.ran_fun_def = calloc(1, sz);
-  assert(setup.ran_fun_def != NULL);
-
-  memcpy(setup.ran_fun_def, SM_GTP_STR , sz);
+  setup = tag_ran_func_def_sm_enc(SM_GTP_STR, SM_ENC_COMPILED);
  
   /*
   setup.len_rfd = strlen(sm->base.ran_func_name);
@@ -257,6 +257,8 @@ sm_ric_t* make_gtp_sm_ric(void /* sm_io_ric_t io */)
   assert(strlen(SM_GTP_STR) < sizeof( sm->base.ran_func_name) );
   memcpy(sm->base.ran_func_name, SM_GTP_STR, strlen(SM_GTP_STR)); 
 
+  sm->base.enc = SM_ENC_COMPILED;
+
 
   return &sm->base;
 }
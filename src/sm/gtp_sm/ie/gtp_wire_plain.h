@@ -0,0 +1,53 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+#ifndef GTP_WIRE_PLAIN_H
+#define GTP_WIRE_PLAIN_H
+
+// Layout of the GTP SM plain encoding, see util/plain_wire.h. Fields are 
+// only appended at the end of a list, as the older readers know a prefix
+
+#include "gtp_data_ie.h"
+#include "../../../util/plain_wire.h"
+
+#define GTP_EVENT_TRIGGER_WIRE(F, A, T) F(T, ms)
+
+#define GTP_IND_HDR_WIRE(F, A, T) F(T, dummy)
+
+#define GTP_CTRL_HDR_WIRE(F, A, T) F(T, dummy)
+
+#define GTP_CTRL_MSG_WIRE(F, A, T) F(T, action)
+
+#define GTP_NGU_STATS_WIRE(F, A, T) \
+  F(T, rnti) \
+  F(T, teidgnb) \
+  F(T, qfi) \
+  F(T, teidupf)
+
+PLAIN_WIRE_REC_MSG(gtp_event_trigger, gtp_event_trigger_t, GTP_EVENT_TRIGGER_WIRE)
+PLAIN_WIRE_REC_MSG(gtp_ind_hdr, gtp_ind_hdr_t, GTP_IND_HDR_WIRE)
+PLAIN_WIRE_REC_MSG(gtp_ctrl_hdr, gtp_ctrl_hdr_t, GTP_CTRL_HDR_WIRE)
+PLAIN_WIRE_REC_MSG(gtp_ctrl_msg, gtp_ctrl_msg_t, GTP_CTRL_MSG_WIRE)
+
+PLAIN_WIRE_REC(gtp_ngu_stats, gtp_ngu_t_stats_t, GTP_NGU_STATS_WIRE)
+PLAIN_WIRE_ARR_MSG(gtp_ind_msg, gtp_ind_msg_t, ngut, len, gtp_ngu_stats, gtp_ngu_t_stats_t, GTP_NGU_STATS_WIRE)
+
+#endif
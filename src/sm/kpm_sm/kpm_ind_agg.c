@@ -0,0 +1,519 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+
+
+#include "kpm_ind_agg.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Samples of one measurement of one UE
+typedef struct{
+  // Ring of the last spec->win samples and the indication they belong to
+  double* val;
+  uint64_t* seq;
+  size_t head;
+  size_t len;
+
+  // Samples ever consumed 
+  uint64_t num;
+  // Indexed as kpm_agg_spec_t::stat
+  double ewma[KPM_AGG_MAX_STAT];
+} kpm_agg_series_t;
+
+typedef struct{
+  // false for Format 1 streams 
+  bool has_id;
+  ue_id_e2sm_t id;
+
+  // Last indication that carried this UE
+  uint64_t last_seq;
+
+  // kpm_agg_series_t, indexed as kpm_ind_agg_t::meas
+  seq_arr_t series;
+} kpm_agg_ue_t;
+
+static
+bool parse_double(char const* s, double lo, double hi, double* dst)
+{
+  if(*s == '\0')
+    return false;
+
+  char* end = NULL;
+  double const d = strtod(s, &end);
+  if(end == s || *end != '\0' || !(d > lo && d <= hi))
+    return false;
+
+  *dst = d;
+  return true;
+}
+
+static
+bool parse_stat(char const* s, kpm_agg_stat_t* dst)
+{
+  if(strcmp(s, "count") == 0)
+    dst->type = COUNT_KPM_AGG;
+  else if(strcmp(s, "mean") == 0)
+    dst->type = MEAN_KPM_AGG;
+  else if(strcmp(s, "min") == 0)
+    dst->type = MIN_KPM_AGG;
+  else if(strcmp(s, "max") == 0)
+    dst->type = MAX_KPM_AGG;
+  else if(strncmp(s, "ewma", 4) == 0){
+    dst->type = EWMA_KPM_AGG;
+    if(parse_double(s + 4, 0.0, 1.0, &dst->param) == false)
+      return false;
+  } else if(s[0] == 'p'){
+    dst->type = QUANTILE_KPM_AGG;
+    if(parse_double(s + 1, 0.0, 100.0, &dst->param) == false)
+      return false;
+    dst->param /= 100.0;
+  } else 
+    return false;
+
+  dst->name = cp_str_to_ba(s);
+  return true;
+}
+
+bool parse_kpm_agg_stat(char* s, kpm_agg_spec_t* dst)
+{
+  assert(s != NULL);
+  assert(dst != NULL);
+  assert(dst->len_stat == 0);
+
+  char* save = NULL;
+  for(char* it = strtok_r(s, ",", &save); it != NULL; it = strtok_r(NULL, ",", &save)){
+    if(dst->len_stat == KPM_AGG_MAX_STAT)
+      return false;
+
+    kpm_agg_stat_t st = {0};
+    if(parse_stat(it, &st) == false)
+      return false;
+
+    dst->stat = realloc(dst->stat, (dst->len_stat + 1)*sizeof(kpm_agg_stat_t));
+    assert(dst->stat != NULL && "Memory exhausted");
+    dst->stat[dst->len_stat] = st;
+    dst->len_stat += 1;
+  }
+  return dst->len_stat > 0;
+}
+
+bool parse_kpm_agg_win(char* s, kpm_agg_spec_t* dst)
+{
+  assert(s != NULL);
+  assert(dst != NULL);
+
+  char* end = NULL;
+  if(*s < '0' || *s > '9')
+    return false;
+  unsigned long const win = strtoul(s, &end, 10);
+
+  unsigned long hop = win; 
+  if(*end == '/'){
+    char* hop_str = end + 1;
+    if(*hop_str < '0' || *hop_str > '9')
+      return false;
+    hop = strtoul(hop_str, &end, 10);
+  }
+
+  if(*end != '\0' || hop == 0 || hop > win || win > KPM_AGG_MAX_WIN)
+    return false;
+
+  dst->win = win;
+  dst->hop = hop;
+  return true;
+}
+
+void free_kpm_agg_spec(kpm_agg_spec_t* src)
+{
+  assert(src != NULL);
+
+  for(size_t i = 0; i < src->len_stat; ++i)
+    free_byte_array(src->stat[i].name);
+  free(src->stat);
+
+  *src = (kpm_agg_spec_t){0};
+}
+
+static
+void free_byte_array_wrapper(void* it)
+{
+  assert(it != NULL);
+  free_byte_array(*(byte_array_t*)it);
+}
+
+static
+void free_series(void* it)
+{
+  assert(it != NULL);
+  kpm_agg_series_t* s = (kpm_agg_series_t*)it;
+  free(s->val);
+  free(s->seq);
+}
+
+static
+void free_agg_ue(void* it)
+{
+  assert(it != NULL);
+  kpm_agg_ue_t* ue = (kpm_agg_ue_t*)it;
+  if(ue->has_id)
+    free_ue_id_e2sm(&ue->id);
+  seq_free(&ue->series, free_series);
+}
+
+void init_kpm_ind_agg(kpm_ind_agg_t* agg, kpm_agg_spec_t spec)
+{
+  assert(agg != NULL);
+  assert(spec.len_stat > 0 && spec.len_stat <= KPM_AGG_MAX_STAT);
+  assert(spec.hop > 0 && spec.hop <= spec.win && spec.win <= KPM_AGG_MAX_WIN);
+
+  agg->spec = spec;
+  agg->seq = 0;
+  seq_init(&agg->meas, sizeof(byte_array_t));
+  seq_init(&agg->ues, sizeof(kpm_agg_ue_t));
+
+  pthread_mutexattr_t attr = {0};
+  int rc = pthread_mutex_init(&agg->mtx, &attr);
+  assert(rc == 0);
+}
+
+void free_kpm_ind_agg(kpm_ind_agg_t* agg)
+{
+  assert(agg != NULL);
+
+  free_kpm_agg_spec(&agg->spec);
+  seq_free(&agg->meas, free_byte_array_wrapper);
+  seq_free(&agg->ues, free_agg_ue);
+
+  int rc = pthread_mutex_destroy(&agg->mtx);
+  assert(rc == 0);
+}
+
+static
+size_t meas_idx(kpm_ind_agg_t* agg, byte_array_t const* name)
+{
+  size_t const sz = seq_size(&agg->meas);
+  for(size_t i = 0; i < sz; ++i){
+    byte_array_t const* it = seq_at(&agg->meas, i);
+    if(eq_byte_array(it, name))
+      return i;
+  }
+
+  byte_array_t ba = copy_byte_array(*name);
+  seq_push_back(&agg->meas, &ba, sizeof(byte_array_t));
+  return sz;
+}
+
+static
+kpm_agg_ue_t* find_ue(kpm_ind_agg_t* agg, ue_id_e2sm_t const* id)
+{
+  size_t const sz = seq_size(&agg->ues);
+  for(size_t i = 0; i < sz; ++i){
+    kpm_agg_ue_t* it = seq_at(&agg->ues, i);
+    if(id == NULL && it->has_id == false)
+      return it;
+    if(id != NULL && it->has_id == true && eq_ue_id_e2sm(&it->id, id))
+      return it;
+  }
+
+  kpm_agg_ue_t ue = {.has_id = id != NULL};
+  if(id != NULL)
+    ue.id = cp_ue_id_e2sm(id);
+  seq_init(&ue.series, sizeof(kpm_agg_series_t));
+  seq_push_back(&agg->ues, &ue, sizeof(kpm_agg_ue_t));
+  return seq_at(&agg->ues, sz);
+}
+
+static
+void push_sample(kpm_ind_agg_t* agg, kpm_agg_ue_t* ue, size_t idx, double v)
+{
+  while(seq_size(&ue->series) <= idx){
+    kpm_agg_series_t s = {0};
+    seq_push_back(&ue->series, &s, sizeof(kpm_agg_series_t));
+  }
+
+  kpm_agg_series_t* s = seq_at(&ue->series, idx);
+  if(s->val == NULL){
+    s->val = calloc(agg->spec.win, sizeof(double));
+    s->seq = calloc(agg->spec.win, sizeof(uint64_t));
+    assert(s->val != NULL && s->seq != NULL && "Memory exhausted");
+  }
+
+  s->val[s->head] = v;
+  s->seq[s->head] = agg->seq;
+  s->head = (s->head + 1) % agg->spec.win;
+  if(s->len < agg->spec.win)
+    s->len += 1;
+
+  for(size_t i = 0; i < agg->spec.len_stat; ++i){
+    kpm_agg_stat_t const* st = &agg->spec.stat[i];
+    if(st->type != EWMA_KPM_AGG)
+      continue;
+    s->ewma[i] = s->num == 0 ? v : st->param * v + (1.0 - st->param) * s->ewma[i];
+  }
+  s->num += 1;
+}
+
+static
+void consume(kpm_ind_agg_t* agg, ue_id_e2sm_t const* id, kpm_ind_msg_format_1_t const* m)
+{
+  if(m->meas_info_lst_len == 0)
+    return;
+
+  // Series index of every column. SIZE_MAX for measurements identified by ID
+  size_t idx[m->meas_info_lst_len];
+  for(size_t i = 0; i < m->meas_info_lst_len; ++i){
+    meas_type_t const* t = &m->meas_info_lst[i].meas_type;
+    idx[i] = t->type == NAME_MEAS_TYPE ? meas_idx(agg, &t->name) : SIZE_MAX;
+  }
+
+  kpm_agg_ue_t* ue = find_ue(agg, id);
+  ue->last_seq = agg->seq;
+
+  for(size_t i = 0; i < m->meas_data_lst_len; ++i){
+    meas_data_lst_t const* row = &m->meas_data_lst[i];
+    size_t const len = row->meas_record_len < m->meas_info_lst_len ? row->meas_record_len : m->meas_info_lst_len;
+    for(size_t j = 0; j < len; ++j){
+      meas_record_lst_t const* r = &row->meas_record_lst[j];
+      if(idx[j] == SIZE_MAX || r->value == NO_VALUE_MEAS_VALUE)
+        continue;
+      double const v = r->value == INTEGER_MEAS_VALUE ? (double)r->int_val : r->real_val;
+      push_sample(agg, ue, idx[j], v);
+    }
+  }
+}
+
+static
+int cmp_double(void const* a, void const* b)
+{
+  double const x = *(double const*)a;
+  double const y = *(double const*)b;
+  return (x > y) - (x < y);
+}
+
+// Samples within the last spec->win indications 
+static
+size_t window(kpm_ind_agg_t const* agg, kpm_agg_series_t const* s, double* dst)
+{
+  uint64_t const lo = agg->seq > agg->spec.win ? agg->seq - agg->spec.win : 0;
+  size_t n = 0;
+  for(size_t i = 0; i < s->len; ++i){
+    if(s->seq[i] > lo)
+      dst[n++] = s->val[i];
+  }
+  return n;
+}
+
+static
+double stat(kpm_agg_stat_t const* st, double const* ewma, double* val, size_t n, bool* sorted)
+{
+  assert(n > 0);
+
+  if(st->type == COUNT_KPM_AGG)
+    return n;
+  if(st->type == EWMA_KPM_AGG)
+    return *ewma;
+
+  if(st->type == QUANTILE_KPM_AGG){
+    if(*sorted == false){
+      qsort(val, n, sizeof(double), cmp_double);
+      *sorted = true;
+    }
+    // Nearest rank
+    size_t rank = (size_t)ceil(st->param * n);
+    rank = rank == 0 ? 1 : rank;
+    return val[rank - 1];
+  }
+
+  double acc = st->type == MEAN_KPM_AGG ? 0.0 : val[0];
+  for(size_t i = 0; i < n; ++i){
+    if(st->type == MEAN_KPM_AGG)
+      acc += val[i];
+    else if(st->type == MIN_KPM_AGG)
+      acc = val[i] < acc ? val[i] : acc;
+    else if(st->type == MAX_KPM_AGG)
+      acc = val[i] > acc ? val[i] : acc;
+    else
+      assert(0 != 0 && "Unknown statistic");
+  }
+  return st->type == MEAN_KPM_AGG ? acc / n : acc;
+}
+
+static
+byte_array_t agg_name(byte_array_t const* meas, byte_array_t const* st)
+{
+  byte_array_t dst = {.len = meas->len + 1 + st->len};
+  dst.buf = malloc(dst.len);
+  assert(dst.buf != NULL && "Memory exhausted");
+  memcpy(dst.buf, meas->buf, meas->len);
+  dst.buf[meas->len] = ':';
+  memcpy(dst.buf + meas->len + 1, st->buf, st->len);
+  return dst;
+}
+
+static
+void add_column(kpm_ind_msg_format_1_t* dst, byte_array_t name, double v)
+{
+  size_t const i = dst->meas_info_lst_len;
+
+  dst->meas_info_lst = realloc(dst->meas_info_lst, (i + 1)*sizeof(meas_info_format_1_lst_t));
+  assert(dst->meas_info_lst != NULL && "Memory exhausted");
+  meas_info_format_1_lst_t* info = &dst->meas_info_lst[i];
+  *info = (meas_info_format_1_lst_t){0};
+  info->meas_type.type = NAME_MEAS_TYPE;
+  info->meas_type.name = name;
+  info->label_info_lst_len = 1;
+  info->label_info_lst = calloc(1, sizeof(label_info_lst_t));
+  assert(info->label_info_lst != NULL && "Memory exhausted");
+  info->label_info_lst[0].noLabel = malloc(sizeof(enum_value_e));
+  assert(info->label_info_lst[0].noLabel != NULL && "Memory exhausted");
+  *info->label_info_lst[0].noLabel = TRUE_ENUM_VALUE;
+  dst->meas_info_lst_len = i + 1;
+
+  meas_data_lst_t* row = &dst->meas_data_lst[0];
+  row->meas_record_lst = realloc(row->meas_record_lst, (i + 1)*sizeof(meas_record_lst_t));
+  assert(row->meas_record_lst != NULL && "Memory exhausted");
+  row->meas_record_lst[i] = (meas_record_lst_t){.value = REAL_MEAS_VALUE, .real_val = v};
+  row->meas_record_len = i + 1;
+}
+
+// Returns false if the UE has no sample in the window
+static
+bool aggregate(kpm_ind_agg_t* agg, kpm_agg_ue_t* ue, kpm_ind_msg_format_1_t* dst)
+{
+  *dst = (kpm_ind_msg_format_1_t){0};
+  dst->meas_data_lst_len = 1;
+  dst->meas_data_lst = calloc(1, sizeof(meas_data_lst_t));
+  assert(dst->meas_data_lst != NULL && "Memory exhausted");
+
+  double val[agg->spec.win];
+  size_t const sz = seq_size(&ue->series);
+  for(size_t i = 0; i < sz; ++i){
+    kpm_agg_series_t* s = seq_at(&ue->series, i);
+    size_t const n = window(agg, s, val);
+    if(n == 0)
+      continue;
+
+    byte_array_t const* meas = seq_at(&agg->meas, i);
+    bool sorted = false;
+    for(size_t j = 0; j < agg->spec.len_stat; ++j){
+      kpm_agg_stat_t const* st = &agg->spec.stat[j];
+      double const v = stat(st, &s->ewma[j], val, n, &sorted);
+      add_column(dst, agg_name(meas, &st->name), v);
+    }
+  }
+
+  if(dst->meas_info_lst_len == 0){
+    free_kpm_ind_msg_frm_1(dst);
+    return false;
+  }
+  return true;
+}
+
+// UEs without indications within the window are forgotten
+static
+void evict(kpm_ind_agg_t* agg)
+{
+  size_t i = 0;
+  while(i < seq_size(&agg->ues)){
+    kpm_agg_ue_t* ue = seq_at(&agg->ues, i);
+    if(ue->last_seq + agg->spec.win > agg->seq){
+      ++i;
+      continue;
+    }
+    free_agg_ue(ue);
+    seq_erase(&agg->ues, ue, seq_next(&agg->ues, ue));
+  }
+}
+
+static
+bool emit(kpm_ind_agg_t* agg, bool frm_3, kpm_ind_msg_t* dst)
+{
+  evict(agg);
+
+  size_t const sz = seq_size(&agg->ues);
+  if(frm_3 == false){
+    kpm_agg_ue_t* ue = find_ue(agg, NULL);
+    dst->type = FORMAT_1_INDICATION_MESSAGE;
+    return aggregate(agg, ue, &dst->frm_1);
+  } 
+
+  dst->type = FORMAT_3_INDICATION_MESSAGE;
+  kpm_ind_msg_format_3_t* m = &dst->frm_3;
+  m->meas_report_per_ue = calloc(sz, sizeof(meas_report_per_ue_t));
+  assert(m->meas_report_per_ue != NULL && "Memory exhausted");
+
+  for(size_t i = 0; i < sz; ++i){
+    kpm_agg_ue_t* ue = seq_at(&agg->ues, i);
+    if(ue->has_id == false)
+      continue;
+
+    meas_report_per_ue_t* r = &m->meas_report_per_ue[m->ue_meas_report_lst_len];
+    if(aggregate(agg, ue, &r->ind_msg_format_1) == false)
+      continue;
+    r->ue_meas_report_lst = cp_ue_id_e2sm(&ue->id);
+    m->ue_meas_report_lst_len += 1;
+  }
+
+  if(m->ue_meas_report_lst_len == 0){
+    free(m->meas_report_per_ue);
+    *m = (kpm_ind_msg_format_3_t){0};
+    return false;
+  }
+  return true;
+}
+
+bool push_kpm_ind_agg(kpm_ind_agg_t* agg, kpm_ind_msg_t* msg)
+{
+  assert(agg != NULL);
+  assert(msg != NULL);
+
+  bool const frm_3 = msg->type == FORMAT_3_INDICATION_MESSAGE;
+  if(msg->type == FORMAT_2_INDICATION_MESSAGE)
+    return false;
+
+  int rc = pthread_mutex_lock(&agg->mtx);
+  assert(rc == 0);
+
+  agg->seq += 1;
+  if(frm_3){
+    for(size_t i = 0; i < msg->frm_3.ue_meas_report_lst_len; ++i){
+      meas_report_per_ue_t const* r = &msg->frm_3.meas_report_per_ue[i];
+      consume(agg, &r->ue_meas_report_lst, &r->ind_msg_format_1);
+    }
+  } else {
+    consume(agg, NULL, &msg->frm_1);
+  }
+
+  free_kpm_ind_msg(msg);
+  *msg = (kpm_ind_msg_t){0};
+
+  bool const fwd = agg->seq % agg->spec.hop == 0 && emit(agg, frm_3, msg);
+
+  rc = pthread_mutex_unlock(&agg->mtx);
+  assert(rc == 0);
+
+  return fwd;
+}
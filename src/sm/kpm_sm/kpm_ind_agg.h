@@ -0,0 +1,110 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+
+
+#ifndef KPM_INDICATION_AGGREGATION_H
+#define KPM_INDICATION_AGGREGATION_H
+
+// Windowed aggregation of KPM Indication Messages per (UE, measurement) on 
+// behalf of an xApp. The E2 Node is implicit, as every subscription targets one.
+// Windows are counted in indications, i.e., the reporting period of the E2 Node:
+//  agg=count,mean,min,max,ewma0.2,p50,p95   Statistics computed
+//  win=10                                   Tumbling window of 10 indications
+//  win=10/2                                 Sliding window of 10 indications, emitted every 2 
+// The aggregates are forwarded as REAL records named <measurement>:<statistic>,
+// e.g., DRB.UEThpDl:p95, once per window instead of the raw indications
+
+#include "kpm_data_ie_wrapper.h"
+#include "../../util/byte_array.h"
+#include "../../util/alg_ds/ds/seq_container/seq_generic.h"
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define KPM_AGG_MAX_WIN 1024 
+#define KPM_AGG_MAX_STAT 16
+
+typedef enum{
+  COUNT_KPM_AGG,
+  MEAN_KPM_AGG,
+  MIN_KPM_AGG,
+  MAX_KPM_AGG,
+  EWMA_KPM_AGG, // param: smoothing factor in (0,1]
+  QUANTILE_KPM_AGG, // param: quantile in (0,1] 
+
+  END_KPM_AGG
+} kpm_agg_e;
+
+typedef struct{
+  byte_array_t name;
+  kpm_agg_e type;
+  double param;
+} kpm_agg_stat_t;
+
+typedef struct{
+  // Empty means no aggregation
+  size_t len_stat;
+  kpm_agg_stat_t* stat;
+
+  // Indications per window 
+  uint32_t win;
+  // Indications between two aggregates. hop == win for tumbling windows
+  uint32_t hop;
+} kpm_agg_spec_t;
+
+// Returns false if the agg= clause is malformed
+bool parse_kpm_agg_stat(char* s, kpm_agg_spec_t* dst);
+
+// Returns false if the win= clause is malformed
+bool parse_kpm_agg_win(char* s, kpm_agg_spec_t* dst);
+
+void free_kpm_agg_spec(kpm_agg_spec_t* src);
+
+typedef struct kpm_ind_agg_s{
+  kpm_agg_spec_t spec;
+
+  // Indications consumed
+  uint64_t seq;
+
+  // byte_array_t. Measurement names seen, the index identifies the series of a UE
+  seq_arr_t meas;
+
+  // kpm_agg_ue_t 
+  seq_arr_t ues;
+
+  // The iApp may apply the same filter from different threads
+  pthread_mutex_t mtx;
+} kpm_ind_agg_t;
+
+// Takes ownership of spec
+void init_kpm_ind_agg(kpm_ind_agg_t* agg, kpm_agg_spec_t spec);
+
+void free_kpm_ind_agg(kpm_ind_agg_t* agg);
+
+// Consumes msg. Returns false while the window is open. Otherwise, msg is 
+// replaced by the aggregates of the last spec->win indications.
+// Format 2 messages are not aggregated and therefore, never forwarded
+bool push_kpm_ind_agg(kpm_ind_agg_t* agg, kpm_ind_msg_t* msg);
+
+#endif
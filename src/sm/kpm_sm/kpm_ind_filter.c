@@ -0,0 +1,426 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+
+#include "kpm_ind_filter.h"
+#include "../../util/conf_file.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static
+bool parse_u64(char const* s, uint64_t* dst)
+{
+  assert(s != NULL);
+  assert(dst != NULL);
+
+  if(*s == '\0')
+    return false;
+
+  char* end = NULL;
+  unsigned long long const v = strtoull(s, &end, 10);
+  if(*end != '\0')
+    return false;
+
+  *dst = v;
+  return true;
+}
+
+static
+bool parse_meas(char* s, kpm_ind_filter_t* dst)
+{
+  char* save = NULL;
+  for(char* it = strtok_r(s, ",", &save); it != NULL; it = strtok_r(NULL, ",", &save)){
+    dst->meas = realloc(dst->meas, (dst->len_meas + 1)*sizeof(byte_array_t));
+    assert(dst->meas != NULL && "Memory exhausted");
+    dst->meas[dst->len_meas] = cp_str_to_ba(it);
+    dst->len_meas += 1;
+  }
+  return dst->len_meas > 0;
+}
+
+static
+bool parse_ue(char* s, kpm_ind_filter_t* dst)
+{
+  char* save = NULL;
+  for(char* it = strtok_r(s, ",", &save); it != NULL; it = strtok_r(NULL, ",", &save)){
+    kpm_ue_range_t r = {0};
+    char* dash = strchr(it, '-');
+    if(dash != NULL){
+      *dash = '\0';
+      if(parse_u64(it, &r.lo) == false || parse_u64(dash + 1, &r.hi) == false || r.lo > r.hi)
+        return false;
+    } else {
+      if(parse_u64(it, &r.lo) == false)
+        return false;
+      r.hi = r.lo;
+    }
+
+    dst->ue = realloc(dst->ue, (dst->len_ue + 1)*sizeof(kpm_ue_range_t));
+    assert(dst->ue != NULL && "Memory exhausted");
+    dst->ue[dst->len_ue] = r;
+    dst->len_ue += 1;
+  }
+  return dst->len_ue > 0;
+}
+
+static
+bool parse_op(char const* s, kpm_pred_op_e* op, size_t* len)
+{
+  static char const* const str[END_KPM_PRED] = {"<", "<=", ">", ">=", "==", "!="};
+
+  // Reverse order, so "<=" is tried before "<"
+  for(int i = END_KPM_PRED - 1; i > -1; --i){
+    size_t const sz = strlen(str[i]);
+    if(strncmp(s, str[i], sz) == 0){
+      *op = i;
+      *len = sz;
+      return true;
+    }
+  }
+  return false;
+}
+
+static
+bool parse_pred(char* s, kpm_ind_filter_t* dst)
+{
+  char* save = NULL;
+  for(char* it = strtok_r(s, ",", &save); it != NULL; it = strtok_r(NULL, ",", &save)){
+    size_t const pos = strcspn(it, "<>=!");
+    if(pos == 0 || it[pos] == '\0')
+      return false;
+
+    kpm_pred_t p = {0};
+    size_t len_op = 0;
+    if(parse_op(it + pos, &p.op, &len_op) == false)
+      return false;
+
+    char const* val = it + pos + len_op;
+    char* end = NULL;
+    p.val = strtod(val, &end);
+    if(end == val || *end != '\0')
+      return false;
+
+    it[pos] = '\0';
+    p.name = cp_str_to_ba(it);
+
+    dst->pred = realloc(dst->pred, (dst->len_pred + 1)*sizeof(kpm_pred_t));
+    assert(dst->pred != NULL && "Memory exhausted");
+    dst->pred[dst->len_pred] = p;
+    dst->len_pred += 1;
+  }
+  return dst->len_pred > 0;
+}
+
+typedef struct{
+  kpm_ind_filter_t* dst;
+  kpm_agg_spec_t spec;
+} filter_conf_t;
+
+static
+bool parse_filter_opt(char* key, char* val, void* data)
+{
+  filter_conf_t* f = (filter_conf_t*)data;
+  kpm_ind_filter_t* dst = f->dst;
+
+  if(strcmp(key, "meas") == 0 && dst->len_meas == 0)
+    return parse_meas(val, dst);
+  if(strcmp(key, "ue") == 0 && dst->len_ue == 0)
+    return parse_ue(val, dst);
+  if(strcmp(key, "pred") == 0 && dst->len_pred == 0)
+    return parse_pred(val, dst);
+  if(strcmp(key, "agg") == 0 && f->spec.len_stat == 0)
+    return parse_kpm_agg_stat(val, &f->spec);
+  if(strcmp(key, "win") == 0 && f->spec.win == 0)
+    return parse_kpm_agg_win(val, &f->spec);
+
+  return false;
+}
+
+bool parse_kpm_ind_filter(byte_array_t src, kpm_ind_filter_t* dst)
+{
+  assert(dst != NULL);
+
+  *dst = (kpm_ind_filter_t){0};
+
+  filter_conf_t f = {.dst = dst};
+  bool ok = parse_kv_conf(src.len, (char const*)src.buf, parse_filter_opt, &f);
+  kpm_agg_spec_t spec = f.spec;
+
+  // Statistics and window go together
+  if(ok == true && (spec.len_stat > 0) != (spec.win > 0))
+    ok = false;
+
+  if(ok == true && spec.len_stat > 0){
+    dst->agg = calloc(1, sizeof(kpm_ind_agg_t));
+    assert(dst->agg != NULL && "Memory exhausted");
+    init_kpm_ind_agg(dst->agg, spec);
+  } else {
+    free_kpm_agg_spec(&spec);
+  }
+
+  if(ok == false){
+    printf("[KPM SM]: Malformed indication filter %.*s \n", (int)src.len, (char const*)src.buf);
+    free_kpm_ind_filter(dst);
+  }
+
+  return ok;
+}
+
+void free_kpm_ind_filter(kpm_ind_filter_t* src)
+{
+  assert(src != NULL);
+
+  for(size_t i = 0; i < src->len_meas; ++i)
+    free_byte_array(src->meas[i]);
+  free(src->meas);
+
+  free(src->ue);
+
+  for(size_t i = 0; i < src->len_pred; ++i)
+    free_byte_array(src->pred[i].name);
+  free(src->pred);
+
+  if(src->agg != NULL){
+    free_kpm_ind_agg(src->agg);
+    free(src->agg);
+  }
+
+  *src = (kpm_ind_filter_t){0};
+}
+
+static
+bool match_name(byte_array_t const* pattern, byte_array_t const* name)
+{
+  size_t const len = pattern->len;
+  if(len > 0 && pattern->buf[len - 1] == '*')
+    return name->len >= len - 1 && memcmp(pattern->buf, name->buf, len - 1) == 0;
+
+  return eq_byte_array(pattern, name);
+}
+
+static
+bool keep_meas(kpm_ind_filter_t const* f, meas_type_t const* t)
+{
+  if(f->len_meas == 0)
+    return true;
+
+  // The names of the measurements sent by ID are not known here
+  if(t->type != NAME_MEAS_TYPE)
+    return false;
+
+  for(size_t i = 0; i < f->len_meas; ++i){
+    if(match_name(&f->meas[i], &t->name) == true)
+      return true;
+  }
+  return false;
+}
+
+static
+bool eval_pred(kpm_pred_t const* p, meas_record_lst_t const* r)
+{
+  double v = 0;
+  if(r->value == INTEGER_MEAS_VALUE)
+    v = r->int_val;
+  else if(r->value == REAL_MEAS_VALUE)
+    v = r->real_val;
+  else
+    return false;
+
+  switch(p->op){
+    case LT_KPM_PRED: return v < p->val;
+    case LE_KPM_PRED: return v <= p->val;
+    case GT_KPM_PRED: return v > p->val;
+    case GE_KPM_PRED: return v >= p->val;
+    case EQ_KPM_PRED: return v == p->val;
+    case NE_KPM_PRED: return v != p->val;
+    default: assert(0!=0 && "Unknown predicate");
+  }
+  return false;
+}
+
+static
+bool keep_ue_id(kpm_ind_filter_t const* f, ue_id_e2sm_t const* ue)
+{
+  if(f->len_ue == 0)
+    return true;
+
+  uint64_t const id = num_ue_id_e2sm(ue);
+
+  for(size_t i = 0; i < f->len_ue; ++i){
+    if(f->ue[i].lo <= id && id <= f->ue[i].hi)
+      return true;
+  }
+  return false;
+}
+
+static
+void free_meas_data(meas_data_lst_t* src)
+{
+  free(src->meas_record_lst);
+  free(src->incomplete_flag);
+}
+
+static
+bool filter_records(kpm_ind_filter_t const* f, kpm_ind_msg_format_1_t* m)
+{
+  size_t const cols = m->meas_info_lst_len;
+
+  // Without Measurement Information the records can not be named
+  if(cols == 0)
+    return true;
+
+  size_t* pred_col = NULL;
+  if(f->len_pred > 0){
+    pred_col = calloc(f->len_pred, sizeof(size_t));
+    assert(pred_col != NULL && "Memory exhausted");
+  }
+
+  bool ok = true;
+  for(size_t i = 0; i < f->len_pred && ok == true; ++i){
+    pred_col[i] = cols;
+    for(size_t j = 0; j < cols; ++j){
+      meas_type_t const* t = &m->meas_info_lst[j].meas_type;
+      if(t->type == NAME_MEAS_TYPE && eq_byte_array(&t->name, &f->pred[i].name) == true){
+        pred_col[i] = j;
+        break;
+      }
+    }
+    // A predicate over an absent measurement never holds
+    ok = pred_col[i] != cols;
+  }
+
+  // Rows
+  size_t len = 0;
+  for(size_t i = 0; i < m->meas_data_lst_len; ++i){
+    meas_data_lst_t* d = &m->meas_data_lst[i];
+    bool keep = ok && d->meas_record_len == cols;
+    for(size_t j = 0; j < f->len_pred && keep == true; ++j)
+      keep = eval_pred(&f->pred[j], &d->meas_record_lst[pred_col[j]]);
+
+    if(keep == true)
+      m->meas_data_lst[len++] = *d;
+    else
+      free_meas_data(d);
+  }
+  m->meas_data_lst_len = len;
+  free(pred_col);
+
+  if(len == 0)
+    return false;
+
+  // Columns
+  size_t kept = 0;
+  bool* keep = calloc(cols, sizeof(bool));
+  assert(keep != NULL && "Memory exhausted");
+  for(size_t j = 0; j < cols; ++j){
+    keep[j] = keep_meas(f, &m->meas_info_lst[j].meas_type);
+    kept += keep[j];
+  }
+
+  if(kept < cols){
+    for(size_t i = 0; i < m->meas_data_lst_len; ++i){
+      meas_data_lst_t* d = &m->meas_data_lst[i];
+      size_t pos = 0;
+      for(size_t j = 0; j < cols; ++j){
+        if(keep[j] == true)
+          d->meas_record_lst[pos++] = d->meas_record_lst[j];
+      }
+      d->meas_record_len = pos;
+    }
+
+    size_t pos = 0;
+    for(size_t j = 0; j < cols; ++j){
+      if(keep[j] == true)
+        m->meas_info_lst[pos++] = m->meas_info_lst[j];
+      else
+        free_meas_info_frm_1(&m->meas_info_lst[j]);
+    }
+    m->meas_info_lst_len = pos;
+  }
+  free(keep);
+
+  return kept > 0;
+}
+
+static
+bool filter_ues(kpm_ind_filter_t const* f, kpm_ind_msg_format_3_t* m)
+{
+  size_t len = 0;
+  for(size_t i = 0; i < m->ue_meas_report_lst_len; ++i){
+    meas_report_per_ue_t* r = &m->meas_report_per_ue[i];
+    if(keep_ue_id(f, &r->ue_meas_report_lst) == true && filter_records(f, &r->ind_msg_format_1) == true){
+      m->meas_report_per_ue[len++] = *r;
+    } else {
+      free_ue_id_e2sm(&r->ue_meas_report_lst);
+      free_kpm_ind_msg_frm_1(&r->ind_msg_format_1);
+    }
+  }
+  m->ue_meas_report_lst_len = len;
+
+  return len > 0;
+}
+
+bool apply_kpm_ind_filter(kpm_ind_filter_t* f, kpm_ind_msg_t* msg)
+{
+  assert(f != NULL);
+  assert(msg != NULL);
+
+  bool fwd = true;
+  if(msg->type == FORMAT_1_INDICATION_MESSAGE)
+    fwd = filter_records(f, &msg->frm_1);
+  else if(msg->type == FORMAT_3_INDICATION_MESSAGE)
+    fwd = filter_ues(f, &msg->frm_3);
+
+  // An indication without surviving records still advances the window
+  if(f->agg != NULL)
+    return push_kpm_ind_agg(f->agg, msg);
+
+  return fwd;
+}
+
+byte_array_t conflate_key_kpm_ind_msg(kpm_ind_msg_t const* msg)
+{
+  assert(msg != NULL);
+
+  if(msg->type != FORMAT_3_INDICATION_MESSAGE || msg->frm_3.ue_meas_report_lst_len == 0)
+    return (byte_array_t){0};
+
+  kpm_ind_msg_format_3_t const* m = &msg->frm_3;
+
+  // "ue/<type>/<id>," per UE
+  size_t const max_len = m->ue_meas_report_lst_len*32;
+  char* str = calloc(max_len, sizeof(char));
+  assert(str != NULL && "Memory exhausted");
+
+  size_t len = 0;
+  for(size_t i = 0; i < m->ue_meas_report_lst_len; ++i){
+    ue_id_e2sm_t const* ue = &m->meas_report_per_ue[i].ue_meas_report_lst;
+    int const n = snprintf(str + len, max_len - len, "%sue/%d/%lu", i == 0 ? "" : ",", ue->type, num_ue_id_e2sm(ue));
+    assert(n > 0 && (size_t)n < max_len - len);
+    len += n;
+  }
+
+  byte_array_t const key = {.buf = (uint8_t*)str, .len = len};
+  return key;
+}
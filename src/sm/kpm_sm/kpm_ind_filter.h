@@ -0,0 +1,95 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+
+#ifndef KPM_INDICATION_FILTER_H
+#define KPM_INDICATION_FILTER_H
+
+// Filter and projection of KPM Indication Messages on behalf of an xApp.
+// Textual form, clauses separated by ';', all of them optional:
+//  meas=DRB.UEThpDl,RRU.PrbUsed*   Measurement names kept. A trailing '*' matches a prefix
+//  ue=1-20,33                      UE ids kept (Format 3)
+//  pred=DRB.UEThpDl>1000,...       Every predicate must hold for a record to be kept
+//  agg=mean,p95;win=10/2           Windowed aggregates instead of raw records, see kpm_ind_agg.h
+// Predicates are evaluated before the projection, so they may reference
+// measurements that are not forwarded
+
+#include "kpm_data_ie_wrapper.h"
+#include "kpm_ind_agg.h"
+#include "../../util/byte_array.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef enum{
+  LT_KPM_PRED,
+  LE_KPM_PRED,
+  GT_KPM_PRED,
+  GE_KPM_PRED,
+  EQ_KPM_PRED,
+  NE_KPM_PRED,
+
+  END_KPM_PRED
+} kpm_pred_op_e;
+
+typedef struct{
+  byte_array_t name;
+  kpm_pred_op_e op;
+  double val;
+} kpm_pred_t;
+
+typedef struct{
+  uint64_t lo;
+  uint64_t hi;
+} kpm_ue_range_t;
+
+typedef struct{
+  // Empty means every measurement
+  size_t len_meas;
+  byte_array_t* meas;
+
+  // Empty means every UE
+  size_t len_ue;
+  kpm_ue_range_t* ue;
+
+  size_t len_pred;
+  kpm_pred_t* pred;
+
+  // NULL without agg= clause
+  kpm_ind_agg_t* agg;
+} kpm_ind_filter_t;
+
+// Returns false if src is malformed
+bool parse_kpm_ind_filter(byte_array_t src, kpm_ind_filter_t* dst);
+
+void free_kpm_ind_filter(kpm_ind_filter_t* src);
+
+// Filters and projects msg in place. Returns false if no record survived, 
+// i.e., the message should not be forwarded. Format 2 messages are kept untouched.
+// With aggregation, msg is replaced by the aggregates once a window closes
+bool apply_kpm_ind_filter(kpm_ind_filter_t* f, kpm_ind_msg_t* msg);
+
+// Conflation key of msg for slow xApps, i.e., the UEs reported by a Format 3
+// message, e.g., "ue/0/7,ue/0/9". Empty for reports on the whole E2 Node
+byte_array_t conflate_key_kpm_ind_msg(kpm_ind_msg_t const* msg);
+
+#endif
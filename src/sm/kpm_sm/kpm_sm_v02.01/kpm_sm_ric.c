@@ -26,6 +26,7 @@
 #include "enc/kpm_enc_generic.h"
 #include "dec/kpm_dec_generic.h"
 #include "kpm_sm_id.h"
+#include "../kpm_ind_filter.h"
 
 #include <assert.h>
 #include <stdlib.h>
@@ -137,6 +138,67 @@ sm_ag_if_rd_rsu_t on_ric_service_update_kpm_sm_ric(sm_ric_t const* sm_ric, sm_ri
   return ret;
 }
 
+static
+void* compile_filter_kpm_sm_ric(sm_ric_t const* sm_ric, byte_array_t src)
+{
+  assert(sm_ric != NULL);
+
+  kpm_ind_filter_t* f = calloc(1, sizeof(kpm_ind_filter_t));
+  assert(f != NULL && "Memory exhausted");
+
+  if(parse_kpm_ind_filter(src, f) == false){
+    free(f);
+    return NULL;
+  }
+
+  return f;
+}
+
+static
+bool apply_filter_kpm_sm_ric(sm_ric_t const* sm_ric, void* filter, sm_ind_data_t const* src, byte_array_t* dst)
+{
+  assert(sm_ric != NULL);
+  assert(filter != NULL);
+  assert(src != NULL);
+  assert(dst != NULL);
+
+  sm_kpm_ric_t* sm = (sm_kpm_ric_t*)sm_ric;
+
+  kpm_ind_msg_t msg = kpm_dec_ind_msg(&sm->enc, src->len_msg, src->ind_msg);
+  defer({ free_kpm_ind_msg(&msg); });
+
+  if(apply_kpm_ind_filter(filter, &msg) == false)
+    return false;
+
+  *dst = kpm_enc_ind_msg(&sm->enc, &msg);
+  return true;
+}
+
+static
+void free_filter_kpm_sm_ric(sm_ric_t const* sm_ric, void* filter)
+{
+  assert(sm_ric != NULL);
+  assert(filter != NULL);
+
+  free_kpm_ind_filter(filter);
+  free(filter);
+}
+
+// The message has to be decoded, as the header does not name the UE
+static
+byte_array_t ind_key_kpm_sm_ric(sm_ric_t const* sm_ric, sm_ind_data_t const* src)
+{
+  assert(sm_ric != NULL);
+  assert(src != NULL);
+
+  sm_kpm_ric_t* sm = (sm_kpm_ric_t*)sm_ric;
+
+  kpm_ind_msg_t msg = kpm_dec_ind_msg(&sm->enc, src->len_msg, src->ind_msg);
+  defer({ free_kpm_ind_msg(&msg); });
+
+  return conflate_key_kpm_ind_msg(&msg);
+}
+
 void free_kpm_sm_ric(sm_ric_t* sm_ric)
 {
   assert(sm_ric != NULL);
@@ -172,9 +234,19 @@ sm_ric_t* make_kpm_sm_ric(void)
   sm->base.proc.on_e2_setup = on_e2_setup_kpm_sm_ric;
   sm->base.proc.on_ric_service_update = on_ric_service_update_kpm_sm_ric; 
 
+  // Indication filters on behalf of the xApps
+  sm->base.filter.compile = compile_filter_kpm_sm_ric;
+  sm->base.filter.apply = apply_filter_kpm_sm_ric;
+  sm->base.filter.free = free_filter_kpm_sm_ric;
+
+  // Conflation of the indications for slow xApps
+  sm->base.conflate.key = ind_key_kpm_sm_ric;
+
   assert(strlen(SM_KPM_STR) < sizeof( sm->base.ran_func_name) );
   memcpy(sm->base.ran_func_name, SM_KPM_STR, strlen(SM_KPM_STR)); 
 
+  sm->base.enc = SM_ENC_COMPILED;
+
   return &sm->base;
 }
 
@@ -335,6 +407,8 @@ sm_ric_t* make_kpm_sm_ric()
   assert(strlen(SM_KPM_STR) < sizeof( sm->base.ran_func_name) );
   memcpy(sm->base.ran_func_name, SM_KPM_STR, strlen(SM_KPM_STR)); 
 
+  sm->base.enc = SM_ENC_COMPILED;
+
   return &sm->base;
 }
 */
@@ -0,0 +1,330 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+
+
+#include "../kpm_ind_filter.h"
+#include "../kpm_ind_agg.h"
+#include "../kpm_sm_id_wrapper.h"
+#include "../../sm_ric.h"
+#include "../../../util/alg_ds/alg/eq_float.h"
+
+#ifdef KPM_V2_01
+#include "../kpm_sm_v02.01/kpm_sm_ric.h"
+#include "../kpm_sm_v02.01/enc/kpm_enc_asn.h"
+#include "../kpm_sm_v02.01/dec/kpm_dec_asn.h"
+#elif defined(KPM_V2_03)
+#include "../kpm_sm_v02.03/kpm_sm_ric.h"
+#include "../kpm_sm_v02.03/enc/kpm_enc_asn.h"
+#include "../kpm_sm_v02.03/dec/kpm_dec_asn.h"
+#elif defined(KPM_V3_00)
+#include "../kpm_sm_v03.00/kpm_sm_ric.h"
+#include "../kpm_sm_v03.00/enc/kpm_enc_asn.h"
+#include "../kpm_sm_v03.00/dec/kpm_dec_asn.h"
+#endif
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Deterministic synthetic streams: one record per measurement and indication
+static
+kpm_ind_msg_format_1_t gen_frm_1(size_t num_meas, char const* name[], int64_t const val[])
+{
+  kpm_ind_msg_format_1_t dst = {0};
+
+  dst.meas_info_lst_len = num_meas;
+  dst.meas_info_lst = calloc(num_meas, sizeof(meas_info_format_1_lst_t));
+  assert(dst.meas_info_lst != NULL && "Memory exhausted");
+
+  dst.meas_data_lst_len = 1;
+  dst.meas_data_lst = calloc(1, sizeof(meas_data_lst_t));
+  assert(dst.meas_data_lst != NULL && "Memory exhausted");
+  dst.meas_data_lst[0].meas_record_len = num_meas;
+  dst.meas_data_lst[0].meas_record_lst = calloc(num_meas, sizeof(meas_record_lst_t));
+  assert(dst.meas_data_lst[0].meas_record_lst != NULL && "Memory exhausted");
+
+  for(size_t i = 0; i < num_meas; ++i){
+    meas_info_format_1_lst_t* info = &dst.meas_info_lst[i];
+    info->meas_type.type = NAME_MEAS_TYPE;
+    info->meas_type.name = cp_str_to_ba(name[i]);
+    info->label_info_lst_len = 1;
+    info->label_info_lst = calloc(1, sizeof(label_info_lst_t));
+    assert(info->label_info_lst != NULL && "Memory exhausted");
+    info->label_info_lst[0].noLabel = malloc(sizeof(enum_value_e));
+    assert(info->label_info_lst[0].noLabel != NULL && "Memory exhausted");
+    *info->label_info_lst[0].noLabel = TRUE_ENUM_VALUE;
+
+    meas_record_lst_t* r = &dst.meas_data_lst[0].meas_record_lst[i];
+    if(val[i] < 0){
+      r->value = NO_VALUE_MEAS_VALUE;
+    } else {
+      r->value = INTEGER_MEAS_VALUE;
+      r->int_val = val[i];
+    }
+  }
+
+  return dst;
+}
+
+static
+kpm_ind_msg_t gen_frm_1_msg(int64_t a, int64_t b)
+{
+  char const* name[] = {"A", "B"};
+  int64_t const val[] = {a, b};
+  kpm_ind_msg_t dst = {.type = FORMAT_1_INDICATION_MESSAGE};
+  dst.frm_1 = gen_frm_1(2, name, val);
+  return dst;
+}
+
+// UE i reports A = i*100 + seq
+static
+kpm_ind_msg_t gen_frm_3_msg(size_t num_ue, uint64_t const ue_id[], int64_t seq)
+{
+  kpm_ind_msg_t dst = {.type = FORMAT_3_INDICATION_MESSAGE};
+
+  dst.frm_3.ue_meas_report_lst_len = num_ue;
+  dst.frm_3.meas_report_per_ue = calloc(num_ue, sizeof(meas_report_per_ue_t));
+  assert(dst.frm_3.meas_report_per_ue != NULL && "Memory exhausted");
+
+  for(size_t i = 0; i < num_ue; ++i){
+    meas_report_per_ue_t* r = &dst.frm_3.meas_report_per_ue[i];
+    r->ue_meas_report_lst.type = GNB_UE_ID_E2SM;
+    r->ue_meas_report_lst.gnb.amf_ue_ngap_id = ue_id[i];
+    r->ue_meas_report_lst.gnb.guami.plmn_id = (e2sm_plmn_t){.mcc = 1, .mnc = 1, .mnc_digit_len = 2};
+    r->ue_meas_report_lst.gnb.guami.amf_region_id = 128;
+    r->ue_meas_report_lst.gnb.guami.amf_set_id = 1;
+    r->ue_meas_report_lst.gnb.guami.amf_ptr = 1;
+
+    char const* name[] = {"A"};
+    int64_t const val[] = {ue_id[i]*100 + seq};
+    r->ind_msg_format_1 = gen_frm_1(1, name, val);
+  }
+
+  return dst;
+}
+
+static
+kpm_ind_filter_t parse(const char* str)
+{
+  kpm_ind_filter_t f = {0};
+  byte_array_t ba = cp_str_to_ba(str);
+  bool const ok = parse_kpm_ind_filter(ba, &f);
+  assert(ok == true);
+  free_byte_array(ba);
+  return f;
+}
+
+// Value of the aggregate named name, e.g., A:mean. Asserts if not present
+static
+double agg_val(kpm_ind_msg_format_1_t const* m, char const* name)
+{
+  assert(m->meas_data_lst_len == 1);
+  byte_array_t ba = {.len = strlen(name), .buf = (uint8_t*)name};
+  for(size_t i = 0; i < m->meas_info_lst_len; ++i){
+    if(eq_byte_array(&m->meas_info_lst[i].meas_type.name, &ba)){
+      meas_record_lst_t const* r = &m->meas_data_lst[0].meas_record_lst[i];
+      assert(r->value == REAL_MEAS_VALUE);
+      return r->real_val;
+    }
+  }
+  assert(0 != 0 && "Aggregate not found");
+  return 0.0;
+}
+
+static
+void test_parse(void)
+{
+  char const* bad[] = {"agg=mean", "win=4", "agg=foo;win=2", "agg=p0;win=2", "agg=p101;win=2", "agg=ewma;win=2", 
+                       "agg=ewma1.5;win=2", "agg=mean;win=2/3", "agg=mean;win=0", "agg=mean;win=2000", "agg=mean;win=4/", 
+                       "agg=mean;win=a", "agg=mean;agg=max;win=2"};
+  for(size_t i = 0; i < sizeof(bad)/sizeof(bad[0]); ++i){
+    kpm_ind_filter_t f = {0};
+    byte_array_t ba = cp_str_to_ba(bad[i]);
+    assert(parse_kpm_ind_filter(ba, &f) == false);
+    assert(f.agg == NULL);
+    free_byte_array(ba);
+  }
+
+  kpm_ind_filter_t f = parse("meas=A;agg=count,mean,min,max,ewma0.25,p99.9;win=8/2");
+  assert(f.agg != NULL);
+  kpm_agg_spec_t const* s = &f.agg->spec;
+  assert(s->win == 8 && s->hop == 2 && s->len_stat == 6);
+  assert(s->stat[4].type == EWMA_KPM_AGG && eq_float(s->stat[4].param, 0.25, 0.000001));
+  assert(s->stat[5].type == QUANTILE_KPM_AGG && eq_float(s->stat[5].param, 0.999, 0.000001));
+  free_kpm_ind_filter(&f);
+
+  f = parse("meas=A");
+  assert(f.agg == NULL);
+  free_kpm_ind_filter(&f);
+}
+
+// A = 1,2,...,8 in a tumbling window of 4 indications. B is never reported
+static
+void test_tumbling(void)
+{
+  kpm_ind_filter_t f = parse("agg=count,mean,min,max,p50,p100,ewma0.5;win=4");
+
+  for(int64_t seq = 1; seq <= 8; ++seq){
+    kpm_ind_msg_t msg = gen_frm_1_msg(seq, -1);
+    bool const fwd = apply_kpm_ind_filter(&f, &msg);
+    assert(fwd == (seq % 4 == 0));
+    if(fwd == false)
+      continue;
+
+    assert(msg.type == FORMAT_1_INDICATION_MESSAGE);
+    // 7 statistics of A, none of B
+    assert(msg.frm_1.meas_info_lst_len == 7);
+
+    double const first = seq - 3;
+    assert(eq_float(agg_val(&msg.frm_1, "A:count"), 4, 0.000001));
+    assert(eq_float(agg_val(&msg.frm_1, "A:mean"), first + 1.5, 0.000001));
+    assert(eq_float(agg_val(&msg.frm_1, "A:min"), first, 0.000001));
+    assert(eq_float(agg_val(&msg.frm_1, "A:max"), seq, 0.000001));
+    // Nearest rank: ceil(0.5 * 4) = 2nd smallest
+    assert(eq_float(agg_val(&msg.frm_1, "A:p50"), first + 1, 0.000001));
+    assert(eq_float(agg_val(&msg.frm_1, "A:p100"), seq, 0.000001));
+    // The EWMA is not reset between windows: 1, 1.5, 2.25, 3.125, 4.0625, 5.03125, 6.015625, 7.0078125
+    double const ewma = seq == 4 ? 3.125 : 7.0078125;
+    assert(eq_float(agg_val(&msg.frm_1, "A:ewma0.5"), ewma, 0.000001));
+
+    free_kpm_ind_msg(&msg);
+  }
+
+  free_kpm_ind_filter(&f);
+}
+
+// A = 1,2,...,10 and B = 10*A in a sliding window of 4 indications, emitted every 2
+static
+void test_sliding(void)
+{
+  kpm_ind_filter_t f = parse("agg=count,mean,p75;win=4/2");
+
+  for(int64_t seq = 1; seq <= 10; ++seq){
+    kpm_ind_msg_t msg = gen_frm_1_msg(seq, 10*seq);
+    bool const fwd = apply_kpm_ind_filter(&f, &msg);
+    assert(fwd == (seq % 2 == 0));
+    if(fwd == false)
+      continue;
+
+    assert(msg.frm_1.meas_info_lst_len == 6);
+
+    // The first window is not full yet
+    int64_t const first = seq > 4 ? seq - 3 : 1;
+    double const n = seq - first + 1;
+    assert(eq_float(agg_val(&msg.frm_1, "A:count"), n, 0.000001));
+    assert(eq_float(agg_val(&msg.frm_1, "A:mean"), (first + seq) / 2.0, 0.000001));
+    assert(eq_float(agg_val(&msg.frm_1, "B:mean"), 10.0*(first + seq) / 2.0, 0.000001));
+    // ceil(0.75*2) = 2nd, ceil(0.75*4) = 3rd smallest
+    double const p75 = seq == 2 ? 2 : seq - 1;
+    assert(eq_float(agg_val(&msg.frm_1, "A:p75"), p75, 0.000001));
+
+    free_kpm_ind_msg(&msg);
+  }
+
+  free_kpm_ind_filter(&f);
+}
+
+// UEs 1,2 and 3 report, then UE 2 leaves. UE 3 is filtered out
+static
+void test_per_ue(void)
+{
+  kpm_ind_filter_t f = parse("ue=1-2;agg=max,count;win=2");
+
+  uint64_t const ue_all[] = {1, 2, 3};
+  uint64_t const ue_left[] = {1, 3};
+
+  for(int64_t seq = 1; seq <= 6; ++seq){
+    kpm_ind_msg_t msg = seq <= 2 ? gen_frm_3_msg(3, ue_all, seq) : gen_frm_3_msg(2, ue_left, seq);
+    bool const fwd = apply_kpm_ind_filter(&f, &msg);
+    assert(fwd == (seq % 2 == 0));
+    if(fwd == false)
+      continue;
+
+    assert(msg.type == FORMAT_3_INDICATION_MESSAGE);
+    kpm_ind_msg_format_3_t const* m = &msg.frm_3;
+    assert(m->ue_meas_report_lst_len == (seq == 2 ? 2 : 1));
+    for(size_t i = 0; i < m->ue_meas_report_lst_len; ++i){
+      uint64_t const id = m->meas_report_per_ue[i].ue_meas_report_lst.gnb.amf_ue_ngap_id;
+      assert(id == i + 1);
+      assert(eq_float(agg_val(&m->meas_report_per_ue[i].ind_msg_format_1, "A:max"), id*100 + seq, 0.000001));
+      assert(eq_float(agg_val(&m->meas_report_per_ue[i].ind_msg_format_1, "A:count"), 2, 0.000001));
+    }
+    // UE 2 was evicted, not only hidden
+    if(seq > 4)
+      assert(seq_size(&f.agg->ues) == 1);
+
+    free_kpm_ind_msg(&msg);
+  }
+
+  free_kpm_ind_filter(&f);
+}
+
+// Through the SM filter interface, as the iApp does: 1 aggregated indication every 4
+static
+void test_sm_ric(void)
+{
+  sm_ric_t* sm = make_kpm_sm_ric();
+
+  byte_array_t str = cp_str_to_ba("meas=A;agg=mean,p50;win=4");
+  void* f = sm->filter.compile(sm, str);
+  assert(f != NULL);
+  free_byte_array(str);
+
+  uint64_t const ue_id[] = {7, 8};
+  size_t fwd = 0;
+  for(int64_t seq = 1; seq <= 16; ++seq){
+    kpm_ind_msg_t msg = gen_frm_3_msg(2, ue_id, seq);
+    byte_array_t ba = kpm_enc_ind_msg_asn(&msg);
+    free_kpm_ind_msg(&msg);
+
+    sm_ind_data_t src = {.ind_msg = ba.buf, .len_msg = ba.len};
+    byte_array_t out = {0};
+    if(sm->filter.apply(sm, f, &src, &out) == true){
+      fwd += 1;
+      kpm_ind_msg_t agg = kpm_dec_ind_msg_asn(out.len, out.buf);
+      assert(agg.type == FORMAT_3_INDICATION_MESSAGE);
+      assert(agg.frm_3.ue_meas_report_lst_len == 2);
+      double const mean = agg_val(&agg.frm_3.meas_report_per_ue[1].ind_msg_format_1, "A:mean");
+      assert(eq_float(mean, 800 + seq - 1.5, 0.000001));
+      free_kpm_ind_msg(&agg);
+      free_byte_array(out);
+    }
+    free_byte_array(ba);
+  }
+  assert(fwd == 4);
+
+  sm->filter.free(sm, f);
+  sm->free_sm(sm);
+}
+
+int main()
+{
+  test_parse();
+  test_tumbling();
+  test_sliding();
+  test_per_ue();
+  test_sm_ric();
+
+  printf("Success\n");
+  return EXIT_SUCCESS;
+}
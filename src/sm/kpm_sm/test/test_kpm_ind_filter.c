@@ -0,0 +1,317 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+
+#include "../kpm_ind_filter.h"
+#include "../kpm_sm_id_wrapper.h"
+#include "../../sm_ric.h"
+#include "../../../util/time_now_us.h"
+
+#ifdef KPM_V2_01
+#include "../kpm_sm_v02.01/kpm_sm_ric.h"
+#include "../kpm_sm_v02.01/enc/kpm_enc_asn.h"
+#include "../kpm_sm_v02.01/dec/kpm_dec_asn.h"
+#elif defined(KPM_V2_03)
+#include "../kpm_sm_v02.03/kpm_sm_ric.h"
+#include "../kpm_sm_v02.03/enc/kpm_enc_asn.h"
+#include "../kpm_sm_v02.03/dec/kpm_dec_asn.h"
+#elif defined(KPM_V3_00)
+#include "../kpm_sm_v03.00/kpm_sm_ric.h"
+#include "../kpm_sm_v03.00/enc/kpm_enc_asn.h"
+#include "../kpm_sm_v03.00/dec/kpm_dec_asn.h"
+#endif
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static
+const char* meas_name[] = { "DRB.UEThpDl", "DRB.UEThpUl", "DRB.RlcSduDelayDl", "DRB.PdcpSduVolumeDL", 
+                            "DRB.PdcpSduVolumeUL", "RRU.PrbTotDl", "RRU.PrbTotUl", "L3servingSINR3gpp_cell", 
+                            "L3servingRSRP", "L3servingRSRQ", "L3neighSINR3gpp_cell_1", "L3neighSINR3gpp_cell_2"};
+
+static
+size_t const num_meas = sizeof(meas_name)/sizeof(meas_name[0]);
+
+static
+kpm_ind_msg_format_1_t gen_frm_1(uint32_t seed)
+{
+  kpm_ind_msg_format_1_t dst = {0};
+
+  dst.meas_info_lst_len = num_meas;
+  dst.meas_info_lst = calloc(num_meas, sizeof(meas_info_format_1_lst_t));
+  assert(dst.meas_info_lst != NULL && "Memory exhausted");
+
+  dst.meas_data_lst_len = 1;
+  dst.meas_data_lst = calloc(1, sizeof(meas_data_lst_t));
+  assert(dst.meas_data_lst != NULL && "Memory exhausted");
+  dst.meas_data_lst[0].meas_record_len = num_meas;
+  dst.meas_data_lst[0].meas_record_lst = calloc(num_meas, sizeof(meas_record_lst_t));
+  assert(dst.meas_data_lst[0].meas_record_lst != NULL && "Memory exhausted");
+
+  for(size_t i = 0; i < num_meas; ++i){
+    meas_info_format_1_lst_t* info = &dst.meas_info_lst[i];
+    info->meas_type.type = NAME_MEAS_TYPE;
+    info->meas_type.name = cp_str_to_ba(meas_name[i]);
+    info->label_info_lst_len = 1;
+    info->label_info_lst = calloc(1, sizeof(label_info_lst_t));
+    assert(info->label_info_lst != NULL && "Memory exhausted");
+    info->label_info_lst[0].noLabel = malloc(sizeof(enum_value_e));
+    assert(info->label_info_lst[0].noLabel != NULL && "Memory exhausted");
+    *info->label_info_lst[0].noLabel = TRUE_ENUM_VALUE;
+
+    meas_record_lst_t* r = &dst.meas_data_lst[0].meas_record_lst[i];
+    if(i % 2 == 0){
+      r->value = INTEGER_MEAS_VALUE;
+      r->int_val = (seed * 37 + i) % 1000; 
+    } else {
+      r->value = REAL_MEAS_VALUE;
+      r->real_val = ((seed * 37 + i) % 1000) / 10.0; 
+    }
+  }
+
+  return dst;
+}
+
+// Format 3, i.e., one Format 1 per UE
+static
+kpm_ind_msg_t gen_ind_msg(size_t num_ue)
+{
+  kpm_ind_msg_t dst = {.type = FORMAT_3_INDICATION_MESSAGE};
+
+  dst.frm_3.ue_meas_report_lst_len = num_ue;
+  dst.frm_3.meas_report_per_ue = calloc(num_ue, sizeof(meas_report_per_ue_t));
+  assert(dst.frm_3.meas_report_per_ue != NULL && "Memory exhausted");
+
+  for(size_t i = 0; i < num_ue; ++i){
+    meas_report_per_ue_t* r = &dst.frm_3.meas_report_per_ue[i];
+    r->ue_meas_report_lst.type = GNB_UE_ID_E2SM;
+    r->ue_meas_report_lst.gnb.amf_ue_ngap_id = i + 1;
+    r->ue_meas_report_lst.gnb.guami.plmn_id = (e2sm_plmn_t){.mcc = 1, .mnc = 1, .mnc_digit_len = 2};
+    r->ue_meas_report_lst.gnb.guami.amf_region_id = 128;
+    r->ue_meas_report_lst.gnb.guami.amf_set_id = 1;
+    r->ue_meas_report_lst.gnb.guami.amf_ptr = 1;
+    r->ind_msg_format_1 = gen_frm_1(i);
+  }
+
+  return dst;
+}
+
+static
+kpm_ind_filter_t parse(const char* str)
+{
+  kpm_ind_filter_t f = {0};
+  byte_array_t ba = cp_str_to_ba(str);
+  bool const ok = parse_kpm_ind_filter(ba, &f);
+  assert(ok == true);
+  free_byte_array(ba);
+  return f;
+}
+
+static
+void test_parse(void)
+{
+  char const* bad[] = {"meas", "ue=1-", "ue=5-1", "ue=a", "pred=x>", "pred=>1", "pred=x~1", "foo=1", "meas=a;meas=b"};
+  for(size_t i = 0; i < sizeof(bad)/sizeof(bad[0]); ++i){
+    kpm_ind_filter_t f = {0};
+    byte_array_t ba = cp_str_to_ba(bad[i]);
+    assert(parse_kpm_ind_filter(ba, &f) == false);
+    free_byte_array(ba);
+  }
+
+  byte_array_t ba = cp_str_to_ba("meas=DRB.UEThpDl,RRU.*;ue=1-20,33;pred=DRB.UEThpDl>=1000,L3servingRSRP!=-3.5");
+  kpm_ind_filter_t f = {0};
+  assert(parse_kpm_ind_filter(ba, &f) == true);
+  free_byte_array(ba);
+
+  assert(f.len_meas == 2);
+  assert(f.len_ue == 2 && f.ue[0].lo == 1 && f.ue[0].hi == 20 && f.ue[1].lo == 33 && f.ue[1].hi == 33);
+  assert(f.len_pred == 2);
+  assert(f.pred[0].op == GE_KPM_PRED && f.pred[0].val == 1000);
+  assert(f.pred[1].op == NE_KPM_PRED && f.pred[1].val == -3.5);
+
+  free_kpm_ind_filter(&f);
+}
+
+static
+void test_filter(void)
+{
+  // Projection and UE selection
+  kpm_ind_msg_t msg = gen_ind_msg(32);
+  kpm_ind_filter_t f = parse("meas=DRB.UEThpDl,RRU.PrbTot*;ue=1-4,10");
+  assert(apply_kpm_ind_filter(&f, &msg) == true);
+  assert(msg.frm_3.ue_meas_report_lst_len == 5);
+  for(size_t i = 0; i < msg.frm_3.ue_meas_report_lst_len; ++i){
+    kpm_ind_msg_format_1_t const* m = &msg.frm_3.meas_report_per_ue[i].ind_msg_format_1;
+    assert(m->meas_info_lst_len == 3);
+    assert(m->meas_data_lst[0].meas_record_len == 3);
+    assert(m->meas_data_lst[0].meas_record_lst[1].value == REAL_MEAS_VALUE);
+    assert(strncmp((char*)m->meas_info_lst[2].meas_type.name.buf, "RRU.PrbTotUl", 12) == 0);
+  }
+  assert(msg.frm_3.meas_report_per_ue[4].ue_meas_report_lst.gnb.amf_ue_ngap_id == 10);
+  free_kpm_ind_filter(&f);
+  free_kpm_ind_msg(&msg);
+
+  // Predicates over measurements not projected. DRB.UEThpDl is (37*i) % 1000
+  msg = gen_ind_msg(32);
+  f = parse("meas=L3servingRSRP;pred=DRB.UEThpDl<100");
+  assert(apply_kpm_ind_filter(&f, &msg) == true);
+  uint64_t const ue_id[] = {1, 2, 3, 29, 30};
+  assert(msg.frm_3.ue_meas_report_lst_len == sizeof(ue_id)/sizeof(ue_id[0]));
+  for(size_t i = 0; i < msg.frm_3.ue_meas_report_lst_len; ++i){
+    assert(msg.frm_3.meas_report_per_ue[i].ue_meas_report_lst.gnb.amf_ue_ngap_id == ue_id[i]);
+    kpm_ind_msg_format_1_t const* m = &msg.frm_3.meas_report_per_ue[i].ind_msg_format_1;
+    assert(m->meas_info_lst_len == 1);
+    assert(m->meas_data_lst[0].meas_record_len == 1);
+    assert(m->meas_data_lst[0].meas_record_lst[0].value == INTEGER_MEAS_VALUE);
+    assert(m->meas_data_lst[0].meas_record_lst[0].int_val == (37*(ue_id[i]-1) + 8) % 1000);
+  }
+  free_kpm_ind_filter(&f);
+  free_kpm_ind_msg(&msg);
+
+  // Nothing survives
+  msg = gen_ind_msg(8);
+  f = parse("ue=100-200");
+  assert(apply_kpm_ind_filter(&f, &msg) == false);
+  free_kpm_ind_filter(&f);
+  free_kpm_ind_msg(&msg);
+
+  msg = gen_ind_msg(8);
+  f = parse("pred=Unknown.Meas>0");
+  assert(apply_kpm_ind_filter(&f, &msg) == false);
+  free_kpm_ind_filter(&f);
+  free_kpm_ind_msg(&msg);
+
+  // Format 1
+  msg = (kpm_ind_msg_t){.type = FORMAT_1_INDICATION_MESSAGE};
+  msg.frm_1 = gen_frm_1(3);
+  f = parse("meas=L3*;ue=7");
+  assert(apply_kpm_ind_filter(&f, &msg) == true);
+  assert(msg.frm_1.meas_info_lst_len == 5);
+  free_kpm_ind_filter(&f);
+  free_kpm_ind_msg(&msg);
+}
+
+// Bytes crossing the E42 socket and CPU spent per indication, 
+// with and without the filter evaluated at the iApp
+// Format 3 messages conflate per set of UEs. Format 1 reports on the whole E2 Node
+static
+void test_conflate(sm_ric_t* sm)
+{
+  assert(sm->conflate.key != NULL);
+
+  kpm_ind_msg_t msg = gen_ind_msg(2);
+  byte_array_t ba = kpm_enc_ind_msg_asn(&msg);
+  free_kpm_ind_msg(&msg);
+
+  sm_ind_data_t src = {.ind_msg = ba.buf, .len_msg = ba.len};
+  byte_array_t key = sm->conflate.key(sm, &src);
+
+  char exp[64] = {0};
+  snprintf(exp, sizeof(exp), "ue/%d/1,ue/%d/2", GNB_UE_ID_E2SM, GNB_UE_ID_E2SM);
+  assert(key.len == strlen(exp) && memcmp(key.buf, exp, key.len) == 0);
+  free_byte_array(key);
+  free_byte_array(ba);
+
+  msg = (kpm_ind_msg_t){.type = FORMAT_1_INDICATION_MESSAGE, .frm_1 = gen_frm_1(0)};
+  ba = kpm_enc_ind_msg_asn(&msg);
+  free_kpm_ind_msg(&msg);
+
+  src = (sm_ind_data_t){.ind_msg = ba.buf, .len_msg = ba.len};
+  key = sm->conflate.key(sm, &src);
+  assert(key.len == 0);
+  free_byte_array(key);
+  free_byte_array(ba);
+}
+
+static
+void bench_filter(sm_ric_t* sm, size_t num_ue, char const* str)
+{
+  kpm_ind_msg_t msg = gen_ind_msg(num_ue);
+  byte_array_t ba = kpm_enc_ind_msg_asn(&msg);
+  free_kpm_ind_msg(&msg);
+
+  byte_array_t ba_filter = cp_str_to_ba(str);
+  void* filter = sm->filter.compile(sm, ba_filter);
+  assert(filter != NULL);
+  free_byte_array(ba_filter);
+
+  size_t const iter = 100;
+  sm_ind_data_t src = {.ind_msg = ba.buf, .len_msg = ba.len};
+
+  // xApp decodes every record
+  int64_t t0 = time_now_us();
+  for(size_t i = 0; i < iter; ++i){
+    kpm_ind_msg_t tmp = kpm_dec_ind_msg_asn(ba.len, ba.buf);
+    free_kpm_ind_msg(&tmp);
+  }
+  int64_t const xapp_all_us = time_now_us() - t0;
+
+  // iApp projects
+  byte_array_t out = {0};
+  t0 = time_now_us();
+  for(size_t i = 0; i < iter; ++i){
+    free_byte_array(out);
+    bool const fwd = sm->filter.apply(sm, filter, &src, &out);
+    assert(fwd == true);
+  }
+  int64_t const iapp_us = time_now_us() - t0;
+
+  // xApp decodes the projected records
+  t0 = time_now_us();
+  for(size_t i = 0; i < iter; ++i){
+    kpm_ind_msg_t tmp = kpm_dec_ind_msg_asn(out.len, out.buf);
+    free_kpm_ind_msg(&tmp);
+  }
+  int64_t const xapp_proj_us = time_now_us() - t0;
+
+  printf("[KPM-FILTER-BENCH]: %3zu UEs x %zu meas, filter \"%s\"\n", num_ue, num_meas, str);
+  printf("[KPM-FILTER-BENCH]:   E42 bytes/ind %6zu -> %6zu (%.1f%% saved)\n", ba.len, out.len, 100.0 - 100.0*out.len/ba.len);
+  printf("[KPM-FILTER-BENCH]:   xApp decode us/ind %8.1f -> %8.1f, iApp filter us/ind %8.1f\n", 
+      (double)xapp_all_us/iter, (double)xapp_proj_us/iter, (double)iapp_us/iter);
+
+  free_byte_array(out);
+  free_byte_array(ba);
+  sm->filter.free(sm, filter);
+}
+
+int main()
+{
+  test_parse();
+  test_filter();
+
+  sm_ric_t* sm = make_kpm_sm_ric();
+  assert(sm->filter.compile != NULL && sm->filter.apply != NULL && sm->filter.free != NULL);
+
+  test_conflate(sm);
+
+  size_t const num_ue[] = {8, 64, 256};
+  for(size_t i = 0; i < sizeof(num_ue)/sizeof(num_ue[0]); ++i){
+    bench_filter(sm, num_ue[i], "meas=DRB.UEThpDl,L3servingSINR3gpp_cell");
+    bench_filter(sm, num_ue[i], "meas=L3*;ue=1-16");
+  }
+
+  sm->free_sm(sm);
+
+  printf("Success\n");
+  return EXIT_SUCCESS;
+}
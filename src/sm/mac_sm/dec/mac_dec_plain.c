@@ -22,16 +22,25 @@
 
 
 #include "mac_dec_plain.h"
+#include "../ie/mac_wire_plain.h"
 
 #include <assert.h>
+#include <stdio.h>
 #include <stdlib.h>
-#include <string.h>
+
+// Corrupt or truncated data is not decoded. An empty IE is returned instead
+static
+void corrupt_ie(char const* ie, size_t len)
+{
+  printf("[E2SM MAC]: Corrupt %s of %lu bytes. Not decoded \n", ie, len);
+}
 
 mac_event_trigger_t mac_dec_event_trigger_plain(size_t len, uint8_t const ev_tr[len])
 {
-  mac_event_trigger_t ev = {0};
-  memcpy(&ev.ms, ev_tr, sizeof(ev.ms));
-  return ev;
+  mac_event_trigger_t ret = {0};
+  if(dec_mac_event_trigger_plain_wire(len, ev_tr, &ret) == false)
+    corrupt_ie("event trigger", len);
+  return ret;
 }
 
 mac_action_def_t mac_dec_action_def_plain(size_t len, uint8_t const action_def[len])
@@ -44,38 +53,17 @@ mac_action_def_t mac_dec_action_def_plain(size_t len, uint8_t const action_def[l
 
 mac_ind_hdr_t mac_dec_ind_hdr_plain(size_t len, uint8_t const ind_hdr[len])
 {
-  assert(len == sizeof(mac_ind_hdr_t)); 
-  mac_ind_hdr_t ret;
-  memcpy(&ret, ind_hdr, len);
+  mac_ind_hdr_t ret = {0};
+  if(dec_mac_ind_hdr_plain_wire(len, ind_hdr, &ret) == false)
+    corrupt_ie("indication header", len);
   return ret;
 }
 
 mac_ind_msg_t mac_dec_ind_msg_plain(size_t len, uint8_t const ind_msg[len])
 {
-//  assert(len == sizeof(mac_ind_msg_t)); 
-  mac_ind_msg_t ret;
-
-  static_assert(sizeof(uint32_t) == sizeof(ret.len_ue_stats), "Different sizes!");
-
-  const size_t len_sizeof = sizeof(ret.len_ue_stats);
-  memcpy(&ret.len_ue_stats, ind_msg, len_sizeof);
-
-  if(ret.len_ue_stats > 0){
-    ret.ue_stats = calloc(ret.len_ue_stats, sizeof(mac_ue_stats_impl_t));
-    assert(ret.ue_stats != NULL && "Memory exhausted!");
-  }
-  
-  void* ptr = (void*)&ind_msg[len_sizeof];
-  for(uint32_t i = 0; i < ret.len_ue_stats; ++i){
-    memcpy(&ret.ue_stats[i], ptr, sizeof( mac_ue_stats_impl_t) );
-    ptr += sizeof( mac_ue_stats_impl_t); 
-  }
-
-  memcpy(&ret.tstamp, ptr, sizeof(ret.tstamp));
-
-  ptr += sizeof(ret.tstamp);
-  assert(ptr == ind_msg + len && "data layout mismacth");
-
+  mac_ind_msg_t ret = {0};
+  if(dec_mac_ind_msg_plain_wire(len, ind_msg, &ret) == false)
+    corrupt_ie("indication message", len);
   return ret;
 }
 
@@ -87,17 +75,17 @@ mac_call_proc_id_t mac_dec_call_proc_id_plain(size_t len, uint8_t const call_pro
 
 mac_ctrl_hdr_t mac_dec_ctrl_hdr_plain(size_t len, uint8_t const ctrl_hdr[len])
 {
-  assert(len == sizeof(mac_ctrl_hdr_t)); 
-  mac_ctrl_hdr_t ret;
-  memcpy(&ret, ctrl_hdr, len);
+  mac_ctrl_hdr_t ret = {0};
+  if(dec_mac_ctrl_hdr_plain_wire(len, ctrl_hdr, &ret) == false)
+    corrupt_ie("control header", len);
   return ret;
 }
 
 mac_ctrl_msg_t mac_dec_ctrl_msg_plain(size_t len, uint8_t const ctrl_msg[len])
 {
-  assert(len == sizeof(mac_ctrl_msg_t)); 
-  mac_ctrl_msg_t ret;
-  memcpy(&ret, ctrl_msg, len);
+  mac_ctrl_msg_t ret = {0};
+  if(dec_mac_ctrl_msg_plain_wire(len, ctrl_msg, &ret) == false)
+    corrupt_ie("control message", len);
   return ret;
 }
 
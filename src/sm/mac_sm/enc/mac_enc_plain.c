@@ -22,6 +22,7 @@
 
 
 #include "mac_enc_plain.h"
+#include "../ie/mac_wire_plain.h"
 
 #include <assert.h>
 #include <stdlib.h>
@@ -30,15 +31,7 @@
 byte_array_t mac_enc_event_trigger_plain(mac_event_trigger_t const* event_trigger)
 {
   assert(event_trigger != NULL);
-  byte_array_t  ba = {0};
- 
-  ba.len = sizeof(event_trigger->ms);
-  ba.buf = malloc(ba.len);
-  assert(ba.buf != NULL && "Memory exhausted");
-
-  memcpy(ba.buf, &event_trigger->ms, ba.len);
-
-  return ba;
+  return enc_mac_event_trigger_plain_wire(event_trigger);
 }
 
 byte_array_t mac_enc_action_def_plain(mac_action_def_t const* action_def)
@@ -53,43 +46,13 @@ byte_array_t mac_enc_action_def_plain(mac_action_def_t const* action_def)
 byte_array_t mac_enc_ind_hdr_plain(mac_ind_hdr_t const* ind_hdr)
 {
   assert(ind_hdr != NULL);
-
-  byte_array_t ba = {0};
-
-  ba.len = sizeof(mac_ind_hdr_t);
-  ba.buf = calloc(ba.len,  sizeof(uint8_t));
-  assert(ba.buf != NULL && "memory exhausted");
-  memcpy(ba.buf, ind_hdr, ba.len);
-
-  return ba;
+  return enc_mac_ind_hdr_plain_wire(ind_hdr);
 }
 
 byte_array_t mac_enc_ind_msg_plain(mac_ind_msg_t const* ind_msg)
 {
   assert(ind_msg != NULL);
-
-  byte_array_t ba = {0};
-  const uint32_t len = sizeof(ind_msg->len_ue_stats) 
-                      + sizeof(mac_ue_stats_impl_t) * ind_msg->len_ue_stats
-                      + sizeof(ind_msg->tstamp); 
-  ba.buf = calloc(1, len); 
-  assert(ba.buf != NULL);
-
-  memcpy(ba.buf, &ind_msg->len_ue_stats, sizeof(ind_msg->len_ue_stats));
-  void* ptr = ba.buf + sizeof(ind_msg->len_ue_stats);
-
-  for(uint32_t i = 0; i < ind_msg->len_ue_stats; ++i){
-    memcpy(ptr, &ind_msg->ue_stats[i], sizeof(ind_msg->ue_stats[0])); 
-    ptr += sizeof(ind_msg->ue_stats[0]);
-  }
-
-  memcpy(ptr, &ind_msg->tstamp, sizeof(ind_msg->tstamp));
-  ptr += sizeof(ind_msg->tstamp);
-
-  assert(ptr == ba.buf + len && "Data layout mismacth");
-
-  ba.len = len;
-  return ba;
+  return enc_mac_ind_msg_plain_wire(ind_msg);
 }
 
 
@@ -105,28 +68,13 @@ byte_array_t mac_enc_call_proc_id_plain(mac_call_proc_id_t const* call_proc_id)
 byte_array_t mac_enc_ctrl_hdr_plain(mac_ctrl_hdr_t const* ctrl_hdr)
 {
   assert(ctrl_hdr != NULL);
-  byte_array_t  ba = {0};
-  ba.len = sizeof(mac_ctrl_hdr_t);
-  ba.buf = calloc(ba.len ,sizeof(uint8_t)); 
-  assert(ba.buf != NULL);
-
-  memcpy(ba.buf, ctrl_hdr, ba.len);
-
-  return ba;
+  return enc_mac_ctrl_hdr_plain_wire(ctrl_hdr);
 }
 
 byte_array_t mac_enc_ctrl_msg_plain(mac_ctrl_msg_t const* ctrl_msg)
 {
   assert(ctrl_msg != NULL);
-
-  byte_array_t  ba = {0};
-  ba.len = sizeof(mac_ctrl_msg_t);
-  ba.buf = calloc(ba.len, sizeof(uint8_t)); 
-  assert(ba.buf != NULL);
-
-  memcpy(ba.buf, ctrl_msg, ba.len);
-
-  return ba;
+  return enc_mac_ctrl_msg_plain_wire(ctrl_msg);
 }
 
 byte_array_t mac_enc_ctrl_out_plain(mac_ctrl_out_t const* ctrl) 
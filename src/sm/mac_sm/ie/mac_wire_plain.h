@@ -0,0 +1,81 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+#ifndef MAC_WIRE_PLAIN_H
+#define MAC_WIRE_PLAIN_H
+
+// Layout of the MAC SM plain encoding, see util/plain_wire.h. Fields are 
+// only appended at the end of a list, as the older readers know a prefix
+
+#include "mac_data_ie.h"
+#include "../../../util/plain_wire.h"
+
+#define MAC_EVENT_TRIGGER_WIRE(F, A, T) F(T, ms)
+
+#define MAC_IND_HDR_WIRE(F, A, T) F(T, dummy)
+
+#define MAC_CTRL_HDR_WIRE(F, A, T) F(T, dummy)
+
+#define MAC_CTRL_MSG_WIRE(F, A, T) F(T, action)
+
+#define MAC_UE_STATS_WIRE(F, A, T) \
+  F(T, dl_aggr_tbs) \
+  F(T, ul_aggr_tbs) \
+  F(T, dl_aggr_bytes_sdus) \
+  F(T, ul_aggr_bytes_sdus) \
+  F(T, dl_curr_tbs) \
+  F(T, ul_curr_tbs) \
+  F(T, dl_sched_rb) \
+  F(T, ul_sched_rb) \
+  F(T, pusch_snr) \
+  F(T, pucch_snr) \
+  F(T, dl_bler) \
+  F(T, ul_bler) \
+  A(T, dl_harq) \
+  A(T, ul_harq) \
+  F(T, dl_num_harq) \
+  F(T, ul_num_harq) \
+  F(T, rnti) \
+  F(T, dl_aggr_prb) \
+  F(T, ul_aggr_prb) \
+  F(T, dl_aggr_sdus) \
+  F(T, ul_aggr_sdus) \
+  F(T, dl_aggr_retx_prb) \
+  F(T, ul_aggr_retx_prb) \
+  F(T, bsr) \
+  F(T, frame) \
+  F(T, slot) \
+  F(T, wb_cqi) \
+  F(T, dl_mcs1) \
+  F(T, ul_mcs1) \
+  F(T, dl_mcs2) \
+  F(T, ul_mcs2) \
+  F(T, phr)
+
+PLAIN_WIRE_REC_MSG(mac_event_trigger, mac_event_trigger_t, MAC_EVENT_TRIGGER_WIRE)
+PLAIN_WIRE_REC_MSG(mac_ind_hdr, mac_ind_hdr_t, MAC_IND_HDR_WIRE)
+PLAIN_WIRE_REC_MSG(mac_ctrl_hdr, mac_ctrl_hdr_t, MAC_CTRL_HDR_WIRE)
+PLAIN_WIRE_REC_MSG(mac_ctrl_msg, mac_ctrl_msg_t, MAC_CTRL_MSG_WIRE)
+
+PLAIN_WIRE_REC(mac_ue_stats, mac_ue_stats_impl_t, MAC_UE_STATS_WIRE)
+PLAIN_WIRE_ARR_MSG(mac_ind_msg, mac_ind_msg_t, ue_stats, len_ue_stats, mac_ue_stats, mac_ue_stats_impl_t, MAC_UE_STATS_WIRE)
+
+#endif
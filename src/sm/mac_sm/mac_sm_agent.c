@@ -20,6 +20,7 @@
  */
 
 #include "mac_sm_agent.h"
+#include "../sm_enc.h"
 
 #include "../../util/alg_ds/alg/defer.h"
 #include "dec/mac_dec_generic.h"
@@ -160,14 +161,7 @@ sm_e2_setup_data_t on_e2_setup_mac_sm_ag(sm_agent_t const* sm_agent)
 
   sm_e2_setup_data_t setup = {.len_rfd = 0, .ran_fun_def = NULL }; 
 
-  size_t const sz = strnlen(SM_MAC_STR, 256);
-  assert(sz < 256 && "Buffer overeflow?");
-
-  setup.len_rfd = sz;
-  setup.ran_fun_def = calloc(1, sz);
-  assert(setup.ran_fun_def != NULL);
-
-  memcpy(setup.ran_fun_def, SM_MAC_STR , sz);
+  setup = tag_ran_func_def_sm_enc(SM_MAC_STR, SM_ENC_COMPILED);
  
   /*
   setup.len_rfd = strlen(sm->base.ran_func_name);
@@ -277,6 +277,8 @@ sm_ric_t* make_mac_sm_ric(void /* sm_io_ric_t io */)
   assert(strlen(SM_MAC_STR) < sizeof(sm->base.ran_func_name));
   memcpy(sm->base.ran_func_name, SM_MAC_STR, strlen(SM_MAC_STR));
 
+  sm->base.enc = SM_ENC_COMPILED;
+
   return &sm->base;
 }
 
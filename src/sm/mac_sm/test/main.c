@@ -24,10 +24,13 @@
 #include "../../../../test/common/fill_ind_data.h"
 #include "../../mac_sm/mac_sm_agent.h"
 #include "../../mac_sm/mac_sm_ric.h"
+#include "../../mac_sm/mac_sm_id.h"
+#include "../../sm_enc.h"
 
 #include <assert.h>
 #include <stdbool.h>
 #include <stdlib.h>
+#include <string.h>
 #include <stdio.h>
 #include <time.h>
 
@@ -72,6 +75,29 @@ void check_eq_ran_function(sm_agent_t const* ag, sm_ric_t const* ric)
   assert(ag->ran_func_id == ric->ran_func_id);
 }
 
+// E2 -> RIC
+// The RAN Function Definition advertises the encoding, and it must be the
+// one that the RIC side decodes
+static
+void check_e2_setup(sm_agent_t* ag, sm_ric_t* ric)
+{
+  assert(ag != NULL);
+  assert(ric != NULL);
+
+  sm_e2_setup_data_t data = ag->proc.on_e2_setup(ag);
+
+  sm_enc_e enc = END_SM_ENC;
+  bool const tagged = ran_func_def_sm_enc(data.len_rfd, data.ran_fun_def, &enc);
+  assert(tagged == true);
+  assert(enc == SM_ENC_COMPILED);
+  assert(enc == ric->enc);
+
+  // Untagged definitions i.e., older agents, do not advertise any encoding
+  assert(ran_func_def_sm_enc(strlen(SM_MAC_STR), (uint8_t const*)SM_MAC_STR, &enc) == false);
+
+  free(data.ran_fun_def);
+}
+
 // RIC -> E2
 static
 void check_subscription(sm_agent_t* ag, sm_ric_t* ric)
@@ -115,6 +141,7 @@ int main()
   sm_ric_t* sm_ric = make_mac_sm_ric();
 
   check_eq_ran_function(sm_ag, sm_ric);
+  check_e2_setup(sm_ag, sm_ric);
   check_subscription(sm_ag, sm_ric);
   check_indication(sm_ag, sm_ric);
 
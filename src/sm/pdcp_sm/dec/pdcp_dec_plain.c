@@ -22,16 +22,25 @@
 
 
 #include "pdcp_dec_plain.h"
+#include "../ie/pdcp_wire_plain.h"
 
 #include <assert.h>
+#include <stdio.h>
 #include <stdlib.h>
-#include <string.h>
+
+// Corrupt or truncated data is not decoded. An empty IE is returned instead
+static
+void corrupt_ie(char const* ie, size_t len)
+{
+  printf("[E2SM PDCP]: Corrupt %s of %lu bytes. Not decoded \n", ie, len);
+}
 
 pdcp_event_trigger_t pdcp_dec_event_trigger_plain(size_t len, uint8_t const ev_tr[len])
 {
-  pdcp_event_trigger_t ev = {0};
-  memcpy(&ev.ms, ev_tr, sizeof(ev.ms));
-  return ev;
+  pdcp_event_trigger_t ret = {0};
+  if(dec_pdcp_event_trigger_plain_wire(len, ev_tr, &ret) == false)
+    corrupt_ie("event trigger", len);
+  return ret;
 }
 
 pdcp_action_def_t pdcp_dec_action_def_plain(size_t len, uint8_t const action_def[len])
@@ -44,40 +53,17 @@ pdcp_action_def_t pdcp_dec_action_def_plain(size_t len, uint8_t const action_def
 
 pdcp_ind_hdr_t pdcp_dec_ind_hdr_plain(size_t len, uint8_t const ind_hdr[len])
 {
-  assert(len == sizeof(pdcp_ind_hdr_t)); 
-  pdcp_ind_hdr_t ret;
-  memcpy(&ret, ind_hdr, len);
+  pdcp_ind_hdr_t ret = {0};
+  if(dec_pdcp_ind_hdr_plain_wire(len, ind_hdr, &ret) == false)
+    corrupt_ie("indication header", len);
   return ret;
 }
 
 pdcp_ind_msg_t pdcp_dec_ind_msg_plain(size_t len, uint8_t const ind_msg[len])
 {
-  assert(len >= sizeof(uint32_t) + sizeof(int64_t));
-//      uint16_t) + sizeof(uint8_t)); // pdcp_ind_msg_t)); 
-  pdcp_ind_msg_t ret;
-
-  void* it = (void*)ind_msg; 
-  memcpy(&ret.len, ind_msg, sizeof(ret.len)); 
-  it += sizeof(ret.len);
-
-  if(ret.len > 0){
-    ret.rb = calloc(ret.len, sizeof(pdcp_radio_bearer_stats_t));
-    assert(ret.rb != NULL && "Memory exhausted!");
-  }
-
-  for(uint32_t i = 0; i < ret.len; ++i){
-    memcpy(&ret.rb[i] , it, sizeof(pdcp_radio_bearer_stats_t));
-    it += sizeof(pdcp_radio_bearer_stats_t);
-  }
-
-  memcpy(&ret.tstamp, it, sizeof(ret.tstamp));
-  it += sizeof(ret.tstamp);
-
-//  memcpy(&ret.slot, it, sizeof(ret.slot));
-//  it += sizeof(ret.slot);
-
-  assert(it == ind_msg + len && "Data layout mismatch");
-
+  pdcp_ind_msg_t ret = {0};
+  if(dec_pdcp_ind_msg_plain_wire(len, ind_msg, &ret) == false)
+    corrupt_ie("indication message", len);
   return ret;
 }
 
@@ -89,29 +75,26 @@ pdcp_call_proc_id_t pdcp_dec_call_proc_id_plain(size_t len, uint8_t const call_p
 
 pdcp_ctrl_hdr_t pdcp_dec_ctrl_hdr_plain(size_t len, uint8_t const ctrl_hdr[len])
 {
-  assert(len == sizeof(pdcp_ctrl_hdr_t)); 
-  pdcp_ctrl_hdr_t ret;
-  memcpy(&ret, ctrl_hdr, len);
+  pdcp_ctrl_hdr_t ret = {0};
+  if(dec_pdcp_ctrl_hdr_plain_wire(len, ctrl_hdr, &ret) == false)
+    corrupt_ie("control header", len);
   return ret;
 }
 
 pdcp_ctrl_msg_t pdcp_dec_ctrl_msg_plain(size_t len, uint8_t const ctrl_msg[len])
 {
-  assert(len == sizeof(pdcp_ctrl_msg_t)); 
-  pdcp_ctrl_msg_t ret;
-  memcpy(&ret, ctrl_msg, len);
+  pdcp_ctrl_msg_t ret = {0};
+  if(dec_pdcp_ctrl_msg_plain_wire(len, ctrl_msg, &ret) == false)
+    corrupt_ie("control message", len);
   return ret;
 }
 
-pdcp_ctrl_out_t pdcp_dec_ctrl_out_plain(size_t len, uint8_t const ctrl_out[len]) 
+pdcp_ctrl_out_t pdcp_dec_ctrl_out_plain(size_t len, uint8_t const ctrl_out[len])
 {
-  assert(len > 0);
-  assert(ctrl_out!= NULL);
-  assert(len == sizeof( pdcp_ctrl_out_t ) );
-  pdcp_ctrl_out_t out = {0}; 
-  memcpy(&out, ctrl_out, len);
-
-  return out;
+  pdcp_ctrl_out_t ret = {0};
+  if(dec_pdcp_ctrl_out_plain_wire(len, ctrl_out, &ret) == false)
+    corrupt_ie("control outcome", len);
+  return ret;
 }
 
 pdcp_func_def_t pdcp_dec_func_def_plain(size_t len, uint8_t const func[len])
@@ -20,6 +20,7 @@
  */
 
 #include "pdcp_enc_plain.h"
+#include "../ie/pdcp_wire_plain.h"
 
 #include <assert.h>
 #include <stdlib.h>
@@ -29,15 +30,7 @@
 byte_array_t pdcp_enc_event_trigger_plain(pdcp_event_trigger_t const* event_trigger)
 {
   assert(event_trigger != NULL);
-  byte_array_t  ba = {0};
- 
-  ba.len = sizeof(event_trigger->ms);
-  ba.buf = calloc(ba.len, sizeof(uint8_t));
-  assert(ba.buf != NULL && "Memory exhausted");
-
-  memcpy(ba.buf, &event_trigger->ms, ba.len);
-
-  return ba;
+  return enc_pdcp_event_trigger_plain_wire(event_trigger);
 }
 
 byte_array_t pdcp_enc_action_def_plain(pdcp_action_def_t const* action_def)
@@ -52,48 +45,13 @@ byte_array_t pdcp_enc_action_def_plain(pdcp_action_def_t const* action_def)
 byte_array_t pdcp_enc_ind_hdr_plain(pdcp_ind_hdr_t const* ind_hdr)
 {
   assert(ind_hdr != NULL);
-
-  byte_array_t ba = {0};
-
-  ba.len = sizeof(pdcp_ind_hdr_t);
-  ba.buf = calloc(ba.len, sizeof(uint8_t));
-  assert(ba.buf != NULL && "memory exhausted");
-  memcpy(ba.buf, ind_hdr, sizeof(pdcp_ind_hdr_t));
-
-  return ba;
+  return enc_pdcp_ind_hdr_plain_wire(ind_hdr);
 }
 
 byte_array_t pdcp_enc_ind_msg_plain(pdcp_ind_msg_t const* ind_msg)
 {
   assert(ind_msg != NULL);
-
-  byte_array_t ba = {0};
-
-  size_t const sz = sizeof(ind_msg->len) + 
-                    sizeof(ind_msg->tstamp) +
-//                    sizeof(ind_msg->slot) +
-                    sizeof(pdcp_radio_bearer_stats_t )*ind_msg->len;
-
-  ba.buf = malloc(sz);
-  assert(ba.buf != NULL && "Memory exhausted");
-
-  memcpy(ba.buf, &ind_msg->len, sizeof(ind_msg->len) );
-
-  void* it = ba.buf + sizeof(ind_msg->len);
-
-  for(uint32_t i = 0 ; i < ind_msg->len; ++i){
-    memcpy(it, &ind_msg->rb[i], sizeof(pdcp_radio_bearer_stats_t));
-    it += sizeof(pdcp_radio_bearer_stats_t);
-  }
-
-  memcpy(it, &ind_msg->tstamp, sizeof(ind_msg->tstamp));
-  it += sizeof(ind_msg->tstamp);
-//  memcpy(it, &ind_msg->slot, sizeof(ind_msg->slot));
-//  it += sizeof(ind_msg->slot);
-  assert(it == ba.buf + sz && "Mismatch of data layout" );
-
-  ba.len = sz;
-  return ba;
+  return enc_pdcp_ind_msg_plain_wire(ind_msg);
 }
 
 
@@ -109,42 +67,19 @@ byte_array_t pdcp_enc_call_proc_id_plain(pdcp_call_proc_id_t const* call_proc_id
 byte_array_t pdcp_enc_ctrl_hdr_plain(pdcp_ctrl_hdr_t const* ctrl_hdr)
 {
   assert(ctrl_hdr != NULL);
-  byte_array_t  ba = {0};
-  ba.len = sizeof(pdcp_ctrl_hdr_t);
-  ba.buf = calloc(ba.len , sizeof(uint8_t)); 
-  assert(ba.buf != NULL && "Memory exhausted");
-
-  memcpy(ba.buf, ctrl_hdr, ba.len);
-
-  return ba;
+  return enc_pdcp_ctrl_hdr_plain_wire(ctrl_hdr);
 }
 
 byte_array_t pdcp_enc_ctrl_msg_plain(pdcp_ctrl_msg_t const* ctrl_msg)
 {
   assert(ctrl_msg != NULL);
-
-  byte_array_t  ba = {0};
-  ba.len = sizeof(pdcp_ctrl_msg_t);
-  ba.buf = calloc(ba.len, sizeof(uint8_t)); 
-  assert(ba.buf != NULL && "Memory exhausted");
-
-  memcpy(ba.buf, ctrl_msg, ba.len);
-
-  return ba;
+  return enc_pdcp_ctrl_msg_plain_wire(ctrl_msg);
 }
 
-byte_array_t pdcp_enc_ctrl_out_plain(pdcp_ctrl_out_t const* ctrl_out) 
+byte_array_t pdcp_enc_ctrl_out_plain(pdcp_ctrl_out_t const* ctrl_out)
 {
   assert(ctrl_out != NULL);
-  byte_array_t  ba = {0};
-
-  ba.len = sizeof(pdcp_ctrl_out_t);
-  ba.buf = calloc(ba.len, sizeof(uint8_t) );
-  assert(ba.buf != NULL && "Memory exhausted");
-
-  memcpy(ba.buf, ctrl_out,ba.len);
-
-  return ba;
+  return enc_pdcp_ctrl_out_plain_wire(ctrl_out);
 }
 
 byte_array_t pdcp_enc_func_def_plain(pdcp_func_def_t const* func)
@@ -0,0 +1,70 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+#ifndef PDCP_WIRE_PLAIN_H
+#define PDCP_WIRE_PLAIN_H
+
+// Layout of the PDCP SM plain encoding, see util/plain_wire.h. Fields are 
+// only appended at the end of a list, as the older readers know a prefix
+
+#include "pdcp_data_ie.h"
+#include "../../../util/plain_wire.h"
+
+#define PDCP_EVENT_TRIGGER_WIRE(F, A, T) F(T, ms)
+
+#define PDCP_IND_HDR_WIRE(F, A, T) F(T, dummy)
+
+#define PDCP_CTRL_HDR_WIRE(F, A, T) F(T, dummy)
+
+#define PDCP_CTRL_MSG_WIRE(F, A, T) F(T, action)
+
+#define PDCP_CTRL_OUT_WIRE(F, A, T) F(T, ans)
+
+#define PDCP_RB_STATS_WIRE(F, A, T) \
+  F(T, txpdu_pkts) \
+  F(T, txpdu_bytes) \
+  F(T, txpdu_sn) \
+  F(T, rxpdu_pkts) \
+  F(T, rxpdu_bytes) \
+  F(T, rxpdu_sn) \
+  F(T, rxpdu_oo_pkts) \
+  F(T, rxpdu_oo_bytes) \
+  F(T, rxpdu_dd_pkts) \
+  F(T, rxpdu_dd_bytes) \
+  F(T, rxpdu_ro_count) \
+  F(T, txsdu_pkts) \
+  F(T, txsdu_bytes) \
+  F(T, rxsdu_pkts) \
+  F(T, rxsdu_bytes) \
+  F(T, rnti) \
+  F(T, mode) \
+  F(T, rbid)
+
+PLAIN_WIRE_REC_MSG(pdcp_event_trigger, pdcp_event_trigger_t, PDCP_EVENT_TRIGGER_WIRE)
+PLAIN_WIRE_REC_MSG(pdcp_ind_hdr, pdcp_ind_hdr_t, PDCP_IND_HDR_WIRE)
+PLAIN_WIRE_REC_MSG(pdcp_ctrl_hdr, pdcp_ctrl_hdr_t, PDCP_CTRL_HDR_WIRE)
+PLAIN_WIRE_REC_MSG(pdcp_ctrl_msg, pdcp_ctrl_msg_t, PDCP_CTRL_MSG_WIRE)
+PLAIN_WIRE_REC_MSG(pdcp_ctrl_out, pdcp_ctrl_out_t, PDCP_CTRL_OUT_WIRE)
+
+PLAIN_WIRE_REC(pdcp_rb_stats, pdcp_radio_bearer_stats_t, PDCP_RB_STATS_WIRE)
+PLAIN_WIRE_ARR_MSG(pdcp_ind_msg, pdcp_ind_msg_t, rb, len, pdcp_rb_stats, pdcp_radio_bearer_stats_t, PDCP_RB_STATS_WIRE)
+
+#endif
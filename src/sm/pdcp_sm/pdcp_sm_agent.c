@@ -21,6 +21,7 @@
 
 
 #include "pdcp_sm_agent.h"
+#include "../sm_enc.h"
 #include "pdcp_sm_id.h"
 #include "enc/pdcp_enc_generic.h"
 #include "dec/pdcp_dec_generic.h"
@@ -164,14 +165,7 @@ sm_e2_setup_data_t on_e2_setup_pdcp_sm_ag(sm_agent_t const* sm_agent)
   sm_e2_setup_data_t setup = {.len_rfd =0, .ran_fun_def = NULL  }; 
 
   // ToDo: Missing a call to the RAN to fill this data
-  size_t const sz = strnlen(SM_PDCP_STR, 256);
-  assert(sz < 256 && "Buffer overeflow?");
-
-  setup.len_rfd = sz;
-  setup.ran_fun_def = calloc(1, sz);
-  assert(setup.ran_fun_def != NULL);
-
-  memcpy(setup.ran_fun_def, SM_PDCP_STR , sz);
+  setup = tag_ran_func_def_sm_enc(SM_PDCP_STR, SM_ENC_COMPILED);
  
 
   /*
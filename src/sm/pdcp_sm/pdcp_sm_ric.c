@@ -259,6 +259,8 @@ sm_ric_t* make_pdcp_sm_ric(void /* sm_io_ric_t io */)
   assert(strlen(SM_PDCP_STR) < sizeof( sm->base.ran_func_name) );
   memcpy(sm->base.ran_func_name, SM_PDCP_STR, strlen(SM_PDCP_STR)); 
 
+  sm->base.enc = SM_ENC_COMPILED;
+
   return &sm->base;
 }
 
@@ -24,6 +24,7 @@
 #include "rc_sm_id.h"
 
 #include <assert.h>
+#include <stdio.h>
 #include <stdlib.h>
 
 #include "enc/rc_enc_generic.h"
@@ -147,6 +148,112 @@ sm_ag_if_rd_rsu_t on_ric_service_update_rc_sm_ric(sm_ric_t const* sm_ric, sm_ric
   return dst;
 }
 
+static
+byte_array_t ctrl_target_rc(ue_id_e2sm_t const* ue)
+{
+  // The whole E2 Node
+  if(ue == NULL)
+    return (byte_array_t){0};
+
+  char str[64] = {0};
+  int const n = snprintf(str, sizeof(str), "ue/%d/%lu", ue->type, num_ue_id_e2sm(ue));
+  assert(n > 0 && n < (int)sizeof(str));
+  return cp_str_to_ba(str);
+}
+
+// One target per RAN Parameter. The value is the encoded parameter
+static
+void add_ctrl_targets_rc(sm_rc_ric_t* sm, ue_id_e2sm_t const* ue, uint32_t style, uint16_t act, e2sm_rc_ctrl_msg_frmt_1_t const* msg, size_t* len, sm_ctrl_target_t** dst)
+{
+  if(msg == NULL || msg->sz_ran_param == 0)
+    return;
+
+  *dst = realloc(*dst, (*len + msg->sz_ran_param)*sizeof(sm_ctrl_target_t));
+  assert(*dst != NULL && "Memory exhausted");
+
+  for(size_t i = 0; i < msg->sz_ran_param; ++i){
+    sm_ctrl_target_t* t = &(*dst)[*len + i];
+    t->target = ctrl_target_rc(ue);
+
+    char str[64] = {0};
+    int const n = snprintf(str, sizeof(str), "%u/%u/%u", style, act, msg->ran_param[i].ran_param_id);
+    assert(n > 0 && n < (int)sizeof(str));
+    t->param = cp_str_to_ba(str);
+
+    e2sm_rc_ctrl_msg_t one = {.format = FORMAT_1_E2SM_RC_CTRL_MSG, 
+                              .frmt_1 = {.sz_ran_param = 1, .ran_param = (seq_ran_param_t*)&msg->ran_param[i]} };
+    t->val = rc_enc_ctrl_msg(&sm->enc, &one);
+  }
+  *len += msg->sz_ran_param;
+}
+
+static
+size_t ctrl_targets_rc_sm_ric(sm_ric_t const* sm_ric, sm_ctrl_req_data_t const* src, sm_ctrl_target_t** dst)
+{
+  assert(sm_ric != NULL);
+  assert(src != NULL);
+  assert(dst != NULL);
+
+  sm_rc_ric_t* sm = (sm_rc_ric_t*)sm_ric;
+
+  e2sm_rc_ctrl_hdr_t hdr = rc_dec_ctrl_hdr(&sm->enc, src->len_hdr, src->ctrl_hdr);
+  e2sm_rc_ctrl_msg_t msg = rc_dec_ctrl_msg(&sm->enc, src->len_msg, src->ctrl_msg);
+
+  ue_id_e2sm_t const* ue = NULL;
+  uint32_t style = 0;
+  uint16_t act = 0;
+  if(hdr.format == FORMAT_1_E2SM_RC_CTRL_HDR){
+    ue = &hdr.frmt_1.ue_id;
+    style = hdr.frmt_1.ric_style_type;
+    act = hdr.frmt_1.ctrl_act_id;
+  } else if(hdr.format == FORMAT_2_E2SM_RC_CTRL_HDR){
+    ue = hdr.frmt_2.ue_id;
+  }
+
+  size_t len = 0;
+  *dst = NULL;
+  if(msg.format == FORMAT_1_E2SM_RC_CTRL_MSG){
+    add_ctrl_targets_rc(sm, ue, style, act, &msg.frmt_1, &len, dst);
+  } else if(msg.format == FORMAT_2_E2SM_RC_CTRL_MSG){
+    for(size_t i = 0; i < msg.frmt_2.sz_seq_ctrl_sma; ++i){
+      seq_ctrl_sma_t const* sma = &msg.frmt_2.action[i];
+      for(size_t j = 0; j < sma->sz_seq_ctrl_act; ++j){
+        seq_ctrl_act_t const* a = &sma->seq_ctrl_act[j];
+        add_ctrl_targets_rc(sm, ue, sma->ctrl_style, a->ctrl_act_id, a->ctrl_msg_frmt_1, &len, dst);
+      }
+    }
+  }
+
+  free_e2sm_rc_ctrl_hdr(&hdr);
+  free_e2sm_rc_ctrl_msg(&msg);
+
+  return len;
+}
+
+// Only the header is decoded. Insert (format 2) and UE specific (format 3) indications
+static
+byte_array_t ind_key_rc_sm_ric(sm_ric_t const* sm_ric, sm_ind_data_t const* src)
+{
+  assert(sm_ric != NULL);
+  assert(src != NULL);
+
+  sm_rc_ric_t* sm = (sm_rc_ric_t*)sm_ric;
+
+  e2sm_rc_ind_hdr_t hdr = rc_dec_ind_hdr(&sm->enc, src->len_hdr, src->ind_hdr);
+
+  ue_id_e2sm_t const* ue = NULL;
+  if(hdr.format == FORMAT_2_E2SM_RC_IND_HDR)
+    ue = &hdr.frmt_2.ue_id;
+  else if(hdr.format == FORMAT_3_E2SM_RC_IND_HDR)
+    ue = hdr.frmt_3.ue_id;
+
+  byte_array_t const key = ctrl_target_rc(ue);
+
+  free_e2sm_rc_ind_hdr(&hdr);
+
+  return key;
+}
+
 static
 void free_rc_sm_ric(sm_ric_t* sm_ric)
 {
@@ -236,11 +343,19 @@ sm_ric_t* make_rc_sm_ric(void /* sm_io_ric_t io */)
 
   sm->base.proc.on_e2_setup = ric_on_e2_setup_rc_sm_ric;
   sm->base.proc.on_ric_service_update = on_ric_service_update_rc_sm_ric; 
+
+  // Conflicting controls from different xApps
+  sm->base.conflict.targets = ctrl_targets_rc_sm_ric;
+
+  // Conflation of the indications for slow xApps
+  sm->base.conflate.key = ind_key_rc_sm_ric;
   sm->base.handle = NULL;
 
   assert(strlen(SM_RAN_CTRL_SHORT_NAME) < sizeof( sm->base.ran_func_name) );
   memcpy(sm->base.ran_func_name,SM_RAN_CTRL_SHORT_NAME, strlen( SM_RAN_CTRL_SHORT_NAME)); 
 
+  sm->base.enc = SM_ENC_COMPILED;
+
   return &sm->base;
 }
 
@@ -8,22 +8,6 @@
 #include <math.h>
 #include <limits.h>
 
-static
-byte_array_t cp_str_to_ba(const char* str)
-{
-  assert(str != NULL);
-  
-  const size_t sz = strlen(str);
-
-  byte_array_t dst = {.len = sz};
-
-  dst.buf = calloc(sz,sizeof(uint8_t));
-  assert(dst.buf != NULL && "Memory exhausted");
-
-  memcpy(dst.buf, str, sz);
-
-  return dst;
-}
 /*
 static
 double rand_double()
@@ -361,12 +345,6 @@ lst_ran_param_t fill_rnd_lst_ran_param(void)
 {
   lst_ran_param_t dst = {0};
 
-  // RAN Parameter ID
-  // Mandatory
-  // 9.3.8
-  //1.. 4294967295
-  dst.ran_param_id = rand() + 1;
-
   // RAN Parameter Structure
   // Mandatory
   // 9.3.12
@@ -1066,7 +1044,7 @@ gnb_e2sm_t fill_rnd_gnb_data(void)
   case GNB_GLOBAL_TYPE_ID:
     gnb.global_ng_ran_node_id->global_gnb_id.plmn_id = (e2sm_plmn_t) {.mcc = 505, .mnc = 1, .mnc_digit_len = 2};
 //    gnb.global_ng_ran_node_id->global_gnb_id.type = GNB_TYPE_ID;
-    gnb.global_ng_ran_node_id->global_gnb_id.gnb_id = (rand() % 4294967296) + 0;
+    gnb.global_ng_ran_node_id->global_gnb_id.gnb_id = (e2ap_gnb_id_t){.nb_id = rand(), .unused = 0};
     break;
   
   case NG_ENB_GLOBAL_TYPE_ID:
@@ -1194,7 +1172,7 @@ ng_enb_e2sm_t fill_rnd_ng_enb_data(void)
   case GNB_GLOBAL_TYPE_ID:
     ng_enb.global_ng_ran_node_id->global_gnb_id.plmn_id = (e2sm_plmn_t) {.mcc = 505, .mnc = 1, .mnc_digit_len = 2};
     //ng_enb.global_ng_ran_node_id->global_gnb_id.type = GNB_TYPE_ID;
-    ng_enb.global_ng_ran_node_id->global_gnb_id.gnb_id = (rand() % 4294967296) + 0;
+    ng_enb.global_ng_ran_node_id->global_gnb_id.gnb_id = (e2ap_gnb_id_t){.nb_id = rand(), .unused = 0};
     break;
   
   case NG_ENB_GLOBAL_TYPE_ID:
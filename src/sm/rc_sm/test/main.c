@@ -32,6 +32,7 @@
 #include "fill_rnd_data_rc.h"
 
 #include "../ie/rc_data_ie.h"
+#include "../rc_sm_ric.h"
 
 #include "fill_rnd_data_rc.h"
 
@@ -139,6 +140,50 @@ void test_rc_ctrl_msg(void)
   assert(eq_e2sm_rc_ctrl_msg(&msg, &out) == true);
 }
 
+// Targets of a control, as used by the RIC to detect conflicting controls
+void test_rc_ctrl_targets(void)
+{
+  rc_ctrl_req_data_t req = {.hdr = fill_rnd_rc_ctrl_hdr(), .msg = fill_rnd_rc_ctrl_msg()};
+  defer({ free_e2sm_rc_ctrl_hdr(&req.hdr); free_e2sm_rc_ctrl_msg(&req.msg); });
+
+  sm_ric_t* sm = make_rc_sm_ric();
+  defer({ sm->free_sm(sm); });
+  assert(sm->conflict.targets != NULL);
+
+  sm_ctrl_req_data_t data = sm->proc.on_control_req(sm, &req);
+  defer({ free_sm_ctrl_req_data(&data); });
+
+  size_t num = 0;
+  if(req.msg.format == FORMAT_1_E2SM_RC_CTRL_MSG){
+    num = req.msg.frmt_1.sz_ran_param;
+  } else {
+    for(size_t i = 0; i < req.msg.frmt_2.sz_seq_ctrl_sma; ++i){
+      seq_ctrl_sma_t const* sma = &req.msg.frmt_2.action[i];
+      for(size_t j = 0; j < sma->sz_seq_ctrl_act; ++j)
+        num += sma->seq_ctrl_act[j].ctrl_msg_frmt_1 != NULL ? sma->seq_ctrl_act[j].ctrl_msg_frmt_1->sz_ran_param : 0;
+    }
+  }
+
+  sm_ctrl_target_t* t0 = NULL;
+  size_t const len0 = sm->conflict.targets(sm, &data, &t0);
+  sm_ctrl_target_t* t1 = NULL;
+  size_t const len1 = sm->conflict.targets(sm, &data, &t1);
+  assert(len0 == num && len1 == num);
+
+  // Deterministic, so that the same control never conflicts with itself
+  for(size_t i = 0; i < num; ++i){
+    assert(eq_byte_array(&t0[i].target, &t1[i].target));
+    assert(eq_byte_array(&t0[i].param, &t1[i].param));
+    assert(eq_byte_array(&t0[i].val, &t1[i].val));
+    assert(t0[i].val.len > 0);
+
+    free_byte_array(t0[i].target); free_byte_array(t0[i].param); free_byte_array(t0[i].val);
+    free_byte_array(t1[i].target); free_byte_array(t1[i].param); free_byte_array(t1[i].val);
+  }
+  free(t0);
+  free(t1);
+}
+
 void test_rc_ctrl_out(void)
 {
   e2sm_rc_ctrl_out_t msg = fill_rnd_rc_ctrl_out();
@@ -207,6 +252,11 @@ int main()
    test_rc_ctrl_msg();
    printf("\nRC Control Message\n");
 
+  // Control targets
+  for(size_t i = 0; i < 16; ++i)
+    test_rc_ctrl_targets();
+  printf("\nRC Control Targets\n");
+
   // Control Outcome 
   test_rc_ctrl_out();
   printf("\nRC Control Outcome\n");
@@ -0,0 +1,84 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+#ifndef RLC_WIRE_PLAIN_H
+#define RLC_WIRE_PLAIN_H
+
+// Layout of the RLC SM plain encoding, see util/plain_wire.h. Fields are 
+// only appended at the end of a list, as the older readers know a prefix
+
+#include "rlc_data_ie.h"
+#include "../../../util/plain_wire.h"
+
+#define RLC_EVENT_TRIGGER_WIRE(F, A, T) F(T, ms)
+
+#define RLC_IND_HDR_WIRE(F, A, T) F(T, dummy)
+
+#define RLC_CTRL_HDR_WIRE(F, A, T) F(T, dummy)
+
+#define RLC_CTRL_MSG_WIRE(F, A, T) F(T, action)
+
+#define RLC_RB_STATS_WIRE(F, A, T) \
+  F(T, txpdu_pkts) \
+  F(T, txpdu_bytes) \
+  F(T, txpdu_wt_ms) \
+  F(T, txpdu_dd_pkts) \
+  F(T, txpdu_dd_bytes) \
+  F(T, txpdu_retx_pkts) \
+  F(T, txpdu_retx_bytes) \
+  F(T, txpdu_segmented) \
+  F(T, txpdu_status_pkts) \
+  F(T, txpdu_status_bytes) \
+  F(T, txbuf_occ_bytes) \
+  F(T, txbuf_occ_pkts) \
+  F(T, rxpdu_pkts) \
+  F(T, rxpdu_bytes) \
+  F(T, rxpdu_dup_pkts) \
+  F(T, rxpdu_dup_bytes) \
+  F(T, rxpdu_dd_pkts) \
+  F(T, rxpdu_dd_bytes) \
+  F(T, rxpdu_ow_pkts) \
+  F(T, rxpdu_ow_bytes) \
+  F(T, rxpdu_status_pkts) \
+  F(T, rxpdu_status_bytes) \
+  F(T, rxbuf_occ_bytes) \
+  F(T, rxbuf_occ_pkts) \
+  F(T, txsdu_pkts) \
+  F(T, txsdu_bytes) \
+  F(T, txsdu_avg_time_to_tx) \
+  F(T, txsdu_wt_us) \
+  F(T, rxsdu_pkts) \
+  F(T, rxsdu_bytes) \
+  F(T, rxsdu_dd_pkts) \
+  F(T, rxsdu_dd_bytes) \
+  F(T, rnti) \
+  F(T, mode) \
+  F(T, rbid)
+
+PLAIN_WIRE_REC_MSG(rlc_event_trigger, rlc_event_trigger_t, RLC_EVENT_TRIGGER_WIRE)
+PLAIN_WIRE_REC_MSG(rlc_ind_hdr, rlc_ind_hdr_t, RLC_IND_HDR_WIRE)
+PLAIN_WIRE_REC_MSG(rlc_ctrl_hdr, rlc_ctrl_hdr_t, RLC_CTRL_HDR_WIRE)
+PLAIN_WIRE_REC_MSG(rlc_ctrl_msg, rlc_ctrl_msg_t, RLC_CTRL_MSG_WIRE)
+
+PLAIN_WIRE_REC(rlc_rb_stats, rlc_radio_bearer_stats_t, RLC_RB_STATS_WIRE)
+PLAIN_WIRE_ARR_MSG(rlc_ind_msg, rlc_ind_msg_t, rb, len, rlc_rb_stats, rlc_radio_bearer_stats_t, RLC_RB_STATS_WIRE)
+
+#endif
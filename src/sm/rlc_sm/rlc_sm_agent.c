@@ -21,6 +21,7 @@
 
 
 #include "rlc_sm_agent.h"
+#include "../sm_enc.h"
 #include "rlc_sm_id.h"
 #include "enc/rlc_enc_generic.h"
 #include "dec/rlc_dec_generic.h"
@@ -153,14 +154,7 @@ sm_e2_setup_data_t on_e2_setup_rlc_sm_ag(sm_agent_t const* sm_agent)
   // ToDo: in other SMs we should call the RAN to fulfill this data
   // as it represents the capabilities of the RAN Function
 
-  size_t const sz = strnlen(SM_RLC_STR, 256);
-  assert(sz < 256 && "Buffer overeflow?");
-
-  setup.len_rfd = sz;
-  setup.ran_fun_def = calloc(1, sz);
-  assert(setup.ran_fun_def != NULL);
-
-  memcpy(setup.ran_fun_def, SM_RLC_STR , sz);
+  setup = tag_ran_func_def_sm_enc(SM_RLC_STR, SM_ENC_COMPILED);
   
   /*
   // RAN Function
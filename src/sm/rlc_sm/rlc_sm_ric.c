@@ -262,6 +262,8 @@ sm_ric_t* make_rlc_sm_ric(void)
   assert(strlen(SM_RLC_STR) < sizeof( sm->base.ran_func_name) );
   memcpy(sm->base.ran_func_name, SM_RLC_STR, strlen(SM_RLC_STR)); 
 
+  sm->base.enc = SM_ENC_COMPILED;
+
   return &sm->base;
 }
 
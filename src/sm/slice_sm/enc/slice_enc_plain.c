@@ -1,4 +1,5 @@
 #include "slice_enc_plain.h"
+#include "../ie/slice_wire_plain.h"
 
 #include <assert.h>
 #include <stdlib.h>
@@ -7,15 +8,7 @@
 byte_array_t slice_enc_event_trigger_plain(slice_event_trigger_t const* event_trigger)
 {
   assert(event_trigger != NULL);
-  byte_array_t  ba = {0};
- 
-  ba.len = sizeof(event_trigger->ms);
-  ba.buf = malloc(ba.len);
-  assert(ba.buf != NULL && "Memory exhausted");
-
-  memcpy(ba.buf, &event_trigger->ms, ba.len);
-
-  return ba;
+  return enc_slice_event_trigger_plain_wire(event_trigger);
 }
 
 byte_array_t slice_enc_action_def_plain(slice_action_def_t const* action_def)
@@ -30,15 +23,7 @@ byte_array_t slice_enc_action_def_plain(slice_action_def_t const* action_def)
 byte_array_t slice_enc_ind_hdr_plain(slice_ind_hdr_t const* ind_hdr)
 {
   assert(ind_hdr != NULL);
-
-  byte_array_t ba = {0};
-
-  ba.len = sizeof(slice_ind_hdr_t);
-  ba.buf = calloc(ba.len , sizeof(uint8_t));
-  assert(ba.buf != NULL && "memory exhausted");
-  memcpy(ba.buf, ind_hdr,ba.len);
-
-  return ba;
+  return enc_slice_ind_hdr_plain_wire(ind_hdr);
 }
 
 static inline
@@ -209,11 +194,11 @@ size_t fill_static(uint8_t* it, static_slice_t* sta)
 
   assert(it < end);
 
-  memcpy(it, &sta->pos_high, sizeof(sta->pos_high));
+  put_plain_wire(it, sta->pos_high);
   it += sizeof(sta->pos_high);
   size_t sz = sizeof(sta->pos_high);
 
-  memcpy(it, &sta->pos_low, sizeof(sta->pos_low));
+  put_plain_wire(it, sta->pos_low);
   it += sizeof(sta->pos_low);
   sz += sizeof(sta->pos_low);
 
@@ -227,11 +212,11 @@ size_t fill_rate(uint8_t* it, nvs_rate_t const* nvs)
   assert(nvs != NULL);
 
 
-  memcpy(it, &nvs->u2.mbps_reference, sizeof(nvs->u2.mbps_reference));
+  put_plain_wire(it, nvs->u2.mbps_reference);
   it += sizeof(nvs->u2.mbps_reference);
   size_t sz = sizeof(nvs->u2.mbps_reference);
 
-  memcpy(it, &nvs->u1.mbps_required, sizeof(nvs->u1.mbps_required));
+  put_plain_wire(it, nvs->u1.mbps_required);
   it += sizeof(nvs->u1.mbps_required);
   sz += sizeof(nvs->u1.mbps_required);
 
@@ -244,7 +229,7 @@ size_t fill_capacity(uint8_t* it, nvs_capacity_t const* nvs)
   assert(it != NULL);
   assert(nvs != NULL);
   
-  memcpy(it, &nvs->u.pct_reserved, sizeof(nvs->u.pct_reserved)); 
+  put_plain_wire(it, nvs->u.pct_reserved); 
   it += sizeof(nvs->u.pct_reserved);
   size_t sz = sizeof(nvs->u.pct_reserved);
 
@@ -258,7 +243,7 @@ size_t fill_nvs(uint8_t* it, nvs_slice_t const* nvs)
   assert(nvs != NULL);
   
 
-  memcpy(it, &nvs->conf, sizeof(nvs->conf));
+  put_plain_wire(it, nvs->conf);
   it += sizeof(nvs->conf);
   size_t sz = sizeof(nvs->conf);
 
@@ -279,15 +264,15 @@ size_t fill_on_demand(uint8_t* it, scn19_on_demand_t* scn)
   assert(it != NULL);
   assert(scn != NULL);
 
-  memcpy(it, &scn->log_delta, sizeof(scn->log_delta));
+  put_plain_wire(it, scn->log_delta);
   it += sizeof(scn->log_delta);
   size_t sz = sizeof(scn->log_delta);
 
-  memcpy(it, &scn->pct_reserved, sizeof(scn->pct_reserved));
+  put_plain_wire(it, scn->pct_reserved);
   it += sizeof(scn->pct_reserved);
   sz += sizeof(scn->pct_reserved);
 
-  memcpy(it, &scn->tau, sizeof(scn->tau));
+  put_plain_wire(it, scn->tau);
   it += sizeof(scn->tau);
   sz += sizeof(scn->tau);
 
@@ -300,7 +285,7 @@ size_t fill_scn19(uint8_t* it, scn19_slice_t* scn)
   assert(it != NULL);
   assert(scn != NULL);
  
-  memcpy(it, &scn->conf, sizeof(scn->conf)); 
+  put_plain_wire(it, scn->conf); 
   it += sizeof(scn->conf);
   size_t sz = sizeof(scn->conf);
 
@@ -323,24 +308,24 @@ size_t fill_edf(uint8_t* it, edf_slice_t* edf)
   assert(it != NULL);
   assert(edf != NULL);
 
-  memcpy(it, &edf->deadline, sizeof(edf->deadline));
+  put_plain_wire(it, edf->deadline);
   it += sizeof(edf->deadline);
   size_t sz = sizeof(edf->deadline);
 
-  memcpy(it, &edf->guaranteed_prbs, sizeof(edf->guaranteed_prbs));
+  put_plain_wire(it, edf->guaranteed_prbs);
   it += sizeof(edf->guaranteed_prbs);
   sz += sizeof(edf->guaranteed_prbs);
 
-  memcpy(it, &edf->max_replenish, sizeof(edf->max_replenish));
+  put_plain_wire(it, edf->max_replenish);
   it += sizeof(edf->max_replenish);
   sz += sizeof(edf->max_replenish);
 
-  memcpy(it, &edf->len_over, sizeof(edf->len_over));
+  put_plain_wire(it, edf->len_over);
   it += sizeof(edf->len_over);
   sz += sizeof(edf->len_over);
 
   for(size_t i = 0; i < edf->len_over; ++i){
-    memcpy(it, &edf->over[i], sizeof(uint32_t));
+    put_plain_wire(it, edf->over[i]);
     it += sizeof(edf->over[i]);
     sz += sizeof(edf->over[i]);
   }
@@ -355,7 +340,7 @@ size_t fill_params(uint8_t* it, slice_params_t* par)
   assert(par != NULL);
 
 
-  memcpy(it, &par->type, sizeof(par->type) );
+  put_plain_wire(it, par->type);
   it += sizeof(par->type);
   size_t sz = sizeof(par->type);
 
@@ -381,24 +366,22 @@ size_t fill_slice(uint8_t* it, fr_slice_t* slc)
   assert(slc != NULL);
   assert(it < end);
 
-  memcpy(it, &slc->id, sizeof(slc->id));
+  put_plain_wire(it, slc->id);
   it += sizeof(slc->id);
   size_t sz = sizeof(slc->id);
 
-  memcpy(it, &slc->len_label, sizeof(slc->len_label) );
+  put_plain_wire(it, slc->len_label);
   it += sizeof(slc->len_label);
   sz += sizeof(slc->len_label);
 
-  memcpy(it, slc->label, slc->len_label);
-  it += slc->len_label;
+  it = put_bytes_plain_wire(it, slc->len_label, slc->label);
   sz += slc->len_label;
 
-  memcpy(it, &slc->len_sched, sizeof(slc->len_sched));
+  put_plain_wire(it, slc->len_sched);
   it += sizeof(slc->len_sched);
   sz += sizeof(slc->len_sched);
 
-  memcpy(it, slc->sched, slc->len_sched);
-  it += slc->len_sched;
+  it = put_bytes_plain_wire(it, slc->len_sched, slc->sched);
   sz += slc->len_sched;
 
   sz += fill_params(it, &slc->params);
@@ -412,15 +395,14 @@ size_t fill_ul_dl_slice_conf(uint8_t* it, ul_dl_slice_conf_t const* conf)
   assert(it != NULL);
   assert(conf != NULL);
 
-  memcpy(it, &conf->len_sched_name, sizeof(conf->len_sched_name)); 
+  put_plain_wire(it, conf->len_sched_name); 
   it += sizeof(conf->len_sched_name);
   size_t sz = sizeof(conf->len_sched_name);
 
-  memcpy(it, conf->sched_name, conf->len_sched_name);
-  it += conf->len_sched_name;
+  it = put_bytes_plain_wire(it, conf->len_sched_name, conf->sched_name);
   sz += conf->len_sched_name;
 
-  memcpy(it, &conf->len_slices, sizeof(conf->len_slices));
+  put_plain_wire(it, conf->len_slices);
   it += sizeof(conf->len_slices);
   sz += sizeof(conf->len_slices);
 
@@ -450,15 +432,15 @@ size_t fill_ue_slice_assoc(uint8_t* it, ue_slice_assoc_t const* assoc)
 
   assert(it < end);
 
-  memcpy(it, &assoc->dl_id, sizeof(assoc->dl_id));
+  put_plain_wire(it, assoc->dl_id);
   it += sizeof(assoc->dl_id);
   size_t sz = sizeof(assoc->dl_id);
 
-  memcpy(it, &assoc->ul_id, sizeof(assoc->ul_id));
+  put_plain_wire(it, assoc->ul_id);
   it += sizeof(assoc->ul_id);
   sz += sizeof(assoc->ul_id);
 
-  memcpy(it, &assoc->rnti, sizeof(assoc->rnti));
+  put_plain_wire(it, assoc->rnti);
   it += sizeof(assoc->rnti);
   sz += sizeof(assoc->rnti);
 
@@ -471,7 +453,7 @@ size_t fill_ue_slice_conf(uint8_t* it, ue_slice_conf_t const* slc)
   assert(it != NULL);
   assert(slc != NULL);
 
-  memcpy(it, &slc->len_ue_slice, sizeof(slc->len_ue_slice));
+  put_plain_wire(it, slc->len_ue_slice);
   it += sizeof(slc->len_ue_slice);
   size_t sz = sizeof(slc->len_ue_slice);
 
@@ -492,20 +474,20 @@ byte_array_t slice_enc_ind_msg_plain(slice_ind_msg_t const* ind_msg)
 
   byte_array_t ba = {0};
 
-  size_t sz = cal_ind_msg_payload(ind_msg);
+  size_t sz = PLAIN_WIRE_TREE_MSG_HDR_LEN + cal_ind_msg_payload(ind_msg);
 
   ba.buf = malloc(sz); 
   assert(ba.buf != NULL && "Memory exhausted");
   end = ba.buf + sz;
 
-  uint8_t* it = ba.buf;
+  uint8_t* it = put_u8_plain_wire(ba.buf, PLAIN_WIRE_VERSION);
   size_t pos1 = fill_slice_conf(it, &ind_msg->slice_conf); 
   it += pos1;
   size_t pos2 = fill_ue_slice_conf(it, &ind_msg->ue_slice_conf);
 
   it += pos2;
   // tstamp
-  memcpy(it, &ind_msg->tstamp, sizeof(ind_msg->tstamp));
+  put_plain_wire(it, ind_msg->tstamp);
   it += sizeof(ind_msg->tstamp);
   assert(it == ba.buf + sz && "Mismatch of data layout");
 
@@ -525,14 +507,7 @@ byte_array_t slice_enc_call_proc_id_plain(slice_call_proc_id_t const* call_proc_
 byte_array_t slice_enc_ctrl_hdr_plain(slice_ctrl_hdr_t const* ctrl_hdr)
 {
   assert(ctrl_hdr != NULL);
-
-  byte_array_t ba = {0};
-  ba.len = sizeof(slice_ind_hdr_t);
-  ba.buf = calloc(ba.len, sizeof(uint8_t));
-  assert(ba.buf != NULL && "memory exhausted");
-  memcpy(ba.buf, ctrl_hdr, ba.len);
-
-  return ba;
+  return enc_slice_ctrl_hdr_plain_wire(ctrl_hdr);
 }
 
 static
@@ -575,22 +550,22 @@ size_t fill_del_slice_conf(uint8_t* it, del_slice_conf_t const* conf)
   assert(it != NULL);
   assert(conf != NULL);
 
-  memcpy(it, &conf->len_dl, sizeof(conf->len_dl));
+  put_plain_wire(it, conf->len_dl);
   it += sizeof(conf->len_dl);
   size_t sz = sizeof(conf->len_dl);
 
   for(size_t i = 0; i < conf->len_dl; ++i){
-    memcpy(it, &conf->dl[i], sizeof(uint32_t)); 
+    put_plain_wire(it, conf->dl[i]); 
     it += sizeof(uint32_t);
     sz += sizeof(uint32_t);
   }
 
-  memcpy(it, &conf->len_ul, sizeof(conf->len_ul));
+  put_plain_wire(it, conf->len_ul);
   it += sizeof(conf->len_ul);
   sz += sizeof(conf->len_ul);
 
   for(size_t i = 0; i < conf->len_ul; ++i){
-    memcpy(it, &conf->ul[i], sizeof(uint32_t)); 
+    put_plain_wire(it, conf->ul[i]); 
     it += sizeof(uint32_t);
     sz += sizeof(uint32_t);
   }
@@ -604,7 +579,7 @@ size_t fill_slice_ctrl_msg(uint8_t* it, slice_ctrl_msg_t const* msg )
   assert(it != NULL);
   assert(msg != NULL);
 
-  memcpy(it, &msg->type, sizeof(msg->type));
+  put_plain_wire(it, msg->type);
   it += sizeof(msg->type);
   size_t sz = sizeof(msg->type);
 
@@ -627,7 +602,7 @@ byte_array_t slice_enc_ctrl_msg_plain(slice_ctrl_msg_t const* ctrl_msg)
 
   byte_array_t ba = {0};
  
-  size_t const sz = cal_ctrl_msg_payload(ctrl_msg);
+  size_t const sz = PLAIN_WIRE_TREE_MSG_HDR_LEN + cal_ctrl_msg_payload(ctrl_msg);
 
   ba.buf = malloc(sz);
   assert(ba.buf != NULL && "Memory exhausted");
@@ -635,10 +610,10 @@ byte_array_t slice_enc_ctrl_msg_plain(slice_ctrl_msg_t const* ctrl_msg)
 
   end = ba.buf + sz;
 
-  uint8_t* it = ba.buf;
+  uint8_t* it = put_u8_plain_wire(ba.buf, PLAIN_WIRE_VERSION);
   size_t const pos = fill_slice_ctrl_msg(it, ctrl_msg);
 
-  assert(pos == sz && "Mismatch of data layout");
+  assert(PLAIN_WIRE_TREE_MSG_HDR_LEN + pos == sz && "Mismatch of data layout");
 
   return ba;
 }
@@ -648,17 +623,16 @@ byte_array_t slice_enc_ctrl_out_plain(slice_ctrl_out_t const* ctrl)
   assert(ctrl != NULL );
   byte_array_t ba = {0};
 
-  ba.len = sizeof(ctrl->len_diag) + ctrl->len_diag;
+  ba.len = PLAIN_WIRE_TREE_MSG_HDR_LEN + sizeof(ctrl->len_diag) + ctrl->len_diag;
 
   ba.buf = malloc(ba.len);
   assert(ba.buf != NULL && "Memory exhausted");
-  uint8_t* it = ba.buf;
+  uint8_t* it = put_u8_plain_wire(ba.buf, PLAIN_WIRE_VERSION);
 
-  memcpy(it, &ctrl->len_diag, sizeof(ctrl->len_diag));
+  put_plain_wire(it, ctrl->len_diag);
   it += sizeof(ctrl->len_diag);
 
-  memcpy(it, ctrl->diagnostic, ctrl->len_diag);
-  it += ctrl->len_diag;
+  it = put_bytes_plain_wire(it, ctrl->len_diag, ctrl->diagnostic);
 
   assert(it == ba.buf + ba.len);
 
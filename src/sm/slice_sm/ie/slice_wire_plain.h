@@ -0,0 +1,42 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+#ifndef SLICE_WIRE_PLAIN_H
+#define SLICE_WIRE_PLAIN_H
+
+// Layout of the slice SM plain encoding, see util/plain_wire.h. The 
+// indication and control messages and the control outcome are trees, 
+// written by slice_enc_plain.c
+
+#include "slice_data_ie.h"
+#include "../../../util/plain_wire.h"
+
+#define SLICE_EVENT_TRIGGER_WIRE(F, A, T) F(T, ms)
+
+#define SLICE_IND_HDR_WIRE(F, A, T) F(T, dummy)
+
+#define SLICE_CTRL_HDR_WIRE(F, A, T) F(T, dummy)
+
+PLAIN_WIRE_REC_MSG(slice_event_trigger, slice_event_trigger_t, SLICE_EVENT_TRIGGER_WIRE)
+PLAIN_WIRE_REC_MSG(slice_ind_hdr, slice_ind_hdr_t, SLICE_IND_HDR_WIRE)
+PLAIN_WIRE_REC_MSG(slice_ctrl_hdr, slice_ctrl_hdr_t, SLICE_CTRL_HDR_WIRE)
+
+#endif
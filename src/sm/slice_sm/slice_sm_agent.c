@@ -1,4 +1,5 @@
 #include "slice_sm_agent.h"
+#include "../sm_enc.h"
 #include "slice_sm_id.h"
 #include "enc/slice_enc_generic.h"
 #include "dec/slice_dec_generic.h"
@@ -127,14 +128,7 @@ sm_e2_setup_data_t on_e2_setup_slice_sm_ag(sm_agent_t const* sm_agent)
 
   sm_e2_setup_data_t setup = {.len_rfd =0, .ran_fun_def = NULL }; 
 
-  size_t const sz = strnlen(SM_SLICE_STR, 256);
-  assert(sz < 256 && "Buffer overeflow?");
-
-  setup.len_rfd = sz;
-  setup.ran_fun_def = calloc(1, sz);
-  assert(setup.ran_fun_def != NULL);
-
-  memcpy(setup.ran_fun_def, SM_SLICE_STR , sz);
+  setup = tag_ran_func_def_sm_enc(SM_SLICE_STR, SM_ENC_COMPILED);
  
 /*
   setup.len_rfd = strlen(sm->base.ran_func_name);
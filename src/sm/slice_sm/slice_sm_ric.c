@@ -232,6 +232,8 @@ sm_ric_t* make_slice_sm_ric(void /* sm_io_ric_t io */)
   assert(strlen(SM_SLICE_STR) < sizeof( sm->base.ran_func_name) );
   memcpy(sm->base.ran_func_name, SM_SLICE_STR, strlen(SM_SLICE_STR)); 
 
+  sm->base.enc = SM_ENC_COMPILED;
+
   return &sm->base;
 }
 
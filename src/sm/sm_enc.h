@@ -0,0 +1,123 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+
+#ifndef SM_ENCODING_MIR_H
+#define SM_ENCODING_MIR_H
+
+#include "sm_proc_data.h"
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Runtime view of the encoding a SM plug-in speaks. The encoder is still
+// selected at compile time (i.e., PLAIN, ASN or FLATBUFFERS), but the agent
+// advertises it per RAN function at E2 Setup, so that the RIC only accepts
+// the RAN functions that its own plug-in is able to decode
+typedef enum{
+  PLAIN_SM_ENC,
+  ASN_SM_ENC,
+  FB_SM_ENC,
+
+  END_SM_ENC
+} sm_enc_e;
+
+#ifdef ASN
+#define SM_ENC_COMPILED ASN_SM_ENC
+#elif FLATBUFFERS
+#define SM_ENC_COMPILED FB_SM_ENC
+#elif PLAIN
+#define SM_ENC_COMPILED PLAIN_SM_ENC
+#endif
+
+// Appended to the RAN Function Definition e.g., MAC_STATS_V0;enc=plain
+#define SM_ENC_TAG ";enc="
+
+static inline
+const char* sm_enc_str(sm_enc_e enc)
+{
+  if(enc == PLAIN_SM_ENC)
+    return "plain";
+  else if(enc == ASN_SM_ENC)
+    return "asn";
+  else if(enc == FB_SM_ENC)
+    return "fb";
+  return "unknown";
+}
+
+// RAN Function Definition of the SMs that advertise a string
+// The encoding is appended to the name of the SM
+static inline
+sm_e2_setup_data_t tag_ran_func_def_sm_enc(const char* name, sm_enc_e enc)
+{
+  assert(name != NULL);
+  assert(enc < END_SM_ENC);
+
+  size_t const sz_name = strnlen(name, 256);
+  assert(sz_name < 256 && "Buffer overflow?");
+
+  const char* enc_str = sm_enc_str(enc);
+  size_t const sz = sz_name + strlen(SM_ENC_TAG) + strlen(enc_str);
+
+  sm_e2_setup_data_t setup = {.len_rfd = sz};
+  setup.ran_fun_def = calloc(1, sz);
+  assert(setup.ran_fun_def != NULL && "Memory exhausted");
+
+  memcpy(setup.ran_fun_def, name, sz_name);
+  memcpy(setup.ran_fun_def + sz_name, SM_ENC_TAG, strlen(SM_ENC_TAG));
+  memcpy(setup.ran_fun_def + sz_name + strlen(SM_ENC_TAG), enc_str, strlen(enc_str));
+
+  return setup;
+}
+
+// Encoding advertised in the RAN Function Definition
+// Returns false if the agent did not advertise it i.e., ASN RAN Function
+// Definitions (KPM, RC) and agents that predate the tag. An advertised but
+// unknown encoding is returned as END_SM_ENC
+static inline
+bool ran_func_def_sm_enc(size_t len, uint8_t const* def, sm_enc_e* enc)
+{
+  assert(def != NULL || len == 0);
+  assert(enc != NULL);
+
+  size_t const sz_tag = strlen(SM_ENC_TAG);
+  for(size_t i = 0; i + sz_tag <= len; ++i){
+    if(memcmp(def + i, SM_ENC_TAG, sz_tag) != 0)
+      continue;
+
+    uint8_t const* val = def + i + sz_tag;
+    size_t const sz_val = len - i - sz_tag;
+    *enc = END_SM_ENC;
+    for(int e = PLAIN_SM_ENC; e < END_SM_ENC; ++e){
+      const char* enc_str = sm_enc_str(e);
+      if(sz_val == strlen(enc_str) && memcmp(val, enc_str, sz_val) == 0)
+        *enc = e;
+    }
+    return true;
+  }
+
+  return false;
+}
+
+#endif
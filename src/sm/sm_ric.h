@@ -29,6 +29,10 @@
 #include "sm_alloc.h"
 #include "sm_io.h"
 #include "sm_proc_data.h"
+#include "sm_enc.h"
+#include "../util/byte_array.h"
+
+#include <stdbool.h>
 
 typedef struct sm_ric_s sm_ric_t;
 
@@ -54,11 +58,59 @@ typedef struct {
 
 } sm_e2ap_procedures_ric_t;
 
+// Filtering and projection of the indication messages on behalf of an xApp
+typedef struct {
+
+  // NULL if the filter is malformed
+  void* (*compile)(sm_ric_t const*, byte_array_t filter);
+
+  // Returns false if no record survived. Otherwise, dst holds the encoded projected indication message.
+  // Filters may keep state, e.g., windowed aggregates
+  bool (*apply)(sm_ric_t const*, void* filter, sm_ind_data_t const* src, byte_array_t* dst);
+
+  void (*free)(sm_ric_t const*, void* filter);
+
+} sm_ind_filter_ric_t;
+
+// What a control request acts on. Two controls conflict if they set the 
+// same parameter of the same target to different values
+typedef struct {
+  // e.g., a UE. Empty if the control acts on the whole E2 Node
+  byte_array_t target;
+  byte_array_t param;
+  byte_array_t val;
+} sm_ctrl_target_t;
+
+// Detection of conflicting control requests from different xApps
+typedef struct {
+
+  // Returns the number of targets in dst, 0 if the control could not be decoded
+  size_t (*targets)(sm_ric_t const*, sm_ctrl_req_data_t const* src, sm_ctrl_target_t** dst);
+
+} sm_ctrl_conflict_ric_t;
+
+// Conflation of the indications queued for a slow xApp
+typedef struct {
+
+  // What the indication reports on, e.g., the UE. Empty if it reports on the whole E2 Node
+  byte_array_t (*key)(sm_ric_t const*, sm_ind_data_t const* src);
+
+} sm_ind_conflate_ric_t;
+
 typedef struct sm_ric_s {
 
   // 5 Procedures stored at the SO
   sm_e2ap_procedures_ric_t proc; 
 
+  // Optional, NULL members if the SM does not support it
+  sm_ind_filter_ric_t filter;
+
+  // Optional, NULL members if the SM does not support it
+  sm_ctrl_conflict_ric_t conflict;
+
+  // Optional, NULL members if the SM does not support it
+  sm_ind_conflate_ric_t conflate;
+
   // Free function
   void (*free_sm)(sm_ric_t* sm_ric);
 
@@ -73,6 +125,9 @@ typedef struct sm_ric_s {
 
   char ran_func_name[32];
 
+  // Encoding understood by the plug-in
+  sm_enc_e enc;
+
 } sm_ric_t;
 
 #endif
@@ -1,4 +1,5 @@
 #include "tc_enc_plain.h"
+#include "../ie/tc_wire_plain.h"
 
 #include <assert.h>
 #include <stdlib.h>
@@ -7,15 +8,7 @@
 byte_array_t tc_enc_event_trigger_plain(tc_event_trigger_t const* event_trigger)
 {
   assert(event_trigger != NULL);
-  byte_array_t  ba = {0};
- 
-  ba.len = sizeof(event_trigger->ms);
-  ba.buf = malloc(ba.len);
-  assert(ba.buf != NULL && "Memory exhausted");
-
-  memcpy(ba.buf, &event_trigger->ms, ba.len);
-
-  return ba;
+  return enc_tc_event_trigger_plain_wire(event_trigger);
 }
 
 byte_array_t tc_enc_action_def_plain(tc_action_def_t const* action_def)
@@ -30,15 +23,7 @@ byte_array_t tc_enc_action_def_plain(tc_action_def_t const* action_def)
 byte_array_t tc_enc_ind_hdr_plain(tc_ind_hdr_t const* ind_hdr)
 {
   assert(ind_hdr != NULL);
-
-  byte_array_t ba = {0};
-
-  ba.len = sizeof(tc_ind_hdr_t);
-  ba.buf = calloc(ba.len , sizeof(uint8_t));
-  assert(ba.buf != NULL && "memory exhausted");
-  memcpy(ba.buf, ind_hdr, ba.len);
-
-  return ba;
+  return enc_tc_ind_hdr_plain_wire(ind_hdr);
 }
 
 static
@@ -98,7 +83,7 @@ size_t cal_cls_osi_payload( tc_cls_osi_t const* osi)
 
   size_t sz = sizeof(osi->len);
 
-  sz += sizeof(tc_cls_osi_filter_t)*osi->len;
+  sz += TC_CLS_OSI_FILTER_WIRE_LEN*osi->len;
 
   return sz;
 
@@ -260,12 +245,12 @@ size_t tc_enc_sch_prio(uint8_t* it, tc_sch_prio_t const* p)
   assert(it != NULL);
   assert(p != NULL);
 
-  memcpy(it, &p->len_q_prio, sizeof(p->len_q_prio));
+  put_plain_wire(it, p->len_q_prio);
   it += sizeof(p->len_q_prio);
   size_t sz = sizeof(p->len_q_prio);
 
-  memcpy(it, p->q_prio, sizeof(uint32_t)*p->len_q_prio);
-  it += sizeof(uint32_t)*p->len_q_prio;
+  for(size_t i = 0; i < p->len_q_prio; ++i)
+    it = put_plain_wire(it, p->q_prio[i]);
   sz += sizeof(uint32_t)*p->len_q_prio;
 
   return sz;
@@ -278,7 +263,7 @@ size_t tc_enc_sch(uint8_t* it, tc_sch_t const* sch)
   assert(sch != NULL);
 
   size_t sz = sizeof(tc_sch_e);
-  memcpy(it, &sch->type, sizeof(tc_sch_e));
+  put_plain_wire(it, sch->type);
   it += sizeof(tc_sch_e);
 
   if(sch->type == TC_SCHED_RR ){
@@ -302,11 +287,11 @@ size_t tc_enc_mtr(uint8_t* it, tc_mtr_t const* mtr)
   assert(it != NULL);
   assert(mtr != NULL);
 
-  memcpy(it, mtr->bnd_uint, sizeof(uint8_t)*4);
-  it += sizeof(uint8_t)*4;
-  size_t sz = sizeof(uint8_t)*4;
+  put_plain_wire(it, mtr->bnd_flt);
+  it += sizeof(mtr->bnd_flt);
+  size_t sz = sizeof(mtr->bnd_flt);
 
-  memcpy(it, &mtr->time_window_ms, sizeof(uint32_t) );
+  put_plain_wire(it, mtr->time_window_ms);
   sz += sizeof(uint32_t);
   return sz;
 }
@@ -317,11 +302,11 @@ size_t tc_enc_pcr(uint8_t* it, tc_pcr_t const* pcr)
   assert(it != NULL);
   assert(pcr != NULL);
 
-  memcpy(it, &pcr->type, sizeof(tc_pcr_e));
+  put_plain_wire(it, pcr->type);
   it += sizeof(tc_pcr_e);
   size_t sz = sizeof(tc_pcr_e);
 
-  memcpy(it, &pcr->id, sizeof(uint32_t) );
+  put_plain_wire(it, pcr->id);
   it += sizeof(uint32_t);
   sz += sizeof(uint32_t);
 
@@ -335,7 +320,7 @@ size_t tc_enc_cls_rr(uint8_t* it, tc_cls_rr_t const* rr)
   assert(it != NULL);
   assert(rr != NULL);
 
-  memcpy(it, &rr->dummy, sizeof(uint32_t));
+  put_plain_wire(it, rr->dummy);
   return sizeof(uint32_t);
 }
 
@@ -345,14 +330,13 @@ size_t tc_enc_cls_osi(uint8_t* it, tc_cls_osi_t const* osi)
   assert(it != NULL);
   assert(osi != NULL);
 
-  memcpy(it, &osi->len, sizeof(osi->len));
+  put_plain_wire(it, osi->len);
   it += sizeof(osi->len);
   size_t sz = sizeof(osi->len);
 
   for(size_t i = 0; i < osi->len; ++i){
-    memcpy(it, &osi->flt[i], sizeof(tc_cls_osi_filter_t ) );
-    it += sizeof(tc_cls_osi_filter_t);
-    sz += sizeof(tc_cls_osi_filter_t); 
+    it = enc_tc_cls_osi_filter_plain_wire(it, &osi->flt[i]);
+    sz += TC_CLS_OSI_FILTER_WIRE_LEN;
   }
 
   return sz;
@@ -364,7 +348,7 @@ size_t tc_enc_cls_sto(uint8_t* it, tc_cls_sto_t const* sto)
   assert(it != NULL);
   assert(sto != NULL);
 
-  memcpy(it, &sto->dummy, sizeof(uint32_t));
+  put_plain_wire(it, sto->dummy);
   return sizeof(uint32_t);
 }
 
@@ -374,7 +358,7 @@ size_t tc_enc_cls(uint8_t* it, tc_cls_t const* cls)
   assert(it != NULL);
   assert(cls != NULL);
 
-  memcpy(it, &cls->type, sizeof(tc_cls_e) );
+  put_plain_wire(it, cls->type);
   it += sizeof(tc_cls_e);
   size_t sz = sizeof(tc_cls_e);
 
@@ -403,15 +387,15 @@ size_t tc_enc_shp(uint8_t* it, tc_shp_t const* shp)
   assert(it != NULL);
   assert(shp != NULL);
 
-  memcpy(it, &shp->id, sizeof(uint32_t) ); 
+  put_plain_wire(it, shp->id); 
   it += sizeof(uint32_t);
   size_t sz = sizeof(uint32_t);
 
-  memcpy(it, &shp->active, sizeof(uint32_t) ); 
+  put_plain_wire(it, shp->active); 
   it += sizeof(uint32_t);
   sz += sizeof(uint32_t);
 
-  memcpy(it, &shp->max_rate_kbps, sizeof(uint32_t) ); 
+  put_plain_wire(it, shp->max_rate_kbps); 
   it += sizeof(uint32_t);
   sz += sizeof(uint32_t);
 
@@ -426,7 +410,7 @@ size_t tc_enc_drp(uint8_t* it, tc_drp_t const* drp)
   assert(it != NULL);
   assert(drp != NULL);
 
-  memcpy(it, &drp-> dropped_pkts, sizeof(uint32_t ) );
+  put_plain_wire(it, drp->dropped_pkts);
   // it += sizeof(uint32_t)
   size_t sz = sizeof(uint32_t);
 
@@ -440,7 +424,7 @@ size_t tc_enc_mrk(uint8_t* it, tc_mrk_t const* mrk)
   assert(it != NULL);
   assert(mrk != NULL);
 
-  memcpy(it, &mrk->marked_pkts, sizeof(uint32_t));
+  put_plain_wire(it, mrk->marked_pkts);
   size_t sz = sizeof(uint32_t);
   // it += sz;
   return sz;
@@ -452,7 +436,7 @@ size_t tc_enc_plc(uint8_t* it, tc_plc_t const* plc)
   assert(it != NULL);
   assert(plc != NULL);
 
-  memcpy(it, &plc->id, sizeof(uint32_t));
+  put_plain_wire(it, plc->id);
   it += sizeof(uint32_t);
   size_t sz = sizeof(uint32_t);
 
@@ -469,20 +453,20 @@ size_t tc_enc_plc(uint8_t* it, tc_plc_t const* plc)
   sz += sz_mrk;
 
 
-  memcpy(it, &plc->max_rate_kbps, sizeof(float) );
+  put_plain_wire(it, plc->max_rate_kbps);
   it += sizeof(float);
   sz += sizeof(float);
 
 
-  memcpy(it, &plc->active, sizeof(uint32_t) );
+  put_plain_wire(it, plc->active);
   it += sizeof(uint32_t);
   sz += sizeof(uint32_t);
 
-  memcpy(it, &plc->dst_id, sizeof(uint32_t) );
+  put_plain_wire(it, plc->dst_id);
   it += sizeof(uint32_t);
   sz += sizeof(uint32_t);
 
-  memcpy(it, &plc->dev_id, sizeof(uint32_t) );
+  put_plain_wire(it, plc->dev_id);
   it += sizeof(uint32_t);
   sz += sizeof(uint32_t);
 
@@ -496,19 +480,19 @@ size_t tc_enc_q_fifo(uint8_t* it, tc_queue_fifo_t const* q)
   assert(it != NULL);
   assert(q != NULL);
 
-  memcpy(it, &q->bytes, sizeof(uint32_t) );
+  put_plain_wire(it, q->bytes);
   it += sizeof(uint32_t);
   size_t sz = sizeof(uint32_t);
 
-  memcpy(it, &q->pkts, sizeof(uint32_t) );
+  put_plain_wire(it, q->pkts);
   it += sizeof(uint32_t);
   sz += sizeof(uint32_t);
 
-  memcpy(it, &q->bytes_fwd, sizeof(uint32_t) );
+  put_plain_wire(it, q->bytes_fwd);
   it += sizeof(uint32_t);
   sz += sizeof(uint32_t);
 
-  memcpy(it, &q->pkts_fwd, sizeof(uint32_t) );
+  put_plain_wire(it, q->pkts_fwd);
   it += sizeof(uint32_t);
   sz += sizeof(uint32_t);
 
@@ -516,11 +500,11 @@ size_t tc_enc_q_fifo(uint8_t* it, tc_queue_fifo_t const* q)
   it += sz_drp;
   sz += sz_drp;
 
-  memcpy(it, &q->avg_sojourn_time, sizeof(float));
+  put_plain_wire(it, q->avg_sojourn_time);
   it += sizeof(float);
   sz += sizeof(float);
 
-  memcpy(it, &q->last_sojourn_time, sizeof(int64_t));
+  put_plain_wire(it, q->last_sojourn_time);
 //  it += sizeof(int64_t);
   sz += sizeof(int64_t);
 
@@ -533,19 +517,19 @@ size_t tc_enc_q_codel(uint8_t* it, tc_queue_codel_t const* q)
   assert(it != NULL);
   assert(q != NULL);
 
-  memcpy(it, &q->bytes, sizeof(uint32_t) );
+  put_plain_wire(it, q->bytes);
   it += sizeof(uint32_t);
   size_t sz = sizeof(uint32_t);
 
-  memcpy(it, &q->pkts, sizeof(uint32_t) );
+  put_plain_wire(it, q->pkts);
   it += sizeof(uint32_t);
   sz += sizeof(uint32_t);
 
-  memcpy(it, &q->bytes_fwd, sizeof(uint32_t) );
+  put_plain_wire(it, q->bytes_fwd);
   it += sizeof(uint32_t);
   sz += sizeof(uint32_t);
 
-  memcpy(it, &q->pkts_fwd, sizeof(uint32_t) );
+  put_plain_wire(it, q->pkts_fwd);
   it += sizeof(uint32_t);
   sz += sizeof(uint32_t);
 
@@ -553,11 +537,11 @@ size_t tc_enc_q_codel(uint8_t* it, tc_queue_codel_t const* q)
   it += sz_drp;
   sz += sz_drp;
 
-  memcpy(it, &q->avg_sojourn_time, sizeof(float));
+  put_plain_wire(it, q->avg_sojourn_time);
   it += sizeof(float);
   sz += sizeof(float);
 
-  memcpy(it, &q->last_sojourn_time, sizeof(int64_t));
+  put_plain_wire(it, q->last_sojourn_time);
 //  it += sizeof(int64_t);
   sz += sizeof(int64_t);
 
@@ -570,19 +554,19 @@ size_t tc_enc_q_ecn_codel(uint8_t* it, tc_queue_ecn_codel_t const* q)
   assert(it != NULL);
   assert(q != NULL);
 
-  memcpy(it, &q->bytes, sizeof(uint32_t) );
+  put_plain_wire(it, q->bytes);
   it += sizeof(uint32_t);
   size_t sz = sizeof(uint32_t);
 
-  memcpy(it, &q->pkts, sizeof(uint32_t) );
+  put_plain_wire(it, q->pkts);
   it += sizeof(uint32_t);
   sz += sizeof(uint32_t);
 
-  memcpy(it, &q->bytes_fwd, sizeof(uint32_t) );
+  put_plain_wire(it, q->bytes_fwd);
   it += sizeof(uint32_t);
   sz += sizeof(uint32_t);
 
-  memcpy(it, &q->pkts_fwd, sizeof(uint32_t) );
+  put_plain_wire(it, q->pkts_fwd);
   it += sizeof(uint32_t);
   sz += sizeof(uint32_t);
 
@@ -590,11 +574,11 @@ size_t tc_enc_q_ecn_codel(uint8_t* it, tc_queue_ecn_codel_t const* q)
   it += sz_drp;
   sz += sz_drp;
 
-  memcpy(it, &q->avg_sojourn_time, sizeof(float));
+  put_plain_wire(it, q->avg_sojourn_time);
   it += sizeof(float);
   sz += sizeof(float);
 
-  memcpy(it, &q->last_sojourn_time, sizeof(int64_t));
+  put_plain_wire(it, q->last_sojourn_time);
 //  it += sizeof(int64_t);
   sz += sizeof(int64_t);
 
@@ -607,7 +591,7 @@ size_t tc_enc_q(uint8_t* it, tc_queue_t const* q)
   assert(it != NULL);
   assert(q != NULL);
 
-  memcpy(it, &q->type, sizeof( tc_queue_e ));
+  put_plain_wire(it, q->type);
   size_t sz = sizeof(tc_queue_e);
   it += sizeof(tc_queue_e);
 
@@ -638,11 +622,11 @@ byte_array_t tc_enc_ind_msg_plain(tc_ind_msg_t const* ind_msg)
 
   size_t sz = cal_ind_msg_payload(ind_msg);
 
-  ba.buf = malloc(sz); 
-  ba.len = sz;
+  ba.len = PLAIN_WIRE_TREE_MSG_HDR_LEN + sz;
+  ba.buf = malloc(ba.len); 
   assert(ba.buf != NULL && "Memory exhausted");
 
-  uint8_t* it = ba.buf;
+  uint8_t* it = put_u8_plain_wire(ba.buf, PLAIN_WIRE_VERSION);
 
   size_t const sz_sch = tc_enc_sch(it, &ind_msg->sch); 
   it += sz_sch;
@@ -656,7 +640,7 @@ byte_array_t tc_enc_ind_msg_plain(tc_ind_msg_t const* ind_msg)
   it += sz_cls;
   assert(it < ba.buf + ba.len && "iterator out of the chunk of memory");
 
-  memcpy(it, &ind_msg->len_q, sizeof(uint32_t));
+  put_plain_wire(it, ind_msg->len_q);
   size_t const sz_len = sizeof(uint32_t);
   it += sz_len;
   assert(it < ba.buf + ba.len && "iterator out of the chunk of memory");
@@ -679,7 +663,7 @@ byte_array_t tc_enc_ind_msg_plain(tc_ind_msg_t const* ind_msg)
     sz_shp_plc_q += sz_shp + sz_plc + sz_q; 
   }
 
-  memcpy(it, &ind_msg->tstamp, sizeof(int64_t));
+  put_plain_wire(it, ind_msg->tstamp);
   size_t sz_tstamp = sizeof(int64_t); 
   it += sizeof(int64_t);
   assert(it == ba.buf + ba.len && "Mismatch of data layout");
@@ -701,15 +685,7 @@ byte_array_t tc_enc_call_proc_id_plain(tc_call_proc_id_t const* call_proc_id)
 byte_array_t tc_enc_ctrl_hdr_plain(tc_ctrl_hdr_t const* ctrl_hdr)
 {
   assert(ctrl_hdr != NULL);
-
-  byte_array_t ba = {0};
-
-  ba.len = sizeof(tc_ind_hdr_t);
-  ba.buf = calloc(ba.len ,sizeof(uint8_t));
-  assert(ba.buf != NULL && "memory exhausted");
-  memcpy(ba.buf, ctrl_hdr, ba.len);
-
-  return ba;
+  return enc_tc_ctrl_hdr_plain_wire(ctrl_hdr);
 }
 
 static
@@ -769,7 +745,8 @@ size_t cal_tc_mod_ctrl_payload_cls_rr(tc_mod_cls_rr_t const* rr)
 static
 size_t cal_tc_mod_ctrl_payload_cls_osi(tc_mod_cls_osi_t const* osi)
 {
-  return sizeof(osi->filter);
+  assert(osi != NULL);
+  return TC_CLS_OSI_FILTER_WIRE_LEN;
 }
 
 static
@@ -1361,7 +1338,7 @@ size_t enc_tc_add_ctrl_payload_cls_rr(uint8_t* it, tc_add_cls_rr_t const* rr)
   assert(it != NULL);
   assert(rr != NULL);
 
-  memcpy(it, &rr->dummy, sizeof(rr->dummy ));
+  put_plain_wire(it, rr->dummy);
   size_t sz = sizeof(rr->dummy);
   //it += sizeof(rr->dummy);
   return sz;
@@ -1375,23 +1352,23 @@ size_t enc_tc_add_ctrl_payload_cls_osi(uint8_t* it, tc_add_cls_osi_t const* osi)
   assert(it != NULL);
   assert(osi != NULL);
 
-  memcpy(it, &osi->l3.src_addr, sizeof(osi->l3.src_addr) );
+  put_plain_wire(it, osi->l3.src_addr);
   it += sizeof(osi->l3.src_addr);
   size_t sz = sizeof(osi->l3.src_addr);
 
-  memcpy(it, &osi->l3.dst_addr, sizeof(osi->l3.dst_addr) );
+  put_plain_wire(it, osi->l3.dst_addr);
   it += sizeof(osi->l3.dst_addr);
   sz += sizeof(osi->l3.dst_addr);
 
-  memcpy(it, &osi->l4.src_port, sizeof(osi->l4.src_port) );
+  put_plain_wire(it, osi->l4.src_port);
   it += sizeof(osi->l4.src_port);
   sz += sizeof(osi->l4.src_port);
 
-  memcpy(it, &osi->l4.dst_port, sizeof(osi->l4.dst_port) );
+  put_plain_wire(it, osi->l4.dst_port);
   it += sizeof(osi->l4.dst_port);
   sz += sizeof(osi->l4.dst_port);
 
-  memcpy(it, &osi->l4.protocol, sizeof(osi->l4.protocol) );
+  put_plain_wire(it, osi->l4.protocol);
   it += sizeof(osi->l4.protocol);
   sz += sizeof(osi->l4.protocol);
 
@@ -1399,7 +1376,7 @@ size_t enc_tc_add_ctrl_payload_cls_osi(uint8_t* it, tc_add_cls_osi_t const* osi)
   //it += sizeof(osi->l4.protocol);
   //sz += sizeof(osi->l4.protocol);
 
-  memcpy(it, &osi->dst_queue, sizeof(osi->dst_queue) );
+  put_plain_wire(it, osi->dst_queue);
   it += sizeof(osi->dst_queue );
   sz += sizeof(osi->dst_queue );
 
@@ -1413,7 +1390,7 @@ size_t enc_tc_add_ctrl_payload_cls_sto(uint8_t* it, tc_add_cls_sto_t const* sto)
   assert(it != NULL);
   assert(sto != NULL);
 
-  memcpy(it, &sto->dummy, sizeof(sto->dummy ));
+  put_plain_wire(it, sto->dummy);
   size_t sz = sizeof(sto->dummy);
   //it += sizeof(rr->dummy);
   return sz;
@@ -1426,7 +1403,7 @@ size_t enc_tc_add_ctrl_payload_cls(uint8_t* it, tc_add_ctrl_cls_t const* add )
   assert(it != NULL);
   assert(add != NULL);
 
-  memcpy(it, &add->type, sizeof(add->type));
+  put_plain_wire(it, add->type);
   it += sizeof(add->type);
   size_t sz = sizeof(add->type);
 
@@ -1449,7 +1426,7 @@ size_t enc_tc_mod_ctrl_payload_cls_rr(uint8_t* it, tc_mod_cls_rr_t const* rr)
   assert(it != NULL);
   assert(rr != NULL);
 
-  memcpy(it, &rr->dummy, sizeof(rr->dummy));
+  put_plain_wire(it, rr->dummy);
   // it += sizeof(rr->dummy);
   size_t sz = sizeof(rr->dummy);
   return sz;
@@ -1461,9 +1438,8 @@ size_t enc_tc_mod_ctrl_payload_cls_osi(uint8_t* it, tc_mod_cls_osi_t const* osi)
   assert(it != NULL);
   assert(osi != NULL);
 
-  memcpy(it, &osi->filter, sizeof(tc_cls_osi_filter_t) );
-//  it += sizeof(osi->filter);
-  size_t sz = sizeof(osi->filter);
+  enc_tc_cls_osi_filter_plain_wire(it, &osi->filter);
+  size_t sz = TC_CLS_OSI_FILTER_WIRE_LEN;
   return sz;
 /*
 tc_cls_osi_filter_t 
@@ -1507,7 +1483,7 @@ size_t enc_tc_mod_ctrl_payload_cls_sto(uint8_t* it, tc_mod_cls_sto_t const* sto)
   assert(it != NULL);
   assert(sto != NULL);
 
-  memcpy(it, &sto->dummy, sizeof(sto->dummy));
+  put_plain_wire(it, sto->dummy);
   // it += sizeof(rr->dummy);
   size_t sz = sizeof(sto->dummy);
   return sz;
@@ -1519,7 +1495,7 @@ size_t enc_tc_mod_ctrl_payload_cls(uint8_t* it, tc_mod_ctrl_cls_t const* mod)
   assert(it != NULL);
   assert(mod != NULL);
 
-  memcpy(it, &mod->type, sizeof(mod->type ) );
+  put_plain_wire(it, mod->type);
   it += sizeof(mod->type);  
   size_t sz = sizeof(mod->type); 
 
@@ -1542,7 +1518,7 @@ size_t enc_tc_del_ctrl_payload_cls_rr(uint8_t* it, tc_del_cls_rr_t const* rr)
   assert(it != NULL);
   assert(rr != NULL);
 
-  memcpy(it, &rr->dummy, sizeof(rr->dummy));
+  put_plain_wire(it, rr->dummy);
   // it += sizeof(rr->dummy );
   size_t sz = sizeof(rr->dummy);
   return sz;
@@ -1554,7 +1530,7 @@ size_t enc_tc_del_ctrl_payload_cls_osi(uint8_t* it, tc_del_cls_osi_t const* osi)
   assert(it != NULL);
   assert(osi != NULL);
 
-  memcpy(it, &osi->filter_id, sizeof(osi->filter_id) );
+  put_plain_wire(it, osi->filter_id);
   // it += sizeof(osi->filter_id); 
   size_t sz = sizeof(osi->filter_id); 
 
@@ -1567,7 +1543,7 @@ size_t enc_tc_del_ctrl_payload_cls_sto(uint8_t* it, tc_del_cls_sto_t const* sto)
   assert(it != NULL);
   assert(sto != NULL);
 
-  memcpy(it, &sto->dummy, sizeof(sto->dummy));
+  put_plain_wire(it, sto->dummy);
   // it += sizeof(sto->dummy);
   size_t sz = sizeof(sto->dummy);
   return sz;
@@ -1579,7 +1555,7 @@ size_t enc_tc_del_ctrl_payload_cls(uint8_t* it, tc_del_ctrl_cls_t const* del )
   assert(it != NULL);
   assert(del != NULL);
 
-  memcpy(it, &del->type, sizeof(del->type));
+  put_plain_wire(it, del->type);
   it += sizeof(del->type);
   size_t sz = sizeof(del->type);
 
@@ -1602,7 +1578,7 @@ size_t enc_tc_ctrl_payload_cls(void* it, tc_ctrl_cls_t const* cls)
   assert(it != NULL);
   assert(cls != NULL);
 
-  memcpy(it, &cls->act, sizeof(cls->act));
+  put_plain_wire(it, cls->act);
   it += sizeof(cls->act);
   size_t sz = sizeof(cls->act);
 
@@ -1648,7 +1624,7 @@ size_t enc_tc_add_ctrl_payload_plc(uint8_t* it, tc_add_ctrl_plc_t const* add)
   assert(it != NULL);
   assert(add != NULL);
 
-  memcpy(it, &add->dummy, sizeof(add->dummy));
+  put_plain_wire(it, add->dummy);
 // it +=  sizeof(add->dummy) 
   size_t sz = sizeof(add->dummy);
   return sz; 
@@ -1660,23 +1636,23 @@ size_t enc_tc_mod_ctrl_payload_plc(uint8_t* it, tc_mod_ctrl_plc_t const* mod)
   assert(it != NULL);
   assert(mod != NULL);
 
-  memcpy(it, &mod->id, sizeof(mod->id) );
+  put_plain_wire(it, mod->id);
   it += sizeof(mod->id);
   size_t sz = sizeof(mod->id);
 
-  memcpy(it, &mod->drop_rate_kbps, sizeof(mod->drop_rate_kbps) );
+  put_plain_wire(it, mod->drop_rate_kbps);
   it += sizeof(mod->drop_rate_kbps);
   sz += sizeof(mod->drop_rate_kbps);
 
-  memcpy(it, &mod->dev_id, sizeof(mod->dev_id) );
+  put_plain_wire(it, mod->dev_id);
   it += sizeof(mod->dev_id);
   sz += sizeof(mod->dev_id);
 
-  memcpy(it, &mod-> dev_rate_kbps, sizeof(mod-> dev_rate_kbps) );
+  put_plain_wire(it, mod->dev_rate_kbps);
   it += sizeof(mod-> dev_rate_kbps);
   sz += sizeof(mod-> dev_rate_kbps);
 
-  memcpy(it, &mod-> active, sizeof(mod-> active) );
+  put_plain_wire(it, mod->active);
   it += sizeof(mod-> active);
   sz += sizeof(mod-> active);
 
@@ -1689,7 +1665,7 @@ size_t enc_tc_del_ctrl_payload_plc(uint8_t* it, tc_del_ctrl_plc_t const* del)
   assert(it != NULL);
   assert(del != NULL);
 
-  memcpy(it, &del->id, sizeof(del->id ));
+  put_plain_wire(it, del->id);
 // it +=  sizeof(add->dummy) 
   size_t sz = sizeof(del->id);
   return sz; 
@@ -1701,7 +1677,7 @@ size_t enc_tc_ctrl_payload_plc(uint8_t* it, tc_ctrl_plc_t const* plc)
   assert(it != NULL);
   assert(plc != NULL);
 
-  memcpy(it, &plc->act, sizeof(plc->act));
+  put_plain_wire(it, plc->act);
   it += sizeof(plc->act);
   size_t sz = sizeof(plc->act);
 
@@ -1749,7 +1725,7 @@ size_t enc_tc_ctrl_payload_q_fifo(uint8_t* it, tc_ctrl_queue_fifo_t const* fifo)
   assert(it != NULL);
   assert(fifo != NULL);
 
-  memcpy(it, &fifo->dummy, sizeof(fifo->dummy));
+  put_plain_wire(it, fifo->dummy);
   // it += sizeof(fifo->dummy);
   return sizeof(fifo->dummy);
 
@@ -1761,11 +1737,11 @@ size_t enc_tc_ctrl_payload_q_codel(uint8_t* it, tc_ctrl_queue_codel_t const* cod
   assert(it != NULL);
   assert(codel != NULL);
 
-  memcpy(it, &codel->target_ms, sizeof(codel->target_ms));
+  put_plain_wire(it, codel->target_ms);
   it += sizeof(codel->target_ms);
   size_t sz = sizeof(codel->target_ms);
 
-  memcpy(it, &codel->interval_ms, sizeof(codel->interval_ms));
+  put_plain_wire(it, codel->interval_ms);
 //  it += sizeof(codel->interval_ms);
   sz += sizeof(codel->interval_ms);
 
@@ -1778,11 +1754,11 @@ size_t enc_tc_ctrl_payload_q_ecn_codel(uint8_t* it, tc_ctrl_queue_ecn_codel_t co
   assert(it != NULL);
   assert(ecn != NULL);
 
-  memcpy(it, &ecn->target_ms, sizeof(ecn->target_ms));
+  put_plain_wire(it, ecn->target_ms);
   it += sizeof(ecn->target_ms);
   size_t sz = sizeof(ecn->target_ms);
 
-  memcpy(it, &ecn->interval_ms, sizeof(ecn->interval_ms));
+  put_plain_wire(it, ecn->interval_ms);
 //  it += sizeof(codel->interval_ms);
   sz += sizeof(ecn->interval_ms);
 
@@ -1795,7 +1771,7 @@ size_t enc_tc_add_ctrl_payload_q(uint8_t* it, tc_add_ctrl_queue_t const* add)
   assert(it != NULL);
   assert(add != NULL);
 
-  memcpy(it, &add->type, sizeof(add->type)); 
+  put_plain_wire(it, add->type); 
   it += sizeof(add->type);
   size_t sz = sizeof(add->type); 
 
@@ -1817,12 +1793,12 @@ size_t enc_tc_mod_ctrl_payload_q(uint8_t* it, tc_mod_ctrl_queue_t const* mod)
 {
   assert(mod != NULL);
 
-  memcpy(it, &mod->id, sizeof(mod->id) );
+  put_plain_wire(it, mod->id);
   it += sizeof(mod->id);
   size_t sz = sizeof(mod->id);
 
 
-  memcpy(it, &mod->type, sizeof(mod->type) );
+  put_plain_wire(it, mod->type);
   it += sizeof(mod->type);
   sz += sizeof(mod->type);
 
@@ -1844,11 +1820,11 @@ size_t enc_tc_del_ctrl_payload_q(uint8_t* it, tc_del_ctrl_queue_t const* del)
 {
   assert(del != NULL);
 
-  memcpy(it, &del->id, sizeof(del->id) );
+  put_plain_wire(it, del->id);
   it += sizeof(del->id);
   size_t sz = sizeof(del->id);
 
-  memcpy(it, &del->type, sizeof(del->type) );
+  put_plain_wire(it, del->type);
   it += sizeof(del->type);
   sz += sizeof(del->type);
 
@@ -1862,7 +1838,7 @@ size_t enc_tc_ctrl_payload_q(uint8_t* it, tc_ctrl_queue_t const* q)
   assert(it != NULL);
   assert(q != NULL);
 
-  memcpy(it, &q->act, sizeof(q->act));
+  put_plain_wire(it, q->act);
   it += sizeof(q->act);
   size_t sz = sizeof(q->act);
 
@@ -1904,7 +1880,7 @@ size_t enc_tc_add_ctrl_payload_sch(uint8_t* it, tc_add_ctrl_sch_t const* add)
   assert(it != NULL);
   assert(add != NULL); 
 
-  memcpy(it, &add->dummy, sizeof(add->dummy) );
+  put_plain_wire(it, add->dummy);
 // it +=  sizeof(add->dummy);
   size_t sz = sizeof(add->dummy);
   return sz; 
@@ -1916,7 +1892,7 @@ size_t enc_tc_mod_ctrl_payload_sch_rr(uint8_t* it, tc_sch_rr_t const* rr)
   assert(it != NULL);
   assert(rr != NULL);
 
-  memcpy(it, &rr->dummy, sizeof(rr->dummy) );
+  put_plain_wire(it, rr->dummy);
   // it += sizeof(rr->dummy);
   size_t sz = sizeof(rr->dummy);
   return sz;
@@ -1928,12 +1904,12 @@ size_t enc_tc_mod_ctrl_payload_sch_prio(uint8_t* it, tc_sch_prio_t const* prio)
   assert(it != NULL);
   assert(prio != NULL);
 
-  memcpy(it, &prio->len_q_prio, sizeof(prio->len_q_prio) );
+  put_plain_wire(it, prio->len_q_prio);
   it += sizeof(prio->len_q_prio);
   size_t sz = sizeof(prio->len_q_prio);
 
   for(size_t i = 0; i < prio->len_q_prio; ++i){
-    memcpy(it, &prio->q_prio[i], sizeof(prio->q_prio[0]) );
+    put_plain_wire(it, prio->q_prio[i]);
     it += sizeof(prio->q_prio[0]);
     sz += sizeof(prio->q_prio[0]);
   }
@@ -1947,7 +1923,7 @@ size_t enc_tc_mod_ctrl_payload_sch(uint8_t* it, tc_mod_ctrl_sch_t const* mod)
   assert(it != NULL);
   assert(mod != NULL); 
 
-  memcpy(it, &mod->type, sizeof(mod->type) );
+  put_plain_wire(it, mod->type);
   it += sizeof(mod->type );
   size_t sz = sizeof(mod->type );
 
@@ -1968,7 +1944,7 @@ size_t enc_tc_del_ctrl_payload_sch(uint8_t* it, tc_del_ctrl_sch_t const* del)
   assert(it != NULL);
   assert(del != NULL); 
 
-  memcpy(it, &del->dummy, sizeof(del->dummy ) );
+  put_plain_wire(it, del->dummy);
   // it += sizeof(del->dummy );
   size_t sz = sizeof(del->dummy);
   return sz;
@@ -1983,7 +1959,7 @@ size_t enc_tc_ctrl_payload_sch(uint8_t* it, tc_ctrl_sch_t const* sch)
   assert(it != NULL);
   assert(sch != NULL);
 
-  memcpy(it, &sch->act, sizeof(sch->act) );
+  put_plain_wire(it, sch->act);
   it += sizeof(sch->act);
   size_t sz = sizeof(sch->act);
 
@@ -2031,7 +2007,7 @@ size_t enc_tc_add_ctrl_payload_shp(uint8_t* it, tc_add_ctrl_shp_t const* add)
   assert(it != NULL);
   assert(add != NULL);
 
-  memcpy(it, &add->dummy, sizeof(add->dummy) );
+  put_plain_wire(it, add->dummy);
   // it += sizeof(add->dummy)
   size_t sz = sizeof(add->dummy);
   return sz;
@@ -2043,19 +2019,19 @@ size_t enc_tc_mod_ctrl_payload_shp(uint8_t* it, tc_mod_ctrl_shp_t const* mod)
   assert(it != NULL);
   assert(mod != NULL);
 
-  memcpy(it, &mod->id, sizeof( mod->id) );
+  put_plain_wire(it, mod->id);
   it += sizeof(mod->id);
   size_t sz = sizeof(mod->id);
 
-  memcpy(it, &mod-> time_window_ms, sizeof( mod-> time_window_ms) );
+  put_plain_wire(it, mod->time_window_ms);
   it += sizeof(mod-> time_window_ms);
   sz += sizeof(mod-> time_window_ms);
 
-  memcpy(it, &mod-> max_rate_kbps, sizeof( mod-> max_rate_kbps) );
+  put_plain_wire(it, mod->max_rate_kbps);
   it += sizeof(mod-> max_rate_kbps);
   sz += sizeof(mod-> max_rate_kbps);
 
-  memcpy(it, &mod-> active, sizeof( mod-> active) );
+  put_plain_wire(it, mod->active);
   it += sizeof(mod-> active);
   sz += sizeof(mod-> active);
 
@@ -2068,7 +2044,7 @@ size_t enc_tc_del_ctrl_payload_shp(uint8_t* it, tc_del_ctrl_shp_t const* del)
   assert(it != NULL);
   assert(del != NULL);
 
-  memcpy(it, &del->id, sizeof(del->id));
+  put_plain_wire(it, del->id);
   // it += sizeof(del->id ) 
   size_t sz = sizeof(del->id);
   return sz;
@@ -2080,7 +2056,7 @@ size_t enc_tc_ctrl_payload_shp(void* it, tc_ctrl_shp_t const* shp)
   assert(it != NULL);
   assert(shp != NULL);
 
-  memcpy(it, &shp->act, sizeof(shp->act) );
+  put_plain_wire(it, shp->act);
   it += sizeof(shp->act); 
   size_t sz = sizeof(shp->act); 
 
@@ -2124,7 +2100,7 @@ size_t enc_tc_add_ctrl_payload_pcr(uint8_t* it, tc_add_ctrl_pcr_t const* add)
   assert(it != NULL);
   assert(add != NULL);
 
-  memcpy(it, &add->dummy, sizeof(add->dummy));
+  put_plain_wire(it, add->dummy);
   // it += sizeof(add->dummy )
   size_t sz = sizeof(add->dummy);
   return sz;
@@ -2136,7 +2112,7 @@ size_t enc_tc_mod_ctrl_payload_pcr_dummy(uint8_t* it, tc_pcr_dummy_t const* dumm
   assert(it != NULL);
   assert(dummy != NULL);
 
-  memcpy(it, &dummy->dummy, sizeof(dummy->dummy));
+  put_plain_wire(it, dummy->dummy);
   // it += 
   size_t sz = sizeof(dummy->dummy);
   return sz;
@@ -2148,11 +2124,11 @@ size_t enc_tc_mod_ctrl_payload_pcr_bdp(uint8_t* it, tc_pcr_5g_bdp_t const* bdp)
   assert(it != NULL);
   assert(bdp != NULL);
 
-  memcpy(it, &bdp->drb_sz, sizeof(bdp->drb_sz));
+  put_plain_wire(it, bdp->drb_sz);
   it += sizeof(bdp->drb_sz);
   size_t sz = sizeof(bdp->drb_sz);
 
-  memcpy(it, &bdp->tstamp, sizeof(bdp->tstamp));
+  put_plain_wire(it, bdp->tstamp);
   it += sizeof(bdp->tstamp);
   sz += sizeof(bdp->tstamp);
 
@@ -2165,7 +2141,7 @@ size_t enc_tc_mod_ctrl_payload_pcr(uint8_t* it, tc_mod_ctrl_pcr_t const* mod)
   assert(it != NULL);
   assert(mod != NULL);
 
-  memcpy(it, &mod->type, sizeof(mod->type));
+  put_plain_wire(it, mod->type);
   it += sizeof(mod->type );
   size_t sz =  sizeof(mod->type);
 
@@ -2186,7 +2162,7 @@ size_t enc_tc_del_ctrl_payload_pcr(uint8_t* it, tc_del_ctrl_pcr_t const* del)
   assert(it != NULL);
   assert(del != NULL);
 
-  memcpy(it, &del->dummy, sizeof(del->dummy) );
+  put_plain_wire(it, del->dummy);
   // it += 
   size_t sz = sizeof(del->dummy);
   return sz;
@@ -2198,7 +2174,7 @@ size_t enc_tc_ctrl_payload_pcr(void* it, tc_ctrl_pcr_t const* pcr)
   assert(it != NULL);
   assert(pcr != NULL);
 
-  memcpy(it, &pcr->act, sizeof(pcr->act));
+  put_plain_wire(it, pcr->act);
   it += sizeof(pcr->act);
   size_t sz = sizeof(pcr->act);
 
@@ -2247,12 +2223,12 @@ byte_array_t tc_enc_ctrl_msg_plain(tc_ctrl_msg_t const* ctrl_msg)
   byte_array_t ba = {0};
 
   size_t const sz = cal_tc_ctrl_payload(ctrl_msg);
-  ba.len = sz;
-  ba.buf = malloc(sz);
+  ba.len = PLAIN_WIRE_TREE_MSG_HDR_LEN + sz;
+  ba.buf = malloc(ba.len);
   assert(ba.buf != NULL && "Memory exhausted");
 
-  void* it = ba.buf;
-  memcpy(it, &ctrl_msg->type, sizeof(ctrl_msg->type) );
+  void* it = put_u8_plain_wire(ba.buf, PLAIN_WIRE_VERSION);
+  put_plain_wire(it, ctrl_msg->type);
   it += sizeof(ctrl_msg->type); 
 
   if(ctrl_msg->type == TC_CTRL_SM_V0_CLS ){
@@ -2279,16 +2255,7 @@ byte_array_t tc_enc_ctrl_msg_plain(tc_ctrl_msg_t const* ctrl_msg)
 byte_array_t tc_enc_ctrl_out_plain(tc_ctrl_out_t const* ctrl) 
 {
   assert(ctrl != NULL );
-  byte_array_t ba = {0};
-
-  ba.len = sizeof(tc_ctrl_out_t);
-
-  ba.buf = calloc(ba.len, sizeof(uint8_t));
-  assert(ba.buf != NULL && "Memory exhausted" );
-
-  memcpy(ba.buf, ctrl, ba.len);
-
-  return ba;
+  return enc_tc_ctrl_out_plain_wire(ctrl);
 }
 
 byte_array_t tc_enc_func_def_plain(tc_func_def_t const* func)
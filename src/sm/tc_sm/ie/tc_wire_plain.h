@@ -0,0 +1,76 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+#ifndef TC_WIRE_PLAIN_H
+#define TC_WIRE_PLAIN_H
+
+// Layout of the TC SM plain encoding, see util/plain_wire.h. The indication
+// and control messages are trees, written by tc_enc_plain.c
+
+#include "tc_data_ie.h"
+#include "../../../util/plain_wire.h"
+
+#define TC_EVENT_TRIGGER_WIRE(F, A, T) F(T, ms)
+
+#define TC_IND_HDR_WIRE(F, A, T) F(T, dummy)
+
+#define TC_CTRL_HDR_WIRE(F, A, T) F(T, dummy)
+
+#define TC_CTRL_OUT_WIRE(F, A, T) F(T, out)
+
+PLAIN_WIRE_REC_MSG(tc_event_trigger, tc_event_trigger_t, TC_EVENT_TRIGGER_WIRE)
+PLAIN_WIRE_REC_MSG(tc_ind_hdr, tc_ind_hdr_t, TC_IND_HDR_WIRE)
+PLAIN_WIRE_REC_MSG(tc_ctrl_hdr, tc_ctrl_hdr_t, TC_CTRL_HDR_WIRE)
+PLAIN_WIRE_REC_MSG(tc_ctrl_out, tc_ctrl_out_t, TC_CTRL_OUT_WIRE)
+
+// The OSI filter nests the L3, L4 and L7 filters, i.e., no FIELDS list.
+// id, l3 (src_addr, dst_addr), l4 (src_port, dst_port, protocol), l7 (dummy),
+// dst_queue
+#define TC_CLS_OSI_FILTER_WIRE_LEN (sizeof(uint32_t) + 2*sizeof(int64_t) + 3*sizeof(int32_t) + sizeof(uint32_t) + sizeof(int32_t))
+
+static inline
+uint8_t* enc_tc_cls_osi_filter_plain_wire(uint8_t* it, tc_cls_osi_filter_t const* src)
+{
+  it = put_plain_wire(it, src->id);
+  it = put_plain_wire(it, src->l3.src_addr);
+  it = put_plain_wire(it, src->l3.dst_addr);
+  it = put_plain_wire(it, src->l4.src_port);
+  it = put_plain_wire(it, src->l4.dst_port);
+  it = put_plain_wire(it, src->l4.protocol);
+  it = put_plain_wire(it, src->l7.dummy);
+  it = put_plain_wire(it, src->dst_queue);
+  return it;
+}
+
+static inline
+void dec_tc_cls_osi_filter_plain_wire(byte_reader_t* rd, tc_cls_osi_filter_t* dst)
+{
+  get_byte_reader(rd, &dst->id);
+  get_byte_reader(rd, &dst->l3.src_addr);
+  get_byte_reader(rd, &dst->l3.dst_addr);
+  get_byte_reader(rd, &dst->l4.src_port);
+  get_byte_reader(rd, &dst->l4.dst_port);
+  get_byte_reader(rd, &dst->l4.protocol);
+  get_byte_reader(rd, &dst->l7.dummy);
+  get_byte_reader(rd, &dst->dst_queue);
+}
+
+#endif
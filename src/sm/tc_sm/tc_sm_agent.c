@@ -1,4 +1,5 @@
 #include "tc_sm_agent.h"
+#include "../sm_enc.h"
 #include "tc_sm_id.h"
 #include "enc/tc_enc_generic.h"
 #include "dec/tc_dec_generic.h"
@@ -126,14 +127,7 @@ sm_e2_setup_data_t on_e2_setup_tc_sm_ag(sm_agent_t const* sm_agent)
 
   // ToDo: RAN Function should be filled from the RAN
 
-  size_t const sz = strnlen(SM_TC_STR, 256);
-  assert(sz < 256 && "Buffer overeflow?");
-
-  setup.len_rfd = sz;
-  setup.ran_fun_def = calloc(1, sz);
-  assert(setup.ran_fun_def != NULL);
-
-  memcpy(setup.ran_fun_def, SM_TC_STR , sz);
+  setup = tag_ran_func_def_sm_enc(SM_TC_STR, SM_ENC_COMPILED);
  
  // RAN Function
 //  setup.rf.def = cp_str_to_ba(SM_TC_SHORT_NAME);
@@ -235,6 +235,8 @@ sm_ric_t* make_tc_sm_ric(void /* sm_io_ric_t io */)
   assert(strlen(SM_TC_STR) < sizeof( sm->base.ran_func_name) );
   memcpy(sm->base.ran_func_name, SM_TC_STR, strlen(SM_TC_STR)); 
 
+  sm->base.enc = SM_ENC_COMPILED;
+
   return &sm->base;
 }
 
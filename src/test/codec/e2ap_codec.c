@@ -0,0 +1,105 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+// Compiled with the other E2AP version, see CMakeLists.txt
+
+#include "e2ap_codec.h"
+#include "../../lib/e2ap/e2ap_ap_wrapper.h"
+#include "../../lib/e2ap/e2ap_msg_dec_generic_wrapper.h"
+
+#include <assert.h>
+#include <pthread.h>
+#include <string.h>
+
+static_assert(RIC_SUBSCRIPTION_REQUEST == 0 && E2_REMOVAL_FAILURE == E2AP_CODEC_NUM_MSG - 1, "IR shared with the other E2AP versions");
+
+static
+e2ap_ap_t ap;
+
+static
+pthread_once_t once = PTHREAD_ONCE_INIT;
+
+static
+void init_codec(void)
+{
+  init_ap(&ap.type);
+}
+
+static
+bool dec_msg_codec(byte_array_t ba, int* type, void* u_msgs, size_t len)
+{
+  assert(type != NULL);
+  assert(u_msgs != NULL);
+
+  e2ap_msg_t msg = e2ap_msg_dec_gen(&ap.type, ba);
+  if(msg.type == NONE_E2_MSG_TYPE)
+    return false;
+
+  // E.g., an E42 message, which the E2 Nodes never send
+  if(msg.type >= E2AP_CODEC_NUM_MSG){
+    ap.type.free_msg[msg.type](&msg);
+    return false;
+  }
+
+  *type = msg.type;
+  memset(u_msgs, 0, len);
+  memcpy(u_msgs, &msg.u_msgs, len < sizeof(msg.u_msgs) ? len : sizeof(msg.u_msgs));
+  return true;
+}
+
+static
+e2ap_msg_t to_msg(int type, void const* u_msgs, size_t len)
+{
+  assert(type > -1 && type < E2AP_CODEC_NUM_MSG);
+  assert(u_msgs != NULL);
+
+  e2ap_msg_t msg = {.type = type};
+  memcpy(&msg.u_msgs, u_msgs, len < sizeof(msg.u_msgs) ? len : sizeof(msg.u_msgs));
+  return msg;
+}
+
+static
+byte_array_t enc_msg_codec(int type, void const* u_msgs, size_t len)
+{
+  e2ap_msg_t const msg = to_msg(type, u_msgs, len);
+  return ap.type.enc_msg[type](&msg);
+}
+
+static
+void free_msg_codec(int type, void* u_msgs, size_t len)
+{
+  e2ap_msg_t msg = to_msg(type, u_msgs, len);
+  ap.type.free_msg[type](&msg);
+}
+
+__attribute__((visibility("default")))
+e2ap_codec_t const* e2ap_codec(void)
+{
+  static e2ap_codec_t const codec = {.version = E2AP_COMPILED_VERSION,
+                                     .dec_msg = dec_msg_codec,
+                                     .enc_msg = enc_msg_codec,
+                                     .free_msg = free_msg_codec};
+
+  int const rc = pthread_once(&once, init_codec);
+  assert(rc == 0);
+  (void)rc;
+  return &codec;
+}
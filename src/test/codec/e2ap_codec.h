@@ -0,0 +1,60 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+#ifndef E2AP_CODEC_MIR_H
+#define E2AP_CODEC_MIR_H 
+
+// Codec of the E2AP version the test was not compiled with, e.g., v3.01 
+// for E2AP_V2, built as a shared object. Its symbols are hidden, as they 
+// are also defined by the codec of the test, so it is loaded through 
+// dlopen() and E2AP_CODEC_SYM. It emulates E2 Nodes of the other version.
+// The FlexRIC IR of the E2AP procedures, i.e., e2_msg_type_t 0 to 
+// E2AP_CODEC_NUM_MSG - 1, is shared between v2.03 and v3.01. v1.01 differs
+// and has no codec. The messages are passed as the union u_msgs of 
+// e2ap_msg_t, as its size differs between the versions
+
+#include "../../lib/e2ap/e2ap_version.h"
+#include "../../util/byte_array.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// RIC Subscription Request to E2 Removal Failure
+#define E2AP_CODEC_NUM_MSG 29
+
+#define E2AP_CODEC_SYM "e2ap_codec"
+
+typedef struct{
+  e2ap_version_e version;
+
+  // False if ba is not a PDU of the version. Else, the union u_msgs of a 
+  // e2ap_msg_t of len bytes is written, to be freed with free_msg
+  bool (*dec_msg)(byte_array_t ba, int* type, void* u_msgs, size_t len);
+
+  byte_array_t (*enc_msg)(int type, void const* u_msgs, size_t len);
+
+  void (*free_msg)(int type, void* u_msgs, size_t len);
+} e2ap_codec_t;
+
+// Entry point of the shared object, i.e., E2AP_CODEC_SYM
+typedef e2ap_codec_t const* (*e2ap_codec_fp)(void);
+
+#endif
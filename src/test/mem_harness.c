@@ -0,0 +1,578 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+#include "mem_harness.h"
+
+#include "../agent/e2_agent.h"
+#include "../agent/sim_clock_agent.h"
+#include "../lib/ep/mem_ep.h"
+#include "../ric/near_ric.h"
+#include "../sm/mac_sm/ie/mac_data_ie.h"
+#include "../util/alg_ds/ds/seq_container/seq_generic.h"
+#include "../util/backoff.h"
+
+#include <assert.h>
+#include <dirent.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define E2AP_PORT_MEM_HARNESS 36421
+
+#define HA_ADDR_MEM_HARNESS "127.0.0.1"
+#define HA_PORT_MEM_HARNESS 36430
+#define HA_PEER_MEM_HARNESS "127.0.0.1:36430"
+#define HA_SECRET_MEM_HARNESS "mem_harness"
+
+typedef struct{
+  e2_agent_t* ag;
+  pthread_t t;
+  global_e2_node_id_t id;
+} harness_ag_t;
+
+typedef struct{
+  e42_xapp_t* xapp;
+  pthread_t t;
+} harness_xapp_t;
+
+struct mem_harness_s{
+  char dir[64];
+  fr_args_t args;
+
+  size_t num_ric;
+  char ric_addr[MAX_RIC_MEM_HARNESS][16];
+
+  near_ric_t* ric;
+  pthread_t t_ric;
+
+  // Until failover_mem_harness()
+  fr_args_t standby_args;
+  near_ric_t* _Atomic standby;
+  pthread_t t_standby;
+  bool failover;
+
+  sim_clock_t clk;
+
+  size_t num_ag;
+  harness_ag_t* ag;
+  char ag_libs_dir[FR_CONF_FILE_LEN];
+
+  size_t num_xapp;
+  harness_xapp_t* xapp;
+};
+
+static
+_Atomic uint64_t ind_read;
+
+static
+_Atomic uint64_t ctrl_written;
+
+/////////////////
+// RAN functions
+/////////////////
+
+static
+bool read_ind_mac(void* data)
+{
+  assert(data != NULL);
+  mac_ind_data_t* mac = (mac_ind_data_t*)data;
+
+  mac->msg.len_ue_stats = 1;
+  mac->msg.ue_stats = calloc(1, sizeof(mac_ue_stats_impl_t));
+  assert(mac->msg.ue_stats != NULL && "Memory exhausted");
+  mac->msg.ue_stats[0].rnti = 0x4601;
+  // The DB of the xApps requires tstamp > 0
+  mac->msg.tstamp = atomic_fetch_add(&ind_read, 1) + 1;
+  return true;
+}
+
+static
+sm_ag_if_ans_t write_ctrl_mac(void const* data)
+{
+  assert(data != NULL);
+  mac_ctrl_req_data_t const* ctrl = (mac_ctrl_req_data_t const*)data;
+  assert(ctrl->hdr.dummy == 1 && ctrl->msg.action == 42);
+
+  atomic_fetch_add(&ctrl_written, 1);
+
+  sm_ag_if_ans_t ans = {.type = CTRL_OUTCOME_SM_AG_IF_ANS_V0};
+  ans.ctrl_out.type = MAC_AGENT_IF_CTRL_ANS_V0;
+  ans.ctrl_out.mac.ans = MAC_CTRL_OUT_OK;
+  return ans;
+}
+
+#if defined(E2AP_V2) || defined(E2AP_V3)
+static
+void read_setup_ran(void* data, const ngran_node_t node_type)
+{
+  assert(data != NULL);
+  assert(node_type == ngran_gNB);
+
+  // One NG interface component, the minimum of the E2 Setup Request
+  arr_node_component_config_add_t* dst = (arr_node_component_config_add_t*)data;
+  dst->len_cca = 1;
+  dst->cca = calloc(1, sizeof(e2ap_node_component_config_add_t));
+  assert(dst->cca != NULL && "Memory exhausted");
+
+  dst->cca[0].e2_node_comp_interface_type = NG_E2AP_NODE_COMP_INTERFACE_TYPE;
+  dst->cca[0].e2_node_comp_id.type = NG_E2AP_NODE_COMP_INTERFACE_TYPE;
+  dst->cca[0].e2_node_comp_id.ng_amf_name = cp_str_to_ba("amf");
+  dst->cca[0].e2_node_comp_conf.request = cp_str_to_ba("ngapRequest");
+  dst->cca[0].e2_node_comp_conf.response = cp_str_to_ba("ngapResponse");
+}
+#endif
+
+static
+sm_io_ag_ran_t init_io_ag(void)
+{
+  sm_io_ag_ran_t io = {0};
+  io.read_ind_tbl[MAC_STATS_V0] = read_ind_mac;
+  io.write_ctrl_tbl[MAC_CTRL_REQ_V0] = write_ctrl_mac;
+#if defined(E2AP_V2) || defined(E2AP_V3)
+  io.read_setup_ran = read_setup_ran;
+#endif
+  return io;
+}
+
+/////////////////
+// Threads 
+/////////////////
+
+static
+void* start_ric(void* arg)
+{
+  start_near_ric(arg);
+  return NULL;
+}
+
+static
+void* start_standby(void* arg)
+{
+  mem_harness_t* h = (mem_harness_t*)arg;
+  // Blocks until the nearRT-RIC of the harness goes down
+  near_ric_t* ric = init_near_ric(&h->standby_args);
+  atomic_store(&h->standby, ric);
+  kick_mem_ep();
+
+  start_near_ric(ric);
+  return NULL;
+}
+
+static
+void* start_ag(void* arg)
+{
+  e2_start_agent(arg);
+  return NULL;
+}
+
+static
+void* start_xapp(void* arg)
+{
+  start_e42_xapp(arg);
+  return NULL;
+}
+
+/////////////////
+// Predicates
+/////////////////
+
+typedef struct{
+  bool (*pred)(void* arg);
+  void* arg;
+} pred_idle_t;
+
+static
+bool pred_idle(void* arg)
+{
+  pred_idle_t const* p = (pred_idle_t const*)arg;
+  return in_flight_mem_ep() == 0 && p->pred(p->arg) == true;
+}
+
+static
+bool pred_num_e2_nodes(void* arg)
+{
+  mem_harness_t* h = (mem_harness_t*)arg;
+  return num_e2_nodes_mem_harness(h) == h->num_ag;
+}
+
+static
+bool pred_xapps_connected(void* arg)
+{
+  mem_harness_t* h = (mem_harness_t*)arg;
+  for(size_t i = 0; i < h->num_xapp; ++i){
+    if(connected_e42_xapp(h->xapp[i].xapp) == false)
+      return false;
+  }
+  return true;
+}
+
+static
+bool pred_standby_on(void* arg)
+{
+  mem_harness_t* h = (mem_harness_t*)arg;
+  return peer_on_repl_ric(&h->ric->repl);
+}
+
+static
+bool pred_standby_up(void* arg)
+{
+  mem_harness_t* h = (mem_harness_t*)arg;
+  return atomic_load(&h->standby) != NULL;
+}
+
+static
+void write_conf_file(mem_harness_t* h, fr_args_t* args, char const* name, char const* role, mem_harness_args_t const* xapp)
+{
+  int n = snprintf(args->conf_file, sizeof(args->conf_file), "%s/%s", h->dir, name);
+  assert(n > 0 && n < (int)sizeof(args->conf_file));
+
+  FILE* fp = fopen(args->conf_file, "w");
+  assert(fp != NULL);
+  // The xApps write their DB next to it
+  n = fprintf(fp, "NEAR_RIC_IP = 127.0.0.1\nDB_DIR = %s/\n", h->dir);
+  assert(n > 0);
+  if(role != NULL){
+    n = fprintf(fp, "HA_ROLE = %s\nHA_PEER = %s\nHA_SECRET = %s\n", role, HA_PEER_MEM_HARNESS, HA_SECRET_MEM_HARNESS);
+    assert(n > 0);
+  }
+  if(xapp != NULL && xapp->xapp_token != NULL){
+    n = fprintf(fp, "XAPP_TOKEN = %s\n", xapp->xapp_token);
+    assert(n > 0);
+  }
+  if(xapp != NULL && xapp->xapp_group != NULL){
+    n = fprintf(fp, "XAPP_GROUP = %s\n", xapp->xapp_group);
+    assert(n > 0);
+  }
+  if(xapp != NULL && xapp->backoff != NULL){
+    n = fprintf(fp, "RECONNECT_BACKOFF = %s\n", xapp->backoff);
+    assert(n > 0);
+  }
+  n = fclose(fp);
+  assert(n == 0);
+}
+
+static
+void init_conf_file(mem_harness_t* h, mem_harness_args_t const* args)
+{
+  strcpy(h->dir, "/tmp/mem_harness_XXXXXX");
+  char* d = mkdtemp(h->dir);
+  assert(d != NULL);
+
+  char const* role = args->standby ? "PRIMARY" : NULL;
+  write_conf_file(h, &h->args, "flexric.conf", role, args);
+
+  if(args->standby){
+    write_conf_file(h, &h->standby_args, "standby.conf", "STANDBY", NULL);
+    strcpy(h->standby_args.libs_dir, args->libs_dir);
+  }
+}
+
+static
+void rm_conf_dir(mem_harness_t* h)
+{
+  DIR* d = opendir(h->dir);
+  assert(d != NULL);
+
+  struct dirent* it = NULL;
+  while((it = readdir(d)) != NULL){
+    if(strcmp(it->d_name, ".") == 0 || strcmp(it->d_name, "..") == 0)
+      continue;
+    int const rc = unlinkat(dirfd(d), it->d_name, 0);
+    assert(rc == 0);
+  }
+  closedir(d);
+
+  int const rc = rmdir(h->dir);
+  assert(rc == 0);
+}
+
+mem_harness_t* init_mem_harness(mem_harness_args_t const* args)
+{
+  assert(args != NULL);
+  assert(args->num_ag > 0 && args->num_ag < 256);
+  assert(args->libs_dir != NULL && strlen(args->libs_dir) < FR_CONF_FILE_LEN);
+  assert(args->ag_libs_dir == NULL || strlen(args->ag_libs_dir) < FR_CONF_FILE_LEN);
+  assert(args->num_extra_ric < MAX_RIC_MEM_HARNESS);
+  assert((args->xapp_token == NULL || args->num_xapp < 2) && "One xApp per token");
+
+  mem_harness_t* h = calloc(1, sizeof(mem_harness_t));
+  assert(h != NULL && "Memory exhausted");
+
+  init_conf_file(h, args);
+  strcpy(h->args.libs_dir, args->libs_dir);
+  strcpy(h->ag_libs_dir, args->ag_libs_dir != NULL ? args->ag_libs_dir : args->libs_dir);
+
+  // Before any endpoint
+  init_mem_ep();
+
+  h->ric = init_near_ric(&h->args);
+  int rc = pthread_create(&h->t_ric, NULL, start_ric, h->ric);
+  assert(rc == 0);
+
+  if(args->standby){
+    rc = pthread_create(&h->t_standby, NULL, start_standby, h);
+    assert(rc == 0);
+  }
+
+  init_sim_clock(&h->clk, 0);
+
+  ric_addr_ag_t addr[MAX_RIC_MEM_HARNESS] = {0};
+  h->num_ric = 1 + args->num_extra_ric;
+  for(size_t i = 0; i < h->num_ric; ++i){
+    int const n = snprintf(h->ric_addr[i], sizeof(h->ric_addr[i]), "127.0.0.%zu", i + 1);
+    assert(n > 0 && n < (int)sizeof(h->ric_addr[i]));
+    addr[i] = (ric_addr_ag_t){.addr = h->ric_addr[i], .port = E2AP_PORT_MEM_HARNESS};
+  }
+
+  h->num_ag = args->num_ag;
+  h->ag = calloc(h->num_ag, sizeof(harness_ag_t));
+  assert(h->ag != NULL && "Memory exhausted");
+
+  backoff_t b = {0};
+  init_conf_backoff(&b, args->backoff);
+
+  sm_io_ag_ran_t const io = init_io_ag();
+  for(size_t i = 0; i < h->num_ag; ++i){
+    global_e2_node_id_t const id = {.type = ngran_gNB,
+                                    .plmn = {.mcc = 505, .mnc = 1, .mnc_digit_len = 2},
+                                    .nb_id.nb_id = i + 1};
+    h->ag[i].id = id;
+    // Takes ownership of its copy
+    h->ag[i].ag = e2_init_multi_ric_agent(h->num_ric, addr, cp_global_e2_node_id(&id), io, h->ag_libs_dir);
+    // Before the agent thread arms any timer
+    h->ag[i].ag->io.clk = &h->clk;
+    backoff_e2_agent(h->ag[i].ag, b.base_ms, b.max_ms);
+    conn_state_cb_e2_agent(h->ag[i].ag, args->conn_cb, args->conn_data);
+
+    rc = pthread_create(&h->ag[i].t, NULL, start_ag, h->ag[i].ag);
+    assert(rc == 0);
+  }
+
+  bool ok = wait_mem_harness(pred_num_e2_nodes, h);
+  assert(ok == true && "E2 Setup timed out");
+
+  if(args->ag_setup_cb != NULL)
+    args->ag_setup_cb(args->ag_setup_data);
+
+  // After the E2 Nodes, as the xApps learn them with the E42 Setup
+  h->num_xapp = args->num_xapp;
+  h->xapp = calloc(h->num_xapp, sizeof(harness_xapp_t));
+  assert(h->num_xapp == 0 || h->xapp != NULL);
+
+  for(size_t i = 0; i < h->num_xapp; ++i){
+    h->xapp[i].xapp = init_e42_xapp(&h->args);
+    conn_state_cb_e42_xapp(h->xapp[i].xapp, args->conn_cb, args->conn_data);
+    rc = pthread_create(&h->xapp[i].t, NULL, start_xapp, h->xapp[i].xapp);
+    assert(rc == 0);
+  }
+
+  ok = wait_mem_harness(pred_xapps_connected, h);
+  assert(ok == true && "E42 Setup timed out");
+
+  if(args->standby){
+    ok = wait_mem_harness(pred_standby_on, h);
+    assert(ok == true && "Standby nearRT-RIC not attached");
+  }
+
+  return h;
+}
+
+void free_mem_harness(mem_harness_t* h)
+{
+  assert(h != NULL);
+  // Otherwise, the standby blocks forever
+  assert((h->standby_args.conf_file[0] == '\0' || h->failover == true) && "Standby without failover");
+
+  for(size_t i = 0; i < h->num_xapp; ++i){
+    free_e42_xapp(h->xapp[i].xapp);
+    int const rc = pthread_join(h->xapp[i].t, NULL);
+    assert(rc == 0);
+  }
+  free(h->xapp);
+
+  // All at once, as each one notices it within the epoll timeout
+  for(size_t i = 0; i < h->num_ag; ++i){
+    if(h->ag[i].ag != NULL)
+      h->ag[i].ag->stop_token = true;
+  }
+  for(size_t i = 0; i < h->num_ag; ++i){
+    if(h->ag[i].ag != NULL)
+      stop_ag_mem_harness(h, i);
+  }
+  free(h->ag);
+
+  free_near_ric(h->ric);
+  int const rc = pthread_join(h->t_ric, NULL);
+  assert(rc == 0);
+
+  free_sim_clock(&h->clk);
+
+  free_mem_ep();
+
+  rm_conf_dir(h);
+  free(h);
+}
+
+e42_xapp_t* xapp_mem_harness(mem_harness_t* h, size_t idx)
+{
+  assert(h != NULL);
+  assert(idx < h->num_xapp);
+  return h->xapp[idx].xapp;
+}
+
+global_e2_node_id_t ag_id_mem_harness(mem_harness_t const* h, size_t idx)
+{
+  assert(h != NULL);
+  assert(idx < h->num_ag);
+  return h->ag[idx].id;
+}
+
+static
+bool pred_true(void* arg)
+{
+  (void)arg;
+  return true;
+}
+
+bool hello_repl_mem_harness(mem_harness_t* h, char const* secret)
+{
+  assert(h != NULL);
+  assert(secret != NULL);
+  assert(h->standby_args.conf_file[0] != '\0' && "No replication without standby");
+
+  e2ap_ep_t ep = {0};
+  e2ap_ep_init(&ep);
+  *(int*)(&ep.fd) = e2ap_ep_connect_mem(&ep, HA_ADDR_MEM_HARNESS, HA_PORT_MEM_HARNESS);
+
+  byte_array_t const ba = {.len = strlen(secret), .buf = (uint8_t*)secret};
+  sctp_msg_t msg = {.ba = enc_repl_rec(&(repl_rec_t){.type = HELLO_REPL_REC, .ba = ba})};
+  e2ap_send_sctp_msg(&ep, &msg);
+  free_byte_array(msg.ba);
+
+  bool const ok = wait_mem_harness(pred_true, NULL);
+  assert(ok == true);
+
+  // The snapshot, or a heartbeat, follows an accepted HELLO
+  struct pollfd pfd = {.fd = ep.fd, .events = POLLIN};
+  int const rc = poll(&pfd, 1, 2 * REPL_HEARTBEAT_MS);
+  assert(rc != -1);
+
+  e2ap_ep_free(&ep);
+  return rc > 0;
+}
+
+size_t num_live_ric_req_id_mem_harness(mem_harness_t* h)
+{
+  assert(h != NULL);
+  return num_live_ric_req_id(&h->ric->req_id);
+}
+
+size_t num_e2_nodes_mem_harness(mem_harness_t* h)
+{
+  assert(h != NULL);
+
+  // Shallow copy
+  seq_arr_t arr = conn_e2_nodes(h->ric);
+  size_t const sz = seq_size(&arr);
+  seq_free(&arr, NULL);
+  return sz;
+}
+
+bool assoc_ag_mem_harness(mem_harness_t* h, size_t idx)
+{
+  assert(h != NULL);
+  assert(idx < h->num_ag);
+
+  sctp_info_t info = {0};
+  return try_find_map_e2_node_sad(&h->ric->ep.e2_nodes, &h->ag[idx].id, &info);
+}
+
+void failover_mem_harness(mem_harness_t* h)
+{
+  assert(h != NULL);
+  assert(h->standby_args.conf_file[0] != '\0' && "No standby nearRT-RIC");
+  assert(h->failover == false);
+
+  free_near_ric(h->ric);
+  int const rc = pthread_join(h->t_ric, NULL);
+  assert(rc == 0);
+
+  bool const ok = wait_mem_harness(pred_standby_up, h);
+  assert(ok == true && "Standby nearRT-RIC did not take over");
+
+  h->ric = atomic_load(&h->standby);
+  h->t_ric = h->t_standby;
+  h->failover = true;
+}
+
+void restart_ric_mem_harness(mem_harness_t* h)
+{
+  assert(h != NULL);
+  assert(h->standby_args.conf_file[0] == '\0' && "Use failover_mem_harness()");
+
+  free_near_ric(h->ric);
+  int rc = pthread_join(h->t_ric, NULL);
+  assert(rc == 0);
+
+  h->ric = init_near_ric(&h->args);
+  rc = pthread_create(&h->t_ric, NULL, start_ric, h->ric);
+  assert(rc == 0);
+}
+
+uint64_t advance_mem_harness(mem_harness_t* h, int64_t delta_ms)
+{
+  assert(h != NULL);
+  return advance_sim_clock(&h->clk, delta_ms);
+}
+
+void stop_ag_mem_harness(mem_harness_t* h, size_t idx)
+{
+  assert(h != NULL);
+  assert(idx < h->num_ag);
+  assert(h->ag[idx].ag != NULL && "E2 Node already stopped");
+
+  // Closes the endpoint, i.e., the nearRT-RIC receives an SCTP_SHUTDOWN_EVENT
+  e2_free_agent(h->ag[idx].ag);
+  int const rc = pthread_join(h->ag[idx].t, NULL);
+  assert(rc == 0);
+  h->ag[idx].ag = NULL;
+}
+
+bool wait_mem_harness(bool (*pred)(void* arg), void* arg)
+{
+  assert(pred != NULL);
+  pred_idle_t p = {.pred = pred, .arg = arg};
+  return wait_mem_ep(pred_idle, &p, TIMEOUT_MEM_HARNESS_MS);
+}
+
+uint64_t ind_read_mem_harness(void)
+{
+  return atomic_load(&ind_read);
+}
+
+uint64_t ctrl_written_mem_harness(void)
+{
+  return atomic_load(&ctrl_written);
+}
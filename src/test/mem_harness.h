@@ -0,0 +1,121 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+#ifndef MEM_HARNESS_H
+#define MEM_HARNESS_H
+
+// A nearRT-RIC, E2 Nodes and xApps in one process, connected through the 
+// in-memory transport, see lib/ep/mem_ep.h. The E2 Nodes are gNBs with 
+// the MAC SM, nb_id 1 to num_ag, whose subscriptions expire with a manual
+// clock, i.e., the test advances it. The steps wait on the protocol events,
+// e.g., the E2 Nodes connected to the nearRT-RIC, and never on the wall clock
+
+#include "../lib/e2ap/e2ap_global_node_id_wrapper.h"
+#include "../xApp/e42_xapp.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define TIMEOUT_MEM_HARNESS_MS 5000
+
+typedef struct mem_harness_s mem_harness_t;
+
+#define MAX_RIC_MEM_HARNESS 4
+
+typedef struct{
+  size_t num_ag;
+  size_t num_xapp;
+  // nearRT-RICs of the test, listening at 127.0.0.2, 127.0.0.3, ... 
+  // The E2 Nodes also connect to them, after the nearRT-RIC of the harness
+  size_t num_extra_ric;
+  // Directory with the SMs, e.g., only libmac_sm.so
+  char const* libs_dir;
+  // Directory with the SMs of the E2 Nodes, e.g., a subset of libs_dir to 
+  // request unknown RAN Functions. NULL for libs_dir
+  char const* ag_libs_dir;
+  // XAPP_TOKEN of the xApps, i.e., one xApp. NULL for none 
+  char const* xapp_token;
+  // XAPP_GROUP of the xApps, i.e., all in one consumer group. NULL for none
+  char const* xapp_group;
+  // A standby nearRT-RIC replicates the one of the harness, at the same 
+  // address, see ric/repl_ric.h. It needs failover_mem_harness() 
+  bool standby;
+  // RECONNECT_BACKOFF of the E2 Nodes and the xApps, e.g., "base=20;max=500". 
+  // NULL for the default, see util/backoff.h
+  char const* backoff;
+  // Connection state changes of the E2 Nodes and the xApps. NULL for none
+  conn_state_cb conn_cb;
+  void* conn_data;
+  // Called after the E2 Setup of the E2 Nodes and before the xApps, e.g., 
+  // to set up E2 Nodes emulated by the test, which the xApps then learn. 
+  // NULL for none
+  void (*ag_setup_cb)(void* data);
+  void* ag_setup_data;
+} mem_harness_args_t;
+
+// Returns once the E2 Nodes and the xApps completed their E2 and E42 Setup
+mem_harness_t* init_mem_harness(mem_harness_args_t const* args);
+
+void free_mem_harness(mem_harness_t* h);
+
+e42_xapp_t* xapp_mem_harness(mem_harness_t* h, size_t idx);
+
+global_e2_node_id_t ag_id_mem_harness(mem_harness_t const* h, size_t idx);
+
+// E2 Nodes connected to the nearRT-RIC
+size_t num_e2_nodes_mem_harness(mem_harness_t* h);
+
+// A peer presents itself to the nearRT-RIC as its standby, with the 
+// HA_SECRET secret. Returns whether it was answered. Needs standby
+bool hello_repl_mem_harness(mem_harness_t* h, char const* secret);
+
+// RIC Request IDs live in the nearRT-RIC
+size_t num_live_ric_req_id_mem_harness(mem_harness_t* h);
+
+// The E2 Node is associated with the nearRT-RIC, e.g., it set up again 
+// after a failover
+bool assoc_ag_mem_harness(mem_harness_t* h, size_t idx);
+
+// The nearRT-RIC goes down and the standby takes over. Returns once the 
+// standby serves the E2 Nodes and the xApps, i.e., before they set up again
+void failover_mem_harness(mem_harness_t* h);
+
+// The nearRT-RIC goes down and starts again from scratch, i.e., without 
+// E2 Nodes, xApps or subscriptions. Returns before they set up again
+void restart_ric_mem_harness(mem_harness_t* h);
+
+// Advances the clock of the E2 Nodes. Returns the expired subscriptions
+uint64_t advance_mem_harness(mem_harness_t* h, int64_t delta_ms);
+
+// The E2 Node closes its association, as if it went down
+void stop_ag_mem_harness(mem_harness_t* h, size_t idx);
+
+// Blocks until pred holds, at most TIMEOUT_MEM_HARNESS_MS. 
+// The messages in flight are delivered before it returns true
+bool wait_mem_harness(bool (*pred)(void* arg), void* arg);
+
+// MAC indications read and controls written by the E2 Nodes
+uint64_t ind_read_mem_harness(void);
+
+uint64_t ctrl_written_mem_harness(void);
+
+#endif
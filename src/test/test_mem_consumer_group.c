@@ -0,0 +1,179 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+// xApps of one consumer group share the subscriptions, see 
+// ric/iApp/consumer_group.h. Every E2 Node reads once per period, whatever 
+// the number of members, and each indication reaches one member. The 
+// members that leave stop receiving, while the others keep on
+
+#include "mem_harness.h"
+#include "../sm/mac_sm/mac_sm_id.h"
+
+#include <assert.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define NUM_AG 4
+#define NUM_XAPP 3
+#define PERIOD_MS 10
+#define NUM_PERIODS 20
+
+static
+_Atomic uint64_t ind_rcv[NUM_XAPP];
+
+static
+void count_ind(size_t xapp, sm_ag_if_rd_t const* rd)
+{
+  assert(rd->type == INDICATION_MSG_AGENT_IF_ANS_V0);
+  assert(rd->ind.type == MAC_STATS_V0);
+
+  atomic_fetch_add(&ind_rcv[xapp], 1);
+  kick_mem_ep();
+}
+
+static
+void cb_mac_0(sm_ag_if_rd_t const* rd)
+{
+  count_ind(0, rd);
+}
+
+static
+void cb_mac_1(sm_ag_if_rd_t const* rd)
+{
+  count_ind(1, rd);
+}
+
+static
+void cb_mac_2(sm_ag_if_rd_t const* rd)
+{
+  count_ind(2, rd);
+}
+
+static
+sm_cb const cb_mac[NUM_XAPP] = {cb_mac_0, cb_mac_1, cb_mac_2};
+
+static
+uint64_t total_ind_rcv(void)
+{
+  uint64_t n = 0;
+  for(size_t i = 0; i < NUM_XAPP; ++i)
+    n += atomic_load(&ind_rcv[i]);
+  return n;
+}
+
+static
+bool pred_ind_rcv(void* arg)
+{
+  return total_ind_rcv() == *(uint64_t*)arg;
+}
+
+static
+bool pred_true(void* arg)
+{
+  (void)arg;
+  return true;
+}
+
+// One E2 subscription per E2 Node, and one indication per E2 Node and period
+static
+void lockstep(mem_harness_t* h)
+{
+  uint64_t expected = total_ind_rcv();
+  for(uint64_t k = 0; k < NUM_PERIODS; ++k){
+    uint64_t const fired = advance_mem_harness(h, PERIOD_MS);
+    assert(fired == NUM_AG);
+
+    expected += NUM_AG;
+    bool const ok = wait_mem_harness(pred_ind_rcv, &expected);
+    assert(ok == true && "Indications lost or duplicated");
+  }
+}
+
+static
+void test_share(mem_harness_t* h, int handle[NUM_XAPP][NUM_AG])
+{
+  char period[] = "10_ms";
+
+  for(size_t i = 0; i < NUM_XAPP; ++i){
+    for(size_t j = 0; j < NUM_AG; ++j){
+      global_e2_node_id_t id = ag_id_mem_harness(h, j);
+      sm_ans_xapp_t const ans = report_sm_sync_xapp(xapp_mem_harness(h, i), &id, SM_MAC_ID, period, NULL, NULL, cb_mac[i]);
+      assert(ans.success == true);
+      handle[i][j] = ans.u.handle;
+    }
+  }
+
+  assert(advance_mem_harness(h, PERIOD_MS) == NUM_AG);
+  uint64_t expected = NUM_AG;
+  bool const ok = wait_mem_harness(pred_ind_rcv, &expected);
+  assert(ok == true);
+
+  lockstep(h);
+  assert(ind_read_mem_harness() == (NUM_PERIODS + 1) * NUM_AG);
+}
+
+static
+void test_leave(mem_harness_t* h, int handle[NUM_XAPP][NUM_AG])
+{
+  // The E2 Nodes of the first member move to the others
+  for(size_t j = 0; j < NUM_AG; ++j)
+    rm_report_sm_sync_xapp(xapp_mem_harness(h, 0), handle[0][j]);
+
+  bool ok = wait_mem_harness(pred_true, NULL);
+  assert(ok == true);
+  uint64_t const left = atomic_load(&ind_rcv[0]);
+
+  lockstep(h);
+  assert(atomic_load(&ind_rcv[0]) == left);
+
+  // The last members delete the subscriptions at the E2 Nodes
+  for(size_t i = 1; i < NUM_XAPP; ++i){
+    for(size_t j = 0; j < NUM_AG; ++j)
+      rm_report_sm_sync_xapp(xapp_mem_harness(h, i), handle[i][j]);
+  }
+
+  uint64_t const rcv = total_ind_rcv();
+  assert(advance_mem_harness(h, 10 * PERIOD_MS) == 0);
+  ok = wait_mem_harness(pred_true, NULL);
+  assert(ok == true);
+  assert(total_ind_rcv() == rcv);
+}
+
+int main()
+{
+  mem_harness_args_t const args = {.num_ag = NUM_AG, 
+                                   .num_xapp = NUM_XAPP, 
+                                   .libs_dir = MEM_HARNESS_SM_DIR,
+                                   .xapp_group = "localization"};
+
+  mem_harness_t* h = init_mem_harness(&args);
+
+  int handle[NUM_XAPP][NUM_AG] = {0};
+
+  test_share(h, handle);
+  test_leave(h, handle);
+
+  free_mem_harness(h);
+
+  printf("Success\n");
+  return EXIT_SUCCESS;
+}
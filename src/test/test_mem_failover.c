@@ -0,0 +1,236 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+// A standby nearRT-RIC replicates the one of the harness and takes over 
+// once it goes down, see ric/repl_ric.h. The E2 Nodes keep reading the 
+// indications, as the clock keeps on advancing. The test measures the data 
+// gap at the xApp, i.e., the wall-clock time without indications, and the 
+// indications lost. The xApp resumes its session with its subscriptions, 
+// which it finally deletes through the standby
+
+#include "mem_harness.h"
+#include "../sm/mac_sm/mac_sm_id.h"
+#include "../util/time_now_us.h"
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#define NUM_AG 2
+#define PERIOD_MS 10
+#define NUM_PERIODS 20
+// Bounded by the shutdown of the nearRT-RIC and the reconnection of the xApp
+#define MAX_GAP_MS 5000
+
+static
+_Atomic uint64_t ind_rcv;
+
+static
+_Atomic int64_t last_ind_us;
+
+static
+_Atomic int64_t max_gap_us;
+
+// Indications read by the E2 Nodes when the lockstep started, and
+// received since then
+static
+_Atomic uint64_t lockstep_read;
+
+static
+_Atomic uint64_t lockstep_rcv;
+
+static
+void cb_mac(sm_ag_if_rd_t const* rd)
+{
+  assert(rd->type == INDICATION_MSG_AGENT_IF_ANS_V0);
+  assert(rd->ind.type == MAC_STATS_V0);
+
+  int64_t const now = time_now_us();
+  int64_t const gap = now - atomic_exchange(&last_ind_us, now);
+  int64_t max = atomic_load(&max_gap_us);
+  while(gap > max && atomic_compare_exchange_weak(&max_gap_us, &max, gap) == false)
+    ;
+
+  // The E2 Nodes stamp the indications with the number read, see mem_harness.c
+  if((uint64_t)rd->ind.mac.msg.tstamp > atomic_load(&lockstep_read))
+    atomic_fetch_add(&lockstep_rcv, 1);
+
+  atomic_fetch_add(&ind_rcv, 1);
+  kick_mem_ep();
+}
+
+static
+bool pred_ind_rcv(void* arg)
+{
+  return atomic_load(&lockstep_rcv) == *(uint64_t*)arg;
+}
+
+static
+bool pred_true(void* arg)
+{
+  (void)arg;
+  return true;
+}
+
+static
+bool pred_assoc(void* arg)
+{
+  for(size_t i = 0; i < NUM_AG; ++i){
+    if(assoc_ag_mem_harness(arg, i) == false)
+      return false;
+  }
+  return true;
+}
+
+typedef struct{
+  mem_harness_t* h;
+  pthread_t t;
+  atomic_bool done;
+} failover_t;
+
+static
+void* start_failover(void* arg)
+{
+  failover_t* f = (failover_t*)arg;
+  failover_mem_harness(f->h);
+  atomic_store(&f->done, true);
+  return NULL;
+}
+
+// One indication per subscription and period, in lockstep
+static
+void lockstep(mem_harness_t* h)
+{
+  // Late indications of the failover, read before, are not counted
+  atomic_store(&lockstep_read, ind_read_mem_harness());
+  atomic_store(&lockstep_rcv, 0);
+
+  uint64_t expected = 0;
+  for(uint64_t k = 0; k < NUM_PERIODS; ++k){
+    uint64_t const fired = advance_mem_harness(h, PERIOD_MS);
+    assert(fired == NUM_AG);
+
+    expected += NUM_AG;
+    bool const ok = wait_mem_harness(pred_ind_rcv, &expected);
+    assert(ok == true && "Indications lost");
+  }
+}
+
+static
+void test_subscribe(mem_harness_t* h, int handle[NUM_AG])
+{
+  char period[] = "10_ms";
+
+  for(size_t i = 0; i < NUM_AG; ++i){
+    global_e2_node_id_t id = ag_id_mem_harness(h, i);
+    sm_ans_xapp_t const ans = report_sm_sync_xapp(xapp_mem_harness(h, 0), &id, SM_MAC_ID, period, NULL, NULL, cb_mac);
+    assert(ans.success == true);
+    handle[i] = ans.u.handle;
+  }
+
+  lockstep(h);
+}
+
+// Only the peers with the HA_SECRET replicate the nearRT-RIC
+static
+void test_rogue_standby(mem_harness_t* h)
+{
+  assert(hello_repl_mem_harness(h, "not the secret") == false);
+  assert(hello_repl_mem_harness(h, "") == false);
+}
+
+static
+void test_failover(mem_harness_t* h)
+{
+  bool ok = wait_mem_harness(pred_true, NULL);
+  assert(ok == true);
+
+  uint64_t const read = ind_read_mem_harness(); 
+  uint64_t const rcv = atomic_load(&ind_rcv);
+  atomic_store(&last_ind_us, time_now_us());
+  atomic_store(&max_gap_us, 0);
+
+  // The clock of the E2 Nodes runs 10 times faster than the wall-clock, 
+  // until the xApp is back
+  failover_t f = {.h = h};
+  int rc = pthread_create(&f.t, NULL, start_failover, &f);
+  assert(rc == 0);
+  int64_t const start = time_now_us();
+  while(atomic_load(&f.done) == false || connected_e42_xapp(xapp_mem_harness(h, 0)) == false){
+    assert(time_now_us() - start < 2 * MAX_GAP_MS * 1000 && "xApp did not reconnect");
+    advance_mem_harness(h, PERIOD_MS);
+    usleep(1000);
+  }
+  rc = pthread_join(f.t, NULL);
+  assert(rc == 0);
+
+  // The E2 Nodes set up again with the standby
+  ok = wait_mem_harness(pred_assoc, h);
+  assert(ok == true && "E2 Nodes did not set up again");
+
+  // The subscriptions were resumed
+  lockstep(h);
+
+  uint64_t const lost = (ind_read_mem_harness() - read) - (atomic_load(&ind_rcv) - rcv);
+  int64_t const gap_ms = atomic_load(&max_gap_us) / 1000;
+  printf("Failover: data gap %ld ms, %lu of %lu indications lost\n", gap_ms, lost, ind_read_mem_harness() - read);
+  assert(gap_ms < MAX_GAP_MS);
+}
+
+static
+void test_rm_subscription(mem_harness_t* h, int handle[NUM_AG])
+{
+  for(size_t i = 0; i < NUM_AG; ++i)
+    rm_report_sm_sync_xapp(xapp_mem_harness(h, 0), handle[i]);
+
+  // The timers of the E2 Nodes are gone
+  uint64_t const rcv = atomic_load(&ind_rcv);
+  assert(advance_mem_harness(h, 10 * PERIOD_MS) == 0);
+  bool const ok = wait_mem_harness(pred_true, NULL);
+  assert(ok == true);
+  assert(atomic_load(&ind_rcv) == rcv);
+}
+
+int main()
+{
+  mem_harness_args_t const args = {.num_ag = NUM_AG, 
+                                   .num_xapp = 1, 
+                                   .libs_dir = MEM_HARNESS_SM_DIR,
+                                   .xapp_token = "failover",
+                                   .standby = true};
+
+  mem_harness_t* h = init_mem_harness(&args);
+
+  int handle[NUM_AG] = {0};
+
+  test_subscribe(h, handle);
+  test_rogue_standby(h);
+  test_failover(h);
+  test_rm_subscription(h, handle);
+
+  free_mem_harness(h);
+
+  printf("Success\n");
+  return EXIT_SUCCESS;
+}
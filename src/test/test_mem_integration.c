@@ -0,0 +1,227 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+#include "mem_harness.h"
+#include "../sm/mac_sm/mac_sm_id.h"
+#include "../sm/rlc_sm/rlc_sm_id.h"
+
+#include <assert.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define NUM_AG 3
+#define NUM_XAPP 2
+#define PERIOD_MS 10
+#define NUM_PERIODS 20
+
+static
+_Atomic uint64_t ind_rcv;
+
+static
+void cb_mac(sm_ag_if_rd_t const* rd)
+{
+  assert(rd->type == INDICATION_MSG_AGENT_IF_ANS_V0);
+  assert(rd->ind.type == MAC_STATS_V0);
+  assert(rd->ind.mac.msg.len_ue_stats == 1);
+  assert(rd->ind.mac.msg.ue_stats[0].rnti == 0x4601);
+
+  atomic_fetch_add(&ind_rcv, 1);
+  // Handled after its message was received
+  kick_mem_ep();
+}
+
+static
+bool pred_ind_rcv(void* arg)
+{
+  return atomic_load(&ind_rcv) == *(uint64_t*)arg;
+}
+
+typedef struct{
+  mem_harness_t* h;
+  size_t num;
+} num_e2_nodes_t;
+
+static
+bool pred_num_e2_nodes(void* arg)
+{
+  num_e2_nodes_t* n = (num_e2_nodes_t*)arg;
+  return num_e2_nodes_mem_harness(n->h) == n->num;
+}
+
+static
+bool pred_no_live_req_id(void* arg)
+{
+  mem_harness_t* h = (mem_harness_t*)arg;
+  return num_live_ric_req_id_mem_harness(h) == 0;
+}
+
+static
+bool pred_true(void* arg)
+{
+  (void)arg;
+  return true;
+}
+
+static
+void test_setup(mem_harness_t* h)
+{
+  assert(num_e2_nodes_mem_harness(h) == NUM_AG);
+
+  for(size_t i = 0; i < NUM_XAPP; ++i){
+    e2_node_arr_xapp_t nodes = e2_nodes_xapp(xapp_mem_harness(h, i));
+    assert(nodes.len == NUM_AG);
+
+    // Every E2 Node once
+    uint32_t seen = 0;
+    for(size_t j = 0; j < nodes.len; ++j){
+      uint32_t const nb_id = nodes.n[j].id.nb_id.nb_id;
+      assert(nb_id > 0 && nb_id <= NUM_AG);
+      seen |= 1 << nb_id;
+    }
+    assert(seen == ((1 << (NUM_AG + 1)) - 2));
+    free_e2_node_arr_xapp(&nodes);
+  }
+}
+
+static
+void test_indication(mem_harness_t* h, int handle[NUM_XAPP][NUM_AG])
+{
+  char period[] = "10_ms";
+
+  // Subscription
+  for(size_t i = 0; i < NUM_XAPP; ++i){
+    for(size_t j = 0; j < NUM_AG; ++j){
+      global_e2_node_id_t id = ag_id_mem_harness(h, j);
+      sm_ans_xapp_t const ans = report_sm_sync_xapp(xapp_mem_harness(h, i), &id, SM_MAC_ID, period, NULL, NULL, cb_mac);
+      assert(ans.success == true);
+      handle[i][j] = ans.u.handle;
+    }
+  }
+
+  // Nothing before the clock advances
+  bool ok = wait_mem_harness(pred_true, NULL);
+  assert(ok == true && atomic_load(&ind_rcv) == 0);
+  assert(advance_mem_harness(h, PERIOD_MS - 1) == 0);
+
+  // One indication per subscription and period, in lockstep
+  for(uint64_t k = 1; k <= NUM_PERIODS; ++k){
+    uint64_t const fired = advance_mem_harness(h, k == 1 ? 1 : PERIOD_MS);
+    assert(fired == NUM_XAPP * NUM_AG);
+
+    uint64_t expected = k * NUM_XAPP * NUM_AG;
+    ok = wait_mem_harness(pred_ind_rcv, &expected);
+    assert(ok == true && "Indications lost");
+    assert(ind_read_mem_harness() == expected);
+  }
+}
+
+static
+void test_rm_subscription(mem_harness_t* h, int handle[NUM_XAPP][NUM_AG])
+{
+  for(size_t i = 0; i < NUM_XAPP; ++i){
+    for(size_t j = 0; j < NUM_AG; ++j)
+      rm_report_sm_sync_xapp(xapp_mem_harness(h, i), handle[i][j]);
+  }
+
+  // The timers of the E2 Nodes are gone
+  assert(advance_mem_harness(h, 10 * PERIOD_MS) == 0);
+  bool const ok = wait_mem_harness(pred_true, NULL);
+  assert(ok == true);
+  assert(atomic_load(&ind_rcv) == NUM_PERIODS * NUM_XAPP * NUM_AG);
+}
+
+static
+void test_control(mem_harness_t* h)
+{
+  mac_ctrl_req_data_t ctrl = {.hdr.dummy = 1, .msg.action = 42};
+
+  for(size_t i = 0; i < NUM_XAPP; ++i){
+    for(size_t j = 0; j < NUM_AG; ++j){
+      global_e2_node_id_t id = ag_id_mem_harness(h, j);
+      sm_ans_xapp_t const ans = control_sm_sync_xapp(xapp_mem_harness(h, i), &id, SM_MAC_ID, &ctrl);
+      assert(ans.success == true);
+      // Acknowledged, i.e., written
+      assert(ctrl_written_mem_harness() == i * NUM_AG + j + 1);
+    }
+  }
+}
+
+// The E2 Nodes lack the RLC SM of the nearRT-RIC and the xApps
+static
+void test_subscription_failure(mem_harness_t* h)
+{
+  char period[] = "10_ms";
+
+  // The IDs of the controls are released after their answers reach the xApps
+  bool ok = wait_mem_harness(pred_no_live_req_id, h);
+  assert(ok == true);
+
+  for(size_t i = 0; i < NUM_XAPP; ++i){
+    global_e2_node_id_t id = ag_id_mem_harness(h, 0);
+    sm_ans_xapp_t const ans = report_sm_sync_xapp(xapp_mem_harness(h, i), &id, SM_RLC_ID, period, NULL, NULL, cb_mac);
+    assert(ans.success == false);
+  }
+
+  // The RIC Request IDs of the failed subscriptions are released
+  ok = wait_mem_harness(pred_no_live_req_id, h);
+  assert(ok == true && "RIC Request ID leaked");
+}
+
+static
+void test_teardown(mem_harness_t* h)
+{
+  num_e2_nodes_t arg = {.h = h, .num = NUM_AG - 1};
+
+  // The nearRT-RIC learns the lost association
+  stop_ag_mem_harness(h, NUM_AG - 1);
+  bool ok = wait_mem_harness(pred_num_e2_nodes, &arg);
+  assert(ok == true);
+
+  stop_ag_mem_harness(h, 0);
+  arg.num = NUM_AG - 2;
+  ok = wait_mem_harness(pred_num_e2_nodes, &arg);
+  assert(ok == true);
+}
+
+int main()
+{
+  mem_harness_args_t const args = {.num_ag = NUM_AG, 
+                                   .num_xapp = NUM_XAPP, 
+                                   .libs_dir = MEM_HARNESS_RIC_SM_DIR,
+                                   .ag_libs_dir = MEM_HARNESS_SM_DIR};
+
+  mem_harness_t* h = init_mem_harness(&args);
+
+  int handle[NUM_XAPP][NUM_AG] = {0};
+
+  test_setup(h);
+  test_indication(h, handle);
+  test_rm_subscription(h, handle);
+  test_control(h);
+  test_subscription_failure(h);
+  test_teardown(h);
+
+  free_mem_harness(h);
+
+  printf("Success\n");
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,320 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+// One nearRT-RIC serves E2 Nodes of E2AP v2.03 and v3.01 at once. The E2 
+// Nodes of the harness speak the compiled version, and an emulated E2 Node 
+// speaks the other one through its codec, see codec/e2ap_codec.h. Both 
+// versions encode the procedures of FlexRIC into the same PDUs, so the
+// nearRT-RIC needs no codec per association for them
+
+#include "mem_harness.h"
+#include "codec/e2ap_codec.h"
+#include "../lib/ep/mem_ep.h"
+#include "../sm/mac_sm/mac_sm_id.h"
+#include "../sm/mac_sm/ie/mac_wire_plain.h"
+#include "../sm/sm_enc.h"
+
+#include <assert.h>
+#include <dlfcn.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NUM_IND 5
+#define RNTI_AG 0x4601
+#define RNTI_OTHER 0x4602
+
+static
+_Atomic uint64_t ind_rcv_ag;
+
+static
+_Atomic uint64_t ind_rcv_other;
+
+static
+void cb_mac(sm_ag_if_rd_t const* rd)
+{
+  assert(rd->type == INDICATION_MSG_AGENT_IF_ANS_V0);
+  assert(rd->ind.type == MAC_STATS_V0);
+  assert(rd->ind.mac.msg.len_ue_stats == 1);
+
+  uint16_t const rnti = rd->ind.mac.msg.ue_stats[0].rnti;
+  assert(rnti == RNTI_AG || rnti == RNTI_OTHER);
+  atomic_fetch_add(rnti == RNTI_AG ? &ind_rcv_ag : &ind_rcv_other, 1);
+  kick_mem_ep();
+}
+
+// E2 Node of the other E2AP version
+typedef struct{
+  e2ap_codec_t const* codec;
+  void* handle;
+  mem_ep_t* ep;
+  global_e2_node_id_t id;
+  pthread_t t;
+} other_node_t;
+
+static
+e2ap_codec_t const* load_codec(void** handle)
+{
+  *handle = dlopen(MEM_HARNESS_E2AP_CODEC, RTLD_NOW | RTLD_LOCAL);
+  assert(*handle != NULL && "E2AP codec not found");
+
+  e2ap_codec_fp fp = (e2ap_codec_fp)dlsym(*handle, E2AP_CODEC_SYM);
+  assert(fp != NULL);
+  return fp();
+}
+
+static
+void send_other_node(other_node_t* n, e2ap_msg_t const* msg)
+{
+  byte_array_t ba = n->codec->enc_msg(msg->type, &msg->u_msgs, sizeof(msg->u_msgs));
+  bool const ok = send_mem_ep(n->ep, NULL, 0, 0, ba);
+  assert(ok == true);
+  free_byte_array(ba);
+}
+
+static
+e2ap_msg_t recv_other_node(other_node_t* n)
+{
+  mem_ep_msg_t rcv = recv_mem_ep(n->ep);
+  assert(rcv.eof == false);
+
+  int type = NONE_E2_MSG_TYPE;
+  e2ap_msg_t dec = {.type = NONE_E2_MSG_TYPE};
+  bool const ok = n->codec->dec_msg(rcv.ba, &type, &dec.u_msgs, sizeof(dec.u_msgs));
+  assert(ok == true && "PDU of the nearRT-RIC undecodable by the other version");
+  free_mem_ep_msg(&rcv);
+
+  e2ap_msg_t const msg = {.type = type, .u_msgs = dec.u_msgs};
+  return msg;
+}
+
+static
+void free_msg_other_node(other_node_t* n, e2ap_msg_t* msg)
+{
+  n->codec->free_msg(msg->type, &msg->u_msgs, sizeof(msg->u_msgs));
+}
+
+static
+void e2_setup_other_node(other_node_t* n)
+{
+  sm_e2_setup_data_t def = tag_ran_func_def_sm_enc(SM_MAC_STR, PLAIN_SM_ENC);
+
+  e2ap_msg_t msg = {.type = E2_SETUP_REQUEST};
+  e2_setup_request_t* sr = &msg.u_msgs.e2_stp_req;
+  sr->trans_id = 1;
+  sr->id = n->id;
+
+  sr->len_rf = 1;
+  sr->ran_func_item = calloc(1, sizeof(ran_function_t));
+  assert(sr->ran_func_item != NULL && "Memory exhausted");
+  sr->ran_func_item[0].id = SM_MAC_ID;
+  sr->ran_func_item[0].rev = SM_MAC_REV;
+  sr->ran_func_item[0].defn = (byte_array_t){.len = def.len_rfd, .buf = def.ran_fun_def};
+  sr->ran_func_item[0].oid = cp_str_to_ba(SM_MAC_OID);
+
+  sr->len_cca = 1;
+  sr->comp_conf_add = calloc(1, sizeof(e2ap_node_component_config_add_t));
+  assert(sr->comp_conf_add != NULL && "Memory exhausted");
+  sr->comp_conf_add[0].e2_node_comp_interface_type = NG_E2AP_NODE_COMP_INTERFACE_TYPE;
+  sr->comp_conf_add[0].e2_node_comp_id.type = NG_E2AP_NODE_COMP_INTERFACE_TYPE;
+  sr->comp_conf_add[0].e2_node_comp_id.ng_amf_name = cp_str_to_ba("amf");
+  sr->comp_conf_add[0].e2_node_comp_conf.request = cp_str_to_ba("ngapRequest");
+  sr->comp_conf_add[0].e2_node_comp_conf.response = cp_str_to_ba("ngapResponse");
+
+  send_other_node(n, &msg);
+  free_msg_other_node(n, &msg);
+
+  e2ap_msg_t ans = recv_other_node(n);
+  assert(ans.type == E2_SETUP_RESPONSE);
+  assert(ans.u_msgs.e2_stp_resp.trans_id == 1);
+  assert(ans.u_msgs.e2_stp_resp.len_acc == 1);
+  assert(ans.u_msgs.e2_stp_resp.accepted[0] == SM_MAC_ID);
+  free_msg_other_node(n, &ans);
+}
+
+static
+void indication_other_node(other_node_t* n, ric_gen_id_t ric_id, uint8_t action_id, int64_t tstamp)
+{
+  mac_ind_hdr_t hdr = {.dummy = 1};
+  mac_ue_stats_impl_t ue = {.rnti = RNTI_OTHER};
+  // The DB of the xApps requires tstamp > 0
+  mac_ind_msg_t ind = {.len_ue_stats = 1, .ue_stats = &ue, .tstamp = tstamp};
+
+  e2ap_msg_t msg = {.type = RIC_INDICATION};
+  ric_indication_t* ri = &msg.u_msgs.ric_ind;
+  ri->ric_id = ric_id;
+  ri->action_id = action_id;
+  ri->type = RIC_IND_REPORT;
+  ri->hdr = enc_mac_ind_hdr_plain_wire(&hdr);
+  ri->msg = enc_mac_ind_msg_plain_wire(&ind);
+
+  send_other_node(n, &msg);
+  free_msg_other_node(n, &msg);
+}
+
+// Answers the subscription of the xApp, reports NUM_IND indications, and 
+// returns after the subscription is deleted
+static
+void* subscription_other_node(void* arg)
+{
+  other_node_t* n = (other_node_t*)arg;
+
+  e2ap_msg_t req = recv_other_node(n);
+  assert(req.type == RIC_SUBSCRIPTION_REQUEST);
+  ric_subscription_request_t const* sr = &req.u_msgs.ric_sub_req;
+  assert(sr->ric_id.ran_func_id == SM_MAC_ID && sr->len_action == 1);
+
+  ric_action_admitted_t adm = {.ric_act_id = sr->action[0].id};
+  e2ap_msg_t resp = {.type = RIC_SUBSCRIPTION_RESPONSE};
+  resp.u_msgs.ric_sub_resp.ric_id = sr->ric_id;
+  resp.u_msgs.ric_sub_resp.admitted = &adm;
+  resp.u_msgs.ric_sub_resp.len_admitted = 1;
+  send_other_node(n, &resp);
+
+  for(int i = 0; i < NUM_IND; ++i)
+    indication_other_node(n, sr->ric_id, sr->action[0].id, i + 1);
+
+  ric_gen_id_t const ric_id = sr->ric_id;
+  free_msg_other_node(n, &req);
+
+  e2ap_msg_t del = recv_other_node(n);
+  assert(del.type == RIC_SUBSCRIPTION_DELETE_REQUEST);
+  assert(eq_ric_gen_id(&del.u_msgs.ric_sub_del_req.ric_id, &ric_id) == true);
+
+  e2ap_msg_t del_resp = {.type = RIC_SUBSCRIPTION_DELETE_RESPONSE};
+  del_resp.u_msgs.ric_sub_del_resp.ric_id = ric_id;
+  send_other_node(n, &del_resp);
+  free_msg_other_node(n, &del);
+
+  return NULL;
+}
+
+static
+bool pred_ind_rcv(void* arg)
+{
+  (void)arg;
+  return atomic_load(&ind_rcv_ag) == 1 && atomic_load(&ind_rcv_other) == NUM_IND;
+}
+
+static
+bool pred_one_e2_node(void* arg)
+{
+  mem_harness_t* h = (mem_harness_t*)arg;
+  return num_e2_nodes_mem_harness(h) == 1;
+}
+
+// Before the xApps, i.e., ag_setup_cb
+static
+void setup_other_node(void* arg)
+{
+  other_node_t* n = (other_node_t*)arg;
+  assert(n->codec->version != E2AP_COMPILED_VERSION);
+  printf("[TEST]: nearRT-RIC of E2AP %s, E2 Node of E2AP %s\n", e2ap_version_str(E2AP_COMPILED_VERSION), e2ap_version_str(n->codec->version));
+
+  n->ep = connect_mem_ep("127.0.0.1", 36421);
+  assert(n->ep != NULL);
+  e2_setup_other_node(n);
+}
+
+static
+void test_setup(mem_harness_t* h, other_node_t const* n)
+{
+  assert(num_e2_nodes_mem_harness(h) == 2);
+
+  // The xApp knows the E2 Nodes of both versions
+  e2_node_arr_xapp_t nodes = e2_nodes_xapp(xapp_mem_harness(h, 0));
+  assert(nodes.len == 2);
+
+  uint32_t seen = 0;
+  for(size_t i = 0; i < nodes.len; ++i){
+    if(eq_global_e2_node_id(&nodes.n[i].id, &n->id))
+      seen |= 1;
+    else if(nodes.n[i].id.nb_id.nb_id == ag_id_mem_harness(h, 0).nb_id.nb_id)
+      seen |= 2;
+  }
+  assert(seen == 3);
+  free_e2_node_arr_xapp(&nodes);
+}
+
+static
+void test_indication(mem_harness_t* h, other_node_t* n)
+{
+  char period[] = "10_ms";
+  e42_xapp_t* xapp = xapp_mem_harness(h, 0);
+
+  global_e2_node_id_t id = ag_id_mem_harness(h, 0);
+  sm_ans_xapp_t const ans_ag = report_sm_sync_xapp(xapp, &id, SM_MAC_ID, period, NULL, NULL, cb_mac);
+  assert(ans_ag.success == true);
+
+  int rc = pthread_create(&n->t, NULL, subscription_other_node, n);
+  assert(rc == 0);
+  sm_ans_xapp_t const ans_other = report_sm_sync_xapp(xapp, &n->id, SM_MAC_ID, period, NULL, NULL, cb_mac);
+  assert(ans_other.success == true);
+
+  // Both versions report to the same xApp
+  assert(advance_mem_harness(h, 10) == 1);
+  bool const ok = wait_mem_harness(pred_ind_rcv, NULL);
+  assert(ok == true && "Indications lost");
+
+  rm_report_sm_sync_xapp(xapp, ans_ag.u.handle);
+  rm_report_sm_sync_xapp(xapp, ans_other.u.handle);
+
+  rc = pthread_join(n->t, NULL);
+  assert(rc == 0);
+}
+
+static
+void test_teardown(mem_harness_t* h, other_node_t* n)
+{
+  close_mem_ep(n->ep);
+
+  // The nearRT-RIC learns the lost association
+  bool const ok = wait_mem_harness(pred_one_e2_node, h);
+  assert(ok == true);
+}
+
+int main()
+{
+  other_node_t n = {.id = {.type = ngran_gNB,
+                           .plmn = {.mcc = 505, .mnc = 1, .mnc_digit_len = 2},
+                           .nb_id.nb_id = 100}};
+  n.codec = load_codec(&n.handle);
+
+  mem_harness_args_t const args = {.num_ag = 1, 
+                                   .num_xapp = 1, 
+                                   .libs_dir = MEM_HARNESS_SM_DIR,
+                                   .ag_setup_cb = setup_other_node,
+                                   .ag_setup_data = &n};
+
+  mem_harness_t* h = init_mem_harness(&args);
+
+  test_setup(h, &n);
+  test_indication(h, &n);
+  test_teardown(h, &n);
+
+  free_mem_harness(h);
+  dlclose(n.handle);
+
+  printf("Success\n");
+  return EXIT_SUCCESS;
+}
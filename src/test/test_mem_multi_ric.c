@@ -0,0 +1,339 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+// An E2 Node connected to two nearRT-RICs. The nearRT-RIC of the harness
+// serves an xApp, while the test plays the second one, the canary, as the 
+// iApp of a nearRT-RIC is a process singleton. The canary only speaks 
+// E2AP: it accepts the E2 Setup, subscribes and counts the indications
+
+#include "mem_harness.h"
+#include "../lib/ep/e2ap_ep.h"
+#include "../ric/e2ap_ric.h"
+#include "../ric/plugin_ric.h"
+#include "../sm/mac_sm/mac_sm_id.h"
+
+#include <assert.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CANARY_ADDR "127.0.0.2"
+#define E2AP_PORT 36421
+// The first RIC Request ID of the nearRT-RIC of the harness, i.e., the 
+// same ID in both nearRT-RICs
+#define RIC_REQ_ID_10_MS 1021
+#define RIC_REQ_ID_5_MS 1022
+
+typedef struct{
+  e2ap_ep_t ep;
+  e2ap_ric_t ap;
+  plugin_ric_t plugin;
+  pthread_t t;
+  atomic_bool stop;
+
+  // The E2 Node, set with its E2 Setup
+  sctp_info_t node;
+  atomic_bool setup;
+
+  _Atomic uint64_t subs_resp;
+  _Atomic uint64_t subs_del_resp;
+  _Atomic uint64_t ind_10_ms;
+  _Atomic uint64_t ind_5_ms;
+} canary_ric_t;
+
+static
+_Atomic uint64_t ind_xapp;
+
+static
+void cb_mac(sm_ag_if_rd_t const* rd)
+{
+  assert(rd->type == INDICATION_MSG_AGENT_IF_ANS_V0);
+  assert(rd->ind.type == MAC_STATS_V0);
+
+  atomic_fetch_add(&ind_xapp, 1);
+  kick_mem_ep();
+}
+
+static
+e2_setup_response_t gen_setup_response(e2_setup_request_t const* req)
+{
+  e2_setup_response_t sr = {.id.plmn = req->id.plmn, 
+                            .id.near_ric_id.double_word = 26};
+
+  // Every RAN function accepted
+  sr.len_acc = req->len_rf;
+  sr.accepted = calloc(req->len_rf, sizeof(accepted_ran_function_t));
+  assert(sr.accepted != NULL && "Memory exhausted");
+  for(size_t i = 0; i < req->len_rf; ++i)
+    sr.accepted[i] = req->ran_func_item[i].id;
+
+#if defined(E2AP_V2) || defined(E2AP_V3)
+  sr.trans_id = req->trans_id;
+  sr.len_ccaa = req->len_cca;
+  sr.comp_config_add_ack = calloc(req->len_cca, sizeof(e2ap_node_comp_config_add_ack_t));
+  assert(sr.comp_config_add_ack != NULL && "Memory exhausted");
+  for(size_t i = 0; i < req->len_cca; ++i){
+    sr.comp_config_add_ack[i].e2_node_comp_interface_type = req->comp_conf_add[i].e2_node_comp_interface_type;
+    sr.comp_config_add_ack[i].e2_node_comp_id = cp_e2ap_node_comp_id(&req->comp_conf_add[i].e2_node_comp_id);
+    sr.comp_config_add_ack[i].e2_node_comp_conf_ack.outcome = SUCCESS_E2AP_NODE_COMP_CONF_ACK; 
+  }
+#endif
+
+  return sr;
+}
+
+static
+void send_canary(canary_ric_t* c, e2ap_msg_t* msg)
+{
+  byte_array_t ba = e2ap_msg_enc_ric(&c->ap, msg);
+  sctp_msg_t out = {.type = SCTP_MSG_PAYLOAD, .info = c->node, .ba = ba};
+  e2ap_send_sctp_msg(&c->ep, &out);
+  free_byte_array(ba);
+}
+
+static
+void handle_canary(canary_ric_t* c, sctp_msg_t const* in)
+{
+  e2ap_msg_t msg = e2ap_msg_dec_ric(&c->ap, in->ba);
+
+  if(msg.type == E2_SETUP_REQUEST){
+    c->node = in->info;
+    e2ap_msg_t ans = {.type = E2_SETUP_RESPONSE};
+    ans.u_msgs.e2_stp_resp = gen_setup_response(&msg.u_msgs.e2_stp_req);
+    send_canary(c, &ans);
+    e2ap_msg_free_ric(&c->ap, &ans);
+    atomic_store(&c->setup, true);
+  } else if(msg.type == RIC_SUBSCRIPTION_RESPONSE){
+    atomic_fetch_add(&c->subs_resp, 1);
+  } else if(msg.type == RIC_SUBSCRIPTION_DELETE_RESPONSE){
+    atomic_fetch_add(&c->subs_del_resp, 1);
+  } else if(msg.type == RIC_INDICATION){
+    // Its own RIC Request IDs, and not the ones of the E2 Node
+    uint32_t const id = msg.u_msgs.ric_ind.ric_id.ric_req_id;
+    assert(id == RIC_REQ_ID_10_MS || id == RIC_REQ_ID_5_MS);
+    atomic_fetch_add(id == RIC_REQ_ID_10_MS ? &c->ind_10_ms : &c->ind_5_ms, 1);
+  } else {
+    assert(0 != 0 && "Unexpected E2AP message at the canary");
+  }
+
+  e2ap_msg_free_ric(&c->ap, &msg);
+}
+
+// Polls, as a blocked receive holds the endpoint, and the test sends
+static
+void* start_canary(void* arg)
+{
+  canary_ric_t* c = (canary_ric_t*)arg;
+
+  struct pollfd pfd = {.fd = c->ep.fd, .events = POLLIN};
+  while(atomic_load(&c->stop) == false){
+    int const rc = poll(&pfd, 1, POLL_MEM_EP_MS);
+    assert(rc > -1);
+    if(rc == 0)
+      continue;
+
+    sctp_msg_t in = e2ap_recv_sctp_msg(&c->ep);
+    if(in.type == SCTP_MSG_PAYLOAD)
+      handle_canary(c, &in);
+    free_sctp_msg(&in);
+  }
+
+  return NULL;
+}
+
+static
+void init_canary(canary_ric_t* c)
+{
+  memset(c, 0, sizeof(*c));
+  e2ap_ep_init(&c->ep);
+  *(int*)&c->ep.fd = e2ap_ep_listen_mem(&c->ep, CANARY_ADDR, E2AP_PORT);
+  init_ap(&c->ap.base.type);
+  init_plugin_ric(&c->plugin, MEM_HARNESS_SM_DIR);
+
+  int const rc = pthread_create(&c->t, NULL, start_canary, c);
+  assert(rc == 0);
+}
+
+static
+void free_canary(canary_ric_t* c)
+{
+  atomic_store(&c->stop, true);
+  int const rc = pthread_join(c->t, NULL);
+  assert(rc == 0);
+
+  free_plugin_ric(&c->plugin);
+  e2ap_ep_free(&c->ep);
+}
+
+static
+void subscribe_canary(canary_ric_t* c, uint32_t ric_req_id, char* period)
+{
+  sm_ric_t* sm = sm_plugin_ric(&c->plugin, SM_MAC_ID);
+  sm_subs_data_t data = sm->proc.on_subscription(sm, period);
+
+  ric_action_t act = {.id = 0, .type = RIC_ACT_REPORT};
+  byte_array_t ad = {.buf = data.action_def, .len = data.len_ad};
+  if(data.action_def != NULL)
+    act.definition = &ad;
+
+  e2ap_msg_t msg = {.type = RIC_SUBSCRIPTION_REQUEST};
+  ric_subscription_request_t* sr = &msg.u_msgs.ric_sub_req;
+  sr->ric_id = (ric_gen_id_t){.ric_req_id = ric_req_id, .ran_func_id = SM_MAC_ID};
+  sr->event_trigger = (byte_array_t){.buf = data.event_trigger, .len = data.len_et};
+  sr->len_action = 1;
+  sr->action = &act;
+
+  send_canary(c, &msg);
+  free(data.event_trigger);
+  free(data.action_def);
+}
+
+static
+void rm_subscription_canary(canary_ric_t* c, uint32_t ric_req_id)
+{
+  e2ap_msg_t msg = {.type = RIC_SUBSCRIPTION_DELETE_REQUEST};
+  msg.u_msgs.ric_sub_del_req.ric_id = (ric_gen_id_t){.ric_req_id = ric_req_id, .ran_func_id = SM_MAC_ID};
+  send_canary(c, &msg);
+}
+
+/////////////////
+// Predicates
+/////////////////
+
+static
+bool pred_setup(void* arg)
+{
+  return atomic_load(&((canary_ric_t*)arg)->setup);
+}
+
+static
+bool pred_eq(void* arg)
+{
+  _Atomic uint64_t** p = (_Atomic uint64_t**)arg; 
+  return atomic_load(p[0]) == atomic_load(p[1]);
+}
+
+typedef struct{
+  canary_ric_t* c;
+  uint64_t xapp;
+  uint64_t ind_10_ms;
+  uint64_t ind_5_ms;
+} expected_t;
+
+static
+bool pred_expected(void* arg)
+{
+  expected_t const* e = (expected_t const*)arg;
+  return atomic_load(&ind_xapp) == e->xapp
+      && atomic_load(&e->c->ind_10_ms) == e->ind_10_ms
+      && atomic_load(&e->c->ind_5_ms) == e->ind_5_ms;
+}
+
+static
+void step(mem_harness_t* h, expected_t* e, bool xapp, bool c_10_ms, bool c_5_ms, uint64_t fired)
+{
+  uint64_t const read = ind_read_mem_harness();
+  assert(advance_mem_harness(h, 5) == fired);
+
+  e->xapp += xapp;
+  e->ind_10_ms += c_10_ms;
+  e->ind_5_ms += c_5_ms;
+  bool const ok = wait_mem_harness(pred_expected, e);
+  assert(ok == true && "Indications lost");
+  // The SM reads once per expired timer, whatever the nearRT-RICs 
+  assert(ind_read_mem_harness() == read + fired);
+}
+
+int main()
+{
+  // Shared with the harness. Before any endpoint
+  init_mem_ep();
+
+  canary_ric_t c; 
+  init_canary(&c);
+
+  mem_harness_args_t const args = {.num_ag = 1, 
+                                   .num_xapp = 1, 
+                                   .num_extra_ric = 1,
+                                   .libs_dir = MEM_HARNESS_SM_DIR};
+
+  mem_harness_t* h = init_mem_harness(&args);
+
+  // E2 Setup with both nearRT-RICs
+  bool ok = wait_mem_harness(pred_setup, &c);
+  assert(ok == true && "E2 Setup with the canary timed out");
+
+  // Same subscription, i.e., one timer 
+  global_e2_node_id_t id = ag_id_mem_harness(h, 0);
+  sm_ans_xapp_t const ans = report_sm_sync_xapp(xapp_mem_harness(h, 0), &id, SM_MAC_ID, "10_ms", NULL, NULL, cb_mac);
+  assert(ans.success == true);
+
+  uint64_t one = 1;
+  _Atomic uint64_t* p[2] = {&c.subs_resp, (_Atomic uint64_t*)&one};
+  subscribe_canary(&c, RIC_REQ_ID_10_MS, "10_ms");
+  ok = wait_mem_harness(pred_eq, p);
+  assert(ok == true);
+
+  expected_t e = {.c = &c};
+  for(int k = 0; k < 10; ++k)
+    step(h, &e, k % 2 == 1, k % 2 == 1, false, k % 2);
+
+  // A different period, i.e., its own timer
+  uint64_t two = 2;
+  p[1] = (_Atomic uint64_t*)&two;
+  subscribe_canary(&c, RIC_REQ_ID_5_MS, "5_ms");
+  ok = wait_mem_harness(pred_eq, p);
+  assert(ok == true);
+
+  for(int k = 0; k < 10; ++k)
+    step(h, &e, k % 2 == 1, k % 2 == 1, true, 1 + k % 2);
+
+  // The xApp keeps its indications, through the shared timer
+  p[0] = &c.subs_del_resp;
+  p[1] = (_Atomic uint64_t*)&one;
+  rm_subscription_canary(&c, RIC_REQ_ID_10_MS);
+  ok = wait_mem_harness(pred_eq, p);
+  assert(ok == true);
+
+  for(int k = 0; k < 10; ++k)
+    step(h, &e, k % 2 == 1, false, true, 1 + k % 2);
+
+  p[1] = (_Atomic uint64_t*)&two;
+  rm_subscription_canary(&c, RIC_REQ_ID_5_MS);
+  ok = wait_mem_harness(pred_eq, p);
+  assert(ok == true);
+
+  for(int k = 0; k < 10; ++k)
+    step(h, &e, k % 2 == 1, false, false, k % 2);
+
+  rm_report_sm_sync_xapp(xapp_mem_harness(h, 0), ans.u.handle);
+  assert(advance_mem_harness(h, 20) == 0);
+
+  free_mem_harness(h);
+  free_canary(&c);
+  free_mem_ep();
+
+  printf("Success\n");
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,162 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+// Many E2 Nodes and an xApp against a nearRT-RIC that restarts. They set 
+// up again with exponential backoff and full jitter, see util/backoff.h, 
+// i.e., not in lockstep, and report the connection state changes
+
+#include "mem_harness.h"
+#include "../util/time_now_us.h"
+
+#include <assert.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NUM_AG 64
+#define NUM_XAPP 1
+#define BASE_MS 20
+#define MAX_MS 500
+#define STR_(x) #x
+#define STR(x) STR_(x)
+
+static
+_Atomic uint64_t num_state[END_CONN_STATE];
+
+// Wall-clock of the E2 and E42 Setup Responses after the restart
+static
+_Atomic int64_t first_conn_us;
+
+static
+_Atomic int64_t last_conn_us;
+
+static
+void conn_cb(char const* addr, conn_state_e state, void* data)
+{
+  assert(addr != NULL && strcmp(addr, "127.0.0.1") == 0);
+  assert(state < END_CONN_STATE);
+  assert(data == num_state);
+
+  if(state == CONNECTED_CONN_STATE){
+    int64_t const now = time_now_us();
+    int64_t zero = 0;
+    atomic_compare_exchange_strong(&first_conn_us, &zero, now);
+    atomic_store(&last_conn_us, now);
+  }
+
+  atomic_fetch_add(&num_state[state], 1);
+  kick_mem_ep();
+}
+
+static
+bool pred_assoc(void* arg)
+{
+  for(size_t i = 0; i < NUM_AG; ++i){
+    if(assoc_ag_mem_harness(arg, i) == false)
+      return false;
+  }
+  return connected_e42_xapp(xapp_mem_harness(arg, 0));
+}
+
+static
+bool pred_connected(void* arg)
+{
+  return atomic_load(&num_state[CONNECTED_CONN_STATE]) == *(uint64_t*)arg;
+}
+
+static
+void test_restart(mem_harness_t* h)
+{
+  // Set up before the restart
+  uint64_t const conn = atomic_load(&num_state[CONNECTED_CONN_STATE]);
+  uint64_t const disconn = atomic_load(&num_state[DISCONNECTED_CONN_STATE]);
+  uint64_t const retries = atomic_load(&num_state[RETRY_CONN_STATE]);
+  assert(conn == disconn + NUM_AG + NUM_XAPP);
+
+  atomic_store(&first_conn_us, 0);
+  int64_t const start = time_now_us();
+  restart_ric_mem_harness(h);
+
+  // The associations are lost at the same instant
+  uint64_t expected = conn + NUM_AG + NUM_XAPP;
+  bool ok = wait_mem_harness(pred_connected, &expected);
+  assert(ok == true && "E2 and E42 Setup timed out after the restart");
+  ok = wait_mem_harness(pred_assoc, h);
+  assert(ok == true);
+
+  assert(atomic_load(&num_state[DISCONNECTED_CONN_STATE]) == disconn + NUM_AG + NUM_XAPP);
+  assert(num_e2_nodes_mem_harness(h) == NUM_AG);
+
+  // In lockstep, they all would set up within the same ms
+  int64_t const spread_ms = (atomic_load(&last_conn_us) - atomic_load(&first_conn_us)) / 1000;
+  printf("Restart: %lu retries, setup again in %ld ms, spread over %ld ms\n",
+         atomic_load(&num_state[RETRY_CONN_STATE]) - retries,
+         (atomic_load(&last_conn_us) - start) / 1000,
+         spread_ms);
+  assert(spread_ms >= BASE_MS / 4);
+}
+
+static
+bool pred_retries(void* arg)
+{
+  return atomic_load(&num_state[RETRY_CONN_STATE]) >= *(uint64_t*)arg;
+}
+
+// Without E2 Nodes, e.g., they have not set up again yet, the E42 SETUP-REQUEST 
+// is not answered, as the E42 SETUP-RESPONSE carries at least one. The xApp 
+// keeps on retrying with backoff
+static
+void test_no_e2_node(mem_harness_t* h)
+{
+  for(size_t i = 0; i < NUM_AG; ++i)
+    stop_ag_mem_harness(h, i);
+  restart_ric_mem_harness(h);
+
+  uint64_t expected = atomic_load(&num_state[RETRY_CONN_STATE]) + 3;
+  bool const ok = wait_mem_harness(pred_retries, &expected);
+  assert(ok == true && "The xApp stopped retrying");
+
+  assert(num_e2_nodes_mem_harness(h) == 0);
+  assert(connected_e42_xapp(xapp_mem_harness(h, 0)) == false);
+}
+
+int main()
+{
+  mem_harness_args_t const args = {.num_ag = NUM_AG, 
+                                   .num_xapp = NUM_XAPP, 
+                                   .libs_dir = MEM_HARNESS_SM_DIR,
+                                   .backoff = "base=" STR(BASE_MS) ";max=" STR(MAX_MS),
+                                   .conn_cb = conn_cb,
+                                   .conn_data = num_state};
+
+  mem_harness_t* h = init_mem_harness(&args);
+
+  test_restart(h);
+  // Twice, as the backoff starts again
+  test_restart(h);
+  test_no_e2_node(h);
+
+  free_mem_harness(h);
+
+  printf("Success\n");
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,148 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+
+// A slow xApp does not grow its indication queue without bound. The 
+// dispatcher of the xApp keeps at most the depth of the overload policy of 
+// the subscription, see xApp/msg_dispatcher_xapp.h, and drops the rest, 
+// while the callback is stuck
+
+#include "mem_harness.h"
+#include "../sm/mac_sm/mac_sm_id.h"
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define PERIOD_MS 10
+#define NUM_PERIODS 20
+#define DEPTH 4
+
+static
+pthread_mutex_t mtx = PTHREAD_MUTEX_INITIALIZER;
+
+static
+pthread_cond_t cv = PTHREAD_COND_INITIALIZER;
+
+static
+bool stuck = true;
+
+static
+_Atomic uint64_t ind_rcv;
+
+static
+void cb_slow_mac(sm_ag_if_rd_t const* rd)
+{
+  assert(rd->type == INDICATION_MSG_AGENT_IF_ANS_V0);
+  assert(rd->ind.type == MAC_STATS_V0);
+
+  pthread_mutex_lock(&mtx);
+  while(stuck)
+    pthread_cond_wait(&cv, &mtx);
+  pthread_mutex_unlock(&mtx);
+
+  atomic_fetch_add(&ind_rcv, 1);
+  kick_mem_ep();
+}
+
+typedef struct{
+  e42_xapp_t* xapp;
+  uint32_t ric_req_id;
+  uint64_t ind_in;
+} sub_t;
+
+static
+bool pred_ind_in(void* arg)
+{
+  sub_t* s = (sub_t*)arg;
+  dispatch_stats_t st = {0};
+  bool const ok = stats_msg_dispatcher(&s->xapp->msg_disp, s->ric_req_id, &st);
+  assert(ok == true);
+  return st.ind_in == s->ind_in;
+}
+
+static
+bool pred_ind_rcv(void* arg)
+{
+  return atomic_load(&ind_rcv) == *(uint64_t*)arg;
+}
+
+static
+void test_slow_xapp(mem_harness_t* h)
+{
+  char period[] = "10_ms";
+  char const overload[] = "policy=drop_oldest;depth=4";
+
+  e42_xapp_t* xapp = xapp_mem_harness(h, 0);
+  global_e2_node_id_t id = ag_id_mem_harness(h, 0);
+  sm_ans_xapp_t const ans = report_sm_sync_xapp(xapp, &id, SM_MAC_ID, period, NULL, overload, cb_slow_mac);
+  assert(ans.success == true);
+
+  // The first indication blocks the callback, the rest queue up 
+  sub_t s = {.xapp = xapp, .ric_req_id = ans.u.handle};
+  bool ok = false;
+  for(uint64_t k = 1; k <= NUM_PERIODS; ++k){
+    uint64_t const fired = advance_mem_harness(h, PERIOD_MS);
+    assert(fired == 1);
+
+    s.ind_in = k;
+    ok = wait_mem_harness(pred_ind_in, &s);
+    assert(ok == true);
+  }
+
+  dispatch_stats_t st = {0};
+  ok = stats_msg_dispatcher(&xapp->msg_disp, s.ric_req_id, &st);
+  assert(ok == true);
+  assert(st.queued == DEPTH && "Queue not bounded");
+  assert(st.dropped == NUM_PERIODS - 1 - DEPTH);
+  assert(atomic_load(&ind_rcv) == 0);
+
+  // The callback catches up with the queued indications only
+  pthread_mutex_lock(&mtx);
+  stuck = false;
+  pthread_cond_broadcast(&cv);
+  pthread_mutex_unlock(&mtx);
+
+  uint64_t expected = 1 + DEPTH;
+  ok = wait_mem_harness(pred_ind_rcv, &expected);
+  assert(ok == true);
+
+  rm_report_sm_sync_xapp(xapp, ans.u.handle);
+  assert(size_msg_dispatcher(&xapp->msg_disp) == 0);
+}
+
+int main()
+{
+  mem_harness_args_t const args = {.num_ag = 1, 
+                                   .num_xapp = 1, 
+                                   .libs_dir = MEM_HARNESS_SM_DIR};
+
+  mem_harness_t* h = init_mem_harness(&args);
+
+  test_slow_xapp(h);
+
+  free_mem_harness(h);
+
+  printf("Success\n");
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,207 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+// A well-formed PDU of a procedure that FlexRIC does not implement, i.e., 
+// an E2 Removal Request, reaches the nearRT-RIC from an E2 Node, the iApp
+// from an xApp and an E2 Agent from a second nearRT-RIC. Each one discards 
+// it and keeps serving the others. The test plays the E2 Node, the xApp 
+// and the second nearRT-RIC through raw endpoints
+
+#include "mem_harness.h"
+#include "../lib/e2ap/e2ap_msg_enc_generic_wrapper.h"
+#include "../lib/ep/mem_ep.h"
+#include "../sm/mac_sm/mac_sm_id.h"
+
+#include <assert.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define RIC_ADDR "127.0.0.1"
+// The extra nearRT-RIC of the E2 Agent, i.e., num_extra_ric = 1
+#define PEER_RIC_ADDR "127.0.0.2"
+#define E2AP_PORT 36421
+#define E42AP_PORT 36422
+
+static
+_Atomic uint64_t ind_rcv;
+
+static
+void cb_mac(sm_ag_if_rd_t const* rd)
+{
+  assert(rd->type == INDICATION_MSG_AGENT_IF_ANS_V0);
+  assert(rd->ind.type == MAC_STATS_V0);
+
+  atomic_fetch_add(&ind_rcv, 1);
+  kick_mem_ep();
+}
+
+// Never answers the E2 Setup of the E2 Agent, so it keeps retrying
+typedef struct{
+  mem_ep_t* ep;
+  pthread_t t;
+  atomic_bool stop;
+
+  // The E2 Agent, set with its first E2 Setup
+  struct sockaddr_in ag;
+  atomic_bool setup;
+} peer_ric_t;
+
+// Polls, as a blocked receive holds the endpoint, and the test sends
+static
+void* start_peer_ric(void* arg)
+{
+  peer_ric_t* p = (peer_ric_t*)arg;
+
+  struct pollfd pfd = {.fd = fd_mem_ep(p->ep), .events = POLLIN};
+  while(atomic_load(&p->stop) == false){
+    int const rc = poll(&pfd, 1, POLL_MEM_EP_MS);
+    assert(rc > -1);
+    if(rc == 0)
+      continue;
+
+    mem_ep_msg_t rcv = recv_mem_ep(p->ep);
+    if(rcv.eof == false && atomic_load(&p->setup) == false){
+      p->ag = rcv.peer;
+      atomic_store(&p->setup, true);
+    }
+    free_mem_ep_msg(&rcv);
+  }
+
+  return NULL;
+}
+
+static
+bool pred_setup(void* arg)
+{
+  return atomic_load(&((peer_ric_t*)arg)->setup);
+}
+
+static
+bool pred_true(void* arg)
+{
+  (void)arg;
+  return true;
+}
+
+static
+bool pred_ind_rcv(void* arg)
+{
+  return atomic_load(&ind_rcv) == *(uint64_t*)arg;
+}
+
+static
+byte_array_t gen_unsupported_pdu(void)
+{
+  e2_removal_request_t const rr = {.trans_id = 1};
+  return e2ap_enc_removal_request_asn(&rr);
+}
+
+static
+void test_unsupported(mem_harness_t* h, peer_ric_t* p, mem_ep_t* node, mem_ep_t* xapp)
+{
+  byte_array_t ba = gen_unsupported_pdu();
+
+  // E2 Node -> nearRT-RIC
+  bool ok = send_mem_ep(node, NULL, 0, 0, ba);
+  assert(ok == true);
+
+  // xApp -> iApp
+  ok = send_mem_ep(xapp, NULL, 0, 0, ba);
+  assert(ok == true);
+
+  // nearRT-RIC -> E2 Agent
+  ok = wait_mem_harness(pred_setup, p);
+  assert(ok == true && "E2 Setup with the second nearRT-RIC not sent");
+  ok = send_mem_ep(p->ep, &p->ag, 0, 0, ba);
+  assert(ok == true);
+
+  free_byte_array(ba);
+
+  // Delivered, and discarded, i.e., not registered as an E2 Node
+  ok = wait_mem_harness(pred_true, NULL);
+  assert(ok == true);
+  assert(num_e2_nodes_mem_harness(h) == 1);
+}
+
+// The nearRT-RIC, the iApp and the E2 Agent still serve the xApp of the harness
+static
+void test_still_serving(mem_harness_t* h)
+{
+  char period[] = "10_ms";
+  e42_xapp_t* xapp = xapp_mem_harness(h, 0);
+
+  global_e2_node_id_t id = ag_id_mem_harness(h, 0);
+  sm_ans_xapp_t const ans = report_sm_sync_xapp(xapp, &id, SM_MAC_ID, period, NULL, NULL, cb_mac);
+  assert(ans.success == true);
+
+  assert(advance_mem_harness(h, 10) == 1);
+  uint64_t one = 1;
+  bool const ok = wait_mem_harness(pred_ind_rcv, &one);
+  assert(ok == true && "Indications lost");
+
+  rm_report_sm_sync_xapp(xapp, ans.u.handle);
+}
+
+int main()
+{
+  // Shared with the harness. Before any endpoint
+  init_mem_ep();
+
+  peer_ric_t p = {.ep = listen_mem_ep(PEER_RIC_ADDR, E2AP_PORT)};
+  assert(p.ep != NULL);
+  int rc = pthread_create(&p.t, NULL, start_peer_ric, &p);
+  assert(rc == 0);
+
+  mem_harness_args_t const args = {.num_ag = 1, 
+                                   .num_xapp = 1, 
+                                   .num_extra_ric = 1,
+                                   .libs_dir = MEM_HARNESS_SM_DIR};
+
+  mem_harness_t* h = init_mem_harness(&args);
+
+  mem_ep_t* node = connect_mem_ep(RIC_ADDR, E2AP_PORT);
+  assert(node != NULL);
+  mem_ep_t* xapp = connect_mem_ep(RIC_ADDR, E42AP_PORT);
+  assert(xapp != NULL);
+
+  test_unsupported(h, &p, node, xapp);
+  test_still_serving(h);
+
+  free_mem_harness(h);
+
+  // After the harness, as the nearRT-RIC and the iApp expect the 
+  // associations they close to have set up
+  close_mem_ep(node);
+  close_mem_ep(xapp);
+
+  atomic_store(&p.stop, true);
+  rc = pthread_join(p.t, NULL);
+  assert(rc == 0);
+  close_mem_ep(p.ep);
+
+  free_mem_ep();
+
+  printf("Success\n");
+  return EXIT_SUCCESS;
+}
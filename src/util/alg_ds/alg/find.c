@@ -150,7 +150,7 @@ bmr_iter_t find_if_bi_map_right(bi_map_t* map, bmr_iter_t start_it, bmr_iter_t e
   assert(start_it.it != NULL);
 
   while(start_it.it != end_it.it){
-    if(f(value, start_it.it) == true)
+    if(f(value, assoc_key(&map->right, start_it.it)) == true)
       return start_it;
 
     start_it = bi_map_next_right(map, start_it);
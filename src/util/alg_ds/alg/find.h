@@ -47,7 +47,7 @@ void* find_if_deque(const seq_deque_t* arr, void* start_it, void* end_it, void*
 void* find_if_ring(seq_ring_t* arr, void* start_it, void* end_it, void* value , bool(*f)(const void*, const void*));
 
 
-// Associative containers
+// Associative containers. f(value, key) is called with the key of every element
 
 void* find_if_rb_tree(assoc_rb_tree_t* tree, void* start_it, void* end_it, void const* value, bool(*f)(const void*, const void*)); 
 
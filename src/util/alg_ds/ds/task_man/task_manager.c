@@ -269,10 +269,15 @@ void seq_ring_swap(seq_ring_t* cb, void* it_1, void* it_2)
 //////////////////////////////////////////////
 //////////////////////////////////////////////
 
+// Batch size of the lanes other than 0. Small, so that a worker comes back
+// soon to check whether higher priority tasks arrived meanwhile
+#define LOW_PRIO_BATCH 16
+
 typedef struct {
   pthread_mutex_t mtx;
   pthread_cond_t cv;
-  seq_ring_t r;
+  seq_ring_t r[TASK_MAN_NUM_PRIO];
+  uint32_t skip[TASK_MAN_NUM_PRIO];
   int done;
 } not_q_t;
 
@@ -288,7 +293,10 @@ void init_not_q(not_q_t* q)
   assert(q != NULL);
 
   q->done = 0;
-  seq_ring_init(&q->r, sizeof(task_t));
+  for(int i = 0; i < TASK_MAN_NUM_PRIO; ++i){
+    seq_ring_init(&q->r[i], sizeof(task_t));
+    q->skip[i] = 0;
+  }
 
   pthread_mutexattr_t attr = {0};
 #ifdef _DEBUG
@@ -309,7 +317,8 @@ void free_not_q(not_q_t* q, void (*clean)(void*) )
   assert(q != NULL);
   assert(q->done == 1);
 
-  seq_ring_free(&q->r, clean);
+  for(int i = 0; i < TASK_MAN_NUM_PRIO; ++i)
+    seq_ring_free(&q->r[i], clean);
 
   int rc = pthread_mutex_destroy(&q->mtx);
   assert(rc == 0);
@@ -319,17 +328,77 @@ void free_not_q(not_q_t* q, void (*clean)(void*) )
 }
 
 static
-bool try_push_not_q(not_q_t* q, task_t t)
+size_t size_not_q(not_q_t* q)
+{
+  size_t sz = 0;
+  for(int i = 0; i < TASK_MAN_NUM_PRIO; ++i)
+    sz += seq_ring_size(&q->r[i]);
+  return sz;
+}
+
+// The highest non-empty lane, unless a lower one waited too long
+static
+int select_lane_not_q(not_q_t* q)
+{
+  int lane = -1;
+  for(int i = 0; i < TASK_MAN_NUM_PRIO; ++i){
+    if(seq_ring_size(&q->r[i]) == 0)
+      continue;
+
+    if(lane == -1){
+      lane = i;
+    } else if(q->skip[i] >= TASK_MAN_MAX_SKIP){
+      lane = i;
+      break;
+    }
+  }
+  assert(lane != -1);
+
+  for(int i = 0; i < TASK_MAN_NUM_PRIO; ++i){
+    if(i == lane)
+      q->skip[i] = 0;
+    else if(seq_ring_size(&q->r[i]) > 0)
+      q->skip[i] += 1;
+  }
+
+  return lane;
+}
+
+// Moves a batch of tasks of a single lane to out. The mutex must be held
+static
+void batch_not_q(not_q_t* q, ret_try_t* out)
+{
+  int const lane = select_lane_not_q(q);
+  seq_ring_t* r = &q->r[lane];
+
+  size_t const max_batch = lane == 0 ? 4096 : LOW_PRIO_BATCH;
+  size_t const sz = seq_ring_size(r); 
+
+  out->len = sz < max_batch ? sz : max_batch;
+  for(int i = 0; i < out->len; ++i){
+    void* it = seq_ring_at(r, i);
+    assert(it != seq_ring_end(r));
+    memcpy(&out->t[i], it, sizeof(task_t)); 
+  }
+
+  seq_ring_erase(r, seq_ring_front(r), seq_ring_at(r, out->len));
+
+  assert(sz == out->len + seq_ring_size(r)); 
+}
+
+static
+bool try_push_not_q(not_q_t* q, task_t t, uint32_t prio)
 {
   assert(q != NULL);
   assert(q->done == 0 || q->done ==1);
   assert(t.func != NULL);
   assert(t.args != NULL);
+  assert(prio < TASK_MAN_NUM_PRIO);
 
   if(pthread_mutex_trylock(&q->mtx ) != 0)
     return false;
 
-  seq_ring_push_back(&q->r, (uint8_t*)&t, sizeof(task_t));
+  seq_ring_push_back(&q->r[prio], (uint8_t*)&t, sizeof(task_t));
 
   int rc = pthread_mutex_unlock(&q->mtx);
   assert(rc == 0);
@@ -340,17 +409,18 @@ bool try_push_not_q(not_q_t* q, task_t t)
 }
 
 static
-void push_not_q(not_q_t* q, task_t t)
+void push_not_q(not_q_t* q, task_t t, uint32_t prio)
 {
   assert(q != NULL);
   assert(q->done == 0 || q->done ==1);
   assert(t.func != NULL);
   //assert(t.args != NULL);
+  assert(prio < TASK_MAN_NUM_PRIO);
 
   int rc = pthread_mutex_lock(&q->mtx);
   assert(rc == 0);
 
-  seq_ring_push_back(&q->r, (void*)&t, sizeof(task_t));
+  seq_ring_push_back(&q->r[prio], (void*)&t, sizeof(task_t));
 
   pthread_mutex_unlock(&q->mtx);
 
@@ -372,7 +442,7 @@ ret_try_t try_pop_not_q(not_q_t* q)
 
   assert(q->done == 0 || q->done ==1);
 
-  size_t sz = seq_ring_size(&q->r); 
+  size_t sz = size_not_q(q); 
   if(sz == 0){
     rc = pthread_mutex_unlock(&q->mtx);
     assert(rc == 0);
@@ -380,22 +450,7 @@ ret_try_t try_pop_not_q(not_q_t* q)
     return ret;
   }
 
-  ret.len = sz < 4096 ? sz : 4096;
-  for(int i = 0; i < ret.len; ++i){
-  void* it = seq_ring_at(&q->r, i);
-    memcpy(&ret.t[i], it, sizeof(task_t)); 
-  }
-
-//   void* it = seq_ring_front(&q->r);
-//    assert(it != seq_ring_end(&q->r));
-//    memcpy(&ret.t, it, sizeof(task_t)); 
-
-  seq_ring_erase(&q->r, seq_ring_front(&q->r), seq_ring_at(&q->r, ret.len) );
-
-
-//  seq_ring_move(&q->r, seq_ring_front(&q->r), seq_ring_at(&q->r, ret.len), ret.t);
-
-  assert(sz == ret.len + seq_ring_size(&q->r)); 
+  batch_not_q(q, &ret);
 
   rc = pthread_mutex_unlock(&q->mtx);
   assert(rc == 0);
@@ -413,7 +468,7 @@ bool pop_not_q(not_q_t* q, ret_try_t* out)
   pthread_mutex_lock(&q->mtx);
   assert(q->done == 0 || q->done ==1);
 
-  while(seq_ring_size(&q->r) == 0 && q->done == 0)
+  while(size_not_q(q) == 0 && q->done == 0)
     pthread_cond_wait(&q->cv , &q->mtx);
 
   if(q->done == 1){
@@ -422,22 +477,7 @@ bool pop_not_q(not_q_t* q, ret_try_t* out)
     return false;
   }
 
-  const size_t sz =  seq_ring_size(&q->r);
-
-  out->len = sz < 4096 ? sz : 4096; 
-  for(int i =0; i < out->len; ++i){
-     void* it = seq_ring_at(&q->r, i);
-    assert(it != seq_ring_end(&q->r));
-    memcpy(&out->t[i], it, sizeof(task_t)); 
-  }
-
-//   void* it = seq_ring_at(&q->r, 0);
-//    assert(it != seq_ring_end(&q->r));
-//    memcpy(&out->t, it, sizeof(task_t)); 
-
-  seq_ring_erase(&q->r, seq_ring_front(&q->r), seq_ring_at(&q->r, out->len));
-
-//  seq_ring_move(&q->r, seq_ring_front(&q->r), seq_ring_at(&q->r, out->len), out->t);
+  batch_not_q(q, out);
 
 
   int rc = pthread_mutex_unlock(&q->mtx);
@@ -566,25 +606,32 @@ void free_task_manager(task_manager_t* man, void (*clean)(void*))
   free(man->t_arr);
 }
 
-void async_task_manager(task_manager_t* man, task_t t)
+void async_prio_task_manager(task_manager_t* man, task_t t, uint32_t prio)
 {
   assert(man != NULL);
   assert(man->len_thr > 0);
   assert(t.func != NULL);
   //assert(t.args != NULL);
+  assert(prio < TASK_MAN_NUM_PRIO);
 
   uint64_t const index = man->index++;
 //  atomic_fetch_add_explicit(&man->index, 1, memory_order_relaxed);
 
   not_q_t* q_arr = (not_q_t*)man->q_arr;
   for(uint32_t i = 0; i < man->len_thr; ++i){
-    if(try_push_not_q(&q_arr[(i+index) % man->len_thr], t)){
+    if(try_push_not_q(&q_arr[(i+index) % man->len_thr], t, prio)){
       return;
     }
   }
 
-  push_not_q(&q_arr[index%man->len_thr], t);
+  push_not_q(&q_arr[index%man->len_thr], t, prio);
+}
+
+void async_task_manager(task_manager_t* man, task_t t)
+{
+  async_prio_task_manager(man, t, 0);
 }
 
-#undef DEFAULT_ELM 
+#undef DEFAULT_ELM
+#undef LOW_PRIO_BATCH 
 
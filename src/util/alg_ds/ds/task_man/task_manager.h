@@ -45,7 +45,15 @@ void init_task_manager(task_manager_t* man, uint32_t num_threads);
 
 void free_task_manager(task_manager_t* man, void (*clean)(void* args) );
 
+// Priority lanes. Lane 0 is the highest and the one used by async_task_manager.
+// A lower lane is served when the higher ones are empty, or after it has
+// waited TASK_MAN_MAX_SKIP batches, so that it does not starve
+#define TASK_MAN_NUM_PRIO 3
+#define TASK_MAN_MAX_SKIP 16
+
 void async_task_manager(task_manager_t* man, task_t t);
 
+void async_prio_task_manager(task_manager_t* man, task_t t, uint32_t prio);
+
 #endif
 
@@ -0,0 +1,123 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+#include "backoff.h"
+#include "conf_file.h"
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+static
+unsigned init_seed(backoff_t const* b)
+{
+  struct timespec ts = {0};
+  int const rc = clock_gettime(CLOCK_MONOTONIC, &ts);
+  assert(rc == 0);
+
+  // Many E2 Nodes may start in the same process, e.g., emulated gNBs
+  uintptr_t const addr = (uintptr_t)b;
+  return (unsigned)(ts.tv_nsec ^ ts.tv_sec ^ (addr >> 4) ^ ((uintptr_t)getpid() << 16));
+}
+
+void init_backoff(backoff_t* b, int64_t base_ms, int64_t max_ms)
+{
+  assert(b != NULL);
+  assert(base_ms > 0);
+  assert(max_ms >= base_ms);
+
+  b->base_ms = base_ms;
+  b->max_ms = max_ms;
+  b->attempt = 0;
+  b->seed = init_seed(b);
+}
+
+typedef struct{
+  long long base_ms;
+  long long max_ms;
+} backoff_conf_t;
+
+static
+bool parse_opt(char* key, char* val, void* data)
+{
+  backoff_conf_t* c = (backoff_conf_t*)data;
+
+  if(strcmp(key, "base") == 0)
+    return parse_num_conf(val, 1, INT32_MAX, &c->base_ms);
+  if(strcmp(key, "max") == 0)
+    return parse_num_conf(val, 1, INT32_MAX, &c->max_ms);
+
+  return false;
+}
+
+void init_conf_backoff(backoff_t* b, char const* conf)
+{
+  assert(b != NULL);
+
+  backoff_conf_t c = {.base_ms = BASE_MS_BACKOFF, .max_ms = MAX_MS_BACKOFF};
+  if(conf != NULL){
+    bool const ok = parse_kv_conf(strlen(conf), conf, parse_opt, &c);
+    if(ok == false || c.max_ms < c.base_ms){
+      printf("[BACKOFF]: Malformed RECONNECT_BACKOFF = %s\n", conf);
+      assert(0 != 0 && "Malformed RECONNECT_BACKOFF");
+    }
+  }
+
+  init_backoff(b, c.base_ms, c.max_ms);
+}
+
+int64_t next_backoff(backoff_t* b)
+{
+  assert(b != NULL);
+  assert(b->base_ms > 0);
+
+  // min(max_ms, base_ms * 2^attempt) without overflowing
+  int64_t ceil_ms = b->base_ms;
+  for(uint32_t i = 0; i < b->attempt && ceil_ms < b->max_ms; ++i)
+    ceil_ms *= 2;
+  if(ceil_ms > b->max_ms)
+    ceil_ms = b->max_ms;
+
+  // Once at the cap, the attempts do not need to grow further
+  if(ceil_ms < b->max_ms)
+    b->attempt += 1;
+
+  // Full jitter. RAND_MAX is at least 2^15-1, i.e., combine two draws 
+  int64_t const floor_ms = floor_backoff(b);
+  uint64_t const r = ((uint64_t)rand_r(&b->seed) << 31) ^ (uint64_t)rand_r(&b->seed);
+  return floor_ms + (int64_t)(r % (uint64_t)(ceil_ms - floor_ms + 1));
+}
+
+int64_t floor_backoff(backoff_t const* b)
+{
+  assert(b != NULL);
+  return b->base_ms / 4 > 0 ? b->base_ms / 4 : 1;
+}
+
+void reset_backoff(backoff_t* b)
+{
+  assert(b != NULL);
+  b->attempt = 0;
+}
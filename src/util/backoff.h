@@ -0,0 +1,65 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+#ifndef BACKOFF_H
+#define BACKOFF_H
+
+// Exponential backoff with full jitter of the E2 and E42 Setup retries. The
+// n-th retry waits a uniform time in [base_ms/4, min(max_ms, base_ms * 2^n)]
+// ms, so that the peers that lost the connection at the same instant, e.g., 
+// the nearRT-RIC restarted, do not set up again in lockstep. The floor is the 
+// time a Setup Response has to arrive, as a retry also times out the previous 
+// request and the nearRT-RIC drops the subscriptions of an E2 Node that sets 
+// up twice
+
+#include <stdint.h>
+
+// RECONNECT_BACKOFF key absent
+#define BASE_MS_BACKOFF 1000
+#define MAX_MS_BACKOFF 30000
+
+typedef struct{
+  int64_t base_ms;
+  int64_t max_ms;
+  // Retries since the last reset 
+  uint32_t attempt;
+  // rand_r() state. Different per instance and process
+  unsigned seed;
+} backoff_t;
+
+void init_backoff(backoff_t* b, int64_t base_ms, int64_t max_ms);
+
+// conf, i.e., the options of the RECONNECT_BACKOFF key, e.g., 
+// RECONNECT_BACKOFF = base=500;max=10000. Absent options and a NULL conf 
+// take the defaults
+void init_conf_backoff(backoff_t* b, char const* conf);
+
+// ms until the next retry
+int64_t next_backoff(backoff_t* b);
+
+// Shortest retry, i.e., base_ms/4 and at least 1 ms, as a timer of 0 ms never
+// expires
+int64_t floor_backoff(backoff_t const* b);
+
+// After a successful setup 
+void reset_backoff(backoff_t* b);
+
+#endif
@@ -0,0 +1,219 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+
+
+
+#ifndef BYTE_READER_MIR_H
+#define BYTE_READER_MIR_H
+
+// Bounds-checked cursor for decoding untrusted bytes, e.g., the plain SM 
+// encodings. The error is sticky: once a read fails, every following read 
+// fails and zeroes its destination, so a decoder checks once at the end.
+// Scalars are little-endian, the layout that the plain encoders memcpy on 
+// every supported target. Header only, so that the getters are inlined
+
+#include <endian.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+typedef struct{
+  uint8_t const* it;
+  uint8_t const* end;
+  bool err;
+} byte_reader_t;
+
+static inline
+byte_reader_t init_byte_reader(size_t len, uint8_t const buf[len])
+{
+  byte_reader_t rd = {.it = buf, .end = buf + len, .err = (buf == NULL && len > 0)};
+  return rd;
+}
+
+static inline
+size_t left_byte_reader(byte_reader_t const* rd)
+{
+  return rd->end - rd->it;
+}
+
+static inline
+void fail_byte_reader(byte_reader_t* rd)
+{
+  rd->err = true;
+  rd->it = rd->end;
+}
+
+// No error and every byte consumed
+static inline
+bool done_byte_reader(byte_reader_t const* rd)
+{
+  return rd->err == false && rd->it == rd->end;
+}
+
+// Copies len raw bytes, e.g., strings or structs memcpy'ed by the encoder
+static inline
+bool get_bytes_byte_reader(byte_reader_t* rd, size_t len, void* dst)
+{
+  if(rd->err == true || left_byte_reader(rd) < len){
+    fail_byte_reader(rd);
+    memset(dst, 0, len);
+    return false;
+  }
+
+  memcpy(dst, rd->it, len);
+  rd->it += len;
+  return true;
+}
+
+static inline
+bool skip_byte_reader(byte_reader_t* rd, size_t len)
+{
+  if(rd->err == true || left_byte_reader(rd) < len){
+    fail_byte_reader(rd);
+    return false;
+  }
+
+  rd->it += len;
+  return true;
+}
+
+// Checks, before allocating, that num elements of at least sz bytes each
+// can be in the buffer. Avoids huge allocations from corrupt counters
+static inline
+bool fits_byte_reader(byte_reader_t* rd, size_t num, size_t sz)
+{
+  if(rd->err == true || (sz > 0 && num > left_byte_reader(rd) / sz)){
+    fail_byte_reader(rd);
+    return false;
+  }
+  return true;
+}
+
+static inline
+bool get_u8_byte_reader(byte_reader_t* rd, uint8_t* dst)
+{
+  return get_bytes_byte_reader(rd, sizeof(*dst), dst);
+}
+
+static inline
+bool get_u16_byte_reader(byte_reader_t* rd, uint16_t* dst)
+{
+  bool const ok = get_bytes_byte_reader(rd, sizeof(*dst), dst);
+  *dst = le16toh(*dst);
+  return ok;
+}
+
+static inline
+bool get_u32_byte_reader(byte_reader_t* rd, uint32_t* dst)
+{
+  bool const ok = get_bytes_byte_reader(rd, sizeof(*dst), dst);
+  *dst = le32toh(*dst);
+  return ok;
+}
+
+static inline
+bool get_u64_byte_reader(byte_reader_t* rd, uint64_t* dst)
+{
+  bool const ok = get_bytes_byte_reader(rd, sizeof(*dst), dst);
+  *dst = le64toh(*dst);
+  return ok;
+}
+
+static inline
+bool get_i8_byte_reader(byte_reader_t* rd, int8_t* dst)
+{
+  return get_bytes_byte_reader(rd, sizeof(*dst), dst);
+}
+
+static inline
+bool get_i16_byte_reader(byte_reader_t* rd, int16_t* dst)
+{
+  return get_u16_byte_reader(rd, (uint16_t*)dst);
+}
+
+static inline
+bool get_i32_byte_reader(byte_reader_t* rd, int32_t* dst)
+{
+  return get_u32_byte_reader(rd, (uint32_t*)dst);
+}
+
+static inline
+bool get_i64_byte_reader(byte_reader_t* rd, int64_t* dst)
+{
+  return get_u64_byte_reader(rd, (uint64_t*)dst);
+}
+
+static inline
+bool get_float_byte_reader(byte_reader_t* rd, float* dst)
+{
+  _Static_assert(sizeof(float) == sizeof(uint32_t), "Unexpected float size");
+  uint32_t v = 0;
+  bool const ok = get_u32_byte_reader(rd, &v);
+  memcpy(dst, &v, sizeof(v));
+  return ok;
+}
+
+static inline
+bool get_double_byte_reader(byte_reader_t* rd, double* dst)
+{
+  _Static_assert(sizeof(double) == sizeof(uint64_t), "Unexpected double size");
+  uint64_t v = 0;
+  bool const ok = get_u64_byte_reader(rd, &v);
+  memcpy(dst, &v, sizeof(v));
+  return ok;
+}
+
+// One byte. Any value other than 0 is true, as a bool can not hold it
+static inline
+bool get_bool_byte_reader(byte_reader_t* rd, bool* dst)
+{
+  uint8_t v = 0;
+  bool const ok = get_u8_byte_reader(rd, &v);
+  *dst = v != 0;
+  return ok;
+}
+
+// Enumerations are encoded with the size of an int. The value is not 
+// validated, that is left to the decoder
+#define get_enum_byte_reader(RD, DST) do { \
+  _Static_assert(sizeof(*(DST)) == sizeof(uint32_t), "Unexpected enum size"); \
+  uint32_t enum_v_ = 0; \
+  get_u32_byte_reader(RD, &enum_v_); \
+  *(DST) = enum_v_; \
+} while(0)
+
+#define get_byte_reader(RD, DST) _Generic((DST), \
+                                  uint8_t*: get_u8_byte_reader, \
+                                  uint16_t*: get_u16_byte_reader, \
+                                  uint32_t*: get_u32_byte_reader, \
+                                  uint64_t*: get_u64_byte_reader, \
+                                  int8_t*: get_i8_byte_reader, \
+                                  int16_t*: get_i16_byte_reader, \
+                                  int32_t*: get_i32_byte_reader, \
+                                  int64_t*: get_i64_byte_reader, \
+                                  float*: get_float_byte_reader, \
+                                  double*: get_double_byte_reader, \
+                                  bool*: get_bool_byte_reader) (RD, DST)
+
+#endif
+
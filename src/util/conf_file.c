@@ -510,3 +510,203 @@ char* get_conf_db_name(fr_args_t const* args)
 
   return strdup(db_name);
 }
+
+// NULL if the key is not present
+static
+char* get_conf_opt_str(fr_args_t const* args, const char* needle)
+{
+  char* line = NULL;
+  defer({free(line);});
+  size_t len = 0;
+  ssize_t read;
+
+  FILE * fp = fopen(args->conf_file, "r");
+
+  if (fp == NULL){
+    printf("%s not found. Did you forget to sudo make install?\n", args->conf_file);
+    exit(EXIT_FAILURE);
+  }
+
+  defer({fclose(fp); } );
+
+  char value[256] = {0};
+  while ((read = getline(&line, &len, fp)) != -1) {
+    char* ans = strstr(line, needle);
+    if(ans != NULL){
+      ans += strlen(needle);
+      ans = ltrim(ans);
+      ans = rtrim(ans);
+      assert(strlen(ans) < sizeof(value) && "Value too large");
+      memcpy(value, ans , strlen(ans));
+      break;
+    }
+  }
+
+  if(strlen(value) == 0)
+    return NULL;
+
+  return strdup(value);
+}
+
+char* get_conf_xapp_token(fr_args_t const* args)
+{
+  char* token = get_conf_opt_str(args, "XAPP_TOKEN =");
+  assert((token == NULL || strchr(token, '/') == NULL) && "XAPP_TOKEN cannot contain '/'");
+  return token;
+}
+
+char* get_conf_xapp_group(fr_args_t const* args)
+{
+  return get_conf_opt_str(args, "XAPP_GROUP =");
+}
+
+char* get_conf_ctrl_conflict(fr_args_t const* args)
+{
+  return get_conf_opt_str(args, "CTRL_CONFLICT =");
+}
+
+char* get_conf_ctrl_audit_log(fr_args_t const* args)
+{
+  return get_conf_opt_str(args, "CTRL_AUDIT_LOG =");
+}
+
+char* get_conf_msg_deadline(fr_args_t const* args)
+{
+  return get_conf_opt_str(args, "MSG_DEADLINE =");
+}
+
+char* get_conf_pcap_file(fr_args_t const* args)
+{
+  return get_conf_opt_str(args, "PCAP_FILE =");
+}
+
+char* get_conf_pcap_ring(fr_args_t const* args)
+{
+  return get_conf_opt_str(args, "PCAP_RING =");
+}
+
+char* get_conf_admin_socket(fr_args_t const* args)
+{
+  return get_conf_opt_str(args, "ADMIN_SOCKET =");
+}
+
+char* get_conf_io_backend(fr_args_t const* args)
+{
+  return get_conf_opt_str(args, "IO_BACKEND =");
+}
+
+char* get_conf_near_ric_ip_list(fr_args_t const* args)
+{
+  return get_conf_opt_str(args, "NEAR_RIC_IP_LIST =");
+}
+
+char* get_conf_ha_role(fr_args_t const* args)
+{
+  return get_conf_opt_str(args, "HA_ROLE =");
+}
+
+char* get_conf_ha_peer(fr_args_t const* args)
+{
+  return get_conf_opt_str(args, "HA_PEER =");
+}
+
+char* get_conf_ha_secret(fr_args_t const* args)
+{
+  return get_conf_opt_str(args, "HA_SECRET =");
+}
+
+char* get_conf_reconnect_backoff(fr_args_t const* args)
+{
+  return get_conf_opt_str(args, "RECONNECT_BACKOFF =");
+}
+
+char* get_conf_influx_sink(fr_args_t const* args)
+{
+  return get_conf_opt_str(args, "INFLUX_SINK =");
+}
+
+char* get_conf_influx_batch(fr_args_t const* args)
+{
+  return get_conf_opt_str(args, "INFLUX_BATCH =");
+}
+
+char* get_conf_influx_spool(fr_args_t const* args)
+{
+  return get_conf_opt_str(args, "INFLUX_SPOOL =");
+}
+
+char* get_conf_telemetry_file(fr_args_t const* args)
+{
+  return get_conf_opt_str(args, "TELEMETRY_FILE =");
+}
+
+char* get_conf_telemetry_format(fr_args_t const* args)
+{
+  return get_conf_opt_str(args, "TELEMETRY_FORMAT =");
+}
+
+char* get_conf_telemetry_rotate(fr_args_t const* args)
+{
+  return get_conf_opt_str(args, "TELEMETRY_ROTATE =");
+}
+
+bool parse_kv_conf(size_t len, char const conf[len], kv_conf_fp fp, void* data)
+{
+  assert(conf != NULL || len == 0);
+  assert(fp != NULL);
+
+  char* str = calloc(1, len + 1);
+  assert(str != NULL && "Memory exhausted");
+  if(len > 0)
+    memcpy(str, conf, len);
+
+  bool ok = true;
+  char* save = NULL;
+  for(char* it = strtok_r(str, ";", &save); ok == true && it != NULL; it = strtok_r(NULL, ";", &save)){
+    char* eq = strchr(it, '=');
+    if(eq == NULL){
+      ok = false;
+      break;
+    }
+    *eq = '\0';
+    ok = fp(it, eq + 1, data);
+  }
+
+  free(str);
+  return ok;
+}
+
+bool parse_size_conf(char const* val, size_t* dst)
+{
+  assert(val != NULL);
+  assert(dst != NULL);
+
+  char* end = NULL;
+  long long const v = strtoll(val, &end, 10);
+  if(end == val || v <= 0)
+    return false;
+
+  size_t mul = 1;
+  if(strcmp(end, "K") == 0)
+    mul = 1024;
+  else if(strcmp(end, "M") == 0)
+    mul = 1024*1024;
+  else if(strcmp(end, "G") == 0)
+    mul = 1024*1024*1024;
+  else if(*end != '\0')
+    return false;
+
+  *dst = v*mul;
+  return true;
+}
+
+bool parse_num_conf(char const* val, long long min, long long max, long long* dst)
+{
+  assert(val != NULL);
+  assert(dst != NULL);
+
+  char* end = NULL;
+  long long const v = strtoll(val, &end, 10);
+  *dst = v;
+  return *val != '\0' && *end == '\0' && v >= min && v <= max;
+}
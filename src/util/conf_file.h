@@ -1,6 +1,8 @@
 #ifndef FLEXRIC_CONFIGURATION_FILE_H
 #define FLEXRIC_CONFIGURATION_FILE_H 
 
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 #define FR_CONF_FILE_LEN 128
 
@@ -21,5 +23,89 @@ char* get_conf_db_dir(fr_args_t const*);
 
 char* get_conf_db_name(fr_args_t const*);
 
+// NULL if the XAPP_TOKEN key is not present
+char* get_conf_xapp_token(fr_args_t const*);
+
+// NULL if the XAPP_GROUP key is not present
+char* get_conf_xapp_group(fr_args_t const*);
+
+// NULL if the CTRL_CONFLICT key is not present
+char* get_conf_ctrl_conflict(fr_args_t const*);
+
+// NULL if the CTRL_AUDIT_LOG key is not present
+char* get_conf_ctrl_audit_log(fr_args_t const*);
+
+// NULL if the MSG_DEADLINE key is not present
+char* get_conf_msg_deadline(fr_args_t const*);
+
+// NULL if the PCAP_FILE key is not present
+char* get_conf_pcap_file(fr_args_t const*);
+
+// NULL if the PCAP_RING key is not present
+char* get_conf_pcap_ring(fr_args_t const*);
+
+// NULL if the ADMIN_SOCKET key is not present
+char* get_conf_admin_socket(fr_args_t const*);
+
+// NULL if the IO_BACKEND key is not present
+char* get_conf_io_backend(fr_args_t const*);
+
+// NULL if the NEAR_RIC_IP_LIST key is not present
+// Comma separated, i.e., NEAR_RIC_IP_LIST = 10.0.0.1,10.0.0.2
+char* get_conf_near_ric_ip_list(fr_args_t const*);
+
+// NULL if the HA_ROLE key is not present, i.e., PRIMARY or STANDBY
+char* get_conf_ha_role(fr_args_t const*);
+
+// NULL if the HA_PEER key is not present, i.e., HA_PEER = 10.0.0.1:36430
+char* get_conf_ha_peer(fr_args_t const*);
+
+// NULL if the HA_SECRET key is not present, i.e., shared by the primary 
+// and the standby nearRT-RICs
+char* get_conf_ha_secret(fr_args_t const*);
+
+// NULL if the RECONNECT_BACKOFF key is not present, i.e., 
+// RECONNECT_BACKOFF = base=500;max=10000 ms of the E2 and E42 Setup retries
+char* get_conf_reconnect_backoff(fr_args_t const*);
+
+// NULL if the INFLUX_SINK key is not present, i.e., INFLUX_SINK = udp://127.0.0.1:8094
+// or tcp://<host>:<port>
+char* get_conf_influx_sink(fr_args_t const*);
+
+// NULL if the INFLUX_BATCH key is not present, i.e.,
+// INFLUX_BATCH = size=1400;ms=100;spool=64M;retry=1000
+char* get_conf_influx_batch(fr_args_t const*);
+
+// NULL if the INFLUX_SPOOL key is not present, i.e., path of the spool file
+char* get_conf_influx_spool(fr_args_t const*);
+
+// NULL if the TELEMETRY_FILE key is not present, i.e., path of the telemetry file
+char* get_conf_telemetry_file(fr_args_t const*);
+
+// NULL if the TELEMETRY_FORMAT key is not present, i.e., json or line
+char* get_conf_telemetry_format(fr_args_t const*);
+
+// NULL if the TELEMETRY_ROTATE key is not present, i.e.,
+// TELEMETRY_ROTATE = size=64M;age=3600;keep=4;gzip=1;buf=4M;ms=1000
+char* get_conf_telemetry_rotate(fr_args_t const*);
+
+/////
+// Values with options, i.e., key=val;key=val
+/////
+
+// Called for every key=val option. key and val are NUL terminated and may
+// be modified. False if the option is not valid
+typedef bool (*kv_conf_fp)(char* key, char* val, void* data);
+
+// Splits the len bytes of conf, e.g., size=64M;ms=1000, at ';' and calls fp
+// with every option. False at the first option without '=' or rejected by fp
+bool parse_kv_conf(size_t len, char const conf[len], kv_conf_fp fp, void* data);
+
+// Positive size with an optional K, M or G suffix, e.g., 64M
+bool parse_size_conf(char const* val, size_t* dst);
+
+// Decimal number in [min, max]
+bool parse_num_conf(char const* val, long long min, long long max, long long* dst);
+
 #endif
 
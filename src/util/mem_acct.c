@@ -0,0 +1,488 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+#define _GNU_SOURCE // dladdr()
+
+#include "mem_acct.h"
+
+#include <assert.h>
+#include <dlfcn.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Live allocations, spread by address so that the threads rarely contend
+#define MEM_ACCT_SHARDS 64
+#define MEM_ACCT_SHARD_INIT_CAP 1024
+
+// Distinct call sites remembered. Beyond, they are reported as unknown
+#define MEM_ACCT_SITES (1 << 14)
+
+typedef struct{
+  void* ptr; // NULL if empty
+  size_t sz;
+  uint32_t site; // 0 if unknown
+  uint32_t tag;
+} entry_t;
+
+// Open addressing with linear probing, at most half full
+typedef struct{
+  pthread_mutex_t mtx;
+  entry_t* arr;
+  size_t cap;
+  size_t len;
+} shard_t;
+
+// Resolved once, when first seen, as the module may be dlclose()d before 
+// the leaks are reported, e.g., the SMs
+typedef struct{
+  _Atomic(uintptr_t) pc; // 0 if empty
+  atomic_bool ready;
+  char* module;
+  char* sym;
+  uintptr_t off;
+} site_t;
+
+typedef struct{
+  atomic_int_fast64_t live_bytes;
+  atomic_int_fast64_t live_allocs;
+  atomic_int_fast64_t peak_bytes;
+  atomic_uint_fast64_t total_allocs;
+} counter_t;
+
+static
+shard_t shards[MEM_ACCT_SHARDS] = { [0 ... MEM_ACCT_SHARDS - 1] = {.mtx = PTHREAD_MUTEX_INITIALIZER} };
+
+static
+site_t sites[MEM_ACCT_SITES];
+
+static
+counter_t counters[END_MEM_ACCT];
+
+#define MEM_ACCT_STR(T) #T,
+
+static
+char const* tag_names[END_MEM_ACCT] = { MEM_ACCT_TAGS(MEM_ACCT_STR) };
+
+static inline
+uint64_t mix(uint64_t h)
+{
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  return h;
+}
+
+static inline
+shard_t* shard(void const* ptr)
+{
+  return &shards[mix((uintptr_t)ptr) % MEM_ACCT_SHARDS];
+}
+
+static inline
+size_t home(shard_t const* s, void const* ptr)
+{
+  return (mix((uintptr_t)ptr) / MEM_ACCT_SHARDS) & (s->cap - 1);
+}
+
+static
+void grow(shard_t* s)
+{
+  size_t const cap = s->cap == 0 ? MEM_ACCT_SHARD_INIT_CAP : 2*s->cap;
+  entry_t* arr = calloc(cap, sizeof(entry_t));
+  assert(arr != NULL && "Memory exhausted");
+
+  entry_t* old = s->arr;
+  size_t const old_cap = s->cap;
+
+  s->arr = arr;
+  s->cap = cap;
+  for(size_t i = 0; i < old_cap; ++i){
+    if(old[i].ptr == NULL)
+      continue;
+    size_t j = home(s, old[i].ptr);
+    while(arr[j].ptr != NULL)
+      j = (j + 1) & (cap - 1);
+    arr[j] = old[i];
+  }
+
+  free(old);
+}
+
+static
+size_t find(shard_t const* s, void const* ptr)
+{
+  if(s->cap == 0)
+    return SIZE_MAX;
+
+  size_t i = home(s, ptr);
+  while(s->arr[i].ptr != NULL){
+    if(s->arr[i].ptr == ptr)
+      return i;
+    i = (i + 1) & (s->cap - 1);
+  }
+  return SIZE_MAX;
+}
+
+// Backward shift, so that no tombstones are needed
+static
+void erase(shard_t* s, size_t i)
+{
+  size_t const mask = s->cap - 1;
+  size_t j = i;
+  for(;;){
+    j = (j + 1) & mask;
+    if(s->arr[j].ptr == NULL)
+      break;
+
+    size_t const k = home(s, s->arr[j].ptr);
+    bool const stays = i <= j ? (i < k && k <= j) : (i < k || k <= j);
+    if(stays)
+      continue;
+
+    s->arr[i] = s->arr[j];
+    i = j;
+  }
+  s->arr[i].ptr = NULL;
+  s->len -= 1;
+}
+
+static
+void count_alloc(uint32_t tag, size_t sz)
+{
+  counter_t* c = &counters[tag];
+  int64_t const live = atomic_fetch_add_explicit(&c->live_bytes, sz, memory_order_relaxed) + sz;
+  atomic_fetch_add_explicit(&c->live_allocs, 1, memory_order_relaxed);
+  atomic_fetch_add_explicit(&c->total_allocs, 1, memory_order_relaxed);
+
+  int64_t peak = atomic_load_explicit(&c->peak_bytes, memory_order_relaxed);
+  while(live > peak && !atomic_compare_exchange_weak_explicit(&c->peak_bytes, &peak, live, memory_order_relaxed, memory_order_relaxed))
+    ;
+}
+
+static
+void count_free(entry_t const* e)
+{
+  counter_t* c = &counters[e->tag];
+  atomic_fetch_sub_explicit(&c->live_bytes, e->sz, memory_order_relaxed);
+  atomic_fetch_sub_explicit(&c->live_allocs, 1, memory_order_relaxed);
+}
+
+static
+void resolve(site_t* s, uintptr_t pc)
+{
+  Dl_info info = {0};
+  if(dladdr((void*)pc, &info) != 0 && info.dli_fname != NULL){
+    char const* base = strrchr(info.dli_fname, '/');
+    s->module = strdup(base != NULL ? base + 1 : info.dli_fname);
+    s->sym = info.dli_sname != NULL ? strdup(info.dli_sname) : NULL;
+    // pc is the return address, i.e., after the call
+    s->off = pc - 1 - (uintptr_t)info.dli_fbase;
+  } else {
+    s->module = NULL;
+    s->sym = NULL;
+    s->off = pc - 1;
+  }
+  atomic_store_explicit(&s->ready, true, memory_order_release);
+}
+
+static
+uint32_t site_id(void const* ret_addr)
+{
+  uintptr_t const pc = (uintptr_t)ret_addr;
+  if(pc == 0)
+    return 0;
+
+  uint64_t const h = mix(pc);
+
+  for(size_t n = 0; n < MEM_ACCT_SITES; ++n){
+    size_t const i = (h + n) & (MEM_ACCT_SITES - 1);
+    uintptr_t cur = atomic_load_explicit(&sites[i].pc, memory_order_acquire);
+    if(cur == 0){
+      if(atomic_compare_exchange_strong(&sites[i].pc, &cur, pc)){
+        resolve(&sites[i], pc);
+        return i + 1;
+      }
+    }
+    if(cur == pc)
+      return i + 1;
+  }
+  return 0;
+}
+
+static
+void* track(uint32_t tag, void const* ret_addr, void* ptr, size_t sz)
+{
+  if(ptr == NULL)
+    return NULL;
+
+  entry_t const e = {.ptr = ptr, .sz = sz, .site = site_id(ret_addr), .tag = tag};
+
+  shard_t* s = shard(ptr);
+  pthread_mutex_lock(&s->mtx);
+
+  // Freed behind our back, e.g., by a file compiled without the accounting
+  size_t const i = find(s, ptr);
+  if(i != SIZE_MAX){
+    count_free(&s->arr[i]);
+    erase(s, i);
+  }
+
+  if(2*(s->len + 1) > s->cap)
+    grow(s);
+
+  size_t j = home(s, ptr);
+  while(s->arr[j].ptr != NULL)
+    j = (j + 1) & (s->cap - 1);
+  s->arr[j] = e;
+  s->len += 1;
+
+  pthread_mutex_unlock(&s->mtx);
+
+  count_alloc(tag, sz);
+  return ptr;
+}
+
+static
+bool untrack(void* ptr, entry_t* dst)
+{
+  shard_t* s = shard(ptr);
+  pthread_mutex_lock(&s->mtx);
+
+  size_t const i = find(s, ptr);
+  bool const found = i != SIZE_MAX;
+  if(found){
+    *dst = s->arr[i];
+    erase(s, i);
+  }
+
+  pthread_mutex_unlock(&s->mtx);
+
+  if(found)
+    count_free(dst);
+  return found;
+}
+
+void free_mem_acct(void* ptr)
+{
+  if(ptr == NULL)
+    return;
+
+  // Before free(), as another thread may get the same address right after
+  entry_t e;
+  untrack(ptr, &e);
+  free(ptr);
+}
+
+static
+void* realloc_tag(uint32_t tag, void const* ret_addr, void* ptr, size_t sz)
+{
+  if(ptr == NULL)
+    return track(tag, ret_addr, malloc(sz), sz);
+
+  entry_t e;
+  bool const found = untrack(ptr, &e);
+
+  void* new_ptr = realloc(ptr, sz);
+  if(new_ptr == NULL){
+    // ptr is still valid, unless sz == 0, where glibc frees it
+    if(found && sz != 0)
+      track(e.tag, NULL, ptr, e.sz);
+    return NULL;
+  }
+  return track(tag, ret_addr, new_ptr, sz);
+}
+
+static
+char* strdup_tag(uint32_t tag, void const* ret_addr, char const* s)
+{
+  char* ptr = strdup(s);
+  return track(tag, ret_addr, ptr, ptr != NULL ? strlen(ptr) + 1 : 0);
+}
+
+// The call site is the return address of these functions
+#define MEM_ACCT_DEF_ALLOC(T) \
+  void* malloc_mem_acct_##T(size_t sz) \
+  { \
+    return track(MEM_ACCT_##T, __builtin_return_address(0), malloc(sz), sz); \
+  } \
+  void* calloc_mem_acct_##T(size_t nmemb, size_t sz) \
+  { \
+    return track(MEM_ACCT_##T, __builtin_return_address(0), calloc(nmemb, sz), nmemb*sz); \
+  } \
+  void* realloc_mem_acct_##T(void* ptr, size_t sz) \
+  { \
+    return realloc_tag(MEM_ACCT_##T, __builtin_return_address(0), ptr, sz); \
+  } \
+  char* strdup_mem_acct_##T(char const* s) \
+  { \
+    return strdup_tag(MEM_ACCT_##T, __builtin_return_address(0), s); \
+  } 
+
+MEM_ACCT_TAGS(MEM_ACCT_DEF_ALLOC)
+
+char const* tag_str_mem_acct(mem_acct_tag_e tag)
+{
+  assert(tag < END_MEM_ACCT);
+  return tag_names[tag];
+}
+
+mem_acct_stats_t stats_mem_acct(mem_acct_tag_e tag)
+{
+  assert(tag < END_MEM_ACCT);
+  counter_t* c = &counters[tag];
+
+  mem_acct_stats_t ans = {
+    .live_bytes = atomic_load_explicit(&c->live_bytes, memory_order_relaxed),
+    .live_allocs = atomic_load_explicit(&c->live_allocs, memory_order_relaxed),
+    .peak_bytes = atomic_load_explicit(&c->peak_bytes, memory_order_relaxed),
+    .total_allocs = atomic_load_explicit(&c->total_allocs, memory_order_relaxed),
+  };
+  return ans;
+}
+
+void print_mem_acct(char const* prefix, FILE* out)
+{
+  assert(prefix != NULL);
+  assert(out != NULL);
+
+  for(int i = 0; i < END_MEM_ACCT; ++i){
+    mem_acct_stats_t const st = stats_mem_acct(i);
+    if(st.total_allocs == 0)
+      continue;
+    fprintf(out, "[%s]: memory %s live %ld B in %ld allocs, peak %ld B, %lu allocs\n",
+        prefix, tag_names[i], st.live_bytes, st.live_allocs, st.peak_bytes, st.total_allocs);
+  }
+
+  size_t overhead = sizeof(shards) + sizeof(sites);
+  for(size_t i = 0; i < MEM_ACCT_SHARDS; ++i){
+    pthread_mutex_lock(&shards[i].mtx);
+    overhead += shards[i].cap*sizeof(entry_t);
+    pthread_mutex_unlock(&shards[i].mtx);
+  }
+  fprintf(out, "[%s]: memory accounting overhead %lu B\n", prefix, overhead);
+}
+
+typedef struct{
+  int64_t bytes;
+  int64_t allocs;
+  uint32_t site;
+  uint32_t tag;
+} agg_t;
+
+static
+int cmp_bytes_desc(void const* a_v, void const* b_v)
+{
+  agg_t const* a = (agg_t const*)a_v;
+  agg_t const* b = (agg_t const*)b_v;
+  if(a->bytes != b->bytes)
+    return a->bytes < b->bytes ? 1 : -1;
+  return a->allocs < b->allocs ? 1 : (a->allocs > b->allocs ? -1 : 0);
+}
+
+static
+void print_site(uint32_t id, FILE* out)
+{
+  site_t const* s = id == 0 ? NULL : &sites[id - 1];
+  if(s == NULL || atomic_load_explicit(&s->ready, memory_order_acquire) == false){
+    fprintf(out, "unknown site");
+  } else if(s->module == NULL){
+    fprintf(out, "0x%lx", s->off);
+  } else {
+    fprintf(out, "%s+0x%lx", s->module, s->off);
+    if(s->sym != NULL)
+      fprintf(out, " (%s)", s->sym);
+  }
+}
+
+int64_t print_sites_mem_acct(char const* prefix, size_t max, FILE* out)
+{
+  assert(prefix != NULL);
+  assert(out != NULL);
+
+  // A call site belongs to one tag, but the unknown ones to all of them 
+  size_t const len = MEM_ACCT_SITES + END_MEM_ACCT;
+  agg_t* agg = calloc(len, sizeof(agg_t));
+  assert(agg != NULL && "Memory exhausted");
+
+  for(size_t i = 0; i < MEM_ACCT_SHARDS; ++i){
+    shard_t* s = &shards[i];
+    pthread_mutex_lock(&s->mtx);
+    for(size_t j = 0; j < s->cap; ++j){
+      entry_t const* e = &s->arr[j];
+      if(e->ptr == NULL)
+        continue;
+      agg_t* a = &agg[e->site == 0 ? MEM_ACCT_SITES + e->tag : e->site - 1];
+      a->bytes += e->sz;
+      a->allocs += 1;
+      a->site = e->site;
+      a->tag = e->tag;
+    }
+    pthread_mutex_unlock(&s->mtx);
+  }
+
+  size_t n = 0;
+  int64_t total = 0;
+  for(size_t i = 0; i < len; ++i){
+    if(agg[i].allocs == 0)
+      continue;
+    total += agg[i].bytes;
+    agg[n++] = agg[i];
+  }
+
+  qsort(agg, n, sizeof(agg_t), cmp_bytes_desc);
+
+  for(size_t i = 0; i < n && i < max; ++i){
+    fprintf(out, "[%s]: %s %ld B in %ld allocs at ", prefix, tag_names[agg[i].tag], agg[i].bytes, agg[i].allocs);
+    print_site(agg[i].site, out);
+    fputc('\n', out);
+  }
+  if(n > max)
+    fprintf(out, "[%s]: %lu more sites\n", prefix, n - max);
+
+  free(agg);
+  return total;
+}
+
+void report_leaks_mem_acct(char const* prefix, FILE* out)
+{
+  assert(prefix != NULL);
+  assert(out != NULL);
+
+  int64_t bytes = 0;
+  int64_t allocs = 0;
+  for(int i = 0; i < END_MEM_ACCT; ++i){
+    mem_acct_stats_t const st = stats_mem_acct(i);
+    bytes += st.live_bytes;
+    allocs += st.live_allocs;
+  }
+
+  if(allocs == 0){
+    fprintf(out, "[%s]: No memory leaks\n", prefix);
+    return;
+  }
+
+  fprintf(out, "[%s]: Memory leaks, %ld B in %ld allocs\n", prefix, bytes, allocs);
+  print_mem_acct(prefix, out);
+  print_sites_mem_acct(prefix, SIZE_MAX, out);
+  fflush(out);
+}
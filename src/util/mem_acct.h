@@ -0,0 +1,127 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+#ifndef MEM_ACCT_H
+#define MEM_ACCT_H
+
+// Per component memory accounting, usable without ASan. Built with 
+// -DMEM_ACCT=ON, every allocation of the nearRT-RIC, the iApp, the agent,
+// the xApp SDK, its DB and each SM is counted under the tag of the 
+// component that allocated it (see mem_acct_alloc.h), and remembered with
+// its call site until freed. The call sites are printed as module+offset 
+// of the call, e.g., "libkpm_sm.so+0x1a2b3", i.e.,
+//  addr2line -f -e libkpm_sm.so 0x1a2b3
+// Without -DMEM_ACCT=ON the functions below do nothing.
+// The nearRT-RIC exposes the counters through the "mem" admin command, and
+// the nearRT-RIC, the agent and the xApp print the leaks when they stop
+
+#include "mem_acct_alloc.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define MEM_ACCT_ENUM(T) MEM_ACCT_##T,
+
+typedef enum{
+  MEM_ACCT_TAGS(MEM_ACCT_ENUM)
+
+  END_MEM_ACCT
+} mem_acct_tag_e;
+
+typedef struct{
+  int64_t live_bytes;
+  int64_t live_allocs;
+  int64_t peak_bytes;
+  uint64_t total_allocs;
+} mem_acct_stats_t;
+
+#ifdef MEM_ACCT
+
+static inline
+bool enabled_mem_acct(void)
+{
+  return true;
+}
+
+// "RIC", "KPM_SM", ...
+char const* tag_str_mem_acct(mem_acct_tag_e tag);
+
+mem_acct_stats_t stats_mem_acct(mem_acct_tag_e tag);
+
+// One line per tag that ever allocated, and the memory of the accounting
+void print_mem_acct(char const* prefix, FILE* out);
+
+// The live memory grouped by call site, the biggest max ones first.
+// Returns the number of live bytes
+int64_t print_sites_mem_acct(char const* prefix, size_t max, FILE* out);
+
+// At shutdown, everything still allocated is a leak
+void report_leaks_mem_acct(char const* prefix, FILE* out);
+
+#else
+
+static inline
+bool enabled_mem_acct(void)
+{
+  return false;
+}
+
+static inline
+char const* tag_str_mem_acct(mem_acct_tag_e tag)
+{
+  (void)tag;
+  return "";
+}
+
+static inline
+mem_acct_stats_t stats_mem_acct(mem_acct_tag_e tag)
+{
+  (void)tag;
+  return (mem_acct_stats_t){0};
+}
+
+static inline
+void print_mem_acct(char const* prefix, FILE* out)
+{
+  (void)prefix;
+  (void)out;
+}
+
+static inline
+int64_t print_sites_mem_acct(char const* prefix, size_t max, FILE* out)
+{
+  (void)prefix;
+  (void)max;
+  (void)out;
+  return 0;
+}
+
+static inline
+void report_leaks_mem_acct(char const* prefix, FILE* out)
+{
+  (void)prefix;
+  (void)out;
+}
+
+#endif
+
+#endif
@@ -0,0 +1,82 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+#ifndef MEM_ACCT_ALLOC_H
+#define MEM_ACCT_ALLOC_H
+
+// Force included, i.e., -include, in every C file when built with
+// -DMEM_ACCT=ON. malloc, calloc, realloc, strdup and free are renamed to 
+// the functions of the component that the file belongs to, selected by the
+// MEM_ACCT_TAG definition of its directory. As the macros are object like,
+// the declarations of the libc headers become declarations of these
+// functions, and free passed as a function pointer is accounted too.
+// No system header is included, so that _GNU_SOURCE and friends still work.
+// See mem_acct.h for the counters and the reports
+
+#include <stddef.h>
+
+// Shared code of lib/ and util/ is LIB, unless compiled within an SM 
+#define MEM_ACCT_TAGS(X) \
+  X(LIB)      \
+  X(RIC)      \
+  X(IAPP)     \
+  X(AGENT)    \
+  X(XAPP)     \
+  X(DB)       \
+  X(MAC_SM)   \
+  X(RLC_SM)   \
+  X(PDCP_SM)  \
+  X(GTP_SM)   \
+  X(SLICE_SM) \
+  X(TC_SM)    \
+  X(KPM_SM)   \
+  X(RC_SM)
+
+#if defined(MEM_ACCT) && !defined(MEM_ACCT_IMPL) && !defined(__cplusplus)
+
+#define MEM_ACCT_DECL_ALLOC(T) \
+  void* malloc_mem_acct_##T(size_t sz); \
+  void* calloc_mem_acct_##T(size_t nmemb, size_t sz); \
+  void* realloc_mem_acct_##T(void* ptr, size_t sz); \
+  char* strdup_mem_acct_##T(char const* s); 
+
+MEM_ACCT_TAGS(MEM_ACCT_DECL_ALLOC)
+
+// The owner of ptr is found, whatever component frees it. Pointers not 
+// allocated through these functions, e.g., by getline(), are just freed
+void free_mem_acct(void* ptr);
+
+#ifndef MEM_ACCT_TAG
+#define MEM_ACCT_TAG LIB
+#endif
+
+#define MEM_ACCT_CAT_(a, b) a##b
+#define MEM_ACCT_CAT(a, b) MEM_ACCT_CAT_(a, b)
+
+#define malloc  MEM_ACCT_CAT(malloc_mem_acct_, MEM_ACCT_TAG)
+#define calloc  MEM_ACCT_CAT(calloc_mem_acct_, MEM_ACCT_TAG)
+#define realloc MEM_ACCT_CAT(realloc_mem_acct_, MEM_ACCT_TAG)
+#define strdup  MEM_ACCT_CAT(strdup_mem_acct_, MEM_ACCT_TAG)
+#define free    free_mem_acct
+
+#endif
+
+#endif
@@ -0,0 +1,84 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+#include "overload_conf.h"
+#include "conf_file.h"
+
+#include <assert.h>
+#include <string.h>
+
+char const* overload_policy_str(overload_policy_e p)
+{
+  if(p == DROP_OLDEST_OVERLOAD_POLICY)
+    return "drop_oldest";
+  else if(p == DROP_NEWEST_OVERLOAD_POLICY)
+    return "drop_newest";
+  else if(p == KEEP_LATEST_OVERLOAD_POLICY)
+    return "keep_latest";
+  assert(0 != 0 && "Unknown overload policy");
+  return NULL;
+}
+
+static
+bool parse_overload_policy(char const* s, overload_policy_e* dst)
+{
+  for(int i = 0; i < END_OVERLOAD_POLICY; ++i){
+    if(strcmp(s, overload_policy_str(i)) == 0){
+      *dst = i;
+      return true;
+    }
+  }
+  return false;
+}
+
+static
+bool parse_overload_opt(char* key, char* val, void* data)
+{
+  overload_conf_t* dst = (overload_conf_t*)data;
+
+  if(strcmp(key, "policy") == 0)
+    return parse_overload_policy(val, &dst->policy);
+
+  if(strcmp(key, "depth") == 0){
+    long long depth = 0;
+    bool const ok = parse_num_conf(val, 1, OVERLOAD_MAX_DEPTH, &depth);
+    dst->depth = depth;
+    return ok;
+  }
+
+  return false;
+}
+
+bool parse_overload_conf(byte_array_t conf, overload_conf_t* dst)
+{
+  assert(dst != NULL);
+
+  *dst = (overload_conf_t){.policy = DROP_OLDEST_OVERLOAD_POLICY, .depth = OVERLOAD_DEPTH};
+
+  if(conf.len == 0 || conf.buf == NULL)
+    return false;
+
+  if(parse_kv_conf(conf.len, (char const*)conf.buf, parse_overload_opt, dst) == false){
+    *dst = (overload_conf_t){.policy = DROP_OLDEST_OVERLOAD_POLICY, .depth = OVERLOAD_DEPTH};
+    return false;
+  }
+  return true;
+}
@@ -0,0 +1,60 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+#ifndef OVERLOAD_CONF_H
+#define OVERLOAD_CONF_H
+
+// Overload policy of a subscription, selected by the xApp, e.g., 
+// "policy=keep_latest;depth=32". Applied by the iApp before sending the 
+// indications and by the xApp before dispatching them to the callback. 
+// Policies, when the queue of the subscription is full:
+//  drop_oldest   Discard the oldest queued indication 
+//  drop_newest   Discard the arriving indication
+//  keep_latest   Replace the queued indication of the same UE, as told by the 
+//                SM conflate hook. As drop_oldest otherwise
+
+#include "byte_array.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#define OVERLOAD_DEPTH 64
+#define OVERLOAD_MAX_DEPTH 4096
+
+typedef enum{
+  DROP_OLDEST_OVERLOAD_POLICY,
+  DROP_NEWEST_OVERLOAD_POLICY,
+  KEEP_LATEST_OVERLOAD_POLICY,
+
+  END_OVERLOAD_POLICY
+} overload_policy_e;
+
+typedef struct{
+  overload_policy_e policy;
+  size_t depth;
+} overload_conf_t;
+
+char const* overload_policy_str(overload_policy_e p);
+
+// Returns false if conf is malformed. dst holds the defaults then
+bool parse_overload_conf(byte_array_t conf, overload_conf_t* dst);
+
+#endif
@@ -0,0 +1,522 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+#ifndef PLAIN_WIRE_MIR_H
+#define PLAIN_WIRE_MIR_H
+
+// Versioned, little-endian layout of the plain SM encodings (MAC, RLC, PDCP,
+// GTP, slice and TC), independent of the host structs, their padding and 
+// endianness:
+//
+//  message  = version:u8 body sections
+//  body     = len_rec:u16 record                          e.g., event trigger
+//           | tstamp:i64 len_rec:u16 num:u32 record*num   indication message
+//           | tree                                        e.g., slice, TC
+//  record   = the fields of a struct, packed, in the order of its FIELDS list
+//  tree     = the fields of nested IEs, packed, in the order of the SM
+//             encoder. Scalars as in a record, enumerations as u32, arrays
+//             and strings as num:u32 elem*num, unions as tag:u32 member
+//  sections = (id:u16 len:u32 byte*len)*                  until the end
+//
+// Compatible changes append fields at the end of a FIELDS list, or add 
+// sections, the only extension point of a tree. A reader decodes the fields that it knows, skips the trailing 
+// ones of a newer writer and zeroes the ones that an older writer did not 
+// send. The sections it does not know are skipped. Incompatible changes bump
+// PLAIN_WIRE_VERSION, and the messages of other versions are not decoded.
+//
+// A FIELDS list, e.g., MAC_UE_STATS_WIRE, names the fields once, F() for
+// scalars and A() for arrays of scalars. PLAIN_WIRE_REC generates the record
+// encoder and decoder. On little-endian targets, a struct with the wire 
+// layout, i.e., no padding between its fields, is copied with one memcpy, 
+// and one with padding, e.g., the RLC bearer, with one memcpy per field at
+// offsets known at compile time, which the compiler merges into runs. Else 
+// the fields are converted one by one. Header only, so that they are inlined
+
+#include "byte_reader.h"
+#include "byte_array.h"
+
+#include <assert.h>
+#include <endian.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PLAIN_WIRE_VERSION 1
+
+// version
+#define PLAIN_WIRE_TREE_MSG_HDR_LEN (sizeof(uint8_t))
+
+// version, len_rec
+#define PLAIN_WIRE_REC_MSG_HDR_LEN (sizeof(uint8_t) + sizeof(uint16_t))
+
+// version, tstamp, len_rec, num
+#define PLAIN_WIRE_ARR_MSG_HDR_LEN (sizeof(uint8_t) + sizeof(int64_t) + sizeof(uint16_t) + sizeof(uint32_t))
+
+/////
+// Scalars. No bounds checks, the caller reserved the bytes
+/////
+
+static inline
+uint8_t* put_u8_plain_wire(uint8_t* it, uint8_t v)
+{
+  *it = v;
+  return it + sizeof(v);
+}
+
+static inline
+uint8_t* put_u16_plain_wire(uint8_t* it, uint16_t v)
+{
+  v = htole16(v);
+  memcpy(it, &v, sizeof(v));
+  return it + sizeof(v);
+}
+
+static inline
+uint8_t* put_u32_plain_wire(uint8_t* it, uint32_t v)
+{
+  v = htole32(v);
+  memcpy(it, &v, sizeof(v));
+  return it + sizeof(v);
+}
+
+static inline
+uint8_t* put_u64_plain_wire(uint8_t* it, uint64_t v)
+{
+  v = htole64(v);
+  memcpy(it, &v, sizeof(v));
+  return it + sizeof(v);
+}
+
+static inline
+uint8_t* put_i8_plain_wire(uint8_t* it, int8_t v)
+{
+  return put_u8_plain_wire(it, (uint8_t)v);
+}
+
+static inline
+uint8_t* put_i16_plain_wire(uint8_t* it, int16_t v)
+{
+  return put_u16_plain_wire(it, (uint16_t)v);
+}
+
+static inline
+uint8_t* put_i32_plain_wire(uint8_t* it, int32_t v)
+{
+  return put_u32_plain_wire(it, (uint32_t)v);
+}
+
+static inline
+uint8_t* put_i64_plain_wire(uint8_t* it, int64_t v)
+{
+  return put_u64_plain_wire(it, (uint64_t)v);
+}
+
+static inline
+uint8_t* put_float_plain_wire(uint8_t* it, float v)
+{
+  uint32_t u = 0;
+  memcpy(&u, &v, sizeof(u));
+  return put_u32_plain_wire(it, u);
+}
+
+static inline
+uint8_t* put_double_plain_wire(uint8_t* it, double v)
+{
+  uint64_t u = 0;
+  memcpy(&u, &v, sizeof(u));
+  return put_u64_plain_wire(it, u);
+}
+
+static inline
+uint8_t* put_bool_plain_wire(uint8_t* it, bool v)
+{
+  return put_u8_plain_wire(it, v);
+}
+
+// E.g., the characters of a string. src may be NULL if len is 0
+static inline
+uint8_t* put_bytes_plain_wire(uint8_t* it, size_t len, void const* src)
+{
+  if(len > 0)
+    memcpy(it, src, len);
+  return it + len;
+}
+
+// Enumerations match the integer type of their size
+#define put_plain_wire(IT, V) _Generic((V), \
+                                  uint8_t: put_u8_plain_wire, \
+                                  uint16_t: put_u16_plain_wire, \
+                                  uint32_t: put_u32_plain_wire, \
+                                  uint64_t: put_u64_plain_wire, \
+                                  int8_t: put_i8_plain_wire, \
+                                  int16_t: put_i16_plain_wire, \
+                                  int32_t: put_i32_plain_wire, \
+                                  int64_t: put_i64_plain_wire, \
+                                  float: put_float_plain_wire, \
+                                  double: put_double_plain_wire, \
+                                  bool: put_bool_plain_wire) (IT, V)
+
+static inline
+uint8_t const* get_u8_plain_wire(uint8_t const* it, uint8_t* dst)
+{
+  *dst = *it;
+  return it + sizeof(*dst);
+}
+
+static inline
+uint8_t const* get_u16_plain_wire(uint8_t const* it, uint16_t* dst)
+{
+  memcpy(dst, it, sizeof(*dst));
+  *dst = le16toh(*dst);
+  return it + sizeof(*dst);
+}
+
+static inline
+uint8_t const* get_u32_plain_wire(uint8_t const* it, uint32_t* dst)
+{
+  memcpy(dst, it, sizeof(*dst));
+  *dst = le32toh(*dst);
+  return it + sizeof(*dst);
+}
+
+static inline
+uint8_t const* get_u64_plain_wire(uint8_t const* it, uint64_t* dst)
+{
+  memcpy(dst, it, sizeof(*dst));
+  *dst = le64toh(*dst);
+  return it + sizeof(*dst);
+}
+
+static inline
+uint8_t const* get_i8_plain_wire(uint8_t const* it, int8_t* dst)
+{
+  return get_u8_plain_wire(it, (uint8_t*)dst);
+}
+
+static inline
+uint8_t const* get_i16_plain_wire(uint8_t const* it, int16_t* dst)
+{
+  return get_u16_plain_wire(it, (uint16_t*)dst);
+}
+
+static inline
+uint8_t const* get_i32_plain_wire(uint8_t const* it, int32_t* dst)
+{
+  return get_u32_plain_wire(it, (uint32_t*)dst);
+}
+
+static inline
+uint8_t const* get_i64_plain_wire(uint8_t const* it, int64_t* dst)
+{
+  return get_u64_plain_wire(it, (uint64_t*)dst);
+}
+
+static inline
+uint8_t const* get_float_plain_wire(uint8_t const* it, float* dst)
+{
+  uint32_t u = 0;
+  it = get_u32_plain_wire(it, &u);
+  memcpy(dst, &u, sizeof(u));
+  return it;
+}
+
+static inline
+uint8_t const* get_double_plain_wire(uint8_t const* it, double* dst)
+{
+  uint64_t u = 0;
+  it = get_u64_plain_wire(it, &u);
+  memcpy(dst, &u, sizeof(u));
+  return it;
+}
+
+// Any value other than 0 is true
+static inline
+uint8_t const* get_bool_plain_wire(uint8_t const* it, bool* dst)
+{
+  *dst = *it != 0;
+  return it + 1;
+}
+
+#define get_plain_wire(IT, DST) _Generic((DST), \
+                                  uint8_t*: get_u8_plain_wire, \
+                                  uint16_t*: get_u16_plain_wire, \
+                                  uint32_t*: get_u32_plain_wire, \
+                                  uint64_t*: get_u64_plain_wire, \
+                                  int8_t*: get_i8_plain_wire, \
+                                  int16_t*: get_i16_plain_wire, \
+                                  int32_t*: get_i32_plain_wire, \
+                                  int64_t*: get_i64_plain_wire, \
+                                  float*: get_float_plain_wire, \
+                                  double*: get_double_plain_wire, \
+                                  bool*: get_bool_plain_wire) (IT, DST)
+
+/////
+// Records
+/////
+
+#define PLAIN_WIRE_LEN_F(T, M) + sizeof(((T*)0)->M)
+
+// Bytes of a record of type T on the wire
+#define PLAIN_WIRE_LEN(T, FIELDS) (0 FIELDS(PLAIN_WIRE_LEN_F, PLAIN_WIRE_LEN_F, T))
+
+#define PLAIN_WIRE_MIRROR_F(T, M) __typeof__(((T*)0)->M) M;
+
+#define PLAIN_WIRE_OFFSET_F(T, M) _Static_assert(offsetof(T, M) == offsetof(struct T##_wire_mirror, M), \
+                                  "The FIELDS list of " #T " is not in declaration order");
+
+#define PLAIN_WIRE_HOST_F(T, M) && offsetof(T, M) == offsetof(struct T##_wire_packed, M) \
+                                && _Generic(((T*)0)->M, bool: 0, default: 1)
+
+#define PLAIN_WIRE_HOST_A(T, M) && offsetof(T, M) == offsetof(struct T##_wire_packed, M) \
+                                && _Generic(((T*)0)->M[0], bool: 0, default: 1)
+
+#define PLAIN_WIRE_LE_F(T, M) && _Generic(((T*)0)->M, bool: 0, default: 1)
+
+#define PLAIN_WIRE_LE_A(T, M) && _Generic(((T*)0)->M[0], bool: 0, default: 1)
+
+#define PLAIN_WIRE_CP_ENC_F(T, M) memcpy(it + offsetof(struct T##_wire_packed, M), &src->M, sizeof(src->M));
+
+#define PLAIN_WIRE_CP_DEC_F(T, M) memcpy(&dst->M, it + offsetof(struct T##_wire_packed, M), sizeof(dst->M));
+
+#define PLAIN_WIRE_ENC_F(T, M) it = put_plain_wire(it, src->M);
+
+#define PLAIN_WIRE_ENC_A(T, M) \
+  for(size_t i_ = 0; i_ < sizeof(src->M)/sizeof(src->M[0]); ++i_) \
+    it = put_plain_wire(it, src->M[i_]);
+
+#define PLAIN_WIRE_DEC_F(T, M) it = get_plain_wire(it, &dst->M);
+
+#define PLAIN_WIRE_DEC_A(T, M) \
+  for(size_t i_ = 0; i_ < sizeof(dst->M)/sizeof(dst->M[0]); ++i_) \
+    it = get_plain_wire(it, &dst->M[i_]);
+
+// Generates enc_<NAME>_rec_plain_wire() and dec_<NAME>_rec_plain_wire(),
+// which write and read the PLAIN_WIRE_LEN(T, FIELDS) bytes of a record. The
+// FIELDS list must name every field of T, in declaration order. Checked at
+// compile time
+#define PLAIN_WIRE_REC(NAME, T, FIELDS) \
+  struct T##_wire_mirror { FIELDS(PLAIN_WIRE_MIRROR_F, PLAIN_WIRE_MIRROR_F, T) }; \
+  _Static_assert(sizeof(struct T##_wire_mirror) == sizeof(T), "A field of " #T " is missing in its FIELDS list"); \
+  FIELDS(PLAIN_WIRE_OFFSET_F, PLAIN_WIRE_OFFSET_F, T) \
+  _Static_assert(PLAIN_WIRE_LEN(T, FIELDS) <= UINT16_MAX, "Record too long"); \
+  \
+  struct __attribute__((packed)) T##_wire_packed { FIELDS(PLAIN_WIRE_MIRROR_F, PLAIN_WIRE_MIRROR_F, T) }; \
+  enum { NAME##_host_plain_wire = __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__ \
+                                  FIELDS(PLAIN_WIRE_HOST_F, PLAIN_WIRE_HOST_A, T) }; \
+  enum { NAME##_le_plain_wire = __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__ \
+                                FIELDS(PLAIN_WIRE_LE_F, PLAIN_WIRE_LE_A, T) }; \
+  \
+  static inline \
+  uint8_t* enc_##NAME##_rec_plain_wire(uint8_t* it, T const* src) \
+  { \
+    if(NAME##_host_plain_wire){ \
+      memcpy(it, src, PLAIN_WIRE_LEN(T, FIELDS)); \
+      return it + PLAIN_WIRE_LEN(T, FIELDS); \
+    } \
+    if(NAME##_le_plain_wire){ \
+      FIELDS(PLAIN_WIRE_CP_ENC_F, PLAIN_WIRE_CP_ENC_F, T) \
+      return it + PLAIN_WIRE_LEN(T, FIELDS); \
+    } \
+    FIELDS(PLAIN_WIRE_ENC_F, PLAIN_WIRE_ENC_A, T) \
+    return it; \
+  } \
+  \
+  static inline \
+  uint8_t const* dec_##NAME##_rec_plain_wire(uint8_t const* it, T* dst) \
+  { \
+    if(NAME##_host_plain_wire){ \
+      memcpy(dst, it, PLAIN_WIRE_LEN(T, FIELDS)); \
+      return it + PLAIN_WIRE_LEN(T, FIELDS); \
+    } \
+    if(NAME##_le_plain_wire){ \
+      FIELDS(PLAIN_WIRE_CP_DEC_F, PLAIN_WIRE_CP_DEC_F, T) \
+      return it + PLAIN_WIRE_LEN(T, FIELDS); \
+    } \
+    FIELDS(PLAIN_WIRE_DEC_F, PLAIN_WIRE_DEC_A, T) \
+    return it; \
+  }
+
+/////
+// Messages
+/////
+
+static inline
+bool get_version_plain_wire(byte_reader_t* rd)
+{
+  uint8_t v = 0;
+  get_u8_byte_reader(rd, &v);
+  if(v != PLAIN_WIRE_VERSION){
+    fail_byte_reader(rd);
+    return false;
+  }
+  return true;
+}
+
+// Consumes a record of len_rec bytes, of which the reader knows len. Returns
+// the len bytes to decode: the input if complete, or tmp with the fields of
+// a newer version zeroed. NULL if corrupt
+static inline
+uint8_t const* get_rec_plain_wire(byte_reader_t* rd, uint16_t len_rec, size_t len, uint8_t tmp[len])
+{
+  uint8_t const* rec = rd->it;
+  if(len_rec == 0 || skip_byte_reader(rd, len_rec) == false){
+    fail_byte_reader(rd);
+    return NULL;
+  }
+
+  if(len_rec >= len)
+    return rec;
+
+  memcpy(tmp, rec, len_rec);
+  memset(tmp + len_rec, 0, len - len_rec);
+  return tmp;
+}
+
+// No section is defined yet, i.e., every section is skipped. Returns whether
+// the message ends well framed
+static inline
+bool skip_sections_plain_wire(byte_reader_t* rd)
+{
+  while(rd->err == false && left_byte_reader(rd) > 0){
+    uint16_t id = 0;
+    uint32_t len = 0;
+    get_u16_byte_reader(rd, &id);
+    get_u32_byte_reader(rd, &len);
+    skip_byte_reader(rd, len);
+  }
+  return done_byte_reader(rd);
+}
+
+// Generates, for IEs with a single record, e.g., the event trigger:
+//  byte_array_t enc_<NAME>_plain_wire(T const* src)
+//  bool dec_<NAME>_plain_wire(size_t len, uint8_t const buf[len], T* dst)
+// The decoder returns false, with dst zeroed, if corrupt or of another version
+#define PLAIN_WIRE_REC_MSG(NAME, T, FIELDS) \
+  PLAIN_WIRE_REC(NAME, T, FIELDS) \
+  \
+  static inline \
+  byte_array_t enc_##NAME##_plain_wire(T const* src) \
+  { \
+    assert(src != NULL); \
+    size_t const len_rec = PLAIN_WIRE_LEN(T, FIELDS); \
+    byte_array_t ba = {.len = PLAIN_WIRE_REC_MSG_HDR_LEN + len_rec}; \
+    ba.buf = malloc(ba.len); \
+    assert(ba.buf != NULL && "Memory exhausted"); \
+    \
+    uint8_t* it = put_u8_plain_wire(ba.buf, PLAIN_WIRE_VERSION); \
+    it = put_u16_plain_wire(it, len_rec); \
+    it = enc_##NAME##_rec_plain_wire(it, src); \
+    assert(it == ba.buf + ba.len && "Data layout mismatch"); \
+    return ba; \
+  } \
+  \
+  static inline \
+  bool dec_##NAME##_plain_wire(size_t len, uint8_t const buf[len], T* dst) \
+  { \
+    assert(dst != NULL); \
+    memset(dst, 0, sizeof(T)); \
+    byte_reader_t rd = init_byte_reader(len, buf); \
+    get_version_plain_wire(&rd); \
+    uint16_t len_rec = 0; \
+    get_u16_byte_reader(&rd, &len_rec); \
+    uint8_t tmp[PLAIN_WIRE_LEN(T, FIELDS)]; \
+    uint8_t const* rec = get_rec_plain_wire(&rd, len_rec, sizeof(tmp), tmp); \
+    if(rec == NULL || skip_sections_plain_wire(&rd) == false) \
+      return false; \
+    dec_##NAME##_rec_plain_wire(rec, dst); \
+    return true; \
+  }
+
+// Generates, for indication messages with an array of records ARR of LEN 
+// elements and a tstamp, e.g., the MAC UE statistics:
+//  byte_array_t enc_<NAME>_plain_wire(T const* src)
+//  bool dec_<NAME>_plain_wire(size_t len, uint8_t const buf[len], T* dst)
+// REC is the NAME of the PLAIN_WIRE_REC of the elements, which are
+// allocated with calloc(). The decoder returns false, with dst zeroed and 
+// nothing allocated, if corrupt or of another version
+#define PLAIN_WIRE_ARR_MSG(NAME, T, ARR, LEN, REC, REC_T, REC_FIELDS) \
+  static inline \
+  byte_array_t enc_##NAME##_plain_wire(T const* src) \
+  { \
+    assert(src != NULL); \
+    assert(src->LEN == 0 || src->ARR != NULL); \
+    size_t const len_rec = PLAIN_WIRE_LEN(REC_T, REC_FIELDS); \
+    byte_array_t ba = {.len = PLAIN_WIRE_ARR_MSG_HDR_LEN + len_rec*src->LEN}; \
+    ba.buf = malloc(ba.len); \
+    assert(ba.buf != NULL && "Memory exhausted"); \
+    \
+    uint8_t* it = put_u8_plain_wire(ba.buf, PLAIN_WIRE_VERSION); \
+    it = put_i64_plain_wire(it, src->tstamp); \
+    it = put_u16_plain_wire(it, len_rec); \
+    it = put_u32_plain_wire(it, src->LEN); \
+    for(size_t i = 0; i < src->LEN; ++i) \
+      it = enc_##REC##_rec_plain_wire(it, &src->ARR[i]); \
+    assert(it == ba.buf + ba.len && "Data layout mismatch"); \
+    return ba; \
+  } \
+  \
+  static inline \
+  bool dec_##NAME##_plain_wire(size_t len, uint8_t const buf[len], T* dst) \
+  { \
+    assert(dst != NULL); \
+    memset(dst, 0, sizeof(T)); \
+    byte_reader_t rd = init_byte_reader(len, buf); \
+    get_version_plain_wire(&rd); \
+    int64_t tstamp = 0; \
+    get_i64_byte_reader(&rd, &tstamp); \
+    uint16_t len_rec = 0; \
+    get_u16_byte_reader(&rd, &len_rec); \
+    uint32_t num = 0; \
+    get_u32_byte_reader(&rd, &num); \
+    if(len_rec == 0 || fits_byte_reader(&rd, num, len_rec) == false) \
+      return false; \
+    \
+    /* Every field is written below, either decoded or zeroed */ \
+    REC_T* arr = NULL; \
+    if(num > 0){ \
+      arr = malloc(num * sizeof(REC_T)); \
+      assert(arr != NULL && "Memory exhausted"); \
+    } \
+    uint8_t tmp[PLAIN_WIRE_LEN(REC_T, REC_FIELDS)]; \
+    if(len_rec >= sizeof(tmp)){ \
+      /* Checked by fits_byte_reader() */ \
+      for(size_t i = 0; i < num; ++i) \
+        dec_##REC##_rec_plain_wire(rd.it + i*len_rec, &arr[i]); \
+      skip_byte_reader(&rd, (size_t)num*len_rec); \
+    } else { \
+      for(size_t i = 0; i < num; ++i){ \
+        uint8_t const* rec = get_rec_plain_wire(&rd, len_rec, sizeof(tmp), tmp); \
+        dec_##REC##_rec_plain_wire(rec, &arr[i]); \
+      } \
+    } \
+    if(skip_sections_plain_wire(&rd) == false){ \
+      free(arr); \
+      return false; \
+    } \
+    dst->ARR = arr; \
+    dst->LEN = num; \
+    dst->tstamp = tstamp; \
+    return true; \
+  }
+
+#endif
@@ -0,0 +1,222 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+
+
+
+// Encoding and decoding time of the plain SM indication messages, e.g., 
+// ./bench_plain_dec | grep BENCH
+// Build it with -DCMAKE_BUILD_TYPE=Release to measure without sanitizers
+
+#include "../../sm/mac_sm/ie/mac_data_ie.h"
+#include "../../sm/mac_sm/enc/mac_enc_plain.h"
+#include "../../sm/mac_sm/dec/mac_dec_plain.h"
+#include "../../sm/rlc_sm/ie/rlc_data_ie.h"
+#include "../../sm/rlc_sm/enc/rlc_enc_plain.h"
+#include "../../sm/rlc_sm/dec/rlc_dec_plain.h"
+#include "../../sm/pdcp_sm/ie/pdcp_data_ie.h"
+#include "../../sm/pdcp_sm/enc/pdcp_enc_plain.h"
+#include "../../sm/pdcp_sm/dec/pdcp_dec_plain.h"
+#include "../../sm/gtp_sm/ie/gtp_data_ie.h"
+#include "../../sm/gtp_sm/enc/gtp_enc_plain.h"
+#include "../../sm/gtp_sm/dec/gtp_dec_plain.h"
+#include "../../sm/slice_sm/ie/slice_data_ie.h"
+#include "../../sm/slice_sm/enc/slice_enc_plain.h"
+#include "../../sm/slice_sm/dec/slice_dec_plain.h"
+#include "../../sm/tc_sm/ie/tc_data_ie.h"
+#include "../../sm/tc_sm/enc/tc_enc_plain.h"
+#include "../../sm/tc_sm/dec/tc_dec_plain.h"
+#include "../time_now_us.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NUM_UES 32
+#define NUM_ITER 200000
+
+// Deterministic, non zero content
+static
+void fill_bytes(void* dst, size_t len, uint32_t seed)
+{
+  uint8_t* p = dst;
+  for(size_t i = 0; i < len; ++i)
+    p[i] = (seed * 31 + i * 7) % 251;
+}
+
+#define BENCH_ENC_DEC(SM, MSG) do { \
+  int64_t const t0 = time_now_us(); \
+  for(size_t i = 0; i < NUM_ITER; ++i){ \
+    byte_array_t ba = SM##_enc_ind_msg_plain(&(MSG)); \
+    free_byte_array(ba); \
+  } \
+  int64_t const t1 = time_now_us(); \
+  byte_array_t ba = SM##_enc_ind_msg_plain(&(MSG)); \
+  for(size_t i = 0; i < NUM_ITER; ++i){ \
+    SM##_ind_msg_t msg = SM##_dec_ind_msg_plain(ba.len, ba.buf); \
+    free_##SM##_ind_msg(&msg); \
+  } \
+  int64_t const t2 = time_now_us(); \
+  printf("[BENCH]: %-5s %5lu bytes enc %6.1f ns/msg dec %6.1f ns/msg \n", #SM, ba.len, \
+         1000.0 * (t1 - t0) / NUM_ITER, 1000.0 * (t2 - t1) / NUM_ITER); \
+  free_byte_array(ba); \
+} while(0)
+
+static
+void bench_mac(void)
+{
+  mac_ue_stats_impl_t ue[NUM_UES];
+  fill_bytes(ue, sizeof(ue), 1);
+  mac_ind_msg_t msg = {.len_ue_stats = NUM_UES, .ue_stats = ue, .tstamp = 42};
+  BENCH_ENC_DEC(mac, msg);
+}
+
+static
+void bench_rlc(void)
+{
+  rlc_radio_bearer_stats_t rb[NUM_UES];
+  fill_bytes(rb, sizeof(rb), 2);
+  rlc_ind_msg_t msg = {.len = NUM_UES, .rb = rb, .tstamp = 42};
+  BENCH_ENC_DEC(rlc, msg);
+}
+
+// Random bytes break the invariants that free_pdcp_ind_msg() asserts, 
+// e.g., the mode or the packets bounded by the bytes
+static
+void fill_pdcp_ind_data(pdcp_ind_msg_t* msg, uint32_t seed)
+{
+  for(uint32_t i = 0; i < msg->len; ++i){
+    pdcp_radio_bearer_stats_t* rb = &msg->rb[i];
+    fill_bytes(rb, sizeof(*rb), seed + i);
+
+    rb->txpdu_bytes = rb->txpdu_pkts + 1500 * (i + 1);
+    rb->rxpdu_bytes = rb->rxpdu_pkts + 1500 * (i + 1);
+    rb->txsdu_bytes = rb->txsdu_pkts + 1400 * (i + 1);
+    rb->rxsdu_bytes = rb->rxsdu_pkts + 1400 * (i + 1);
+    rb->mode = i % 3;
+    rb->rbid = i % 11;
+  }
+}
+
+static
+void bench_pdcp(void)
+{
+  pdcp_radio_bearer_stats_t rb[NUM_UES];
+  pdcp_ind_msg_t msg = {.len = NUM_UES, .rb = rb, .tstamp = 42};
+  fill_pdcp_ind_data(&msg, 3);
+  BENCH_ENC_DEC(pdcp, msg);
+}
+
+static
+void bench_gtp(void)
+{
+  gtp_ngu_t_stats_t ngut[NUM_UES];
+  fill_bytes(ngut, sizeof(ngut), 4);
+  gtp_ind_msg_t msg = {.len = NUM_UES, .ngut = ngut, .tstamp = 42};
+  BENCH_ENC_DEC(gtp, msg);
+}
+
+static
+void bench_slice(void)
+{
+  char label[] = "slice";
+  char sched[] = "pf";
+  fr_slice_t slc[4] = {0};
+  for(uint32_t i = 0; i < 4; ++i){
+    slc[i].id = i;
+    slc[i].len_label = strlen(label);
+    slc[i].label = label;
+    slc[i].len_sched = strlen(sched);
+    slc[i].sched = sched;
+    slc[i].params.type = SLICE_ALG_SM_V0_STATIC;
+    slc[i].params.u.sta.pos_low = 5*i;
+    slc[i].params.u.sta.pos_high = 5*i + 4;
+  }
+
+  ue_slice_assoc_t ues[NUM_UES] = {0};
+  for(uint32_t i = 0; i < NUM_UES; ++i)
+    ues[i] = (ue_slice_assoc_t){.dl_id = i % 4, .ul_id = i % 4, .rnti = 1000 + i};
+
+  char sched_name[] = "static";
+  slice_ind_msg_t msg = {0};
+  msg.slice_conf.dl = (ul_dl_slice_conf_t){.len_slices = 4, .slices = slc, .len_sched_name = strlen(sched_name), .sched_name = sched_name};
+  msg.slice_conf.ul = (ul_dl_slice_conf_t){.len_slices = 4, .slices = slc, .len_sched_name = strlen(sched_name), .sched_name = sched_name};
+  msg.ue_slice_conf = (ue_slice_conf_t){.len_ue_slice = NUM_UES, .ues = ues};
+  msg.tstamp = 42;
+  BENCH_ENC_DEC(slice, msg);
+}
+
+// One queue, shaper and policer per UE, with the three queue types
+static
+void bench_tc(void)
+{
+  tc_cls_osi_filter_t flt[4] = {0};
+  for(uint32_t i = 0; i < 4; ++i){
+    flt[i].id = i;
+    flt[i].l3 = (L3_filter_t){.src_addr = -1, .dst_addr = 0x0a000001 + i};
+    flt[i].l4 = (L4_filter_t){.src_port = -1, .dst_port = 5000 + i, .protocol = 17};
+    flt[i].dst_queue = i;
+  }
+
+  tc_queue_t q[NUM_UES] = {0};
+  tc_shp_t shp[NUM_UES] = {0};
+  tc_plc_t plc[NUM_UES] = {0};
+  for(uint32_t i = 0; i < NUM_UES; ++i){
+    q[i].id = i;
+    q[i].type = i % TC_QUEUE_END;
+    if(q[i].type == TC_QUEUE_FIFO)
+      q[i].fifo = (tc_queue_fifo_t){.bytes = 1500*i, .pkts = i, .drp.dropped_pkts = i/2, .avg_sojourn_time = 1.5, .last_sojourn_time = 42};
+    else if(q[i].type == TC_QUEUE_CODEL)
+      q[i].codel = (tc_queue_codel_t){.bytes = 1500*i, .pkts = i, .drp.dropped_pkts = i/2, .avg_sojourn_time = 2.5, .last_sojourn_time = 42};
+    else
+      q[i].ecn = (tc_queue_ecn_codel_t){.bytes = 1500*i, .pkts = i, .mrk.marked_pkts = i/2, .avg_sojourn_time = 3.5, .last_sojourn_time = 42};
+
+    shp[i] = (tc_shp_t){.id = i, .active = 1, .max_rate_kbps = 10000, .mtr = {.time_window_ms = 100, .bnd_flt = 1.0}};
+    plc[i] = (tc_plc_t){.id = i, .mtr = {.time_window_ms = 100, .bnd_flt = 2.0}, .max_rate_kbps = 20000.0, .active = 1, .dst_id = i, .dev_id = 0};
+  }
+
+  tc_ind_msg_t msg = {0};
+  msg.sch.type = TC_SCHED_RR;
+  msg.pcr = (tc_pcr_t){.type = TC_PCR_5G_BDP, .id = 1, .mtr = {.time_window_ms = 100, .bnd_flt = 3.0}};
+  msg.cls.type = TC_CLS_OSI;
+  msg.cls.osi = (tc_cls_osi_t){.len = 4, .flt = flt};
+  msg.len_q = NUM_UES;
+  msg.q = q;
+  msg.shp = shp;
+  msg.plc = plc;
+  msg.tstamp = 42;
+  BENCH_ENC_DEC(tc, msg);
+}
+
+int main()
+{
+  bench_mac();
+  bench_rlc();
+  bench_pdcp();
+  bench_gtp();
+  bench_slice();
+  bench_tc();
+
+  printf("Success\n");
+  return EXIT_SUCCESS;
+}
+
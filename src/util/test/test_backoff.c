@@ -0,0 +1,118 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+#include "../backoff.h"
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+static
+void test_bounds(void)
+{
+  backoff_t b = {0};
+  init_backoff(&b, 100, 1000);
+
+  // 100, 200, 400, 800 and then the cap
+  int64_t const ceil_ms[] = {100, 200, 400, 800, 1000, 1000, 1000};
+  for(size_t i = 0; i < sizeof(ceil_ms)/sizeof(ceil_ms[0]); ++i){
+    int64_t const d = next_backoff(&b);
+    assert(d >= 25 && d <= ceil_ms[i]);
+  }
+
+  // Stays at the cap, without overflowing
+  for(int i = 0; i < 10000; ++i){
+    int64_t const d = next_backoff(&b);
+    assert(d >= 25 && d <= 1000);
+  }
+
+  // Back to the base after a successful setup
+  for(int i = 0; i < 1000; ++i){
+    reset_backoff(&b);
+    int64_t const d = next_backoff(&b);
+    assert(d >= 25 && d <= 100);
+  }
+}
+
+static
+void test_conf(void)
+{
+  backoff_t b = {0};
+  init_conf_backoff(&b, NULL);
+  assert(b.base_ms == BASE_MS_BACKOFF && b.max_ms == MAX_MS_BACKOFF);
+
+  init_conf_backoff(&b, "base=500;max=10000");
+  assert(b.base_ms == 500 && b.max_ms == 10000);
+
+  init_conf_backoff(&b, "base=500");
+  assert(b.base_ms == 500 && b.max_ms == MAX_MS_BACKOFF);
+
+  init_conf_backoff(&b, "max=20;base=20");
+  assert(b.base_ms == 20 && b.max_ms == 20);
+  for(int i = 0; i < 100; ++i){
+    int64_t const d = next_backoff(&b);
+    assert(d >= 5 && d <= 20);
+  }
+}
+
+// The E2 Nodes that lost the nearRT-RIC at the same instant do not retry
+// in lockstep, i.e., the delays spread over [floor, ceil]
+static
+void test_spread(void)
+{
+  enum { NUM_PEERS = 512, CEIL_MS = 1000, NUM_BINS = 10 };
+
+  backoff_t* b = calloc(NUM_PEERS, sizeof(backoff_t));
+  assert(b != NULL && "Memory exhausted");
+  for(size_t i = 0; i < NUM_PEERS; ++i)
+    init_backoff(&b[i], CEIL_MS, CEIL_MS);
+
+  int64_t const floor_ms = floor_backoff(&b[0]);
+  int64_t const range_ms = CEIL_MS - floor_ms + 1;
+  size_t bins[NUM_BINS] = {0};
+  int64_t sum = 0;
+  for(size_t i = 0; i < NUM_PEERS; ++i){
+    int64_t const d = next_backoff(&b[i]);
+    assert(d >= floor_ms && d <= CEIL_MS);
+    bins[(d - floor_ms) * NUM_BINS / range_ms] += 1;
+    sum += d;
+  }
+
+  // Uniform: ~51 per bin, and a mean of ~625 ms
+  for(size_t i = 0; i < NUM_BINS; ++i)
+    assert(bins[i] > 15 && bins[i] < 110);
+  int64_t const mean = sum / NUM_PEERS;
+  assert(mean > 525 && mean < 725);
+  printf("Mean first retry of %d peers = %ld ms\n", NUM_PEERS, mean);
+
+  free(b);
+}
+
+int main()
+{
+  test_bounds();
+  test_conf();
+  test_spread();
+
+  printf("Success\n");
+  return EXIT_SUCCESS;
+}
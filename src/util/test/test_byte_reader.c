@@ -0,0 +1,221 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+
+
+
+#include "../byte_reader.h"
+#include "../plain_wire.h"
+#include "../../sm/mac_sm/ie/mac_data_ie.h"
+#include "../../sm/mac_sm/enc/mac_enc_plain.h"
+#include "../../sm/mac_sm/dec/mac_dec_plain.h"
+#include "../../sm/slice_sm/ie/slice_data_ie.h"
+#include "../../sm/slice_sm/enc/slice_enc_plain.h"
+#include "../../sm/slice_sm/dec/slice_dec_plain.h"
+#include "../../sm/tc_sm/ie/tc_data_ie.h"
+#include "../../sm/tc_sm/enc/tc_enc_plain.h"
+#include "../../sm/tc_sm/dec/tc_dec_plain.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static
+void test_scalars(void)
+{
+  uint8_t const buf[] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x00, 0x02};
+  byte_reader_t rd = init_byte_reader(sizeof(buf), buf);
+
+  uint16_t u16 = 0;
+  get_byte_reader(&rd, &u16);
+  assert(u16 == 0x0201);
+
+  uint32_t u32 = 0;
+  get_byte_reader(&rd, &u32);
+  assert(u32 == 0x06050403);
+
+  uint8_t u8 = 0;
+  get_byte_reader(&rd, &u8);
+  assert(u8 == 0x07);
+
+  bool b = true;
+  get_byte_reader(&rd, &b);
+  assert(b == true);
+  get_byte_reader(&rd, &b);
+  assert(b == false);
+
+  assert(left_byte_reader(&rd) == 1);
+  assert(done_byte_reader(&rd) == false);
+  get_byte_reader(&rd, &b);
+  assert(b == true);
+  assert(done_byte_reader(&rd) == true);
+}
+
+static
+void test_truncated(void)
+{
+  uint8_t const buf[] = {0xFF, 0xFF, 0xFF};
+  byte_reader_t rd = init_byte_reader(sizeof(buf), buf);
+
+  // Not enough bytes. The destination is zeroed and the error sticks
+  uint32_t u32 = 42;
+  get_byte_reader(&rd, &u32);
+  assert(u32 == 0);
+  assert(rd.err == true);
+  assert(left_byte_reader(&rd) == 0);
+
+  uint8_t u8 = 42;
+  get_byte_reader(&rd, &u8);
+  assert(u8 == 0);
+  assert(done_byte_reader(&rd) == false);
+
+  byte_reader_t empty_rd = init_byte_reader(0, NULL);
+  assert(done_byte_reader(&empty_rd) == true);
+}
+
+static
+void test_fits(void)
+{
+  uint8_t const buf[16] = {0};
+  byte_reader_t rd = init_byte_reader(sizeof(buf), buf);
+
+  assert(fits_byte_reader(&rd, 4, 4) == true);
+  assert(rd.err == false);
+
+  // num*sz overflows a size_t
+  assert(fits_byte_reader(&rd, SIZE_MAX/2, 4) == false);
+  assert(rd.err == true);
+
+  rd = init_byte_reader(sizeof(buf), buf);
+  assert(fits_byte_reader(&rd, 5, 4) == false);
+  assert(rd.err == true);
+}
+
+static
+void test_mac(void)
+{
+  mac_ue_stats_impl_t ue[2] = {0};
+  ue[0].rnti = 1234;
+  ue[1].rnti = 4321;
+  mac_ind_msg_t msg = {.len_ue_stats = 2, .ue_stats = ue, .tstamp = 42};
+  byte_array_t ba = mac_enc_ind_msg_plain(&msg);
+
+  mac_ind_msg_t ok = mac_dec_ind_msg_plain(ba.len, ba.buf);
+  assert(ok.len_ue_stats == 2);
+  assert(ok.ue_stats[1].rnti == 4321);
+  assert(ok.tstamp == 42);
+  free_mac_ind_msg(&ok);
+
+  // Truncated
+  mac_ind_msg_t trunc = mac_dec_ind_msg_plain(ba.len - 1, ba.buf);
+  assert(trunc.len_ue_stats == 0 && trunc.ue_stats == NULL);
+
+  // The number of UEs, after the version, tstamp and record length, does not
+  // match the bytes
+  uint32_t const huge = UINT32_MAX;
+  memcpy(ba.buf + PLAIN_WIRE_ARR_MSG_HDR_LEN - sizeof(huge), &huge, sizeof(huge));
+  mac_ind_msg_t lie = mac_dec_ind_msg_plain(ba.len, ba.buf);
+  assert(lie.len_ue_stats == 0 && lie.ue_stats == NULL);
+
+  free_byte_array(ba);
+}
+
+static
+void test_slice(void)
+{
+  char label[] = "slice";
+  char sched[] = "edf";
+  uint32_t over[2] = {1, 2};
+  fr_slice_t slc = {.id = 7, .len_label = strlen(label), .label = label,
+                    .len_sched = strlen(sched), .sched = sched,
+                    .params.type = SLICE_ALG_SM_V0_EDF,
+                    .params.u.edf = {.deadline = 10, .len_over = 2, .over = over}};
+
+  ue_slice_assoc_t ues[1] = {{.dl_id = 7, .ul_id = 7, .rnti = 1000}};
+  char sched_name[] = "edf";
+  slice_ind_msg_t msg = {0};
+  msg.slice_conf.dl = (ul_dl_slice_conf_t){.len_slices = 1, .slices = &slc, .len_sched_name = strlen(sched_name), .sched_name = sched_name};
+  msg.ue_slice_conf = (ue_slice_conf_t){.len_ue_slice = 1, .ues = ues};
+  msg.tstamp = 42;
+  byte_array_t ba = slice_enc_ind_msg_plain(&msg);
+
+  slice_ind_msg_t ok = slice_dec_ind_msg_plain(ba.len, ba.buf);
+  assert(ok.slice_conf.dl.len_slices == 1);
+  assert(strcmp(ok.slice_conf.dl.slices[0].label, label) == 0);
+  assert(ok.slice_conf.dl.slices[0].params.u.edf.over[1] == 2);
+  assert(ok.ue_slice_conf.ues[0].rnti == 1000);
+  assert(ok.tstamp == 42);
+  free_slice_ind_msg(&ok);
+
+  // Every truncation frees what was decoded, i.e., ASan reports no leak
+  for(size_t len = 0; len < ba.len; ++len){
+    slice_ind_msg_t trunc = slice_dec_ind_msg_plain(len, ba.buf);
+    assert(trunc.slice_conf.dl.len_slices == 0 && trunc.slice_conf.dl.slices == NULL);
+    assert(trunc.ue_slice_conf.len_ue_slice == 0 && trunc.ue_slice_conf.ues == NULL);
+  }
+
+  free_byte_array(ba);
+}
+
+static
+void test_tc(void)
+{
+  uint32_t q_prio[2] = {0, 1};
+  tc_ctrl_msg_t msg = {.type = TC_CTRL_SM_V0_SCH};
+  msg.sch.act = TC_CTRL_ACTION_SM_V0_MOD;
+  msg.sch.mod = (tc_mod_ctrl_sch_t){.type = TC_SCHED_PRIO, .prio = {.len_q_prio = 2, .q_prio = q_prio}};
+  byte_array_t ba = tc_enc_ctrl_msg_plain(&msg);
+
+  tc_ctrl_msg_t ok = tc_dec_ctrl_msg_plain(ba.len, ba.buf);
+  assert(ok.type == TC_CTRL_SM_V0_SCH && ok.sch.act == TC_CTRL_ACTION_SM_V0_MOD);
+  assert(ok.sch.mod.type == TC_SCHED_PRIO && ok.sch.mod.prio.len_q_prio == 2);
+  assert(ok.sch.mod.prio.q_prio[1] == 1);
+  free_tc_ctrl_msg(&ok);
+
+  for(size_t len = 0; len < ba.len; ++len){
+    tc_ctrl_msg_t trunc = tc_dec_ctrl_msg_plain(len, ba.buf);
+    assert(trunc.type == TC_CTRL_SM_V0_CLS);
+    free_tc_ctrl_msg(&trunc);
+  }
+
+  // Unknown scheduler type, after the version, the type and the action
+  uint32_t const type = TC_SCHED_END;
+  memcpy(ba.buf + sizeof(uint8_t) + 2*sizeof(uint32_t), &type, sizeof(type));
+  tc_ctrl_msg_t unk = tc_dec_ctrl_msg_plain(ba.len, ba.buf);
+  assert(unk.type == TC_CTRL_SM_V0_CLS);
+  free_tc_ctrl_msg(&unk);
+
+  free_byte_array(ba);
+}
+
+int main()
+{
+  test_scalars();
+  test_truncated();
+  test_fits();
+  test_mac();
+  test_slice();
+  test_tc();
+
+  printf("Success\n");
+  return EXIT_SUCCESS;
+}
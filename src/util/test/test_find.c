@@ -0,0 +1,115 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+
+#include "../alg_ds/alg/find.h"
+#include "../alg_ds/ds/assoc_container/bimap.h"
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// E.g., the pending events of the xApp. left: fd | right: event
+typedef struct{
+  int type;
+  uint32_t id;
+} ev_t;
+
+static
+int cmp_int(void const* a_v, void const* b_v)
+{
+  int const a = *(int const*)a_v;
+  int const b = *(int const*)b_v;
+  return (a > b) - (a < b);
+}
+
+static
+int cmp_ev(void const* a_v, void const* b_v)
+{
+  ev_t const* a = (ev_t const*)a_v;
+  ev_t const* b = (ev_t const*)b_v;
+  if(a->type != b->type)
+    return (a->type > b->type) - (a->type < b->type);
+  return (a->id > b->id) - (a->id < b->id);
+}
+
+static
+bool eq_int(void const* value, void const* key)
+{
+  return cmp_int(value, key) == 0;
+}
+
+static
+bool eq_ev(void const* value, void const* key)
+{
+  return cmp_ev(value, key) == 0;
+}
+
+static
+void free_key(void* key, void* value)
+{
+  (void)key;
+  free(value);
+}
+
+// The predicate receives the key on both sides of the bimap. The right
+// side used to receive the tree node, i.e., it never matched
+static
+void test_bi_map_find(void)
+{
+  bi_map_t m = {0};
+  bi_map_init(&m, sizeof(int), sizeof(ev_t), cmp_int, cmp_ev, free_key, free_key);
+
+  for(int fd = 3; fd < 67; ++fd){
+    ev_t const ev = {.type = fd % 3, .id = 1000 + fd};
+    bi_map_insert(&m, &fd, sizeof(fd), &ev, sizeof(ev));
+  }
+
+  for(int fd = 3; fd < 67; ++fd){
+    ev_t const ev = {.type = fd % 3, .id = 1000 + fd};
+    bmr_iter_t const r = find_if_bi_map_right(&m, bi_map_front_right(&m), bi_map_end_right(&m), &ev, eq_ev);
+    assert(r.it != bi_map_end_right(&m).it);
+    assert(*(int*)assoc_rb_tree_value(&m.right, r.it) == fd);
+
+    bml_iter_t const l = find_if_bi_map_left(&m, bi_map_front_left(&m), bi_map_end_left(&m), &fd, eq_int);
+    assert(l.it != bi_map_end_left(&m).it);
+    assert(cmp_ev(assoc_rb_tree_value(&m.left, l.it), &ev) == 0);
+  }
+
+  ev_t const absent = {.type = 1, .id = 1003};
+  bmr_iter_t const r = find_if_bi_map_right(&m, bi_map_front_right(&m), bi_map_end_right(&m), &absent, eq_ev);
+  assert(r.it == bi_map_end_right(&m).it);
+
+  int const fd = 67;
+  bml_iter_t const l = find_if_bi_map_left(&m, bi_map_front_left(&m), bi_map_end_left(&m), &fd, eq_int);
+  assert(l.it == bi_map_end_left(&m).it);
+
+  bi_map_free(&m);
+}
+
+int main()
+{
+  test_bi_map_find();
+
+  printf("[FIND]: Test passed\n");
+  return EXIT_SUCCESS;
+}
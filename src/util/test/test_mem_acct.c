@@ -0,0 +1,218 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+// Compiled as part of the RIC component, i.e., MEM_ACCT_TAG=RIC, with 
+// mem_acct_alloc.h force included
+
+#include "../mem_acct.h"
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static
+void test_alloc(void)
+{
+  mem_acct_stats_t const st = stats_mem_acct(MEM_ACCT_RIC);
+  assert(st.live_bytes == 0 && st.live_allocs == 0);
+
+  char* a = malloc(100);
+  int* b = calloc(10, sizeof(int));
+  char* c = strdup("flexric");
+  assert(a != NULL && b != NULL && c != NULL);
+
+  mem_acct_stats_t st2 = stats_mem_acct(MEM_ACCT_RIC);
+  assert(st2.live_bytes == 100 + 10*sizeof(int) + 8);
+  assert(st2.live_allocs == 3);
+  assert(st2.total_allocs == st.total_allocs + 3);
+
+  a = realloc(a, 1000);
+  assert(a != NULL);
+  st2 = stats_mem_acct(MEM_ACCT_RIC);
+  assert(st2.live_bytes == 1000 + 10*sizeof(int) + 8);
+  assert(st2.live_allocs == 3);
+  assert(st2.peak_bytes == st2.live_bytes);
+
+  free(a);
+  free(b);
+  free(c);
+  free(NULL);
+
+  st2 = stats_mem_acct(MEM_ACCT_RIC);
+  assert(st2.live_bytes == 0 && st2.live_allocs == 0);
+}
+
+static
+void test_cross_component(void)
+{
+  // As allocated within an SM and freed by the nearRT-RIC
+  void* p = malloc_mem_acct_KPM_SM(64);
+  assert(stats_mem_acct(MEM_ACCT_KPM_SM).live_bytes == 64);
+
+  free(p);
+  assert(stats_mem_acct(MEM_ACCT_KPM_SM).live_bytes == 0);
+  assert(stats_mem_acct(MEM_ACCT_KPM_SM).total_allocs == 1);
+  assert(stats_mem_acct(MEM_ACCT_RIC).live_allocs == 0);
+
+  // free as a function pointer is accounted too
+  void (*free_fp)(void*) = free;
+  free_fp(malloc(8));
+  assert(stats_mem_acct(MEM_ACCT_RIC).live_allocs == 0);
+}
+
+static
+void test_untracked(void)
+{
+  // Allocated by libc, freed through free_mem_acct()
+  char* buf = NULL;
+  size_t len = 0;
+  FILE* f = open_memstream(&buf, &len);
+  assert(f != NULL);
+  fprintf(f, "not accounted");
+  fclose(f);
+
+  free(buf);
+  assert(stats_mem_acct(MEM_ACCT_RIC).live_allocs == 0);
+}
+
+static
+void test_many(void)
+{
+  // Enough to grow the shards, freed in another order than allocated 
+  size_t const len = 20000;
+  void** arr = calloc(len, sizeof(void*));
+  assert(arr != NULL);
+  for(size_t i = 0; i < len; ++i){
+    arr[i] = malloc(i % 64 + 1);
+    assert(arr[i] != NULL);
+  }
+  assert(stats_mem_acct(MEM_ACCT_RIC).live_allocs == (int64_t)len + 1);
+
+  for(size_t i = 0; i < len; i += 2)
+    free(arr[i]);
+  for(size_t i = 1; i < len; i += 2)
+    free(arr[len - i]);
+  free(arr);
+
+  mem_acct_stats_t const st = stats_mem_acct(MEM_ACCT_RIC);
+  assert(st.live_bytes == 0 && st.live_allocs == 0);
+}
+
+static
+void* churn(void* arg)
+{
+  unsigned seed = (unsigned)(size_t)arg;
+  void* live[64] = {0};
+  for(int i = 0; i < 50000; ++i){
+    size_t const j = rand_r(&seed) % 64;
+    if(live[j] == NULL)
+      live[j] = malloc(rand_r(&seed) % 512 + 1);
+    else if(rand_r(&seed) % 2)
+      live[j] = realloc(live[j], rand_r(&seed) % 512 + 1);
+    else{
+      free(live[j]);
+      live[j] = NULL;
+    }
+    assert(i % 64 != 0 || stats_mem_acct(MEM_ACCT_RIC).live_allocs >= 0);
+  }
+  for(size_t j = 0; j < 64; ++j)
+    free(live[j]);
+  return NULL;
+}
+
+static
+void test_threads(void)
+{
+  pthread_t t[4];
+  for(size_t i = 0; i < 4; ++i){
+    int const rc = pthread_create(&t[i], NULL, churn, (void*)(i + 1));
+    assert(rc == 0);
+  }
+  for(size_t i = 0; i < 4; ++i){
+    int const rc = pthread_join(t[i], NULL);
+    assert(rc == 0);
+  }
+
+  mem_acct_stats_t const st = stats_mem_acct(MEM_ACCT_RIC);
+  assert(st.live_bytes == 0 && st.live_allocs == 0);
+}
+
+static
+void* leak_one(size_t sz)
+{
+  return malloc(sz);
+}
+
+static
+void test_report(void)
+{
+  void* p = leak_one(333);
+  void* q = leak_one(333);
+
+  char* buf = NULL;
+  size_t len = 0;
+  FILE* f = open_memstream(&buf, &len);
+  assert(f != NULL);
+  int64_t const live = print_sites_mem_acct("TEST", 8, f);
+  fclose(f);
+  assert(live == 666);
+  // Both from the same call site
+  assert(strstr(buf, "[TEST]: RIC 666 B in 2 allocs at test_mem_acct+0x") != NULL);
+  free(buf);
+
+  f = open_memstream(&buf, &len);
+  assert(f != NULL);
+  report_leaks_mem_acct("TEST", f);
+  fclose(f);
+  assert(strstr(buf, "[TEST]: Memory leaks, 666 B in 2 allocs") != NULL);
+  assert(strstr(buf, "[TEST]: memory RIC live 666 B in 2 allocs") != NULL);
+  assert(strstr(buf, "[TEST]: memory KPM_SM live 0 B in 0 allocs, peak 64 B, 1 allocs") != NULL);
+  free(buf);
+
+  free(p);
+  free(q);
+
+  f = open_memstream(&buf, &len);
+  assert(f != NULL);
+  report_leaks_mem_acct("TEST", f);
+  fclose(f);
+  assert(strcmp(buf, "[TEST]: No memory leaks\n") == 0);
+  free(buf);
+}
+
+int main()
+{
+  assert(enabled_mem_acct() == true);
+  assert(strcmp(tag_str_mem_acct(MEM_ACCT_SLICE_SM), "SLICE_SM") == 0);
+
+  test_alloc();
+  test_cross_component();
+  test_untracked();
+  test_many();
+  test_threads();
+  test_report();
+
+  print_mem_acct("TEST", stdout);
+  printf("Success\n");
+  return EXIT_SUCCESS;
+}
@@ -20,18 +20,63 @@
  */
 
 
+
+
 #include "act_proc.h"
 #include "../util/alg_ds/ds/lock_guard/lock_guard.h"
-#include "../util/alg_ds/alg/find.h"
+#include "../util/alg_ds/alg/alg.h"
 
 
 #include <assert.h>
 #include <pthread.h>
+#include <stdlib.h>
+
+static
+int cmp_ric_req_id(void const* m0_v, void const* m1_v)
+{
+  assert(m0_v != NULL);
+  assert(m1_v != NULL);
+
+  uint16_t const* m0 = (uint16_t const*)m0_v;
+  uint16_t const* m1 = (uint16_t const*)m1_v;
+
+  if(*m0 < *m1) 
+    return 1;
+
+  if(*m0 > *m1) 
+    return -1;
+
+  return 0;
+}
+
+static
+bool eq_ric_req_id(void const* m0_v, void const* m1_v)
+{
+  assert(m0_v != NULL);
+  assert(m1_v != NULL);
+
+  uint16_t const* m0 = (uint16_t const*)m0_v;
+  uint16_t const* m1 = (uint16_t const*)m1_v;
+
+  return *m0 == *m1;
+}
+
+static
+void free_act_proc_key_val(void* key, void* value)
+{
+  assert(key != NULL);
+  assert(value != NULL);
+
+  free(key);
+  free_act_proc_val(value);
+  free(value);
+}
 
 void init_act_proc(act_proc_t* p)
 {
   assert(p != NULL);
-  assoc_reg_init(&p->reg, sizeof(act_proc_val_t ));
+  assoc_init(&p->tree, sizeof(uint16_t), cmp_ric_req_id, free_act_proc_key_val);
+  p->next_id = 1;
 
   pthread_mutexattr_t *mtx_attr = NULL;
 #ifdef DEBUG
@@ -46,7 +91,7 @@ void free_act_proc(act_proc_t* p)
 {
   assert(p != NULL);
 
-  assoc_reg_free(&p->reg);
+  assoc_free(&p->tree);
 
   int rc = pthread_mutex_destroy(&p->mtx);
   assert(rc == 0);
@@ -71,6 +116,34 @@ bool valid_proc_type(act_proc_val_e type)
   return false;
 }
 
+static
+act_proc_val_t* find_val(act_proc_t* p, uint16_t ric_req_id)
+{
+  void* it = assoc_front(&p->tree);
+  void* end = assoc_end(&p->tree);
+
+  it = find_if(&p->tree, it, end, &ric_req_id, eq_ric_req_id);
+  if(it == end)
+    return NULL;
+
+  return assoc_value(&p->tree, it);
+}
+
+// The IDs wrap below ASYNC_CTRL_RIC_REQ_ID skipping the ones still in use,
+// e.g., long lived subscriptions
+static
+uint16_t next_ric_req_id(act_proc_t* p)
+{
+  assert(assoc_size(&p->tree) < ASYNC_CTRL_RIC_REQ_ID - 1 && "RIC request IDs exhausted");
+
+  uint16_t id = p->next_id;
+  while(find_val(p, id) != NULL)
+    id = id + 1 == ASYNC_CTRL_RIC_REQ_ID ? 1 : id + 1;
+
+  p->next_id = id + 1 == ASYNC_CTRL_RIC_REQ_ID ? 1 : id + 1;
+  return id;
+}
+
 uint32_t add_act_proc(act_proc_t* p, act_proc_val_e type, ric_gen_id_t id, global_e2_node_id_t const* e2_node, void(*sm_cb)(sm_ag_if_rd_t const *))
 {
   assert(p != NULL);
@@ -78,13 +151,19 @@ uint32_t add_act_proc(act_proc_t* p, act_proc_val_e type, ric_gen_id_t id, globa
 
   lock_guard(&p->mtx);
 
-  act_proc_val_t val = {  .type = type, 
-                          .id = id,
-                          .sm_cb = sm_cb,
-                          .e2_node = cp_global_e2_node_id(e2_node)
-                        };
+  uint16_t const ric_req_id = next_ric_req_id(p);
+
+  act_proc_val_t* val = calloc(1, sizeof(act_proc_val_t));
+  assert(val != NULL && "Memory exhausted");
+  *val = (act_proc_val_t){ .type = type, 
+                           .id = id,
+                           .sm_cb = sm_cb,
+                           .e2_node = cp_global_e2_node_id(e2_node),
+                           .failed = false
+                         };
+  val->id.ric_req_id = ric_req_id;
 
-  uint32_t const ric_req_id = assoc_reg_push_back(&p->reg, &val, sizeof(act_proc_val_t));
+  assoc_insert(&p->tree, &ric_req_id, sizeof(uint16_t), val);
   return ric_req_id; 
 }
 
@@ -93,13 +172,10 @@ void rm_act_proc(act_proc_t* p, uint16_t ric_req_id )
   assert(p != NULL);
   lock_guard(&p->mtx);
 
-  void* it = assoc_reg_front(&p->reg);
-  void* end = assoc_reg_end(&p->reg);
-
-  it = find_reg(&p->reg, it, end, ric_req_id );
-  assert(it != end && "ric_req_id key value not found in the registry" );
-  void* next = assoc_reg_next(&p->reg, it);
-  assoc_reg_erase(&p->reg, it, next, free_act_proc_val);
+  assert(find_val(p, ric_req_id) != NULL && "ric_req_id key value not found in the registry" );
+  act_proc_val_t* val = assoc_extract(&p->tree, &ric_req_id);
+  free_act_proc_val(val);
+  free(val);
 }
 
 act_proc_ans_t find_act_proc(act_proc_t* act, uint16_t ric_req_id)
@@ -107,25 +183,27 @@ act_proc_ans_t find_act_proc(act_proc_t* act, uint16_t ric_req_id)
   assert(act != NULL);
   lock_guard(&act->mtx);
 
-  void* it = assoc_reg_front(&act->reg);
-  void* end = assoc_reg_end(&act->reg);
-
-  it = find_reg(&act->reg, it, end, ric_req_id );
-
-  if(it == end){
+  act_proc_val_t const* val = find_val(act, ric_req_id);
+  if(val == NULL){
     act_proc_ans_t ans = {.ok = false,
                           .error = "ric_req_id not found in the registry" };     
     return ans;
   }
 
-
-  assert(it != end && "ric_req_id key value not found in the registry" );
-
-  act_proc_val_t* val = (act_proc_val_t*)assoc_reg_value(&act->reg ,it);
-  val->id.ric_req_id = ric_req_id;
- 
   act_proc_ans_t ans = {.ok = true,
                         .val = *val };     
   return ans;
 }
 
+bool fail_act_proc(act_proc_t* act, uint16_t ric_req_id)
+{
+  assert(act != NULL);
+  lock_guard(&act->mtx);
+
+  act_proc_val_t* val = find_val(act, ric_req_id);
+  if(val == NULL)
+    return false;
+
+  val->failed = true;
+  return true;
+}
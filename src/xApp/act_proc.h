@@ -53,10 +53,18 @@ typedef struct{
   ric_gen_id_t id; 
   void (*sm_cb)(sm_ag_if_rd_t const*);
   global_e2_node_id_t e2_node;
+  // Outcome of this very request, set by the failure handlers 
+  bool failed;
 } act_proc_val_t;
 
+// RIC request IDs from here on belong to the asynchronous controls, see 
+// control_sm_async_xapp. act_proc wraps below, so that the two never collide
+#define ASYNC_CTRL_RIC_REQ_ID (1 << 15)
+
 typedef struct{
-  assoc_reg_t reg; // key: uint32_t | value: act_subs_val_t 
+  assoc_rb_tree_t tree; // key: uint16_t ric_req_id | value: act_proc_val_t*
+  // Next candidate RIC request ID, in [1, ASYNC_CTRL_RIC_REQ_ID)
+  uint16_t next_id;
   pthread_mutex_t mtx; //act_subs_mtx;
 } act_proc_t;
 
@@ -82,5 +90,8 @@ typedef struct{
 
 act_proc_ans_t find_act_proc(act_proc_t* proc, uint16_t ric_req_id);
 
+// Mark the procedure as failed. Returns false if ric_req_id is not registered 
+bool fail_act_proc(act_proc_t* proc, uint16_t ric_req_id);
+
 #endif
 
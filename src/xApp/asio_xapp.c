@@ -45,6 +45,13 @@ void set_fd_non_blocking(int sfd)
 void init_asio_xapp(asio_xapp_t* io)
 {
   assert(io != NULL);
+
+  io->ring = create_asio_uring();
+  if(io->ring != NULL){
+    io->efd = -1;
+    return;
+  }
+
   const int flags = EPOLL_CLOEXEC; 
   const int efd = epoll_create1(flags);  
   assert(efd != -1);
@@ -56,6 +63,11 @@ void add_fd_asio_xapp(asio_xapp_t* io, int fd)
   assert(io != NULL);
   assert(fd > 0 && "fd cannot be negative, data corrupted");
 
+  if(io->ring != NULL){
+    add_fd_asio_uring(io->ring, fd, true);
+    return;
+  }
+
   set_fd_non_blocking(io->efd);
   const int op = EPOLL_CTL_ADD;
   const epoll_data_t e_data = {.fd = fd};
@@ -69,7 +81,11 @@ int create_timer_ms_asio_xapp(asio_xapp_t* io, long initial_ms, long interval_ms
 {
   assert(io != NULL);
   assert(initial_ms > 0);
-  assert(interval_ms > 0);
+  // 0 for a one-shot timer
+  assert(interval_ms > -1);
+
+  if(io->ring != NULL)
+    return create_timer_ms_asio_uring(io->ring, initial_ms, interval_ms);
 
   // Create the timer
   const int clockid = CLOCK_MONOTONIC;
@@ -101,6 +117,17 @@ int create_timer_ms_asio_xapp(asio_xapp_t* io, long initial_ms, long interval_ms
 void rm_fd_asio_xapp(asio_xapp_t* io, int fd)
 {
   assert(io != NULL);
+
+  if(io->ring != NULL && is_timer_asio_uring(fd) == true){
+    rm_timer_asio_uring(io->ring, fd);
+    return;
+  } else if(io->ring != NULL){
+    rm_fd_asio_uring(io->ring, fd);
+    int const rc = close(fd);
+    assert(rc == 0);
+    return;
+  }
+
   const int op = EPOLL_CTL_DEL;
   const epoll_data_t e_data = {.fd = fd};
   const int e_events = EPOLLIN; // open for reading
@@ -112,10 +139,30 @@ void rm_fd_asio_xapp(asio_xapp_t* io, int fd)
 
 }
 
+void consume_timer_asio_xapp(asio_xapp_t const* io, int fd)
+{
+  assert(io != NULL);
+  assert(fd > 0);
+
+  // Nothing to read from io_uring timeouts
+  if(io->ring != NULL && is_timer_asio_uring(fd) == true)
+    return;
+
+  uint64_t read_buf = 0;
+  ssize_t const bytes = read(fd, &read_buf, sizeof(read_buf));
+  assert(bytes == sizeof(read_buf));
+}
+
 int event_asio_xapp(asio_xapp_t const* io)
 {
   assert(io != NULL);
 
+  if(io->ring != NULL){
+    int fd = -1;
+    size_t const len = event_asio_uring(io->ring, 1000, 1, &fd);
+    return len == 0 ? -1 : fd;
+  }
+
   const int maxevents = 1;
   struct epoll_event events[maxevents];
   const int timeout_ms = 1000;
@@ -23,9 +23,13 @@
 #ifndef ASYNC_INPUT_OUTPUT_XAPP_H
 #define ASYNC_INPUT_OUTPUT_XAPP_H
 
+#include "../lib/asio_uring.h"
+
 typedef struct{
   // epoll based fd
   int efd; 
+  // io_uring backend. NULL if epoll 
+  asio_uring_t* ring;
 
 } asio_xapp_t;
 
@@ -38,6 +42,9 @@ int create_timer_ms_asio_xapp(asio_xapp_t* io, long initial_ms, long interval_ms
 
 void rm_fd_asio_xapp(asio_xapp_t* io, int fd);
 
+// Acknowledges the expiration of a timer
+void consume_timer_asio_xapp(asio_xapp_t const* io, int fd);
+
 int event_asio_xapp(asio_xapp_t const* io);
 
 
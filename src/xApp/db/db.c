@@ -33,13 +33,14 @@ typedef struct{
   sm_ag_if_rd_t rd;
 } e2_node_ag_if_t;
 
-static
+// Per worker_thread, as several xApps may run in one process
+static _Thread_local
 e2_node_ag_if_t static_e2_node_ag_if; 
 
-static
+static _Thread_local
 e2_node_ag_if_t static_e2_node_ag_if_10[10]; 
 
-static
+static _Thread_local
 e2_node_ag_if_t static_e2_node_ag_if_100[100]; 
 
 
@@ -55,7 +56,7 @@ void* create_val(void* it)
   return &static_e2_node_ag_if;
 }
 
-static 
+static _Thread_local
 int val_10 = 0;
 
 static
@@ -71,7 +72,7 @@ void* create_val_10(void* it)
   return &static_e2_node_ag_if_10;
 }
 
-static 
+static _Thread_local
 int val_100 = 0;
 
 static
@@ -57,6 +57,7 @@
 #include <time.h>
 #include <stdio.h>
 #include <pthread.h>
+#include <unistd.h>
 
 
 
@@ -110,15 +111,6 @@ async_event_xapp_t find_event_type(e42_xapp_t* xapp, int fd)
   return e;
 }
 
-static
-void consume_fd(int fd)
-{
-  assert(fd > 0);
-  uint64_t read_buf = 0;
-  ssize_t const bytes = read(fd,&read_buf, sizeof(read_buf));
-  assert(bytes == sizeof(read_buf));
-}
-
 /*
 static
 void read_xapp(sm_ag_if_rd_t* data)
@@ -238,6 +230,32 @@ e42_xapp_t* init_e42_xapp(fr_args_t const* args)
   free(dir);
   free(db_name);
 
+  char* token = get_conf_xapp_token(args);
+  if(token != NULL){
+    char tkn[128] = {0};
+    n = snprintf(tkn, sizeof(tkn), "%s/%d.%ld", token, getpid(), now);
+    assert(n < (int)sizeof(tkn) && "Overflow");
+    free(token);
+
+    xapp->token = calloc(1, sizeof(byte_array_t));
+    assert(xapp->token != NULL && "Memory exhausted");
+    *xapp->token = cp_str_to_ba(tkn);
+    printf("[xApp]: Token = %s \n", tkn);
+  }
+
+  char* group = get_conf_xapp_group(args);
+  if(group != NULL){
+    xapp->group = calloc(1, sizeof(byte_array_t));
+    assert(xapp->group != NULL && "Memory exhausted");
+    *xapp->group = cp_str_to_ba(group);
+    printf("[xApp]: Consumer group = %s \n", group);
+    free(group);
+  }
+
+  char* backoff = get_conf_reconnect_backoff(args);
+  init_conf_backoff(&xapp->backoff, backoff);
+  free(backoff);
+
 
   const pthread_mutexattr_t *attr = NULL;
   int rc = pthread_mutex_init(&xapp->conn_mtx , attr);
@@ -273,12 +291,32 @@ void e2_event_loop_xapp(e42_xapp_t* xapp)
 
     if(e.type == NETWORK_EVENT){ 
 
-      byte_array_t ba = e2ap_recv_msg_xapp(&xapp->ep);
-      defer( {free_byte_array(ba);} );
+      sctp_msg_t rcv = e2ap_recv_msg_xapp(&xapp->ep);
+      defer( {free_sctp_msg(&rcv);} );
+
+      if(rcv.type == SCTP_MSG_NOTIFICATION){
+        // The nearRT-RIC went down. Keep knocking on its door
+        printf("[xApp]: Communication with the nearRT-RIC lost\n");
+        {
+          lock_guard(&xapp->conn_mtx);
+          xapp->connected = false;
+        }
+        notify_conn_state_xapp(xapp, DISCONNECTED_CONN_STATE);
+        // Not at once, as every xApp of the nearRT-RIC lost it at this instant
+        reset_backoff(&xapp->backoff);
+        arm_setup_timer_xapp(xapp);
+        continue;
+      }
 
-      e2ap_msg_t msg = e2ap_msg_dec_xapp(&xapp->ap, ba);
+      e2ap_msg_t msg = e2ap_msg_dec_xapp(&xapp->ap, rcv.ba);
       defer( { e2ap_msg_free_xapp(&xapp->ap, &msg);} );
 
+      // Undecodable or of an unsupported procedure, e.g., of another E2AP version
+      if(msg.type == NONE_E2_MSG_TYPE){
+        printf("[xApp]: Undecodable or unsupported E2AP PDU from the nearRT-RIC discarded\n");
+        continue;
+      }
+
       e2ap_msg_t ans = e2ap_msg_handle_xapp(xapp, &msg);
       defer( { e2ap_msg_free_xapp(&xapp->ap, &ans);} );
 
@@ -298,17 +336,12 @@ void e2_event_loop_xapp(e42_xapp_t* xapp)
       assert(*e.p_ev != E42_RIC_SUBSCRIPTION_DELETE_REQUEST_PENDING_EVENT  && "Timeout waiting for Subscription Delete. Connection lost with the RIC?");
       assert(*e.p_ev != E42_RIC_CONTROL_REQUEST_PENDING_EVENT && "Timeout waiting for Control ACK. Connection lost with the RIC?");
 
-      // Resend the subscription request message
-      e42_setup_request_t sr = generate_e42_setup_request(xapp);
-      defer({ e2ap_free_e42_setup_request(&sr);  } );
-
+      // Resend the setup request message. It re-arms the one-shot timer
+      // with the next delay of the backoff 
       printf("[E2AP]: Resending Setup Request after timeout\n");
-      byte_array_t ba = e2ap_enc_e42_setup_request_xapp(&xapp->ap, &sr);
-      defer({free_byte_array(ba); } );
-
-      e2ap_send_bytes_xapp(&xapp->ep, ba);
-
-      consume_fd(fd);
+      consume_timer_asio_xapp(&xapp->io, fd);
+      send_setup_request(xapp);
+      notify_conn_state_xapp(xapp, RETRY_CONN_STATE);
     } else {
       assert(0!=0 && "An interruption that it is not a network pkt, or a timer expired pending event happened!");
     }
@@ -356,6 +389,16 @@ void free_e42_xapp(e42_xapp_t* xapp)
 
   close_db_xapp(&xapp->db);
 
+  if(xapp->token != NULL){
+    free_byte_array(*xapp->token);
+    free(xapp->token);
+  }
+
+  if(xapp->group != NULL){
+    free_byte_array(*xapp->group);
+    free(xapp->group);
+  }
+
   int rc = pthread_mutex_destroy(&xapp->conn_mtx);
   assert(rc == 0);
 
@@ -370,7 +413,7 @@ e2_node_arr_xapp_t e2_nodes_xapp(e42_xapp_t* xapp)
 }
 
 static
-void send_subscription_request(e42_xapp_t* xapp, global_e2_node_id_t* id, ric_gen_id_t ric_id, void* data)
+void send_subscription_request(e42_xapp_t* xapp, global_e2_node_id_t* id, ric_gen_id_t ric_id, void* data, char const* filter, char const* overload)
 {
   assert(xapp != NULL);
   assert(id != NULL);
@@ -378,7 +421,7 @@ void send_subscription_request(e42_xapp_t* xapp, global_e2_node_id_t* id, ric_ge
 
   sm_ric_t* sm = sm_plugin_ric(&xapp->plugin_ric, ric_id.ran_func_id);
 
-  ric_subscription_request_t sr = generate_subscription_request(ric_id, sm, data);
+  ric_subscription_request_t sr = generate_subscription_request(ric_id, sm, data, filter, overload);
   e42_ric_subscription_request_t e42_sr = {
     .xapp_id = xapp->id,
     .id = cp_global_e2_node_id(id),
@@ -419,13 +462,13 @@ ric_gen_id_t generate_ric_gen_id(e42_xapp_t* xapp, act_proc_val_e type, uint16_t
   ric_gen_id_t ric_req = {.ric_inst_id = 0, .ran_func_id = ran_func_id };
   uint32_t const req_id = add_act_proc(&xapp->act_proc, type, ric_req, id, cb); 
   //printf("Generated of req_id = %d \n", req_id);
-  assert(req_id < 1 << 16 && "Overflow detected");
+  assert(req_id < ASYNC_CTRL_RIC_REQ_ID && "Overflow detected");
   ric_req.ric_req_id = req_id;
 
   return ric_req;
 }
 
-sm_ans_xapp_t report_sm_sync_xapp(e42_xapp_t* xapp, global_e2_node_id_t* id, uint16_t rf_id , void* data, sm_cb cb)
+sm_ans_xapp_t report_sm_sync_xapp(e42_xapp_t* xapp, global_e2_node_id_t* id, uint16_t rf_id , void* data, char const* filter, char const* overload, sm_cb cb)
 {
   assert(xapp != NULL);
   assert(id != NULL);
@@ -433,13 +476,30 @@ sm_ans_xapp_t report_sm_sync_xapp(e42_xapp_t* xapp, global_e2_node_id_t* id, uin
   // Generate and registry the ric_req_id
   ric_gen_id_t ric_id = generate_ric_gen_id(xapp, RIC_SUBSCRIPTION_PROCEDURE_ACTIVE , rf_id, id, cb);
 
+  // The callback is shed with the policy sent to the iApp
+  overload_conf_t conf = {0};
+  bool const has_conf = overload != NULL && parse_overload_conf((byte_array_t){.buf = (uint8_t*)overload, .len = strlen(overload)}, &conf);
+  sm_ric_t const* sm = sm_plugin_ric(&xapp->plugin_ric, rf_id);
+  add_sub_msg_dispatcher(&xapp->msg_disp, ric_id.ric_req_id, sm, has_conf ? &conf : NULL);
+
+  arm_sync_ui(&xapp->sync);
+
   // Send message 
-  send_subscription_request(xapp, id, ric_id, data);
+  send_subscription_request(xapp, id, ric_id, data, filter, overload);
 
   // Wait for the answer (it will arrive in the event loop)
   cond_wait_sync_ui(&xapp->sync, xapp->sync.wait_ms);
 
-  // Answer arrived
+  // Answer arrived. Either a SUBSCRIPTION-RESPONSE or a SUBSCRIPTION-FAILURE for this ric_req_id
+  act_proc_ans_t const rv = find_act_proc(&xapp->act_proc, ric_id.ric_req_id);
+  assert(rv.ok == true && "ric_req_id not registered in the registry");
+  if(rv.val.failed == true){
+    rm_act_proc(&xapp->act_proc, ric_id.ric_req_id); 
+    rm_sub_msg_dispatcher(&xapp->msg_disp, ric_id.ric_req_id);
+    sm_ans_xapp_t const ans = {.success = false, .u.reason = "RIC Subscription Failure received"};
+    return ans;
+  }
+
   printf("[xApp]: Successfully subscribed to RAN_FUNC_ID %d \n", rf_id);
 
   // The RIC_SUBSCRIPTION_PROCEDURE is still active
@@ -476,6 +536,8 @@ void rm_report_sm_sync_xapp(e42_xapp_t* xapp, int ric_req_id)
     exit(-1);
   }
 
+  arm_sync_ui(&xapp->sync);
+
   // Send message
   send_ric_subscription_delete(xapp, ans.val.id);
 
@@ -487,10 +549,11 @@ void rm_report_sm_sync_xapp(e42_xapp_t* xapp, int ric_req_id)
 
   // Remove the active procedure  
   rm_act_proc(&xapp->act_proc, ric_req_id ); 
+  rm_sub_msg_dispatcher(&xapp->msg_disp, ric_req_id);
 }
 
 static
-void send_control_request(e42_xapp_t* xapp, global_e2_node_id_t* id, ric_gen_id_t ric_req, void* ctrl_msg)
+void send_control_request(e42_xapp_t* xapp, global_e2_node_id_t* id, ric_gen_id_t ric_req, void* ctrl_msg, ric_control_ack_req_t ack)
 {
   assert(xapp != NULL);
   assert(id != NULL);
@@ -499,7 +562,7 @@ void send_control_request(e42_xapp_t* xapp, global_e2_node_id_t* id, ric_gen_id_
 
   sm_ric_t* sm = sm_plugin_ric(&xapp->plugin_ric, ric_req.ran_func_id);
   
-  ric_control_request_t ctrl_req = generate_ric_control_request(ric_req, sm, ctrl_msg);
+  ric_control_request_t ctrl_req = generate_ric_control_request(ric_req, sm, ctrl_msg, ack);
 
   e42_ric_control_request_t e42_cr = { .xapp_id = xapp->id,
                                        .id = cp_global_e2_node_id(id),
@@ -525,22 +588,65 @@ sm_ans_xapp_t control_sm_sync_xapp(e42_xapp_t* xapp, global_e2_node_id_t* id, ui
   // Generate and registry the ric_req_id
   ric_gen_id_t ric_id = generate_ric_gen_id(xapp, RIC_CONTROL_PROCEDURE_ACTIVE, ran_func_id, id, NULL);
 
+  arm_sync_ui(&xapp->sync);
+
   // Send the message
-  send_control_request(xapp, id, ric_id, ctrl_msg);  
+  send_control_request(xapp, id, ric_id, ctrl_msg, RIC_CONTROL_REQUEST_ACK);  
 
   // Wait for the answer (it will arrive in the event loop)
   cond_wait_sync_ui(&xapp->sync, xapp->sync.wait_ms);
 
-  // Answer received
-  printf("[xApp]: Successfully received CONTROL-ACK \n");
+  // Answer received. Either a CONTROL-ACK or a CONTROL-FAILURE for this ric_req_id
+  act_proc_ans_t const rv = find_act_proc(&xapp->act_proc, ric_id.ric_req_id);
+  assert(rv.ok == true && "ric_req_id not registered in the registry");
 
   // Remove the active procedure, control request  
   rm_act_proc(&xapp->act_proc, ric_id.ric_req_id ); 
+
+  if(rv.val.failed == true){
+    sm_ans_xapp_t const ans = {.success = false, .u.reason = "RIC Control Failure received"};
+    return ans;
+  }
+
+  printf("[xApp]: Successfully received CONTROL-ACK \n");
  
   sm_ans_xapp_t const ans = {.success = true};
   return ans;
 }
 
+// The RIC request IDs of the asynchronous controls are taken from the upper half of the 
+// 16 bits space, while act_proc wraps its IDs below ASYNC_CTRL_RIC_REQ_ID. 
+// Registering every fire-and-forget control in act_proc would fill it, as
+// nothing would ever remove the entries 
+static
+uint16_t next_async_ctrl_id(e42_xapp_t* xapp)
+{
+  assert(xapp != NULL);
+
+  uint16_t const id = atomic_fetch_add(&xapp->async_ctrl_id, 1);
+  return ASYNC_CTRL_RIC_REQ_ID | id;
+}
+
+sm_ans_xapp_t control_sm_async_xapp(e42_xapp_t* xapp, global_e2_node_id_t* id, uint16_t ran_func_id, void* ctrl_msg, ric_control_ack_req_t ack)
+{
+  assert(xapp != NULL);
+  assert(id != NULL);
+  assert(valid_ran_func_id(ran_func_id) == true);
+  assert(ctrl_msg != NULL);
+  assert(ack == RIC_CONTROL_REQUEST_NO_ACK || ack == RIC_CONTROL_REQUEST_NACK);
+
+  ric_gen_id_t const ric_id = {.ric_req_id = next_async_ctrl_id(xapp),
+                               .ric_inst_id = 0,
+                               .ran_func_id = ran_func_id};
+
+  // No pending event and no wait. A NAck control only hears back on failure,
+  // which is accounted in xapp->ctrl_failures
+  send_control_request(xapp, id, ric_id, ctrl_msg, ack);  
+
+  sm_ans_xapp_t const ans = {.success = true, .u.handle = ric_id.ric_req_id};
+  return ans;
+}
+
 
 bool connected_e42_xapp( e42_xapp_t* xapp)
 {
@@ -548,6 +654,23 @@ bool connected_e42_xapp( e42_xapp_t* xapp)
   return xapp->connected;
 }
 
+void conn_state_cb_e42_xapp(e42_xapp_t* xapp, conn_state_cb cb, void* data)
+{
+  assert(xapp != NULL);
+
+  xapp->conn_cb = cb;
+  xapp->conn_data = data;
+}
+
+void notify_conn_state_xapp(e42_xapp_t const* xapp, conn_state_e state)
+{
+  assert(xapp != NULL);
+  assert(state < END_CONN_STATE);
+
+  if(xapp->conn_cb != NULL)
+    xapp->conn_cb(xapp->ep.base.addr, state, xapp->conn_data);
+}
+
 
 size_t not_dispatch_msg(e42_xapp_t* xapp)
 {
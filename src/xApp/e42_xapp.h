@@ -33,7 +33,9 @@
 #include "util/alg_ds/ds/assoc_container/bimap.h"
 #include "util/alg_ds/ds/tsn_queue/tsn_queue.h"
 
+#include "../lib/conn_state.h"
 #include "../lib/msg_hand/reg_e2_nodes.h"
+#include "../util/backoff.h"
 #include "db/db.h"
 #include "e42_xapp_api.h"
 #include "pending_event_xapp.h"
@@ -78,6 +80,13 @@ typedef struct e42_xapp_s
   // xApp ID, used for uniquely identify the xApp at the iApp 
   const uint16_t id;
 
+  // <identity>/<instance>, presented to the iApp to resume the session 
+  // after a reconnection. NULL if XAPP_TOKEN is not configured
+  byte_array_t* token;
+
+  // Consumer group joined at the iApp. NULL if XAPP_GROUP is not configured
+  byte_array_t* group;
+
   // Syncronization primitives
    sync_ui_t sync;
 
@@ -85,10 +94,24 @@ typedef struct e42_xapp_s
   // It provides a monotonically increasing RIC request ID
   // as well as it stores the ric_gen_id_t and the callbacks
   act_proc_t act_proc;   
+
+  // RIC request IDs of the controls that do not wait for an answer.
+  // They do not go through act_proc, see control_sm_async_xapp
+  _Atomic uint16_t async_ctrl_id;
+
+  // RIC Control Failures received
+  _Atomic uint64_t ctrl_failures;
   
   // Pending events (i.e., waiting response)
   pending_event_xapp_ds_t pending;
 
+  // Delay of the E42 Setup Request retries, see RECONNECT_BACKOFF
+  backoff_t backoff;
+
+  // Connection state changes of the nearRT-RIC. NULL for none
+  conn_state_cb conn_cb;
+  void* conn_data;
+
   // Indication Messages dispatcher
   msg_dispatcher_xapp_t msg_disp; 
 
@@ -105,6 +128,11 @@ e42_xapp_t* init_e42_xapp(fr_args_t const* args);
 
 bool connected_e42_xapp( e42_xapp_t* xapp);
 
+// Call it before start_e42_xapp()
+void conn_state_cb_e42_xapp(e42_xapp_t* xapp, conn_state_cb cb, void* data);
+
+void notify_conn_state_xapp(e42_xapp_t const* xapp, conn_state_e state);
+
 // Blocking call
 void start_e42_xapp(e42_xapp_t* xapp);
 
@@ -115,7 +143,8 @@ e2_node_arr_xapp_t e2_nodes_xapp(e42_xapp_t* xapp);
 size_t not_dispatch_msg(e42_xapp_t* xapp);
 
 // We wait for the message to come back and avoid asyncronous programming
-sm_ans_xapp_t report_sm_sync_xapp(e42_xapp_t* xapp, global_e2_node_id_t* id, uint16_t ran_func_id, void* data, sm_cb cb);
+// filter is optional, e.g., "meas=DRB.UEThpDl;ue=1-20;pred=DRB.UEThpDl>1000"
+sm_ans_xapp_t report_sm_sync_xapp(e42_xapp_t* xapp, global_e2_node_id_t* id, uint16_t ran_func_id, void* data, char const* filter, char const* overload, sm_cb cb);
 
 // We wait for the message to come back and avoid asyncronous programming
 void rm_report_sm_sync_xapp(e42_xapp_t* xapp, int handle);
@@ -123,6 +152,9 @@ void rm_report_sm_sync_xapp(e42_xapp_t* xapp, int handle);
 // We wait for the message to come back and avoid asyncronous programming
 sm_ans_xapp_t control_sm_sync_xapp(e42_xapp_t* xapp, global_e2_node_id_t* id, uint16_t ran_func_id, void* ctrl_msg);
 
+// Fire-and-forget (NoAck) or error-only (NAck) control. It does not wait
+sm_ans_xapp_t control_sm_async_xapp(e42_xapp_t* xapp, global_e2_node_id_t* id, uint16_t ran_func_id, void* ctrl_msg, ric_control_ack_req_t ack);
+
 #undef HANDLE_MSG_NUM 
 
 #endif
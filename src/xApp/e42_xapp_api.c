@@ -23,6 +23,9 @@
 #include "e42_xapp_api.h"
 #include "e42_xapp.h"
 #include "../util/conf_file.h"
+#include "../lib/ep/e2ap_capture.h"
+#include "../lib/asio_uring.h"
+#include "../util/mem_acct.h"
 #include "../lib/e2ap/e2ap_global_node_id_wrapper.h"
 #include "../util/alg_ds/alg/defer.h"
 #include "../util/alg_ds/alg/alg.h"
@@ -46,6 +49,12 @@ pthread_t thrd_xapp;
 static
 atomic_bool stop_xapp = false;
 
+static
+conn_state_cb conn_cb = NULL;
+
+static
+void* conn_data = NULL;
+
 static
 void xapp_unblock_wait_api(void)
 {
@@ -78,6 +87,15 @@ void* static_start_xapp(void* a)
   return NULL;
 }
 
+static
+void init_io_backend(fr_args_t const* args)
+{
+  char* name = get_conf_io_backend(args);
+  if(name != NULL && set_backend_str_asio(name) == false)
+    printf("[xApp]: Unknown IO_BACKEND %s. Using %s\n", name, backend_asio_str(backend_asio()));
+  free(name);
+}
+
 void init_xapp_api(fr_args_t const* args)
 {
   assert(xapp == NULL && "The init_xapp_api function can only be called once");
@@ -87,7 +105,12 @@ void init_xapp_api(fr_args_t const* args)
   signal(SIGINT, sig_handler);
   signal(SIGTERM, sig_handler);
 
+  init_conf_e2ap_capture(args);
+  init_io_backend(args);
+
   xapp = init_e42_xapp(args);
+  tag_e2ap_capture(&xapp->ep.to, "nearRT-RIC");
+  conn_state_cb_e42_xapp(xapp, conn_cb, conn_data);
 
   // Spawn a new thread for the xapp
   int rc = pthread_create(&thrd_xapp, NULL, static_start_xapp, NULL);
@@ -98,6 +121,14 @@ void init_xapp_api(fr_args_t const* args)
  
 }
   
+void conn_state_cb_xapp_api(conn_state_cb cb, void* data)
+{
+  assert(xapp == NULL && "Call it before init_xapp_api()");
+
+  conn_cb = cb;
+  conn_data = data;
+}
+
 bool try_stop_xapp_api(void)
 {
   assert(xapp != NULL);
@@ -110,6 +141,9 @@ bool try_stop_xapp_api(void)
 
   int const rc = pthread_join(thrd_xapp, NULL);
   assert(rc == 0);
+
+  free_e2ap_capture();
+  report_leaks_mem_acct("xApp", stdout);
   printf("[xApp]: Successfully stopped \n");
   return true;
 }
@@ -178,7 +212,33 @@ sm_ans_xapp_t report_sm_xapp_api(global_e2_node_id_t* id, uint32_t rf_id, void*
   assert(valid_global_e2_node(id, &xapp->e2_nodes) == true);
   assert(valid_sm_id(id, rf_id)  == true);
 
-  return report_sm_sync_xapp(xapp, id, rf_id, data, handler);
+  return report_sm_sync_xapp(xapp, id, rf_id, data, NULL, NULL, handler);
+}
+
+sm_ans_xapp_t report_sm_filter_xapp_api(global_e2_node_id_t* id, uint32_t rf_id, void* data, char const* filter, sm_cb handler)
+{
+  assert(xapp != NULL);
+  assert(id != NULL);
+  assert(data != NULL);
+  assert(filter != NULL);
+
+  assert(valid_global_e2_node(id, &xapp->e2_nodes) == true);
+  assert(valid_sm_id(id, rf_id)  == true);
+
+  return report_sm_sync_xapp(xapp, id, rf_id, data, filter, NULL, handler);
+}
+
+sm_ans_xapp_t report_sm_overload_xapp_api(global_e2_node_id_t* id, uint32_t rf_id, void* data, char const* filter, char const* overload, sm_cb handler)
+{
+  assert(xapp != NULL);
+  assert(id != NULL);
+  assert(data != NULL);
+  assert(overload != NULL);
+
+  assert(valid_global_e2_node(id, &xapp->e2_nodes) == true);
+  assert(valid_sm_id(id, rf_id)  == true);
+
+  return report_sm_sync_xapp(xapp, id, rf_id, data, filter, overload, handler);
 }
 
 // remove the handle previously returned
@@ -201,4 +261,23 @@ sm_ans_xapp_t control_sm_xapp_api(global_e2_node_id_t* id, uint32_t ran_func_id,
   return control_sm_sync_xapp(xapp, id, ran_func_id, wr);
 }
 
+sm_ans_xapp_t control_sm_async_xapp_api(global_e2_node_id_t* id, uint32_t ran_func_id, void* wr, ctrl_mode_xapp_e mode)
+{
+  assert(xapp != NULL);
+  assert(id != NULL);
+  assert(ran_func_id == SM_MAC_ID || ran_func_id == SM_SLICE_ID || ran_func_id == SM_TC_ID || ran_func_id == SM_RC_ID);
+  assert(wr != NULL);
+  assert(mode == NO_ACK_CTRL_MODE_XAPP || mode == FAIL_ONLY_CTRL_MODE_XAPP);
+
+  ric_control_ack_req_t const ack = mode == NO_ACK_CTRL_MODE_XAPP ? RIC_CONTROL_REQUEST_NO_ACK : RIC_CONTROL_REQUEST_NACK;
+
+  return control_sm_async_xapp(xapp, id, ran_func_id, wr, ack);
+}
+
+uint64_t ctrl_failures_xapp_api(void)
+{
+  assert(xapp != NULL);
+  return xapp->ctrl_failures;
+}
+
 
@@ -30,6 +30,7 @@ extern "C" {
 #include <stdint.h>
 
 #include "e2_node_arr_xapp.h"
+#include "../lib/conn_state.h"
 #include "../sm/agent_if/write/sm_ag_if_wr.h"
 #include "../sm/agent_if/read/sm_ag_if_rd.h"
 #include "../util/conf_file.h"
@@ -37,6 +38,11 @@ extern "C" {
 void xapp_wait_end_api(void);
 
 void init_xapp_api(fr_args_t const*);
+
+// Connection state changes of the nearRT-RIC, e.g., the xApp lost it.
+// The E42 Setup retries follow the RECONNECT_BACKOFF key of the conf file.
+// Call it before init_xapp_api()
+void conn_state_cb_xapp_api(conn_state_cb cb, void* data);
   
 bool try_stop_xapp_api(void);     
 
@@ -68,6 +74,18 @@ typedef enum{
 // Returns a handle
 sm_ans_xapp_t report_sm_xapp_api(global_e2_node_id_t* id, uint32_t rf_id, void* data, sm_cb handler);
 
+// Like report_sm_xapp_api, but the iApp filters and projects the indications 
+// before sending them, e.g., "meas=DRB.UEThpDl,RRU.PrbUsed*;ue=1-20;pred=DRB.UEThpDl>1000"
+// or windowed aggregates at a lower rate, e.g., "meas=DRB.UEThpDl;agg=mean,p95;win=10/5"
+// Only supported by the KPM SM. The iApp ignores a malformed filter
+sm_ans_xapp_t report_sm_filter_xapp_api(global_e2_node_id_t* id, uint32_t rf_id, void* data, char const* filter, sm_cb handler);
+
+// Like report_sm_filter_xapp_api, but the iApp queues the indications and sheds 
+// them if the xApp does not keep up, e.g., "policy=keep_latest;depth=32". 
+// Policies: drop_oldest, drop_newest and keep_latest (per UE). filter may be NULL.
+// The iApp lowers the report rate while the overload persists
+sm_ans_xapp_t report_sm_overload_xapp_api(global_e2_node_id_t* id, uint32_t rf_id, void* data, char const* filter, char const* overload, sm_cb handler);
+
 // Remove the handle previously returned
 void rm_report_sm_xapp_api(int const handle);
 
@@ -75,6 +93,20 @@ void rm_report_sm_xapp_api(int const handle);
 // return void but sm_ag_if_ans_ctrl_t should be returned. Add it in the future if needed
 sm_ans_xapp_t control_sm_xapp_api(global_e2_node_id_t* id, uint32_t rf_id, void* wr);
 
+typedef enum{
+  NO_ACK_CTRL_MODE_XAPP,    // Fire-and-forget. The E2 Node answers nothing
+  FAIL_ONLY_CTRL_MODE_XAPP, // The E2 Node only answers with a RIC Control Failure
+
+  END_CTRL_MODE_XAPP,
+} ctrl_mode_xapp_e;
+
+// Send control message without waiting for the answer. 
+// Returns as soon as the message is handed to the transport
+sm_ans_xapp_t control_sm_async_xapp_api(global_e2_node_id_t* id, uint32_t rf_id, void* wr, ctrl_mode_xapp_e mode);
+
+// RIC Control Failures received since init_xapp_api
+uint64_t ctrl_failures_xapp_api(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -51,6 +51,7 @@ void init_sctp_conn_client(e2ap_ep_xapp_t* ep, const char* addr, int port)
   struct sctp_event_subscribe evnts; 
   bzero(&evnts, sizeof (evnts)) ;
   evnts.sctp_data_io_event = 1 ;
+  evnts.sctp_shutdown_event = 1 ;
   setsockopt(sock_fd, IPPROTO_SCTP, SCTP_EVENTS, &evnts, sizeof (evnts));
 
   const int no_delay = 1;
@@ -70,26 +71,39 @@ void init_sctp_conn_client(e2ap_ep_xapp_t* ep, const char* addr, int port)
   strncpy((char*)(&ep->base.addr), addr, 16);
 }
 
+static
+void init_mem_conn_client(e2ap_ep_xapp_t* ep, const char* addr, int port)
+{
+  struct sockaddr_in servaddr = { .sin_family = AF_INET,
+                                  .sin_port = htons(port)}; 
+
+  int rc = inet_pton(AF_INET, addr, &servaddr.sin_addr);
+  assert(rc == 1);
+
+  ep->to = servaddr;
+  *(int*)(&ep->base.port) = port; 
+  *(int*)(&ep->base.fd) = e2ap_ep_connect_mem(&ep->base, addr, port);
+  strncpy((char*)(&ep->base.addr), addr, 16);
+}
+
 void e2ap_init_ep_xapp(e2ap_ep_xapp_t* ep, const char* addr, int port)
 {
   assert(ep != NULL);
   assert(addr != NULL);
   assert(strlen(addr) < 16);
   assert(port > 0 && port < 65535);
-  init_sctp_conn_client(ep, addr, port);
+
+  if(enabled_mem_ep() == true)
+    init_mem_conn_client(ep, addr, port);
+  else
+    init_sctp_conn_client(ep, addr, port);
 }
 
-byte_array_t e2ap_recv_msg_xapp(e2ap_ep_xapp_t* ep)
+sctp_msg_t e2ap_recv_msg_xapp(e2ap_ep_xapp_t* ep)
 {
   assert(ep != NULL);
 
-  sctp_msg_t rcv = e2ap_recv_sctp_msg(&ep->base); //, &ba);
-
-//sctp_msg_t e2ap_recv_sctp_msg(e2ap_ep_t* ep);
-  return rcv.ba;
-//  e2ap_msg_t msg = e2ap_msg_dec(&enc->type, ba);
-  //printf("Message received in the iapp\n");
-//  return msg;
+  return e2ap_recv_sctp_msg(&ep->base);
 }
 
 void e2ap_send_bytes_xapp(e2ap_ep_xapp_t* ep, byte_array_t ba)
@@ -41,7 +41,8 @@ void e2ap_init_ep_xapp(e2ap_ep_xapp_t* ep, const char* addr, int port);
 
 void e2ap_free_ep_xapp(e2ap_ep_xapp_t* ep);
 
-byte_array_t e2ap_recv_msg_xapp(e2ap_ep_xapp_t* ep);
+// Either a payload or an SCTP notification (i.e., shutdown)
+sctp_msg_t e2ap_recv_msg_xapp(e2ap_ep_xapp_t* ep);
 
 void e2ap_send_bytes_xapp(e2ap_ep_xapp_t* ep, byte_array_t ba);
 
@@ -1,56 +1,172 @@
 #include <assert.h>
 #include <string.h>
 #include <stdio.h>
+#include <stdlib.h>
 
-#include "../util/alg_ds/alg/defer.h"
+#include "../util/alg_ds/ds/lock_guard/lock_guard.h"
 
 #include "msg_dispatcher_xapp.h"
 
+typedef struct{
+  msg_dispatch_t msg;
+  // Conflation key. Empty if none
+  byte_array_t key;
+} dispatch_queued_t;
 
+typedef struct{
+  uint32_t ric_req_id;
+  sm_ric_t const* sm;
+  overload_conf_t conf;
+  // Selected by the xApp, or the default one
+  bool policy;
+  // Not registered, or already removed. Erased once nothing is queued
+  bool lazy;
+  dispatch_stats_t stats;
+} dispatch_sub_t;
 
 static
-msg_dispatch_t static_msg; 
+void free_dispatch_queued(dispatch_queued_t* q)
+{
+  assert(q != NULL);
+
+  free_sm_ag_if_rd(&q->msg.rd);
+  free_byte_array(q->key);
+  free(q);
+}
+
+static
+void free_dispatch_queued_wrapper(void* it)
+{
+  assert(it != NULL);
+  free_dispatch_queued(*(dispatch_queued_t**)it);
+}
+
+static
+void free_dispatch_sub_wrapper(void* it)
+{
+  assert(it != NULL);
+  free(*(dispatch_sub_t**)it);
+}
 
 static
-void* create_val(void* it)
+size_t find_sub_idx(msg_dispatcher_xapp_t* d, uint32_t ric_req_id)
 {
-  if(it == NULL)
+  size_t const sz = seq_size(&d->subs);
+  for(size_t i = 0; i < sz; ++i){
+    dispatch_sub_t* s = *(dispatch_sub_t**)seq_at(&d->subs, i);
+    if(s->ric_req_id == ric_req_id)
+      return i;
+  }
+  return sz;
+}
+
+static
+dispatch_sub_t* find_sub(msg_dispatcher_xapp_t* d, uint32_t ric_req_id)
+{
+  size_t const idx = find_sub_idx(d, ric_req_id);
+  if(idx == seq_size(&d->subs))
     return NULL;
+  return *(dispatch_sub_t**)seq_at(&d->subs, idx);
+}
 
- // msg_dispatch_t* msg = calloc(1, sizeof( msg_dispatch_t )); 
-//  assert(msg != NULL && "Memory exhausted");
+static
+dispatch_sub_t* push_sub(msg_dispatcher_xapp_t* d, uint32_t ric_req_id)
+{
+  dispatch_sub_t* s = calloc(1, sizeof(dispatch_sub_t));
+  assert(s != NULL && "Memory exhausted");
+  s->ric_req_id = ric_req_id;
+  s->conf = (overload_conf_t){.policy = DROP_OLDEST_OVERLOAD_POLICY, .depth = DISPATCH_DEPTH};
 
-  memcpy(&static_msg, it, sizeof(msg_dispatch_t ) );
-  
-  return &static_msg;
+  seq_push_back(&d->subs, &s, sizeof(dispatch_sub_t*));
+  return s;
 }
 
+static
+void erase_sub(msg_dispatcher_xapp_t* d, dispatch_sub_t* s)
+{
+  if(s->policy == true || s->stats.dropped > 0)
+    printf("[xApp]: RIC_REQ_ID %u dispatched %lu/%lu indications, dropped %lu, conflated %lu\n", 
+        s->ric_req_id, s->stats.ind_out, s->stats.ind_in, s->stats.dropped, s->stats.conflated);
+
+  size_t const idx = find_sub_idx(d, s->ric_req_id);
+  assert(idx < seq_size(&d->subs));
+  void* it = seq_at(&d->subs, idx);
+  seq_erase(&d->subs, it, seq_next(&d->subs, it));
+  free(s);
+}
+
+// The oldest queued indication of the subscription, if key is empty. 
+// The one with the same key otherwise
+static
+size_t find_queued(msg_dispatcher_xapp_t* d, uint32_t ric_req_id, byte_array_t key)
+{
+  size_t const sz = seq_size(&d->q);
+  for(size_t i = 0; i < sz; ++i){
+    dispatch_queued_t* q = *(dispatch_queued_t**)seq_at(&d->q, i);
+    if(q->msg.ric_req_id != ric_req_id)
+      continue;
+    if(key.len == 0 || eq_byte_array(&q->key, &key) == true)
+      return i;
+  }
+  return sz;
+}
 
 static
 void* worker_thread(void* arg)
 {
-  tsnq_t* q = (tsnq_t*)arg;
+  msg_dispatcher_xapp_t* d = (msg_dispatcher_xapp_t*)arg;
 
   while(true){
-    msg_dispatch_t* msg = wait_and_pop_tsnq(q,  create_val);
-    if(msg == NULL)
+    int rc = pthread_mutex_lock(&d->mtx);
+    assert(rc == 0);
+
+    while(d->stop == false && seq_size(&d->q) == 0){
+      rc = pthread_cond_wait(&d->cv, &d->mtx);
+      assert(rc == 0);
+    }
+
+    if(d->stop == true){
+      rc = pthread_mutex_unlock(&d->mtx);
+      assert(rc == 0);
       break;
+    }
+
+    dispatch_queued_t* q = *(dispatch_queued_t**)seq_front(&d->q);
+    seq_erase(&d->q, seq_front(&d->q), seq_next(&d->q, seq_front(&d->q)));
 
-    msg->sm_cb(&msg->rd);
-    free_sm_ag_if_rd(&msg->rd);
+    dispatch_sub_t* s = find_sub(d, q->msg.ric_req_id);
+    assert(s != NULL && "Subscription of a queued indication not found");
+    s->stats.queued -= 1;
+    s->stats.ind_out += 1;
+    if(s->lazy == true && s->stats.queued == 0)
+      erase_sub(d, s);
+
+    rc = pthread_mutex_unlock(&d->mtx);
+    assert(rc == 0);
+
+    // The callback may block. The queue keeps accepting indications
+    q->msg.sm_cb(&q->msg.rd);
+    free_dispatch_queued(q);
   }
-  q->stopped = true;
 
   return NULL;
 }
 
-
 void init_msg_dispatcher( msg_dispatcher_xapp_t* d)
 {
   assert(d != NULL);
 
-  init_tsnq(&d->q, sizeof(msg_dispatch_t));
-  int rc = pthread_create(&d->p, NULL, worker_thread, &d->q);
+  seq_init(&d->q, sizeof(dispatch_queued_t*));
+  seq_init(&d->subs, sizeof(dispatch_sub_t*));
+  d->stop = false;
+
+  int rc = pthread_mutex_init(&d->mtx, NULL);
+  assert(rc == 0);
+
+  rc = pthread_cond_init(&d->cv, NULL);
+  assert(rc == 0);
+
+  rc = pthread_create(&d->p, NULL, worker_thread, d);
   assert(rc == 0);
 }
 
@@ -58,23 +174,143 @@ void free_msg_dispatcher(msg_dispatcher_xapp_t* d)
 {
   assert(d != NULL);
 
-  free_tsnq(&d->q, NULL);
+  {
+    lock_guard(&d->mtx);
+    d->stop = true;
+    int const rc = pthread_cond_signal(&d->cv);
+    assert(rc == 0);
+  }
+
   int rc = pthread_join(d->p, NULL);
   assert(rc == 0);
+
+  seq_free(&d->q, free_dispatch_queued_wrapper);
+  seq_free(&d->subs, free_dispatch_sub_wrapper);
+
+  rc = pthread_cond_destroy(&d->cv);
+  assert(rc == 0);
+
+  rc = pthread_mutex_destroy(&d->mtx);
+  assert(rc == 0);
+}
+
+void add_sub_msg_dispatcher(msg_dispatcher_xapp_t* d, uint32_t ric_req_id, sm_ric_t const* sm, overload_conf_t const* conf)
+{
+  assert(d != NULL);
+  assert(conf == NULL || (conf->policy < END_OVERLOAD_POLICY && conf->depth > 0 && conf->depth <= OVERLOAD_MAX_DEPTH));
+
+  if(conf != NULL && conf->policy == KEEP_LATEST_OVERLOAD_POLICY && (sm == NULL || sm->conflate.key == NULL))
+    printf("[xApp]: RIC_REQ_ID %u keep_latest not supported by the SM. Dropping the oldest\n", ric_req_id);
+
+  lock_guard(&d->mtx);
+
+  // The ID may be reused while indications of the previous subscription are queued
+  dispatch_sub_t* s = find_sub(d, ric_req_id);
+  if(s == NULL)
+    s = push_sub(d, ric_req_id);
+
+  s->sm = sm;
+  s->lazy = false;
+  s->policy = conf != NULL;
+  if(conf != NULL)
+    s->conf = *conf;
+}
+
+void rm_sub_msg_dispatcher(msg_dispatcher_xapp_t* d, uint32_t ric_req_id)
+{
+  assert(d != NULL);
+
+  lock_guard(&d->mtx);
+
+  dispatch_sub_t* s = find_sub(d, ric_req_id);
+  if(s == NULL)
+    return;
+
+  if(s->stats.queued == 0)
+    erase_sub(d, s);
+  else
+    s->lazy = true;
 }
 
-void send_msg_dispatcher( msg_dispatcher_xapp_t* d, msg_dispatch_t* msg )
+void send_msg_dispatcher( msg_dispatcher_xapp_t* d, msg_dispatch_t* msg, sm_ind_data_t const* src)
 {
   assert(d != NULL);
   assert(msg != NULL);
+  assert(msg->sm_cb != NULL);
+  assert(src != NULL);
 
-  push_tsnq(&d->q, msg, sizeof(msg_dispatch_t));
+  dispatch_queued_t* q = calloc(1, sizeof(dispatch_queued_t));
+  assert(q != NULL && "Memory exhausted");
+  q->msg = *msg;
+  *msg = (msg_dispatch_t){0};
+
+  lock_guard(&d->mtx);
+
+  dispatch_sub_t* s = find_sub(d, q->msg.ric_req_id);
+  if(s == NULL){
+    s = push_sub(d, q->msg.ric_req_id);
+    s->lazy = true;
+  }
+
+  s->stats.ind_in += 1;
+
+  if(s->conf.policy == KEEP_LATEST_OVERLOAD_POLICY && s->sm != NULL && s->sm->conflate.key != NULL)
+    q->key = s->sm->conflate.key(s->sm, src);
+
+  // The latest indication of the UE replaces the queued one, in place
+  if(q->key.len > 0){
+    size_t const idx = find_queued(d, s->ric_req_id, q->key);
+    if(idx < seq_size(&d->q)){
+      dispatch_queued_t** old = seq_at(&d->q, idx);
+      free_dispatch_queued(*old);
+      *old = q;
+      s->stats.conflated += 1;
+      return;
+    }
+  }
+
+  if(s->stats.queued == s->conf.depth){
+    if(s->stats.dropped == 0)
+      printf("[xApp]: RIC_REQ_ID %u callback does not keep up. Dropping indications (%s)\n", s->ric_req_id, overload_policy_str(s->conf.policy));
+    s->stats.dropped += 1;
+    if(s->conf.policy == DROP_NEWEST_OVERLOAD_POLICY){
+      free_dispatch_queued(q);
+      return;
+    }
+    size_t const idx = find_queued(d, s->ric_req_id, (byte_array_t){0});
+    assert(idx < seq_size(&d->q));
+    void* it = seq_at(&d->q, idx);
+    free_dispatch_queued(*(dispatch_queued_t**)it);
+    seq_erase(&d->q, it, seq_next(&d->q, it));
+    s->stats.queued -= 1;
+  }
+
+  seq_push_back(&d->q, &q, sizeof(dispatch_queued_t*));
+  s->stats.queued += 1;
+
+  int const rc = pthread_cond_signal(&d->cv);
+  assert(rc == 0);
 }
 
-size_t size_msg_dispatcher(msg_dispatcher_xapp_t* d)
+bool stats_msg_dispatcher(msg_dispatcher_xapp_t* d, uint32_t ric_req_id, dispatch_stats_t* dst)
 {
   assert(d != NULL);
+  assert(dst != NULL);
+
+  lock_guard(&d->mtx);
+
+  dispatch_sub_t* s = find_sub(d, ric_req_id);
+  if(s == NULL)
+    return false;
 
-  return size_tsnq(&d->q);
+  *dst = s->stats;
+  return true;
 }
 
+size_t size_msg_dispatcher(msg_dispatcher_xapp_t* d)
+{
+  assert(d != NULL);
+
+  lock_guard(&d->mtx);
+  return seq_size(&d->q);
+}
@@ -25,27 +25,64 @@
 #define MESSAGE_DISPATCHER_XAPP_H 
 
 
-#include "../util/alg_ds/ds/tsn_queue/tsn_queue.h"
+// The indications are handed to the callbacks by one thread. The queue of
+// every subscription is bounded and shed with the policy the xApp selected 
+// at subscribe time, see overload_conf.h. Subscriptions without a policy 
+// drop the oldest indication beyond DISPATCH_DEPTH
+
 #include "../sm/agent_if/read/sm_ag_if_rd.h"
+#include "../sm/sm_ric.h"
+#include "../util/alg_ds/ds/seq_container/seq_generic.h"
+#include "../util/overload_conf.h"
 
 #include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#define DISPATCH_DEPTH OVERLOAD_MAX_DEPTH
 
+typedef struct{
+  uint64_t ind_in;
+  uint64_t ind_out;
+  uint64_t dropped;
+  uint64_t conflated;
+  size_t queued;
+} dispatch_stats_t;
 
 typedef struct{
   pthread_t p;
-  tsnq_t q;
+  pthread_mutex_t mtx;
+  pthread_cond_t cv;
+  bool stop;
+
+  // dispatch_queued_t*. FIFO
+  seq_arr_t q;
+
+  // dispatch_sub_t*
+  seq_arr_t subs;
 } msg_dispatcher_xapp_t;
 
 typedef struct{
   sm_ag_if_rd_t rd; 
   void (*sm_cb)(sm_ag_if_rd_t const*);
+  uint32_t ric_req_id;
 } msg_dispatch_t ;
 
 void init_msg_dispatcher( msg_dispatcher_xapp_t* d);
 
+// The queued indications are discarded
 void free_msg_dispatcher( msg_dispatcher_xapp_t* d);
 
-void send_msg_dispatcher( msg_dispatcher_xapp_t* d, msg_dispatch_t* msg );
+// sm may be NULL. conf NULL for the default policy
+void add_sub_msg_dispatcher(msg_dispatcher_xapp_t* d, uint32_t ric_req_id, sm_ric_t const* sm, overload_conf_t const* conf);
+
+// The indications already queued are still dispatched
+void rm_sub_msg_dispatcher(msg_dispatcher_xapp_t* d, uint32_t ric_req_id);
+
+// msg is moved, and queued or dropped. src is only read by keep_latest
+void send_msg_dispatcher( msg_dispatcher_xapp_t* d, msg_dispatch_t* msg, sm_ind_data_t const* src);
+
+bool stats_msg_dispatcher(msg_dispatcher_xapp_t* d, uint32_t ric_req_id, dispatch_stats_t* dst);
 
 size_t size_msg_dispatcher(msg_dispatcher_xapp_t* d);
 
@@ -23,7 +23,7 @@
 
 #include <assert.h>
 
-ric_subscription_request_t generate_subscription_request(ric_gen_id_t ric_id , sm_ric_t const* sm, void* cmd)
+ric_subscription_request_t generate_subscription_request(ric_gen_id_t ric_id , sm_ric_t const* sm, void* cmd, char const* filter, char const* overload)
 {
   assert(sm != NULL);
   assert(cmd != NULL);
@@ -36,9 +36,9 @@ ric_subscription_request_t generate_subscription_request(ric_gen_id_t ric_id , s
   sr.event_trigger.len = data.len_et;
   sr.event_trigger.buf = data.event_trigger;
 
-  // We just support one action per subscription msg
-  sr.len_action = 1;  
-  sr.action = calloc(1, sizeof(ric_action_t));
+  // We just support one action per subscription msg, plus the optional filter and overload policy
+  sr.len_action = 1 + (filter != NULL) + (overload != NULL);  
+  sr.action = calloc(sr.len_action, sizeof(ric_action_t));
   assert(sr.action != NULL && "Memory exhausted");
 
   sr.action[0].id = 0;
@@ -53,6 +53,25 @@ ric_subscription_request_t generate_subscription_request(ric_gen_id_t ric_id , s
   // Only fulfilled when the type is RIC_ACT_INSERT  
   sr.action[0].subseq_action = NULL;
 
+  // Evaluated and removed at the iApp
+  size_t i = 1;
+  if(filter != NULL){
+    sr.action[i].id = E42_IND_FILTER_ACTION_ID;
+    sr.action[i].type = RIC_ACT_REPORT;
+    sr.action[i].definition = malloc(sizeof(byte_array_t));
+    assert(sr.action[i].definition != NULL && "Memory exhausted");
+    *sr.action[i].definition = cp_str_to_ba(filter);
+    i += 1;
+  }
+
+  if(overload != NULL){
+    sr.action[i].id = E42_OVERLOAD_ACTION_ID;
+    sr.action[i].type = RIC_ACT_REPORT;
+    sr.action[i].definition = malloc(sizeof(byte_array_t));
+    assert(sr.action[i].definition != NULL && "Memory exhausted");
+    *sr.action[i].definition = cp_str_to_ba(overload);
+  }
+
   return sr; 
 }
 
@@ -115,12 +134,25 @@ e42_setup_request_t generate_e42_setup_request(e42_xapp_t* xapp)
     .len_rf = len_rf,
   };
 
+  if(xapp->token != NULL){
+    sr.token = calloc(1, sizeof(byte_array_t));
+    assert(sr.token != NULL && "Memory exhausted");
+    *sr.token = copy_byte_array(*xapp->token);
+  }
+
+  if(xapp->group != NULL){
+    sr.group = calloc(1, sizeof(byte_array_t));
+    assert(sr.group != NULL && "Memory exhausted");
+    *sr.group = copy_byte_array(*xapp->group);
+  }
+
   return sr;
 }
 
-ric_control_request_t generate_ric_control_request(ric_gen_id_t ric_id, sm_ric_t const* sm, void* ctrl_msg)
+ric_control_request_t generate_ric_control_request(ric_gen_id_t ric_id, sm_ric_t const* sm, void* ctrl_msg, ric_control_ack_req_t ack)
 {
   assert(sm != NULL);
+  assert(ack == RIC_CONTROL_REQUEST_NO_ACK || ack == RIC_CONTROL_REQUEST_ACK || ack == RIC_CONTROL_REQUEST_NACK);
 
   sm_ctrl_req_data_t const data = sm->proc.on_control_req(sm,  ctrl_msg);
 
@@ -133,7 +165,7 @@ ric_control_request_t generate_ric_control_request(ric_gen_id_t ric_id, sm_ric_t
   cr.msg.len = data.len_msg;
   cr.ack_req = malloc(sizeof(ric_control_ack_req_t )) ;
   assert(cr.ack_req != NULL);
-  *cr.ack_req = RIC_CONTROL_REQUEST_ACK;  
+  *cr.ack_req = ack;
 
   return cr;
 }
@@ -33,13 +33,14 @@
 #include "e42_xapp.h"
 
 
-ric_subscription_request_t generate_subscription_request(ric_gen_id_t ric_id, sm_ric_t const* sm, void* cmd);
+// filter is optional. See E42_IND_FILTER_ACTION_ID
+ric_subscription_request_t generate_subscription_request(ric_gen_id_t ric_id, sm_ric_t const* sm, void* cmd, char const* filter, char const* overload);
 
 e42_ric_subscription_request_t generate_e42_ric_subscription_request(uint16_t xapp_id, global_e2_node_id_t* id,  ric_subscription_request_t* sr); 
 
 e42_setup_request_t generate_e42_setup_request(e42_xapp_t* xapp);
 
-ric_control_request_t generate_ric_control_request(ric_gen_id_t ric_id, sm_ric_t const* sm, void* ctrl_msg);
+ric_control_request_t generate_ric_control_request(ric_gen_id_t ric_id, sm_ric_t const* sm, void* ctrl_msg, ric_control_ack_req_t ack);
 
 //e42_ric_control_request_t generate_e42_ric_control_request(uint16_t xapp_id, global_e2_node_id_t* id,  ric_subscription_request_t* sr);
 
@@ -90,6 +90,32 @@ void rm_pending_event_xapp(e42_xapp_t* xapp, pending_event_xapp_t* ev)
   defer({ free(fd); } );
 }
 
+// false if not armed, e.g., a duplicated E42 Setup Response
+static
+bool stop_setup_timer_xapp(e42_xapp_t* xapp)
+{
+  pending_event_xapp_t ev = {.ev = E42_SETUP_REQUEST_PENDING_EVENT };
+  if(find_pending_event_ev(&xapp->pending, &ev) == false)
+    return false;
+
+  rm_pending_event_xapp(xapp, &ev);
+  return true;
+}
+
+void arm_setup_timer_xapp(e42_xapp_t* xapp)
+{
+  assert(xapp != NULL);
+
+  stop_setup_timer_xapp(xapp);
+
+  // One-shot, as every retry waits longer
+  pending_event_xapp_t ev = {.ev = E42_SETUP_REQUEST_PENDING_EVENT,
+                             .wait_ms = next_backoff(&xapp->backoff),
+                             .id = {0} }; 
+  int fd_timer = create_timer_ms_asio_xapp(&xapp->io, ev.wait_ms, 0); 
+  add_pending_event(&xapp->pending, fd_timer, &ev);
+}
+
 void init_handle_msg_xapp(size_t len, e2ap_handle_msg_fp_xapp (*handle_msg)[len])
 {
   assert(len == NONE_E2_MSG_TYPE);
@@ -168,7 +194,23 @@ e2ap_msg_t e2ap_msg_handle_xapp(e42_xapp_t* xapp, const e2ap_msg_t* msg)
   assert(xapp != NULL);
   assert(msg != NULL);
   assert(msg->type == RIC_SUBSCRIPTION_FAILURE);
-  assert(0!=0 && "Not implemented");
+
+  ric_subscription_failure_t const* fail = &msg->u_msgs.ric_sub_fail;
+
+  printf("[xApp]: SUBSCRIPTION FAILURE rx RAN_FUNC_ID %d RIC_REQ_ID %d CAUSE %d\n", fail->ric_id.ran_func_id, fail->ric_id.ric_req_id, cause_ric_subscription_failure(fail).present);
+
+  act_proc_ans_t rv = find_act_proc(&xapp->act_proc, fail->ric_id.ric_req_id);
+  assert(rv.ok == true && "ric_req_id not registered in the registry");
+  bool const found = fail_act_proc(&xapp->act_proc, fail->ric_id.ric_req_id);
+  assert(found == true);
+
+  pending_event_xapp_t ev = {.ev = E42_RIC_SUBSCRIPTION_REQUEST_PENDING_EVENT,
+                             .id = rv.val.id};
+  // Remove pending event  
+  rm_pending_event_xapp(xapp, &ev);
+
+  // Unblock UI thread  
+  signal_sync_ui(&xapp->sync);
 
   e2ap_msg_t ans = {.type = NONE_E2_MSG_TYPE};
   return ans;
@@ -269,7 +311,8 @@ sm_ind_data_t ind_sm_payload(ric_indication_t const* src)
 
     // Write to the callback. Should I send the E2 Node info to the cb??
     msg_disp.sm_cb = ans.val.sm_cb;
-    send_msg_dispatcher(&xapp->msg_disp, &msg_disp );
+    msg_disp.ric_req_id = src->ric_id.ric_req_id;
+    send_msg_dispatcher(&xapp->msg_disp, &msg_disp, &ind_data);
  }
 
   e2ap_msg_t ret = {.type = NONE_E2_MSG_TYPE };
@@ -315,7 +358,26 @@ sm_ind_data_t ind_sm_payload(ric_indication_t const* src)
   assert(xapp != NULL);
   assert(msg != NULL);
   assert(msg->type == RIC_CONTROL_FAILURE);
-  assert(0!=0 && "not implemented" );
+
+  ric_control_failure_t const* fail = &msg->u_msgs.ric_ctrl_fail;
+
+  xapp->ctrl_failures += 1;
+
+  printf("[xApp]: CONTROL FAILURE rx RAN_FUNC_ID %d RIC_REQ_ID %d CAUSE %d \n", fail->ric_id.ran_func_id, fail->ric_id.ric_req_id, fail->cause.present);
+
+  // Only the blocking controls are registered. NAck controls (async) just account the failure  
+  // The outcome is stored in the request's own entry, so that a concurrent control 
+  // failing on another thread is not attributed to this one
+  act_proc_ans_t rv = find_act_proc(&xapp->act_proc, fail->ric_id.ric_req_id);
+  if(rv.ok == true && fail_act_proc(&xapp->act_proc, fail->ric_id.ric_req_id) == true){
+    pending_event_xapp_t ev = {.ev = E42_RIC_CONTROL_REQUEST_PENDING_EVENT, .id = rv.val.id };
+
+    // Stop the timer
+    rm_pending_event_xapp(xapp, &ev);
+
+    // Unblock UI thread  
+    signal_sync_ui(&xapp->sync);
+  }
 
   e2ap_msg_t ans = {.type = NONE_E2_MSG_TYPE};
   return ans;
@@ -354,6 +416,17 @@ e2ap_msg_t e2ap_handle_e42_setup_response_xapp(e42_xapp_t* xapp, const e2ap_msg_
 
   printf("[xApp]: E42 SETUP-RESPONSE rx \n");
 
+  // Reconnection. The E2 Nodes connected may have changed in between 
+  if(sz_reg_e2_node(&xapp->e2_nodes) > 0){
+    e2_node_arr_t old = generate_e2_node_arr(&xapp->e2_nodes);
+    for(size_t i = 0; i < old.len; ++i)
+      rm_reg_e2_node(&xapp->e2_nodes, &old.n[i].id);
+    free_e2_node_arr(&old);
+
+    if(xapp->id != sr->xapp_id)
+      printf("[xApp]: Session not resumed. xApp ID %u -> %u. Previous subscriptions lost \n", xapp->id, sr->xapp_id);
+  }
+
   *(uint16_t*)&xapp->id = sr->xapp_id;
   printf("[xApp]: xApp ID = %u \n", sr->xapp_id);
 
@@ -374,11 +447,12 @@ e2ap_msg_t e2ap_handle_e42_setup_response_xapp(e42_xapp_t* xapp, const e2ap_msg_
   printf("[xApp]: Registered E2 Nodes = %ld \n", sz_reg_e2_node(&xapp->e2_nodes) );
 
   // Stop the timer
-  pending_event_xapp_t ev = {.ev = E42_SETUP_REQUEST_PENDING_EVENT };
-  rm_pending_event_xapp(xapp, &ev);
+  stop_setup_timer_xapp(xapp);
+  reset_backoff(&xapp->backoff);
 
   // Set the connected flag 
   xapp->connected = true;
+  notify_conn_state_xapp(xapp, CONNECTED_CONN_STATE);
 
   e2ap_msg_t ans = {.type = NONE_E2_MSG_TYPE};
   return ans; 
@@ -497,12 +571,9 @@ e2ap_msg_t e2ap_handle_e42_setup_request_xapp(struct e42_xapp_s* xapp, const str
 
   printf("[xApp]: E42 SETUP-REQUEST tx\n");
 
-  // A pending event is created along with a timer of 1000 ms,
-  // after which an event will be triggered
-  pending_event_xapp_t x_ev = {.ev = E42_SETUP_REQUEST_PENDING_EVENT,
-                                .wait_ms = 1000,
-                               .id = {0} }; 
-  add_pending_event_xapp(xapp, &x_ev);
+  // A pending event is created along with a timer, after which 
+  // the E42 SETUP-REQUEST is sent again
+  arm_setup_timer_xapp(xapp);
 
   e2ap_msg_t ans = {.type = NONE_E2_MSG_TYPE };
   return ans;
@@ -550,15 +621,15 @@ e2ap_msg_t e2ap_handle_e42_subscription_delete_request_xapp(e42_xapp_t* xapp, co
   byte_array_t ba_msg = e2ap_enc_e42_ric_subscription_delete_xapp(&xapp->ap,( e42_ric_subscription_delete_request_t* ) e42_sdr);
   defer({ free_byte_array(ba_msg) ;}; );
 
-  e2ap_send_bytes_xapp(&xapp->ep, ba_msg);
-
   // A pending event is created along with a timer of 10000 ms,
-  // after which an event will be generated
+  // after which an event will be generated. Before sending, as the
+  // answer may arrive before e2ap_send_bytes_xapp returns
   pending_event_xapp_t ev = {.ev = E42_RIC_SUBSCRIPTION_DELETE_REQUEST_PENDING_EVENT, 
                               .id = e42_sdr->sdr.ric_id,
                               .wait_ms = 10000};
   add_pending_event_xapp(xapp, &ev);
 
+  e2ap_send_bytes_xapp(&xapp->ep, ba_msg);
 
   e2ap_msg_t ans = {.type = NONE_E2_MSG_TYPE};
   return ans; 
@@ -575,14 +646,19 @@ e2ap_msg_t e2ap_handle_e42_ric_control_request_xapp(e42_xapp_t* xapp, const e2ap
   byte_array_t ba_msg = e2ap_enc_e42_control_request_xapp(&xapp->ap,(  e42_ric_control_request_t* ) cr);
   defer({ free_byte_array(ba_msg) ;}; );
 
-  e2ap_send_bytes_xapp(&xapp->ep, ba_msg);
+  // NoAck and NAck controls do not wait for any answer, hence, no timer 
+  ric_control_ack_req_t const* ack = cr->ctrl_req.ack_req;
+  if(ack == NULL || *ack == RIC_CONTROL_REQUEST_ACK){
+    pending_event_xapp_t ev = {.ev = E42_RIC_CONTROL_REQUEST_PENDING_EVENT,
+      .id = cr->ctrl_req.ric_id,
+      .wait_ms = 10000};
+    add_pending_event_xapp(xapp, &ev);
+  }
 
-  printf("[xApp]: CONTROL-REQUEST tx \n");
+  e2ap_send_bytes_xapp(&xapp->ep, ba_msg);
 
-  pending_event_xapp_t ev = {.ev = E42_RIC_CONTROL_REQUEST_PENDING_EVENT,
-    .id = cr->ctrl_req.ric_id,
-    .wait_ms = 10000};
-  add_pending_event_xapp(xapp, &ev);
+  if(ack == NULL || *ack == RIC_CONTROL_REQUEST_ACK)
+    printf("[xApp]: CONTROL-REQUEST tx \n");
 
 
   e2ap_msg_t ans = {.type = NONE_E2_MSG_TYPE};
@@ -30,6 +30,10 @@ void init_handle_msg_xapp(size_t len, e2ap_handle_msg_fp_xapp (*handle_msg)[len]
 
 e2ap_msg_t e2ap_msg_handle_xapp(e42_xapp_t* xapp, const e2ap_msg_t* msg);
 
+// One-shot timer of the E42 Setup Request, armed with the next delay of the
+// backoff. It replaces the armed one, if any
+void arm_setup_timer_xapp(e42_xapp_t* xapp);
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // O-RAN E2APv01.01: Messages for Global Procedures ///////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -21,6 +21,7 @@
 
 
 #include "plugin_ric.h"
+#include "lib/e2ap/e42_setup_request_wrapper.h"
 
 #include "util/alg_ds/alg/alg.h"
 #include "util/compare.h"
@@ -179,7 +180,11 @@ void load_plugin_ric(plugin_ric_t* p, const char* path)
   sm->handle = handle; 
   assert(sm != NULL);
   const uint16_t ran_func_id = sm->ran_func_id;
-  assert(ran_func_id > 0 && "Reserved RAN function ID");
+  // The E42 SETUP-REQUEST carries the xApp token and the consumer group as 
+  // RAN Functions with these IDs
+  if(ran_func_id == E42_XAPP_TOKEN_RAN_FUNC_ID || ran_func_id == E42_XAPP_GROUP_RAN_FUNC_ID)
+    printf("[NEAR-RIC]: SM %s uses the RAN function ID %d, reserved by E42\n", path, ran_func_id);
+  assert(ran_func_id != E42_XAPP_TOKEN_RAN_FUNC_ID && ran_func_id != E42_XAPP_GROUP_RAN_FUNC_ID && "Reserved RAN function ID");
   assoc_insert(&p->sm_ds, &ran_func_id, sizeof(ran_func_id), sm);
   
   printf("[NEAR-RIC]: Loading SM ID = %d with def = %s \n", sm->ran_func_id, sm->ran_func_name);
@@ -39,6 +39,10 @@ void init_sync_ui(sync_ui_t* s);
 
 void free_sync_ui(sync_ui_t* s);
 
+// Call it before sending the request, as the answer may arrive before
+// cond_wait_sync_ui is reached
+void arm_sync_ui(sync_ui_t* s);
+
 void cond_wait_sync_ui(sync_ui_t* s, uint32_t ms);
 
 void signal_sync_ui(sync_ui_t* s); 
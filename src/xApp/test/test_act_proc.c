@@ -0,0 +1,79 @@
+/*
+ * Licensed to the OpenAirInterface (OAI) Software Alliance under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The OpenAirInterface Software Alliance licenses this file to You under
+ * the OAI Public License, Version 1.1  (the "License"); you may not use this file
+ * except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.openairinterface.org/?page_id=698
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *-------------------------------------------------------------------------------
+ * For more information about the OpenAirInterface (OAI) Software Alliance:
+ *      contact@openairinterface.org
+ */
+
+#include "../act_proc.h"
+
+#include <assert.h>
+#include <stdio.h>
+
+static
+global_e2_node_id_t node(void)
+{
+  global_e2_node_id_t n = {.type = ngran_gNB, 
+                           .plmn = {.mcc = 505, .mnc = 1, .mnc_digit_len = 2},
+                           .nb_id.nb_id = 1};
+  return n;
+}
+
+// The IDs wrap below ASYNC_CTRL_RIC_REQ_ID, i.e., they never collide with the
+// ones of the asynchronous controls
+static
+void test_wrap(void)
+{
+  act_proc_t p = {0};
+  init_act_proc(&p);
+
+  global_e2_node_id_t const n = node();
+  ric_gen_id_t const id = {.ran_func_id = 142};
+
+  // A long lived subscription
+  uint32_t const sub = add_act_proc(&p, RIC_SUBSCRIPTION_PROCEDURE_ACTIVE, id, &n, NULL);
+
+  for(size_t i = 0; i < 2*ASYNC_CTRL_RIC_REQ_ID; ++i){
+    uint32_t const ctrl = add_act_proc(&p, RIC_CONTROL_PROCEDURE_ACTIVE, id, &n, NULL);
+    assert(ctrl > 0 && ctrl < ASYNC_CTRL_RIC_REQ_ID);
+    assert(ctrl != sub && "RIC request ID in use handed out");
+
+    act_proc_ans_t const ans = find_act_proc(&p, ctrl);
+    assert(ans.ok == true && ans.val.type == RIC_CONTROL_PROCEDURE_ACTIVE);
+    assert(ans.val.id.ric_req_id == ctrl);
+
+    rm_act_proc(&p, ctrl);
+  }
+
+  act_proc_ans_t const ans = find_act_proc(&p, sub);
+  assert(ans.ok == true && ans.val.type == RIC_SUBSCRIPTION_PROCEDURE_ACTIVE);
+  assert(fail_act_proc(&p, sub) == true);
+  assert(find_act_proc(&p, sub).val.failed == true);
+
+  rm_act_proc(&p, sub);
+  assert(find_act_proc(&p, sub).ok == false);
+  assert(fail_act_proc(&p, sub) == false);
+
+  free_act_proc(&p);
+}
+
+int main()
+{
+  test_wrap();
+  printf("Success\n");
+  return 0;
+}
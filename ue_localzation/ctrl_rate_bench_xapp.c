@@ -0,0 +1,86 @@
+/*
+ * Control rate benchmark xApp
+ * Sends N MAC control messages per mode (Ack, NoAck, NAck) towards the first
+ * E2 Node and prints the sustained control rate of every mode
+ * N can be set through the CTRL_BENCH_NUM environment variable (default 10000)
+ */
+
+#include "../../../../src/xApp/e42_xapp_api.h"
+#include "../../../../src/util/time_now_us.h"
+#include "../../../../src/util/alg_ds/alg/defer.h"
+#include "../../../../src/sm/mac_sm/mac_sm_id.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <unistd.h>
+
+static
+mac_ctrl_req_data_t gen_mac_ctrl(uint32_t i)
+{
+  mac_ctrl_req_data_t wr = {0};
+  wr.hdr.dummy = 1;
+  wr.msg.action = i;
+  return wr;
+}
+
+static
+void print_rate(const char* mode, size_t num, int64_t elapsed_us)
+{
+  assert(elapsed_us > 0);
+  double const rate = (double)num * 1000000.0 / (double)elapsed_us;
+  printf("[CTRL-BENCH]: %-6s %zu msgs in %ld us -> %.0f msgs/s \n", mode, num, elapsed_us, rate);
+}
+
+static
+void bench_ack(global_e2_node_id_t* id, size_t num)
+{
+  int64_t const t0 = time_now_us();
+  for(size_t i = 0; i < num; ++i){
+    mac_ctrl_req_data_t wr = gen_mac_ctrl(i);
+    sm_ans_xapp_t const ans = control_sm_xapp_api(id, SM_MAC_ID, &wr);
+    assert(ans.success == true);
+  }
+  print_rate("Ack", num, time_now_us() - t0);
+}
+
+static
+void bench_async(global_e2_node_id_t* id, size_t num, ctrl_mode_xapp_e mode)
+{
+  int64_t const t0 = time_now_us();
+  for(size_t i = 0; i < num; ++i){
+    mac_ctrl_req_data_t wr = gen_mac_ctrl(i);
+    sm_ans_xapp_t const ans = control_sm_async_xapp_api(id, SM_MAC_ID, &wr, mode);
+    assert(ans.success == true);
+  }
+  print_rate(mode == NO_ACK_CTRL_MODE_XAPP ? "NoAck" : "NAck", num, time_now_us() - t0);
+}
+
+int main(int argc, char *argv[])
+{
+  fr_args_t args = init_fr_args(argc, argv);
+  init_xapp_api(&args);
+  sleep(1);
+
+  e2_node_arr_xapp_t nodes = e2_nodes_xapp_api();
+  defer({ free_e2_node_arr_xapp(&nodes); });
+  assert(nodes.len > 0);
+
+  const char* value = getenv("CTRL_BENCH_NUM");
+  size_t const num = value ? strtoul(value, NULL, 10) : 10000;
+  assert(num > 0);
+
+  global_e2_node_id_t* id = &nodes.n[0].id;
+
+  bench_ack(id, num);
+  bench_async(id, num, NO_ACK_CTRL_MODE_XAPP);
+  bench_async(id, num, FAIL_ONLY_CTRL_MODE_XAPP);
+
+  // Give a late RIC Control Failure the chance to arrive
+  sleep(1);
+  printf("[CTRL-BENCH]: RIC Control Failures received %lu \n", ctrl_failures_xapp_api());
+
+  while(try_stop_xapp_api() == false)
+    usleep(1000);
+
+  return 0;
+}